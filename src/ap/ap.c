@@ -25,6 +25,8 @@ void apMain(void)
   ledOn(_DEF_LED1);
   while(1)
   {
+    idleWait();                                                 // V261017R5: 키 변화/1ms tick/SOF/VIA 이벤트가 없으면 WFI 대기
+
     if (is_led_on && millis()-pre_time >= 500U)                  // V251124R2: 부팅 후 0.5s 경과 시 LED 1회 소등
     {
       is_led_on = false;
@@ -35,6 +37,7 @@ void apMain(void)
     usbProcess();                                               // V250924R2 USB 안정성 이벤트 처리
     usbHidMonitorBackgroundService();                           // V251124R1: 모니터 OFF 시 타임스탬프 취득을 건너뛰는 래퍼
     qmkUpdate();
+    idleMarkDone();                                             // V261017R5: 키 변화 → 리포트 제출 지연 계측
   }
 }
 
@@ -35,6 +35,14 @@
 #define DEBOUNCE                    5
 #define DEBOUNCE_TYPE               sym_defer_pk   // V251114R3: CMake 없이 debounce 구현 선택
 
+// V261020R1: 매트릭스 배선 (keys.c 디스크립터, 행 PA0~PA4 / 열 PB0~PB14)
+#define HW_KEYS_ROW_PORT            GPIOA
+#define HW_KEYS_ROW_PINS            {0, 1, 2, 3, 4}
+#define HW_KEYS_COL_PORT_CNT        1
+#define HW_KEYS_COL_PORTS           {GPIOB}
+#define HW_KEYS_COL_SEGS            {{0, 0, 15, 0}}
+#define HW_KEYS_COL_PULL            GPIO_PULLDOWN
+
 
 // ---------------------------------------------------------------------------
 // 입력/유틸리티 기능 토글
@@ -45,6 +53,7 @@
 #define KKUK_ENABLE
 #define USB_MONITOR_ENABLE          1           // V251108R1: Brick60 VIA 채널 USB 모니터 활성화
 #define BOOTMODE_ENABLE             1
+#define NKRO_ENABLE                             // V261018R1: NKRO 인터페이스(EP 0x86) + VIA 토글
 #if defined(USB_MONITOR_ENABLE) && !defined(BOOTMODE_ENABLE)
 #  define BOOTMODE_ENABLE           1
 #endif
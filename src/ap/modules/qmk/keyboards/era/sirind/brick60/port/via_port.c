@@ -1,9 +1,13 @@
 #include "indicator_port.h"
 #include "ver_port.h"
 #include "sys_port.h"
+#include "bulk_sync.h"                                                // V261018R7
+#include "latency_stat.h"                                             // V261019R2
 #include "bootmode.h"
 #include "usb_monitor.h"
+#include "nkro.h"                                                     // V261018R1
 #include "debounce_profile.h"
+#include "scan_profile.h"
 #include "tapping_term.h"
 #include "tapdance.h"
 
@@ -42,6 +46,10 @@ void via_custom_value_command_kb(uint8_t *data, uint8_t length)
 
   if (*channel_id == id_qmk_key_response)
   {
+    if (scan_profile_handle_via_command(data, length))
+    {
+      return;                                                       // V261017R6: 오버샘플링/스캔 주기 항목
+    }
     if (debounce_profile_handle_via_command(data, length))
     {
       return;
@@ -79,6 +87,18 @@ void via_custom_value_command_kb(uint8_t *data, uint8_t length)
     return;
   }
 
+  if (*channel_id == id_qmk_bulk)
+  {
+    via_qmk_bulk_command(data, length);                             // V261018R7: 압축 일괄 전송
+    return;
+  }
+
+  if (*channel_id == id_qmk_latency)
+  {
+    via_qmk_latency_command(data, length);                          // V261019R2: 구간별 지연 조회
+    return;
+  }
+
 #ifdef KILL_SWITCH_ENABLE
   if (*channel_id == id_qmk_kill_switch_lr)
   {
@@ -151,6 +171,14 @@ static void via_handle_usb_polling_channel(uint8_t *data, uint8_t length)
   }
 #endif
 
+#ifdef NKRO_ENABLE
+  if (value_id == id_qmk_usb_nkro_toggle)
+  {
+    via_qmk_usb_nkro_command(data, length);                     // V261018R1: NKRO 토글
+    return;
+  }
+#endif
+
   *command_id = id_unhandled;
 }
 
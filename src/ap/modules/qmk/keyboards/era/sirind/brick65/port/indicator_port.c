@@ -41,7 +41,7 @@ static void indicator_render(uint8_t slot, bool active, rgb_led_t color);
 static bool indicator_via_color_value(uint8_t value_id);  // V250310R5: 색상 명령의 2바이트 payload 요구 여부 판별
 
 EECONFIG_DEBOUNCE_HELPER(indicator_0, EECONFIG_USER_INDICATOR, indicator_config[BRICK65_INDICATOR_SLOT_1]);
-EECONFIG_DEBOUNCE_HELPER(indicator_1, (void *)((uint32_t)EECONFIG_USER_INDICATOR + 4), indicator_config[BRICK65_INDICATOR_SLOT_2]);
+EECONFIG_DEBOUNCE_HELPER(indicator_1, (void *)((uintptr_t)EECONFIG_USER_INDICATOR + 4), indicator_config[BRICK65_INDICATOR_SLOT_2]);  // V261020R9: uintptr_t
 
 static void indicator_apply_defaults(uint8_t index)
 {
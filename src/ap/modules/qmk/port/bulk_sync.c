@@ -0,0 +1,511 @@
+#include "bulk_sync.h"
+#include <string.h>
+#include "port.h"
+#include "quantum.h"
+#include "dynamic_keymap.h"
+#include "util_core.h"
+
+
+// ---------------------------------------------------------------------------
+// [VIA Bulk] V261018R7
+//   - 기존 경로는 키맵 28B, 매크로 28B, 탭댄스/USER 는 값 단위로 왕복한다. 상위 레이어는 대부분
+//     KC_TRNS/KC_NO 라 워드 RLE 로 줄이면 왕복 수가 압축률만큼 준다.
+//   - 요청/응답 (value_data = data[3..]):
+//       info   get [region]                              -> [region, raw(2), crc(2), stream(2)]
+//       read   get [region, off(2)]                      -> [region, off(2), len, payload(<=25)]
+//       begin  set [region, raw(2), crc(2), stream(2)]
+//       data   set [region, off(2), len, payload]        (off 는 지금까지 받은 길이와 같아야 함)
+//       commit set [region]                              -> [region, changed(2), reboot]
+//     실패는 command_id = id_unhandled 로 돌려준다. 2바이트 값은 big-endian.
+//   - VIA 명령은 메인 루프(via_hid_task)에서만 처리되므로 상태는 잠금 없이 둔다.
+//   - V261020R5: 원본 사본(bulk_raw)을 없애고 압축 스트림 버퍼 하나만 둔다 (8.2KB → 4.1KB).
+//     읽기는 영역을 워드 단위로 직접 읽으며 부호화하고, 적용은 스트림을 두 번 풀어
+//     (1) 길이/CRC 검증, (2) BULK_DIFF_CHUNK 단위 비교·기록을 한다. 검증 전에는 아무것도 쓰지 않는다.
+//     읽기 스냅샷과 쓰기 수신은 같은 버퍼를 쓰므로 info/begin 이 서로의 상태를 끝낸다.
+// ---------------------------------------------------------------------------
+#define BULK_TAPDANCE_SIZE    ((uint32_t)((uintptr_t)EECONFIG_USER_SCAN - (uintptr_t)EECONFIG_USER_TAPDANCE))                 // V261020R9: uintptr_t
+#define BULK_SENTINEL_OFFSET  ((uint32_t)((uintptr_t)EECONFIG_USER_EEPROM_CLEAR_FLAG - (uintptr_t)EECONFIG_USER_DATABLOCK))
+#define BULK_SENTINEL_SIZE    8                       // 자동 초기화 플래그 + 쿠키
+#define BULK_DIFF_CHUNK       64
+
+
+typedef enum
+{
+  BULK_STATE_IDLE = 0,
+  BULK_STATE_READ,
+  BULK_STATE_WRITE,
+} bulk_state_t;
+
+
+// V261020R5: 원본(raw) 또는 메모리 버퍼에서 워드를 읽는 부호화 입력
+typedef struct
+{
+  const uint8_t *p_raw;                               // NULL 이면 region 에서 읽음
+  uint8_t        region;
+  uint32_t       raw_len;
+} bulk_src_t;
+
+// V261020R5: 복원된 원본을 BULK_DIFF_CHUNK 단위로 받는 출력
+typedef bool (*bulk_sink_t)(void *arg, uint16_t offset, uint8_t *p_data, uint16_t len);
+
+typedef struct
+{
+  uint8_t  region;
+  uint16_t changed;
+} bulk_apply_t;
+
+
+static uint8_t      bulk_stream[BULK_STREAM_MAX];     // V261020R5: 읽기 스냅샷/쓰기 수신 공용
+static bulk_state_t bulk_state      = BULK_STATE_IDLE;
+static uint8_t      bulk_region_cur = 0;
+static uint16_t     bulk_raw_len    = 0;
+static uint16_t     bulk_stream_len = 0;
+static uint16_t     bulk_rx_len     = 0;
+static uint16_t     bulk_crc        = 0;
+
+static bool bulk_info(uint8_t *value_data);
+static bool bulk_read(uint8_t *value_data);
+static bool bulk_write_begin(uint8_t *value_data);
+static bool bulk_write_data(uint8_t *value_data);
+static bool bulk_write_commit(uint8_t *value_data);
+static void bulk_region_read(uint8_t region, uint16_t offset, uint16_t size, uint8_t *p_data);
+
+
+
+
+static uint16_t bulk_get_u16(const uint8_t *p_data)
+{
+  return ((uint16_t)p_data[0] << 8) | p_data[1];
+}
+
+static void bulk_set_u16(uint8_t *p_data, uint16_t value)
+{
+  p_data[0] = value >> 8;
+  p_data[1] = value & 0xFF;
+}
+
+// 홀수 길이의 마지막 워드는 하위 바이트를 0 으로 채운다.
+static uint16_t bulk_src_word(const bulk_src_t *p_src, uint32_t w)
+{
+  uint8_t  word[2] = {0, 0};
+  uint32_t len     = 2 * w + 1 < p_src->raw_len ? 2 : 1;
+
+  if (p_src->p_raw != NULL)
+  {
+    memcpy(word, &p_src->p_raw[2 * w], len);
+  }
+  else
+  {
+    bulk_region_read(p_src->region, 2 * w, len, word);
+  }
+  return ((uint16_t)word[0] << 8) | word[1];
+}
+
+static uint32_t bulk_rle_encode_src(const bulk_src_t *p_src, uint8_t *p_out, uint32_t out_max)
+{
+  uint32_t words = (p_src->raw_len + 1) / 2;
+  uint32_t i     = 0;
+  uint32_t len   = 0;
+
+  while (i < words)
+  {
+    uint16_t word = bulk_src_word(p_src, i);
+    uint32_t run  = 1;
+
+    while (i + run < words && run < BULK_RLE_RUN_MAX && bulk_src_word(p_src, i + run) == word)
+    {
+      run++;
+    }
+
+    if (run >= 2)
+    {
+      if (len + 3 > out_max)
+      {
+        return 0;
+      }
+      p_out[len++] = 0x80 | (run - 1);
+      p_out[len++] = word >> 8;
+      p_out[len++] = word & 0xFF;
+      i += run;
+      continue;
+    }
+
+    // 다음 반복이 시작되기 전까지를 리터럴로 묶는다.
+    uint32_t lit  = 0;
+    uint16_t next = word;
+
+    while (i + lit < words && lit < BULK_RLE_RUN_MAX)
+    {
+      uint16_t cur = next;
+
+      if (i + lit + 1 < words)
+      {
+        next = bulk_src_word(p_src, i + lit + 1);
+        if (next == cur)
+        {
+          break;
+        }
+      }
+      lit++;
+    }
+
+    if (len + 1 + lit * 2 > out_max)
+    {
+      return 0;
+    }
+    p_out[len++] = lit - 1;
+    for (uint32_t w=0; w<lit; w++, i++)
+    {
+      word         = bulk_src_word(p_src, i);
+      p_out[len++] = word >> 8;
+      p_out[len++] = word & 0xFF;
+    }
+  }
+  return len;
+}
+
+// 압축 길이를 돌려준다. out_max 를 넘으면 0.
+uint32_t bulk_rle_encode(const uint8_t *p_raw, uint32_t raw_len, uint8_t *p_out, uint32_t out_max)
+{
+  bulk_src_t src = {.p_raw = p_raw, .region = 0, .raw_len = raw_len};
+
+  return bulk_rle_encode_src(&src, p_out, out_max);
+}
+
+// V261020R5: 복원 결과를 BULK_DIFF_CHUNK 씩 sink 로 넘긴다. 스트림 전체가 정확히 raw_len 바이트
+//            (채움 워드 포함)로 풀려야 true. 도중에 실패하면 그 전까지의 조각은 이미 넘어갔을 수 있다.
+static bool bulk_rle_decode_to(const uint8_t *p_in, uint32_t in_len, uint32_t raw_len, bulk_sink_t sink, void *arg)
+{
+  uint8_t  chunk[BULK_DIFF_CHUNK];
+  uint32_t words  = (raw_len + 1) / 2;
+  uint32_t w      = 0;
+  uint32_t pos    = 0;
+  uint32_t fill   = 0;
+  uint32_t offset = 0;
+
+  while (pos < in_len)
+  {
+    uint8_t  head  = p_in[pos++];
+    uint32_t count = (head & 0x7F) + 1;
+    bool     run   = (head & 0x80) != 0;
+    uint32_t need  = run ? 2 : count * 2;
+
+    if (pos + need > in_len || w + count > words)
+    {
+      return false;
+    }
+
+    for (uint32_t i=0; i<count; i++, w++)
+    {
+      const uint8_t *p_word = run ? &p_in[pos] : &p_in[pos + 2 * i];
+
+      for (uint32_t b=0; b<2 && 2 * w + b < raw_len; b++)
+      {
+        chunk[fill++] = p_word[b];
+        if (fill == sizeof(chunk))
+        {
+          if (sink(arg, offset, chunk, fill) != true)
+          {
+            return false;
+          }
+          offset += fill;
+          fill    = 0;
+        }
+      }
+    }
+    pos += need;
+  }
+  if (w != words)
+  {
+    return false;
+  }
+  return fill == 0 || sink(arg, offset, chunk, fill);
+}
+
+static bool bulk_sink_copy(void *arg, uint16_t offset, uint8_t *p_data, uint16_t len)
+{
+  memcpy((uint8_t *)arg + offset, p_data, len);
+  return true;
+}
+
+static bool bulk_sink_crc(void *arg, uint16_t offset, uint8_t *p_data, uint16_t len)
+{
+  (void)offset;
+  *(uint16_t *)arg = utilCalcCRC(*(uint16_t *)arg, p_data, len);
+  return true;
+}
+
+// 스트림 전체가 정확히 raw_len 바이트(채움 워드 포함)로 풀려야 true.
+bool bulk_rle_decode(const uint8_t *p_in, uint32_t in_len, uint8_t *p_raw, uint32_t raw_len)
+{
+  return bulk_rle_decode_to(p_in, in_len, raw_len, bulk_sink_copy, p_raw);
+}
+
+uint16_t bulk_region_size(uint8_t region)
+{
+  switch (region)
+  {
+    case BULK_REGION_KEYMAP:
+      return dynamic_keymap_get_layer_count() * MATRIX_ROWS * MATRIX_COLS * 2;
+    case BULK_REGION_MACRO:
+      return dynamic_keymap_macro_get_buffer_size();
+#ifdef TAPDANCE_ENABLE
+    case BULK_REGION_TAPDANCE:
+      return BULK_TAPDANCE_SIZE;
+#endif
+    case BULK_REGION_USER:
+      return EECONFIG_USER_DATA_SIZE;
+    default:
+      return 0;
+  }
+}
+
+static void bulk_region_read(uint8_t region, uint16_t offset, uint16_t size, uint8_t *p_data)
+{
+  switch (region)
+  {
+    case BULK_REGION_KEYMAP:
+      dynamic_keymap_get_buffer(offset, size, p_data);
+      break;
+    case BULK_REGION_MACRO:
+      dynamic_keymap_macro_get_buffer(offset, size, p_data);
+      break;
+    case BULK_REGION_TAPDANCE:
+      eeprom_read_block(p_data, (uint8_t *)EECONFIG_USER_TAPDANCE + offset, size);
+      break;
+    case BULK_REGION_USER:
+      eeprom_read_block(p_data, (uint8_t *)EECONFIG_USER_DATABLOCK + offset, size);
+      break;
+  }
+}
+
+// 키맵/매크로는 QMK 경로를 그대로 타서 부수 효과(고스트 행 무효화 등)를 유지한다. 모두 eeprom_update_* 라
+// eeprom_buf 와 같은 바이트는 큐에 들어가지 않는다.
+// V261020R5: 원본 사본 없이 조각 단위로 적용하므로 offset 부터 size 만큼 쓴다.
+static void bulk_region_write(uint8_t region, uint16_t offset, uint16_t size, uint8_t *p_data)
+{
+  switch (region)
+  {
+    case BULK_REGION_KEYMAP:
+      dynamic_keymap_set_buffer(offset, size, p_data);
+      break;
+    case BULK_REGION_MACRO:
+      dynamic_keymap_macro_set_buffer(offset, size, p_data);
+      break;
+    case BULK_REGION_TAPDANCE:
+      eeprom_update_block(p_data, (uint8_t *)EECONFIG_USER_TAPDANCE + offset, size);
+      break;
+    case BULK_REGION_USER:
+      eeprom_update_block(p_data, (uint8_t *)EECONFIG_USER_DATABLOCK + offset, size);
+      break;
+  }
+}
+
+// V261020R5: 복원 조각을 현재 내용과 비교해 바뀐 조각만 쓴다.
+static bool bulk_sink_apply(void *arg, uint16_t offset, uint8_t *p_data, uint16_t len)
+{
+  bulk_apply_t *p_apply = (bulk_apply_t *)arg;
+  uint8_t       cur[BULK_DIFF_CHUNK];
+  uint16_t      changed = 0;
+
+  bulk_region_read(p_apply->region, offset, len, cur);
+  for (uint16_t i=0; i<len; i++)
+  {
+    uint32_t pos = (uint32_t)offset + i;
+
+    // 자동 초기화 센티넬은 현재 값을 유지한다. 나머지 USER 슬롯은 각 모듈이 재부팅 시 다시 읽는다.
+    if (p_apply->region == BULK_REGION_USER &&
+        pos >= BULK_SENTINEL_OFFSET && pos < BULK_SENTINEL_OFFSET + BULK_SENTINEL_SIZE)
+    {
+      p_data[i] = cur[i];
+    }
+    changed += cur[i] != p_data[i] ? 1 : 0;
+  }
+
+  if (changed > 0)
+  {
+    bulk_region_write(p_apply->region, offset, len, p_data);
+    p_apply->changed += changed;
+  }
+  return true;
+}
+
+void via_qmk_bulk_command(uint8_t *data, uint8_t length)
+{
+  // data = [ command_id, channel_id, value_id, value_data ]
+  uint8_t *command_id = &(data[0]);
+  uint8_t *value_id   = &(data[2]);
+  uint8_t *value_data = &(data[3]);
+  bool     ret        = false;
+
+  if (length < 4U)
+  {
+    *command_id = id_unhandled;
+    return;
+  }
+
+  if (*command_id == id_custom_get_value)
+  {
+    if (*value_id == id_qmk_bulk_info)
+    {
+      ret = bulk_info(value_data);
+    }
+    else if (*value_id == id_qmk_bulk_read)
+    {
+      ret = bulk_read(value_data);
+    }
+  }
+  else if (*command_id == id_custom_set_value)
+  {
+    if (*value_id == id_qmk_bulk_write_begin)
+    {
+      ret = bulk_write_begin(value_data);
+    }
+    else if (*value_id == id_qmk_bulk_write_data)
+    {
+      ret = bulk_write_data(value_data);
+    }
+    else if (*value_id == id_qmk_bulk_write_commit)
+    {
+      ret = bulk_write_commit(value_data);
+    }
+  }
+
+  if (ret != true)
+  {
+    *command_id = id_unhandled;
+  }
+}
+
+bool bulk_info(uint8_t *value_data)
+{
+  uint8_t  region = value_data[0];
+  uint16_t size   = bulk_region_size(region);
+
+  bulk_state = BULK_STATE_IDLE;
+  if (size == 0 || size > BULK_RAW_MAX)
+  {
+    return false;
+  }
+
+  // V261020R5: 영역을 직접 읽으며 부호화하고 CRC 는 조각 단위로 누적한다.
+  bulk_src_t src = {.p_raw = NULL, .region = region, .raw_len = size};
+  uint8_t    chunk[BULK_DIFF_CHUNK];
+  uint16_t   crc = 0;
+
+  bulk_stream_len = bulk_rle_encode_src(&src, bulk_stream, sizeof(bulk_stream));
+  if (bulk_stream_len == 0)
+  {
+    return false;
+  }
+  for (uint16_t offset=0; offset<size; offset+=BULK_DIFF_CHUNK)
+  {
+    uint16_t len = size - offset < BULK_DIFF_CHUNK ? size - offset : BULK_DIFF_CHUNK;
+
+    bulk_region_read(region, offset, len, chunk);
+    crc = utilCalcCRC(crc, chunk, len);
+  }
+  bulk_region_cur = region;
+  bulk_raw_len    = size;
+  bulk_crc        = crc;
+  bulk_state      = BULK_STATE_READ;
+
+  bulk_set_u16(&value_data[1], bulk_raw_len);
+  bulk_set_u16(&value_data[3], bulk_crc);
+  bulk_set_u16(&value_data[5], bulk_stream_len);
+  return true;
+}
+
+bool bulk_read(uint8_t *value_data)
+{
+  uint16_t offset = bulk_get_u16(&value_data[1]);
+
+  if (bulk_state != BULK_STATE_READ || value_data[0] != bulk_region_cur || offset > bulk_stream_len)
+  {
+    return false;
+  }
+
+  uint16_t len = bulk_stream_len - offset < BULK_CHUNK_MAX ? bulk_stream_len - offset : BULK_CHUNK_MAX;
+
+  value_data[3] = len;
+  memcpy(&value_data[4], &bulk_stream[offset], len);
+  return true;
+}
+
+bool bulk_write_begin(uint8_t *value_data)
+{
+  uint8_t  region     = value_data[0];
+  uint16_t raw_len    = bulk_get_u16(&value_data[1]);
+  uint16_t stream_len = bulk_get_u16(&value_data[5]);
+
+  bulk_state = BULK_STATE_IDLE;
+  if (raw_len == 0 || raw_len != bulk_region_size(region) || stream_len == 0 || stream_len > sizeof(bulk_stream))
+  {
+    return false;
+  }
+
+  bulk_region_cur = region;
+  bulk_raw_len    = raw_len;
+  bulk_crc        = bulk_get_u16(&value_data[3]);
+  bulk_stream_len = stream_len;
+  bulk_rx_len     = 0;
+  bulk_state      = BULK_STATE_WRITE;
+  return true;
+}
+
+bool bulk_write_data(uint8_t *value_data)
+{
+  uint16_t offset = bulk_get_u16(&value_data[1]);
+  uint8_t  len    = value_data[3];
+
+  if (bulk_state != BULK_STATE_WRITE || value_data[0] != bulk_region_cur ||
+      offset != bulk_rx_len || len > BULK_CHUNK_MAX || offset + len > bulk_stream_len)
+  {
+    return false;
+  }
+
+  memcpy(&bulk_stream[offset], &value_data[4], len);
+  bulk_rx_len += len;
+  return true;
+}
+
+bool bulk_write_commit(uint8_t *value_data)
+{
+  uint8_t region = value_data[0];
+  bool    reboot = false;
+
+  if (bulk_state != BULK_STATE_WRITE || region != bulk_region_cur || bulk_rx_len != bulk_stream_len)
+  {
+    bulk_state = BULK_STATE_IDLE;
+    return false;
+  }
+  bulk_state = BULK_STATE_IDLE;
+
+  // V261020R5: 1차로 길이/CRC 만 검증하고, 통과하면 2차로 풀면서 조각 단위로 비교·기록한다.
+  uint16_t crc = 0;
+
+  if (bulk_rle_decode_to(bulk_stream, bulk_stream_len, bulk_raw_len, bulk_sink_crc, &crc) != true || crc != bulk_crc)
+  {
+    logPrintf("[!] VIA bulk region %d : decode/crc fail\n", region);
+    return false;
+  }
+
+  bulk_apply_t apply = {.region = region, .changed = 0};
+
+  (void)bulk_rle_decode_to(bulk_stream, bulk_stream_len, bulk_raw_len, bulk_sink_apply, &apply);
+  reboot = region == BULK_REGION_USER;
+#ifdef TAPDANCE_ENABLE
+  if (apply.changed > 0 && (region == BULK_REGION_TAPDANCE || region == BULK_REGION_USER))
+  {
+    tapdance_init();                                                // 탭댄스 RAM 사본을 EEPROM 에서 다시 읽음
+  }
+#endif
+
+  uint16_t changed = apply.changed;
+
+  logPrintf("[  ] VIA bulk region %d : %u / %u bytes changed\n", region, changed, bulk_raw_len);
+
+  bulk_set_u16(&value_data[1], changed);
+  value_data[3] = reboot && changed > 0;
+  return true;
+}
@@ -0,0 +1,34 @@
+#pragma once
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include QMK_KEYMAP_CONFIG_H
+
+
+// V261018R7: VIA 압축 일괄 전송 (VIA 채널 id_qmk_bulk)
+//   - 영역 전체를 16비트 워드 RLE 로 압축한 스냅샷을 25B 조각으로 읽고, 같은 형식으로 받아 적용한다.
+//   - 적용은 CRC 검증 후 eeprom_buf 와 비교해 바뀐 바이트만 EEPROM 쓰기 큐에 넣는다.
+//   - RLE 헤더 h: bit7 = 1 이면 다음 워드 1개를 (h & 0x7F) + 1 번 반복, 0 이면 워드 h + 1 개를 그대로 복사.
+//     홀수 길이 영역의 마지막 워드는 0 으로 채워 부호화하고 복원 시 잘라낸다.
+#define BULK_RAW_MAX          TOTAL_EEPROM_BYTE_COUNT
+#define BULK_STREAM_MAX       (BULK_RAW_MAX + BULK_RAW_MAX / 256 + 2)   // 리터럴만 나올 때의 최대 길이
+                                                                // V261020R5: 상주 버퍼는 이 크기 하나 (원본 사본 없음)
+#define BULK_CHUNK_MAX        25                                        // 32B - [cmd, ch, value_id, region, off_hi, off_lo, len]
+#define BULK_RLE_RUN_MAX      128
+
+
+typedef enum
+{
+  BULK_REGION_KEYMAP = 0,                             // 동적 키맵 (레이어 x 행 x 열 x 2, big-endian)
+  BULK_REGION_MACRO,                                  // 동적 매크로 버퍼
+  BULK_REGION_TAPDANCE,                               // EECONFIG_USER_TAPDANCE 슬롯
+  BULK_REGION_USER,                                   // EECONFIG_USER_DATABLOCK 전체 (자동 초기화 센티넬은 적용하지 않음)
+  BULK_REGION_MAX
+} bulk_region_t;
+
+
+uint32_t bulk_rle_encode(const uint8_t *p_raw, uint32_t raw_len, uint8_t *p_out, uint32_t out_max);
+bool     bulk_rle_decode(const uint8_t *p_in, uint32_t in_len, uint8_t *p_raw, uint32_t raw_len);
+uint16_t bulk_region_size(uint8_t region);
+void     via_qmk_bulk_command(uint8_t *data, uint8_t length);
@@ -10,14 +10,19 @@
 
 
 #define DEBOUNCE_PROFILE_SIGNATURE     (0x434E4244UL)     // "DBNC"
-#define DEBOUNCE_PROFILE_VERSION       (1U)
+#define DEBOUNCE_PROFILE_VERSION       (2U)               // V261017R2: type 바이트 bit7 에 시간 단위 저장
+#define DEBOUNCE_PROFILE_VERSION_V1    (1U)               // V261017R2: ms 전용 구버전 레이아웃 (마이그레이션 대상)
 #define DEBOUNCE_PROFILE_MIN_DELAY_MS  (1U)
 #define DEBOUNCE_PROFILE_MAX_DELAY_MS  (30U)
+#define DEBOUNCE_PROFILE_TICKS_PER_MS  (1000U / DEBOUNCE_RUNTIME_TICK_US)
+#define DEBOUNCE_PROFILE_MAX_DELAY_TICK (DEBOUNCE_PROFILE_MAX_DELAY_MS * DEBOUNCE_PROFILE_TICKS_PER_MS)
+#define DEBOUNCE_PROFILE_TYPE_MASK     (0x7FU)
+#define DEBOUNCE_PROFILE_UNIT_BIT      (0x80U)
 
 
 typedef struct __attribute__((packed))
 {
-  uint8_t  type;
+  uint8_t  type;                                          // V261017R2: bit7 = 125us 단위, bit0~6 = 알고리즘
   uint8_t  pre_ms;
   uint8_t  post_ms;
   uint8_t  version;
@@ -44,7 +49,9 @@ static debounce_profile_state_t debounce_profile_state = {0};
 static void     debounce_profile_apply_defaults_locked(void);
 static void     debounce_profile_sync_from_storage(void);
 static bool     debounce_profile_is_storage_valid(const debounce_profile_storage_t *storage);
-static uint8_t  debounce_profile_clamp_delay(uint8_t delay);
+static uint8_t  debounce_profile_clamp_delay(uint8_t delay, debounce_runtime_unit_t unit, debounce_runtime_type_t type);
+static uint8_t  debounce_profile_convert_delay(uint8_t delay, debounce_runtime_unit_t from, debounce_runtime_unit_t to, debounce_runtime_type_t type);
+static uint8_t  debounce_profile_storage_pack_type(const debounce_profile_values_t *values);
 static void     debounce_profile_store_current(void);
 static bool     debounce_profile_set_value_internal(uint8_t id, uint8_t value);
 static void     debounce_profile_get_value_internal(uint8_t id, uint8_t *value_data);
@@ -87,6 +94,7 @@ void debounce_profile_apply_current(void)
     .type    = debounce_profile_state.values.type,
     .pre_ms  = debounce_profile_state.values.pre_ms,
     .post_ms = debounce_profile_state.values.post_ms,
+    .unit    = debounce_profile_state.values.unit,             // V261017R2: 프로필 단위를 런타임 타이머에 전달
   };
 
   if (!debounce_runtime_apply_config(&config))
@@ -130,20 +138,21 @@ bool debounce_profile_set_mode(uint8_t mode)
 
   debounce_profile_values_t previous = debounce_profile_state.values;
   debounce_profile_state.values.type = (debounce_runtime_type_t)mode;
-  if (mode == DEBOUNCE_RUNTIME_TYPE_SYM_DEFER_PK)
+  debounce_runtime_type_t base = debounce_runtime_get_base_type((debounce_runtime_type_t)mode);  // V261017R3: bs 커널은 pk 와 같은 지연 구성
+  if (base == DEBOUNCE_RUNTIME_TYPE_SYM_DEFER_PK)
   {
-    uint8_t common_delay = debounce_profile_clamp_delay(debounce_profile_state.values.pre_ms);
+    uint8_t common_delay = debounce_profile_clamp_delay(debounce_profile_state.values.pre_ms, debounce_profile_state.values.unit, debounce_profile_state.values.type);
     debounce_profile_state.values.pre_ms  = common_delay;
     debounce_profile_state.values.post_ms = common_delay;
   }
-  else if (mode == DEBOUNCE_RUNTIME_TYPE_SYM_EAGER_PK)
+  else if (base == DEBOUNCE_RUNTIME_TYPE_SYM_EAGER_PK)
   {
-    debounce_profile_state.values.post_ms = debounce_profile_clamp_delay(debounce_profile_state.values.post_ms);
+    debounce_profile_state.values.post_ms = debounce_profile_clamp_delay(debounce_profile_state.values.post_ms, debounce_profile_state.values.unit, debounce_profile_state.values.type);
   }
   else
   {
-    debounce_profile_state.values.pre_ms  = debounce_profile_clamp_delay(debounce_profile_state.values.pre_ms);
-    debounce_profile_state.values.post_ms = debounce_profile_clamp_delay(debounce_profile_state.values.post_ms);
+    debounce_profile_state.values.pre_ms  = debounce_profile_clamp_delay(debounce_profile_state.values.pre_ms, debounce_profile_state.values.unit, debounce_profile_state.values.type);
+    debounce_profile_state.values.post_ms = debounce_profile_clamp_delay(debounce_profile_state.values.post_ms, debounce_profile_state.values.unit, debounce_profile_state.values.type);
   }
 
   bool changed = debounce_profile_values_changed(&previous, &debounce_profile_state.values);
@@ -160,13 +169,13 @@ bool debounce_profile_set_mode(uint8_t mode)
 
 bool debounce_profile_set_single_delay(uint8_t delay_ms)
 {
-  if (debounce_profile_state.values.type != DEBOUNCE_RUNTIME_TYPE_SYM_DEFER_PK)
+  if (debounce_runtime_get_base_type(debounce_profile_state.values.type) != DEBOUNCE_RUNTIME_TYPE_SYM_DEFER_PK)
   {
     return false;
   }
 
   debounce_profile_values_t previous = debounce_profile_state.values;
-  uint8_t clamped = debounce_profile_clamp_delay(delay_ms);
+  uint8_t clamped = debounce_profile_clamp_delay(delay_ms, debounce_profile_state.values.unit, debounce_profile_state.values.type);
   debounce_profile_state.values.pre_ms  = clamped;
   debounce_profile_state.values.post_ms = clamped;
   bool changed = debounce_profile_values_changed(&previous, &debounce_profile_state.values);
@@ -182,13 +191,13 @@ bool debounce_profile_set_single_delay(uint8_t delay_ms)
 
 bool debounce_profile_set_press_delay(uint8_t delay_ms)
 {
-  if (debounce_profile_state.values.type != DEBOUNCE_RUNTIME_TYPE_ASYM_EAGER_DEFER_PK)
+  if (debounce_runtime_get_base_type(debounce_profile_state.values.type) != DEBOUNCE_RUNTIME_TYPE_ASYM_EAGER_DEFER_PK)
   {
     return false;
   }
 
   debounce_profile_values_t previous = debounce_profile_state.values;
-  debounce_profile_state.values.pre_ms = debounce_profile_clamp_delay(delay_ms);
+  debounce_profile_state.values.pre_ms = debounce_profile_clamp_delay(delay_ms, debounce_profile_state.values.unit, debounce_profile_state.values.type);
   bool changed = debounce_profile_values_changed(&previous, &debounce_profile_state.values);
   debounce_profile_state.applied       = false;
   debounce_profile_store_current();
@@ -202,13 +211,13 @@ bool debounce_profile_set_press_delay(uint8_t delay_ms)
 
 bool debounce_profile_set_release_delay(uint8_t delay_ms)
 {
-  if (debounce_profile_state.values.type == DEBOUNCE_RUNTIME_TYPE_SYM_DEFER_PK)
+  if (debounce_runtime_get_base_type(debounce_profile_state.values.type) == DEBOUNCE_RUNTIME_TYPE_SYM_DEFER_PK)
   {
     return false;
   }
 
   debounce_profile_values_t previous = debounce_profile_state.values;
-  debounce_profile_state.values.post_ms = debounce_profile_clamp_delay(delay_ms);
+  debounce_profile_state.values.post_ms = debounce_profile_clamp_delay(delay_ms, debounce_profile_state.values.unit, debounce_profile_state.values.type);
   bool changed = debounce_profile_values_changed(&previous, &debounce_profile_state.values);
   debounce_profile_state.applied        = false;
   debounce_profile_store_current();
@@ -220,6 +229,30 @@ bool debounce_profile_set_release_delay(uint8_t delay_ms)
   return true;
 }
 
+bool debounce_profile_set_unit(uint8_t unit)
+{
+  if (unit >= DEBOUNCE_RUNTIME_UNIT_COUNT)
+  {
+    return false;
+  }
+
+  debounce_profile_values_t previous = debounce_profile_state.values;
+  debounce_runtime_unit_t   to       = (debounce_runtime_unit_t)unit;
+
+  debounce_profile_state.values.pre_ms  = debounce_profile_convert_delay(previous.pre_ms, previous.unit, to, previous.type);
+  debounce_profile_state.values.post_ms = debounce_profile_convert_delay(previous.post_ms, previous.unit, to, previous.type);
+  debounce_profile_state.values.unit    = to;
+  bool changed = debounce_profile_values_changed(&previous, &debounce_profile_state.values);
+  debounce_profile_state.applied        = false;
+  debounce_profile_store_current();
+  debounce_profile_apply_current();
+  if (changed)
+  {
+    debounce_profile_log_change("unit");                    // V261017R2: VIA 디바운스 단위 변경 로그
+  }
+  return true;
+}
+
 void debounce_profile_save(bool force)
 {
   eeconfig_flush_debounce_profile(force);
@@ -287,9 +320,16 @@ bool debounce_profile_handle_via_command(uint8_t *data, uint8_t length)
 static void debounce_profile_apply_defaults_locked(void)
 {
   const debounce_runtime_config_t *default_config = debounce_profile_default_config();
-  debounce_profile_storage.type      = (uint8_t)default_config->type;
-  debounce_profile_storage.pre_ms    = debounce_profile_clamp_delay(default_config->pre_ms);
-  debounce_profile_storage.post_ms   = debounce_profile_clamp_delay(default_config->post_ms);
+  debounce_profile_values_t values =
+  {
+    .type    = default_config->type,
+    .pre_ms  = debounce_profile_clamp_delay(default_config->pre_ms, default_config->unit, default_config->type),
+    .post_ms = debounce_profile_clamp_delay(default_config->post_ms, default_config->unit, default_config->type),
+    .unit    = default_config->unit,
+  };
+  debounce_profile_storage.type      = debounce_profile_storage_pack_type(&values);
+  debounce_profile_storage.pre_ms    = values.pre_ms;
+  debounce_profile_storage.post_ms   = values.post_ms;
   debounce_profile_storage.version   = DEBOUNCE_PROFILE_VERSION;
   debounce_profile_storage.signature = DEBOUNCE_PROFILE_SIGNATURE;
   eeconfig_flag_debounce_profile(true);
@@ -298,15 +338,21 @@ static void debounce_profile_apply_defaults_locked(void)
 static void debounce_profile_sync_from_storage(void)
 {
   debounce_profile_values_t values;
-  values.type    = (debounce_runtime_type_t)debounce_profile_storage.type;
-  values.pre_ms  = debounce_profile_clamp_delay(debounce_profile_storage.pre_ms);
-  values.post_ms = debounce_profile_clamp_delay(debounce_profile_storage.post_ms);
+  values.type    = (debounce_runtime_type_t)(debounce_profile_storage.type & DEBOUNCE_PROFILE_TYPE_MASK);
+  values.unit    = DEBOUNCE_RUNTIME_UNIT_MS;
+  if (debounce_profile_storage.version != DEBOUNCE_PROFILE_VERSION_V1 &&
+      (debounce_profile_storage.type & DEBOUNCE_PROFILE_UNIT_BIT) != 0U)
+  {
+    values.unit = DEBOUNCE_RUNTIME_UNIT_125US;              // V261017R2: v1 레코드는 ms 단위로 해석
+  }
+  values.pre_ms  = debounce_profile_clamp_delay(debounce_profile_storage.pre_ms, values.unit, values.type);
+  values.post_ms = debounce_profile_clamp_delay(debounce_profile_storage.post_ms, values.unit, values.type);
 
   if (values.type >= DEBOUNCE_RUNTIME_TYPE_COUNT)
   {
     values.type = debounce_profile_default_config()->type;
   }
-  if (values.type == DEBOUNCE_RUNTIME_TYPE_SYM_DEFER_PK)
+  if (debounce_runtime_get_base_type(values.type) == DEBOUNCE_RUNTIME_TYPE_SYM_DEFER_PK)
   {
     values.post_ms = values.pre_ms;
   }
@@ -320,11 +366,12 @@ static bool debounce_profile_is_storage_valid(const debounce_profile_storage_t *
   {
     return false;
   }
-  if (storage->version != DEBOUNCE_PROFILE_VERSION)
+  if (storage->version != DEBOUNCE_PROFILE_VERSION &&
+      storage->version != DEBOUNCE_PROFILE_VERSION_V1)      // V261017R2: v1 은 유효 데이터로 받아 다음 저장 시 v2 로 승격
   {
     return false;
   }
-  if (storage->type >= DEBOUNCE_RUNTIME_TYPE_COUNT)
+  if ((storage->type & DEBOUNCE_PROFILE_TYPE_MASK) >= DEBOUNCE_RUNTIME_TYPE_COUNT)
   {
     return false;
   }
@@ -336,22 +383,67 @@ static const debounce_runtime_config_t *debounce_profile_default_config(void)
   return debounce_runtime_get_default_config();             // V251115R3: 보드 기본 디바운스 설정을 프로필 기본값으로 사용
 }
 
-static uint8_t debounce_profile_clamp_delay(uint8_t delay)
+static uint8_t debounce_profile_clamp_delay(uint8_t delay, debounce_runtime_unit_t unit, debounce_runtime_type_t type)
 {
+  uint8_t max_delay = DEBOUNCE_PROFILE_MAX_DELAY_MS;
+  uint8_t algo_max  = debounce_runtime_get_max_delay(type);
+
+  if (unit == DEBOUNCE_RUNTIME_UNIT_125US)
+  {
+    max_delay = DEBOUNCE_PROFILE_MAX_DELAY_TICK;            // V261017R2: 125us 모드도 최대 30ms(240틱)로 제한
+  }
+  if (max_delay > algo_max)
+  {
+    max_delay = algo_max;                                   // V261019R8: 커널 카운터 한도(asym pk 127틱)까지만 받아 VIA 응답과 실제 지연을 일치
+  }
   if (delay < DEBOUNCE_PROFILE_MIN_DELAY_MS)
   {
     delay = DEBOUNCE_PROFILE_MIN_DELAY_MS;
   }
-  if (delay > DEBOUNCE_PROFILE_MAX_DELAY_MS)
+  if (delay > max_delay)
   {
-    delay = DEBOUNCE_PROFILE_MAX_DELAY_MS;
+    delay = max_delay;
   }
   return delay;
 }
 
+static uint8_t debounce_profile_convert_delay(uint8_t delay, debounce_runtime_unit_t from, debounce_runtime_unit_t to, debounce_runtime_type_t type)
+{
+  uint32_t converted = delay;
+
+  if (from == to)
+  {
+    return debounce_profile_clamp_delay(delay, to, type);
+  }
+  if (to == DEBOUNCE_RUNTIME_UNIT_125US)
+  {
+    converted = (uint32_t)delay * DEBOUNCE_PROFILE_TICKS_PER_MS;
+  }
+  else
+  {
+    converted = ((uint32_t)delay + DEBOUNCE_PROFILE_TICKS_PER_MS - 1U) / DEBOUNCE_PROFILE_TICKS_PER_MS;  // V261017R2: ms 환산 시 올림으로 채터 여유 유지
+  }
+  if (converted > UINT8_MAX)
+  {
+    converted = UINT8_MAX;
+  }
+  return debounce_profile_clamp_delay((uint8_t)converted, to, type);
+}
+
+static uint8_t debounce_profile_storage_pack_type(const debounce_profile_values_t *values)
+{
+  uint8_t packed = (uint8_t)values->type & DEBOUNCE_PROFILE_TYPE_MASK;
+
+  if (values->unit == DEBOUNCE_RUNTIME_UNIT_125US)
+  {
+    packed |= DEBOUNCE_PROFILE_UNIT_BIT;
+  }
+  return packed;
+}
+
 static void debounce_profile_store_current(void)
 {
-  debounce_profile_storage.type      = (uint8_t)debounce_profile_state.values.type;
+  debounce_profile_storage.type      = debounce_profile_storage_pack_type(&debounce_profile_state.values);
   debounce_profile_storage.pre_ms    = debounce_profile_state.values.pre_ms;
   debounce_profile_storage.post_ms   = debounce_profile_state.values.post_ms;
   debounce_profile_storage.version   = DEBOUNCE_PROFILE_VERSION;
@@ -378,6 +470,9 @@ static bool debounce_profile_set_value_internal(uint8_t id, uint8_t value)
     case id_qmk_debounce_status:
       return true;
 
+    case id_qmk_debounce_unit:
+      return debounce_profile_set_unit(value);              // V261017R2: VIA 타이밍 해상도 선택
+
     default:
       break;
   }
@@ -409,6 +504,10 @@ static void debounce_profile_get_value_internal(uint8_t id, uint8_t *value_data)
       value_data[0] = (uint8_t)debounce_profile_get_status();
       break;
 
+    case id_qmk_debounce_unit:
+      value_data[0] = (uint8_t)debounce_profile_state.values.unit;
+      break;
+
     default:
       value_data[0] = 0U;
       break;
@@ -435,15 +534,22 @@ static bool debounce_profile_values_changed(const debounce_profile_values_t *bef
   {
     return true;
   }
+  if (before->unit != after->unit)
+  {
+    return true;
+  }
   return false;
 }
 
 static void debounce_profile_log_change(const char *source)
 {
   const char *log_source = (source != NULL) ? source : "unknown";
-  logPrintf("[  ] DEBOUNCE change (%s): type %d, pre %d ms, post %d ms\n",
+  const char *unit_str   = (debounce_profile_state.values.unit == DEBOUNCE_RUNTIME_UNIT_125US) ? "x125us" : "ms";
+  logPrintf("[  ] DEBOUNCE change (%s): type %d, pre %d %s, post %d %s\n",
             log_source,
             debounce_profile_state.values.type,
             debounce_profile_state.values.pre_ms,
-            debounce_profile_state.values.post_ms);         // V251115R2: VIA 디바운스 런타임 설정 변경 로그
+            unit_str,
+            debounce_profile_state.values.post_ms,
+            unit_str);         // V251115R2: VIA 디바운스 런타임 설정 변경 로그
 }
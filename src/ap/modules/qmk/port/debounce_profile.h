@@ -10,7 +10,8 @@ typedef struct
 {
   debounce_runtime_type_t type;
   uint8_t                 pre_ms;
-  uint8_t                 post_ms;
+  uint8_t                 post_ms;                    // V261017R2: unit 단위 값 (125us 모드에서는 틱 수)
+  debounce_runtime_unit_t unit;
 } debounce_profile_values_t;  // V251115R1: VIA 런타임 디바운스 값 캐시
 
 typedef enum
@@ -30,6 +31,7 @@ bool                        debounce_profile_set_mode(uint8_t mode);
 bool                        debounce_profile_set_single_delay(uint8_t delay_ms);
 bool                        debounce_profile_set_press_delay(uint8_t delay_ms);
 bool                        debounce_profile_set_release_delay(uint8_t delay_ms);
+bool                        debounce_profile_set_unit(uint8_t unit);   // V261017R2: 1ms/125us 단위 전환 (기존 값은 환산)
 void                        debounce_profile_save(bool force);
 void                        debounce_profile_restore_defaults(void);
 void                        debounce_profile_storage_apply_defaults(void);
@@ -5,6 +5,7 @@
 #include "usb.h"
 #include "qmk/port/usb_monitor.h"
 #include "qmk/port/debounce_profile.h"
+#include "qmk/port/scan_profile.h"
 
 
 #if (EECONFIG_USER_DATA_SIZE) > 0
@@ -20,6 +21,8 @@ void eeconfig_init_user_datablock(void)
 #endif
   debounce_profile_storage_apply_defaults();                   // V251115R1: VIA 디바운스 프로필 기본값 기록
   debounce_profile_save(true);
+  scan_profile_storage_apply_defaults();                       // V261017R6: 매트릭스 오버샘플링 슬롯 기본값 기록
+  scan_profile_save(true);
 #ifdef G_TERM_ENABLE
   tapping_term_storage_apply_defaults();                       // V251123R4: VIA TAPPING 슬롯 기본값 기록
   tapping_term_storage_flush(true);
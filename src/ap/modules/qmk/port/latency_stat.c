@@ -0,0 +1,151 @@
+#include "latency_stat.h"
+#include "port.h"
+#include "quantum.h"
+
+
+// ---------------------------------------------------------------------------
+// [VIA Latency] V261019R2
+//   - 요청/응답 (value_data = data[3..], 다중 바이트 값은 big-endian):
+//       enable get                    -> [enable]
+//       enable set [enable]
+//       clear  set
+//       info   get                    -> [samples(4), abandoned(4), tick_per_us(2), bins]
+//       stage  get [stage]            -> [stage, cnt(4), avg_ns(4), p50_ns(4), p99_ns(4), max_ns(4)]
+//       hist   get [stage, first]     -> [stage, first, n, cnt(2) x n]   (구간 카운트는 65535 에서 포화)
+//     stage 0~4 는 capture>debounce ~ tx>done, 5 는 total. 구간 상한은 latencyBinUpperTick() 규칙을 따른다.
+// ---------------------------------------------------------------------------
+#ifdef _USE_HW_LATENCY
+
+static void latency_stat_put32(uint8_t *p_buf, uint32_t value);
+static void latency_stat_put16(uint8_t *p_buf, uint16_t value);
+static bool latency_stat_stage(uint8_t *value_data);
+static bool latency_stat_hist(uint8_t *value_data);
+
+
+void via_qmk_latency_command(uint8_t *data, uint8_t length)
+{
+  // data = [ command_id, channel_id, value_id, value_data ]
+  uint8_t *command_id = &(data[0]);
+  uint8_t *value_id   = &(data[2]);
+  uint8_t *value_data = &(data[3]);
+  bool     ret        = false;
+
+  if (length < 4U)
+  {
+    *command_id = id_unhandled;
+    return;
+  }
+
+  if (*command_id == id_custom_get_value)
+  {
+    if (*value_id == id_qmk_latency_enable)
+    {
+      value_data[0] = latencyIsEnabled() ? 1 : 0;
+      ret = true;
+    }
+    else if (*value_id == id_qmk_latency_info)
+    {
+      latency_stat_put32(&value_data[0], latencyGetSampleCount());
+      latency_stat_put32(&value_data[4], latencyGetAbandonCount());
+      latency_stat_put16(&value_data[8], (uint16_t)latencyGetTickPerUs());
+      value_data[10] = LATENCY_HIST_BINS;
+      ret = true;
+    }
+    else if (*value_id == id_qmk_latency_stage)
+    {
+      ret = latency_stat_stage(value_data);
+    }
+    else if (*value_id == id_qmk_latency_hist)
+    {
+      ret = latency_stat_hist(value_data);
+    }
+  }
+  else if (*command_id == id_custom_set_value)
+  {
+    if (*value_id == id_qmk_latency_enable)
+    {
+      latencySetEnable(value_data[0] != 0);
+      ret = true;
+    }
+    else if (*value_id == id_qmk_latency_clear)
+    {
+      latencyClear();
+      ret = true;
+    }
+  }
+
+  if (ret != true)
+  {
+    *command_id = id_unhandled;
+  }
+}
+
+bool latency_stat_stage(uint8_t *value_data)
+{
+  latency_stage_t       stage  = (latency_stage_t)value_data[0];
+  const latency_hist_t *p_hist = latencyGetHist(stage);
+  uint32_t              avg_ns;
+
+  if (p_hist == NULL)
+  {
+    return false;
+  }
+  avg_ns = p_hist->cnt > 0 ? latencyTickToNs((uint32_t)(p_hist->sum_tick / p_hist->cnt)) : 0;
+
+  latency_stat_put32(&value_data[1],  p_hist->cnt);
+  latency_stat_put32(&value_data[5],  avg_ns);
+  latency_stat_put32(&value_data[9],  latencyGetPercentileNs(stage, 500));
+  latency_stat_put32(&value_data[13], latencyGetPercentileNs(stage, 990));
+  latency_stat_put32(&value_data[17], latencyTickToNs(p_hist->max_tick));
+  return true;
+}
+
+bool latency_stat_hist(uint8_t *value_data)
+{
+  const latency_hist_t *p_hist = latencyGetHist((latency_stage_t)value_data[0]);
+  uint8_t               first  = value_data[1];
+  uint8_t               n;
+
+  if (p_hist == NULL || first >= LATENCY_HIST_BINS)
+  {
+    return false;
+  }
+  n = LATENCY_HIST_BINS - first;
+  if (n > LATENCY_STAT_HIST_CHUNK)
+  {
+    n = LATENCY_STAT_HIST_CHUNK;
+  }
+
+  value_data[2] = n;
+  for (uint8_t i=0; i<n; i++)
+  {
+    uint32_t cnt = p_hist->bin[first + i];
+
+    latency_stat_put16(&value_data[3 + i * 2], cnt < UINT16_MAX ? (uint16_t)cnt : UINT16_MAX);
+  }
+  return true;
+}
+
+void latency_stat_put32(uint8_t *p_buf, uint32_t value)
+{
+  p_buf[0] = (uint8_t)(value >> 24);
+  p_buf[1] = (uint8_t)(value >> 16);
+  p_buf[2] = (uint8_t)(value >> 8);
+  p_buf[3] = (uint8_t)(value >> 0);
+}
+
+void latency_stat_put16(uint8_t *p_buf, uint16_t value)
+{
+  p_buf[0] = (uint8_t)(value >> 8);
+  p_buf[1] = (uint8_t)(value >> 0);
+}
+
+#else
+
+void via_qmk_latency_command(uint8_t *data, uint8_t length)
+{
+  (void)length;
+  data[0] = id_unhandled;
+}
+
+#endif
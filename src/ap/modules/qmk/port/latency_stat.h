@@ -0,0 +1,11 @@
+#pragma once
+
+#include <stdbool.h>
+#include <stdint.h>
+
+
+// V261019R2: VIA 지연 계측 채널 (id_qmk_latency). 계측 자체는 hw/driver/latency.c
+#define LATENCY_STAT_HIST_CHUNK   12                  // 한 응답에 싣는 히스토그램 구간 수 (2B x 12)
+
+
+void via_qmk_latency_command(uint8_t *data, uint8_t length);
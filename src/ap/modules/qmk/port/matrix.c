@@ -10,15 +10,24 @@
 #include "keys.h"
 #include "matrix_instrumentation.h"  // V251009R9: 매트릭스 계측 경로를 독립 모듈로 이관
 #include "debounce_profile.h"
+#include "latency.h"                 // V261019R2: 디바운스 확정 시점에서 구간 지연 샘플 시작
+#include "idle.h"                    // V261019R9: 디바운스 확정 대기 중 WFI 억제
 
 
 /* matrix state(1:on, 0:off) */
 static matrix_row_t raw_matrix[MATRIX_ROWS]; // raw values
 static matrix_row_t matrix[MATRIX_ROWS];     // debounced values
 static bool         is_info_enable = false;
+static uint32_t     frame_seq      = 0;               // V261017R4: 마지막으로 처리한 DMA 스캔 프레임 번호
+static uint32_t     edge_us[MATRIX_ROWS][MATRIX_COLS];  // V261017R8: 키별 마지막 raw 엣지 시각 (DMA 프레임 캡처 시각, us)
+static matrix_row_t edge_valid[MATRIX_ROWS];              // V261020R2: edge_us 기록 여부 (micros() 0 도 유효한 시각이므로 별도 비트)
 
 static void cliCmd(cli_args_t *args);
 static void matrix_info(void);
+static inline uint8_t matrix_lowest_col(matrix_row_t bits);
+#if _DEF_ENABLE_USB_HID_TIMING_PROBE || defined(_USE_HW_LATENCY)
+static uint32_t matrix_oldest_edge_us(const matrix_row_t *p_prev, uint32_t now_us);
+#endif
 
 
 
@@ -28,6 +37,8 @@ void matrix_init(void)
 {
   memset(matrix, 0, sizeof(matrix));
   memset(raw_matrix, 0, sizeof(raw_matrix));
+  memset(edge_us, 0, sizeof(edge_us));
+  memset(edge_valid, 0, sizeof(edge_valid));
 
   debounce_init(MATRIX_ROWS);
   debounce_profile_apply_current();                                   // V251115R1: 매트릭스 초기화 직후 현재 디바운스 프로필 적용
@@ -49,37 +60,141 @@ matrix_row_t matrix_get_row(uint8_t row)
   return matrix[row];
 }
 
+// V261017R8: 디바운스된 상태를 만든 마지막 raw 엣지 시각을 반환한다.
+//            eager 계열은 실제 눌림/떼짐 프레임, defer 계열은 채터가 끝난 마지막 프레임 시각이 된다.
+// V261020R2: 기록된 엣지가 없으면 false. 0 us 는 micros() 랩어라운드에서 나올 수 있는 정상 값이다.
+bool matrix_get_edge_us(uint8_t row, uint8_t col, uint32_t *p_us)
+{
+  if (row >= MATRIX_ROWS || col >= MATRIX_COLS)
+  {
+    return false;
+  }
+  if ((edge_valid[row] & ((matrix_row_t)1 << col)) == 0)
+  {
+    return false;
+  }
+  *p_us = edge_us[row][col];
+  return true;
+}
+
 uint8_t matrix_scan(void)
 {
   bool         changed = false;
   uint32_t     pre_time = matrixInstrumentationCaptureStart();
+#if _DEF_ENABLE_USB_HID_TIMING_PROBE || defined(_USE_HW_LATENCY)
+  matrix_row_t cooked_prev[MATRIX_ROWS];
+#endif
 
-  _Static_assert(sizeof(matrix_row_t) == sizeof(uint16_t),
-                 "matrix_row_t must match keysReadColsBuf element size");
-
-  const volatile matrix_row_t *hw_matrix = (const volatile matrix_row_t *)keysPeekColsBuf();  // V250924R5: DMA 버퍼를 직접 참조하여 스캔 복사 비용 제거 (재검토: volatile 로 최신 스캔 보장)
-  // V251009R3: DMA 폴백 블록을 제거해 단일 경로로 단순화
+  _Static_assert(sizeof(matrix_row_t) <= sizeof(keys_col_t),
+                 "matrix_row_t must fit keysReadFrame element size");     // V261017R7: MATRIX_COLS > 16 이면 둘 다 32비트
 
-  for (uint32_t rows=0; rows<MATRIX_ROWS; rows++)
+  // V261017R4: DMA HT/TC 에서 게시한 완결 프레임이 바뀐 경우에만 raw 를 갱신한다.
+  //            새 프레임이 없어도 디바운스 카운터 만료 처리를 위해 debounce()는 계속 호출한다.
+  if (keysGetFrameSeq() != frame_seq)
   {
-    matrix_row_t new_state = (matrix_row_t)hw_matrix[rows];
+    keys_col_t frame[MATRIX_ROWS];
+    uint32_t   frame_us;
 
-    if (raw_matrix[rows] != new_state)
+    keysReadFrame(frame, MATRIX_ROWS, &frame_seq, &frame_us);
+
+    for (uint32_t rows=0; rows<MATRIX_ROWS; rows++)
     {
-      raw_matrix[rows] = new_state;
-      changed          = true;
+      matrix_row_t edges = raw_matrix[rows] ^ (matrix_row_t)frame[rows];
+
+      if (edges != 0)
+      {
+        raw_matrix[rows] = (matrix_row_t)frame[rows];
+        changed          = true;
+        while (edges)
+        {
+          uint8_t col = matrix_lowest_col(edges);
+
+          if (col < MATRIX_COLS)
+          {
+            edge_us[rows][col] = frame_us;                            // V261017R8: 바뀐 키만 엣지 시각 갱신
+            edge_valid[rows]  |= (matrix_row_t)1 << col;              // V261020R2
+          }
+          edges &= edges - 1;
+        }
+      }
     }
   }
+#if _DEF_ENABLE_USB_HID_TIMING_PROBE || defined(_USE_HW_LATENCY)
+  memcpy(cooked_prev, matrix, sizeof(matrix));
+#endif
 
   matrixInstrumentationLogScan(pre_time, is_info_enable);
 
   changed = debounce(raw_matrix, matrix, MATRIX_ROWS, changed);
+#ifdef _USE_HW_IDLE
+  // V261019R9: raw 와 확정값이 다르면 새 엣지 없이도 카운터 만료로 출력이 바뀔 수 있다.
+  //            1ms tick 까지 잠들면 125us/defer 만료가 tick 단위로 밀리므로 다음 루프를 바로 돌린다.
+  if (memcmp(raw_matrix, matrix, sizeof(matrix)) != 0)
+  {
+    idleSetEvent(IDLE_EVENT_DEBOUNCE);
+  }
+#endif
+#ifdef _USE_HW_LATENCY
+  if (changed && latencyIsEnabled())
+  {
+    uint32_t now_us = micros();
+
+    latencyBegin(now_us - matrix_oldest_edge_us(cooked_prev, now_us));   // V261019R2: 캡처 → 디바운스 구간은 엣지 프레임 기준
+  }
+#endif
+#if _DEF_ENABLE_USB_HID_TIMING_PROBE
+  if (changed)
+  {
+    pre_time = matrix_oldest_edge_us(cooked_prev, pre_time);          // V261017R8: 지연 계측 기준을 스캔 시작 대신 스위치 엣지로
+  }
+#endif
   matrixInstrumentationPropagate(changed, pre_time);
   matrix_info();
 
   return (uint8_t)changed;
 }
 
+#if _DEF_ENABLE_USB_HID_TIMING_PROBE || defined(_USE_HW_LATENCY)
+// V261017R8: 이번 스캔에서 디바운스 상태가 바뀐 키 중 가장 오래된 엣지 시각 (없으면 now_us)
+uint32_t matrix_oldest_edge_us(const matrix_row_t *p_prev, uint32_t now_us)
+{
+  uint32_t oldest_age = 0;
+
+  for (uint32_t rows=0; rows<MATRIX_ROWS; rows++)
+  {
+    matrix_row_t flips = p_prev[rows] ^ matrix[rows];
+
+    while (flips)
+    {
+      uint8_t col = matrix_lowest_col(flips);
+
+      if (col < MATRIX_COLS && (edge_valid[rows] & ((matrix_row_t)1 << col)))   // V261020R2: 기록 없는 키 제외
+      {
+        uint32_t age = now_us - edge_us[rows][col];
+
+        if (age > oldest_age && age < UINT32_MAX / 2)
+        {
+          oldest_age = age;
+        }
+      }
+      flips &= flips - 1;
+    }
+  }
+  return now_us - oldest_age;
+}
+#endif
+
+// V261020R1: 가장 낮은 set 비트의 열 번호. matrix_row_t 는 최대 32비트라 unsigned int 폭의 ctz 를 쓴다.
+//            __builtin_ctz(0) 은 정의되지 않으므로 0 이면 MATRIX_COLS(범위 밖)를 돌려준다.
+static inline uint8_t matrix_lowest_col(matrix_row_t bits)
+{
+  if (bits == 0)
+  {
+    return MATRIX_COLS;
+  }
+  return (uint8_t)__builtin_ctz((unsigned int)bits);
+}
+
 void matrix_info(void)
 {
 #if _DEF_ENABLE_MATRIX_TIMING_PROBE
@@ -146,15 +261,19 @@ void cliCmd(cli_args_t *args)
     {
       logPrintf("Scan Time : disabled\n");  // V251009R4: 빌드 타임으로 계측이 제외되었음을 안내
     }
+    logPrintf("Frame Seq : %lu (last %lu)\n", keysGetFrameSeq(), frame_seq);  // V261017R4: DMA 프레임 게시 진행 확인
+#ifdef _USE_HW_LATENCY
+    latencyPrintInfo();                                               // V261019R2: 캡처 → IN 완료 구간별 지연
+#endif
 
     ret = true;
   }
 
   if (args->argc == 2 && args->isStr(0, "row"))
   {
-    uint16_t data;
+    matrix_row_t data;
 
-    data = args->getData(1);
+    data = (matrix_row_t)args->getData(1);
 
     cliPrintf("row 0:0x%X\n", data);
     matrix[0] = data;
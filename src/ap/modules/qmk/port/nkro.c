@@ -0,0 +1,84 @@
+#include "nkro.h"
+
+#ifdef NKRO_ENABLE
+
+#include "action.h"
+#include "eeconfig.h"
+#include "keycode_config.h"
+#include "via.h"
+
+
+void nkro_set_enable(bool enable)
+{
+  if (keymap_config.nkro == enable)
+  {
+    return;
+  }
+
+  clear_keyboard();                                             // 전환 전 현재 리포트 형식으로 모든 키를 해제해 고착 방지
+  keymap_config.nkro = enable;
+  eeconfig_update_keymap(keymap_config.raw);
+}
+
+bool nkro_is_enabled(void)
+{
+  return keymap_config.nkro;
+}
+
+// V261021R3: 다른 채널 처리기(bootmode.c 등)와 같이 저장 명령은 길이와 무관하게 받고,
+//            짧은 패킷·알 수 없는 value ID/명령은 id_unhandled 로 응답한다.
+void via_qmk_usb_nkro_command(uint8_t *data, uint8_t length)
+{
+  if (data == NULL)
+  {
+    return;
+  }
+
+  uint8_t *command_id = &(data[0]);
+
+  if ((*command_id != id_custom_save) && length < 4)
+  {
+    *command_id = id_unhandled;
+    return;
+  }
+
+  uint8_t *value_id   = &(data[2]);
+  uint8_t *value_data = &(data[3]);
+
+  switch (*command_id)
+  {
+    case id_custom_set_value:
+    {
+      if (*value_id != id_qmk_usb_nkro_toggle)
+      {
+        *command_id = id_unhandled;
+        break;
+      }
+      nkro_set_enable(value_data[0] != 0U);
+      value_data[0] = (uint8_t)nkro_is_enabled();
+      break;
+    }
+
+    case id_custom_get_value:
+    {
+      if (*value_id != id_qmk_usb_nkro_toggle)
+      {
+        *command_id = id_unhandled;
+        break;
+      }
+      value_data[0] = (uint8_t)nkro_is_enabled();
+      break;
+    }
+
+    case id_custom_save:
+    {
+      break;                                                    // 토글 시 eeconfig_update_keymap() 으로 이미 저장됨
+    }
+
+    default:
+      *command_id = id_unhandled;
+      break;
+  }
+}
+
+#endif
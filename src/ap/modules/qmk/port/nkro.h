@@ -0,0 +1,19 @@
+#pragma once
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include QMK_KEYMAP_CONFIG_H
+
+// V261018R1: NKRO 런타임 토글 (VIA USB POLLING 채널 value ID 4, keymap_config.nkro 에 저장)
+#ifdef NKRO_ENABLE
+void nkro_set_enable(bool enable);
+bool nkro_is_enabled(void);
+void via_qmk_usb_nkro_command(uint8_t *data, uint8_t length);
+#else
+static inline void via_qmk_usb_nkro_command(uint8_t *data, uint8_t length)
+{
+  (void)data;
+  (void)length;
+}
+#endif
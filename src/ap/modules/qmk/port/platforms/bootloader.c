@@ -38,10 +38,7 @@ bool bootloader_jump_deferred(void)
 
 void mcu_reset(void)
 {
-  for (int i=0; i<32; i++)
-  {
-    eeprom_update();
-  }
+  eeprom_flush_pending();                                       // V261019R4: 비차단 쓰기는 호출마다 한 페이지씩이라 리셋 전 모두 기록
 
   if (mcu_reset_deferred() == true)
   {
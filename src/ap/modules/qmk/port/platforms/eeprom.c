@@ -5,57 +5,257 @@
 #include "qmk/quantum/eeconfig.h"                  // V251112R3: AUTO_FACTORY_RESET/VIA 공용 초기화 루틴
 #include "qmk/port/usb_monitor.h"                  // V251112R5: USB 모니터 기본값 적용
 #include "qmk/port/port.h"
-
-
-#define EEPROM_WRITE_Q_BUF_MAX         (TOTAL_EEPROM_BYTE_COUNT + 1)
+#include "eeprom_wl.h"                             // V261019R6: 고빈도 구간 QSPI 웨어 레벨링
+
+
+// ---------------------------------------------------------------------------
+// [EEPROM Write-back] V261019R3
+//   - V261019R2 까지는 바이트마다 {addr, data} 를 4096 엔트리 링(16KB)에 넣고 eeprom_update() 가
+//     연속 구간을 다시 찾아냈다. 링이 차면 2ms 재시도 후 직접 쓰기로 빠졌다.
+//   - 지금은 eeprom_buf 미러를 그대로 캐시로 쓰고 32B 페이지마다 더티 비트와 더티 구간(lo~hi)만 둔다.
+//     쓰기는 미러 갱신 + 비트/구간 표시(O(1))이고, 같은 바이트를 여러 번 써도 한 번만 기록된다.
+//   - 플러시는 낮은 주소의 더티 페이지부터 구간을 한 번의 페이지 쓰기로 내보낸다.
+//     더티가 아닌 페이지는 미러 == 칩이므로 값이 같은 쓰기는 표시하지 않는다.
+//   - 쓰기는 메인 루프(VIA/QMK)에서만 일어나므로 잠금 없이 둔다.
+//   - V261019R4: 기록은 드라이버의 비차단 페이지 쓰기로 넘긴다. eeprom_update() 는 끝난 페이지를 확인하고
+//     엔진이 비었을 때 다음 더티 페이지 하나를 시작만 한다 (100us 슬라이스와 버스트 추가 호출 제거).
+//     시작한 페이지는 더티 비트를 바로 내리고 엔진이 사본을 들고 간다. 그 사이 같은 페이지에 새로 쓰면
+//     다시 더티가 되고, 실패하면 보냈던 구간을 다시 더티로 표시한다.
+//   - V261019R5: 부팅 때 4KB 전체를 바이트 단위로 읽고 나서야 스캔을 시작했다 (hw.c 와 qmkInit() 에서 두 번).
+//     지금 eeprom_init() 은 eeconfig 헤더 ~ 기본 레이어 키맵(KB/USER/VIA 블록 포함)만 순차 읽기로 먼저 채우고,
+//     나머지 레이어/매크로는 eeprom_update() 가 드라이버 비동기 읽기로 EEPROM_LOAD_CHUNK_PAGES 씩 흘려 읽는다.
+//     아직 없는 페이지에 접근하면 그 페이지 하나만 블로킹으로 읽는다. 적재가 끝나면 load_done 하나로 검사를 건너뛴다.
+//   - V261019R6: _USE_HW_EEPROM_WL 이면 RGB/토글/BootMode 같은 고빈도 구간 쓰기는 더티 페이지 대신
+//     eeprom_wl.c 의 플래시 로그로 간다. 우선 적재 직후 플래시 값을 미러에 덮어쓰고, 끌 때는 그 구간을 I2C 로 되돌려 쓴다.
+// ---------------------------------------------------------------------------
 #define EEPROM_WRITE_PAGE_SIZE         32          // V251112R5: 외부 EEPROM 페이지 크기
-#define EEPROM_WRITE_SLICE_MAX_US      100         // V251112R5: 8 kHz 루프당 100us 안에서만 실 기록
-#define EEPROM_WRITE_QUEUE_WAIT_MS     2           // V251112R2: 큐 가득 참 재시도 대기 시간
+#define EEPROM_WRITE_PAGE_MAX          (TOTAL_EEPROM_BYTE_COUNT / EEPROM_WRITE_PAGE_SIZE)
+#define EEPROM_WRITE_MAP_WORDS         ((EEPROM_WRITE_PAGE_MAX + 31) / 32)
 #define EEPROM_UPDATE_BLOCK_CHUNK      64          // V251112R2: 고정 버퍼로 블록 비교
-#define EEPROM_WRITE_BURST_THRESHOLD   512         // V251112R5: 버스트 모드 진입 임계값(엔트리)
-#define EEPROM_WRITE_BURST_EXTRA_CALLS 2           // V251112R5: 버스트 모드 시 추가 실행 횟수
 #define EEPROM_FLUSH_STALL_TIMEOUT_MS  200         // V251124R5: flush 정체 감지 타임아웃(ms)
 #define EEPROM_FLUSH_MAX_SPIN          32000       // V251124R5: flush 정체 시 최대 반복 횟수
+#define EEPROM_LOAD_CHUNK_PAGES        4           // V261019R5: 백그라운드 읽기 1회 페이지 수 (128B)
+
+_Static_assert(TOTAL_EEPROM_BYTE_COUNT % EEPROM_WRITE_PAGE_SIZE == 0, "EEPROM size must be a multiple of the page size.");
+
+
+static uint8_t  eeprom_buf[TOTAL_EEPROM_BYTE_COUNT];
+static uint32_t dirty_map[EEPROM_WRITE_MAP_WORDS];                  // V261019R3: 페이지별 더티 비트
+static uint8_t  dirty_lo[EEPROM_WRITE_PAGE_MAX];                    // V261019R3: 페이지 안 더티 구간 [lo, hi]
+static uint8_t  dirty_hi[EEPROM_WRITE_PAGE_MAX];
+static uint32_t dirty_cnt        = 0;
+static uint32_t dirty_high_water = 0;
+
+typedef enum
+{
+  EEPROM_OP_NONE = 0,
+  EEPROM_OP_WRITE,                                                  // V261019R4: 더티 페이지 기록 중
+  EEPROM_OP_LOAD,                                                   // V261019R5: 미적재 페이지 읽는 중 (eeprom_buf 로 직접 수신)
+} eeprom_op_t;
+
+static eeprom_op_t inflight      = EEPROM_OP_NONE;                  // V261019R4: 드라이버가 처리 중인 요청
+static uint32_t inflight_addr    = 0;
+static uint32_t inflight_len     = 0;
+
+static uint32_t load_map[EEPROM_WRITE_MAP_WORDS];                   // V261019R5: 페이지별 적재 비트
+static uint32_t load_cnt         = 0;
+static bool     load_done        = false;
+static uint32_t load_prio_bytes  = 0;
+static uint32_t load_prio_us     = 0;
+static uint32_t load_done_ms     = 0;
+static uint32_t load_lazy_cnt    = 0;                               // 적재 전 접근으로 블로킹 읽은 페이지 수
+
+static bool eeprom_next_dirty_page(uint32_t *p_page)
+{
+  for (uint32_t i=0; i<EEPROM_WRITE_MAP_WORDS; i++)
+  {
+    if (dirty_map[i] != 0)
+    {
+      *p_page = i * 32U + (uint32_t)__builtin_ctz(dirty_map[i]);
+      return true;
+    }
+  }
+  return false;
+}
+
+static void eeprom_mark_dirty(uint32_t addr)
+{
+  uint32_t page   = addr / EEPROM_WRITE_PAGE_SIZE;
+  uint8_t  offset = (uint8_t)(addr % EEPROM_WRITE_PAGE_SIZE);
+  uint32_t bit    = 1UL << (page % 32U);
+
+  if ((dirty_map[page / 32U] & bit) == 0)
+  {
+    dirty_map[page / 32U] |= bit;
+    dirty_lo[page] = offset;
+    dirty_hi[page] = offset;
+    dirty_cnt++;
+    if (dirty_cnt > dirty_high_water)
+    {
+      dirty_high_water = dirty_cnt;                                 // V251112R2: 하이워터 추적 (페이지 단위)
+    }
+    return;
+  }
+  if (offset < dirty_lo[page])
+  {
+    dirty_lo[page] = offset;
+  }
+  if (offset > dirty_hi[page])
+  {
+    dirty_hi[page] = offset;
+  }
+}
+
+static void eeprom_clear_dirty(void)
+{
+  memset(dirty_map, 0, sizeof(dirty_map));
+  dirty_cnt = 0;
+}
+
+static bool eeprom_is_page_loaded(uint32_t page)
+{
+  return (load_map[page / 32U] & (1UL << (page % 32U))) != 0;
+}
+
+static void eeprom_mark_loaded(uint32_t page, uint32_t count)
+{
+  for (uint32_t i=page; i<page + count; i++)
+  {
+    if (eeprom_is_page_loaded(i) != true)
+    {
+      load_map[i / 32U] |= 1UL << (i % 32U);
+      load_cnt++;
+    }
+  }
+  if (load_cnt >= EEPROM_WRITE_PAGE_MAX && load_done != true)
+  {
+    load_done    = true;
+    load_done_ms = millis();
+    logPrintf("[OK] eeprom load : %u B ready at %lu ms (on-demand %lu pages)\n",
+              TOTAL_EEPROM_BYTE_COUNT, (unsigned long)load_done_ms, (unsigned long)load_lazy_cnt);
+  }
+}
+
+static void eeprom_load_pages(uint32_t page, uint32_t count)
+{
+  uint32_t addr = page * EEPROM_WRITE_PAGE_SIZE;
 
+  if (eepromRead(addr, &eeprom_buf[addr], count * EEPROM_WRITE_PAGE_SIZE) != true)
+  {
+    logPrintf("[!] eepromRead() fail addr=%lu len=%lu\n", (unsigned long)addr, (unsigned long)(count * EEPROM_WRITE_PAGE_SIZE));
+  }
+  eeprom_mark_loaded(page, count);                                  // 실패해도 V261019R4 이전처럼 미러 값으로 진행
+}
 
-typedef struct
+// 부팅 직후 먼저 필요한 구간: eeconfig 헤더, KB/USER 블록, VIA 헤더, 기본 레이어 키맵 (RGB 설정은 헤더 안)
+static uint32_t eeprom_priority_length(void)
 {
-  uint16_t addr;
-  uint8_t  data;
-} eeprom_write_t;
+#ifdef DYNAMIC_KEYMAP_ENABLE
+  uint32_t len = (uint32_t)(uintptr_t)dynamic_keymap_key_to_eeprom_address(1, 0, 0);   // V261020R9: uintptr_t 경유
+#else
+  uint32_t len = EECONFIG_SIZE;
+#endif
 
-static uint8_t        eeprom_buf[TOTAL_EEPROM_BYTE_COUNT];
-static qbuffer_t      write_q;
-static eeprom_write_t write_buf[EEPROM_WRITE_Q_BUF_MAX];
-static uint32_t       write_q_high_water = 0;
-static uint32_t       write_q_overflow   = 0;
-static uint8_t        page_batch_buf[EEPROM_WRITE_PAGE_SIZE];       // V251112R5: 페이지 단위 버퍼
+  len = (len + EEPROM_WRITE_PAGE_SIZE - 1U) / EEPROM_WRITE_PAGE_SIZE * EEPROM_WRITE_PAGE_SIZE;
+  return len < TOTAL_EEPROM_BYTE_COUNT ? len : TOTAL_EEPROM_BYTE_COUNT;
+}
 
-static bool eeprom_peek_queue_entry(uint32_t offset, eeprom_write_t *out_entry)
+// 끝난 요청 결과를 반영한다. false 면 아직 진행 중이거나 이번 루프는 쉬어 간다
+static bool eeprom_poll_inflight(void)
 {
-  uint32_t pending = qbufferAvailable(&write_q);
+  eeprom_async_state_t state;
+  eeprom_op_t          op = inflight;
 
-  if (offset >= pending)
+  if (op == EEPROM_OP_NONE)
+  {
+    return true;
+  }
+  state = eepromAsyncUpdate();
+  if (state == EEPROM_ASYNC_BUSY)
   {
     return false;
   }
+  inflight = EEPROM_OP_NONE;
 
-  uint32_t slot = (write_q.out + offset) % write_q.len;
+  if (op == EEPROM_OP_LOAD)
+  {
+    if (state == EEPROM_ASYNC_FAIL)
+    {
+      logPrintf("[!] eepromReadAsync() fail addr=%lu len=%lu\n", (unsigned long)inflight_addr, (unsigned long)inflight_len);
+      eeprom_load_pages(inflight_addr / EEPROM_WRITE_PAGE_SIZE, inflight_len / EEPROM_WRITE_PAGE_SIZE);   // 블로킹으로 한 번 더
+      return true;
+    }
+    eeprom_mark_loaded(inflight_addr / EEPROM_WRITE_PAGE_SIZE, inflight_len / EEPROM_WRITE_PAGE_SIZE);
+    return true;
+  }
 
-  *out_entry = write_buf[slot];                                      // V251112R8: 큐 엔트리를 안전하게 참조
+  if (state == EEPROM_ASYNC_FAIL)
+  {
+    logPrintf("[!] eepromWritePageAsync() fail addr=%lu len=%lu\n", (unsigned long)inflight_addr, (unsigned long)inflight_len);   // V251112R5: 페이지 쓰기 오류 감시
+    eeprom_mark_dirty(inflight_addr);                                  // V261019R4: 보냈던 구간을 다시 더티로
+    eeprom_mark_dirty(inflight_addr + inflight_len - 1U);
+    return false;                                                      // 재시도는 다음 루프
+  }
   return true;
 }
 
-static void eeprom_update_queue_watermark(void)
+static void eeprom_load_on_demand(uint32_t addr)
 {
-  uint32_t pending = qbufferAvailable(&write_q);
+  uint32_t page = addr / EEPROM_WRITE_PAGE_SIZE;
+
+  if (inflight == EEPROM_OP_LOAD)
+  {
+    eepromAsyncWait(EEPROM_FLUSH_STALL_TIMEOUT_MS);                    // 읽는 중인 구간일 수 있으니 끝을 기다린다
+    eeprom_poll_inflight();
+    if (eeprom_is_page_loaded(page) == true)
+    {
+      return;
+    }
+  }
+  load_lazy_cnt++;
+  eeprom_load_pages(page, 1);
+}
 
-  if (pending > write_q_high_water)
+static inline void eeprom_ensure_loaded(uint32_t addr)
+{
+  if (load_done != true && eeprom_is_page_loaded(addr / EEPROM_WRITE_PAGE_SIZE) != true)
   {
-    write_q_high_water = pending;
+    eeprom_load_on_demand(addr);
   }
 }
 
+// 다음 미적재 구간(최대 EEPROM_LOAD_CHUNK_PAGES 페이지)의 비동기 읽기를 시작한다
+static bool eeprom_stream_next(void)
+{
+  uint32_t page  = 0;
+  uint32_t count = 0;
+
+  while (page < EEPROM_WRITE_PAGE_MAX && eeprom_is_page_loaded(page) == true)
+  {
+    page++;
+  }
+  while (page + count < EEPROM_WRITE_PAGE_MAX && count < EEPROM_LOAD_CHUNK_PAGES && eeprom_is_page_loaded(page + count) != true)
+  {
+    count++;
+  }
+  if (count == 0)
+  {
+    return false;
+  }
+
+  uint32_t addr = page * EEPROM_WRITE_PAGE_SIZE;
+  uint32_t len  = count * EEPROM_WRITE_PAGE_SIZE;
+
+  if (eepromReadAsync(addr, &eeprom_buf[addr], len) != true)
+  {
+    return false;
+  }
+  inflight      = EEPROM_OP_LOAD;
+  inflight_addr = addr;
+  inflight_len  = len;
+  return true;
+}
+
 static void eeprom_restore_auto_factory_reset_sentinel(void)
 {
 #if defined(AUTO_FACTORY_RESET_FLAG_MAGIC) && defined(AUTO_FACTORY_RESET_COOKIE)
@@ -67,78 +267,137 @@ static void eeprom_restore_auto_factory_reset_sentinel(void)
 
 void eeprom_init(void)
 {
-  eepromRead(0, eeprom_buf, TOTAL_EEPROM_BYTE_COUNT);
-  qbufferCreateBySize(&write_q, (uint8_t *)write_buf, sizeof(eeprom_write_t), EEPROM_WRITE_Q_BUF_MAX); 
+  uint32_t pre_us = micros();
+  uint32_t length = eeprom_priority_length();
+
+  eepromAsyncWait(EEPROM_FLUSH_STALL_TIMEOUT_MS);                    // V261019R5: 재동기화 시 진행 중 요청 정리
+  eepromAsyncUpdate();
+  inflight = EEPROM_OP_NONE;
+  eeprom_clear_dirty();                                              // V261019R3: 미러 == 칩에서 시작
+  memset(load_map, 0, sizeof(load_map));
+  load_cnt      = 0;
+  load_done     = false;
+  load_lazy_cnt = 0;
+
+  eeprom_load_pages(0, length / EEPROM_WRITE_PAGE_SIZE);             // V261019R5: 우선 구간만 먼저, 나머지는 eeprom_update()
+  load_prio_bytes = length;
+  load_prio_us    = micros() - pre_us;
+  logPrintf("[  ] eeprom load : priority %lu B in %lu us, %lu B in background\n",
+            (unsigned long)load_prio_bytes,
+            (unsigned long)load_prio_us,
+            (unsigned long)(TOTAL_EEPROM_BYTE_COUNT - load_prio_bytes));
+#ifdef _USE_HW_EEPROM_WL
+  eeprom_wl_init(eeprom_buf);                                        // V261019R6: 고빈도 구간은 우선 구간 안에 있다
+#endif
 }
 
-void eeprom_update(void)
+#ifdef _USE_HW_EEPROM_WL
+bool eeprom_set_wl_enable(bool enable)
 {
-  uint32_t slice_begin = micros();
+  eeprom_wl_info_t info;
+  uint32_t         addr;
+  uint32_t         len;
 
-  while (qbufferAvailable(&write_q) > 0)
+  if (enable == eeprom_wl_is_enabled())
   {
-    if (eepromIsErasing() == true)
-    {
-      break;                                                          // V251112R8: 클린업 중이면 큐 제거 보류
-    }
+    return true;
+  }
+  if (enable == true)
+  {
+    return eeprom_wl_set_enable(true, eeprom_buf);                   // V261019R6: I2C 미러 값으로 플래시를 채운다
+  }
 
-    if ((uint32_t)(micros() - slice_begin) >= EEPROM_WRITE_SLICE_MAX_US)
+  eeprom_wl_get_info(&info);
+  eeprom_wl_set_enable(false, eeprom_buf);
+  for (uint32_t i=0; info.ready == true && eeprom_wl_get_span(i, &addr, &len) == true; i++)
+  {
+    for (uint32_t j=0; j<len; j++)
     {
-      break;
+      eeprom_mark_dirty(addr + j);                                   // V261019R6: 플래시에만 있던 값을 I2C 로
     }
+  }
+  return true;
+}
+#endif
 
-    eeprom_write_t first_entry;
-    if (eeprom_peek_queue_entry(0, &first_entry) != true)
+void eeprom_load_all(void)
+{
+  eepromAsyncWait(EEPROM_FLUSH_STALL_TIMEOUT_MS);                    // V261019R5: 남은 구간을 한 번에 (V261020R8: eeprom_apply_factory_defaults() 에서 사용)
+  eeprom_poll_inflight();
+  for (uint32_t page=0; page<EEPROM_WRITE_PAGE_MAX && load_done != true; page++)
+  {
+    if (eeprom_is_page_loaded(page) != true)
     {
-      break;
-    }
-
-    uint32_t chunk_addr    = first_entry.addr;
-    uint32_t page_end_addr = ((chunk_addr / EEPROM_WRITE_PAGE_SIZE) * EEPROM_WRITE_PAGE_SIZE) + EEPROM_WRITE_PAGE_SIZE;
-    uint32_t pending       = qbufferAvailable(&write_q);
-    uint8_t  chunk_len     = 0;
+      uint32_t count = 1;
 
-    while (chunk_len < pending && chunk_len < EEPROM_WRITE_PAGE_SIZE)
-    {
-      eeprom_write_t entry;
-      if (eeprom_peek_queue_entry(chunk_len, &entry) != true)
+      while (page + count < EEPROM_WRITE_PAGE_MAX && eeprom_is_page_loaded(page + count) != true)
       {
-        break;
+        count++;
       }
+      eeprom_load_pages(page, count);
+      page += count - 1U;
+    }
+  }
+}
 
-      if (entry.addr != (chunk_addr + chunk_len))
-      {
-        break;
-      }
-      if ((chunk_addr + chunk_len) >= page_end_addr)
-      {
-        break;
-      }
+bool eeprom_is_loaded(void)
+{
+  return load_done;
+}
 
-      page_batch_buf[chunk_len++] = entry.data;
-    }
+void eeprom_get_load_info(eeprom_load_info_t *p_info)
+{
+  p_info->prio_bytes = load_prio_bytes;
+  p_info->prio_us    = load_prio_us;
+  p_info->loaded     = load_cnt * EEPROM_WRITE_PAGE_SIZE;
+  p_info->done_ms    = load_done_ms;
+  p_info->lazy_cnt   = load_lazy_cnt;
+}
 
-    if (chunk_len == 0)
-    {
-      break;
-    }
+void eeprom_update(void)
+{
+  uint32_t page;
 
-    if (eepromWritePage(chunk_addr, page_batch_buf, chunk_len) != true)
-    {
-      if (eepromIsErasing() != true)
-      {
-        logPrintf("[!] eepromWritePage() fail addr=%lu len=%u\n", (unsigned long)chunk_addr, chunk_len);   // V251112R5: 페이지 쓰기 오류 감시
-      }
-      break;
-    }
+#ifdef _USE_HW_EEPROM_WL
+  eeprom_wl_update(eeprom_buf);                                      // V261019R6: 고빈도 구간 1개 (QSPI, I2C 와 별개)
+#endif
+  if (eeprom_poll_inflight() != true)
+  {
+    return;
+  }
+  if (load_done != true && eeprom_stream_next() == true)
+  {
+    return;                                                            // V261019R5: 적재를 먼저 끝낸다 (요청당 ~1.3ms, 32회)
+  }
+
+  if (eepromIsErasing() == true || eeprom_next_dirty_page(&page) != true)
+  {
+    return;                                                            // V251112R8: 클린업 중이면 기록 보류
+  }
+
+  uint32_t addr = page * EEPROM_WRITE_PAGE_SIZE + dirty_lo[page];
+  uint32_t len  = (uint32_t)dirty_hi[page] - dirty_lo[page] + 1U;
 
-    qbufferRead(&write_q, NULL, chunk_len);
+  if (eepromWritePageAsync(addr, &eeprom_buf[addr], len) != true)
+  {
+    return;
   }
+  dirty_map[page / 32U] &= ~(1UL << (page % 32U));                      // V261019R4: 엔진이 사본을 가져감
+  dirty_cnt--;
+  inflight      = EEPROM_OP_WRITE;
+  inflight_addr = addr;
+  inflight_len  = len;
 }
 
 bool eeprom_is_pending(void)
 {
-  return qbufferAvailable(&write_q) > 0;
+#ifdef _USE_HW_EEPROM_WL
+  if (eeprom_wl_is_pending() == true)
+  {
+    return true;
+  }
+#endif
+  return dirty_cnt > 0 || inflight == EEPROM_OP_WRITE;
 }
 
 bool eeprom_flush_pending(void)
@@ -146,12 +405,18 @@ bool eeprom_flush_pending(void)
   uint32_t last_progress_ms = millis();
   uint32_t stall_loops      = 0;
 
+#ifdef _USE_HW_EEPROM_WL
+  eeprom_wl_flush(eeprom_buf);                                       // V261019R6: 플래시 구간은 바로 끝난다
+#endif
   while (eeprom_is_pending())
   {
-    uint32_t pending_before = qbufferAvailable(&write_q);
+    uint32_t pending_before = eeprom_get_write_pending_count();
+    uint32_t loaded_before  = load_cnt;
+
+    eepromAsyncWait(EEPROM_FLUSH_STALL_TIMEOUT_MS);                    // V261019R4: 진행 중 페이지를 기다린 뒤 관찰
     eeprom_update();
 
-    if (qbufferAvailable(&write_q) < pending_before)
+    if (eeprom_get_write_pending_count() < pending_before || load_cnt > loaded_before)   // V261019R5: 적재 진행도 진행
     {
       last_progress_ms = millis();
       stall_loops      = 0;
@@ -163,8 +428,11 @@ bool eeprom_flush_pending(void)
     if ((millis() - last_progress_ms) >= EEPROM_FLUSH_STALL_TIMEOUT_MS ||
         stall_loops >= EEPROM_FLUSH_MAX_SPIN)
     {
-      logPrintf("[!] EEPROM flush stalled pending=%lu\n", (unsigned long)qbufferAvailable(&write_q));  // V251124R5: 연속 실패 시 무한 루프 방지
-      qbufferFlush(&write_q);
+      logPrintf("[!] EEPROM flush stalled pending=%lu pages\n", (unsigned long)eeprom_get_write_pending_count());  // V251124R5: 연속 실패 시 무한 루프 방지
+      eepromAsyncWait(EEPROM_FLUSH_STALL_TIMEOUT_MS);
+      eepromAsyncUpdate();
+      inflight = EEPROM_OP_NONE;
+      eeprom_clear_dirty();
       return false;
     }
   }
@@ -178,6 +446,7 @@ bool eeprom_apply_factory_defaults(bool restore_factory_reset_sentinel)
   {
     return false;
   }
+  eeprom_load_all();                                                       // V261020R8: 키맵/매크로 전체를 덮으므로 페이지별 블로킹 읽기 대신 한 번에 적재
 
   eeconfig_disable();
   eeconfig_init();
@@ -244,15 +513,22 @@ void eeprom_req_clean(void)
 
 uint8_t  eeprom_read_byte(const uint8_t *addr)
 {
-  return eeprom_buf[(uint32_t)addr];
+  uint32_t index = (uint32_t)(uintptr_t)addr;                         // V261020R9: uintptr_t 경유
+
+  if (index >= TOTAL_EEPROM_BYTE_COUNT)
+  {
+    return 0xFF;
+  }
+  eeprom_ensure_loaded(index);                                       // V261019R5: 미적재 페이지만 블로킹
+  return eeprom_buf[index];
 }
 
 uint16_t eeprom_read_word(const uint16_t *addr)
 {
   uint16_t ret = 0;
 
-  ret  = eeprom_buf[((uint32_t)addr) + 0] << 0;
-  ret |= eeprom_buf[((uint32_t)addr) + 1] << 8;
+  ret  = eeprom_read_byte((const uint8_t *)addr + 0) << 0;           // V261019R5: 페이지 경계/적재 검사 공용
+  ret |= eeprom_read_byte((const uint8_t *)addr + 1) << 8;
 
   return ret;
 }
@@ -282,44 +558,25 @@ void eeprom_read_block(void *buf, const void *addr, uint32_t len)
 
 void eeprom_write_byte(uint8_t *addr, uint8_t value)
 {
-  eeprom_write_t write_byte;
-  uint32_t       pre_time;
-  bool           is_enqueued = false;
-
-  eeprom_buf[(uint32_t)addr] = value;
-
-  write_byte.addr = (uint32_t)addr;
-  write_byte.data = value;
+  uint32_t index = (uint32_t)(uintptr_t)addr;                         // V261020R9: uintptr_t 경유
 
-  pre_time = millis();
-  while (is_enqueued != true)
+  if (index >= TOTAL_EEPROM_BYTE_COUNT)
   {
-    if (qbufferWrite(&write_q, (uint8_t *)&write_byte, 1))
-    {
-      is_enqueued = true;
-      eeprom_update_queue_watermark();                                 // V251112R2: 큐 하이워터 추적
-      break;
-    }
-
-    eeprom_update();                                                   // V251112R2: 큐가 가득 찼다면 즉시 비우기
-    if (millis()-pre_time >= EEPROM_WRITE_QUEUE_WAIT_MS)
-    {
-      break;
-    }
+    return;
   }
-
-  if (is_enqueued != true)
+  eeprom_ensure_loaded(index);                                       // V261019R5: 비교 전에 칩 값을 미러로
+  if (eeprom_buf[index] == value)
   {
-    write_q_overflow++;
-    if (eepromWriteByte(write_byte.addr, write_byte.data) != true)
-    {
-      logPrintf("[!] EEPROM write queue overflow (addr=%lu) direct-write fail\n", write_byte.addr); // V251112R2 큐 오버플로 감시
-    }
-    else
-    {
-      logPrintf("[ ] EEPROM write queue overflow (addr=%lu) flushed inline\n", write_byte.addr);     // V251112R2 큐 오버플로 감시
-    }
+    return;                                                          // V261019R3: 미러와 같으면 칩도 같은 값
+  }
+  eeprom_buf[index] = value;
+#ifdef _USE_HW_EEPROM_WL
+  if (eeprom_wl_mark(index) == true)
+  {
+    return;                                                          // V261019R6: 고빈도 구간은 플래시 로그로
   }
+#endif
+  eeprom_mark_dirty(index);
 }
 
 void eeprom_write_word(uint16_t *addr, uint16_t value)
@@ -402,25 +659,16 @@ void eeprom_update_block(const void *buf, void *addr, size_t len)
 
 uint32_t eeprom_get_write_pending_count(void)
 {
-  return qbufferAvailable(&write_q);
+  return dirty_cnt + (inflight == EEPROM_OP_WRITE ? 1U : 0U);   // V261019R3: 더티 페이지 수 (V261019R4: 기록 중 포함)
 }
 
 uint32_t eeprom_get_write_pending_max(void)
 {
-  return write_q_high_water;
+  return dirty_high_water;
 }
 
 uint32_t eeprom_get_write_overflow_count(void)
 {
-  return write_q_overflow;
+  return 0;                                                          // V261019R3: 캐시는 넘치지 않아 직접 쓰기가 없다
 }
 
-bool eeprom_is_burst_mode_active(void)
-{
-  return qbufferAvailable(&write_q) >= EEPROM_WRITE_BURST_THRESHOLD;     // V251112R5: 버스트 모드 임계값 비교
-}
-
-uint8_t eeprom_get_burst_extra_calls(void)
-{
-  return eeprom_is_burst_mode_active() ? EEPROM_WRITE_BURST_EXTRA_CALLS : 0;  // V251112R5: 추가 실행 횟수 산출
-}
@@ -4,10 +4,26 @@
 
 
 #include "hw_def.h"
+#include "eeprom_wl.h"
 
 
+typedef struct
+{
+  uint32_t prio_bytes;                                               // eeprom_init() 이 먼저 읽은 바이트
+  uint32_t prio_us;                                                  // 그 시간
+  uint32_t loaded;                                                   // 지금까지 적재된 바이트
+  uint32_t done_ms;                                                  // 전체 적재 완료 시각 (부팅 기준, 0 = 진행 중)
+  uint32_t lazy_cnt;                                                 // 적재 전 접근으로 블로킹 읽은 페이지 수
+} eeprom_load_info_t;                                                // V261019R5: 우선/지연 적재 계측
+
 
 void     eeprom_init(void);
+void     eeprom_load_all(void);                                      // V261019R5: 남은 구간 블로킹 적재
+bool     eeprom_is_loaded(void);
+void     eeprom_get_load_info(eeprom_load_info_t *p_info);
+#ifdef _USE_HW_EEPROM_WL
+bool     eeprom_set_wl_enable(bool enable);                          // V261019R6: 끄면 고빈도 구간을 I2C 로 되돌려 쓴다
+#endif
 void     eeprom_update(void);
 bool     eeprom_is_pending(void);
 bool     eeprom_flush_pending(void);
@@ -29,5 +45,3 @@ bool     eeprom_apply_factory_defaults(bool restore_factory_reset_sentinel);  //
 uint32_t eeprom_get_write_pending_count(void);                       // V251112R2: EEPROM 큐 현재 사용량 조회
 uint32_t eeprom_get_write_pending_max(void);                         // V251112R2: 부트 후 최고 사용량 조회
 uint32_t eeprom_get_write_overflow_count(void);                      // V251112R2: 직접 기록된 횟수 조회
-bool     eeprom_is_burst_mode_active(void);                          // V251112R5: 버스트 모드 상태 확인
-uint8_t  eeprom_get_burst_extra_calls(void);                         // V251112R5: 버스트 모드 시 추가 실행 횟수
@@ -0,0 +1,401 @@
+#include "quantum.h"
+#include "eeprom_wl.h"
+
+
+#ifdef _USE_HW_EEPROM_WL
+#include "qspi.h"
+#include "qspi/w25q16jv.h"
+#include "wear_leveling.h"
+#include "wear_leveling_internal.h"
+#include "qmk/port/port.h"
+
+
+// ---------------------------------------------------------------------------
+// [EEPROM Wear-leveling] V261019R6
+//   - RGB 모드/HSV, 키맵 토글(NKRO 등), 인디케이터, KKUK, BootMode, USB 모니터 토글은 키 하나로 여러 번
+//     바뀌는데 매번 I2C 페이지 쓰기(전송 + tWR 5ms)와 EEPROM 셀 수명을 쓴다.
+//   - 이 구간들만 QSPI W25Q16 끝 8KB 에 QMK wear_leveling 로그(8B 엔트리 추가 기록, 로그가 차면 정리)로 보낸다.
+//     미러(eeprom_buf)는 그대로 진실이고, 구간 기록은 eeprom_update() 에서 한 루프에 하나씩 한다.
+//   - 논리 영역 64B = 헤더(magic, 구간 배치 서명, 부팅 횟수) + 구간을 빈틈없이 이어 붙인 값.
+//     헤더가 맞으면 부팅 때 미러 위에 덮어쓰고, 다르면(첫 부팅/배치 변경/끈 적 있음) 미러로 다시 채운다.
+//   - 내부 플래시(64KB)는 펌웨어가 채우고 있어 QSPI 를 쓴다. NOR 지운 값 0xFF 는 보수로 0 으로 읽힌다.
+//   - 정리(서브섹터 2개 지우기 + 64B 기록)는 wear_leveling 안에서 동기로 일어난다 (~1000 엔트리마다 한 번).
+// ---------------------------------------------------------------------------
+#define EEPROM_WL_MAGIC                0x31574C45  // "ELW1"
+#define EEPROM_WL_OFFSET_MAGIC         0
+#define EEPROM_WL_OFFSET_SIG           4
+#define EEPROM_WL_OFFSET_BOOT          8
+#define EEPROM_WL_OFFSET_DATA          12
+#define EEPROM_WL_LOG_BEGIN            ((WEAR_LEVELING_LOGICAL_SIZE) + 8)   // 정리 영역 + FNV1a_64
+
+_Static_assert(HW_EEPROM_WL_QSPI_ADDR % W25Q16JV_SUBSECTOR_SIZE == 0, "WL area must start on a 4KB subsector.");
+_Static_assert((WEAR_LEVELING_BACKING_SIZE) % W25Q16JV_SUBSECTOR_SIZE == 0, "WL area must be whole 4KB subsectors.");
+_Static_assert(HW_EEPROM_WL_QSPI_ADDR + (WEAR_LEVELING_BACKING_SIZE) <= W25Q16JV_FLASH_SIZE, "WL area exceeds the QSPI flash.");
+
+
+typedef struct
+{
+  uint16_t addr;                                                     // EEPROM 주소
+  uint8_t  len;
+} eeprom_wl_span_t;
+
+static const eeprom_wl_span_t span_tbl[] =
+{
+  {(uint16_t)(uintptr_t)EECONFIG_KEYMAP,                2},          // keymap_config (NKRO/스왑 토글)
+#ifdef RGBLIGHT_ENABLE
+  {(uint16_t)(uintptr_t)EECONFIG_RGBLIGHT,              4},          // 모드/HSV
+  {(uint16_t)(uintptr_t)EECONFIG_RGBLIGHT_EXTENDED,     1},          // 속도
+#endif
+#if (EECONFIG_USER_DATA_SIZE) > 0
+  {(uint16_t)(uintptr_t)EECONFIG_USER_INDICATOR,        8},
+  {(uint16_t)(uintptr_t)EECONFIG_USER_KKUK,             4},
+  {(uint16_t)(uintptr_t)EECONFIG_USER_BOOTMODE,         4},
+  {(uint16_t)(uintptr_t)EECONFIG_USER_USB_INSTABILITY,  4},          // USB 모니터 토글
+#endif
+};
+
+#define EEPROM_WL_SPAN_MAX             (sizeof(span_tbl) / sizeof(span_tbl[0]))
+
+_Static_assert(EEPROM_WL_SPAN_MAX <= 32, "WL span bitmap is 32 bits.");
+
+static uint8_t  span_offset[EEPROM_WL_SPAN_MAX];                    // 논리 영역 위치
+static uint32_t span_dirty       = 0;                               // 구간별 미기록 비트
+static uint32_t span_sig         = 0;
+static bool     is_enable        = HW_EEPROM_WL_ENABLE_DEFAULT;
+static bool     is_ready         = false;
+
+static uint32_t wl_boot_cnt      = 0;
+static uint32_t wl_seed_cnt      = 0;
+static uint32_t wl_write_cnt     = 0;
+static uint32_t wl_entry_cnt     = 0;
+static uint32_t wl_log_used      = 0;
+static uint32_t wl_consolidate   = 0;
+static uint32_t wl_erase_cnt     = 0;
+static uint32_t wl_commit_max_us = 0;
+static uint32_t wl_fail_cnt      = 0;
+
+
+// Backing store: QSPI, 지운 상태(0xFF)를 0 으로 보이도록 보수로 기록/읽기
+bool backing_store_init(void)
+{
+  return qspiIsInit();
+}
+
+bool backing_store_unlock(void)
+{
+  return true;
+}
+
+bool backing_store_lock(void)
+{
+  return true;
+}
+
+bool backing_store_erase(void)
+{
+  for (uint32_t addr=0; addr<(WEAR_LEVELING_BACKING_SIZE); addr+=W25Q16JV_SUBSECTOR_SIZE)
+  {
+    if (qspiEraseBlock(HW_EEPROM_WL_QSPI_ADDR + addr) != true)
+    {
+      return false;
+    }
+    wl_erase_cnt++;
+  }
+  wl_log_used = 0;
+  return true;
+}
+
+bool backing_store_write(uint32_t address, backing_store_int_t value)
+{
+  backing_store_int_t data = ~value;
+
+  if (qspiWrite(HW_EEPROM_WL_QSPI_ADDR + address, (uint8_t *)&data, sizeof(data)) != true)
+  {
+    return false;
+  }
+  if (address >= EEPROM_WL_LOG_BEGIN)
+  {
+    wl_entry_cnt++;
+    wl_log_used = address + sizeof(data) - EEPROM_WL_LOG_BEGIN;
+  }
+  return true;
+}
+
+bool backing_store_write_bulk(uint32_t address, backing_store_int_t *values, size_t item_count)
+{
+  backing_store_int_t data[(WEAR_LEVELING_LOGICAL_SIZE) / sizeof(backing_store_int_t)];
+
+  while (item_count > 0)
+  {
+    size_t count = item_count < (sizeof(data) / sizeof(data[0])) ? item_count : (sizeof(data) / sizeof(data[0]));
+
+    for (size_t i=0; i<count; i++)
+    {
+      data[i] = ~values[i];
+    }
+    if (qspiWrite(HW_EEPROM_WL_QSPI_ADDR + address, (uint8_t *)data, count * sizeof(data[0])) != true)
+    {
+      return false;
+    }
+    address    += count * sizeof(data[0]);
+    values     += count;
+    item_count -= count;
+  }
+  return true;
+}
+
+bool backing_store_read(uint32_t address, backing_store_int_t *value)
+{
+  backing_store_int_t data;
+
+  if (qspiRead(HW_EEPROM_WL_QSPI_ADDR + address, (uint8_t *)&data, sizeof(data)) != true)
+  {
+    return false;
+  }
+  *value = ~data;
+  if (address >= EEPROM_WL_LOG_BEGIN && *value != 0)
+  {
+    wl_log_used = address + sizeof(data) - EEPROM_WL_LOG_BEGIN;      // 부팅 시 로그 재생 위치
+  }
+  return true;
+}
+
+bool backing_store_read_bulk(uint32_t address, backing_store_int_t *values, size_t item_count)
+{
+  if (qspiRead(HW_EEPROM_WL_QSPI_ADDR + address, (uint8_t *)values, item_count * sizeof(values[0])) != true)
+  {
+    return false;
+  }
+  for (size_t i=0; i<item_count; i++)
+  {
+    values[i] = ~values[i];
+  }
+  return true;
+}
+
+
+static int32_t eeprom_wl_find(uint32_t addr)
+{
+  for (uint32_t i=0; i<EEPROM_WL_SPAN_MAX; i++)
+  {
+    if (addr >= span_tbl[i].addr && addr < (uint32_t)span_tbl[i].addr + span_tbl[i].len)
+    {
+      return (int32_t)i;
+    }
+  }
+  return -1;
+}
+
+static bool eeprom_wl_write(uint32_t offset, const void *p_data, uint32_t len)
+{
+  uint32_t               pre_us = micros();
+  wear_leveling_status_t status = wear_leveling_write(offset, p_data, len);
+  uint32_t               exe_us = micros() - pre_us;
+
+  if (exe_us > wl_commit_max_us)
+  {
+    wl_commit_max_us = exe_us;
+  }
+  if (status == WEAR_LEVELING_FAILED)
+  {
+    wl_fail_cnt++;
+    logPrintf("[!] eeprom wl : write fail offset=%lu len=%lu\n", (unsigned long)offset, (unsigned long)len);
+    return false;
+  }
+  if (status == WEAR_LEVELING_CONSOLIDATED)
+  {
+    wl_consolidate++;
+  }
+  wl_write_cnt++;
+  return true;
+}
+
+// I2C 미러가 최신일 때 (첫 부팅, 배치 변경, 다시 켬) 플래시 구간을 미러로 채운다
+static void eeprom_wl_seed(const uint8_t *p_mirror)
+{
+  uint32_t magic = EEPROM_WL_MAGIC;
+
+  for (uint32_t i=0; i<EEPROM_WL_SPAN_MAX; i++)
+  {
+    eeprom_wl_write(span_offset[i], &p_mirror[span_tbl[i].addr], span_tbl[i].len);
+  }
+  eeprom_wl_write(EEPROM_WL_OFFSET_SIG, &span_sig, sizeof(span_sig));
+  eeprom_wl_write(EEPROM_WL_OFFSET_MAGIC, &magic, sizeof(magic));       // 값 다음에 magic (중간에 꺼지면 다시 채움)
+  span_dirty = 0;
+  wl_seed_cnt++;
+}
+
+static bool eeprom_wl_open(void)
+{
+  uint32_t offset = EEPROM_WL_OFFSET_DATA;
+
+  span_sig = (uint32_t)EEPROM_WL_SPAN_MAX;
+  for (uint32_t i=0; i<EEPROM_WL_SPAN_MAX; i++)
+  {
+    span_offset[i] = (uint8_t)offset;
+    offset        += span_tbl[i].len;
+    span_sig       = span_sig * 31U + ((uint32_t)span_tbl[i].addr << 8) + span_tbl[i].len;
+  }
+  span_dirty = 0;
+  if (offset > (WEAR_LEVELING_LOGICAL_SIZE))
+  {
+    logPrintf("[!] eeprom wl : %lu B spans exceed %u B\n", (unsigned long)offset, (WEAR_LEVELING_LOGICAL_SIZE));
+    return false;
+  }
+  if (wear_leveling_init() == WEAR_LEVELING_FAILED)
+  {
+    logPrintf("[!] eeprom wl : qspi 0x%lX init fail\n", (unsigned long)HW_EEPROM_WL_QSPI_ADDR);
+    return false;
+  }
+  return true;
+}
+
+void eeprom_wl_init(uint8_t *p_mirror)
+{
+  uint32_t magic = 0;
+  uint32_t sig   = 0;
+
+  is_ready = false;
+  if (is_enable != true)
+  {
+    return;                                                          // 꺼져 있으면 I2C 가 전체 원본
+  }
+  is_ready = eeprom_wl_open();
+  if (is_ready != true)
+  {
+    return;
+  }
+
+  wear_leveling_read(EEPROM_WL_OFFSET_MAGIC, &magic, sizeof(magic));
+  wear_leveling_read(EEPROM_WL_OFFSET_SIG, &sig, sizeof(sig));
+  if (magic == EEPROM_WL_MAGIC && sig == span_sig)
+  {
+    for (uint32_t i=0; i<EEPROM_WL_SPAN_MAX; i++)
+    {
+      wear_leveling_read(span_offset[i], &p_mirror[span_tbl[i].addr], span_tbl[i].len);
+    }
+  }
+  else
+  {
+    eeprom_wl_seed(p_mirror);
+  }
+
+  wear_leveling_read(EEPROM_WL_OFFSET_BOOT, &wl_boot_cnt, sizeof(wl_boot_cnt));
+  wl_boot_cnt++;
+  eeprom_wl_write(EEPROM_WL_OFFSET_BOOT, &wl_boot_cnt, sizeof(wl_boot_cnt));   // 런타임 카운터: 부팅 횟수
+  logPrintf("[OK] eeprom wl : qspi 0x%lX %u B, %lu spans, log %lu/%u B, boot %lu%s\n",
+            (unsigned long)HW_EEPROM_WL_QSPI_ADDR,
+            (WEAR_LEVELING_BACKING_SIZE),
+            (unsigned long)EEPROM_WL_SPAN_MAX,
+            (unsigned long)wl_log_used,
+            (WEAR_LEVELING_BACKING_SIZE) - EEPROM_WL_LOG_BEGIN,
+            (unsigned long)wl_boot_cnt,
+            magic == EEPROM_WL_MAGIC && sig == span_sig ? "" : " (seeded)");
+}
+
+bool eeprom_wl_mark(uint32_t addr)
+{
+  int32_t index;
+
+  if (is_ready != true || addr >= EECONFIG_SIZE)
+  {
+    return false;
+  }
+  index = eeprom_wl_find(addr);
+  if (index < 0)
+  {
+    return false;
+  }
+  span_dirty |= 1UL << index;
+  return true;
+}
+
+bool eeprom_wl_update(const uint8_t *p_mirror)
+{
+  uint32_t index;
+
+  if (span_dirty == 0)
+  {
+    return false;
+  }
+  index       = (uint32_t)__builtin_ctz(span_dirty);
+  span_dirty &= ~(1UL << index);
+  eeprom_wl_write(span_offset[index], &p_mirror[span_tbl[index].addr], span_tbl[index].len);   // 실패는 계수만 (미러 값은 유지)
+  return true;
+}
+
+void eeprom_wl_flush(const uint8_t *p_mirror)
+{
+  while (eeprom_wl_update(p_mirror) == true)
+  {
+  }
+}
+
+bool eeprom_wl_is_pending(void)
+{
+  return span_dirty != 0;
+}
+
+bool eeprom_wl_is_enabled(void)
+{
+  return is_enable;
+}
+
+// 끌 때는 플래시 헤더를 지워 다음 부팅이 I2C 값으로 다시 채우게 하고, 켤 때는 미러로 채운다.
+// 끌 때 I2C 로 되돌려 쓰는 것은 호출자(eeprom.c)가 eeprom_wl_get_span() 으로 한다.
+bool eeprom_wl_set_enable(bool enable, uint8_t *p_mirror)
+{
+  uint32_t magic = 0;
+
+  if (enable == true)
+  {
+    is_enable = true;
+    if (is_ready != true)
+    {
+      is_ready = eeprom_wl_open();
+      if (is_ready == true)
+      {
+        eeprom_wl_seed(p_mirror);
+      }
+    }
+    return is_ready;
+  }
+
+  if (is_ready == true)
+  {
+    eeprom_wl_flush(p_mirror);
+    eeprom_wl_write(EEPROM_WL_OFFSET_MAGIC, &magic, sizeof(magic));
+  }
+  is_enable = false;
+  is_ready  = false;
+  return true;
+}
+
+bool eeprom_wl_get_span(uint32_t index, uint32_t *p_addr, uint32_t *p_len)
+{
+  if (index >= EEPROM_WL_SPAN_MAX)
+  {
+    return false;
+  }
+  *p_addr = span_tbl[index].addr;
+  *p_len  = span_tbl[index].len;
+  return true;
+}
+
+void eeprom_wl_get_info(eeprom_wl_info_t *p_info)
+{
+  p_info->enable          = is_enable;
+  p_info->ready           = is_ready;
+  p_info->boot_cnt        = wl_boot_cnt;
+  p_info->seed_cnt        = wl_seed_cnt;
+  p_info->write_cnt       = wl_write_cnt;
+  p_info->entry_cnt       = wl_entry_cnt;
+  p_info->log_used        = wl_log_used;
+  p_info->log_size        = (WEAR_LEVELING_BACKING_SIZE) - EEPROM_WL_LOG_BEGIN;
+  p_info->consolidate_cnt = wl_consolidate;
+  p_info->erase_cnt       = wl_erase_cnt;
+  p_info->commit_max_us   = wl_commit_max_us;
+  p_info->fail_cnt        = wl_fail_cnt;
+}
+
+#endif
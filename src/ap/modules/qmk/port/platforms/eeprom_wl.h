@@ -0,0 +1,38 @@
+// Copyright 2018-2022 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+#pragma once
+
+
+#include "hw_def.h"
+
+
+#ifdef _USE_HW_EEPROM_WL
+
+typedef struct
+{
+  bool     enable;                                                   // 고빈도 구간을 플래시로 보내는 중
+  bool     ready;                                                    // wear_leveling_init() 성공
+  uint32_t boot_cnt;                                                 // 플래시 로그에 누적한 부팅 횟수
+  uint32_t seed_cnt;                                                 // I2C 미러로 다시 채운 횟수
+  uint32_t write_cnt;                                                // 구간 기록 (wear_leveling_write) 수
+  uint32_t entry_cnt;                                                // 로그 엔트리 프로그램 수
+  uint32_t log_used;                                                 // 현재 로그 사용 바이트
+  uint32_t log_size;                                                 // 로그 영역 바이트
+  uint32_t consolidate_cnt;                                          // 로그가 차서 정리한 횟수
+  uint32_t erase_cnt;                                                // 4KB 서브섹터 지우기 수
+  uint32_t commit_max_us;                                            // 구간 기록 1회 최대 시간 (정리 포함)
+  uint32_t fail_cnt;
+} eeprom_wl_info_t;                                                  // V261019R6: 웨어 레벨링 계측
+
+
+void     eeprom_wl_init(uint8_t *p_mirror);
+bool     eeprom_wl_mark(uint32_t addr);
+bool     eeprom_wl_update(const uint8_t *p_mirror);
+void     eeprom_wl_flush(const uint8_t *p_mirror);
+bool     eeprom_wl_is_pending(void);
+bool     eeprom_wl_is_enabled(void);
+bool     eeprom_wl_set_enable(bool enable, uint8_t *p_mirror);
+bool     eeprom_wl_get_span(uint32_t index, uint32_t *p_addr, uint32_t *p_len);
+void     eeprom_wl_get_info(eeprom_wl_info_t *p_info);
+
+#endif
@@ -1,4 +1,5 @@
 #include "timer.h"
+#include "micros.h"
 
 
 
@@ -35,4 +36,14 @@ uint16_t timer_elapsed(uint16_t last)
 uint32_t timer_elapsed32(uint32_t last)
 {
   return millis()-last;
-}
\ No newline at end of file
+}
+
+uint32_t timer_read_us(void)
+{
+  return micros();
+}
+
+uint32_t timer_elapsed_us(uint32_t last)
+{
+  return micros()-last;
+}
@@ -14,17 +14,19 @@
 
 #define QMK_BUILDDATE   "2025-06-27-17:35:30"
 
-#define EECONFIG_USER_INDICATOR           ((void *)((uint32_t)EECONFIG_USER_DATABLOCK +  0))  // 8B  // V251129R1: 통합 인디케이터 슬롯 (기존 CAPS/SCROLL 통합)
-#define EECONFIG_USER_KILL_SWITCH_LR      ((void *)((uint32_t)EECONFIG_USER_DATABLOCK +  8))  // 8B
-#define EECONFIG_USER_KILL_SWITCH_UD      ((void *)((uint32_t)EECONFIG_USER_DATABLOCK + 16))  // 8B
-#define EECONFIG_USER_KKUK                ((void *)((uint32_t)EECONFIG_USER_DATABLOCK + 24))  // 4B
-#define EECONFIG_USER_BOOTMODE            ((void *)((uint32_t)EECONFIG_USER_DATABLOCK + 28))  // 4B
-#define EECONFIG_USER_USB_INSTABILITY     ((void *)((uint32_t)EECONFIG_USER_DATABLOCK + 32))  // 4B  // V251108R1: USB 모니터 토글 저장 슬롯
-#define EECONFIG_USER_EEPROM_CLEAR_FLAG   ((void *)((uint32_t)EECONFIG_USER_DATABLOCK + 36))  // 4B  // V251112R1: 자동 초기화 플래그
-#define EECONFIG_USER_EEPROM_CLEAR_COOKIE ((void *)((uint32_t)EECONFIG_USER_DATABLOCK + 40))  // 4B  // V251112R1: 자동 초기화 쿠키 기록 슬롯
-#define EECONFIG_USER_DEBOUNCE            ((void *)((uint32_t)EECONFIG_USER_DATABLOCK + 44))  // 8B  // V251115R1: VIA 디바운스 프로필 저장 슬롯
-#define EECONFIG_USER_TAPPING_TERM        ((void *)((uint32_t)EECONFIG_USER_DATABLOCK + 52))  // 12B  // V251123R4: VIA TAPPING 설정 슬롯
-#define EECONFIG_USER_TAPDANCE            ((void *)((uint32_t)EECONFIG_USER_DATABLOCK + 64))  // 88B  // V251124R8: VIA TAPDANCE 슬롯
+// V261020R9: 주소 연산은 uintptr_t (펌웨어는 동일, 호스트 시뮬레이터 64비트 포인터에서 경고 없음)
+#define EECONFIG_USER_INDICATOR           ((void *)((uintptr_t)EECONFIG_USER_DATABLOCK +  0))  // 8B  // V251129R1: 통합 인디케이터 슬롯 (기존 CAPS/SCROLL 통합)
+#define EECONFIG_USER_KILL_SWITCH_LR      ((void *)((uintptr_t)EECONFIG_USER_DATABLOCK +  8))  // 8B
+#define EECONFIG_USER_KILL_SWITCH_UD      ((void *)((uintptr_t)EECONFIG_USER_DATABLOCK + 16))  // 8B
+#define EECONFIG_USER_KKUK                ((void *)((uintptr_t)EECONFIG_USER_DATABLOCK + 24))  // 4B
+#define EECONFIG_USER_BOOTMODE            ((void *)((uintptr_t)EECONFIG_USER_DATABLOCK + 28))  // 4B
+#define EECONFIG_USER_USB_INSTABILITY     ((void *)((uintptr_t)EECONFIG_USER_DATABLOCK + 32))  // 4B  // V251108R1: USB 모니터 토글 저장 슬롯
+#define EECONFIG_USER_EEPROM_CLEAR_FLAG   ((void *)((uintptr_t)EECONFIG_USER_DATABLOCK + 36))  // 4B  // V251112R1: 자동 초기화 플래그
+#define EECONFIG_USER_EEPROM_CLEAR_COOKIE ((void *)((uintptr_t)EECONFIG_USER_DATABLOCK + 40))  // 4B  // V251112R1: 자동 초기화 쿠키 기록 슬롯
+#define EECONFIG_USER_DEBOUNCE            ((void *)((uintptr_t)EECONFIG_USER_DATABLOCK + 44))  // 8B  // V251115R1: VIA 디바운스 프로필 저장 슬롯
+#define EECONFIG_USER_TAPPING_TERM        ((void *)((uintptr_t)EECONFIG_USER_DATABLOCK + 52))  // 12B  // V251123R4: VIA TAPPING 설정 슬롯
+#define EECONFIG_USER_TAPDANCE            ((void *)((uintptr_t)EECONFIG_USER_DATABLOCK + 64))  // 88B  // V251124R8: VIA TAPDANCE 슬롯
+#define EECONFIG_USER_SCAN                ((void *)((uintptr_t)EECONFIG_USER_DATABLOCK + 152)) // 8B  // V261017R6: 매트릭스 오버샘플링/스캔 주기 슬롯
 
 typedef struct
 {
@@ -16,12 +16,15 @@ along with this program.  If not, see <http://www.gnu.org/licenses/>.
 */
 
 #include <stdint.h>
+#include <string.h>
 #include "keyboard.h"
 #include "keycode.h"
 #include "host.h"
 #include "util.h"
 #include "debug.h"
 #include "usb.h"
+#include "action_util.h"
+#include "latency.h"  // V261019R2: action_exec → host send 구간 지점
 
 
 #ifdef DIGITIZER_ENABLE
@@ -47,6 +50,8 @@ static uint16_t       last_system_usage   = 0;
 static uint16_t       last_consumer_usage = 0;
 static volatile uint8_t host_led_state    = 0;  // V251124R7: USB HID SET_REPORT로 수신한 LED 상태 캐시
 
+uint8_t keyboard_protocol = 1;  // V261018R1: Boot 프로토콜(0)이면 NKRO 설정과 무관하게 6KRO 리포트를 사용
+
 void host_set_driver(host_driver_t *d) {
     driver = d;
 }
@@ -86,13 +91,71 @@ __WEAK uint8_t host_keyboard_leds(void)
   return host_led_state;  // V251124R7: 드라이버가 없을 때는 최근 HID SET_REPORT 값으로 응답
 }
 
+// V261018R1: Boot 프로토콜 리포트는 6키 고정이다. 7키 이상이면 스펙대로 ErrorRollOver(0x01)로 채운다.
+#define HOST_BOOT_REPORT_KEYS   6
+#define HOST_BOOT_ROLLOVER      0x01
+
+static void host_keyboard_send_boot(report_keyboard_t *report)
+{
+  uint8_t boot[2 + HOST_BOOT_REPORT_KEYS] = {report->mods, 0};
+  uint8_t cnt = 0;
+
+  for (uint8_t i = 0; i < KEYBOARD_REPORT_KEYS; i++)
+  {
+    if (report->keys[i] == 0)
+    {
+      continue;
+    }
+    if (cnt == HOST_BOOT_REPORT_KEYS)
+    {
+      memset(&boot[2], HOST_BOOT_ROLLOVER, HOST_BOOT_REPORT_KEYS);
+      break;
+    }
+    boot[2 + cnt++] = report->keys[i];
+  }
+
+  usbHidSendReport(boot, sizeof(boot));
+}
+
 led_t host_keyboard_led_state(void) {
     return (led_t)host_keyboard_leds();
 }
 
+void usbHidSetProtocol(uint8_t protocol)
+{
+  keyboard_protocol = protocol != 0 ? 1 : 0;  // V261018R1: USB ISR 에서 호출, report.c/action_util.c 가 매 리포트마다 참조
+}
+
+// V261018R8: USB 재열거 후 호스트는 모든 키를 놓은 상태로 시작한다.
+//   send_keyboard_report() 는 직전 리포트와 같으면 보내지 않으므로 현재 상태를 직접 다시 보낸다.
+void usbHidResendReports(void)
+{
+  uint16_t usage;
+
+#ifdef NKRO_ENABLE
+  if (keyboard_protocol && keymap_config.nkro)
+  {
+    host_nkro_send(nkro_report);
+  }
+  else
+#endif
+  {
+    host_keyboard_send(keyboard_report);
+  }
+
+  usage               = last_system_usage;
+  last_system_usage   = 0;
+  host_system_send(usage);
+  usage               = last_consumer_usage;
+  last_consumer_usage = 0;
+  host_consumer_send(usage);
+}
+
 /* send report */
 void host_keyboard_send(report_keyboard_t *report)
 {
+  latencyMark(LATENCY_POINT_HOST);  // V261019R2
+
 #ifdef BLUETOOTH_ENABLE
   if (where_to_send() == OUTPUT_BLUETOOTH)
   {
@@ -101,7 +164,14 @@ void host_keyboard_send(report_keyboard_t *report)
   }
 #endif
 
-  usbHidSendReport((uint8_t *)report, sizeof(report_keyboard_t));
+  if (keyboard_protocol == 0)
+  {
+    host_keyboard_send_boot(report);
+  }
+  else
+  {
+    usbHidSendReport((uint8_t *)report, sizeof(report_keyboard_t));
+  }
 
   #ifdef DEBUG_KEY_SEND
   static uint32_t pre_time = 0;
@@ -139,18 +209,24 @@ void host_keyboard_send(report_keyboard_t *report)
   }
 }
 
-void host_nkro_send(report_nkro_t *report) {
-    if (!driver) return;
-    report->report_id = REPORT_ID_NKRO;
-    (*driver->send_nkro)(report);
-
-    if (debug_keyboard) {
-        dprintf("nkro_report: %02X | ", report->mods);
-        for (uint8_t i = 0; i < NKRO_REPORT_BITS; i++) {
-            dprintf("%02X ", report->bits[i]);
-        }
-        dprint("\n");
+void host_nkro_send(report_nkro_t *report)
+{
+  latencyMark(LATENCY_POINT_HOST);  // V261019R2
+  report->report_id = REPORT_ID_NKRO;
+  usbHidSendReportNKRO((uint8_t *)report, sizeof(report_nkro_t));  // V261018R1: NKRO 인터페이스(EP 0x86)로 직접 전송
+
+  if (!driver) return;
+  (*driver->send_nkro)(report);
+
+  if (debug_keyboard)
+  {
+    dprintf("nkro_report: %02X | ", report->mods);
+    for (uint8_t i = 0; i < NKRO_REPORT_BITS; i++)
+    {
+      dprintf("%02X ", report->bits[i]);
     }
+    dprint("\n");
+  }
 }
 
 void host_mouse_send(report_mouse_t *report) {
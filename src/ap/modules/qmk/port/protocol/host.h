@@ -9,6 +9,8 @@
 #include "qmk/quantum/led.h"
 
 
+extern uint8_t keyboard_protocol;  // V261018R1: 0=Boot, 1=Report (키보드 인터페이스 SET_PROTOCOL)
+
 /* host driver */
 void           host_set_driver(host_driver_t *driver);
 host_driver_t *host_get_driver(void);
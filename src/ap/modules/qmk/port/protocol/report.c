@@ -212,6 +212,27 @@ void del_key_byte(report_keyboard_t* keyboard_report, uint8_t code) {
 }
 
 #ifdef NKRO_ENABLE
+// V261018R1: add/del/clear 가 건드린 bits[] 바이트 구간 [lo, hi]. lo > hi 이면 변경 없음.
+//   send_nkro_report() 가 이 구간만 비교/복사해 전체 키 롤오버에서도 리포트 비용이 바뀐 바이트 수에 비례한다.
+static uint8_t nkro_dirty_lo = 0;
+static uint8_t nkro_dirty_hi = NKRO_REPORT_BITS - 1;
+
+static inline void nkro_mark_dirty(uint8_t lo, uint8_t hi) {
+    if (lo < nkro_dirty_lo) nkro_dirty_lo = lo;
+    if (hi > nkro_dirty_hi) nkro_dirty_hi = hi;  // 빈 구간은 hi = 0 이므로 첫 표시에서 바로 갱신된다
+}
+
+bool nkro_report_take_dirty(uint8_t* lo, uint8_t* hi) {
+    if (nkro_dirty_lo > nkro_dirty_hi) {
+        return false;
+    }
+    *lo           = nkro_dirty_lo;
+    *hi           = nkro_dirty_hi;
+    nkro_dirty_lo = NKRO_REPORT_BITS;
+    nkro_dirty_hi = 0;
+    return true;
+}
+
 /** \brief add key bit
  *
  * FIXME: Needs doc
@@ -219,6 +240,7 @@ void del_key_byte(report_keyboard_t* keyboard_report, uint8_t code) {
 void add_key_bit(report_nkro_t* nkro_report, uint8_t code) {
     if ((code >> 3) < NKRO_REPORT_BITS) {
         nkro_report->bits[code >> 3] |= 1 << (code & 7);
+        nkro_mark_dirty(code >> 3, code >> 3);
     } else {
         dprintf("add_key_bit: can't add: %02X\n", code);
     }
@@ -231,6 +253,7 @@ void add_key_bit(report_nkro_t* nkro_report, uint8_t code) {
 void del_key_bit(report_nkro_t* nkro_report, uint8_t code) {
     if ((code >> 3) < NKRO_REPORT_BITS) {
         nkro_report->bits[code >> 3] &= ~(1 << (code & 7));
+        nkro_mark_dirty(code >> 3, code >> 3);
     } else {
         dprintf("del_key_bit: can't del: %02X\n", code);
     }
@@ -274,6 +297,7 @@ void clear_keys_from_report(void) {
 #ifdef NKRO_ENABLE
     if (keyboard_protocol && keymap_config.nkro) {
         memset(nkro_report->bits, 0, sizeof(nkro_report->bits));
+        nkro_mark_dirty(0, NKRO_REPORT_BITS - 1);
         return;
     }
 #endif
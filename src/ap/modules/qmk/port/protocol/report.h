@@ -322,6 +322,7 @@ void del_key_byte(report_keyboard_t* keyboard_report, uint8_t code);
 #ifdef NKRO_ENABLE
 void add_key_bit(report_nkro_t* nkro_report, uint8_t code);
 void del_key_bit(report_nkro_t* nkro_report, uint8_t code);
+bool nkro_report_take_dirty(uint8_t* lo, uint8_t* hi);  // V261018R1: 직전 전송 이후 바뀐 bits[] 구간
 #endif
 
 void add_key_to_report(uint8_t key);
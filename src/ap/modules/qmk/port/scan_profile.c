@@ -0,0 +1,240 @@
+#include "scan_profile.h"
+
+
+#include "eeconfig.h"
+#include "log.h"
+#include "keys.h"
+#include "qmk/port/port.h"
+#include "via.h"
+
+
+// ---------------------------------------------------------------------------
+// [Scan Profile] V261017R6
+//   - keys.c 오버샘플링(프레임당 축약 스윕 수/축약 방식)과 행 샘플 주기를 VIA 로 노출하고 EEPROM 에 저장한다.
+//   - 값은 keysSetOversample()/keysSetScanRate() 로 즉시 반영되며 DMA ISR 이 다음 프레임부터 사용한다.
+// ---------------------------------------------------------------------------
+#define SCAN_PROFILE_SIGNATURE    (0x4E414353UL)      // "SCAN"
+#define SCAN_PROFILE_VERSION      (1U)
+
+
+typedef struct __attribute__((packed))
+{
+  uint8_t  samples;
+  uint8_t  reduce;
+  uint8_t  rate;
+  uint8_t  version;
+  uint32_t signature;
+} scan_profile_storage_t;
+
+_Static_assert(sizeof(scan_profile_storage_t) == 8, "EECONFIG out of spec.");
+
+static scan_profile_storage_t scan_profile_storage = {0};
+
+
+EECONFIG_DEBOUNCE_HELPER(scan_profile, EECONFIG_USER_SCAN, scan_profile_storage);
+
+
+static bool scan_profile_is_storage_valid(const scan_profile_storage_t *storage);
+static void scan_profile_apply_defaults_locked(void);
+static void scan_profile_apply(void);
+static bool scan_profile_set_value_internal(uint8_t id, uint8_t value);
+static void scan_profile_get_value_internal(uint8_t id, uint8_t *value_data);
+
+
+void scan_profile_init(void)
+{
+  eeconfig_init_scan_profile();
+
+  if (scan_profile_is_storage_valid(&scan_profile_storage) == false)
+  {
+    scan_profile_apply_defaults_locked();                         // 손상/미기록 슬롯은 보드 기본값으로 복원
+    eeconfig_flush_scan_profile(true);
+  }
+
+  scan_profile_apply();
+}
+
+bool scan_profile_set_samples(uint8_t samples)
+{
+  if (samples == 0U || samples > KEYS_OVERSAMPLE_MAX)
+  {
+    return false;
+  }
+
+  scan_profile_storage.samples = samples;
+  eeconfig_flag_scan_profile(true);
+  scan_profile_apply();
+  return true;
+}
+
+bool scan_profile_set_reduce(uint8_t reduce)
+{
+  if (reduce >= KEYS_REDUCE_COUNT)
+  {
+    return false;
+  }
+
+  scan_profile_storage.reduce = reduce;
+  eeconfig_flag_scan_profile(true);
+  scan_profile_apply();
+  return true;
+}
+
+bool scan_profile_set_rate(uint8_t rate)
+{
+  if (rate >= KEYS_SCAN_RATE_COUNT)
+  {
+    return false;
+  }
+
+  scan_profile_storage.rate = rate;
+  eeconfig_flag_scan_profile(true);
+  scan_profile_apply();
+  return true;
+}
+
+void scan_profile_save(bool force)
+{
+  eeconfig_flush_scan_profile(force);
+}
+
+void scan_profile_storage_apply_defaults(void)
+{
+  scan_profile_apply_defaults_locked();                           // EEPROM 공장 초기화 경로에서 기본값만 기록
+}
+
+bool scan_profile_handle_via_command(uint8_t *data, uint8_t length)
+{
+  if (data == NULL || length < 4U)
+  {
+    return false;
+  }
+
+  uint8_t *command_id = &(data[0]);
+  uint8_t *value_id   = &(data[2]);
+  uint8_t *value_data = &(data[3]);
+  bool     handled    = false;
+
+  if (*value_id != id_qmk_scan_samples &&
+      *value_id != id_qmk_scan_reduce  &&
+      *value_id != id_qmk_scan_rate)
+  {
+    return false;                                                 // 디바운스 항목은 debounce_profile 이 처리
+  }
+
+  switch (*command_id)
+  {
+    case id_custom_set_value:
+      handled = scan_profile_set_value_internal(*value_id, value_data[0]);
+      if (handled)
+      {
+        scan_profile_get_value_internal(*value_id, value_data);
+      }
+      break;
+
+    case id_custom_get_value:
+      scan_profile_get_value_internal(*value_id, value_data);
+      handled = true;
+      break;
+
+    case id_custom_save:
+      scan_profile_save(true);
+      handled = true;
+      break;
+
+    default:
+      handled = false;
+      break;
+  }
+
+  if (!handled)
+  {
+    *command_id = id_unhandled;
+  }
+  return handled;
+}
+
+static bool scan_profile_is_storage_valid(const scan_profile_storage_t *storage)
+{
+  if (storage->signature != SCAN_PROFILE_SIGNATURE || storage->version != SCAN_PROFILE_VERSION)
+  {
+    return false;
+  }
+  if (storage->samples == 0U || storage->samples > KEYS_OVERSAMPLE_MAX)
+  {
+    return false;
+  }
+  if (storage->reduce >= KEYS_REDUCE_COUNT || storage->rate >= KEYS_SCAN_RATE_COUNT)
+  {
+    return false;
+  }
+  return true;
+}
+
+static void scan_profile_apply_defaults_locked(void)
+{
+  scan_profile_storage.samples   = HW_KEYS_OVERSAMPLE_DEFAULT;
+  scan_profile_storage.reduce    = HW_KEYS_REDUCE_DEFAULT;
+  scan_profile_storage.rate      = HW_KEYS_SCAN_RATE_DEFAULT;
+  scan_profile_storage.version   = SCAN_PROFILE_VERSION;
+  scan_profile_storage.signature = SCAN_PROFILE_SIGNATURE;
+  eeconfig_flag_scan_profile(true);
+}
+
+static void scan_profile_apply(void)
+{
+  scan_profile_storage.version   = SCAN_PROFILE_VERSION;
+  scan_profile_storage.signature = SCAN_PROFILE_SIGNATURE;
+
+  keysSetOversample(scan_profile_storage.samples, (keys_reduce_t)scan_profile_storage.reduce);
+  keysSetScanRate((keys_scan_rate_t)scan_profile_storage.rate);
+
+  logPrintf("[  ] SCAN profile : oversample %d (reduce %d), row rate %d, frame %lu Hz (sweep %lu Hz)\n",  // V261021R1: 게시 빈도와 스윕 빈도 구분
+            scan_profile_storage.samples,
+            scan_profile_storage.reduce,
+            scan_profile_storage.rate,
+            keysGetScanFreqHz(),
+            keysGetSweepFreqHz());
+}
+
+static bool scan_profile_set_value_internal(uint8_t id, uint8_t value)
+{
+  switch (id)
+  {
+    case id_qmk_scan_samples:
+      return scan_profile_set_samples(value);
+
+    case id_qmk_scan_reduce:
+      return scan_profile_set_reduce(value);
+
+    case id_qmk_scan_rate:
+      return scan_profile_set_rate(value);
+
+    default:
+      break;
+  }
+
+  return false;
+}
+
+static void scan_profile_get_value_internal(uint8_t id, uint8_t *value_data)
+{
+  switch (id)
+  {
+    case id_qmk_scan_samples:
+      value_data[0] = keysGetOversample();
+      break;
+
+    case id_qmk_scan_reduce:
+      value_data[0] = (uint8_t)keysGetReduce();
+      break;
+
+    case id_qmk_scan_rate:
+      value_data[0] = (uint8_t)keysGetScanRate();
+      break;
+
+    default:
+      value_data[0] = 0U;
+      break;
+  }
+}
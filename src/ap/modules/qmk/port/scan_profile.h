@@ -0,0 +1,15 @@
+#pragma once
+
+
+#include <stdbool.h>
+#include <stdint.h>
+
+
+// V261017R6: VIA KEY RESPONSE 채널의 매트릭스 오버샘플링/스캔 주기 프로필
+void scan_profile_init(void);
+bool scan_profile_set_samples(uint8_t samples);
+bool scan_profile_set_reduce(uint8_t reduce);
+bool scan_profile_set_rate(uint8_t rate);
+void scan_profile_save(bool force);
+void scan_profile_storage_apply_defaults(void);
+bool scan_profile_handle_via_command(uint8_t *data, uint8_t length);
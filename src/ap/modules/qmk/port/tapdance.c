@@ -239,6 +239,8 @@ static void tapdance_register_keycode(uint16_t keycode, bool is_tap)
   record.event.key.col = 0;
   record.event.pressed = true;
   record.event.time = timer_read();
+  record.event.time_us = timer_read_us();                 // V261017R8: 가상 이벤트도 us 시계 기록
+  record.event.has_time_us = true;                        // V261020R2
 #ifndef NO_ACTION_TAPPING
   record.tap.count = is_tap ? 1U : 0U;
 #endif
@@ -262,6 +264,8 @@ static void tapdance_unregister_keycode(uint16_t keycode, bool is_tap)
   record.event.key.col = 0;
   record.event.pressed = false;
   record.event.time = timer_read();
+  record.event.time_us = timer_read_us();                 // V261017R8: 가상 이벤트도 us 시계 기록
+  record.event.has_time_us = true;                        // V261020R2
 #ifndef NO_ACTION_TAPPING
   record.tap.count = is_tap ? 1U : 0U;
 #endif
@@ -2,7 +2,8 @@
 #include "raw_hid.h"
 #include <string.h>
 #include "log.h"
-#include "qbuffer.h"
+#include "qring.h"                                                   // V261017R9: USB ISR -> 메인 루프 SPSC 링
+#include "idle.h"                                                    // V261017R5: VIA RX 시 메인 루프 깨움
 #include "hw/driver/usb/usb_hid/usbd_hid.h"
 
 
@@ -16,7 +17,9 @@ typedef struct
   uint8_t buf[VIA_HID_REPORT_SIZE];
 } via_hid_packet_t;
 
-static qbuffer_t            via_hid_rx_q;
+_Static_assert(QRING_IS_POW2(VIA_HID_RX_QUEUE_DEPTH), "VIA RX queue depth must be a power of two.");
+
+static qring_t              via_hid_rx_q;
 static via_hid_packet_t     via_hid_rx_buf[VIA_HID_RX_QUEUE_DEPTH];
 static volatile uint32_t    via_hid_rx_drop_cnt = 0;
 
@@ -52,12 +55,12 @@ static void via_hid_print(uint8_t *data, uint8_t length, bool is_resp);
 #endif
 
 
-static void via_hid_receive(uint8_t *data, uint8_t length);
+static bool via_hid_receive(uint8_t *data, uint8_t length);
 
 
 void via_hid_init(void)
 {
-  qbufferCreateBySize(&via_hid_rx_q, (uint8_t *)via_hid_rx_buf, sizeof(via_hid_packet_t), VIA_HID_RX_QUEUE_DEPTH);
+  qringCreate(&via_hid_rx_q, via_hid_rx_buf, sizeof(via_hid_packet_t), VIA_HID_RX_QUEUE_DEPTH);
   usbHidSetViaReceiveFunc(via_hid_receive);                          // V251108R8: RX 큐 초기화 후 USB ISR 등록
 }
 
@@ -66,7 +69,8 @@ void raw_hid_send(uint8_t *data, uint8_t length)
   
 }
 
-void via_hid_receive(uint8_t *data, uint8_t length)
+// V261020R4: 요청을 RX 큐에 실었으면 true. USB 흐름 제어는 실린 요청만 응답 대기 수로 센다.
+bool via_hid_receive(uint8_t *data, uint8_t length)
 {
   #if USE_VIA_HID_PRINT == 1
   via_hid_print(data, length, true);
@@ -74,18 +78,25 @@ void via_hid_receive(uint8_t *data, uint8_t length)
 
   if (data == NULL || length == 0U)
   {
-    return;
+    return false;
   }
 
-  via_hid_packet_t packet;
-  packet.len = length > VIA_HID_REPORT_SIZE ? VIA_HID_REPORT_SIZE : length;
-  memset(packet.buf, 0, sizeof(packet.buf));
-  memcpy(packet.buf, data, packet.len);
+  via_hid_packet_t *p_packet = qringReserve(&via_hid_rx_q);        // V261017R9: 링 슬롯에 직접 기록
 
-  if (qbufferWrite(&via_hid_rx_q, (uint8_t *)&packet, 1) != true)
+  if (p_packet == NULL)
   {
     via_hid_rx_drop_cnt++;                                          // V251108R8: ISR에서 로그 대신 카운터만 증가
+    return false;
   }
+
+  p_packet->len = length > VIA_HID_REPORT_SIZE ? VIA_HID_REPORT_SIZE : length;
+  memset(p_packet->buf, 0, sizeof(p_packet->buf));
+  memcpy(p_packet->buf, data, p_packet->len);
+  qringCommit(&via_hid_rx_q);
+#ifdef _USE_HW_IDLE
+  idleSetEvent(IDLE_EVENT_VIA);                                     // V261017R5: via_hid_task 가 다음 루프에서 처리
+#endif
+  return true;
 }
 
 void via_hid_task(void)
@@ -99,9 +110,9 @@ void via_hid_task(void)
     logPrintf("[!] VIA RX queue overflow : %lu\n", dropped);        // V251108R8: 메인 루프에서만 로그 출력
   }
 
-  while (qbufferAvailable(&via_hid_rx_q) > 0U)
+  while (qringAvailable(&via_hid_rx_q) > 0U)
   {
-    if (qbufferRead(&via_hid_rx_q, (uint8_t *)&packet, 1) != true)
+    if (qringRead(&via_hid_rx_q, &packet, 1) != true)
     {
       break;
     }
@@ -2,21 +2,26 @@
 #include "qmk/port/port.h"
 #include "qmk/port/platforms/eeprom.h"            // V251112R5: EEPROM 버스트 모드 제어
 #include "qmk/port/debounce_profile.h"
+#include "qmk/port/scan_profile.h"
 
 
 static void cliQmk(cli_args_t *args);
 static void idle_task(void);
+static void boot_timeline_task(void);
 
-static bool is_suspended = false;
+static bool     is_suspended = false;
+static uint32_t boot_loop_ms = 0;                  // V261019R5: 부팅 → 메인 루프 진입
+static bool     boot_logged  = false;
 
 
 
 
 bool qmkInit(void)
 {
-  eeprom_init();
+  // V261019R5: eeprom_init() 은 hwInit() 에서 한 번만 한다 (여기서 4KB 를 다시 읽던 호출 제거)
   via_hid_init();
   debounce_profile_init();                         // V251115R1: VIA 디바운스 프로필 초기 로드
+  scan_profile_init();                             // V261017R6: 매트릭스 오버샘플링/스캔 주기 로드 및 적용
 #ifdef G_TERM_ENABLE
   tapping_term_init();                             // V251123R4: VIA TAPPING 설정 초기 로드
 #endif
@@ -34,12 +39,16 @@ bool qmkInit(void)
   logPrintf("     MATRIX_ROWS : %d\n", MATRIX_ROWS);
   logPrintf("     MATRIX_COLS : %d\n", MATRIX_COLS);
   const debounce_profile_values_t *profile = debounce_profile_current();
-  logPrintf("     DEBOUNCE    : mode %d, pre %d ms, post %d ms\n",
+  const char *debounce_unit = (profile->unit == DEBOUNCE_RUNTIME_UNIT_125US) ? "x125us" : "ms";
+  logPrintf("     DEBOUNCE    : mode %d, pre %d %s, post %d %s\n",
             profile->type,
             profile->pre_ms,
-            profile->post_ms);                    // V251115R1: VIA 런타임 디바운스 상태 로그
+            debounce_unit,
+            profile->post_ms,
+            debounce_unit);                       // V251115R1: VIA 런타임 디바운스 상태 로그 (V261017R2: 단위 표시)
 
   cliAdd("qmk", cliQmk);
+  boot_loop_ms = millis();
   return true;
 }
 
@@ -47,12 +56,7 @@ void qmkUpdate(void)
 {
   via_hid_task();                                                // V251108R8: VIA 명령을 메인 루프에서 처리해 USB ISR 부하 감소
   keyboard_task();
-  eeprom_task();
-  uint8_t burst_calls = eeprom_get_burst_extra_calls();          // V251112R5: 큐 적체 시 추가 페이지 플러시
-  while (burst_calls-- > 0 && eeprom_is_pending())
-  {
-    eeprom_update();                                             // V251112R5: 버스트 모드 동안 즉시 추가 처리
-  }
+  eeprom_task();                                                 // V261019R4: 비차단 페이지 쓰기 관찰/시작만 (버스트 추가 호출 제거)
   idle_task();
 }
 
@@ -81,6 +85,11 @@ void idle_task(void)
 {
   bool is_suspended_cur;
 
+  // V261019R1: 원격 깨우기 K 상태 종료/재개 후 재전송을 먼저 처리해, 깨운 키 입력이 LED 복구보다 앞서 호스트에 간다.
+  usbHidWakeUpProcess();
+  latencyUpdate();                                          // V261019R2: 완료된 지연 샘플을 히스토그램에 합산
+  boot_timeline_task();                                     // V261019R5
+
   is_suspended_cur = usbIsSuspended();
   if (is_suspended_cur != is_suspended)
   {
@@ -101,10 +110,101 @@ void idle_task(void)
 #endif
 }
 
+// V261019R5: EEPROM 우선 적재 → 메인 루프 → 첫 리포트 → 전체 적재 순서를 한 번 남긴다
+static void boot_timeline_print(void (*p_print)(const char *fmt, ...))
+{
+  eeprom_load_info_t info;
+
+  eeprom_get_load_info(&info);
+  p_print("boot timeline : eeprom priority %lu B %lu us, main loop %lu ms, first report %lu ms, eeprom full %lu ms (on-demand %lu pages)\n",
+        (unsigned long)info.prio_bytes,
+        (unsigned long)info.prio_us,
+        (unsigned long)boot_loop_ms,
+        (unsigned long)usbGetBootReportMs(),
+        (unsigned long)info.done_ms,
+        (unsigned long)info.lazy_cnt);
+}
+
+static void boot_timeline_task(void)
+{
+  if (boot_logged == true || eeprom_is_loaded() != true || usbGetBootReportMs() == 0)
+  {
+    return;
+  }
+  boot_logged = true;
+  boot_timeline_print(logPrintf);
+}
+
+#ifdef _USE_HW_EEPROM_WL
+// V261019R6: 고빈도 설정 플래시 로그 상태
+static void eeprom_wl_print(void)
+{
+  eeprom_wl_info_t info;
+
+  eeprom_wl_get_info(&info);
+  cliPrintf("wl enable      : %s%s\n", info.enable ? "on" : "off", info.enable && info.ready != true ? " (not ready)" : "");
+  cliPrintf("wl boot count  : %lu (seeded %lu)\n", (unsigned long)info.boot_cnt, (unsigned long)info.seed_cnt);
+  cliPrintf("wl writes      : %lu spans, %lu entries, %lu fail\n",
+            (unsigned long)info.write_cnt, (unsigned long)info.entry_cnt, (unsigned long)info.fail_cnt);
+  cliPrintf("wl log         : %lu / %lu B\n", (unsigned long)info.log_used, (unsigned long)info.log_size);
+  cliPrintf("wl consolidate : %lu, %lu subsector erases\n", (unsigned long)info.consolidate_cnt, (unsigned long)info.erase_cnt);
+  cliPrintf("wl commit max  : %lu us\n", (unsigned long)info.commit_max_us);
+}
+#endif
+
+// V261019R7: 해석 키맵 캐시 적중/채우기 상태
+static void keymap_cache_print(void)
+{
+  keymap_cache_info_t info;
+
+  keymap_cache_get_info(&info);
+  cliPrintf("keycache enable : %s\n", keymap_cache_is_enabled() ? "on" : "off");
+  cliPrintf("keycache lookup : %lu hit, %lu miss\n", (unsigned long)info.hit_cnt, (unsigned long)info.miss_cnt);
+  cliPrintf("keycache fill   : %lu positions\n", (unsigned long)info.fill_cnt);
+  cliPrintf("keycache layer  : %lu changes, %lu positions dropped\n", (unsigned long)info.sync_cnt, (unsigned long)info.drop_cnt);
+}
+
 void cliQmk(cli_args_t *args)
 {
   bool ret = false;
 
+  if (args->argc == 1 && args->isStr(0, "boot"))
+  {
+    boot_timeline_print(cliPrintf);
+    ret = true;
+  }
+
+  if (args->argc == 1 && args->isStr(0, "keycache"))
+  {
+    keymap_cache_print();
+    ret = true;
+  }
+
+  if (args->argc == 2 && args->isStr(0, "keycache") && (args->isStr(1, "on") || args->isStr(1, "off")))
+  {
+    keymap_cache_set_enable(args->isStr(1, "on"));
+    keymap_cache_print();
+    ret = true;
+  }
+
+#ifdef _USE_HW_EEPROM_WL
+  if (args->argc == 1 && args->isStr(0, "wl"))
+  {
+    eeprom_wl_print();
+    ret = true;
+  }
+
+  if (args->argc == 2 && args->isStr(0, "wl") && (args->isStr(1, "on") || args->isStr(1, "off")))
+  {
+    if (eeprom_set_wl_enable(args->isStr(1, "on")) != true)
+    {
+      cliPrintf("wl enable fail\n");
+    }
+    eeprom_wl_print();
+    ret = true;
+  }
+#endif
+
 
   if (args->argc == 2 && args->isStr(0, "clear") && args->isStr(1, "eeprom"))
   {
@@ -117,5 +217,10 @@ void cliQmk(cli_args_t *args)
   {
     cliPrintf("qmk info\n");
     cliPrintf("qmk clear eeprom\n");
+    cliPrintf("qmk boot\n");
+    cliPrintf("qmk keycache [on|off]\n");                            // V261019R7
+#ifdef _USE_HW_EEPROM_WL
+    cliPrintf("qmk wl [on|off]\n");                                  // V261019R6
+#endif
   }
 }
@@ -5,6 +5,8 @@
 #include "action.h"
 #include "encoder.h"
 #include "util.h"
+#include "matrix.h"
+#include "keymap_common.h"
 #include "action_layer.h"
 
 /** \brief Default Layer State
@@ -289,6 +291,181 @@ uint8_t read_source_layers_cache(keypos_t key) {
 }
 #endif
 
+#ifndef NO_ACTION_LAYER
+/** \brief resolved keymap cache
+ *
+ * V261019R7: 매트릭스 위치마다 (layer_state | default_layer_state) 기준으로 해석한 레이어와 키코드를
+ * 보관해, 이벤트마다 MAX_LAYER 부터 내려가며 EEPROM 미러를 두 바이트씩 읽는 조회를 배열 읽기 한 번으로 줄인다.
+ * 레이어 상태가 바뀌면 바뀐 가장 높은 레이어 이하에서 해석된 위치만 무효화하고 (그보다 위에서 해석된
+ * 위치는 결과가 같다), 키맵 쓰기는 해당 위치만 무효화한다. 빈 자리는 조회 시 또는 keymap_cache_task()가 행 단위로 채운다.
+ */
+#    define KEYMAP_CACHE_ROW_MASK ((MATRIX_COLS >= (sizeof(matrix_row_t) * CHAR_BIT)) ? (matrix_row_t)~(matrix_row_t)0 : (matrix_row_t)((((matrix_row_t)1) << (MATRIX_COLS % (sizeof(matrix_row_t) * CHAR_BIT))) - 1))
+
+static bool          keymap_cache_enable = true;
+static layer_state_t keymap_cache_state;                           // 캐시를 해석한 layer_state | default_layer_state
+static matrix_row_t  keymap_cache_valid[MATRIX_ROWS];              // 위치별 해석 완료 비트
+static uint8_t       keymap_cache_layer[MATRIX_ROWS][MATRIX_COLS];
+static uint16_t      keymap_cache_keycode[MATRIX_ROWS][MATRIX_COLS];
+static bool          keymap_cache_full;                            // 모든 위치가 채워짐 (task 생략)
+static uint8_t       keymap_cache_row;                             // task 채우기 커서
+static keymap_cache_info_t keymap_cache_info;
+
+static uint8_t keymap_cache_resolve(layer_state_t layers, keypos_t key, uint16_t *p_keycode) {
+    /* check top layer first */
+    for (int8_t i = MAX_LAYER - 1; i >= 0; i--) {
+        if (layers & ((layer_state_t)1 << i)) {
+            uint16_t keycode = keymap_key_to_keycode(i, key);
+            if (action_for_keycode(keycode).code != ACTION_TRANSPARENT) {
+                *p_keycode = keycode;
+                return i;
+            }
+        }
+    }
+    /* fall back to layer 0 */
+    *p_keycode = keymap_key_to_keycode(0, key);
+    return 0;
+}
+
+static void keymap_cache_fill(uint8_t row, uint8_t col) {
+    keypos_t key = {.row = row, .col = col};
+
+    keymap_cache_layer[row][col] = keymap_cache_resolve(keymap_cache_state, key, &keymap_cache_keycode[row][col]);
+    keymap_cache_valid[row] |= ((matrix_row_t)1) << col;
+    keymap_cache_info.fill_cnt++;
+}
+
+static void keymap_cache_sync(void) {
+    layer_state_t layers = layer_state | default_layer_state;
+
+    if (layers == keymap_cache_state) {
+        return;
+    }
+    // 바뀐 가장 높은 레이어보다 위에서 해석된 위치는 그 위 레이어들의 활성 여부가 그대로라 결과도 같다.
+    // 폴백(레이어 0)은 새로 켜진 레이어가 가릴 수 있어 항상 다시 해석한다.
+    layer_state_t changed     = layers ^ keymap_cache_state;
+    uint8_t       changed_top = MAX_LAYER - 1;
+
+    while (changed_top > 0 && (changed & ((layer_state_t)1 << changed_top)) == 0) {
+        changed_top--;
+    }
+
+    for (uint8_t row = 0; row < MATRIX_ROWS; row++) {
+        matrix_row_t valid = keymap_cache_valid[row];
+
+        for (uint8_t col = 0; col < MATRIX_COLS; col++) {
+            if ((valid & (((matrix_row_t)1) << col)) && keymap_cache_layer[row][col] <= changed_top) {
+                valid &= ~(((matrix_row_t)1) << col);
+                keymap_cache_info.drop_cnt++;
+            }
+        }
+        keymap_cache_valid[row] = valid;
+    }
+    keymap_cache_state = layers;
+    keymap_cache_full  = false;
+    keymap_cache_info.sync_cnt++;
+}
+
+static inline bool keymap_cache_in_matrix(keypos_t key) {
+    return keymap_cache_enable && key.row < MATRIX_ROWS && key.col < MATRIX_COLS;
+}
+
+/** \brief keymap cache invalidate
+ *
+ * Drops one position after a keymap write (any layer may change its resolution)
+ */
+void keymap_cache_invalidate(uint8_t row, uint8_t col) {
+    if (row < MATRIX_ROWS && col < MATRIX_COLS) {
+        keymap_cache_valid[row] &= ~(((matrix_row_t)1) << col);
+        keymap_cache_full = false;
+    }
+}
+
+/** \brief keymap cache invalidate all
+ *
+ * Drops every position (bulk keymap writes, reset, init)
+ */
+void keymap_cache_invalidate_all(void) {
+    for (uint8_t row = 0; row < MATRIX_ROWS; row++) {
+        keymap_cache_valid[row] = 0;
+    }
+    keymap_cache_full = false;
+}
+
+/** \brief keymap cache task
+ *
+ * Resolves the empty positions of one row per call so that key events after a layer change hit the cache
+ */
+void keymap_cache_task(void) {
+    if (keymap_cache_enable != true) {
+        return;
+    }
+    keymap_cache_sync();
+    if (keymap_cache_full) {
+        return;
+    }
+    for (uint8_t i = 0; i < MATRIX_ROWS; i++) {
+        uint8_t row = keymap_cache_row;
+
+        keymap_cache_row = (keymap_cache_row + 1) % MATRIX_ROWS;
+        if (keymap_cache_valid[row] != KEYMAP_CACHE_ROW_MASK) {
+            for (uint8_t col = 0; col < MATRIX_COLS; col++) {
+                if ((keymap_cache_valid[row] & (((matrix_row_t)1) << col)) == 0) {
+                    keymap_cache_fill(row, col);
+                }
+            }
+            return;
+        }
+    }
+    keymap_cache_full = true;
+}
+
+/** \brief keymap cache set enable
+ *
+ * Turns the cache off for comparison; lookups then resolve through the keymap every time
+ */
+void keymap_cache_set_enable(bool enable) {
+    keymap_cache_enable = enable;
+    keymap_cache_invalidate_all();
+}
+
+bool keymap_cache_is_enabled(void) {
+    return keymap_cache_enable;
+}
+
+void keymap_cache_get_info(keymap_cache_info_t *p_info) {
+    *p_info = keymap_cache_info;
+}
+
+static bool keymap_cache_lookup(keypos_t key, uint8_t *p_layer, uint16_t *p_keycode) {
+    if (keymap_cache_in_matrix(key) != true) {
+        return false;
+    }
+    keymap_cache_sync();
+    if ((keymap_cache_valid[key.row] & (((matrix_row_t)1) << key.col)) == 0) {
+        keymap_cache_fill(key.row, key.col);
+        keymap_cache_info.miss_cnt++;
+    } else {
+        keymap_cache_info.hit_cnt++;
+    }
+    *p_layer   = keymap_cache_layer[key.row][key.col];
+    *p_keycode = keymap_cache_keycode[key.row][key.col];
+    return true;
+}
+#endif
+
+/** \brief Layer switch get keycode
+ *
+ * Gets the keycode of key on layer, taking it from the resolved keymap cache when it holds that layer
+ */
+uint16_t layer_switch_get_keycode(uint8_t layer, keypos_t key) {
+#ifndef NO_ACTION_LAYER
+    if (keymap_cache_in_matrix(key) && (keymap_cache_valid[key.row] & (((matrix_row_t)1) << key.col)) && keymap_cache_layer[key.row][key.col] == layer) {
+        return keymap_cache_keycode[key.row][key.col];  // V261019R7: 눌림 때 해석한 위치는 키맵을 다시 읽지 않음
+    }
+#endif
+    return keymap_key_to_keycode(layer, key);
+}
+
 /** \brief Store or get action (FIXME: Needs better summary)
  *
  * Make sure the action triggered when the key is released is the same
@@ -310,7 +487,7 @@ action_t store_or_get_action(bool pressed, keypos_t key) {
     } else {
         layer = read_source_layers_cache(key);
     }
-    return action_for_key(layer, key);
+    return action_for_keycode(layer_switch_get_keycode(layer, key));  // V261019R7
 #else
     return layer_switch_get_action(key);
 #endif
@@ -322,21 +499,13 @@ action_t store_or_get_action(bool pressed, keypos_t key) {
  */
 uint8_t layer_switch_get_layer(keypos_t key) {
 #ifndef NO_ACTION_LAYER
-    action_t action;
-    action.code = ACTION_TRANSPARENT;
+    uint8_t  layer;
+    uint16_t keycode;
 
-    layer_state_t layers = layer_state | default_layer_state;
-    /* check top layer first */
-    for (int8_t i = MAX_LAYER - 1; i >= 0; i--) {
-        if (layers & ((layer_state_t)1 << i)) {
-            action = action_for_key(i, key);
-            if (action.code != ACTION_TRANSPARENT) {
-                return i;
-            }
-        }
+    if (keymap_cache_lookup(key, &layer, &keycode)) {
+        return layer;  // V261019R7: 해석 캐시 배열 읽기
     }
-    /* fall back to layer 0 */
-    return 0;
+    return keymap_cache_resolve(layer_state | default_layer_state, key, &keycode);
 #else
     return get_highest_layer(default_layer_state);
 #endif
@@ -347,7 +516,7 @@ uint8_t layer_switch_get_layer(keypos_t key) {
  * Gets action code based on key position
  */
 action_t layer_switch_get_action(keypos_t key) {
-    return action_for_key(layer_switch_get_layer(key), key);
+    return action_for_keycode(layer_switch_get_keycode(layer_switch_get_layer(key), key));  // V261019R7
 }
 
 #ifndef NO_ACTION_LAYER
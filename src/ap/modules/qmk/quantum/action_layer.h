@@ -166,5 +166,26 @@ action_t store_or_get_action(bool pressed, keypos_t key);
 /* return the topmost non-transparent layer currently associated with key */
 uint8_t layer_switch_get_layer(keypos_t key);
 
+/* return the keycode of key on layer (resolved keymap cache when it matches) */
+uint16_t layer_switch_get_keycode(uint8_t layer, keypos_t key);
+
+#ifndef NO_ACTION_LAYER
+/* resolved keymap cache (V261019R7) */
+typedef struct {
+    uint32_t hit_cnt;   // 해석 결과를 그대로 쓴 조회
+    uint32_t miss_cnt;  // 조회 시 비어 있어 바로 해석한 위치
+    uint32_t fill_cnt;  // 해석한 위치 수 (조회 + task)
+    uint32_t sync_cnt;  // 레이어 상태 변경 반영 횟수
+    uint32_t drop_cnt;  // 레이어 상태 변경으로 무효화한 위치 수
+} keymap_cache_info_t;
+
+void keymap_cache_invalidate(uint8_t row, uint8_t col);
+void keymap_cache_invalidate_all(void);
+void keymap_cache_task(void);
+void keymap_cache_set_enable(bool enable);
+bool keymap_cache_is_enabled(void);
+void keymap_cache_get_info(keymap_cache_info_t *p_info);
+#endif
+
 /* return action depending on current layer status */
 action_t layer_switch_get_action(keypos_t key);
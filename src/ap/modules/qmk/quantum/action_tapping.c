@@ -20,8 +20,9 @@
 #    else
 #        define IS_TAPPING_RECORD(r) (KEYEQ(tapping_key.event.key, (r->event.key)) && tapping_key.keycode == r->keycode)
 #    endif
-#    define WITHIN_TAPPING_TERM(e) (TIMER_DIFF_16(e.time, tapping_key.event.time) < GET_TAPPING_TERM(get_record_keycode(&tapping_key, false), &tapping_key))
-#    define WITHIN_QUICK_TAP_TERM(e) (TIMER_DIFF_16(e.time, tapping_key.event.time) < GET_QUICK_TAP_TERM(get_record_keycode(&tapping_key, false), &tapping_key))
+// V261017R8: 키 이벤트끼리는 스위치 엣지 시각(us)으로 비교하고, tick/엣지 미상 이벤트는 기존 ms 처리 시각을 사용한다.
+#    define WITHIN_TAPPING_TERM(e) (tapping_event_within((e), GET_TAPPING_TERM(get_record_keycode(&tapping_key, false), &tapping_key)))
+#    define WITHIN_QUICK_TAP_TERM(e) (tapping_event_within((e), GET_QUICK_TAP_TERM(get_record_keycode(&tapping_key, false), &tapping_key)))
 
 #    ifdef DYNAMIC_TAPPING_TERM_ENABLE
 uint16_t g_tapping_term = TAPPING_TERM;
@@ -65,6 +66,7 @@ static uint8_t     waiting_buffer_head                 = 0;
 static uint8_t     waiting_buffer_tail                 = 0;
 
 static bool process_tapping(keyrecord_t *record);
+static inline bool tapping_event_within(keyevent_t event, uint16_t term_ms);
 static bool waiting_buffer_enq(keyrecord_t record);
 static void waiting_buffer_clear(void);
 static bool waiting_buffer_typed(keyevent_t event);
@@ -73,6 +75,20 @@ static void waiting_buffer_scan_tap(void);
 static void debug_tapping_key(void);
 static void debug_waiting_buffer(void);
 
+/* V261017R8: tapping_key 와 event 사이 간격이 term_ms 미만인지 판정한다.
+ *   - 둘 다 엣지 시각을 가진 키 이벤트면 us 단위로 비교해 같은 ms 안의 순서와 sub-ms 보류 시간을 구분한다.
+ *   - 디바운스 대기 중이던 키가 늦게 처리되어 엣지 순서가 역전되면 간격 0 으로 본다.
+ *   - tick 이벤트는 처리 시각 기준이어야 디바운스 지연만큼 일찍 hold 로 판정하지 않으므로 ms 비교를 유지한다.
+ */
+static inline bool tapping_event_within(keyevent_t event, uint16_t term_ms) {
+    if (IS_KEYEVENT(event) && event.has_time_us && tapping_key.event.has_time_us) {  // V261020R2: 0 us 센티널 대신 유효 비트
+        int32_t diff_us = (int32_t)(event.time_us - tapping_key.event.time_us);
+
+        return diff_us < 0 || (uint32_t)diff_us < (uint32_t)term_ms * 1000U;
+    }
+    return TIMER_DIFF_16(event.time, tapping_key.event.time) < term_ms;
+}
+
 /** \brief Action Tapping Process
  *
  * FIXME: Needs doc
@@ -307,6 +323,8 @@ bool process_tapping(keyrecord_t *keyp) {
                             .tap           = tapping_key.tap,
                             .event.key     = tapping_key.event.key,
                             .event.time    = event.time,
+                            .event.time_us = event.time_us,
+                            .event.has_time_us = event.has_time_us,
                             .event.pressed = false,
                             .event.type    = tapping_key.event.type,
 #    ifdef COMBO_ENABLE
@@ -358,6 +376,8 @@ bool process_tapping(keyrecord_t *keyp) {
                             .tap           = tapping_key.tap,
                             .event.key     = tapping_key.event.key,
                             .event.time    = event.time,
+                            .event.time_us = event.time_us,
+                            .event.has_time_us = event.has_time_us,
                             .event.pressed = false,
                             .event.type    = tapping_key.event.type,
 #    ifdef COMBO_ENABLE
@@ -303,10 +303,24 @@ void send_nkro_report(void) {
     nkro_report->mods = get_mods_for_report();
 
     static report_nkro_t last_report;
+    bool                 changed = false;
+    uint8_t              lo, hi;
 
     /* Only send the report if there are changes to propagate to the host. */
-    if (memcmp(nkro_report, &last_report, sizeof(report_nkro_t)) != 0) {
-        memcpy(&last_report, nkro_report, sizeof(report_nkro_t));
+    // V261018R1: 비트맵은 add/del 로 바뀐 바이트 구간만 비교/복사한다 (전체 30B memcmp 대신)
+    if (nkro_report->mods != last_report.mods) {
+        last_report.mods = nkro_report->mods;
+        changed          = true;
+    }
+    if (nkro_report_take_dirty(&lo, &hi)) {
+        uint8_t len = hi - lo + 1;
+
+        if (memcmp(&nkro_report->bits[lo], &last_report.bits[lo], len) != 0) {
+            memcpy(&last_report.bits[lo], &nkro_report->bits[lo], len);
+            changed = true;
+        }
+    }
+    if (changed) {
         host_nkro_send(nkro_report);
     }
 }
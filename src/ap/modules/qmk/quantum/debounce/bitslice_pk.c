@@ -0,0 +1,358 @@
+#include "debounce.h"
+#include "debounce_runtime.h"
+#include "timer.h"
+#include <string.h>
+
+
+// ---------------------------------------------------------------------------
+// [Bit-sliced Debounce] V261017R3
+//   - 키별 8비트 카운터를 비트 평면(plane[bit][row])으로 나눠 저장하는 수직 카운터 구현
+//   - 한 행의 모든 키 카운터를 matrix_row_t 단위 AND/XOR 로 동시에 감산한다.
+//   - 저장소는 MATRIX_ROWS 기준 정적 배열이며 세 커널(sym_defer/sym_eager/asym_eager_defer)이 공유한다.
+//     런타임 엔진은 한 번에 하나의 알고리즘만 활성화하므로 공유해도 안전하다.
+//   - 동작은 각 *_pk 알고리즘과 동일하며 VIA 에서 모드 3~5 로 선택한다.
+// ---------------------------------------------------------------------------
+#define DEBOUNCE_BS_BITS          8                   // 카운터 폭 (최대 255 틱)
+
+
+typedef struct
+{
+  matrix_row_t plane[DEBOUNCE_BS_BITS][MATRIX_ROWS];  // 카운터 비트 b 의 행별 비트 평면
+  matrix_row_t active[MATRIX_ROWS];                   // 카운터가 동작 중인 키
+  matrix_row_t pressed[MATRIX_ROWS];                  // asym: 카운터 시작 시점의 raw 상태
+  fast_timer_t last_time;
+  uint8_t      rows;
+  bool         counters_need_update;
+  bool         matrix_need_update;
+} debounce_bs_state_t;
+
+static debounce_bs_state_t bs_state;
+
+
+static bool         debounce_bs_init(uint8_t num_rows);
+static void         debounce_bs_free(void);
+static uint8_t      debounce_bs_elapsed(void);
+static void         debounce_bs_load(uint8_t row, matrix_row_t mask, uint8_t value);
+static void         debounce_bs_clear(uint8_t row, matrix_row_t mask);
+static matrix_row_t debounce_bs_tick(uint8_t row, uint8_t elapsed);
+
+
+
+
+static bool debounce_bs_init(uint8_t num_rows)
+{
+  if (num_rows > MATRIX_ROWS)
+  {
+    return false;
+  }
+
+  memset(&bs_state, 0, sizeof(bs_state));
+  bs_state.rows      = num_rows;
+  bs_state.last_time = debounce_runtime_timer_read();
+  return true;
+}
+
+static void debounce_bs_free(void)
+{
+  memset(&bs_state, 0, sizeof(bs_state));
+}
+
+// 마지막 호출 이후 경과 틱을 반환한다. *_pk 와 동일하게 UINT8_MAX 에서 포화시킨다.
+static uint8_t debounce_bs_elapsed(void)
+{
+  fast_timer_t now     = debounce_runtime_timer_read();
+  fast_timer_t elapsed = TIMER_DIFF_FAST(now, bs_state.last_time);
+
+  bs_state.last_time = now;
+  if (elapsed > UINT8_MAX)
+  {
+    elapsed = UINT8_MAX;
+  }
+  return (uint8_t)elapsed;
+}
+
+static void debounce_bs_load(uint8_t row, matrix_row_t mask, uint8_t value)
+{
+  for (uint8_t b = 0; b < DEBOUNCE_BS_BITS; b++)
+  {
+    matrix_row_t bits = ((value >> b) & 1U) ? mask : 0;
+
+    bs_state.plane[b][row] = (bs_state.plane[b][row] & ~mask) | bits;
+  }
+  bs_state.active[row] |= mask;
+}
+
+static void debounce_bs_clear(uint8_t row, matrix_row_t mask)
+{
+  for (uint8_t b = 0; b < DEBOUNCE_BS_BITS; b++)
+  {
+    bs_state.plane[b][row] &= ~mask;
+  }
+  bs_state.active[row] &= ~mask;
+}
+
+// 동작 중인 키 카운터에서 elapsed 를 비트 직렬 감산하고, 0 이하가 된 키 마스크를 반환한다.
+static matrix_row_t debounce_bs_tick(uint8_t row, uint8_t elapsed)
+{
+  matrix_row_t lanes   = bs_state.active[row];
+  matrix_row_t borrow  = 0;
+  matrix_row_t nonzero = 0;
+
+  if (lanes == 0)
+  {
+    return 0;
+  }
+
+  for (uint8_t b = 0; b < DEBOUNCE_BS_BITS; b++)
+  {
+    matrix_row_t x = bs_state.plane[b][row];
+    matrix_row_t y = ((elapsed >> b) & 1U) ? lanes : 0;
+    matrix_row_t d = x ^ y ^ borrow;
+
+    borrow                 = (~x & (y | borrow)) | (y & borrow);
+    bs_state.plane[b][row] = d;
+    nonzero               |= d;
+  }
+
+  matrix_row_t expired = lanes & (borrow | ~nonzero);
+
+  if (expired != 0)
+  {
+    debounce_bs_clear(row, expired);
+  }
+  if (bs_state.active[row] != 0)
+  {
+    bs_state.counters_need_update = true;
+  }
+  return expired;
+}
+
+
+// sym_defer_bs : 변화가 delay 동안 유지되면 반영 (sym_defer_pk 와 동일)
+//
+bool debounce_sym_defer_bs_init(uint8_t num_rows)
+{
+  return debounce_bs_init(num_rows);
+}
+
+void debounce_sym_defer_bs_free(void)
+{
+  debounce_bs_free();
+}
+
+bool debounce_sym_defer_bs_run(matrix_row_t raw[], matrix_row_t cooked[], uint8_t num_rows, bool changed)
+{
+  bool updated_last   = false;
+  bool cooked_changed = false;
+
+  if (bs_state.counters_need_update)
+  {
+    uint8_t elapsed = debounce_bs_elapsed();
+
+    updated_last = true;
+    if (elapsed > 0)
+    {
+      bs_state.counters_need_update = false;
+      for (uint8_t row = 0; row < num_rows; row++)
+      {
+        matrix_row_t expired = debounce_bs_tick(row, elapsed);
+
+        if (expired != 0)
+        {
+          matrix_row_t cooked_next = (cooked[row] & ~expired) | (raw[row] & expired);
+
+          cooked_changed |= (cooked_next != cooked[row]);
+          cooked[row]     = cooked_next;
+        }
+      }
+    }
+  }
+
+  if (changed)
+  {
+    const uint8_t delay = debounce_runtime_release_delay();
+
+    if (!updated_last)
+    {
+      bs_state.last_time = debounce_runtime_timer_read();
+    }
+    for (uint8_t row = 0; row < num_rows; row++)
+    {
+      matrix_row_t delta  = raw[row] ^ cooked[row];
+      matrix_row_t start  = delta & ~bs_state.active[row];
+      matrix_row_t cancel = ~delta & bs_state.active[row];
+
+      if (start != 0)
+      {
+        debounce_bs_load(row, start, delay);
+        bs_state.counters_need_update = true;
+      }
+      if (cancel != 0)
+      {
+        debounce_bs_clear(row, cancel);
+      }
+    }
+  }
+
+  return cooked_changed;
+}
+
+
+// sym_eager_bs : 변화 즉시 반영 후 delay 동안 잠금 (sym_eager_pk 와 동일)
+//
+bool debounce_sym_eager_bs_init(uint8_t num_rows)
+{
+  return debounce_bs_init(num_rows);
+}
+
+void debounce_sym_eager_bs_free(void)
+{
+  debounce_bs_free();
+}
+
+bool debounce_sym_eager_bs_run(matrix_row_t raw[], matrix_row_t cooked[], uint8_t num_rows, bool changed)
+{
+  bool updated_last   = false;
+  bool cooked_changed = false;
+
+  if (bs_state.counters_need_update)
+  {
+    uint8_t elapsed = debounce_bs_elapsed();
+
+    updated_last = true;
+    if (elapsed > 0)
+    {
+      bs_state.counters_need_update = false;
+      bs_state.matrix_need_update   = false;
+      for (uint8_t row = 0; row < num_rows; row++)
+      {
+        if (debounce_bs_tick(row, elapsed) != 0)
+        {
+          bs_state.matrix_need_update = true;             // 잠금 해제된 키의 대기 중 변화를 다시 반영
+        }
+      }
+    }
+  }
+
+  if (changed || bs_state.matrix_need_update)
+  {
+    const uint8_t delay = debounce_runtime_release_delay();
+
+    if (!updated_last)
+    {
+      bs_state.last_time = debounce_runtime_timer_read();
+    }
+    bs_state.matrix_need_update = false;
+    for (uint8_t row = 0; row < num_rows; row++)
+    {
+      matrix_row_t flip = (raw[row] ^ cooked[row]) & ~bs_state.active[row];
+
+      if (flip != 0)
+      {
+        debounce_bs_load(row, flip, delay);
+        bs_state.counters_need_update = true;
+        cooked[row]                  ^= flip;
+        cooked_changed                = true;
+      }
+    }
+  }
+
+  return cooked_changed;
+}
+
+
+// asym_eager_defer_bs : press 는 즉시 반영 후 잠금, release 는 유지 시 반영 (asym_eager_defer_pk 와 동일)
+//
+bool debounce_asym_eager_defer_bs_init(uint8_t num_rows)
+{
+  return debounce_bs_init(num_rows);
+}
+
+void debounce_asym_eager_defer_bs_free(void)
+{
+  debounce_bs_free();
+}
+
+bool debounce_asym_eager_defer_bs_run(matrix_row_t raw[], matrix_row_t cooked[], uint8_t num_rows, bool changed)
+{
+  bool updated_last   = false;
+  bool cooked_changed = false;
+
+  if (bs_state.counters_need_update)
+  {
+    uint8_t elapsed = debounce_bs_elapsed();
+
+    updated_last = true;
+    if (elapsed > 0)
+    {
+      bs_state.counters_need_update = false;
+      bs_state.matrix_need_update   = false;
+      for (uint8_t row = 0; row < num_rows; row++)
+      {
+        matrix_row_t expired = debounce_bs_tick(row, elapsed);
+
+        if (expired == 0)
+        {
+          continue;
+        }
+
+        matrix_row_t released = expired & ~bs_state.pressed[row];
+
+        if ((expired & bs_state.pressed[row]) != 0)
+        {
+          bs_state.matrix_need_update = true;             // key-down: eager 잠금 해제
+        }
+        if (released != 0)
+        {
+          matrix_row_t cooked_next = (cooked[row] & ~released) | (raw[row] & released);  // key-up: defer
+
+          cooked_changed |= (cooked_next != cooked[row]);
+          cooked[row]     = cooked_next;
+        }
+      }
+    }
+  }
+
+  if (changed || bs_state.matrix_need_update)
+  {
+    const uint8_t press_delay   = debounce_runtime_press_delay();
+    const uint8_t release_delay = debounce_runtime_release_delay();
+
+    if (!updated_last)
+    {
+      bs_state.last_time = debounce_runtime_timer_read();
+    }
+    bs_state.matrix_need_update = false;
+    for (uint8_t row = 0; row < num_rows; row++)
+    {
+      matrix_row_t delta  = raw[row] ^ cooked[row];
+      matrix_row_t start  = delta & ~bs_state.active[row];
+      matrix_row_t cancel = ~delta & bs_state.active[row] & ~bs_state.pressed[row];
+
+      if (start != 0)
+      {
+        matrix_row_t down = start & raw[row];
+        matrix_row_t up   = start & ~raw[row];
+
+        if (down != 0)
+        {
+          debounce_bs_load(row, down, press_delay);
+          cooked[row]   |= down;
+          cooked_changed = true;
+        }
+        if (up != 0)
+        {
+          debounce_bs_load(row, up, release_delay);
+        }
+        bs_state.pressed[row]         = (bs_state.pressed[row] & ~start) | down;
+        bs_state.counters_need_update = true;
+      }
+      if (cancel != 0)
+      {
+        debounce_bs_clear(row, cancel);                   // key-up 대기 중 다시 눌림: defer 취소
+      }
+    }
+  }
+
+  return cooked_changed;
+}
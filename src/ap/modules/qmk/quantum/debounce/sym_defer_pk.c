@@ -55,7 +55,7 @@ bool debounce_sym_defer_pk_init(uint8_t num_rows)
     memset(debounce_counters, DEBOUNCE_ELAPSED, (size_t)num_rows * MATRIX_COLS * sizeof(debounce_counter_t));
     counters_need_update = false;
     cooked_changed       = false;
-    last_time            = timer_read_fast();
+    last_time            = debounce_runtime_timer_read();   // V261017R2: 런타임 단위(ms 또는 125us 틱) 타이머 사용
     return true;
 }
 
@@ -72,7 +72,7 @@ bool debounce_sym_defer_pk_run(matrix_row_t raw[], matrix_row_t cooked[], uint8_
     cooked_changed    = false;
 
     if (counters_need_update) {
-        fast_timer_t now          = timer_read_fast();
+        fast_timer_t now          = debounce_runtime_timer_read();
         fast_timer_t elapsed_time = TIMER_DIFF_FAST(now, last_time);
 
         last_time    = now;
@@ -88,7 +88,7 @@ bool debounce_sym_defer_pk_run(matrix_row_t raw[], matrix_row_t cooked[], uint8_
 
     if (changed) {
         if (!updated_last) {
-            last_time = timer_read_fast();
+            last_time = debounce_runtime_timer_read();
         }
 
         start_debounce_counters(raw, cooked, num_rows);
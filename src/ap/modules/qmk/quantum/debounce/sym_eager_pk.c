@@ -57,7 +57,7 @@ bool debounce_sym_eager_pk_init(uint8_t num_rows)
     counters_need_update = false;
     matrix_need_update   = false;
     cooked_changed       = false;
-    last_time            = timer_read_fast();
+    last_time            = debounce_runtime_timer_read();   // V261017R2: 런타임 단위(ms 또는 125us 틱) 타이머 사용
     return true;
 }
 
@@ -75,7 +75,7 @@ bool debounce_sym_eager_pk_run(matrix_row_t raw[], matrix_row_t cooked[], uint8_
     cooked_changed    = false;
 
     if (counters_need_update) {
-        fast_timer_t now          = timer_read_fast();
+        fast_timer_t now          = debounce_runtime_timer_read();
         fast_timer_t elapsed_time = TIMER_DIFF_FAST(now, last_time);
 
         last_time    = now;
@@ -91,7 +91,7 @@ bool debounce_sym_eager_pk_run(matrix_row_t raw[], matrix_row_t cooked[], uint8_
 
     if (changed || matrix_need_update) {
         if (!updated_last) {
-            last_time = timer_read_fast();
+            last_time = debounce_runtime_timer_read();
         }
 
         transfer_matrix_values(raw, cooked, num_rows);
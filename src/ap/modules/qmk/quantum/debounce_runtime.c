@@ -1,6 +1,7 @@
 #include "debounce_runtime.h"
 #include "debounce.h"
 #include "matrix.h"
+#include "timer.h"
 #include <stddef.h>
 #include <string.h>
 
@@ -16,9 +17,12 @@
 #endif
 
 // V251115R3: 보드 config.h의 디바운스 기본값을 런타임 기본값으로 반영
-#define DEBOUNCE_RUNTIME_CFG_sym_defer_pk        { .type = DEBOUNCE_RUNTIME_TYPE_SYM_DEFER_PK,       .pre_ms = (uint8_t)(QMK_DEFAULT_DEBOUNCE_DELAY), .post_ms = (uint8_t)(QMK_DEFAULT_DEBOUNCE_DELAY) }
-#define DEBOUNCE_RUNTIME_CFG_sym_eager_pk        { .type = DEBOUNCE_RUNTIME_TYPE_SYM_EAGER_PK,       .pre_ms = 1U,                                       .post_ms = (uint8_t)(QMK_DEFAULT_DEBOUNCE_DELAY) }
-#define DEBOUNCE_RUNTIME_CFG_asym_eager_defer_pk { .type = DEBOUNCE_RUNTIME_TYPE_ASYM_EAGER_DEFER_PK, .pre_ms = (uint8_t)(QMK_DEFAULT_DEBOUNCE_DELAY), .post_ms = (uint8_t)(QMK_DEFAULT_DEBOUNCE_DELAY) }
+#define DEBOUNCE_RUNTIME_CFG_sym_defer_pk        { .type = DEBOUNCE_RUNTIME_TYPE_SYM_DEFER_PK,       .pre_ms = (uint8_t)(QMK_DEFAULT_DEBOUNCE_DELAY), .post_ms = (uint8_t)(QMK_DEFAULT_DEBOUNCE_DELAY), .unit = DEBOUNCE_RUNTIME_UNIT_MS }
+#define DEBOUNCE_RUNTIME_CFG_sym_eager_pk        { .type = DEBOUNCE_RUNTIME_TYPE_SYM_EAGER_PK,       .pre_ms = 1U,                                       .post_ms = (uint8_t)(QMK_DEFAULT_DEBOUNCE_DELAY), .unit = DEBOUNCE_RUNTIME_UNIT_MS }
+#define DEBOUNCE_RUNTIME_CFG_asym_eager_defer_pk { .type = DEBOUNCE_RUNTIME_TYPE_ASYM_EAGER_DEFER_PK, .pre_ms = (uint8_t)(QMK_DEFAULT_DEBOUNCE_DELAY), .post_ms = (uint8_t)(QMK_DEFAULT_DEBOUNCE_DELAY), .unit = DEBOUNCE_RUNTIME_UNIT_MS }
+#define DEBOUNCE_RUNTIME_CFG_sym_defer_bs        { .type = DEBOUNCE_RUNTIME_TYPE_SYM_DEFER_BS,       .pre_ms = (uint8_t)(QMK_DEFAULT_DEBOUNCE_DELAY), .post_ms = (uint8_t)(QMK_DEFAULT_DEBOUNCE_DELAY), .unit = DEBOUNCE_RUNTIME_UNIT_MS }
+#define DEBOUNCE_RUNTIME_CFG_sym_eager_bs        { .type = DEBOUNCE_RUNTIME_TYPE_SYM_EAGER_BS,       .pre_ms = 1U,                                       .post_ms = (uint8_t)(QMK_DEFAULT_DEBOUNCE_DELAY), .unit = DEBOUNCE_RUNTIME_UNIT_MS }
+#define DEBOUNCE_RUNTIME_CFG_asym_eager_defer_bs { .type = DEBOUNCE_RUNTIME_TYPE_ASYM_EAGER_DEFER_BS, .pre_ms = (uint8_t)(QMK_DEFAULT_DEBOUNCE_DELAY), .post_ms = (uint8_t)(QMK_DEFAULT_DEBOUNCE_DELAY), .unit = DEBOUNCE_RUNTIME_UNIT_MS }
 #define DEBOUNCE_RUNTIME_CFG_JOIN(type)          DEBOUNCE_RUNTIME_CFG_##type
 #define DEBOUNCE_RUNTIME_CFG(type)               DEBOUNCE_RUNTIME_CFG_JOIN(type)  // V251115R3: 토큰 전달 시 매크로 확장 허용
 
@@ -41,10 +45,24 @@ bool debounce_asym_eager_defer_pk_init(uint8_t num_rows);
 bool debounce_asym_eager_defer_pk_run(matrix_row_t raw[], matrix_row_t cooked[], uint8_t num_rows, bool changed);
 void debounce_asym_eager_defer_pk_free(void);
 
+// V261017R3: 정적 비트 평면 저장소를 쓰는 수직 카운터 커널 (quantum/debounce/bitslice_pk.c)
+bool debounce_sym_defer_bs_init(uint8_t num_rows);
+bool debounce_sym_defer_bs_run(matrix_row_t raw[], matrix_row_t cooked[], uint8_t num_rows, bool changed);
+void debounce_sym_defer_bs_free(void);
+
+bool debounce_sym_eager_bs_init(uint8_t num_rows);
+bool debounce_sym_eager_bs_run(matrix_row_t raw[], matrix_row_t cooked[], uint8_t num_rows, bool changed);
+void debounce_sym_eager_bs_free(void);
+
+bool debounce_asym_eager_defer_bs_init(uint8_t num_rows);
+bool debounce_asym_eager_defer_bs_run(matrix_row_t raw[], matrix_row_t cooked[], uint8_t num_rows, bool changed);
+void debounce_asym_eager_defer_bs_free(void);
+
 
 typedef struct
 {
   debounce_runtime_type_t type;
+  debounce_runtime_type_t base_type;                  // V261017R3: VIA 지연 항목 구성이 같은 *_PK 타입
   debounce_algo_init_t    init;
   debounce_algo_run_t     run;
   debounce_algo_free_t    free;
@@ -57,6 +75,7 @@ static const debounce_algo_entry_t k_algorithms[] =
 {
   {
     .type        = DEBOUNCE_RUNTIME_TYPE_SYM_DEFER_PK,
+    .base_type   = DEBOUNCE_RUNTIME_TYPE_SYM_DEFER_PK,
     .init        = debounce_sym_defer_pk_init,
     .run         = debounce_sym_defer_pk_run,
     .free        = debounce_sym_defer_pk_free,
@@ -65,6 +84,7 @@ static const debounce_algo_entry_t k_algorithms[] =
   },
   {
     .type        = DEBOUNCE_RUNTIME_TYPE_SYM_EAGER_PK,
+    .base_type   = DEBOUNCE_RUNTIME_TYPE_SYM_EAGER_PK,
     .init        = debounce_sym_eager_pk_init,
     .run         = debounce_sym_eager_pk_run,
     .free        = debounce_sym_eager_pk_free,
@@ -73,12 +93,40 @@ static const debounce_algo_entry_t k_algorithms[] =
   },
   {
     .type        = DEBOUNCE_RUNTIME_TYPE_ASYM_EAGER_DEFER_PK,
+    .base_type   = DEBOUNCE_RUNTIME_TYPE_ASYM_EAGER_DEFER_PK,
     .init        = debounce_asym_eager_defer_pk_init,
     .run         = debounce_asym_eager_defer_pk_run,
     .free        = debounce_asym_eager_defer_pk_free,
     .max_pre_ms  = 127,
     .max_post_ms = 127,
   },
+  {
+    .type        = DEBOUNCE_RUNTIME_TYPE_SYM_DEFER_BS,
+    .base_type   = DEBOUNCE_RUNTIME_TYPE_SYM_DEFER_PK,
+    .init        = debounce_sym_defer_bs_init,
+    .run         = debounce_sym_defer_bs_run,
+    .free        = debounce_sym_defer_bs_free,
+    .max_pre_ms  = UINT8_MAX,
+    .max_post_ms = UINT8_MAX,
+  },
+  {
+    .type        = DEBOUNCE_RUNTIME_TYPE_SYM_EAGER_BS,
+    .base_type   = DEBOUNCE_RUNTIME_TYPE_SYM_EAGER_PK,
+    .init        = debounce_sym_eager_bs_init,
+    .run         = debounce_sym_eager_bs_run,
+    .free        = debounce_sym_eager_bs_free,
+    .max_pre_ms  = UINT8_MAX,
+    .max_post_ms = UINT8_MAX,
+  },
+  {
+    .type        = DEBOUNCE_RUNTIME_TYPE_ASYM_EAGER_DEFER_BS,
+    .base_type   = DEBOUNCE_RUNTIME_TYPE_ASYM_EAGER_DEFER_PK,
+    .init        = debounce_asym_eager_defer_bs_init,
+    .run         = debounce_asym_eager_defer_bs_run,
+    .free        = debounce_asym_eager_defer_bs_free,
+    .max_pre_ms  = UINT8_MAX,                           // V261017R3: 8비트 평면이므로 pk 의 7비트 제한 없음
+    .max_post_ms = UINT8_MAX,
+  },
 };
 
 
@@ -91,6 +139,8 @@ typedef struct
   bool                         config_ready;
   bool                         pending_reinit;
   debounce_runtime_error_t     last_error;
+  uint32_t                     tick_base_us;              // V261017R2: 마지막으로 틱에 반영한 micros() 시각
+  uint32_t                     tick_count;                // V261017R2: 누적 125us 틱 (32비트 wrap 허용)
 } debounce_runtime_state_t;
 
 static debounce_runtime_state_t g_runtime = {0};
@@ -121,6 +171,12 @@ bool debounce_runtime_apply_config(const debounce_runtime_config_t *config)
     return false;
   }
 
+  if (config->unit >= DEBOUNCE_RUNTIME_UNIT_COUNT)
+  {
+    g_runtime.last_error = DEBOUNCE_RUNTIME_ERROR_UNSUPPORTED;   // V261017R2: 알 수 없는 시간 단위 거부
+    return false;
+  }
+
   debounce_runtime_config_t sanitized = *config;
   sanitized.pre_ms  = debounce_runtime_clamp_delay(config->pre_ms, algo->max_pre_ms);
   sanitized.post_ms = debounce_runtime_clamp_delay(config->post_ms, algo->max_post_ms);
@@ -159,6 +215,28 @@ debounce_runtime_error_t debounce_runtime_get_last_error(void)
   return g_runtime.last_error;
 }
 
+debounce_runtime_type_t debounce_runtime_get_base_type(debounce_runtime_type_t type)
+{
+  const debounce_algo_entry_t *algo = debounce_runtime_find_algo(type);
+
+  if (algo == NULL)
+  {
+    return type;
+  }
+  return algo->base_type;
+}
+
+uint8_t debounce_runtime_get_max_delay(debounce_runtime_type_t type)
+{
+  const debounce_algo_entry_t *algo = debounce_runtime_find_algo(type);
+
+  if (algo == NULL)
+  {
+    return UINT8_MAX;
+  }
+  return algo->max_pre_ms < algo->max_post_ms ? algo->max_pre_ms : algo->max_post_ms;
+}
+
 bool debounce_runtime_is_ready(void)
 {
   return (g_runtime.config_ready == true) &&
@@ -176,6 +254,23 @@ uint8_t debounce_runtime_release_delay(void)
   return debounce_runtime_get_config()->post_ms;
 }
 
+uint32_t debounce_runtime_timer_read(void)
+{
+  if (debounce_runtime_get_config()->unit != DEBOUNCE_RUNTIME_UNIT_125US)
+  {
+    return timer_read_fast();
+  }
+
+  // V261017R2: micros()를 125us 틱으로 누적 변환한다.
+  //            나머지는 tick_base_us 에 남겨 micros() 32비트 wrap 시에도 틱이 연속되도록 한다.
+  uint32_t elapsed_us = micros() - g_runtime.tick_base_us;
+  uint32_t ticks      = elapsed_us / DEBOUNCE_RUNTIME_TICK_US;
+
+  g_runtime.tick_base_us += ticks * DEBOUNCE_RUNTIME_TICK_US;
+  g_runtime.tick_count   += ticks;
+  return g_runtime.tick_count;
+}
+
 void debounce_init(uint8_t num_rows)
 {
   g_runtime.rows       = num_rows;
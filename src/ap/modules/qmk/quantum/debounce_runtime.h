@@ -10,14 +10,27 @@ typedef enum
   DEBOUNCE_RUNTIME_TYPE_SYM_DEFER_PK = 0,
   DEBOUNCE_RUNTIME_TYPE_SYM_EAGER_PK = 1,
   DEBOUNCE_RUNTIME_TYPE_ASYM_EAGER_DEFER_PK = 2,
+  DEBOUNCE_RUNTIME_TYPE_SYM_DEFER_BS = 3,           // V261017R3: 비트 평면(수직 카운터) 커널, 동작은 *_PK 와 동일
+  DEBOUNCE_RUNTIME_TYPE_SYM_EAGER_BS = 4,
+  DEBOUNCE_RUNTIME_TYPE_ASYM_EAGER_DEFER_BS = 5,
   DEBOUNCE_RUNTIME_TYPE_COUNT
 } debounce_runtime_type_t;  // V251115R1: VIA 런타임 전용 디바운스 알고리즘 구분값
 
+typedef enum
+{
+  DEBOUNCE_RUNTIME_UNIT_MS    = 0,
+  DEBOUNCE_RUNTIME_UNIT_125US = 1,
+  DEBOUNCE_RUNTIME_UNIT_COUNT
+} debounce_runtime_unit_t;  // V261017R2: 디바운스 카운터 시간 단위 (1ms 또는 125us 스캔 틱)
+
+#define DEBOUNCE_RUNTIME_TICK_US        125U              // V261017R2: 125us 단위 모드의 1틱 길이 (TIM16 스캔 주기)
+
 typedef struct
 {
   debounce_runtime_type_t type;
-  uint8_t                 pre_ms;
+  uint8_t                 pre_ms;                     // V261017R2: unit 단위 값 (125us 모드에서는 틱 수)
   uint8_t                 post_ms;
+  debounce_runtime_unit_t unit;                       // V261017R2: pre/post 값의 시간 단위
 } debounce_runtime_config_t;  // V251115R1: 런타임 디바운스 구성 (press/pre, release/post)
 
 typedef enum
@@ -33,7 +46,10 @@ const debounce_runtime_config_t *
 const debounce_runtime_config_t *
                               debounce_runtime_get_default_config(void);  // V251115R3: 보드 기본 디바운스 설정 조회
 debounce_runtime_error_t     debounce_runtime_get_last_error(void);
+debounce_runtime_type_t      debounce_runtime_get_base_type(debounce_runtime_type_t type);  // V261017R3: 동일 동작의 *_PK 타입 조회
+uint8_t                      debounce_runtime_get_max_delay(debounce_runtime_type_t type);  // V261019R8: 커널이 표현하는 최대 지연 (단위 무관)
 bool                         debounce_runtime_is_ready(void);
 
-uint8_t debounce_runtime_press_delay(void);
-uint8_t debounce_runtime_release_delay(void);
+uint8_t  debounce_runtime_press_delay(void);
+uint8_t  debounce_runtime_release_delay(void);
+uint32_t debounce_runtime_timer_read(void);                        // V261017R2: 현재 단위 기준 디바운스 타이머 (ms 또는 125us 틱)
@@ -22,6 +22,7 @@
 #include "send_string.h"
 #include "keycodes.h"
 #include "keyboard.h"  // V250928R3: 고스트 마스크 캐시 무효화를 위해 키보드 헬퍼 호출
+#include "action_layer.h"  // V261019R7: 해석 키맵 캐시 무효화
 
 #ifdef VIA_ENABLE
 #    include "via.h"
@@ -126,6 +127,9 @@ void dynamic_keymap_set_keycode(uint8_t layer, uint8_t row, uint8_t column, uint
     // Big endian, so we can read/write EEPROM directly from host if we want
     eeprom_update_byte(address, (uint8_t)(keycode >> 8));
     eeprom_update_byte(address + 1, (uint8_t)(keycode & 0xFF));
+#ifndef NO_ACTION_LAYER
+    keymap_cache_invalidate(row, column);  // V261019R7: 어느 레이어든 해당 위치의 해석 결과가 바뀔 수 있음
+#endif
 #if defined(MATRIX_HAS_GHOST)
     if (layer == 0) {
         keyboard_keymap_real_keys_invalidate(row);  // V250928R3: 베이스 레이어 변경 시 해당 행의 캐시를 무효화
@@ -171,6 +175,9 @@ void dynamic_keymap_reset(void) {
         }
 #endif // ENCODER_MAP_ENABLE
     }
+#ifndef NO_ACTION_LAYER
+    keymap_cache_invalidate_all();  // V261019R7
+#endif
 #if defined(MATRIX_HAS_GHOST)
     keyboard_keymap_real_keys_invalidate_all();  // V250928R3: 초기화 이후 모든 행의 마스크를 다시 계산하도록 요청
 #endif
@@ -198,6 +205,10 @@ void dynamic_keymap_set_buffer(uint16_t offset, uint16_t size, uint8_t *data) {
     for (uint16_t i = 0; i < size; i++) {
         if (offset + i < dynamic_keymap_eeprom_size) {
             eeprom_update_byte(target, *source);
+#ifndef NO_ACTION_LAYER
+            uint16_t pos = ((offset + i) / 2) % (MATRIX_ROWS * MATRIX_COLS);
+            keymap_cache_invalidate(pos / MATRIX_COLS, pos % MATRIX_COLS);  // V261019R7: 쓴 위치만 무효화
+#endif
         }
         source++;
         target++;
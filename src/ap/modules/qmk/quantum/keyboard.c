@@ -34,6 +34,7 @@ along with this program.  If not, see <http://www.gnu.org/licenses/>.
 #include "sendchar.h"
 #include "eeconfig.h"
 #include "action_layer.h"
+#include "latency.h"  // V261019R2: 디바운스 → action_exec 구간 지점
 #ifdef BOOTMAGIC_ENABLE
 #    include "bootmagic.h"
 #endif
@@ -497,6 +498,9 @@ void keyboard_init(void) {
 #ifdef VIA_ENABLE
     via_init();
 #endif
+#ifndef NO_ACTION_LAYER
+    keymap_cache_invalidate_all();  // V261019R7: EEPROM 재적재 후 이전 해석 결과를 버림
+#endif
 #ifdef SPLIT_KEYBOARD
     split_pre_init();
 #endif
@@ -610,6 +614,8 @@ static inline void generate_tick_event(void)
       .time = now,            // V251001R1: tick 이벤트도 스캔 시각을 재사용해 timer_read() 중복 호출 제거
       .type = TICK_EVENT,
       .pressed = false,
+      .has_time_us = true,         // V261020R2
+      .time_us = timer_read_us(),  // V261017R8: 엣지 시각과 같은 시계
     };
 
     action_exec(tick_event);
@@ -718,6 +724,8 @@ static bool matrix_task(void) {
             if (process_keypress) {
                 event.key.col = col;
                 event.pressed = key_pressed;
+                event.has_time_us = matrix_get_edge_us(row, col, &event.time_us);  // V261017R8: 스캔 시각 대신 키별 스위치 엣지 시각 전달 / V261020R2: 유효 비트 분리
+                latencyMark(LATENCY_POINT_ACTION);             // V261019R2: 첫 이벤트만 기록 (이후 호출은 무시)
                 action_exec(event);
             }
 
@@ -822,6 +830,10 @@ void keyboard_task(void) {
 
     quantum_task();
 
+#ifndef NO_ACTION_LAYER
+    keymap_cache_task();  // V261019R7: 레이어 변경 후 빈 해석 캐시를 한 행씩 채움
+#endif
+
 #if defined(SPLIT_WATCHDOG_ENABLE)
     split_watchdog_task();
 #endif
@@ -40,6 +40,8 @@ typedef struct {
     uint16_t        time;
     keyevent_type_t type;
     bool            pressed;
+    bool            has_time_us; // V261020R2: time_us 유효 여부. false 면 time(ms) 사용 (0 us 도 정상 시각)
+    uint32_t        time_us; // V261017R8: 스위치 엣지 시각(us, DMA 프레임 해상도)
 } keyevent_t;
 
 /* equivalent test of keypos_t */
@@ -74,7 +76,7 @@ static inline bool IS_DIPSWITCHEVENT(const keyevent_t event) {
 #define MAKE_KEYPOS(row_num, col_num) ((keypos_t){.row = (row_num), .col = (col_num)})
 
 /* Common keyevent_t object factory */
-#define MAKE_EVENT(row_num, col_num, press, event_type) ((keyevent_t){.key = MAKE_KEYPOS((row_num), (col_num)), .pressed = (press), .time = timer_read(), .type = (event_type)})
+#define MAKE_EVENT(row_num, col_num, press, event_type) ((keyevent_t){.key = MAKE_KEYPOS((row_num), (col_num)), .pressed = (press), .time = timer_read(), .type = (event_type), .has_time_us = true, .time_us = timer_read_us()})
 
 /**
  * @brief Constructs a key event for a pressed or released key.
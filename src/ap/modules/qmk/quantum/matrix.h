@@ -57,6 +57,9 @@ bool matrix_can_read(void);
 bool matrix_is_on(uint8_t row, uint8_t col);
 /* matrix state on row */
 matrix_row_t matrix_get_row(uint8_t row);
+/* microsecond time of the last raw edge that a switch's debounced state came from (V261017R8)
+ * returns false when no edge was recorded (V261020R2: 0 us is a valid micros() value) */
+bool matrix_get_edge_us(uint8_t row, uint8_t col, uint32_t *p_us);
 /* print matrix for debug */
 void matrix_print(void);
 /* delay between changing matrix pin state and reading values */
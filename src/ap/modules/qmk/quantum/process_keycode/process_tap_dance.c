@@ -26,7 +26,7 @@
 #endif
 
 static uint16_t active_td;
-static uint16_t last_tap_time;
+static uint32_t last_tap_us;  // V261017R8: 마지막 탭 처리 시각 (us, ms 양자화 제거)
 
 void tap_dance_pair_on_each_tap(tap_dance_state_t *state, void *user_data) {
     tap_dance_pair_t *pair = (tap_dance_pair_t *)user_data;
@@ -176,7 +176,7 @@ bool process_tap_dance(uint16_t keycode, keyrecord_t *record) {
 
                 action->state.pressed = record->event.pressed;
                 if (record->event.pressed) {
-                    last_tap_time = timer_read();
+                    last_tap_us = timer_read_us();
                     process_tap_dance_action_on_each_tap(action);
                     active_td = action->state.finished ? 0 : keycode;
                 } else {
@@ -200,7 +200,7 @@ bool process_tap_dance(uint16_t keycode, keyrecord_t *record) {
 
             action->state.pressed = record->event.pressed;
             if (record->event.pressed) {
-                last_tap_time = timer_read();
+                last_tap_us = timer_read_us();
                 process_tap_dance_action_on_each_tap(action);
                 active_td = action->state.finished ? 0 : keycode;
             } else {
@@ -234,13 +234,13 @@ void tap_dance_task(void) {
         return;                                               // V251124R8: 정의되지 않은 Tap Dance 슬롯 무시
     }
 
-    if (timer_elapsed(last_tap_time) <= tapdance_get_term_ms(active_td)) {
+    if (timer_elapsed_us(last_tap_us) <= (uint32_t)tapdance_get_term_ms(active_td) * 1000U) {  // V261017R8: 처리 시각 기준 us 비교 (엣지 기준이면 디바운스 지연만큼 일찍 종료)
         return;
     }
 
     action = &tap_dance_actions[slot_index];
 #else
-    if (!active_td || timer_elapsed(last_tap_time) <= GET_TAPPING_TERM(active_td, &(keyrecord_t){})) return;
+    if (!active_td || timer_elapsed_us(last_tap_us) <= (uint32_t)GET_TAPPING_TERM(active_td, &(keyrecord_t){}) * 1000U) return;
 
     action = &tap_dance_actions[QK_TAP_DANCE_GET_INDEX(active_td)];
 #endif
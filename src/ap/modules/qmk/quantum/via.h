@@ -120,6 +120,8 @@ enum via_channel_id {
     id_qmk_key_response       = 14,  // V251115R1: VIA 디바운스 프로필 제어 채널
     id_qmk_tapping            = 15,  // V251123R4: VIA TAPPING 제어 채널
     id_qmk_tapdance           = 16,  // V251124R8: VIA TAPDANCE 제어 채널
+    id_qmk_bulk               = 17,  // V261018R7: 압축 일괄 전송(키맵/매크로/탭댄스/USER) 채널
+    id_qmk_latency            = 18,  // V261019R2: 키 입력 → USB 전달 구간별 지연 조회 채널
 };
 
 enum via_qmk_backlight_value {
@@ -158,6 +160,25 @@ enum via_qmk_usb_polling_value {
     id_qmk_usb_bootmode_select = 1,
     id_qmk_usb_bootmode_apply  = 2,
     id_qmk_usb_monitor_toggle  = 3,
+    id_qmk_usb_nkro_toggle     = 4,  // V261018R1: NKRO 인터페이스 사용 토글
+};
+
+// V261018R7: 압축 일괄 전송 채널 value ID 매핑 (bulk_sync.c)
+enum via_qmk_bulk_value {
+    id_qmk_bulk_info         = 1,  // 스냅샷 생성 + 원본/압축 크기, CRC
+    id_qmk_bulk_read         = 2,  // 압축 스트림 조각 읽기
+    id_qmk_bulk_write_begin  = 3,  // 적용할 압축 스트림 수신 시작
+    id_qmk_bulk_write_data   = 4,  // 압축 스트림 조각 쓰기
+    id_qmk_bulk_write_commit = 5,  // 복원 + CRC 검증 + 바뀐 바이트만 EEPROM 큐에 적재
+};
+
+// V261019R2: 지연 계측 채널 value ID 매핑 (latency_stat.c)
+enum via_qmk_latency_value {
+    id_qmk_latency_enable = 1,  // 계측 on/off
+    id_qmk_latency_clear  = 2,  // 히스토그램 초기화
+    id_qmk_latency_info   = 3,  // 샘플/폐기 수, 틱 분해능
+    id_qmk_latency_stage  = 4,  // 구간별 평균/p50/p99/최대
+    id_qmk_latency_hist   = 5,  // 구간별 히스토그램 조각
 };
 
 // V251115R1: VIA KEY RESPONSE 메뉴 value ID 매핑
@@ -167,6 +188,10 @@ enum via_qmk_key_response_value {
     id_qmk_debounce_time_pre    = 3,
     id_qmk_debounce_time_post   = 4,
     id_qmk_debounce_status      = 5,
+    id_qmk_debounce_unit        = 6,  // V261017R2: 0 = 1ms, 1 = 125us
+    id_qmk_scan_samples         = 7,  // V261017R6: 프레임당 오버샘플 스윕 수 (1~16)
+    id_qmk_scan_reduce          = 8,  // V261017R6: 0 = majority, 1 = AND, 2 = OR
+    id_qmk_scan_rate            = 9,  // V261017R6: 행 샘플 주기 0~3 = 1/2/4/8us
 };
 
 // V251123R4: VIA TAPPING 설정 value ID 매핑
@@ -0,0 +1,23 @@
+// Copyright 2022 Nick Brassel (@tzarc)
+// SPDX-License-Identifier: GPL-2.0-or-later
+#pragma once
+
+#include <stdint.h>
+#include <stddef.h>
+
+// V261019R6: QMK lib/fnv 중 wear_leveling.c 가 쓰는 FNV-1a 64 만 옮겨 둔다 (hash_64a.c 와 같은 결과)
+typedef uint64_t Fnv64_t;
+
+#define FNV1A_64_INIT ((Fnv64_t)0xcbf29ce484222325ULL)
+#define FNV_64_PRIME ((Fnv64_t)0x100000001b3ULL)
+
+static inline Fnv64_t fnv_64a_buf(const void *buf, size_t len, Fnv64_t hval) {
+    const uint8_t *bp = (const uint8_t *)buf;
+    const uint8_t *be = bp + len;
+
+    while (bp < be) {
+        hval ^= (Fnv64_t)*bp++;
+        hval *= FNV_64_PRIME;
+    }
+    return hval;
+}
@@ -0,0 +1,176 @@
+#include "qring.h"
+
+
+// ---------------------------------------------------------------------------
+// [SPSC Ring] V261017R9
+//   - 생산자와 소비자가 각각 한 컨텍스트(ISR 또는 메인 루프)일 때 잠금 없이 동작한다.
+//   - in/out 은 자유 증가 카운터이고 슬롯은 (index & mask) 로 찾는다. 개수는 in - out.
+//   - 상대 인덱스는 acquire 로 읽고 자기 인덱스는 release 로 게시한다.
+//     Cortex-M7 에서는 DMB 가 붙어 데이터 복사와 인덱스 갱신의 순서가 보장되고
+//     (쓰기 버퍼/재정렬 포함) 호스트 스레드에서도 같은 의미로 동작한다.
+//   - 대량 복사는 끝 경계에서 최대 두 번의 memcpy 로 나눈다.
+// ---------------------------------------------------------------------------
+#define QRING_LOAD_ACQ(p)         __atomic_load_n((p), __ATOMIC_ACQUIRE)
+#define QRING_LOAD_OWN(p)         __atomic_load_n((p), __ATOMIC_RELAXED)
+#define QRING_STORE_REL(p, v)     __atomic_store_n((p), (v), __ATOMIC_RELEASE)
+
+
+
+
+bool qringCreate(qring_t *p_node, void *p_buf, uint32_t size, uint32_t length)
+{
+  if (p_node == NULL || p_buf == NULL || size == 0 || QRING_IS_POW2(length) != true)
+  {
+    return false;
+  }
+
+  p_node->in    = 0;
+  p_node->out   = 0;
+  p_node->len   = length;
+  p_node->mask  = length - 1;
+  p_node->size  = size;
+  p_node->p_buf = (uint8_t *)p_buf;
+
+  return true;
+}
+
+static void qringCopyIn(qring_t *p_node, uint32_t index, const uint8_t *p_data, uint32_t count)
+{
+  uint32_t slot  = index & p_node->mask;
+  uint32_t first = p_node->len - slot;
+
+  if (first > count)
+  {
+    first = count;
+  }
+  memcpy(&p_node->p_buf[slot * p_node->size], p_data, first * p_node->size);
+  if (count > first)
+  {
+    memcpy(&p_node->p_buf[0], &p_data[first * p_node->size], (count - first) * p_node->size);
+  }
+}
+
+static void qringCopyOut(qring_t *p_node, uint32_t index, uint8_t *p_data, uint32_t count)
+{
+  uint32_t slot  = index & p_node->mask;
+  uint32_t first = p_node->len - slot;
+
+  if (first > count)
+  {
+    first = count;
+  }
+  memcpy(p_data, &p_node->p_buf[slot * p_node->size], first * p_node->size);
+  if (count > first)
+  {
+    memcpy(&p_data[first * p_node->size], &p_node->p_buf[0], (count - first) * p_node->size);
+  }
+}
+
+// count 개 레코드를 모두 넣을 공간이 있을 때만 기록한다 (부분 기록 없음).
+bool qringWrite(qring_t *p_node, const void *p_data, uint32_t count)
+{
+  uint32_t in  = QRING_LOAD_OWN(&p_node->in);
+  uint32_t out = QRING_LOAD_ACQ(&p_node->out);
+
+  if (count > p_node->len - (in - out))
+  {
+    return false;
+  }
+  if (count > 0)
+  {
+    qringCopyIn(p_node, in, (const uint8_t *)p_data, count);
+    QRING_STORE_REL(&p_node->in, in + count);
+  }
+  return true;
+}
+
+// 다음 쓰기 슬롯을 반환한다. 채운 뒤 qringCommit() 으로 게시한다. 가득 차면 NULL.
+void *qringReserve(qring_t *p_node)
+{
+  uint32_t in  = QRING_LOAD_OWN(&p_node->in);
+  uint32_t out = QRING_LOAD_ACQ(&p_node->out);
+
+  if (in - out >= p_node->len)
+  {
+    return NULL;
+  }
+  return &p_node->p_buf[(in & p_node->mask) * p_node->size];
+}
+
+void qringCommit(qring_t *p_node)
+{
+  QRING_STORE_REL(&p_node->in, QRING_LOAD_OWN(&p_node->in) + 1);
+}
+
+// 어느 쪽에서 호출해도 호출 시점의 스냅샷이다. 생산자 기준으로는 보수적인(작거나 같은) 값이다.
+uint32_t qringFree(qring_t *p_node)
+{
+  return p_node->len - qringAvailable(p_node);
+}
+
+// count 개 레코드가 모두 쌓였을 때만 읽는다. p_data 가 NULL 이면 복사 없이 버린다.
+bool qringRead(qring_t *p_node, void *p_data, uint32_t count)
+{
+  uint32_t out = QRING_LOAD_OWN(&p_node->out);
+  uint32_t in  = QRING_LOAD_ACQ(&p_node->in);
+
+  if (count > in - out)
+  {
+    return false;
+  }
+  if (count > 0)
+  {
+    if (p_data != NULL)
+    {
+      qringCopyOut(p_node, out, (uint8_t *)p_data, count);
+    }
+    QRING_STORE_REL(&p_node->out, out + count);
+  }
+  return true;
+}
+
+void *qringPeek(qring_t *p_node)
+{
+  return qringPeekAt(p_node, 0);
+}
+
+// 읽기 위치에서 offset 번째 레코드를 복사 없이 참조한다. qringRelease() 전까지 유효하다.
+void *qringPeekAt(qring_t *p_node, uint32_t offset)
+{
+  uint32_t out = QRING_LOAD_OWN(&p_node->out);
+  uint32_t in  = QRING_LOAD_ACQ(&p_node->in);
+
+  if (offset >= in - out)
+  {
+    return NULL;
+  }
+  return &p_node->p_buf[((out + offset) & p_node->mask) * p_node->size];
+}
+
+void qringRelease(qring_t *p_node, uint32_t count)
+{
+  uint32_t out = QRING_LOAD_OWN(&p_node->out);
+  uint32_t in  = QRING_LOAD_ACQ(&p_node->in);
+
+  if (count > in - out)
+  {
+    count = in - out;
+  }
+  QRING_STORE_REL(&p_node->out, out + count);
+}
+
+// out 을 먼저 읽어야 제3 컨텍스트(예: 계측)에서 호출해도 in - out 이 음수가 되지 않는다.
+uint32_t qringAvailable(qring_t *p_node)
+{
+  uint32_t out = QRING_LOAD_ACQ(&p_node->out);
+  uint32_t in  = QRING_LOAD_ACQ(&p_node->in);
+  uint32_t cnt = in - out;
+
+  return cnt > p_node->len ? p_node->len : cnt;
+}
+
+// 소비자 쪽에서 쌓인 레코드를 모두 버린다. 생산자는 계속 기록해도 된다.
+void qringFlush(qring_t *p_node)
+{
+  QRING_STORE_REL(&p_node->out, QRING_LOAD_ACQ(&p_node->in));
+}
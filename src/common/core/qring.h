@@ -0,0 +1,51 @@
+#ifndef QRING_H_
+#define QRING_H_
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+
+#include "def.h"
+
+
+// V261017R9: 단일 생산자/단일 소비자(ISR <-> 메인 루프) 링 버퍼
+//   - 용량(레코드 수)은 2의 거듭제곱이어야 하며 인덱스는 자유 증가 + 마스크로 처리한다.
+//   - 용량 전체를 사용할 수 있다 (qbuffer 는 len - 1).
+#define QRING_IS_POW2(n)          ((n) != 0 && ((n) & ((n) - 1)) == 0)
+
+
+typedef struct
+{
+  uint32_t in;                                        // 생산자만 기록
+  uint32_t out;                                       // 소비자만 기록
+  uint32_t len;                                       // 레코드 수 (2^n)
+  uint32_t mask;
+  uint32_t size;                                      // 레코드 크기(byte)
+
+  uint8_t *p_buf;
+} qring_t;
+
+
+bool     qringCreate(qring_t *p_node, void *p_buf, uint32_t size, uint32_t length);
+
+// 생산자
+bool     qringWrite(qring_t *p_node, const void *p_data, uint32_t count);
+void    *qringReserve(qring_t *p_node);
+void     qringCommit(qring_t *p_node);
+uint32_t qringFree(qring_t *p_node);
+
+// 소비자
+bool     qringRead(qring_t *p_node, void *p_data, uint32_t count);
+void    *qringPeek(qring_t *p_node);
+void    *qringPeekAt(qring_t *p_node, uint32_t offset);
+void     qringRelease(qring_t *p_node, uint32_t count);
+uint32_t qringAvailable(qring_t *p_node);
+void     qringFlush(qring_t *p_node);
+
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -11,6 +11,14 @@
 
 #ifdef _USE_HW_EEPROM
 
+typedef enum
+{
+  EEPROM_ASYNC_IDLE = 0,                                      // 비어 있음, 새 요청 시작 가능
+  EEPROM_ASYNC_BUSY,                                          // 전송 또는 쓰기 주기(tWR) 대기 중
+  EEPROM_ASYNC_DONE,                                          // 마지막 요청 완료 (한 번 돌려준 뒤 IDLE)
+  EEPROM_ASYNC_FAIL,                                          // 마지막 요청 실패 (한 번 돌려준 뒤 IDLE)
+} eeprom_async_state_t;                                       // V261019R4: 비차단 페이지 쓰기 상태 (V261019R5: 읽기 공용)
+
 
 bool     eepromInit();
 bool     eepromIsInit(void);
@@ -24,6 +32,13 @@ uint32_t eepromGetLength(void);
 bool     eepromIsErasing(void);                               // V251112R8: 플래시 에뮬 클린업 진행 여부
 bool     eepromFormat(void);
 
+// V261019R4: 비차단 페이지 쓰기. 메인 루프는 시작(Async)과 관찰(Update)만 하고 전송은 I2C 인터럽트,
+//   쓰기 주기 완료는 간격을 둔 ACK 프로브로 확인한다. 블로킹 API 는 진행 중인 페이지가 끝난 뒤 실행된다.
+bool                 eepromWritePageAsync(uint32_t addr, uint8_t const *p_data, uint32_t length);
+bool                 eepromReadAsync(uint32_t addr, uint8_t *p_data, uint32_t length);  // V261019R5: p_data 로 바로 수신 (완료까지 유지)
+eeprom_async_state_t eepromAsyncUpdate(void);
+bool                 eepromAsyncWait(uint32_t timeout_ms);   // BUSY 가 끝날 때까지 대기 (결과는 Update 로 남김)
+
 
 #endif
 
@@ -19,6 +19,15 @@ typedef struct
   uint8_t  wait_last_addr;
 } i2c_ready_wait_stats_t;                                    // V251112R9: Ready wait 통계 구조체
 
+typedef enum
+{
+  I2C_ASYNC_IDLE = 0,                                        // 진행 중인 전송 없음 (결과도 이미 가져감)
+  I2C_ASYNC_BUSY,                                            // IT 전송 진행 중
+  I2C_ASYNC_DONE,                                            // 완료 (ACK)
+  I2C_ASYNC_NACK,                                            // 주소 NACK (쓰기 주기 중인 EEPROM 등)
+  I2C_ASYNC_ERROR,                                           // 버스 오류/중재 상실 등
+} i2c_async_t;                                               // V261019R4: 비차단 전송 상태
+
 bool i2cInit(void);
 bool i2cIsInit(void);
 bool i2cBegin(uint8_t ch, uint32_t freq_khz);
@@ -45,6 +54,14 @@ void     i2cClearErrCount(uint8_t ch);
 uint32_t i2cGetErrCount(uint8_t ch);
 void     i2cGetReadyWaitStats(uint8_t ch, i2c_ready_wait_stats_t *p_stats);   // V251112R9: Ready wait 통계 조회
 
+// V261019R4: IT 구동 비차단 전송. 시작 후 완료/오류는 I2C 인터럽트가 기록하고
+//   i2cAsyncPoll() 이 결과를 한 번 돌려준 뒤 IDLE 로 돌아간다. p_data 는 완료까지 유지해야 한다.
+bool        i2cWriteA16BytesAsync(uint8_t ch, uint16_t dev_addr, uint16_t reg_addr, uint8_t *p_data, uint32_t length);
+bool        i2cReadA16BytesAsync(uint8_t ch, uint16_t dev_addr, uint16_t reg_addr, uint8_t *p_data, uint32_t length);  // V261019R5
+bool        i2cProbeAsync(uint8_t ch, uint8_t dev_addr);     // 주소만 보내 ACK 확인 (Ready wait 통계 반영)
+i2c_async_t i2cAsyncPoll(uint8_t ch);
+void        i2cAsyncAbort(uint8_t ch);                       // 시간 초과 시 버스 복구
+
 
 #endif
 
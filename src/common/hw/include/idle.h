@@ -0,0 +1,58 @@
+#ifndef IDLE_H_
+#define IDLE_H_
+
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include "hw_def.h"
+
+#ifdef _USE_HW_IDLE
+
+
+// V261017R5: 메인 루프 깨움 이벤트 (ISR 에서 idleSetEvent 로 기록)
+#define IDLE_EVENT_KEYS           (1U << 0)           // DMA 프레임에서 매트릭스 변화 감지
+#define IDLE_EVENT_TIMER          (1U << 1)           // 1ms tick 경과 (QMK 타이머/디바운스 진행)
+#define IDLE_EVENT_SOF            (1U << 2)           // USB SOF 샘플 링이 임계에 닿음 (V261020R7, SOF 모니터 활성 시)
+#define IDLE_EVENT_VIA            (1U << 3)           // VIA RX 패킷 수신
+#define IDLE_EVENT_DEBOUNCE       (1U << 4)           // V261019R9: 디바운스 확정 대기 중 (다음 루프를 WFI 없이 재실행)
+#define IDLE_EVENT_ALL            (IDLE_EVENT_KEYS | IDLE_EVENT_TIMER | IDLE_EVENT_SOF | IDLE_EVENT_VIA | IDLE_EVENT_DEBOUNCE)
+#define IDLE_EVENT_MAX            5                   // V261019R9: event_cnt[] 크기
+
+
+typedef struct
+{
+  bool     enable;
+  uint32_t wake_cnt;                                  // idleWait() 가 이벤트를 반환한 횟수
+  uint32_t sleep_cnt;                                 // WFI 진입 횟수
+  uint32_t sleep_us;                                  // WFI 로 보낸 누적 시간
+  uint32_t event_cnt[IDLE_EVENT_MAX];                 // KEYS/TIMER/SOF/VIA/DEBOUNCE 별 처리 횟수 (V261019R9)
+  uint32_t key_wake_us_last;                          // 변화 감지 → 메인 루프 재개
+  uint32_t key_wake_us_max;
+  uint32_t key_done_us_last;                          // 변화 감지 → 루프 처리(리포트 제출) 완료
+  uint32_t key_done_us_max;
+  uint32_t key_done_us_sum;
+  uint32_t key_done_cnt;
+} idle_info_t;
+
+
+bool     idleInit(void);
+void     idleSetEnable(bool enable);
+bool     idleIsEnabled(void);
+void     idleSetEvent(uint32_t event);
+uint32_t idleWait(void);
+void     idleMarkDone(void);
+void     idleGetInfo(idle_info_t *p_info);
+void     idleClearInfo(void);
+
+
+#endif
+
+
+#ifdef __cplusplus
+}
+#endif
+
+
+#endif
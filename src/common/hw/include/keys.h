@@ -8,6 +8,66 @@ extern "C" {
 #include "hw_def.h"
 
 
+// V261017R7: 보드 매트릭스 디스크립터 (행 포트/핀, 열 포트 구간)
+#define KEYS_ROWS_MAX             16
+#define KEYS_COLS_MAX             32
+#define KEYS_COL_PORT_MAX         4                   // 한 행에서 함께 읽는 열 GPIO 포트 수
+
+#if (MATRIX_COLS > 16)
+typedef uint32_t keys_col_t;                          // 행 하나의 열 비트 (matrix_row_t 폭과 맞춤)
+#else
+typedef uint16_t keys_col_t;
+#endif
+
+typedef struct
+{
+  uint8_t port;                                       // col_port[] 인덱스
+  uint8_t pin_first;                                  // 연속 핀 구간 시작 핀 번호
+  uint8_t pin_count;
+  uint8_t col_first;                                  // 매핑되는 첫 매트릭스 열
+} keys_col_seg_t;
+
+typedef struct
+{
+  GPIO_TypeDef         *row_port;                     // 행 출력 포트 (BSRR 로 기록, 다른 핀은 건드리지 않음)
+  uint8_t               row_pin[KEYS_ROWS_MAX];
+  uint8_t               rows;
+  GPIO_TypeDef         *col_port[KEYS_COL_PORT_MAX];  // 주소 오름차순, 같은 간격이어야 한 DMA 체인으로 읽는다
+  uint8_t               col_ports;
+  const keys_col_seg_t *col_seg;
+  uint8_t               col_segs;
+} keys_matrix_desc_t;
+
+// V261017R6: 오버샘플링(한 프레임 = 최근 N 스윕 축약)과 행 스캔 주기
+#define KEYS_OVERSAMPLE_MAX       16                  // DMA 절반 버퍼의 최대 스윕 수와 같다
+
+// V261021R2: 절반 버퍼 스윕 수 = max(오버샘플 수, 게시 주기 KEYS_FRAME_MIN_US 를 채우는 스윕 수)
+//   - N=1 이면 행 수/주기와 무관하게 프레임 게시 주기가 스윕 1회 + 24us 이내로 줄어든다.
+//   - KEYS_FRAME_MIN_US 는 HT/TC 인터럽트 빈도 상한(40kHz), KEYS_FRAME_MAX_US 는 8kHz 게시 기준이다.
+#define KEYS_FRAME_MIN_US         25
+#define KEYS_FRAME_MAX_US         125
+#define KEYS_DIV_CEIL(a, b)       (((a) + (b) - 1) / (b))
+#define KEYS_SWEEPS_PER_HALF_CALC(samples, sweep_us)                                        \
+  ((samples) > KEYS_DIV_CEIL(KEYS_FRAME_MIN_US, (sweep_us)) ? (samples) :                 \
+   KEYS_DIV_CEIL(KEYS_FRAME_MIN_US, (sweep_us)) > KEYS_OVERSAMPLE_MAX ? KEYS_OVERSAMPLE_MAX : \
+   KEYS_DIV_CEIL(KEYS_FRAME_MIN_US, (sweep_us)))
+
+typedef enum
+{
+  KEYS_REDUCE_MAJORITY = 0,                           // N/2 초과 샘플이 눌림일 때 눌림
+  KEYS_REDUCE_AND      = 1,                           // 모든 샘플이 눌림일 때 눌림 (잡음성 눌림 차단)
+  KEYS_REDUCE_OR       = 2,                           // 하나라도 눌림이면 눌림 (잡음성 떨어짐 차단)
+  KEYS_REDUCE_COUNT
+} keys_reduce_t;
+
+typedef enum
+{
+  KEYS_SCAN_RATE_1US = 0,                             // 행당 1us (TIM16 ARR 9)
+  KEYS_SCAN_RATE_2US = 1,
+  KEYS_SCAN_RATE_4US = 2,
+  KEYS_SCAN_RATE_8US = 3,
+  KEYS_SCAN_RATE_COUNT
+} keys_scan_rate_t;
 
 
 bool keysInit(void);
@@ -15,8 +75,21 @@ bool keysIsBusy(void);
 // V251009R1: DMA 전용 스캔으로 keysUpdate() API 제거
 bool keysGetPressed(uint16_t row, uint16_t col);
 bool keysReadBuf(uint8_t *p_data, uint32_t length);
-bool keysReadColsBuf(uint16_t *p_data, uint32_t rows_cnt);
-const volatile uint16_t *keysPeekColsBuf(void);  // V250924R5: DMA 버퍼 스냅샷 포인터 제공 (재검토: volatile 포인터 반환)
+bool keysReadColsBuf(keys_col_t *p_data, uint32_t rows_cnt);
+const volatile keys_col_t *keysPeekColsBuf(void);  // V250924R5: DMA 버퍼 스냅샷 포인터 제공 (재검토: volatile 포인터 반환)
+uint32_t keysGetFrameSeq(void);                                              // V261017R4: 게시된 DMA 스캔 프레임 번호 (0 = 없음)
+bool     keysReadFrame(keys_col_t *p_data, uint32_t rows_cnt, uint32_t *p_seq, uint32_t *p_us); // V261017R4: 최근 완결 프레임 복사 (V261017R8: 캡처 시각)
+
+bool             keysSetOversample(uint8_t samples, keys_reduce_t reduce);  // V261017R6: 1 = 마지막 스윕만 사용
+uint8_t          keysGetOversample(void);
+keys_reduce_t    keysGetReduce(void);
+bool             keysSetScanRate(keys_scan_rate_t rate);                    // V261017R6: 행 샘플 주기 변경
+keys_scan_rate_t keysGetScanRate(void);
+uint32_t         keysGetScanFreqHz(void);                                   // V261021R1: 프레임 게시 주파수 (matrix_scan 이 새 프레임을 받는 빈도)
+uint32_t         keysGetSweepFreqHz(void);                                  // V261021R1: 매트릭스 전체 스윕 주파수 (DMA 원시 캡처)
+uint32_t         keysGetFramePeriodUs(void);                                // V261021R1: 프레임 게시 주기 (HT/TC 간격, us)
+uint32_t         keysCalcSweepsPerHalf(uint32_t samples, uint32_t sweep_us);  // V261021R2: DMA 절반 버퍼 스윕 수 (레지스터 비의존)
+uint16_t         keysReduceSamples(const volatile uint16_t *p_sample, uint32_t stride, uint32_t count, keys_reduce_t reduce);
 
 #ifdef __cplusplus
 }
@@ -0,0 +1,88 @@
+#ifndef LATENCY_H_
+#define LATENCY_H_
+
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include "hw_def.h"
+
+
+// V261019R2: 키 입력 → USB 전달 구간별 지연 (DWT CYCCNT 틱)
+//   - 한 번에 샘플 1개만 추적한다. 디바운스 확정에서 시작해 지점마다 바로 다음 지점만 받으므로
+//     같은 샘플에 다른 리포트의 시각이 섞이지 않는다.
+//   - CAPTURE~HOST 는 메인 루프, TX 는 메인 루프/TIM2, DONE 은 OTG ISR 에서 기록하고
+//     latencyUpdate() 가 메인 루프에서 히스토그램에 합친다.
+typedef enum
+{
+  LATENCY_POINT_CAPTURE = 0,                          // DMA 프레임 캡처 (가장 오래된 엣지)
+  LATENCY_POINT_DEBOUNCE,                             // 디바운스 확정 (matrix_scan)
+  LATENCY_POINT_ACTION,                               // action_exec() 진입
+  LATENCY_POINT_HOST,                                 // host_keyboard_send()/host_nkro_send()
+  LATENCY_POINT_TX,                                   // USBD_LL_Transmit (키보드/NKRO EP)
+  LATENCY_POINT_DONE,                                 // DataIn (호스트 IN 완료)
+  LATENCY_POINT_MAX,
+} latency_point_t;
+
+typedef enum
+{
+  LATENCY_STAGE_DEBOUNCE = 0,                         // CAPTURE → DEBOUNCE
+  LATENCY_STAGE_ACTION,                               // DEBOUNCE → ACTION
+  LATENCY_STAGE_HOST,                                 // ACTION → HOST
+  LATENCY_STAGE_TX,                                   // HOST → TX
+  LATENCY_STAGE_DONE,                                 // TX → DONE
+  LATENCY_STAGE_TOTAL,                                // CAPTURE → DONE
+  LATENCY_STAGE_MAX,
+} latency_stage_t;
+
+#define LATENCY_HIST_BINS         64                  // 반 옥타브 로그 구간: 0, 1, 2, 3, 4, 6, 8, 12, 16, ... 틱
+
+
+typedef struct
+{
+  uint32_t cnt;
+  uint32_t min_tick;
+  uint32_t max_tick;
+  uint64_t sum_tick;
+  uint32_t bin[LATENCY_HIST_BINS];
+} latency_hist_t;
+
+
+#ifdef _USE_HW_LATENCY
+
+bool     latencyInit(uint32_t (*tick_func)(void), uint32_t tick_per_us);
+void     latencySetEnable(bool enable);
+bool     latencyIsEnabled(void);
+void     latencyBegin(uint32_t age_us);               // 디바운스 확정. age_us = 가장 오래된 엣지 프레임이 캡처된 뒤 지난 시간
+void     latencyMark(latency_point_t point);          // ACTION/HOST/TX/DONE (ISR 가능)
+void     latencyUpdate(void);                         // 메인 루프: 완료 샘플 합산, 시간 초과 샘플 폐기
+void     latencyClear(void);
+
+const latency_hist_t *latencyGetHist(latency_stage_t stage);
+uint32_t latencyGetSampleCount(void);
+uint32_t latencyGetAbandonCount(void);
+uint32_t latencyGetTickPerUs(void);
+uint32_t latencyTickToNs(uint32_t tick);
+uint32_t latencyBinUpperTick(uint32_t bin);
+uint32_t latencyGetPercentileNs(latency_stage_t stage, uint32_t permille);   // 구간 상한 기준
+const char *latencyStageName(latency_stage_t stage);
+
+void     latencyPrintInfo(void);                      // matrix info / usbhid latency
+void     latencyPrintHist(latency_stage_t stage);     // usbhid latency his <stage>
+
+#else
+
+static inline void latencyBegin(uint32_t age_us)      { (void)age_us; }
+static inline void latencyMark(latency_point_t point) { (void)point; }
+static inline void latencyUpdate(void)                { }
+
+#endif
+
+
+#ifdef __cplusplus
+}
+#endif
+
+
+#endif
@@ -166,6 +166,35 @@ bool eepromWritePage(uint32_t addr, uint8_t const *p_data, uint32_t length)
   return ret;
 }
 
+static eeprom_async_state_t async_result = EEPROM_ASYNC_IDLE;
+
+bool eepromWritePageAsync(uint32_t addr, uint8_t const *p_data, uint32_t length)
+{
+  // V261019R4: 플래시 에뮬은 RAM 캐시에 바로 기록되므로 즉시 완료로 처리 (클린업은 eepromIsErasing 으로 보류)
+  async_result = eepromWritePage(addr, p_data, length) ? EEPROM_ASYNC_DONE : EEPROM_ASYNC_FAIL;
+  return true;
+}
+
+bool eepromReadAsync(uint32_t addr, uint8_t *p_data, uint32_t length)
+{
+  async_result = eepromRead(addr, p_data, length) ? EEPROM_ASYNC_DONE : EEPROM_ASYNC_FAIL;  // V261019R5: RAM 캐시 → 즉시 완료
+  return true;
+}
+
+eeprom_async_state_t eepromAsyncUpdate(void)
+{
+  eeprom_async_state_t ret = async_result;
+
+  async_result = EEPROM_ASYNC_IDLE;
+  return ret;
+}
+
+bool eepromAsyncWait(uint32_t timeout_ms)
+{
+  (void)timeout_ms;
+  return true;
+}
+
 bool eepromRead(uint32_t addr, uint8_t *p_data, uint32_t length)
 {
   bool ret = true;
@@ -326,13 +355,13 @@ void cliEeprom(cli_args_t *args)
       cliPrintf("eeprom init   : %d\n", eepromIsInit());
       cliPrintf("eeprom length : %d bytes\n", eepromGetLength());
 #if defined(QMK_KEYMAP_CONFIG_H)
-      cliPrintf("eeprom queue cur : %lu entries\n", (unsigned long)eeprom_get_write_pending_count());   // V251112R2: QMK 큐 계측
-      cliPrintf("eeprom queue max : %lu entries\n", (unsigned long)eeprom_get_write_pending_max());     // V251112R2: 최고 사용량
+      cliPrintf("eeprom dirty cur : %lu pages\n", (unsigned long)eeprom_get_write_pending_count());     // V261019R3: 더티 페이지 캐시
+      cliPrintf("eeprom dirty max : %lu pages\n", (unsigned long)eeprom_get_write_pending_max());       // V261019R3: 최고 사용량
       cliPrintf("eeprom queue ofl : %lu events\n", (unsigned long)eeprom_get_write_overflow_count());  // V251112R2: 직접 쓰기 횟수
 #endif
       cliPrintf("emul cleanup busy : %d\n", eepromIsErasing());                                        // V251112R8: 클린업 진행 여부
       cliPrintf("emul cleanup last : %lums\n", (unsigned long)cleanup_stats.last_duration_ms);         // V251112R8: 최근 클린업 시간
-      cliPrintf("emul cleanup wait : %lu entries\n", (unsigned long)cleanup_stats.wait_entry_snapshot);// V251112R8: 트리거 당시 대기 엔트리
+      cliPrintf("emul cleanup wait : %lu pages\n", (unsigned long)cleanup_stats.wait_entry_snapshot);  // V261019R3: 트리거 당시 더티 페이지
       cliPrintf("emul cleanup cnt  : %lu\n", (unsigned long)cleanup_stats.total_count);                // V251112R8: 누적 실행 횟수
     }
     else if(args->isStr(0, "format") == true)
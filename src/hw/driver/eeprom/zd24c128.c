@@ -19,14 +19,56 @@ void cliEeprom(cli_args_t *args);
 #define EEPROM_PAGE_SIZE               32                          // V251112R5: ZD24C128 페이지 크기
 #define EEPROM_WRITE_I2C_TIMEOUT_MS    10                          // V251112R5: 페이지 쓰기 I2C 타임아웃
 #define EEPROM_WRITE_READY_TIMEOUT_MS  100                         // V251112R5: 페이지 쓰기 완료 확인 제한 시간
+#define EEPROM_WRITE_POLL_US           250                         // V261019R4: 비동기 쓰기 주기 ACK 프로브 간격
+#define EEPROM_READ_CHUNK              256                         // V261019R5: 블로킹 순차 읽기 1회 전송 크기
+#define EEPROM_READ_TIMEOUT_MS         100                         // V261019R5: 순차 읽기 1회 전송 제한 시간
+
+
+// ---------------------------------------------------------------------------
+// [Async Page Write] V261019R4
+//   - 블로킹 eepromWritePage() 는 I2C 전송(~0.4ms)과 쓰기 주기 ACK 폴링(tWR, 최대 5ms)을 호출자에서 기다린다.
+//     platforms/eeprom.c 는 이를 100us 슬라이스로 잘랐지만 한 페이지가 시작되면 슬라이스를 넘겨도 멈출 수 없었다.
+//   - 여기서는 페이지를 내부 버퍼로 복사해 IT 전송을 시작하고, eepromAsyncUpdate() 가 완료를 확인한 뒤
+//     EEPROM_WRITE_POLL_US 간격으로 IT ACK 프로브를 보낸다. 메인 루프 비용은 상태 확인 몇 번이다.
+//   - 프로브 결과는 i2cAsyncPoll() 에서 Ready wait 통계(i2cGetReadyWaitStats)에 그대로 합쳐진다.
+//   - 블로킹 API 는 진행 중인 페이지가 끝난 뒤 기존 경로로 실행한다 (공장 초기화/CLI/부팅 로드).
+//   - V261019R5: 같은 엔진으로 순차 읽기(eepromReadAsync)도 돌린다. 읽기는 쓰기 주기가 없어 RX 완료로 끝난다.
+// ---------------------------------------------------------------------------
+typedef enum
+{
+  EEPROM_STAGE_IDLE = 0,
+  EEPROM_STAGE_TX,                                                 // 페이지 IT 전송 중
+  EEPROM_STAGE_READY_WAIT,                                         // 다음 프로브 시각 대기
+  EEPROM_STAGE_READY_PROBE,                                        // ACK 프로브 IT 전송 중
+  EEPROM_STAGE_RX,                                                 // V261019R5: 순차 읽기 IT 수신 중
+} eeprom_stage_t;
+
+typedef struct
+{
+  eeprom_stage_t stage;
+  eeprom_async_state_t result;                                     // 끝난 요청 결과 (Update 가 한 번 돌려줌)
+  uint8_t              buf[EEPROM_PAGE_SIZE];
+  uint32_t             begin_us;
+  uint32_t             stage_us;
+
+  uint32_t             page_cnt;
+  uint32_t             fail_cnt;
+  uint32_t             probe_cnt;
+  uint32_t             last_us;                                    // 시작 → 쓰기 주기 완료
+  uint32_t             max_us;
+  uint32_t             read_cnt;                                   // V261019R5: 비동기 읽기 횟수
+  uint32_t             read_bytes;
+} eeprom_async_t;
 
 
 static bool is_init = false;
 static uint8_t i2c_ch = _DEF_I2C1;
 static uint8_t i2c_addr = 0x50;
 static uint8_t page_write_buf[EEPROM_PAGE_SIZE];                   // V251112R5: I2C 페이지 버퍼
+static eeprom_async_t eep_async;                                 // V261019R4: 비차단 페이지 쓰기 엔진
 
 static bool eepromWaitReady(uint32_t timeout_ms);
+static void eepromAsyncStep(void);
 
 
 
@@ -74,7 +116,7 @@ bool eepromValid(uint32_t addr)
   uint8_t data;
   bool ret;
 
-  if (addr >= EEPROM_MAX_SIZE)
+  if (addr >= EEPROM_MAX_SIZE || eepromAsyncWait(EEPROM_WRITE_READY_TIMEOUT_MS) != true)
   {
     return false;
   }
@@ -88,7 +130,7 @@ bool eepromReadByte(uint32_t addr, uint8_t *p_data)
 {
   bool ret;
 
-  if (addr >= EEPROM_MAX_SIZE)
+  if (addr >= EEPROM_MAX_SIZE || eepromAsyncWait(EEPROM_WRITE_READY_TIMEOUT_MS) != true)
   {
     return false;
   }
@@ -118,6 +160,10 @@ bool eepromWritePage(uint32_t addr, uint8_t const *p_data, uint32_t length)
   {
     return false;
   }
+  if (eepromAsyncWait(EEPROM_WRITE_READY_TIMEOUT_MS) != true)
+  {
+    return false;                                                  // V261019R4: 비동기 페이지가 버스를 쓰는 중
+  }
 
   for (uint32_t i = 0; i < length; i++)
   {
@@ -140,20 +186,30 @@ bool eepromWriteByte(uint32_t addr, uint8_t data_in)
 
 bool eepromRead(uint32_t addr, uint8_t *p_data, uint32_t length)
 {
-  bool ret = true;
-  uint32_t i;
-
+  // V261019R5: 바이트마다 주소를 다시 보내던 1바이트 전송 대신 순차 읽기로 묶는다 (~5배 빠름)
+  if (addr >= EEPROM_MAX_SIZE || (addr + length) > EEPROM_MAX_SIZE)
+  {
+    return false;
+  }
+  if (eepromAsyncWait(EEPROM_WRITE_READY_TIMEOUT_MS) != true)
+  {
+    return false;
+  }
 
-  for (i=0; i<length; i++)
+  while (length > 0)
   {
-    ret = eepromReadByte(addr + i, &p_data[i]);
-    if (ret != true)
+    uint32_t chunk = length < EEPROM_READ_CHUNK ? length : EEPROM_READ_CHUNK;
+
+    if (i2cReadA16Bytes(i2c_ch, i2c_addr, addr, p_data, chunk, EEPROM_READ_TIMEOUT_MS) != true)
     {
-      break;
+      return false;
     }
+    addr   += chunk;
+    p_data += chunk;
+    length -= chunk;
   }
 
-  return ret;
+  return true;
 }
 
 bool eepromWrite(uint32_t addr, uint8_t *p_data, uint32_t length)
@@ -195,6 +251,185 @@ bool eepromFormat(void)
   return true;
 }
 
+bool eepromWritePageAsync(uint32_t addr, uint8_t const *p_data, uint32_t length)
+{
+  if (length == 0 || eep_async.stage != EEPROM_STAGE_IDLE)
+  {
+    return false;
+  }
+  if (addr >= EEPROM_MAX_SIZE || (addr + length) > EEPROM_MAX_SIZE)
+  {
+    return false;
+  }
+  if ((addr % EEPROM_PAGE_SIZE) + length > EEPROM_PAGE_SIZE)
+  {
+    return false;
+  }
+
+  memcpy(eep_async.buf, p_data, length);
+  if (i2cWriteA16BytesAsync(i2c_ch, i2c_addr, addr, eep_async.buf, length) != true)
+  {
+    return false;                                                  // HAL 이 아직 바쁨 → 호출자가 다음 루프에 재시도
+  }
+  eep_async.stage    = EEPROM_STAGE_TX;
+  eep_async.result   = EEPROM_ASYNC_IDLE;
+  eep_async.begin_us = micros();
+  eep_async.stage_us = eep_async.begin_us;
+
+  return true;
+}
+
+bool eepromReadAsync(uint32_t addr, uint8_t *p_data, uint32_t length)
+{
+  // V261019R5: 부팅 뒤 나머지 이미지를 메인 루프에서 흘려 읽는다
+  if (length == 0 || length > EEPROM_READ_CHUNK || eep_async.stage != EEPROM_STAGE_IDLE)
+  {
+    return false;
+  }
+  if (addr >= EEPROM_MAX_SIZE || (addr + length) > EEPROM_MAX_SIZE)
+  {
+    return false;
+  }
+
+  if (i2cReadA16BytesAsync(i2c_ch, i2c_addr, addr, p_data, length) != true)
+  {
+    return false;
+  }
+  eep_async.stage    = EEPROM_STAGE_RX;
+  eep_async.result   = EEPROM_ASYNC_IDLE;
+  eep_async.begin_us = micros();
+  eep_async.stage_us = eep_async.begin_us;
+  eep_async.read_cnt++;
+  eep_async.read_bytes += length;
+
+  return true;
+}
+
+eeprom_async_state_t eepromAsyncUpdate(void)
+{
+  eeprom_async_state_t ret;
+
+  eepromAsyncStep();
+  if (eep_async.stage != EEPROM_STAGE_IDLE)
+  {
+    return EEPROM_ASYNC_BUSY;
+  }
+  ret = eep_async.result;
+  eep_async.result = EEPROM_ASYNC_IDLE;
+
+  return ret;
+}
+
+bool eepromAsyncWait(uint32_t timeout_ms)
+{
+  uint32_t pre_time = millis();
+
+  while (eep_async.stage != EEPROM_STAGE_IDLE)
+  {
+    eepromAsyncStep();
+    if (millis() - pre_time >= timeout_ms)
+    {
+      return false;
+    }
+  }
+
+  return true;
+}
+
+static void eepromAsyncFinish(bool ok)
+{
+  uint32_t elapsed = micros() - eep_async.begin_us;
+  bool     is_read = eep_async.stage == EEPROM_STAGE_RX;
+
+  eep_async.stage  = EEPROM_STAGE_IDLE;
+  eep_async.result = ok ? EEPROM_ASYNC_DONE : EEPROM_ASYNC_FAIL;
+  if (ok != true)
+  {
+    eep_async.fail_cnt++;
+    return;
+  }
+  if (is_read == true)
+  {
+    return;                                                        // 페이지 시간 통계는 쓰기만
+  }
+  eep_async.page_cnt++;
+  eep_async.last_us = elapsed;
+  if (elapsed > eep_async.max_us)
+  {
+    eep_async.max_us = elapsed;
+  }
+}
+
+static void eepromAsyncStep(void)
+{
+  uint32_t    now = micros();
+  i2c_async_t i2c_ret;
+
+  switch (eep_async.stage)
+  {
+    case EEPROM_STAGE_TX:
+    case EEPROM_STAGE_READY_PROBE:
+      i2c_ret = i2cAsyncPoll(i2c_ch);
+      if (i2c_ret == I2C_ASYNC_BUSY)
+      {
+        if (now - eep_async.stage_us >= EEPROM_WRITE_I2C_TIMEOUT_MS * 1000U)
+        {
+          i2cAsyncAbort(i2c_ch);
+          eepromAsyncFinish(false);
+        }
+        break;
+      }
+      if (i2c_ret == I2C_ASYNC_DONE && eep_async.stage == EEPROM_STAGE_READY_PROBE)
+      {
+        eepromAsyncFinish(true);                                   // 주소 ACK = 쓰기 주기 끝
+        break;
+      }
+      if (i2c_ret != I2C_ASYNC_DONE && eep_async.stage == EEPROM_STAGE_TX)
+      {
+        eepromAsyncFinish(false);
+        break;
+      }
+      eep_async.stage    = EEPROM_STAGE_READY_WAIT;              // 전송 완료 또는 프로브 NACK
+      eep_async.stage_us = now;
+      break;
+
+    case EEPROM_STAGE_RX:
+      i2c_ret = i2cAsyncPoll(i2c_ch);
+      if (i2c_ret == I2C_ASYNC_BUSY)
+      {
+        if (now - eep_async.stage_us >= EEPROM_READ_TIMEOUT_MS * 1000U)
+        {
+          i2cAsyncAbort(i2c_ch);
+          eepromAsyncFinish(false);
+        }
+        break;
+      }
+      eepromAsyncFinish(i2c_ret == I2C_ASYNC_DONE);
+      break;
+
+    case EEPROM_STAGE_READY_WAIT:
+      if (now - eep_async.stage_us < EEPROM_WRITE_POLL_US)
+      {
+        break;
+      }
+      if (now - eep_async.begin_us >= EEPROM_WRITE_READY_TIMEOUT_MS * 1000U)
+      {
+        eepromAsyncFinish(false);
+        break;
+      }
+      eep_async.stage_us = now;
+      if (i2cProbeAsync(i2c_ch, i2c_addr) == true)
+      {
+        eep_async.stage = EEPROM_STAGE_READY_PROBE;
+        eep_async.probe_cnt++;
+      }
+      break;
+
+    default:
+      break;
+  }
+}
+
 static bool eepromWaitReady(uint32_t timeout_ms)
 {
   // V251112R5: FastMode Plus에서 완료 여부를 짧게 폴링
@@ -234,8 +469,8 @@ void cliEeprom(cli_args_t *args)
       cliPrintf("eeprom init   : %s\n", eepromIsInit() ? "True":"False");
       cliPrintf("eeprom length : %d bytes\n", eepromGetLength());
 #if defined(QMK_KEYMAP_CONFIG_H)
-      cliPrintf("eeprom queue cur : %lu entries\n", (unsigned long)eeprom_get_write_pending_count());   // V251112R2: QMK 큐 계측
-      cliPrintf("eeprom queue max : %lu entries\n", (unsigned long)eeprom_get_write_pending_max());     // V251112R2: 최고 사용량
+      cliPrintf("eeprom dirty cur : %lu pages\n", (unsigned long)eeprom_get_write_pending_count());     // V261019R3: 더티 페이지 캐시
+      cliPrintf("eeprom dirty max : %lu pages\n", (unsigned long)eeprom_get_write_pending_max());       // V261019R3: 최고 사용량
       cliPrintf("eeprom queue ofl : %lu events\n", (unsigned long)eeprom_get_write_overflow_count());  // V251112R2: 직접 쓰기 횟수
 #endif
       i2c_ready_wait_stats_t ready_stats;
@@ -245,6 +480,16 @@ void cliEeprom(cli_args_t *args)
       cliPrintf("ready wait last  : %lums (addr=0x%02X)\n",
                 (unsigned long)ready_stats.wait_last_ms,
                 ready_stats.wait_last_addr);
+      cliPrintf("async write      : %lu pages, %lu fail, %lu probes\n",                               // V261019R4: 비차단 쓰기 계측
+                (unsigned long)eep_async.page_cnt,
+                (unsigned long)eep_async.fail_cnt,
+                (unsigned long)eep_async.probe_cnt);
+      cliPrintf("async page time  : last %luus, max %luus\n",
+                (unsigned long)eep_async.last_us,
+                (unsigned long)eep_async.max_us);
+      cliPrintf("async read       : %lu reqs, %lu bytes\n",                                          // V261019R5: 백그라운드 로드
+                (unsigned long)eep_async.read_cnt,
+                (unsigned long)eep_async.read_bytes);
       cliPrintf("emul cleanup busy : %d\n", eepromIsErasing());                                        // V251112R8: 외부 EEPROM에서도 계측 필드 제공
       cliPrintf("emul cleanup last : 0ms\n");                                                          // V251112R8: 클린업 미지원 보드 → 고정 0
       cliPrintf("emul cleanup wait : 0 entries\n");                                                    // V251112R8: 외부 EEPROM은 큐 대기로 전환 없음
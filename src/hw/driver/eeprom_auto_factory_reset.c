@@ -110,7 +110,7 @@ bool eepromAutoFactoryResetCheck(void)
 
   eeprom_init();  // V251112R2: 하드웨어/버퍼 재동기화
 
-  if (eeprom_apply_factory_defaults(true) != true)              // V251112R3: VIA와 동일한 공용 초기화 경로
+  if (eeprom_apply_factory_defaults(true) != true)              // V251112R3: VIA와 동일한 공용 초기화 경로 (V261020R8: 남은 구간 적재 포함)
   {
     logPrintf("[!] EEPROM auto factory reset : factory defaults fail\n");
     return false;
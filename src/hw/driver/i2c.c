@@ -20,6 +20,7 @@ static uint32_t i2cGetTimming(uint32_t freq_khz);
 static void delayUs(uint32_t us);
 static int8_t i2cGetChannelFromHandle(I2C_HandleTypeDef *hi2c);
 static void i2cLogTimingOnce(uint8_t ch, I2C_HandleTypeDef *hi2c);
+static void i2cReadyWaitTrack(uint8_t ch, uint8_t dev_addr, bool ready);
 #if CLI_USE(HW_I2C)
 static void cliI2C(cli_args_t *args);
 #endif
@@ -34,6 +35,10 @@ static bool     i2c_ready_wait_active[I2C_MAX_CH];       // V251112R7: Ready 폴
 static uint32_t i2c_ready_wait_start_ms[I2C_MAX_CH];     // V251112R7: Ready 폴링 시작 시각
 static uint8_t  i2c_ready_wait_addr[I2C_MAX_CH];         // V251112R7: Ready 폴링 대상 주소
 static i2c_ready_wait_stats_t i2c_ready_wait_stats[I2C_MAX_CH];  // V251112R9: Ready wait 통계 누적
+static volatile uint8_t i2c_async_state[I2C_MAX_CH];     // V261019R4: i2c_async_t, 완료/오류는 ISR 이 기록
+static bool     i2c_async_probe[I2C_MAX_CH];             // V261019R4: 진행 중인 전송이 ACK 프로브인지
+static uint8_t  i2c_async_addr[I2C_MAX_CH];              // V261019R4: 프로브 대상 주소 (Ready wait 통계)
+static uint8_t  i2c_async_dummy;                         // V261019R4: 0바이트 프로브용 버퍼 (참조되지 않음)
 
 static bool is_init = false;
 static bool is_begin[I2C_MAX_CH];
@@ -116,6 +121,7 @@ bool i2cInit(void)
     i2c_ready_wait_stats[i].wait_last_ms = 0;            // V251112R9: Ready wait 마지막 지연 초기화
     i2c_ready_wait_stats[i].wait_max_ms = 0;             // V251112R9: Ready wait 최댓값 초기화
     i2c_ready_wait_stats[i].wait_last_addr = 0;          // V251112R9: Ready wait 마지막 주소 초기화
+    i2c_async_state[i] = I2C_ASYNC_IDLE;                 // V261019R4: 비동기 전송 상태 초기화
   }
 
 #if CLI_USE(HW_I2C)
@@ -187,6 +193,7 @@ bool i2cBegin(uint8_t ch, uint32_t freq_khz)
 
       ret = true;
       is_begin[ch] = true;
+      i2c_async_state[ch] = I2C_ASYNC_IDLE;              // V261019R4: 재초기화로 진행 중 전송은 사라짐
       break;
   }
 
@@ -266,22 +273,11 @@ void i2cReset(uint8_t ch)
   unLock();
 }
 
-bool i2cIsDeviceReady(uint8_t ch, uint8_t dev_addr)
+static void i2cReadyWaitTrack(uint8_t ch, uint8_t dev_addr, bool ready)
 {
-  bool ret = false;
-  I2C_HandleTypeDef *p_handle = i2c_tbl[ch].p_hi2c;
-  bool was_waiting;
+  bool was_waiting = i2c_ready_wait_active[ch];          // V251112R7: Ready 폴링 상태 추적
 
-  lock();
-  if (HAL_I2C_IsDeviceReady(p_handle, dev_addr << 1, 10, 10) == HAL_OK)
-  {
-    __enable_irq();
-    ret = true;
-  }
-  unLock();
-
-  was_waiting = i2c_ready_wait_active[ch];               // V251112R7: Ready 폴링 상태 추적
-  if (ret != true)
+  if (ready != true)
   {
     if (i2c_ready_wait_active[ch] != true)
     {
@@ -315,6 +311,22 @@ bool i2cIsDeviceReady(uint8_t ch, uint8_t dev_addr)
 #endif
     i2c_ready_wait_active[ch] = false;
   }
+}
+
+bool i2cIsDeviceReady(uint8_t ch, uint8_t dev_addr)
+{
+  bool ret = false;
+  I2C_HandleTypeDef *p_handle = i2c_tbl[ch].p_hi2c;
+
+  lock();
+  if (HAL_I2C_IsDeviceReady(p_handle, dev_addr << 1, 10, 10) == HAL_OK)
+  {
+    __enable_irq();
+    ret = true;
+  }
+  unLock();
+
+  i2cReadyWaitTrack(ch, dev_addr, ret);                 // V261019R4: 비동기 프로브와 통계 공용
 
   return ret;
 }
@@ -550,6 +562,153 @@ void i2cGetReadyWaitStats(uint8_t ch, i2c_ready_wait_stats_t *p_stats)
   *p_stats = i2c_ready_wait_stats[ch];                                // V251112R9: Ready wait 통계 조회
 }
 
+// ---------------------------------------------------------------------------
+// [Async] V261019R4
+//   - 블로킹 HAL_I2C_Mem_Write()/HAL_I2C_IsDeviceReady() 는 전송과 ACK 폴링 동안 호출자를 붙잡는다.
+//     여기서는 HAL IT 전송을 시작만 하고 완료/NACK 는 I2C3_EV/ER 인터럽트 콜백이 상태로 남긴다.
+//   - ACK 프로브는 NBYTES=0 + AUTOEND 마스터 송신이다. 주소 ACK 면 STOP 후 TxCplt, NACK 면 AF 오류로 끝난다.
+//   - 결과는 i2cAsyncPoll() 이 한 번만 돌려준다. 프로브 결과는 여기서 Ready wait 통계에 합친다.
+// ---------------------------------------------------------------------------
+bool i2cWriteA16BytesAsync(uint8_t ch, uint16_t dev_addr, uint16_t reg_addr, uint8_t *p_data, uint32_t length)
+{
+  HAL_StatusTypeDef i2c_ret;
+
+  if (ch >= I2C_MAX_CH || i2c_async_state[ch] == I2C_ASYNC_BUSY)
+  {
+    return false;
+  }
+
+  i2cLogTimingOnce(ch, i2c_tbl[ch].p_hi2c);
+
+  i2c_async_probe[ch] = false;
+  i2c_async_state[ch] = I2C_ASYNC_BUSY;
+  i2c_ret = HAL_I2C_Mem_Write_IT(i2c_tbl[ch].p_hi2c, (uint16_t)(dev_addr << 1), reg_addr, I2C_MEMADD_SIZE_16BIT, p_data, (uint16_t)length);
+  if (i2c_ret != HAL_OK)
+  {
+    i2c_async_state[ch] = I2C_ASYNC_IDLE;
+    return false;
+  }
+
+  return true;
+}
+
+bool i2cReadA16BytesAsync(uint8_t ch, uint16_t dev_addr, uint16_t reg_addr, uint8_t *p_data, uint32_t length)
+{
+  HAL_StatusTypeDef i2c_ret;
+
+  if (ch >= I2C_MAX_CH || i2c_async_state[ch] == I2C_ASYNC_BUSY)
+  {
+    return false;
+  }
+
+  i2cLogTimingOnce(ch, i2c_tbl[ch].p_hi2c);
+
+  i2c_async_probe[ch] = false;
+  i2c_async_state[ch] = I2C_ASYNC_BUSY;
+  i2c_ret = HAL_I2C_Mem_Read_IT(i2c_tbl[ch].p_hi2c, (uint16_t)(dev_addr << 1), reg_addr, I2C_MEMADD_SIZE_16BIT, p_data, (uint16_t)length);
+  if (i2c_ret != HAL_OK)
+  {
+    i2c_async_state[ch] = I2C_ASYNC_IDLE;
+    return false;
+  }
+
+  return true;
+}
+
+bool i2cProbeAsync(uint8_t ch, uint8_t dev_addr)
+{
+  HAL_StatusTypeDef i2c_ret;
+
+  if (ch >= I2C_MAX_CH || i2c_async_state[ch] == I2C_ASYNC_BUSY)
+  {
+    return false;
+  }
+
+  i2c_async_probe[ch] = true;
+  i2c_async_addr[ch]  = dev_addr;
+  i2c_async_state[ch] = I2C_ASYNC_BUSY;
+  i2c_ret = HAL_I2C_Master_Transmit_IT(i2c_tbl[ch].p_hi2c, (uint16_t)(dev_addr << 1), &i2c_async_dummy, 0);
+  if (i2c_ret != HAL_OK)
+  {
+    i2c_async_state[ch] = I2C_ASYNC_IDLE;
+    return false;
+  }
+
+  return true;
+}
+
+i2c_async_t i2cAsyncPoll(uint8_t ch)
+{
+  i2c_async_t state;
+
+  if (ch >= I2C_MAX_CH)
+  {
+    return I2C_ASYNC_IDLE;
+  }
+
+  state = (i2c_async_t)i2c_async_state[ch];
+  if (state == I2C_ASYNC_IDLE || state == I2C_ASYNC_BUSY)
+  {
+    return state;
+  }
+
+  if (i2c_async_probe[ch] == true && state != I2C_ASYNC_ERROR)
+  {
+    i2cReadyWaitTrack(ch, i2c_async_addr[ch], state == I2C_ASYNC_DONE);
+  }
+  i2c_async_state[ch] = I2C_ASYNC_IDLE;
+
+  return state;
+}
+
+void i2cAsyncAbort(uint8_t ch)
+{
+  if (ch >= I2C_MAX_CH)
+  {
+    return;
+  }
+
+  logPrintf("[!] I2C ch%d async timeout, recovery\n", ch + 1);
+  i2c_errcount[ch]++;
+  i2cRecovery(ch);                                       // HAL 상태/IT 를 초기화하고 버스를 푼다
+  i2c_async_state[ch] = I2C_ASYNC_IDLE;
+}
+
+static void i2cAsyncComplete(I2C_HandleTypeDef *hi2c)
+{
+  int8_t ch = i2cGetChannelFromHandle(hi2c);
+
+  if (ch >= 0 && i2c_async_state[ch] == I2C_ASYNC_BUSY)
+  {
+    i2c_async_state[ch] = I2C_ASYNC_DONE;
+  }
+}
+
+void HAL_I2C_MemTxCpltCallback(I2C_HandleTypeDef *hi2c)
+{
+  i2cAsyncComplete(hi2c);
+}
+
+void HAL_I2C_MasterTxCpltCallback(I2C_HandleTypeDef *hi2c)
+{
+  i2cAsyncComplete(hi2c);
+}
+
+void HAL_I2C_MemRxCpltCallback(I2C_HandleTypeDef *hi2c)
+{
+  i2cAsyncComplete(hi2c);                                // V261019R5: 백그라운드 EEPROM 이미지 로드
+}
+
+void I2C3_EV_IRQHandler(void)
+{
+  HAL_I2C_EV_IRQHandler(&hi2c3);
+}
+
+void I2C3_ER_IRQHandler(void)
+{
+  HAL_I2C_ER_IRQHandler(&hi2c3);
+}
+
 void delayUs(uint32_t us)
 {
   volatile uint32_t i;
@@ -570,6 +729,16 @@ void HAL_I2C_ErrorCallback(I2C_HandleTypeDef *hi2c)
   uint32_t err = HAL_I2C_GetError(hi2c);
   uint32_t err_time = millis();                          // V251112R7: HAL 오류 타임스탬프 기록
 
+  if (ch >= 0 && i2c_async_state[ch] == I2C_ASYNC_BUSY)
+  {
+    if (i2c_async_probe[ch] == true && err == HAL_I2C_ERROR_AF)
+    {
+      i2c_async_state[ch] = I2C_ASYNC_NACK;              // V261019R4: 프로브 NACK 는 쓰기 주기 중인 정상 응답
+      return;
+    }
+    i2c_async_state[ch] = (err == HAL_I2C_ERROR_AF) ? I2C_ASYNC_NACK : I2C_ASYNC_ERROR;
+  }
+
   if (ch >= 0)
   {
     i2c_errcount[ch]++;
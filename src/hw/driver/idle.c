@@ -0,0 +1,230 @@
+#include "idle.h"
+
+
+#ifdef _USE_HW_IDLE
+#include "micros.h"
+#include "cli.h"
+
+#if CLI_USE(HW_IDLE)
+static void cliIdle(cli_args_t *args);
+#endif
+
+
+// ---------------------------------------------------------------------------
+// [Idle WFI] V261017R5
+//   - ISR(DMA 프레임 변화, VIA RX, SOF)이 idleSetEvent() 로 이벤트 비트를 기록하고
+//     메인 루프는 idleWait() 에서 이벤트가 없으면 WFI 로 잠든다.
+//   - 1ms tick(SysTick) 경과는 TIMER 이벤트로 취급해 QMK 타이머/디바운스가 계속 진행되도록 한다.
+//   - 이벤트 확인과 WFI 는 PRIMASK 로 인터럽트를 막은 상태에서 수행한다.
+//     PRIMASK=1 이어도 보류 인터럽트는 WFI 를 깨우므로 확인~수면 사이에 들어온 이벤트를 놓치지 않는다.
+//   - V261019R9: 매트릭스가 디바운스 확정 대기(raw != cooked) 상태면 DEBOUNCE 이벤트를 남겨
+//     다음 idleWait() 가 잠들지 않게 한다. 125us/defer 만료가 1ms tick 까지 밀리지 않는다.
+//   - KEYS 이벤트는 ISR 시각을 기록해 깨움 지연과 루프 처리 완료 지연을 계측한다.
+// ---------------------------------------------------------------------------
+static volatile uint32_t idle_events = 0;
+static volatile uint32_t idle_key_us = 0;            // 첫 KEYS 이벤트가 기록된 시각
+static uint32_t          idle_tick_ms = 0;
+static uint32_t          idle_taken   = 0;            // 마지막 idleWait() 가 가져간 이벤트
+static uint32_t          idle_taken_key_us = 0;
+static idle_info_t       idle_info;
+
+
+
+
+bool idleInit(void)
+{
+  memset(&idle_info, 0, sizeof(idle_info));
+  idle_info.enable = HW_IDLE_WFI_DEFAULT ? true : false;
+  idle_events      = 0;
+  idle_tick_ms     = millis();
+
+  logPrintf("[OK] idleInit()\n");
+  logPrintf("     wfi : %s\n", idle_info.enable ? "ON" : "OFF");
+
+#if CLI_USE(HW_IDLE)
+  cliAdd("idle", cliIdle);
+#endif
+  return true;
+}
+
+void idleSetEnable(bool enable)
+{
+  idle_info.enable = enable;
+}
+
+bool idleIsEnabled(void)
+{
+  return idle_info.enable;
+}
+
+// ISR 에서 호출된다. 우선순위가 다른 ISR 끼리 중첩될 수 있으므로 원자적 OR 로 기록한다.
+void idleSetEvent(uint32_t event)
+{
+  if ((event & IDLE_EVENT_KEYS) && (idle_events & IDLE_EVENT_KEYS) == 0)
+  {
+    idle_key_us = micros();
+  }
+  __atomic_fetch_or(&idle_events, event, __ATOMIC_RELAXED);
+}
+
+// 처리할 이벤트가 생길 때까지 WFI 로 대기하고 가져간 이벤트 비트를 반환한다.
+// 비활성 상태에서는 잠들지 않고 즉시 반환하므로(0 가능) 기존 busy loop 와 동일하게 동작한다.
+uint32_t idleWait(void)
+{
+  uint32_t events;
+  uint32_t key_us;
+
+  while (true)
+  {
+    __disable_irq();
+    uint32_t now_ms = millis();
+
+    if (now_ms != idle_tick_ms)
+    {
+      idle_tick_ms = now_ms;
+      idle_events |= IDLE_EVENT_TIMER;
+    }
+    events      = idle_events;
+    key_us      = idle_key_us;
+    idle_events = 0;
+
+    if (events == 0 && idle_info.enable)
+    {
+      uint32_t sleep_us = micros();
+
+      __DSB();
+      __WFI();
+      idle_info.sleep_us += micros() - sleep_us;
+      idle_info.sleep_cnt++;
+    }
+    __enable_irq();                                   // 보류된 ISR 이 여기서 실행된다
+
+    if (events != 0 || idle_info.enable != true)
+    {
+      break;
+    }
+  }
+
+  idle_taken        = events;
+  idle_taken_key_us = key_us;
+  if (events != 0)
+  {
+    idle_info.wake_cnt++;
+    for (uint32_t i=0; i<IDLE_EVENT_MAX; i++)
+    {
+      if (events & (1U << i))
+      {
+        idle_info.event_cnt[i]++;
+      }
+    }
+  }
+  if (events & IDLE_EVENT_KEYS)
+  {
+    uint32_t lat = micros() - key_us;
+
+    idle_info.key_wake_us_last = lat;
+    if (lat > idle_info.key_wake_us_max)
+    {
+      idle_info.key_wake_us_max = lat;
+    }
+  }
+  return events;
+}
+
+// 메인 루프가 idleWait() 이후 한 바퀴 처리를 끝냈을 때 호출한다.
+void idleMarkDone(void)
+{
+  if (idle_taken & IDLE_EVENT_KEYS)
+  {
+    uint32_t lat = micros() - idle_taken_key_us;
+
+    idle_info.key_done_us_last = lat;
+    idle_info.key_done_us_sum += lat;
+    idle_info.key_done_cnt++;
+    if (lat > idle_info.key_done_us_max)
+    {
+      idle_info.key_done_us_max = lat;
+    }
+  }
+  idle_taken = 0;
+}
+
+void idleGetInfo(idle_info_t *p_info)
+{
+  *p_info = idle_info;
+}
+
+void idleClearInfo(void)
+{
+  bool enable = idle_info.enable;
+
+  memset(&idle_info, 0, sizeof(idle_info));
+  idle_info.enable = enable;
+}
+
+
+#if CLI_USE(HW_IDLE)
+void cliIdle(cli_args_t *args)
+{
+  bool ret = false;
+
+
+  if (args->argc == 1 && args->isStr(0, "info"))
+  {
+    idle_info_t info;
+    uint32_t    avg;
+
+    idleGetInfo(&info);
+    avg = info.key_done_cnt > 0 ? info.key_done_us_sum / info.key_done_cnt : 0;
+
+    cliPrintf("wfi        : %s\n", info.enable ? "ON" : "OFF");
+    cliPrintf("wake cnt   : %lu\n", info.wake_cnt);
+    cliPrintf("sleep cnt  : %lu\n", info.sleep_cnt);
+    cliPrintf("sleep time : %lu ms\n", info.sleep_us / 1000);
+    cliPrintf("events     : keys %lu, timer %lu, sof %lu, via %lu, debounce %lu\n",
+              info.event_cnt[0],
+              info.event_cnt[1],
+              info.event_cnt[2],
+              info.event_cnt[3],
+              info.event_cnt[4]);                     // V261019R9: 디바운스 대기 재실행 횟수
+    cliPrintf("key wake   : last %lu us, max %lu us\n", info.key_wake_us_last, info.key_wake_us_max);
+    cliPrintf("key done   : last %lu us, max %lu us, avg %lu us (%lu)\n",
+              info.key_done_us_last,
+              info.key_done_us_max,
+              avg,
+              info.key_done_cnt);
+    ret = true;
+  }
+
+  if (args->argc == 1 && args->isStr(0, "on"))
+  {
+    idleSetEnable(true);
+    cliPrintf("wfi : ON\n");
+    ret = true;
+  }
+
+  if (args->argc == 1 && args->isStr(0, "off"))
+  {
+    idleSetEnable(false);
+    cliPrintf("wfi : OFF\n");
+    ret = true;
+  }
+
+  if (args->argc == 1 && args->isStr(0, "clear"))
+  {
+    idleClearInfo();
+    ret = true;
+  }
+
+
+  if (ret == false)
+  {
+    cliPrintf("idle info\n");
+    cliPrintf("idle on\n");
+    cliPrintf("idle off\n");
+    cliPrintf("idle clear\n");
+  }
+}
+#endif
+
+#endif
@@ -4,34 +4,118 @@
 
 #ifdef _USE_HW_KEYS
 #include "button.h"
+#include "idle.h"                                                              // V261017R5: 프레임 변화 시 메인 루프 깨움
+#include "cli.h"
+#include "micros.h"                                                            // V261017R8: 프레임 캡처 시각
 
 
 
+static bool keysInitDesc(void);
 static bool keysInitTimer(void);
 static bool keysInitDma(void);
 static bool keysInitGpio(void);
+static void keysGpioClockEnable(GPIO_TypeDef *port);
+static void keysDmaHalfCpltCallback(DMA_HandleTypeDef *hdma);
+static void keysDmaCpltCallback(DMA_HandleTypeDef *hdma);
+#if CLI_USE(HW_KEYS)
+static void cliKeys(cli_args_t *args);
+#endif
+static void keysPublishFrame(uint32_t half);
+static bool keysApplyScan(uint8_t samples, keys_reduce_t reduce, keys_scan_rate_t rate);
+static bool keysCaptureRestart(uint8_t samples, keys_reduce_t reduce, keys_scan_rate_t rate);
+static void keysBuildCaptureNode(DMA_NodeConfTypeDef *p_cfg);
+
+
+_Static_assert(MATRIX_ROWS <= KEYS_ROWS_MAX, "MATRIX_ROWS exceeds KEYS_ROWS_MAX");
+_Static_assert(MATRIX_COLS <= KEYS_COLS_MAX, "MATRIX_COLS exceeds KEYS_COLS_MAX");
+_Static_assert(HW_KEYS_COL_PORT_CNT >= 1 && HW_KEYS_COL_PORT_CNT <= KEYS_COL_PORT_MAX, "HW_KEYS_COL_PORT_CNT out of range");
+// V261021R2: 보드 기본 스캔 설정과 최고 속도(행 1us, N=1)의 프레임 게시 주기가 8kHz(125us) 이내인지 확인
+_Static_assert(KEYS_SWEEPS_PER_HALF_CALC(1, MATRIX_ROWS) * MATRIX_ROWS <= KEYS_FRAME_MAX_US,
+               "MATRIX_ROWS too large for 8kHz frame publish");
+_Static_assert(KEYS_SWEEPS_PER_HALF_CALC(HW_KEYS_OVERSAMPLE_DEFAULT, MATRIX_ROWS * (1U << HW_KEYS_SCAN_RATE_DEFAULT)) *
+               MATRIX_ROWS * (1U << HW_KEYS_SCAN_RATE_DEFAULT) <= KEYS_FRAME_MAX_US,
+               "default scan profile publishes frames slower than 8kHz");
+
+
+// V261017R7: 보드 매트릭스 디스크립터 (hw_caps_keys.h 기본값 또는 보드 config.h 재정의)
+//   - 행 출력은 keysInitDesc() 가 row_wr_buf 에 BSRR 워드(해당 행 set + 나머지 행 reset)로 만든다.
+//   - 열 입력은 포트별 IDR 샘플을 [스윕][행][포트] 순서로 캡처하고, 게시 시 구간 표로 keys_col_t 로 모은다.
+//   - 열 포트가 하나면 기존과 같은 선형 노드(Channel2), 둘 이상이면 2D 노드(Channel12)로
+//     TIM16 Update 요청 1회당 모든 열 포트를 연속으로 읽는다.
+#define KEYS_COL_PORTS            HW_KEYS_COL_PORT_CNT
+
+static const keys_col_seg_t     keys_col_seg[] = HW_KEYS_COL_SEGS;
+static const keys_matrix_desc_t keys_matrix_desc =
+{
+  .row_port  = HW_KEYS_ROW_PORT,
+  .row_pin   = HW_KEYS_ROW_PINS,
+  .rows      = MATRIX_ROWS,
+  .col_port  = HW_KEYS_COL_PORTS,
+  .col_ports = KEYS_COL_PORTS,
+  .col_seg   = keys_col_seg,
+  .col_segs  = sizeof(keys_col_seg) / sizeof(keys_col_seg[0]),
+};
+
+static uint16_t keys_seg_mask[sizeof(keys_col_seg) / sizeof(keys_col_seg[0])];  // 구간별 핀 마스크 (pin_first 기준 정렬)
+static bool     keys_seg_direct = false;                                        // 포트 1개·구간 1개·시프트 없음이면 마스크만 적용
 
+__attribute__((section(".non_cache")))
+static volatile uint32_t row_wr_buf[MATRIX_ROWS] = {0x00,};                     // V261017R7: 행별 BSRR 워드 (DMA 소스)
 
-
-const static uint8_t row_wr_buf[] = {0x01, 0x02, 0x04, 0x08, 0x10, 0x20};
+// V261017R4: 프레임 단위 이중 버퍼 캡처
+//   - DMA 는 col_dma_buf 앞쪽 2 x 절반을 순환 기록하고, HT/TC 이벤트마다 방금 완료된 절반의 마지막 스윕을 게시한다.
+//   - 게시는 col_frame_buf[seq & 1] 핑퐁 + col_frame_seq 증가로 하며, 메인 루프는 seq 가 바뀔 때만 스캔한다.
+//   - V261021R2: 절반 = keys_sweeps_per_half 스윕 (keysCalcSweepsPerHalf()). 고정 16 스윕이면 16행 1us 에서도
+//     256us 마다 게시되어 8kHz 에 못 미치므로, 오버샘플/행 주기가 바뀔 때 캡처 노드를 다시 만든다.
+#define KEYS_SWEEP_SAMPLES        (MATRIX_ROWS * KEYS_COL_PORTS)                // V261017R7: 스윕 1회의 IDR 샘플 수
 
 __attribute__((section(".non_cache")))
-static volatile uint16_t col_rd_buf[MATRIX_ROWS] = {0x00,};  // V250924R5: DMA 직접 참조 재검토로 volatile 지정해 최신 값 보장
-
+static volatile uint16_t col_dma_buf[2 * KEYS_OVERSAMPLE_MAX * KEYS_SWEEP_SAMPLES] = {0x00,};
+
+static keys_col_t        col_frame_buf[2][MATRIX_ROWS];  // V261017R4: 완결된 스윕 스냅샷 (ISR 기록, 메인 루프 읽기)
+static volatile uint32_t col_frame_seq = 0;               // V261017R4: 게시된 프레임 번호 (0 = 아직 없음)
+static uint32_t          col_frame_us[2];                 // V261017R8: 프레임 게시 시각 (마지막 스윕 완료 시점, us)
+
+// V261017R6: 오버샘플링 설정 (ISR 에서 읽음). 한 프레임 = 완료된 절반의 마지막 keys_oversample 스윕 축약
+//   TIM16 은 10MHz 카운트이므로 ARR 로 행 샘플 주기(1/2/4/8us)를 정한다.
+static volatile uint8_t       keys_oversample = HW_KEYS_OVERSAMPLE_DEFAULT;
+static volatile keys_reduce_t keys_reduce     = (keys_reduce_t)HW_KEYS_REDUCE_DEFAULT;
+static keys_scan_rate_t       keys_scan_rate  = (keys_scan_rate_t)HW_KEYS_SCAN_RATE_DEFAULT;
+static const uint16_t         keys_scan_period[KEYS_SCAN_RATE_COUNT] = {9, 19, 39, 79};
+static const uint8_t          keys_scan_row_us[KEYS_SCAN_RATE_COUNT] = {1, 2, 4, 8};
+static volatile uint32_t      keys_sweeps_per_half = KEYS_SWEEPS_PER_HALF_CALC(HW_KEYS_OVERSAMPLE_DEFAULT,
+                                                                               MATRIX_ROWS * (1U << HW_KEYS_SCAN_RATE_DEFAULT));
+
+
+#if KEYS_COL_PORTS > 1
+#define KEYS_CAP_DMA_CHANNEL      GPDMA1_Channel12    // V261017R7: 2D 주소 지정 채널 (12~15)
+#define KEYS_CAP_DMA_IRQn         GPDMA1_Channel12_IRQn
+#define KEYS_CAP_DMA_IRQHandler   GPDMA1_Channel12_IRQHandler
+#else
+#define KEYS_CAP_DMA_CHANNEL      GPDMA1_Channel2
+#define KEYS_CAP_DMA_IRQn         GPDMA1_Channel2_IRQn
+#define KEYS_CAP_DMA_IRQHandler   GPDMA1_Channel2_IRQHandler
+#endif
 
 
 static TIM_HandleTypeDef htim16;
 static DMA_NodeTypeDef   Node_GPDMA1_Channel1;
 static DMA_QListTypeDef  List_GPDMA1_Channel1;
 static DMA_HandleTypeDef handle_GPDMA1_Channel1;
-static DMA_NodeTypeDef   Node_GPDMA1_Channel2;
-static DMA_QListTypeDef  List_GPDMA1_Channel2;
-static DMA_HandleTypeDef handle_GPDMA1_Channel2;
+static DMA_NodeTypeDef   Node_GPDMA1_Capture;
+static DMA_QListTypeDef  List_GPDMA1_Capture;
+static DMA_HandleTypeDef handle_GPDMA1_Capture;
 
 
 
 bool keysInit(void)
 {
+  if (keysInitDesc() != true)
+  {
+    logPrintf("[!] keysInitDesc 실패\n");                                      // V261017R7: 매트릭스 디스크립터 검증 실패
+    return false;
+  }
+
   if (keysInitGpio() != true)
   {
     logPrintf("[!] keysInitGpio 실패\n");                                      // V251124R4: GPIO 초기화 실패 감지
@@ -55,57 +139,144 @@ bool keysInit(void)
   HAL_TIM_Base_Start(&htim16);
   HAL_TIM_OC_Start(&htim16, TIM_CHANNEL_1);
 
+#if CLI_USE(HW_KEYS)
+  cliAdd("keys", cliKeys);                                                     // V261017R6: 오버샘플링/스캔 주기 조회·변경
+#endif
+
 
   // V251009R2: DMA 기반 자동 스캔이 상시 갱신되므로 CLI 키 매트릭스 뷰어를 제거함
   return true;
 }
 
-bool keysInitGpio(void)
+// V261017R7: 디스크립터를 검증하고 행 BSRR 표와 열 구간 마스크를 만든다.
+bool keysInitDesc(void)
 {
-  GPIO_InitTypeDef GPIO_InitStruct = {0};
+  const keys_matrix_desc_t *p_desc   = &keys_matrix_desc;
+  uint32_t                  row_mask = 0;
+  keys_col_t                col_used = 0;
 
 
-  __HAL_RCC_GPIOA_CLK_ENABLE();
-  __HAL_RCC_GPIOB_CLK_ENABLE();
+  for (uint32_t i=0; i<p_desc->rows; i++)
+  {
+    if (p_desc->row_pin[i] >= 16 || (row_mask & (1U << p_desc->row_pin[i])))
+    {
+      logPrintf("[!] keys row pin invalid : row %d\n", i);
+      return false;
+    }
+    row_mask |= 1U << p_desc->row_pin[i];
+  }
+  for (uint32_t i=0; i<p_desc->rows; i++)
+  {
+    uint32_t set = 1U << p_desc->row_pin[i];
+
+    row_wr_buf[i] = set | ((row_mask & ~set) << 16);                  // BSRR: 하위 16비트 set, 상위 16비트 reset
+  }
+
+  // 2D 노드는 포트 사이 주소 간격을 버스트 오프셋 하나로 표현하므로 등간격만 허용한다.
+  for (uint32_t i=2; i<p_desc->col_ports; i++)
+  {
+    if ((uint32_t)p_desc->col_port[i] - (uint32_t)p_desc->col_port[i - 1] !=
+        (uint32_t)p_desc->col_port[1] - (uint32_t)p_desc->col_port[0])
+    {
+      logPrintf("[!] keys col ports must be evenly spaced\n");
+      return false;
+    }
+  }
+  if (p_desc->col_ports > 1 && p_desc->col_port[1] <= p_desc->col_port[0])
+  {
+    logPrintf("[!] keys col ports must be ascending\n");
+    return false;
+  }
+
+  for (uint32_t i=0; i<p_desc->col_segs; i++)
+  {
+    const keys_col_seg_t *p_seg = &p_desc->col_seg[i];
+    keys_col_t            cols;
+
+    if (p_seg->port >= p_desc->col_ports ||
+        p_seg->pin_count == 0 ||
+        p_seg->pin_first + p_seg->pin_count > 16 ||
+        p_seg->col_first + p_seg->pin_count > MATRIX_COLS)
+    {
+      logPrintf("[!] keys col seg invalid : %d\n", i);
+      return false;
+    }
+    cols = (keys_col_t)((((uint64_t)1 << p_seg->pin_count) - 1) << p_seg->col_first);
+    if (col_used & cols)
+    {
+      logPrintf("[!] keys col seg overlap : %d\n", i);
+      return false;
+    }
+    col_used        |= cols;
+    keys_seg_mask[i] = (uint16_t)((1UL << p_seg->pin_count) - 1);
+  }
+
+  keys_seg_direct = (p_desc->col_ports == 1 &&
+                     p_desc->col_segs == 1 &&
+                     p_desc->col_seg[0].pin_first == 0 &&
+                     p_desc->col_seg[0].col_first == 0);
+  return true;
+}
+
+void keysGpioClockEnable(GPIO_TypeDef *port)
+{
+  if (port == GPIOA) __HAL_RCC_GPIOA_CLK_ENABLE();
+  if (port == GPIOB) __HAL_RCC_GPIOB_CLK_ENABLE();
+  if (port == GPIOC) __HAL_RCC_GPIOC_CLK_ENABLE();
+  if (port == GPIOD) __HAL_RCC_GPIOD_CLK_ENABLE();
+  if (port == GPIOE) __HAL_RCC_GPIOE_CLK_ENABLE();
+  if (port == GPIOF) __HAL_RCC_GPIOF_CLK_ENABLE();
+  if (port == GPIOG) __HAL_RCC_GPIOG_CLK_ENABLE();
+  if (port == GPIOH) __HAL_RCC_GPIOH_CLK_ENABLE();
+  if (port == GPIOM) __HAL_RCC_GPIOM_CLK_ENABLE();
+  if (port == GPION) __HAL_RCC_GPION_CLK_ENABLE();
+  if (port == GPIOO) __HAL_RCC_GPIOO_CLK_ENABLE();
+  if (port == GPIOP) __HAL_RCC_GPIOP_CLK_ENABLE();
+}
+
+bool keysInitGpio(void)
+{
+  const keys_matrix_desc_t *p_desc = &keys_matrix_desc;
+  GPIO_InitTypeDef          GPIO_InitStruct = {0};
+
 
   // ROWS
   //
+  keysGpioClockEnable(p_desc->row_port);
+
   GPIO_InitStruct.Mode  = GPIO_MODE_OUTPUT_PP;
   GPIO_InitStruct.Speed = GPIO_SPEED_FREQ_HIGH;
-  GPIO_InitStruct.Pin   = GPIO_PIN_0 |
-                        GPIO_PIN_1 |
-                        GPIO_PIN_2 |
-                        GPIO_PIN_3 |
-                        GPIO_PIN_4 |
-                        GPIO_PIN_5 |
-                        GPIO_PIN_6 |
-                        GPIO_PIN_7;
+  GPIO_InitStruct.Pin   = 0;
+  for (uint32_t i=0; i<p_desc->rows; i++)
+  {
+    GPIO_InitStruct.Pin |= 1U << p_desc->row_pin[i];                 // V261017R7: 디스크립터 행 핀만 출력으로 설정
+  }
   GPIO_InitStruct.Pull  = GPIO_NOPULL;
-  HAL_GPIO_Init(GPIOA, &GPIO_InitStruct); 
+  HAL_GPIO_Init(p_desc->row_port, &GPIO_InitStruct);
 
 
   // COLS
   //
-  GPIO_InitStruct.Mode  = GPIO_MODE_INPUT;
-  GPIO_InitStruct.Speed = GPIO_SPEED_FREQ_HIGH;
-  GPIO_InitStruct.Pin   = GPIO_PIN_0 |
-                        GPIO_PIN_1 |
-                        GPIO_PIN_2 |
-                        GPIO_PIN_3 |
-                        GPIO_PIN_4 |
-                        GPIO_PIN_5 |
-                        GPIO_PIN_6 |
-                        GPIO_PIN_7 |
-                        GPIO_PIN_8 |
-                        GPIO_PIN_9 |
-                        GPIO_PIN_10 |
-                        GPIO_PIN_11 |
-                        GPIO_PIN_12 |
-                        GPIO_PIN_13 |
-                        GPIO_PIN_14 |
-                        GPIO_PIN_15;
-  GPIO_InitStruct.Pull  = GPIO_PULLDOWN;
-  HAL_GPIO_Init(GPIOB, &GPIO_InitStruct);  
+  for (uint32_t port=0; port<p_desc->col_ports; port++)
+  {
+    keysGpioClockEnable(p_desc->col_port[port]);
+
+    GPIO_InitStruct.Mode  = GPIO_MODE_INPUT;
+    GPIO_InitStruct.Speed = GPIO_SPEED_FREQ_HIGH;
+    GPIO_InitStruct.Pin   = 0;
+    for (uint32_t i=0; i<p_desc->col_segs; i++)
+    {
+      if (p_desc->col_seg[i].port == port)
+      {
+        GPIO_InitStruct.Pin |= (uint32_t)keys_seg_mask[i] << p_desc->col_seg[i].pin_first;
+      }
+    }
+    GPIO_InitStruct.Pull  = HW_KEYS_COL_PULL;
+    if (GPIO_InitStruct.Pin != 0)
+    {
+      HAL_GPIO_Init(p_desc->col_port[port], &GPIO_InitStruct);
+    }
+  }
   return true;
 }
 
@@ -122,7 +293,7 @@ bool keysInitTimer(void)
   htim16.Instance               = TIM16;
   htim16.Init.Prescaler         = 29;
   htim16.Init.CounterMode       = TIM_COUNTERMODE_UP;
-  htim16.Init.Period            = 9;
+  htim16.Init.Period            = keys_scan_period[keys_scan_rate];           // V261017R6: 행 샘플 주기 (기본 1us)
   htim16.Init.ClockDivision     = TIM_CLOCKDIVISION_DIV1;
   htim16.Init.RepetitionCounter = 0;
   htim16.Init.AutoReloadPreload = TIM_AUTORELOAD_PRELOAD_DISABLE;
@@ -183,8 +354,8 @@ bool keysInitDma(void)
   NodeConfig.Init.Direction                   = DMA_MEMORY_TO_PERIPH;
   NodeConfig.Init.SrcInc                      = DMA_SINC_INCREMENTED;
   NodeConfig.Init.DestInc                     = DMA_DINC_FIXED;
-  NodeConfig.Init.SrcDataWidth                = DMA_SRC_DATAWIDTH_BYTE;
-  NodeConfig.Init.DestDataWidth               = DMA_DEST_DATAWIDTH_BYTE;
+  NodeConfig.Init.SrcDataWidth                = DMA_SRC_DATAWIDTH_WORD;   // V261017R7: BSRR 워드 기록
+  NodeConfig.Init.DestDataWidth               = DMA_DEST_DATAWIDTH_WORD;
   NodeConfig.Init.SrcBurstLength              = 1;
   NodeConfig.Init.DestBurstLength             = 1;
   NodeConfig.Init.TransferAllocatedPort       = DMA_SRC_ALLOCATED_PORT0 | DMA_DEST_ALLOCATED_PORT0;
@@ -194,8 +365,8 @@ bool keysInitDma(void)
   NodeConfig.DataHandlingConfig.DataExchange  = DMA_EXCHANGE_NONE;
   NodeConfig.DataHandlingConfig.DataAlignment = DMA_DATA_RIGHTALIGN_ZEROPADDED;
   NodeConfig.SrcAddress                       = (uint32_t)&row_wr_buf[0];
-  NodeConfig.DstAddress                       = (uint32_t)&GPIOA->ODR;
-  NodeConfig.DataSize                         = MATRIX_ROWS;
+  NodeConfig.DstAddress                       = (uint32_t)&keys_matrix_desc.row_port->BSRR;
+  NodeConfig.DataSize                         = sizeof(row_wr_buf);
   if (HAL_DMAEx_List_BuildNode(&NodeConfig, &Node_GPDMA1_Channel1) != HAL_OK)
   {
     return false;
@@ -237,66 +408,105 @@ bool keysInitDma(void)
 
   // Update Event
   //
-  NodeConfig.NodeType                         = DMA_GPDMA_LINEAR_NODE;
-  NodeConfig.Init.Request                     = GPDMA1_REQUEST_TIM16_UP;
-  NodeConfig.Init.BlkHWRequest                = DMA_BREQ_SINGLE_BURST;
-  NodeConfig.Init.Direction                   = DMA_PERIPH_TO_MEMORY;
-  NodeConfig.Init.SrcInc                      = DMA_SINC_FIXED;
-  NodeConfig.Init.DestInc                     = DMA_DINC_INCREMENTED;
-  NodeConfig.Init.SrcDataWidth                = DMA_SRC_DATAWIDTH_HALFWORD;
-  NodeConfig.Init.DestDataWidth               = DMA_DEST_DATAWIDTH_HALFWORD;
-  NodeConfig.Init.SrcBurstLength              = 1;
-  NodeConfig.Init.DestBurstLength             = 1;
-  NodeConfig.Init.TransferAllocatedPort       = DMA_SRC_ALLOCATED_PORT0 | DMA_DEST_ALLOCATED_PORT0;
-  NodeConfig.Init.TransferEventMode           = DMA_TCEM_BLOCK_TRANSFER;
-  NodeConfig.Init.Mode                        = DMA_NORMAL;
-  NodeConfig.TriggerConfig.TriggerPolarity    = DMA_TRIG_POLARITY_MASKED;
-  NodeConfig.DataHandlingConfig.DataExchange  = DMA_EXCHANGE_NONE;
-  NodeConfig.DataHandlingConfig.DataAlignment = DMA_DATA_RIGHTALIGN_ZEROPADDED;
-  NodeConfig.SrcAddress                       = (uint32_t)&GPIOB->IDR;
-  NodeConfig.DstAddress                       = (uint32_t)&col_rd_buf[0];
-  NodeConfig.DataSize                         = sizeof(col_rd_buf);
-  if (HAL_DMAEx_List_BuildNode(&NodeConfig, &Node_GPDMA1_Channel2) != HAL_OK)
+  keysBuildCaptureNode(&NodeConfig);                                  // V261021R2: 절반 스윕 수는 현재 오버샘플/행 주기로 정함
+  if (HAL_DMAEx_List_BuildNode(&NodeConfig, &Node_GPDMA1_Capture) != HAL_OK)
   {
     return false;
   }
 
-  if (HAL_DMAEx_List_InsertNode(&List_GPDMA1_Channel2, NULL, &Node_GPDMA1_Channel2) != HAL_OK)
+  if (HAL_DMAEx_List_InsertNode(&List_GPDMA1_Capture, NULL, &Node_GPDMA1_Capture) != HAL_OK)
   {
     return false;
   }
 
-  if (HAL_DMAEx_List_SetCircularMode(&List_GPDMA1_Channel2) != HAL_OK)
+  if (HAL_DMAEx_List_SetCircularMode(&List_GPDMA1_Capture) != HAL_OK)
   {
     return false;
   }
 
-  handle_GPDMA1_Channel2.Instance                         = GPDMA1_Channel2;
-  handle_GPDMA1_Channel2.InitLinkedList.Priority          = DMA_LOW_PRIORITY_MID_WEIGHT;
-  handle_GPDMA1_Channel2.InitLinkedList.LinkStepMode      = DMA_LSM_FULL_EXECUTION;
-  handle_GPDMA1_Channel2.InitLinkedList.LinkAllocatedPort = DMA_LINK_ALLOCATED_PORT1;
-  handle_GPDMA1_Channel2.InitLinkedList.TransferEventMode = DMA_TCEM_BLOCK_TRANSFER;
-  handle_GPDMA1_Channel2.InitLinkedList.LinkedListMode    = DMA_LINKEDLIST_CIRCULAR;
-  if (HAL_DMAEx_List_Init(&handle_GPDMA1_Channel2) != HAL_OK)
+  handle_GPDMA1_Capture.Instance                         = KEYS_CAP_DMA_CHANNEL;
+  handle_GPDMA1_Capture.InitLinkedList.Priority          = DMA_LOW_PRIORITY_MID_WEIGHT;
+  handle_GPDMA1_Capture.InitLinkedList.LinkStepMode      = DMA_LSM_FULL_EXECUTION;
+  handle_GPDMA1_Capture.InitLinkedList.LinkAllocatedPort = DMA_LINK_ALLOCATED_PORT1;
+  handle_GPDMA1_Capture.InitLinkedList.TransferEventMode = NodeConfig.Init.TransferEventMode;
+  handle_GPDMA1_Capture.InitLinkedList.LinkedListMode    = DMA_LINKEDLIST_CIRCULAR;
+  if (HAL_DMAEx_List_Init(&handle_GPDMA1_Capture) != HAL_OK)
   {
     return false;
   }
 
-  if (HAL_DMAEx_List_LinkQ(&handle_GPDMA1_Channel2, &List_GPDMA1_Channel2) != HAL_OK)
+  if (HAL_DMAEx_List_LinkQ(&handle_GPDMA1_Capture, &List_GPDMA1_Capture) != HAL_OK)
   {
     return false;
   }
 
-  if (HAL_DMA_ConfigChannelAttributes(&handle_GPDMA1_Channel2, DMA_CHANNEL_NPRIV) != HAL_OK)
+  if (HAL_DMA_ConfigChannelAttributes(&handle_GPDMA1_Capture, DMA_CHANNEL_NPRIV) != HAL_OK)
   {
     return false;
   }
 
-  HAL_DMAEx_List_Start(&handle_GPDMA1_Channel2);
+  // V261017R4: HT/TC 콜백 등록 시 HAL_DMAEx_List_Start_IT() 가 두 인터럽트를 함께 활성화한다.
+  if (HAL_DMA_RegisterCallback(&handle_GPDMA1_Capture, HAL_DMA_XFER_HALFCPLT_CB_ID, keysDmaHalfCpltCallback) != HAL_OK)
+  {
+    return false;
+  }
+  if (HAL_DMA_RegisterCallback(&handle_GPDMA1_Capture, HAL_DMA_XFER_CPLT_CB_ID, keysDmaCpltCallback) != HAL_OK)
+  {
+    return false;
+  }
+
+  HAL_NVIC_SetPriority(KEYS_CAP_DMA_IRQn, 5, 0);
+  HAL_NVIC_EnableIRQ(KEYS_CAP_DMA_IRQn);
+
+  if (HAL_DMAEx_List_Start_IT(&handle_GPDMA1_Capture) != HAL_OK)
+  {
+    return false;
+  }
 
   return true;
 }
 
+// V261021R2: TIM16 Update 요청으로 열 IDR 을 읽는 캡처 노드 설정 (절반 = keys_sweeps_per_half 스윕)
+void keysBuildCaptureNode(DMA_NodeConfTypeDef *p_cfg)
+{
+  uint32_t sweeps = keys_sweeps_per_half;
+
+
+  p_cfg->NodeType                         = DMA_GPDMA_LINEAR_NODE;
+  p_cfg->Init.Request                     = GPDMA1_REQUEST_TIM16_UP;
+  p_cfg->Init.BlkHWRequest                = DMA_BREQ_SINGLE_BURST;
+  p_cfg->Init.Direction                   = DMA_PERIPH_TO_MEMORY;
+  p_cfg->Init.SrcInc                      = DMA_SINC_FIXED;
+  p_cfg->Init.DestInc                     = DMA_DINC_INCREMENTED;
+  p_cfg->Init.SrcDataWidth                = DMA_SRC_DATAWIDTH_HALFWORD;
+  p_cfg->Init.DestDataWidth               = DMA_DEST_DATAWIDTH_HALFWORD;
+  p_cfg->Init.SrcBurstLength              = 1;
+  p_cfg->Init.DestBurstLength             = 1;
+  p_cfg->Init.TransferAllocatedPort       = DMA_SRC_ALLOCATED_PORT0 | DMA_DEST_ALLOCATED_PORT0;
+  p_cfg->Init.TransferEventMode           = DMA_TCEM_BLOCK_TRANSFER;
+  p_cfg->Init.Mode                        = DMA_NORMAL;
+  p_cfg->TriggerConfig.TriggerPolarity    = DMA_TRIG_POLARITY_MASKED;
+  p_cfg->DataHandlingConfig.DataExchange  = DMA_EXCHANGE_NONE;
+  p_cfg->DataHandlingConfig.DataAlignment = DMA_DATA_RIGHTALIGN_ZEROPADDED;
+  p_cfg->SrcAddress                       = (uint32_t)&keys_matrix_desc.col_port[0]->IDR;
+  p_cfg->DstAddress                       = (uint32_t)&col_dma_buf[0];
+  p_cfg->DataSize                         = 2 * sweeps * KEYS_SWEEP_SAMPLES * sizeof(uint16_t);  // V261017R4: 두 절반을 한 블록으로 순환, HT/TC 로 절반 완료 감지
+#if KEYS_COL_PORTS > 1
+  // V261017R7: 2D 노드로 Update 요청 1회(블록 = 포트 수 x 하프워드)마다 열 포트 IDR 을 차례로 읽는다.
+  //   - 버스트 간 소스 오프셋 = 포트 간격, 블록 종료 후 첫 포트로 되돌림
+  //   - 반복 블록 전체(2 x 절반)를 한 전송으로 보고 HT/TC 로 절반 완료를 감지한다.
+  p_cfg->NodeType                           = DMA_GPDMA_2D_NODE;
+  p_cfg->Init.BlkHWRequest                  = DMA_BREQ_BLOCK;
+  p_cfg->Init.TransferEventMode             = DMA_TCEM_REPEATED_BLOCK_TRANSFER;
+  p_cfg->DataSize                           = KEYS_COL_PORTS * sizeof(uint16_t);
+  p_cfg->RepeatBlockConfig.RepeatCount      = 2 * sweeps * MATRIX_ROWS;
+  p_cfg->RepeatBlockConfig.SrcAddrOffset    = (int32_t)((uint32_t)keys_matrix_desc.col_port[1] - (uint32_t)keys_matrix_desc.col_port[0]);
+  p_cfg->RepeatBlockConfig.DestAddrOffset   = 0;
+  p_cfg->RepeatBlockConfig.BlkSrcAddrOffset = -(int32_t)((KEYS_COL_PORTS - 1) * p_cfg->RepeatBlockConfig.SrcAddrOffset);
+  p_cfg->RepeatBlockConfig.BlkDestAddrOffset = 0;
+#endif
+}
+
 bool keysIsBusy(void)
 {
   return false;
@@ -307,25 +517,64 @@ bool keysReadBuf(uint8_t *p_data, uint32_t length)
   return true;
 }
 
-bool keysReadColsBuf(uint16_t *p_data, uint32_t rows_cnt)
+bool keysReadColsBuf(keys_col_t *p_data, uint32_t rows_cnt)
 {
-  memcpy(p_data, (const void *)col_rd_buf, rows_cnt * sizeof(uint16_t));
-  return true;
+  return keysReadFrame(p_data, rows_cnt, NULL, NULL);                 // V261017R4: 게시된 완결 프레임만 복사
 }
 
-const volatile uint16_t *keysPeekColsBuf(void)
+const volatile keys_col_t *keysPeekColsBuf(void)
 {
-  return col_rd_buf;  // V250924R5: DMA 수집 버퍼를 직접 노출하여 추가 복사 없이 스캔 상태를 참조 (재검토: volatile 접근으로 안정성 확보)
+  return col_frame_buf[col_frame_seq & 1];  // V261017R4: DMA 기록 중인 버퍼 대신 최근 게시 프레임을 노출
+}
+
+uint32_t keysGetFrameSeq(void)
+{
+  return col_frame_seq;
+}
+
+bool keysReadFrame(keys_col_t *p_data, uint32_t rows_cnt, uint32_t *p_seq, uint32_t *p_us)
+{
+  uint32_t seq;
+  uint32_t frame_us;
+
+  if (rows_cnt > MATRIX_ROWS)
+  {
+    rows_cnt = MATRIX_ROWS;
+  }
+
+  // V261017R4: 복사 중 ISR 이 두 번 이상 게시하면 같은 핑퐁 슬롯을 덮어쓸 수 있으므로 다시 읽는다.
+  do
+  {
+    seq = col_frame_seq;
+    __DMB();
+    memcpy(p_data, col_frame_buf[seq & 1], rows_cnt * sizeof(keys_col_t));
+    frame_us = col_frame_us[seq & 1];
+    __DMB();
+  } while ((uint32_t)(col_frame_seq - seq) >= 2U);
+
+  if (p_seq != NULL)
+  {
+    *p_seq = seq;
+  }
+  if (p_us != NULL)
+  {
+    *p_us = frame_us;
+  }
+  return seq != 0;
 }
 
 bool keysGetPressed(uint16_t row, uint16_t col)
 {
-  bool     ret = false;
-  uint16_t col_bit;
+  bool       ret = false;
+  keys_col_t col_bit;
 
-  col_bit = col_rd_buf[row];
+  if (row >= MATRIX_ROWS || col >= MATRIX_COLS)
+  {
+    return false;
+  }
+  col_bit = keysPeekColsBuf()[row];
 
-  if (col_bit & (1<<col))
+  if (col_bit & ((keys_col_t)1 << col))
   {
     ret = true;
   }
@@ -333,4 +582,281 @@ bool keysGetPressed(uint16_t row, uint16_t col)
   return ret;
 }
 
+bool keysSetOversample(uint8_t samples, keys_reduce_t reduce)
+{
+  if (samples == 0 || samples > KEYS_OVERSAMPLE_MAX || reduce >= KEYS_REDUCE_COUNT)
+  {
+    return false;
+  }
+
+  return keysApplyScan(samples, reduce, keys_scan_rate);
+}
+
+uint8_t keysGetOversample(void)
+{
+  return keys_oversample;
+}
+
+keys_reduce_t keysGetReduce(void)
+{
+  return keys_reduce;
+}
+
+bool keysSetScanRate(keys_scan_rate_t rate)
+{
+  if (rate >= KEYS_SCAN_RATE_COUNT)
+  {
+    return false;
+  }
+
+  return keysApplyScan(keys_oversample, keys_reduce, rate);
+}
+
+// V261021R2: 오버샘플/행 주기 적용. 절반 스윕 수가 그대로면 캡처를 멈추지 않고 값만 바꾼다
+//   (samples <= keys_sweeps_per_half 가 유지되므로 ISR 이 언제 읽어도 절반 안쪽만 본다).
+bool keysApplyScan(uint8_t samples, keys_reduce_t reduce, keys_scan_rate_t rate)
+{
+  uint32_t sweeps = keysCalcSweepsPerHalf(samples, keys_scan_row_us[rate] * MATRIX_ROWS);
+
+  if (htim16.Instance != NULL && sweeps != keys_sweeps_per_half)
+  {
+    return keysCaptureRestart(samples, reduce, rate);
+  }
+
+  keys_reduce          = reduce;
+  keys_oversample      = samples;
+  keys_sweeps_per_half = sweeps;
+  if (rate != keys_scan_rate)
+  {
+    keys_scan_rate = rate;
+    if (htim16.Instance != NULL)
+    {
+      __HAL_TIM_SET_AUTORELOAD(&htim16, keys_scan_period[rate]);
+      __HAL_TIM_SET_COUNTER(&htim16, 0);                              // 줄어든 ARR 를 지나친 카운터가 0xFFFF 까지 도는 것 방지
+    }
+  }
+  return true;
+}
+
+// V261021R2: TIM16 과 두 DMA 를 멈추고 캡처 노드를 새 절반 스윕 수로 다시 만든 뒤 행 0 부터 재시작한다.
+//   - 행 출력(CC1)과 열 캡처(Update) 인덱스가 어긋나지 않도록 두 채널을 함께 처음부터 시작한다.
+//   - DMA 요청 허용 비트를 껐다 켜서 정지 중 남은 TIM16 요청이 재시작 직후 처리되지 않게 한다.
+bool keysCaptureRestart(uint8_t samples, keys_reduce_t reduce, keys_scan_rate_t rate)
+{
+  DMA_NodeConfTypeDef NodeConfig = {0};
+  bool                ret        = true;
+
+
+  __HAL_TIM_DISABLE(&htim16);
+  __HAL_TIM_DISABLE_DMA(&htim16, TIM_DMA_CC1 | TIM_DMA_UPDATE);
+  HAL_DMA_Abort(&handle_GPDMA1_Capture);
+  HAL_DMA_Abort(&handle_GPDMA1_Channel1);
+
+  keys_reduce          = reduce;
+  keys_oversample      = samples;
+  keys_scan_rate       = rate;
+  keys_sweeps_per_half = keysCalcSweepsPerHalf(samples, keys_scan_row_us[rate] * MATRIX_ROWS);
+
+  keysBuildCaptureNode(&NodeConfig);
+  if (HAL_DMAEx_List_BuildNode(&NodeConfig, &Node_GPDMA1_Capture) != HAL_OK)
+  {
+    ret = false;
+  }
+
+  __HAL_TIM_SET_AUTORELOAD(&htim16, keys_scan_period[rate]);
+  __HAL_TIM_SET_COUNTER(&htim16, 0);                                  // 줄어든 ARR 를 지나친 카운터가 0xFFFF 까지 도는 것 방지
+  HAL_DMAEx_List_Start(&handle_GPDMA1_Channel1);
+  if (HAL_DMAEx_List_Start_IT(&handle_GPDMA1_Capture) != HAL_OK)
+  {
+    ret = false;
+  }
+  __HAL_TIM_ENABLE_DMA(&htim16, TIM_DMA_CC1 | TIM_DMA_UPDATE);
+  __HAL_TIM_ENABLE(&htim16);
+
+  if (ret != true)
+  {
+    logPrintf("[!] keys capture restart 실패\n");
+  }
+  return ret;
+}
+
+keys_scan_rate_t keysGetScanRate(void)
+{
+  return keys_scan_rate;
+}
+
+// V261021R1: 스캔 주파수는 matrix_scan() 이 새 프레임을 받는 빈도(HT/TC 게시 주기)로 보고한다.
+//   원시 스윕 주파수는 keysGetSweepFreqHz() 로 따로 노출한다.
+uint32_t keysGetScanFreqHz(void)
+{
+  return 1000000U / keysGetFramePeriodUs();
+}
+
+uint32_t keysGetSweepFreqHz(void)
+{
+  return 1000000U / (keys_scan_row_us[keys_scan_rate] * MATRIX_ROWS);
+}
+
+uint32_t keysGetFramePeriodUs(void)
+{
+  return keys_scan_row_us[keys_scan_rate] * MATRIX_ROWS * keys_sweeps_per_half;
+}
+
+// V261017R7: 한 행의 포트별 IDR 샘플을 열 구간 표에 따라 매트릭스 열 비트로 모은다.
+static inline keys_col_t keysPackRow(const uint16_t *p_port)
+{
+  keys_col_t row = 0;
+
+  if (keys_seg_direct)
+  {
+    return (keys_col_t)(p_port[0] & keys_seg_mask[0]);
+  }
+  for (uint32_t i=0; i<keys_matrix_desc.col_segs; i++)
+  {
+    const keys_col_seg_t *p_seg = &keys_col_seg[i];
+
+    row |= (keys_col_t)((p_port[p_seg->port] >> p_seg->pin_first) & keys_seg_mask[i]) << p_seg->col_first;
+  }
+  return row;
+}
+
+void keysPublishFrame(uint32_t half)
+{
+  uint32_t                 samples = keys_oversample;
+  keys_reduce_t            reduce  = keys_reduce;
+  uint32_t                 sweeps  = keys_sweeps_per_half;                                   // V261021R2: 가변 절반 크기
+  const volatile uint16_t *p_sweep = &col_dma_buf[(half * sweeps + sweeps - samples) * KEYS_SWEEP_SAMPLES];
+  uint32_t                 next    = col_frame_seq + 1;
+  keys_col_t              *p_dst   = col_frame_buf[next & 1];
+
+  if (next == 0)
+  {
+    next = 2;                                                         // 0 은 "프레임 없음" 으로 예약 (슬롯 패리티 유지)
+    p_dst = col_frame_buf[next & 1];
+  }
+
+  const keys_col_t *p_prev  = col_frame_buf[(next - 1) & 1];
+  keys_col_t        changed = 0;
+
+  for (uint32_t i=0; i<MATRIX_ROWS; i++)
+  {
+    uint16_t port_val[KEYS_COL_PORTS];
+
+    for (uint32_t k=0; k<KEYS_COL_PORTS; k++)
+    {
+      const volatile uint16_t *p_sample = &p_sweep[i * KEYS_COL_PORTS + k];
+
+      if (samples > 1)
+      {
+        port_val[k] = keysReduceSamples(p_sample, KEYS_SWEEP_SAMPLES, samples, reduce);  // V261017R6: 최근 N 스윕 축약
+      }
+      else
+      {
+        port_val[k] = *p_sample;
+      }
+    }
+    p_dst[i]  = keysPackRow(port_val);                                // V261017R7: 포트 샘플 → 매트릭스 열
+    changed  |= p_dst[i] ^ p_prev[i];                                 // V261017R5: 직전 프레임 대비 변화 검출
+  }
+  col_frame_us[next & 1] = micros();                                  // V261017R8: 키 엣지 시각의 기준 (해상도 = 프레임 주기)
+  __DMB();
+  col_frame_seq = next;
+
+#ifdef _USE_HW_IDLE
+  if (changed != 0)
+  {
+    idleSetEvent(IDLE_EVENT_KEYS);                                    // V261017R5: 변화가 있을 때만 메인 루프를 깨움
+  }
+#endif
+}
+
+void keysDmaHalfCpltCallback(DMA_HandleTypeDef *hdma)
+{
+  keysPublishFrame(0);
+}
+
+void keysDmaCpltCallback(DMA_HandleTypeDef *hdma)
+{
+  keysPublishFrame(1);
+}
+
+void KEYS_CAP_DMA_IRQHandler(void)
+{
+  HAL_DMA_IRQHandler(&handle_GPDMA1_Capture);
+}
+
+
+#if CLI_USE(HW_KEYS)
+// V261021R2: 현재 설정의 프레임 게시 주기가 8kHz(125us) 기준을 넘으면 알린다.
+static void cliKeysCheckFrame(void)
+{
+  if (keysGetFramePeriodUs() > KEYS_FRAME_MAX_US)
+  {
+    cliPrintf("[!] frame %lu us > %d us : 8kHz 미달 (oversample 또는 row period 를 줄이세요)\n",
+              keysGetFramePeriodUs(),
+              KEYS_FRAME_MAX_US);
+  }
+}
+
+void cliKeys(cli_args_t *args)
+{
+  bool ret = false;
+  const char *reduce_str[KEYS_REDUCE_COUNT] = {"majority", "and", "or"};
+
+
+  if (args->argc == 1 && args->isStr(0, "info"))
+  {
+    cliPrintf("oversample : %d (%s)\n", keys_oversample, reduce_str[keys_reduce]);
+    cliPrintf("row period : %d us\n", keys_scan_row_us[keys_scan_rate]);
+    cliPrintf("sweep freq : %lu Hz\n", keysGetSweepFreqHz());                 // V261021R1: 원시 스윕과 프레임 게시 빈도를 구분
+    cliPrintf("frame freq : %lu Hz (%lu us, %lu sweeps)\n", keysGetScanFreqHz(), keysGetFramePeriodUs(), keys_sweeps_per_half);
+    cliKeysCheckFrame();
+    cliPrintf("frame seq  : %lu\n", col_frame_seq);
+    cliPrintf("matrix     : %d x %d, col ports %d, segs %d (%s)\n",
+              MATRIX_ROWS,
+              MATRIX_COLS,
+              keys_matrix_desc.col_ports,
+              keys_matrix_desc.col_segs,
+              keys_seg_direct ? "direct" : "packed");
+    ret = true;
+  }
+
+  if (args->argc == 3 && args->isStr(0, "oversample"))
+  {
+    uint8_t samples = (uint8_t)args->getData(1);
+    uint8_t reduce  = (uint8_t)args->getData(2);
+
+    if (keysSetOversample(samples, (keys_reduce_t)reduce) != true)
+    {
+      cliPrintf("invalid : samples 1~%d, reduce 0~%d\n", KEYS_OVERSAMPLE_MAX, KEYS_REDUCE_COUNT - 1);
+    }
+    cliPrintf("oversample : %d (%s)\n", keys_oversample, reduce_str[keys_reduce]);
+    cliKeysCheckFrame();
+    ret = true;
+  }
+
+  if (args->argc == 2 && args->isStr(0, "rate"))
+  {
+    if (keysSetScanRate((keys_scan_rate_t)args->getData(1)) != true)
+    {
+      cliPrintf("invalid : rate 0~%d\n", KEYS_SCAN_RATE_COUNT - 1);
+    }
+    cliPrintf("row period : %d us, sweep %lu Hz, frame %lu Hz\n",
+              keys_scan_row_us[keys_scan_rate],
+              keysGetSweepFreqHz(),
+              keysGetScanFreqHz());
+    cliKeysCheckFrame();
+    ret = true;
+  }
+
+
+  if (ret == false)
+  {
+    cliPrintf("keys info\n");
+    cliPrintf("keys oversample [1~%d] [0:majority 1:and 2:or]\n", KEYS_OVERSAMPLE_MAX);
+    cliPrintf("keys rate [0:1us 1:2us 2:4us 3:8us]\n");
+  }
+}
+#endif
+
 #endif
@@ -0,0 +1,93 @@
+#include "keys.h"
+
+
+#ifdef _USE_HW_KEYS
+
+
+// ---------------------------------------------------------------------------
+// [Oversample Reduce] V261017R6
+//   - 한 행의 연속 스윕 샘플 count 개(간격 stride)를 열 비트 단위로 하나의 값으로 축약한다.
+//   - MAJORITY 는 열별 눌림 개수를 5비트 수직 카운터(비트 평면)로 누적한 뒤
+//     임계값(count/2 + 1)과 비트 병렬 비교하므로 16열을 한 번에 처리한다.
+//   - 레지스터 비의존 코드라 호스트 시뮬레이터도 같은 소스를 빌드한다.
+// ---------------------------------------------------------------------------
+#define KEYS_REDUCE_CNT_BITS      5                   // KEYS_OVERSAMPLE_MAX(16) 까지 표현
+
+
+
+
+// V261021R2: 오버샘플 수와 스윕 1회 시간(행 수 x 행 주기)으로 DMA 절반 버퍼의 스윕 수를 정한다.
+//   keys.c 가 캡처 노드를 다시 만들 때 쓰고, 시뮬레이터가 게시 주기 상한을 검증한다.
+uint32_t keysCalcSweepsPerHalf(uint32_t samples, uint32_t sweep_us)
+{
+  if (samples == 0 || sweep_us == 0)
+  {
+    return 1;
+  }
+  return KEYS_SWEEPS_PER_HALF_CALC(samples, sweep_us);
+}
+
+uint16_t keysReduceSamples(const volatile uint16_t *p_sample, uint32_t stride, uint32_t count, keys_reduce_t reduce)
+{
+  uint16_t ret;
+
+  if (count == 0)
+  {
+    return 0;
+  }
+
+  switch (reduce)
+  {
+    case KEYS_REDUCE_AND:
+      ret = 0xFFFF;
+      for (uint32_t i=0; i<count; i++)
+      {
+        ret &= p_sample[i * stride];
+      }
+      break;
+
+    case KEYS_REDUCE_OR:
+      ret = 0;
+      for (uint32_t i=0; i<count; i++)
+      {
+        ret |= p_sample[i * stride];
+      }
+      break;
+
+    default:
+    {
+      uint16_t plane[KEYS_REDUCE_CNT_BITS] = {0, };
+      uint32_t threshold = count / 2 + 1;
+      uint16_t gt = 0;
+      uint16_t eq = 0xFFFF;
+
+      for (uint32_t i=0; i<count; i++)
+      {
+        uint16_t carry = p_sample[i * stride];
+
+        for (uint32_t b=0; b<KEYS_REDUCE_CNT_BITS && carry != 0; b++)
+        {
+          uint16_t next = plane[b] & carry;
+
+          plane[b] ^= carry;
+          carry      = next;
+        }
+      }
+
+      // 상위 비트부터 count >= threshold 를 열별로 판정
+      for (int32_t b=KEYS_REDUCE_CNT_BITS-1; b>=0; b--)
+      {
+        uint16_t t = ((threshold >> b) & 1U) ? 0xFFFF : 0;
+
+        gt |= eq & plane[b] & (uint16_t)~t;
+        eq &= (uint16_t)~(plane[b] ^ t);
+      }
+      ret = gt | eq;
+      break;
+    }
+  }
+
+  return ret;
+}
+
+#endif
@@ -0,0 +1,305 @@
+#include "latency.h"
+
+
+#ifdef _USE_HW_LATENCY
+#include "cli.h"
+
+
+// ---------------------------------------------------------------------------
+// [Latency] V261019R2
+//   - usbd_hid_instrumentation.c 의 key_time_log 는 계측 빌드에서 리포트 제출 → IN 완료만 보여 준다.
+//     여기서는 릴리스 빌드에서도 DMA 캡처 → 디바운스 → action_exec → host send → LL Transmit → DataIn
+//     각 구간을 반 옥타브 로그 히스토그램으로 누적한다.
+//   - 지점 기록은 틱 1회 읽기 + 비교 1회이고, 나눗셈/구간 계산은 latencyUpdate() 에서만 한다.
+//   - 앞 지점에 도달하지 못한 샘플은 새 디바운스 확정이 오면 버린다 (레이어/탭 홀드처럼 리포트가 없는 입력).
+//     HOST 이후 샘플은 끝날 때까지 유지하고, HW_LATENCY_TIMEOUT_MS 를 넘기면 버린다.
+// ---------------------------------------------------------------------------
+#define LATENCY_POINT_IDLE        LATENCY_POINT_MAX
+
+
+static uint32_t        (*lat_tick_func)(void) = NULL;
+static uint32_t          lat_tick_per_us = 1;
+static uint32_t          lat_timeout_tick = 0;
+static bool              lat_enable = false;
+static volatile uint8_t  lat_point  = LATENCY_POINT_IDLE;    // 마지막으로 기록한 지점
+static uint32_t          lat_tick[LATENCY_POINT_MAX];
+static uint32_t          lat_sample_cnt  = 0;
+static uint32_t          lat_abandon_cnt = 0;
+static latency_hist_t    lat_hist[LATENCY_STAGE_MAX];
+
+static const char *lat_stage_name[LATENCY_STAGE_MAX] =
+{
+  "capture>debounce",
+  "debounce>action",
+  "action>host",
+  "host>tx",
+  "tx>done",
+  "total",
+};
+
+static void latencyHistAdd(latency_hist_t *p_hist, uint32_t tick);
+static uint32_t latencyBin(uint32_t tick);
+
+
+
+
+bool latencyInit(uint32_t (*tick_func)(void), uint32_t tick_per_us)
+{
+  lat_tick_func    = tick_func;
+  lat_tick_per_us  = tick_per_us > 0 ? tick_per_us : 1;
+  lat_timeout_tick = HW_LATENCY_TIMEOUT_MS * 1000U * lat_tick_per_us;
+  lat_enable       = HW_LATENCY_ENABLE_DEFAULT ? true : false;
+  latencyClear();
+
+  logPrintf("[OK] latencyInit()\n");
+  logPrintf("     probe : %s, %lu tick/us\n", lat_enable ? "ON" : "OFF", (unsigned long)lat_tick_per_us);
+  return true;
+}
+
+void latencySetEnable(bool enable)
+{
+  lat_point  = LATENCY_POINT_IDLE;
+  lat_enable = enable;
+}
+
+bool latencyIsEnabled(void)
+{
+  return lat_enable;
+}
+
+void latencyBegin(uint32_t age_us)
+{
+  uint8_t point = lat_point;
+
+  if (lat_enable != true)
+  {
+    return;
+  }
+  if (point >= LATENCY_POINT_HOST && point < LATENCY_POINT_DONE)
+  {
+    return;                                           // 리포트 전송 중인 샘플은 끝까지 둔다
+  }
+  if (point == LATENCY_POINT_DONE)
+  {
+    latencyUpdate();
+  }
+  else if (point != LATENCY_POINT_IDLE)
+  {
+    lat_abandon_cnt++;
+  }
+
+  uint32_t now = lat_tick_func();
+
+  lat_tick[LATENCY_POINT_DEBOUNCE] = now;
+  lat_tick[LATENCY_POINT_CAPTURE]  = now - age_us * lat_tick_per_us;
+  __DMB();
+  lat_point = LATENCY_POINT_DEBOUNCE;
+}
+
+void latencyMark(latency_point_t point)
+{
+  if (lat_point + 1U != (uint32_t)point)
+  {
+    return;
+  }
+  lat_tick[point] = lat_tick_func();
+  __DMB();
+  lat_point = (uint8_t)point;
+}
+
+void latencyUpdate(void)
+{
+  uint8_t point = lat_point;
+
+  if (point == LATENCY_POINT_IDLE)
+  {
+    return;
+  }
+  if (point != LATENCY_POINT_DONE)
+  {
+    if (lat_tick_func() - lat_tick[LATENCY_POINT_DEBOUNCE] > lat_timeout_tick)
+    {
+      lat_point = LATENCY_POINT_IDLE;
+      lat_abandon_cnt++;
+    }
+    return;
+  }
+
+  for (uint32_t i=0; i<LATENCY_STAGE_TOTAL; i++)
+  {
+    latencyHistAdd(&lat_hist[i], lat_tick[i + 1] - lat_tick[i]);
+  }
+  latencyHistAdd(&lat_hist[LATENCY_STAGE_TOTAL], lat_tick[LATENCY_POINT_DONE] - lat_tick[LATENCY_POINT_CAPTURE]);
+  lat_sample_cnt++;
+  lat_point = LATENCY_POINT_IDLE;
+}
+
+void latencyClear(void)
+{
+  lat_point = LATENCY_POINT_IDLE;
+  memset(lat_hist, 0, sizeof(lat_hist));
+  for (uint32_t i=0; i<LATENCY_STAGE_MAX; i++)
+  {
+    lat_hist[i].min_tick = UINT32_MAX;
+  }
+  lat_sample_cnt  = 0;
+  lat_abandon_cnt = 0;
+}
+
+const latency_hist_t *latencyGetHist(latency_stage_t stage)
+{
+  if (stage >= LATENCY_STAGE_MAX)
+  {
+    return NULL;
+  }
+  return &lat_hist[stage];
+}
+
+uint32_t latencyGetSampleCount(void)
+{
+  return lat_sample_cnt;
+}
+
+uint32_t latencyGetAbandonCount(void)
+{
+  return lat_abandon_cnt;
+}
+
+uint32_t latencyGetTickPerUs(void)
+{
+  return lat_tick_per_us;
+}
+
+const char *latencyStageName(latency_stage_t stage)
+{
+  return stage < LATENCY_STAGE_MAX ? lat_stage_name[stage] : "?";
+}
+
+uint32_t latencyTickToNs(uint32_t tick)
+{
+  uint64_t ns = (uint64_t)tick * 1000U / lat_tick_per_us;
+
+  return ns < UINT32_MAX ? (uint32_t)ns : UINT32_MAX;
+}
+
+// 구간 b 는 [하한(b), 하한(b + 1)) 틱. 0~3 은 1틱 단위, 그 위는 옥타브마다 2개
+static uint32_t latencyBinLowerTick(uint32_t bin)
+{
+  if (bin < 4)
+  {
+    return bin;
+  }
+  uint32_t msb = bin / 2;
+
+  return (1UL << msb) | ((bin & 1U) << (msb - 1U));
+}
+
+uint32_t latencyBinUpperTick(uint32_t bin)
+{
+  if (bin + 1U >= LATENCY_HIST_BINS)
+  {
+    return UINT32_MAX;
+  }
+  return latencyBinLowerTick(bin + 1U) - 1U;
+}
+
+static uint32_t latencyBin(uint32_t tick)
+{
+  if (tick < 4)
+  {
+    return tick;
+  }
+  uint32_t msb = 31U - (uint32_t)__builtin_clz(tick);
+
+  return msb * 2U + ((tick >> (msb - 1U)) & 1U);
+}
+
+static void latencyHistAdd(latency_hist_t *p_hist, uint32_t tick)
+{
+  p_hist->cnt++;
+  p_hist->sum_tick += tick;
+  if (tick < p_hist->min_tick)
+  {
+    p_hist->min_tick = tick;
+  }
+  if (tick > p_hist->max_tick)
+  {
+    p_hist->max_tick = tick;
+  }
+  p_hist->bin[latencyBin(tick)]++;
+}
+
+uint32_t latencyGetPercentileNs(latency_stage_t stage, uint32_t permille)
+{
+  const latency_hist_t *p_hist = latencyGetHist(stage);
+  uint64_t              target;
+  uint64_t              acc = 0;
+
+  if (p_hist == NULL || p_hist->cnt == 0)
+  {
+    return 0;
+  }
+  target = ((uint64_t)p_hist->cnt * permille + 999U) / 1000U;
+  for (uint32_t i=0; i<LATENCY_HIST_BINS; i++)
+  {
+    acc += p_hist->bin[i];
+    if (acc >= target && acc > 0)
+    {
+      uint32_t upper = latencyBinUpperTick(i);
+
+      return latencyTickToNs(upper < p_hist->max_tick ? upper : p_hist->max_tick);
+    }
+  }
+  return latencyTickToNs(p_hist->max_tick);
+}
+
+void latencyPrintInfo(void)
+{
+#ifdef _USE_HW_CLI
+  cliPrintf("Latency   : %s, samples %lu, abandoned %lu (us: avg / p50 / p99 / max)\n",
+            lat_enable ? "on" : "off",
+            (unsigned long)lat_sample_cnt,
+            (unsigned long)lat_abandon_cnt);
+  for (uint32_t i=0; i<LATENCY_STAGE_MAX; i++)
+  {
+    const latency_hist_t *p_hist = &lat_hist[i];
+    uint32_t              avg_ns = p_hist->cnt > 0 ? latencyTickToNs((uint32_t)(p_hist->sum_tick / p_hist->cnt)) : 0;
+    uint32_t              p50_ns = latencyGetPercentileNs((latency_stage_t)i, 500);
+    uint32_t              p99_ns = latencyGetPercentileNs((latency_stage_t)i, 990);
+    uint32_t              max_ns = latencyTickToNs(p_hist->max_tick);
+
+    cliPrintf("  %-16s : %5lu.%02lu / %5lu.%02lu / %5lu.%02lu / %5lu.%02lu\n",
+              lat_stage_name[i],
+              (unsigned long)(avg_ns / 1000U), (unsigned long)(avg_ns % 1000U / 10U),
+              (unsigned long)(p50_ns / 1000U), (unsigned long)(p50_ns % 1000U / 10U),
+              (unsigned long)(p99_ns / 1000U), (unsigned long)(p99_ns % 1000U / 10U),
+              (unsigned long)(max_ns / 1000U), (unsigned long)(max_ns % 1000U / 10U));
+  }
+#endif
+}
+
+void latencyPrintHist(latency_stage_t stage)
+{
+#ifdef _USE_HW_CLI
+  const latency_hist_t *p_hist = latencyGetHist(stage);
+
+  if (p_hist == NULL)
+  {
+    return;
+  }
+  cliPrintf("%s : %lu samples\n", lat_stage_name[stage], (unsigned long)p_hist->cnt);
+  for (uint32_t i=0; i<LATENCY_HIST_BINS; i++)
+  {
+    if (p_hist->bin[i] == 0)
+    {
+      continue;
+    }
+    uint32_t lo_ns = latencyTickToNs(latencyBinLowerTick(i));
+    uint32_t hi_ns = latencyTickToNs(latencyBinUpperTick(i));
+
+    cliPrintf("  %8lu ~ %8lu ns : %lu\n", (unsigned long)lo_ns, (unsigned long)hi_ns, (unsigned long)p_hist->bin[i]);
+  }
+#endif
+}
+
+#endif
@@ -23,6 +23,8 @@
 #ifdef _USE_HW_USB
 #include "usbd_cmp.h"
 #include "usbd_hid.h"
+#include "usbd_hid_instrumentation.h"                                 // V261018R5: OTG ISR 사이클 집계
+#include "usb_reenum.h"                                               // V261018R8: 리셋 없는 재열거
 
 
 static bool      is_init = false;
@@ -71,6 +73,8 @@ static volatile struct
   uint32_t ready_ms;
 } usb_reset_request = {false, false, 0U};
 
+static usb_reenum_t usb_reenum;                                            // V261018R8: 폴링 모드 변경용 재열거 상태
+
 USBD_HandleTypeDef USBD_Device;                                            // V251123R6: USB_MONITOR_ENABLE 비활성 빌드에서도 전역 선언 유지
 extern PCD_HandleTypeDef hpcd_USB_OTG_HS;
 
@@ -133,6 +137,7 @@ static uint8_t hid_ep_tbl[] = {
   HID_VIA_EP_IN, 
   HID_VIA_EP_OUT,
   HID_EXK_EP_IN,
+  HID_NKRO_EP_IN,                                                    // V261018R1
   };
 
 static uint8_t cdc_ep_tbl[] = {
@@ -223,6 +228,23 @@ bool usbBootModeSaveAndReset(UsbBootMode_t mode)
 
   return usbScheduleGraceReset(USB_BOOTMODE_APPLY_GRACE_MS);              // V251109R4: VIA 응답 송신 후 리셋
 }
+
+// V261018R8: 저장 후 MCU 리셋 대신 USB 만 다시 열거한다. 재열거를 쓸 수 없으면 기존 리셋 경로.
+bool usbBootModeSaveAndApply(UsbBootMode_t mode)
+{
+  if (usbBootModeStore(mode) != true)
+  {
+    return false;
+  }
+
+#if HW_USB_SOFT_REENUM == 1
+  if (is_init == true && usb_reset_request.pending != true)
+  {
+    return usbReEnumRequest(&usb_reenum, (uint8_t)is_usb_mode, millis(), USB_BOOTMODE_APPLY_GRACE_MS);
+  }
+#endif
+  return usbScheduleGraceReset(USB_BOOTMODE_APPLY_GRACE_MS);
+}
 #endif
 
 #ifdef BOOTMODE_ENABLE
@@ -349,7 +371,7 @@ static void usbProcessBootModeApply(void)
     return;
   }
 
-  if (usbBootModeSaveAndReset(req_mode) != true)
+  if (usbBootModeSaveAndApply(req_mode) != true)                        // V261018R8
   {
     logPrintf("[!] USB BootMode apply 실패\n");
   }
@@ -394,11 +416,11 @@ static void usbProcessBootModeDowngrade(void)
         boot_mode_request.log_pending = false;
       }
 
-      if (usbBootModeSaveAndReset(boot_mode_request.next_mode) != true)
+      if (usbBootModeSaveAndApply(boot_mode_request.next_mode) != true)                       // V261018R8: 리셋 없이 재열거
       {
         logPrintf("[!] USB Poll 모드 저장 실패\n");                                            // V250924R2 저장 실패 로그
       }
-      else
+      else if (usb_reset_request.pending == true)
       {
         usb_reset_request.from_monitor = true;                                                // V251124R3: 토글 비활성화 시 중단 가능하도록 표시
       }
@@ -437,6 +459,37 @@ static void usbProcessDeferredReset(void)
   resetToReset();                                                        // V251109R4: VIA 응답 송신 이후에만 리셋 실행
 }
 
+// V261018R8: 유예/분리 대기는 비차단으로 나누고, CONFIGURED 후 눌린 키를 다시 보낸다.
+static void usbProcessReEnum(void)
+{
+  switch (usbReEnumStep(&usb_reenum, millis(), usbIsConnect()))
+  {
+    case USB_REENUM_ACT_DETACH:
+      USBD_Stop(&USBD_Device);
+      USBD_DeInit(&USBD_Device);
+      is_init     = false;
+      is_usb_mode = USB_NON_MODE;
+      break;
+
+    case USB_REENUM_ACT_ATTACH:
+      usbBegin((UsbMode_t)usb_reenum.usb_mode);
+      break;
+
+    case USB_REENUM_ACT_RESEND:
+      usbHidResendReports();
+      logPrintf("[  ] USB ReEnum : %s, enum %lu ms\n", usbBootModeLabel(usbBootModeGet()), usb_reenum.enum_ms);
+      break;
+
+    case USB_REENUM_ACT_TIMEOUT:
+      logPrintf("[!] USB ReEnum timeout -> reset\n");
+      usbScheduleGraceReset(1U);
+      break;
+
+    default:
+      break;
+  }
+}
+
 static bool usbHasPendingService(bool has_apply_request, bool has_monitor_request, bool has_reset_request)
 {
 #if defined(BOOTMODE_ENABLE) && !defined(USB_MONITOR_ENABLE)
@@ -446,7 +499,8 @@ static bool usbHasPendingService(bool has_apply_request, bool has_monitor_reques
 #if defined(BOOTMODE_ENABLE) && defined(USB_MONITOR_ENABLE)
          || has_monitor_request
 #endif
-         || has_reset_request;
+         || has_reset_request
+         || usbReEnumIsBusy(&usb_reenum);
 }
 
 void usbDebugGetState(usb_debug_state_t *state)                               // V251123R7: USB 모니터/리셋 상태 스냅샷
@@ -506,6 +560,21 @@ void usbProcess(void)
   {
     usbProcessDeferredReset();
   }
+  if (usbReEnumIsBusy(&usb_reenum) == true)
+  {
+    usbProcessReEnum();
+  }
+}
+
+// V261018R8: 키보드 EP IN 완료 (usbd_hid.c DataIn). 부팅/재열거 후 첫 리포트 시각을 남긴다.
+void usbOnKeyboardReportSent(void)
+{
+  usbReEnumOnReport(&usb_reenum, millis());
+}
+
+uint32_t usbGetBootReportMs(void)
+{
+  return usb_reenum.boot_report_ms;                                 // V261019R5: 부팅 타임라인 로그
 }
 
 #ifdef USB_MONITOR_ENABLE
@@ -559,10 +628,16 @@ bool usbInit(void)
 #if defined(BOOTMODE_ENABLE) && defined(USB_MONITOR_ENABLE)
   usbBootModeRequestReset();                                          // V251108R1: 모니터 활성 시에만 다운그레이드 큐 초기화
 #endif
+  usbReEnumInit(&usb_reenum, USB_RESET_DETACH_DELAY_MS, HW_USB_REENUM_TIMEOUT_MS);  // V261018R8
 #endif
 #ifdef _USE_HW_CLI
   cliAdd("usb", cliCmd);
   cliAdd("boot", cliBoot);                                    // V250923R1 Expose boot mode control
+#endif
+#if _DEF_ENABLE_USB_HID_TIMING_PROBE
+  CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;                     // V261018R5: OTG ISR 사이클 측정용 DWT 카운터
+  DWT->LAR          = 0xC5ACCE55;
+  DWT->CTRL        |= DWT_CTRL_CYCCNTENA_Msk;
 #endif
   return true;
 }
@@ -645,6 +720,7 @@ bool usbBegin(UsbMode_t usb_mode)
   {
     #if HW_USB_CMP == 1
     USBD_Init(&USBD_Device, &CMP_Desc, DEVICE_HS);
+    USBD_CMPST_ClearConfDesc(&USBD_Device);                                             // V261020R6: 재열거 시 구성 디스크립터가 뒤에 이어 붙지 않도록 크기 초기화
 
 
     /* Add Supported Class */
@@ -736,7 +812,14 @@ UsbType_t usbGetType(void)
 
 void OTG_HS_IRQHandler(void)
 {
+#if _DEF_ENABLE_USB_HID_TIMING_PROBE
+  uint32_t cycle_begin = DWT->CYCCNT;                                 // V261018R5: PIO/DMA ISR 비용 비교
+
+  HAL_PCD_IRQHandler(&hpcd_USB_OTG_HS);
+  usbHidInstrumentationOnOtgIsr(DWT->CYCCNT - cycle_begin);
+#else
   HAL_PCD_IRQHandler(&hpcd_USB_OTG_HS);
+#endif
 }
 
 
@@ -831,9 +914,41 @@ void cliCmd(cli_args_t *args)
   }
 #endif
 
+  // V261018R5: OTG DMA 버퍼 경로 통계
+  if (args->argc == 1 && args->isStr(0, "dma") == true)
+  {
+    usbd_dma_info_t info;
+
+    USBD_DMA_GetInfo(&info);
+    cliPrintf("USB DMA     : %s\n", info.enable ? "on" : "off (PIO)");
+    cliPrintf("  tx        : direct %lu, bounce %lu, clean %lu\n",
+              (unsigned long)info.tx_direct, (unsigned long)info.tx_bounce, (unsigned long)info.tx_clean);
+    cliPrintf("  rx        : direct %lu, bounce %lu\n",
+              (unsigned long)info.rx_direct, (unsigned long)info.rx_bounce);
+    cliPrintf("  reject    : %lu\n", (unsigned long)info.reject);
+    ret = true;
+  }
+
+  // V261018R8: 재열거/리셋 경로의 첫 리포트까지 시간
+  if (args->argc == 1 && args->isStr(0, "reenum") == true)
+  {
+    uint32_t reset_ms = USB_BOOTMODE_APPLY_GRACE_MS + USB_RESET_DETACH_DELAY_MS + usb_reenum.boot_report_ms;
+
+    cliPrintf("USB ReEnum  : %s\n", HW_USB_SOFT_REENUM == 1 ? "soft" : "reset");
+    cliPrintf("  count     : %lu, timeout %lu\n", (unsigned long)usb_reenum.count, (unsigned long)usb_reenum.timeout_cnt);
+    cliPrintf("  soft      : first report %lu ms (attach -> configured %lu ms)\n",
+              (unsigned long)usb_reenum.first_report_ms, (unsigned long)usb_reenum.enum_ms);
+    cliPrintf("  reset     : grace %u + detach %u + boot -> first report %lu = %lu ms\n",
+              USB_BOOTMODE_APPLY_GRACE_MS, USB_RESET_DETACH_DELAY_MS,
+              (unsigned long)usb_reenum.boot_report_ms, (unsigned long)reset_ms);
+    ret = true;
+  }
+
   if (ret == false)
   {
     cliPrintf("usb info\n");
+    cliPrintf("usb dma\n");                                           // V261018R5
+    cliPrintf("usb reenum\n");                                        // V261018R8
     #if HW_USB_CDC == 1
     cliPrintf("usb tx\n");
     cliPrintf("usb rx\n");
@@ -851,7 +966,7 @@ void cliBoot(cli_args_t *args)
     ret = true;
   }
 
-  if (args->argc == 2 && args->isStr(0, "set") == true)
+  if ((args->argc == 2 || args->argc == 3) && args->isStr(0, "set") == true)
   {
     UsbBootMode_t req_mode = USB_BOOT_MODE_MAX;
 
@@ -875,7 +990,9 @@ void cliBoot(cli_args_t *args)
     if (req_mode < USB_BOOT_MODE_MAX)
     {
       cliPrintf("Boot Mode   : %s -> %s\n", usbBootModeLabel(usbBootModeGet()), usbBootModeLabel(req_mode));
-      if (usbBootModeSaveAndReset(req_mode) != true)
+      bool use_reset = args->argc == 3 && args->isStr(2, "reset") == true;   // V261018R8: 리셋 경로 비교용
+
+      if ((use_reset ? usbBootModeSaveAndReset(req_mode) : usbBootModeSaveAndApply(req_mode)) != true)
       {
         cliPrintf("Boot mode save failed\n");
       }
@@ -890,6 +1007,7 @@ void cliBoot(cli_args_t *args)
     cliPrintf("boot set 4k\n");
     cliPrintf("boot set 2k\n");
     cliPrintf("boot set 1k\n");
+    cliPrintf("boot set 8k|4k|2k|1k reset\n");                       // V261018R8
   }
 }
 #endif
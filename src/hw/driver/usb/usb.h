@@ -96,6 +96,7 @@ uint8_t       usbBootModeGetHsInterval(void);           // V250923R1 Retrieve HS
 bool          usbBootModeStore(UsbBootMode_t mode);     // V251108R1 VIA BootMode 저장 공개
 void          usbBootModeApplyDefaults(void);           // V251112R5 EEPROM 초기화용 기본값 적용
 bool          usbBootModeSaveAndReset(UsbBootMode_t mode);
+bool          usbBootModeSaveAndApply(UsbBootMode_t mode);  // V261018R8: 저장 후 리셋 없이 USB 재열거
 bool          usbBootModeScheduleApply(UsbBootMode_t mode);  // V251108R3: 인터럽트 문맥에서 리셋을 defer
 usb_boot_downgrade_result_t usbRequestBootModeDowngrade(UsbBootMode_t mode,
                                                         uint32_t      measured_delta_us,
@@ -143,6 +144,12 @@ static inline bool usbBootModeSaveAndReset(UsbBootMode_t mode)
   return false;
 }
 
+static inline bool usbBootModeSaveAndApply(UsbBootMode_t mode)
+{
+  (void)mode;
+  return false;
+}
+
 static inline bool usbBootModeScheduleApply(UsbBootMode_t mode)
 {
   (void)mode;
@@ -204,6 +211,8 @@ static inline void usb_monitor_init(void)
 
 void usbProcess(void);                                  // V250924R2 USB 안정성 모니터 서비스 루프
 bool usbScheduleGraceReset(uint32_t delay_ms);          // V251109R4 VIA 응답 송신 보장용 리셋 요청
+void usbOnKeyboardReportSent(void);                     // V261018R8 키보드 EP IN 완료 통지 (OTG ISR)
+uint32_t usbGetBootReportMs(void);                      // V261019R5 부팅 → 첫 리포트 IN 완료 (0 = 아직)
 
 bool usbInit(void);
 bool usbBegin(UsbMode_t usb_mode);
@@ -21,7 +21,7 @@
 
 /* Includes ------------------------------------------------------------------*/
 #include "usbd_cdc_if.h"
-#include "qbuffer.h"
+#include "qring.h"                                 // V261017R9: SOF/RX ISR <-> 메인 루프 SPSC 링
 
 
 
@@ -38,13 +38,13 @@ USBD_CDC_LineCodingTypeDef LineCoding =
 
 
 uint8_t CDC_Reset_Status = 0;
-uint8_t UserRxBufferFS[APP_RX_DATA_SIZE + 1];
-uint8_t UserTxBufferFS[APP_TX_DATA_SIZE + 1];
+USBD_DMA_BUF uint8_t UserRxBufferFS[APP_RX_DATA_SIZE + 1];         // V261018R5: DMA 빌드 시 비캐시 배치
+USBD_DMA_BUF uint8_t UserTxBufferFS[APP_TX_DATA_SIZE + 1];
 
 
 
-static qbuffer_t q_rx;
-static qbuffer_t q_tx;
+static qring_t q_rx;
+static qring_t q_tx;
 
 static uint8_t q_rx_buf[2048];
 static uint8_t q_tx_buf[2048];
@@ -79,22 +79,22 @@ USBD_CDC_ItfTypeDef USBD_CDC_fops =
 bool cdcIfInit(void)
 {
   is_opened = false;
-  qbufferCreate(&q_rx, q_rx_buf, 2048);
-  qbufferCreate(&q_tx, q_tx_buf, 2048);
+  qringCreate(&q_rx, q_rx_buf, 1, sizeof(q_rx_buf));
+  qringCreate(&q_tx, q_tx_buf, 1, sizeof(q_tx_buf));
 
   return true;
 }
 
 uint32_t cdcIfAvailable(void)
 {
-  return qbufferAvailable(&q_rx);
+  return qringAvailable(&q_rx);
 }
 
 uint8_t cdcIfRead(void)
 {
   uint8_t ret = 0;
 
-  qbufferRead(&q_rx, &ret, 1);
+  qringRead(&q_rx, &ret, 1);
 
   return ret;
 }
@@ -115,7 +115,7 @@ uint32_t cdcIfWrite(uint8_t *p_data, uint32_t length)
   pre_time = millis();
   while(sent_len < length)
   {
-    buf_len = (q_tx.len - qbufferAvailable(&q_tx)) - 1;
+    buf_len = qringFree(&q_tx);
     tx_len = length - sent_len;
 
     if (tx_len > buf_len)
@@ -125,7 +125,7 @@ uint32_t cdcIfWrite(uint8_t *p_data, uint32_t length)
 
     if (tx_len > 0)
     {
-      qbufferWrite(&q_tx, p_data, tx_len);
+      qringWrite(&q_tx, p_data, tx_len);
       p_data += tx_len;
       sent_len += tx_len;
     }
@@ -193,7 +193,7 @@ uint8_t CDC_SoF_ISR(struct _USBD_HandleTypeDef *pdev)
   {
     uint32_t buf_len;
 
-    buf_len = (q_rx.len - qbufferAvailable(&q_rx)) - 1;
+    buf_len = qringFree(&q_rx);
 
     if (buf_len >= CDC_DATA_HS_MAX_PACKET_SIZE)
     {
@@ -207,7 +207,7 @@ uint8_t CDC_SoF_ISR(struct _USBD_HandleTypeDef *pdev)
   //-- TX
   //
   uint32_t tx_len;
-  tx_len = qbufferAvailable(&q_tx);
+  tx_len = qringAvailable(&q_tx);
 
   if (tx_len%CDC_DATA_HS_MAX_PACKET_SIZE == 0)
   {
@@ -222,7 +222,7 @@ uint8_t CDC_SoF_ISR(struct _USBD_HandleTypeDef *pdev)
     USBD_CDC_HandleTypeDef *hcdc = (USBD_CDC_HandleTypeDef*)pdev->pClassDataCmsit[pdev->classId];
     if (hcdc->TxState == 0)
     {
-      qbufferRead(&q_tx, UserTxBufferFS, tx_len);
+      qringRead(&q_tx, UserTxBufferFS, tx_len);
 
       #ifdef USE_USBD_COMPOSITE
       USBD_CDC_SetTxBuffer(pdev, UserTxBufferFS, tx_len, pdev->classId);
@@ -401,7 +401,7 @@ static int8_t CDC_Receive_FS(USBD_HandleTypeDef *pdev, uint8_t* Buf, uint32_t *L
   uint32_t i;
 
 
-  qbufferWrite(&q_rx, Buf, *Len);
+  qringWrite(&q_rx, Buf, *Len);
 
   if( CDC_Reset_Status == 1 )
   {
@@ -423,7 +423,7 @@ static int8_t CDC_Receive_FS(USBD_HandleTypeDef *pdev, uint8_t* Buf, uint32_t *L
 
   uint32_t buf_len;
 
-  buf_len = (q_rx.len - qbufferAvailable(&q_rx)) - 1;
+  buf_len = qringFree(&q_rx);
 
   if (buf_len >= CDC_DATA_HS_MAX_PACKET_SIZE)
   {
@@ -284,13 +284,14 @@ uint8_t  USBD_CMPSIT_AddToConfDesc(USBD_HandleTypeDef *pdev)
 
       /* Find the first available interface slot and Assign number of interfaces */
       idxIf = USBD_CMPSIT_FindFreeIFNbr(pdev);
-      pdev->tclasslist[pdev->classId].NumIf = 3U;
+      pdev->tclasslist[pdev->classId].NumIf = 4U;                       // V261018R1: NKRO 인터페이스 추가
       pdev->tclasslist[pdev->classId].Ifs[0] = idxIf;
       pdev->tclasslist[pdev->classId].Ifs[1] = (uint8_t)(idxIf + 1U);
       pdev->tclasslist[pdev->classId].Ifs[2] = (uint8_t)(idxIf + 2U);
+      pdev->tclasslist[pdev->classId].Ifs[3] = (uint8_t)(idxIf + 3U);
 
       /* Assign endpoint numbers */
-      pdev->tclasslist[pdev->classId].NumEps = 4U; 
+      pdev->tclasslist[pdev->classId].NumEps = 5U;                      // V261018R1: USBD_MAX_CLASS_ENDPOINTS(5) 까지 사용
 
       /* Set IN endpoint slot */
       iEp = pdev->tclasslist[pdev->classId].EpAdd[0];
@@ -308,6 +309,10 @@ uint8_t  USBD_CMPSIT_AddToConfDesc(USBD_HandleTypeDef *pdev)
       iEp = pdev->tclasslist[pdev->classId].EpAdd[3];
       USBD_CMPSIT_AssignEp(pdev, iEp, USBD_EP_TYPE_INTR, HID_EXK_EP_SIZE);
 
+      /* Set NKRO IN endpoint slot */
+      iEp = pdev->tclasslist[pdev->classId].EpAdd[4];
+      USBD_CMPSIT_AssignEp(pdev, iEp, USBD_EP_TYPE_INTR, HID_NKRO_EP_SIZE);
+
 
       /* Configure and Append the Descriptor */
       USBD_CMPSIT_HIDKeyboardDesc(pdev, (uint32_t)pCmpstFSConfDesc, &CurrFSConfDescSz, (uint8_t)USBD_SPEED_FULL);
@@ -936,6 +941,38 @@ static void  USBD_CMPSIT_HIDKeyboardDesc(USBD_HandleTypeDef *pdev, uint32_t pCon
   /* Update Config Descriptor and IAD descriptor */
   ((USBD_ConfigDescTypeDef *)pConf)->bNumInterfaces += 1U;
   ((USBD_ConfigDescTypeDef *)pConf)->wTotalLength  = (uint16_t)(*Sze);
+
+
+  // NKRO  V261018R1
+  //
+  /* Append HID Interface descriptor to Configuration descriptor */
+  __USBD_CMPSIT_SET_IF(pdev->tclasslist[pdev->classId].Ifs[3],
+                       0U,     /* bAlternateSetting: Alternate setting */
+                       1U,     /* bNumEndpoints */
+                       0x03U,  /* bInterfaceClass: HID */
+                       0x00U,  /* bInterfaceSubClass : 1=BOOT, 0=no boot */
+                       0x00U,  /* nInterfaceProtocol : 0=none, 1=keyboard, 2=mouse */
+                       0x00U); /* iInterface: Index of string descriptor */
+
+  /* Append HID Functional descriptor to Configuration descriptor */
+  pHidKeyboardDesc                      = ((USBD_HIDDescTypeDef *)(pConf + *Sze));
+  pHidKeyboardDesc->bLength             = (uint8_t)sizeof(USBD_HIDDescTypeDef);
+  pHidKeyboardDesc->bDescriptorType     = HID_DESCRIPTOR_TYPE;
+  pHidKeyboardDesc->bcdHID              = 0x0111U;
+  pHidKeyboardDesc->bCountryCode        = 0x00U;
+  pHidKeyboardDesc->bNumDescriptors     = 0x01U;
+  pHidKeyboardDesc->bHIDDescriptorType  = 0x22U;
+  pHidKeyboardDesc->wItemLength         = HID_NKRO_REPORT_DESC_SIZE;
+  *Sze                                 += (uint32_t)sizeof(USBD_HIDDescTypeDef);
+
+
+  /* Append Endpoint descriptor to Configuration descriptor */
+  __USBD_CMPSIT_SET_EP(pdev->tclasslist[pdev->classId].Eps[4].add, USBD_EP_TYPE_INTR, HID_NKRO_EP_SIZE, \
+                       usbBootModeGetHsInterval(), HID_FS_BINTERVAL);
+
+  /* Update Config Descriptor and IAD descriptor */
+  ((USBD_ConfigDescTypeDef *)pConf)->bNumInterfaces += 1U;
+  ((USBD_ConfigDescTypeDef *)pConf)->wTotalLength  = (uint16_t)(*Sze);
 }
 
 #if 0
@@ -48,11 +48,19 @@
 #include "cli.h"
 #include "log.h"
 #include "keys.h"
-#include "qbuffer.h"
+#include "idle.h"                                               // V261017R5: SOF 모니터 활성 시 메인 루프 깨움
+#include "qring.h"                                                  // V261017R9: ISR/메인 루프 간 SPSC 링
 #include "report.h"
 #include "micros.h"                                          // V251124R1: 백그라운드 모니터 래퍼에서 타임스탬프 취득
 #include "usbd_hid_internal.h"           // V251009R9: 계측 전용 상수를 공유
 #include "usbd_hid_instrumentation.h"    // V251009R9: HID 계측 로직을 전용 모듈로 이관
+#include "usbd_hid_coalesce.h"        // V261018R2: 키보드 리포트 상태 병합 큐
+#include "usbd_hid_jit.h"             // V261018R4: SOF 위상 고정 JIT 적재
+#include "usbd_hid_via.h"             // V261018R6: VIA RAW HID 파이프라인 전송
+#include "usbd_hid_tx.h"              // V261021R4: EP 상태 + 대기열 + 드레인 정책 (시뮬레이터와 공유)
+#include "usbd_hid_sof_mon.h"         // V261018R9: SOF 안정성 감시 (ISR 적재 + 메인 루프 일괄 평가)
+#include "usbd_hid_wakeup.h"          // V261019R1: 비차단 원격 깨우기 + 재개 전 리포트 보관
+#include "latency.h"                  // V261019R2: LL Transmit / IN 완료 지점
 
 
 #if HW_USB_LOG == 1
@@ -66,13 +74,7 @@
 #define logDebug(...) 
 #endif
 
-typedef enum                                                // V251109R2 다운그레이드 이벤트 구분
-{
-  USB_MONITOR_EVENT_SOF = 0,
-  USB_MONITOR_EVENT_ENUM,
-  USB_MONITOR_EVENT_SPEED,
-  USB_MONITOR_EVENT_SUSPEND
-} usb_monitor_event_t;
+#define HID_KEYBOARD_ITF_NBR      0U                    // V261020R3: Boot 키보드 인터페이스 (SET/GET_PROTOCOL 대상)
 
 
 static uint8_t USBD_HID_Init(USBD_HandleTypeDef *pdev, uint8_t cfgidx);
@@ -97,22 +99,23 @@ static uint8_t *USBD_HID_GetUsrStrDescriptor(struct _USBD_HandleTypeDef *pdev, u
 
 static void cliCmd(cli_args_t *args);
 static bool usbHidUpdateWakeUp(USBD_HandleTypeDef *pdev);
+static bool usbHidWakeUpHold(uint8_t ep_addr, uint8_t *p_data, uint16_t length);   // V261019R1
+static bool usbHidSendReportNow(uint8_t *p_data, uint16_t length);
+static bool usbHidSendReportEXKNow(uint8_t *p_data, uint16_t length);
+static bool usbHidSendReportNKRONow(uint8_t *p_data, uint16_t length);
 static void usbHidInitTimer(void);
+static bool usbHidEpTransmit(uint8_t ep_addr, uint8_t *report, uint16_t len);
+static uint16_t usbHidKeyboardReportLength(void);
 static uint32_t usbHidBackupTimerOffsetUs(void);                       // V251012R1 FS 백업 전송 지연 재조정
+static void     usbHidJitApplyCompare(void);                            // V261018R4
+static void     usbHidViaService(USBD_HandleTypeDef *pdev);              // V261018R6
 #ifdef USB_MONITOR_ENABLE
-static void usbHidMonitorSof(uint32_t now_us);                          // V250924R2 SOF 안정성 추적
-static void usbHidMonitorProcessDelta(uint32_t now_us, uint32_t delta_us);  // V251108R9 SOF 간격 평가
-static void usbHidMonitorPrimeTimeout(uint32_t now_us);                 // V251108R9 SOF 누락 타임아웃 갱신
-static bool usbHidMonitorCommitDowngrade(uint32_t      now_us,
-                                         uint32_t      delta_us,
-                                         uint32_t      expected_us,
-                                         usb_monitor_event_t event);    // V251109R2 공통 다운그레이드 처리
+static bool usbHidMonitorRequestDowngrade(uint32_t      now_us,
+                                          uint32_t      delta_us,
+                                          uint32_t      expected_us,
+                                          usb_monitor_event_t event);   // V261018R9 SOF 감시 모듈 → BootMode 다운그레이드 연결
 static void usbHidMonitorTrackEnumeration(uint32_t now_us,
                                           bool     monitor_enabled);    // V251109R1 열거 실패 감시
-static void usbHidMonitorHandleSpeedChange(uint32_t now_us);            // V251109R2 속도 변동 감시
-static void usbHidMonitorHandleSuspend(uint32_t now_us);                // V251109R2 서스펜드 감시
-static void usbHidMonitorBumpPersistent(uint32_t now_us, usb_monitor_event_t event); // V251109R2 persistent 점수
-static void usbHidMonitorRefreshEventWindows(uint32_t now_us);          // V251109R2 이벤트 윈도우 만료 처리
 static UsbBootMode_t usbHidResolveDowngradeTarget(void);                // V250924R2 다운그레이드 대상 계산
 void usbHidMonitorBackgroundTick(uint32_t now_us);                      // V251108R9 SOF 중단 감시
 #if HW_USB_LOG == 1
@@ -124,40 +127,25 @@ static const char *usbHidMonitorEventLabel(usb_monitor_event_t event);  // V2511
 
 
 
-typedef struct
-{
-  uint8_t  buf[HID_KEYBOARD_REPORT_SIZE];
-} report_info_t;
-
-typedef struct
-{
-  uint8_t  buf[32];
-} via_report_info_t;
-
-typedef struct
-{
-  uint8_t len;
-  uint8_t buf[HID_EXK_EP_SIZE];
-} exk_report_info_t;
+_Static_assert(sizeof(report_nkro_t) == HID_NKRO_EP_SIZE, "NKRO report must fill one NKRO EP packet.");
 
 static USBD_SetupReqTypedef ep0_req;
 static uint8_t ep0_req_buf[USB_MAX_EP0_SIZE];
 
-static qbuffer_t             via_report_q;
-static via_report_info_t     via_report_q_buf[128];
-static uint32_t              via_report_pre_time;
-static uint32_t              via_report_time = 20;
-__ALIGN_BEGIN static uint8_t via_hid_usb_report[32] __ALIGN_END;
-static void (*via_hid_receive_func)(uint8_t *data, uint8_t length) = NULL;
+static hid_via_t             via_report;                                        // V261018R6: 20ms 게이트 대신 IN 이 비는 즉시 전송
+__ALIGN_BEGIN static uint8_t via_hid_rx_report[HID_VIA_PACKET_SIZE] __ALIGN_END USBD_DMA_BUF;  // V261018R6: 요청을 여러 개 받으므로 RX/TX 버퍼 분리
+__ALIGN_BEGIN static uint8_t via_hid_tx_report[HID_VIA_PACKET_SIZE] __ALIGN_END USBD_DMA_BUF;
+static bool (*via_hid_receive_func)(uint8_t *data, uint8_t length) = NULL;   // V261020R4: 요청을 큐에 실었으면 true
 
 
-static qbuffer_t              report_q;
-static report_info_t          report_buf[128];
-__ALIGN_BEGIN  static uint8_t hid_buf[HID_KEYBOARD_REPORT_SIZE] __ALIGN_END = {0,};
+static hid_tx_t               hid_tx;                                          // V261021R4: EP 상태 + 키보드/EXK/NKRO 대기열 + JIT (usbd_hid_tx.c)
+__ALIGN_BEGIN  static uint8_t hid_buf[HID_KEYBOARD_REPORT_SIZE] __ALIGN_END USBD_DMA_BUF = {0,};   // V261018R5
 
-static qbuffer_t              report_exk_q;
-static exk_report_info_t      report_exk_buf[128];
-__ALIGN_BEGIN  static uint8_t hid_buf_exk[HID_EXK_EP_SIZE] __ALIGN_END = {0,};
+static bool                   hid_jit_enable = HW_USB_HID_JIT_DEFAULT;
+static hid_wakeup_t           hid_wakeup;                                      // V261019R1: 원격 깨우기 단계 + 재개 전 리포트 (usbd_hid_wakeup.c)
+
+__ALIGN_BEGIN  static uint8_t hid_buf_exk[HID_EXK_EP_SIZE] __ALIGN_END USBD_DMA_BUF = {0,};  // V261018R5
+__ALIGN_BEGIN  static uint8_t hid_buf_nkro[HID_NKRO_EP_SIZE] __ALIGN_END USBD_DMA_BUF = {0,};  // V261018R5
 
 
 
@@ -198,7 +186,7 @@ __ALIGN_BEGIN static uint8_t USBD_HID_CfgDesc[USB_HID_CONFIG_DESC_SIZ] __ALIGN_E
   USB_DESC_TYPE_CONFIGURATION,                        /* bDescriptorType: Configuration */
   USB_HID_CONFIG_DESC_SIZ,                            /* wTotalLength: Bytes returned */
   0x00,
-  0x03,                                               /* bNumInterfaces: 3 interface */
+  0x04,                                               /* bNumInterfaces: 4 interface */  // V261018R1: NKRO 인터페이스 추가
   0x01,                                               /* bConfigurationValue: Configuration value */
   0x00,                                               /* iConfiguration: Index of string descriptor
                                                          describing the configuration */
@@ -324,6 +312,41 @@ __ALIGN_BEGIN static uint8_t USBD_HID_CfgDesc[USB_HID_CONFIG_DESC_SIZ] __ALIGN_E
   HID_HS_BINTERVAL,                                   /* bInterval: Polling Interval */
   /* 91 */
 
+
+  /*---------------------------------------------------------------------------*/
+  /* NKRO interface descriptor */                     // V261018R1
+  0x09,                                               /* bLength: Interface Descriptor size */
+  USB_DESC_TYPE_INTERFACE,                            /* bDescriptorType: */
+  0x03,                                               /* bInterfaceNumber: Number of Interface */
+  0x00,                                               /* bAlternateSetting: Alternate setting */
+  0x01,                                               /* bNumEndpoints: One endpoint used */
+  0x03,                                               /* bInterfaceClass: HID */
+  0x00,                                               /* bInterfaceSubClass : 1=BOOT, 0=no boot */
+  0x00,                                               /* nInterfaceProtocol : 0=none, 1=keyboard, 2=mouse */
+  0x00,                                               /* iInterface */
+
+  /******************** Descriptor of NKRO ********************/
+  /* 100 */
+  0x09,                                               /* bLength: HID Descriptor size */
+  HID_DESCRIPTOR_TYPE,                                /* bDescriptorType: HID */
+  0x11,                                               /* bcdHID: HID Class Spec release number */
+  0x01,
+  0x00,                                               /* bCountryCode: Hardware target country */
+  0x01,                                               /* bNumDescriptors: Number of HID class descriptors to follow */
+  0x22,                                               /* bDescriptorType */
+  HID_NKRO_REPORT_DESC_SIZE,                          /* wItemLength: Total length of Report descriptor */
+  0x00,
+
+  /******************** Descriptor of NKRO endpoint ********************/
+  /* 109 */
+  0x07,                                               /* bLength: Endpoint Descriptor size */
+  USB_DESC_TYPE_ENDPOINT,                             /* bDescriptorType:*/
+  HID_NKRO_EP_IN,                                     /* bEndpointAddress: Endpoint Address (IN) */
+  USBD_EP_TYPE_INTR,                                  /* bmAttributes: Interrupt endpoint */
+  HID_NKRO_EP_SIZE,                                   /* wMaxPacketSize: */
+  0x00,
+  HID_HS_BINTERVAL,                                   /* bInterval: Polling Interval */
+  /* 116 */
 };
 #endif /* USE_USBD_COMPOSITE  */
 
@@ -492,6 +515,30 @@ __ALIGN_BEGIN static uint8_t HID_EXK_ReportDesc[HID_EXK_REPORT_DESC_SIZE] __ALIG
   0xC0                      // End Collection
 };
 
+// V261018R1: report_nkro_t 와 같은 배치 (report id + mods + NKRO_REPORT_BITS 바이트 비트맵)
+//   LED 출력은 부트 키보드 인터페이스(0)에만 두어 SET_REPORT 처리 경로를 하나로 유지한다.
+__ALIGN_BEGIN static uint8_t HID_NKRO_ReportDesc[HID_NKRO_REPORT_DESC_SIZE] __ALIGN_END =
+{
+  0x05, 0x01,                         // USAGE_PAGE (Generic Desktop)
+  0x09, 0x06,                         // USAGE (Keyboard)
+  0xa1, 0x01,                         // COLLECTION (Application)
+  0x85, REPORT_ID_NKRO,               //   REPORT_ID
+  0x05, 0x07,                         //   USAGE_PAGE (Keyboard)
+  0x19, 0xe0,                         //   USAGE_MINIMUM (Keyboard LeftControl)
+  0x29, 0xe7,                         //   USAGE_MAXIMUM (Keyboard Right GUI)
+  0x15, 0x00,                         //   LOGICAL_MINIMUM (0)
+  0x25, 0x01,                         //   LOGICAL_MAXIMUM (1)
+  0x95, 0x08,                         //   REPORT_COUNT (8)
+  0x75, 0x01,                         //   REPORT_SIZE (1)
+  0x81, 0x02,                         //   INPUT (Data,Var,Abs)
+  0x19, 0x00,                         //   USAGE_MINIMUM (0)
+  0x29, NKRO_REPORT_BITS * 8 - 1,     //   USAGE_MAXIMUM (239)
+  0x95, NKRO_REPORT_BITS * 8,         //   REPORT_COUNT (240)
+  0x75, 0x01,                         //   REPORT_SIZE (1)
+  0x81, 0x02,                         //   INPUT (Data,Var,Abs)
+  0xc0                                // END_COLLECTION
+};
+
 static USBD_HID_HandleTypeDef *p_hhid = NULL;
 static uint8_t HIDInEpAdd = HID_EPIN_ADDR;
 extern USBD_HandleTypeDef USBD_Device;
@@ -500,65 +547,16 @@ static TIM_HandleTypeDef htim2;
 #ifdef USB_MONITOR_ENABLE  // V251009R6: USB 불안정성 감시 블록을 독립 매크로로 분리
 enum
 { 
-  USB_SOF_MONITOR_CONFIG_HOLDOFF_MS   = 50U,                                               // V251108R9 재협상/재개 지연 최소화
-  USB_SOF_MONITOR_WARMUP_TIMEOUT_MS   = USB_SOF_MONITOR_CONFIG_HOLDOFF_MS + USB_BOOT_MONITOR_CONFIRM_DELAY_MS, // V250924R3 워밍업 최대 시간(ms)
-  USB_SOF_MONITOR_WARMUP_FRAMES_HS    = 2048U,                                             // V250924R3 HS 안정성 확인 프레임 수
-  USB_SOF_MONITOR_WARMUP_FRAMES_FS    = 128U,                                              // V250924R3 FS 안정성 확인 프레임 수
-  USB_SOF_MONITOR_CONFIG_HOLDOFF_US   = USB_SOF_MONITOR_CONFIG_HOLDOFF_MS * 1000UL,        // 구성 직후 워밍업 지연(us)
-  USB_SOF_MONITOR_WARMUP_TIMEOUT_US   = USB_SOF_MONITOR_WARMUP_TIMEOUT_MS * 1000UL,        // 워밍업 최대 시간(us)
-  USB_SOF_MONITOR_RESUME_HOLDOFF_US   = 50U * 1000UL,                                      // V251108R9 일시중지 해제 후 감시 재개 지연(us)
-  USB_SOF_MONITOR_RECOVERY_DELAY_US   = 50U * 1000UL,                                      // 다운그레이드 실패 후 지연(us)
-  USB_SOF_MONITOR_NO_SOF_TIMEOUT_FACTOR = 64U,                                            // V251108R9 SOF 누락 감시용 시간 배수
   USB_ENUM_MONITOR_ATTEMPT_TIMEOUT_MS = 250U,                                             // V251109R1 열거 시도 타임아웃(ms)
   USB_ENUM_MONITOR_FAIL_THRESHOLD     = 3U,                                               // V251109R1 열거 실패 다운그레이드 임계
   USB_ENUM_MONITOR_SCORE_CAP          = 5U,                                               // V251109R1 열거 실패 점수 상한
   USB_ENUM_MONITOR_RECOVERY_MS        = 1000U,                                            // V251109R1 열거 안정 여부 감쇠(ms)
-  USB_SOF_MONITOR_SPEED_WINDOW_US     = 1000U * 1000UL,                                   // V251109R2 HS 재협상 평균 재시도(≤1s)에 맞춘 윈도우
-  USB_SOF_MONITOR_SPEED_THRESHOLD     = 3U,                                               // V251109R2 1초 내 3회 이상이면 비정상으로 간주
-  USB_SOF_MONITOR_SUSPEND_WINDOW_US   = 1500U * 1000UL,                                   // V251109R2 Selective Suspend 허용 간격(>1.5s)
-  USB_SOF_MONITOR_SUSPEND_THRESHOLD   = 3U,                                               // V251109R2 1.5s 내 3회 서스펜드는 비정상
-  USB_SOF_MONITOR_PERSISTENT_THRESHOLD = 3U,                                              // V251109R2 영구 점수 임계 (세 번째 이벤트에서 다운그레이드)
-  USB_SOF_MONITOR_WARMUP_GRACE_US     = 200U * 1000UL,                                    // V251109R2 워밍업 완화 기간(us)
-  USB_BOOT_MONITOR_CONFIRM_DELAY_US   = USB_BOOT_MONITOR_CONFIRM_DELAY_MS * 1000UL          // 다운그레이드 확인 대기(us)
 };
 
 #define USB_ENUM_MONITOR_ATTEMPT_TIMEOUT_US (USB_ENUM_MONITOR_ATTEMPT_TIMEOUT_MS * 1000UL)
 #define USB_ENUM_MONITOR_RECOVERY_US       (USB_ENUM_MONITOR_RECOVERY_MS * 1000UL)
 
-typedef struct
-{
-  uint32_t prev_tick_us;                                          // V250924R2 직전 SOF 타임스탬프(us)
-  uint32_t last_decay_us;                                         // 점수 감소 시각(us)
-  uint32_t slow_last_decay_us;                                    // V251108R9 느린 점수 감소/증가 기준 시각(us)
-  uint32_t holdoff_end_us;                                        // 다운그레이드 홀드오프 종료 시각(us)
-  uint32_t warmup_deadline_us;                                    // 워밍업 타임아웃 시각(us)
-  uint32_t no_sof_deadline_us;                                    // V251108R9 SOF 미수신 타임아웃 시각(us)
-  uint32_t expected_us;                                           // V250924R4 속도별 기대 SOF 주기(us)
-  uint32_t stable_threshold_us;                                   // V250924R4 정상 범위 상한(us)
-  uint32_t decay_interval_us;                                     // 점수 감쇠 주기(us)
-  uint32_t slow_decay_interval_us;                                // V251108R9 느린 점수 감쇠 주기(us)
-  uint32_t speed_change_window_us;                                // V251109R2 속도 변동 감시 윈도우(us)
-  uint32_t suspend_window_us;                                     // V251109R2 서스펜드 감시 윈도우(us)
-  uint32_t warmup_grace_deadline_us;                              // V251109R2 워밍업 완화 기한(us)
-  uint16_t warmup_good_frames;                                    // V250924R3 누적 정상 프레임 수
-  uint16_t warmup_target_frames;                                  // V250924R3 요구되는 정상 프레임 한계
-  uint8_t  degrade_threshold;                                     // V250924R4 다운그레이드 임계 점수
-  uint8_t  slow_degrade_threshold;                                // V251108R9 느린 점수 임계
-  uint8_t  event_score_cap;                                       // V251108R9 속도별 단일 이벤트 점수 상한
-  uint8_t  active_speed;                                          // V250924R4 캐시된 USB 속도 코드
-  uint8_t  score;                                                 // V250924R2 누적 불안정 점수
-  uint8_t  slow_score;                                            // V251108R9 느린 불안정 점수
-  uint8_t  speed_change_count;                                    // V251109R2 속도 변동 누적
-  uint8_t  suspend_count;                                         // V251109R2 서스펜드 누적
-  uint8_t  persistent_score;                                      // V251109R2 속도/서스펜드 전용 점수
-  uint8_t  persistent_threshold;                                  // V251109R2 persistent 다운그레이드 임계
-  bool     warmup_complete;                                       // V250924R3 워밍업 완료 여부
-  bool     warmup_grace_active;                                   // V251109R2 워밍업 완화 적용 여부
-} usb_sof_monitor_t;
-
-static usb_sof_monitor_t sof_monitor = {0};                       // V250924R2 SOF 안정성 상태
-static uint8_t           sof_prev_dev_state = USBD_STATE_DEFAULT; // V250924R2 마지막 USB 장치 상태
-static bool              sof_prev_suspended = false;              // V251109R2 직전 서스펜드 상태
+static hid_sof_mon_t     sof_monitor;                             // V261018R9: SOF 안정성 상태 + ISR→메인 루프 샘플 링 (usbd_hid_sof_mon.c)
 
 typedef struct                                             // V251109R1 USB 열거 실패 감시 상태
 {
@@ -571,48 +569,6 @@ typedef struct                                             // V251109R1 USB 열
 
 static usb_enumeration_monitor_t enum_monitor = {0};
 
-static void usbHidSofMonitorApplySpeedParams(uint8_t speed_code)  // V250924R4 속도별 모니터링 파라미터 캐시
-{
-  sof_monitor.active_speed = speed_code;
-
-  switch (speed_code)
-  {
-    case USBD_SPEED_HIGH:
-      sof_monitor.expected_us        = 125U;
-      sof_monitor.stable_threshold_us = 180U;                       // V251108R9 HS 환경 허용 오차 축소
-      sof_monitor.decay_interval_us  = 4000U;
-      sof_monitor.slow_decay_interval_us = 12000U;                  // V251108R9 느린 점수 감쇠 (약 12ms)
-      sof_monitor.degrade_threshold  = 10U;
-      sof_monitor.slow_degrade_threshold = 4U;
-      sof_monitor.event_score_cap    = 6U;
-      sof_monitor.persistent_threshold = USB_SOF_MONITOR_PERSISTENT_THRESHOLD;
-      sof_monitor.warmup_target_frames = USB_SOF_MONITOR_WARMUP_FRAMES_HS;
-      break;
-    case USBD_SPEED_FULL:
-      sof_monitor.expected_us        = 1000U;
-      sof_monitor.stable_threshold_us = 1500U;                      // V251108R9 FS 허용 오차 축소
-      sof_monitor.decay_interval_us  = 20000U;
-      sof_monitor.slow_decay_interval_us = 60000U;                  // V251108R9 느린 점수 감쇠 (약 60ms)
-      sof_monitor.degrade_threshold  = 5U;
-      sof_monitor.slow_degrade_threshold = 3U;
-      sof_monitor.event_score_cap    = 4U;
-      sof_monitor.persistent_threshold = USB_SOF_MONITOR_PERSISTENT_THRESHOLD;
-      sof_monitor.warmup_target_frames = USB_SOF_MONITOR_WARMUP_FRAMES_FS;
-      break;
-    default:
-      sof_monitor.expected_us        = 0U;
-      sof_monitor.stable_threshold_us = 0U;
-      sof_monitor.decay_interval_us  = 0U;
-      sof_monitor.degrade_threshold  = 0U;
-      sof_monitor.slow_decay_interval_us = 0U;
-      sof_monitor.slow_degrade_threshold = 0U;
-      sof_monitor.event_score_cap    = 0U;
-      sof_monitor.persistent_threshold = 0U;
-      sof_monitor.warmup_target_frames = 0U;
-      break;
-  }
-}
-
 #endif  // USB_MONITOR_ENABLE  // V251010R5: 모니터 전용 정의 영역을 조기 종료해 일반 HID 경로가 항상 컴파일되도록 조정
 
 
@@ -672,11 +628,30 @@ static uint8_t USBD_HID_Init(USBD_HandleTypeDef *pdev, uint8_t cfgidx)
   (void)USBD_LL_OpenEP(pdev, HID_EXK_EP_IN, USBD_EP_TYPE_INTR, HID_EXK_EP_SIZE);
   pdev->ep_in[HID_EXK_EP_IN & 0xFU].is_used = 1U;
 
+  // NKRO EP
+  //
+  pdev->ep_in[HID_NKRO_EP_IN & 0xFU].bInterval = pdev->dev_speed == USBD_SPEED_HIGH ? hs_interval:HID_FS_BINTERVAL;
+  (void)USBD_LL_OpenEP(pdev, HID_NKRO_EP_IN, USBD_EP_TYPE_INTR, HID_NKRO_EP_SIZE);
+  pdev->ep_in[HID_NKRO_EP_IN & 0xFU].is_used = 1U;
+
 
-  hhid->state = USBD_HID_IDLE;
+  hhid->Protocol = 1U;                                                  // V261018R1: 리셋/재구성 후 기본값은 Report 프로토콜
+  usbHidSetProtocol(1U);
 
   /* Prepare Out endpoint to receive next packet */
-  (void)USBD_LL_PrepareReceive(pdev, HID_VIA_EP_OUT, via_hid_usb_report, 32);
+  usbHidViaReset(&via_report);                                          // V261018R6
+  (void)USBD_LL_PrepareReceive(pdev, HID_VIA_EP_OUT, via_hid_rx_report, sizeof(via_hid_rx_report));
+
+  // V261018R4: 속도/호스트가 바뀔 수 있으므로 재구성마다 위상을 다시 학습한다.
+  if (pdev->dev_speed == USBD_SPEED_HIGH)
+  {
+    usbHidJitInit(&hid_tx.jit, hid_jit_enable, 125U, HW_USB_HID_JIT_GUARD_HS_US, usbHidBackupTimerOffsetUs());
+  }
+  else
+  {
+    usbHidJitInit(&hid_tx.jit, hid_jit_enable, 1000U, HW_USB_HID_JIT_GUARD_FS_US, usbHidBackupTimerOffsetUs());
+  }
+  usbHidJitApplyCompare();
 
 
   static bool is_first = true;
@@ -684,9 +659,19 @@ static uint8_t USBD_HID_Init(USBD_HandleTypeDef *pdev, uint8_t cfgidx)
   {
     is_first = false;
 
-    qbufferCreateBySize(&report_q, (uint8_t *)report_buf, sizeof(report_info_t), 128); 
-    qbufferCreateBySize(&via_report_q, (uint8_t *)via_report_q_buf, sizeof(via_report_info_t), 128); 
-    qbufferCreateBySize(&report_exk_q, (uint8_t *)report_exk_buf, sizeof(report_info_t), 128); 
+    // V261021R6: DMA 빌드의 USBD_DMA_BUF 는 .non_cache(NOLOAD) 라 = {0,} 초기값이 적용되지 않는다.
+    memset(hid_buf, 0, sizeof(hid_buf));
+    memset(hid_buf_exk, 0, sizeof(hid_buf_exk));
+    memset(hid_buf_nkro, 0, sizeof(hid_buf_nkro));
+    memset(via_hid_rx_report, 0, sizeof(via_hid_rx_report));
+    memset(via_hid_tx_report, 0, sizeof(via_hid_tx_report));
+
+    usbHidTxInit(&hid_tx, usbHidEpTransmit, hid_buf, hid_buf_exk, hid_buf_nkro);   // V261021R4
+    usbHidViaInit(&via_report, HW_USB_VIA_GATE_MS, HW_USB_VIA_WINDOW);   // V261018R6
+    usbHidWakeUpInit(&hid_wakeup, HW_USB_WAKEUP_SIGNAL_MS, HW_USB_WAKEUP_TIMEOUT_MS);   // V261019R1
+#ifdef USB_MONITOR_ENABLE
+    usbHidSofMonInit(&sof_monitor, HW_USB_MONITOR_BATCH, usbHidMonitorRequestDowngrade);   // V261018R9
+#endif
 
     logPrintf("[OK] USB Hid\n");
     logPrintf("     Keyboard\n");
@@ -694,6 +679,10 @@ static uint8_t USBD_HID_Init(USBD_HandleTypeDef *pdev, uint8_t cfgidx)
 
     usbHidInitTimer();
   }
+  usbHidTxSetKeyboardLength(&hid_tx, usbHidKeyboardReportLength());
+  // V261021R5: HS 4K/2K(bInterval 2/3) 는 2/4 마이크로프레임마다 폴링한다. TIM2 는 매 SOF 리셋되므로 JIT 가 폴링 마이크로프레임을 가린다.
+  usbHidTxSetPollDiv(&hid_tx, pdev->dev_speed == USBD_SPEED_HIGH ? (1UL << (hs_interval - 1U)) : 1UL);
+  usbHidTxReset(&hid_tx, true);                                         // V261018R3: 재구성마다 모든 IN EP idle
 
   return (uint8_t)USBD_OK;
 }
@@ -719,6 +708,8 @@ static uint8_t USBD_HID_DeInit(USBD_HandleTypeDef *pdev, uint8_t cfgidx)
   pdev->ep_in[HIDInEpAdd & 0xFU].is_used = 0U;
   pdev->ep_in[HIDInEpAdd & 0xFU].bInterval = 0U;
 
+  usbHidTxReset(&hid_tx, false);                                        // V261021R4: 해제 후에는 다시 구성될 때까지 대기열에만 쌓는다
+
   /* Free allocated memory */
   if (pdev->pClassDataCmsit[pdev->classId] != NULL)
   {
@@ -762,12 +753,28 @@ static uint8_t USBD_HID_Setup(USBD_HandleTypeDef *pdev, USBD_SetupReqTypedef *re
       {
         case USBD_HID_REQ_SET_PROTOCOL:
           logDebug("  USBD_HID_REQ_SET_PROTOCOL  : 0x%X, 0x%d\n", req->wValue, req->wLength);      
-          hhid->Protocol = (uint8_t)(req->wValue);
+          // V261020R3: 프로토콜은 Boot 키보드 인터페이스에만 있다. VIA/EXK/NKRO 인터페이스로 온 요청이
+          //            키보드 EP 를 8바이트 부트 리포트로 바꾸지 않도록 수락만 하고 상태는 바꾸지 않는다.
+          if (LOBYTE(req->wIndex) == HID_KEYBOARD_ITF_NBR)
+          {
+            hhid->Protocol = (uint8_t)(req->wValue);
+            usbHidSetProtocol((uint8_t)req->wValue);                    // V261018R1: Boot 프로토콜이면 6KRO 경로로 폴백
+            usbHidTxSetKeyboardLength(&hid_tx, usbHidKeyboardReportLength());
+          }
           break;
 
         case USBD_HID_REQ_GET_PROTOCOL:
           logDebug("  USBD_HID_REQ_GET_PROTOCOL  : 0x%X, 0x%d\n", req->wValue, req->wLength);      
-          (void)USBD_CtlSendData(pdev, (uint8_t *)&hhid->Protocol, 1U);
+          if (LOBYTE(req->wIndex) == HID_KEYBOARD_ITF_NBR)
+          {
+            (void)USBD_CtlSendData(pdev, (uint8_t *)&hhid->Protocol, 1U);
+          }
+          else
+          {
+            static uint8_t report_protocol = 1U;                        // V261020R3: 비 Boot 인터페이스는 항상 Report 프로토콜
+
+            (void)USBD_CtlSendData(pdev, &report_protocol, 1U);
+          }
           break;
 
         case USBD_HID_REQ_SET_IDLE:
@@ -824,6 +831,11 @@ static uint8_t USBD_HID_Setup(USBD_HandleTypeDef *pdev, USBD_SetupReqTypedef *re
                 pbuf = HID_EXK_ReportDesc;
                 break;
 
+              case 3:
+                len = MIN(HID_NKRO_REPORT_DESC_SIZE, req->wLength);   // V261018R1
+                pbuf = HID_NKRO_ReportDesc;
+                break;
+
               default:
                 len = MIN(HID_KEYBOARD_REPORT_DESC_SIZE, req->wLength);
                 pbuf = HID_KEYBOARD_ReportDesc;
@@ -917,33 +929,34 @@ uint8_t USBD_HID_EP0_RxReady(USBD_HandleTypeDef *pdev)
   return (uint8_t)USBD_OK;
 }
 
-/**
-  * @brief  USBD_HID_SendReport
-  *         Send HID Report
-  * @param  buff: pointer to report
-  * @retval status
-  */
-bool USBD_HID_SendReport(uint8_t *report, uint16_t len)
+// V261018R3: IN EP 번호별로 전송 중 상태를 따로 둔다. 한 EP 의 IN 완료가 늦어도 다른 EP 전송을 막지 않는다.
+// V261021R4: 상태 표는 usbd_hid_tx.c 로 옮겼고 여기서는 실제 전송만 한다 (usbHidTxStart() 가 호출).
+static bool usbHidEpTransmit(uint8_t ep_addr, uint8_t *report, uint16_t len)
 {
   USBD_HandleTypeDef *pdev = &USBD_Device;
-  bool ret = false;
 
-  if (p_hhid == NULL)
+  if (pdev->dev_state != USBD_STATE_CONFIGURED)
   {
     return false;
   }
 
-  if (pdev->dev_state == USBD_STATE_CONFIGURED)
+  (void)USBD_LL_Transmit(pdev, ep_addr, report, len);
+  if (ep_addr == HID_EPIN_ADDR || ep_addr == HID_NKRO_EP_IN)
   {
-    if (p_hhid->state == USBD_HID_IDLE)
-    {
-      ret = true;
-      p_hhid->state = USBD_HID_BUSY;
-      (void)USBD_LL_Transmit(pdev, HID_EPIN_ADDR, report, len);
-    }
+    latencyMark(LATENCY_POINT_TX);                                    // V261019R2: host send → LL Transmit 구간
   }
+  return true;
+}
 
-  return ret;
+/**
+  * @brief  USBD_HID_SendReport
+  *         Send HID Report
+  * @param  buff: pointer to report
+  * @retval status
+  */
+bool USBD_HID_SendReport(uint8_t *report, uint16_t len)
+{
+  return usbHidTxStart(&hid_tx, HID_EPIN_ADDR, report, len);
 }
 
 /**
@@ -954,25 +967,18 @@ bool USBD_HID_SendReport(uint8_t *report, uint16_t len)
   */
 bool USBD_HID_SendReportEXK(uint8_t *report, uint16_t len)
 {
-  USBD_HandleTypeDef *pdev = &USBD_Device;
-  bool ret = false;
-
-  if (p_hhid == NULL)
-  {
-    return false;
-  }
-
-  if (pdev->dev_state == USBD_STATE_CONFIGURED)
-  {
-    if (p_hhid->state == USBD_HID_IDLE)
-    {
-      ret = true;
-      p_hhid->state = USBD_HID_BUSY;
-      (void)USBD_LL_Transmit(pdev, HID_EXK_EP_IN, report, len);
-    }
-  }
+  return usbHidTxStart(&hid_tx, HID_EXK_EP_IN, report, len);
+}
 
-  return ret;
+/**
+  * @brief  USBD_HID_SendReportNKRO
+  *         Send HID Report
+  * @param  buff: pointer to report
+  * @retval status
+  */
+bool USBD_HID_SendReportNKRO(uint8_t *report, uint16_t len)
+{
+  return usbHidTxStart(&hid_tx, HID_NKRO_EP_IN, report, len);
 }
 
 /**
@@ -1068,6 +1074,12 @@ static uint8_t *USBD_HID_GetHSCfgDesc(uint16_t *length)
     pEpDesc->bInterval = hs_interval;                                 // V250923R1 EXK polling interval
   }
 
+  pEpDesc = USBD_GetEpDesc(USBD_HID_CfgDesc, HID_NKRO_EP_IN);
+  if (pEpDesc != NULL)
+  {
+    pEpDesc->bInterval = hs_interval;                                 // V261018R1 NKRO polling interval
+  }
+
   *length = (uint16_t)sizeof(USBD_HID_CfgDesc);
   return USBD_HID_CfgDesc;
 }
@@ -1103,15 +1115,25 @@ static uint8_t *USBD_HID_GetOtherSpeedCfgDesc(uint16_t *length)
   */
 static uint8_t USBD_HID_DataIn(USBD_HandleTypeDef *pdev, uint8_t epnum)
 {
-  UNUSED(epnum);
-  /* Ensure that the FIFO is empty before a new transfer, this condition could
-  be caused by  a new transfer before the end of the previous transfer */
-  ((USBD_HID_HandleTypeDef *)pdev->pClassDataCmsit[pdev->classId])->state = USBD_HID_IDLE;
+  usbHidTxOnDataIn(&hid_tx, epnum);                                   // V261018R3: 완료된 EP 만 해제
 
+  if (epnum == (HID_VIA_EP_IN & 0x0F))
+  {
+    usbHidViaService(pdev);                                           // V261018R6: 다음 응답을 바로 이어서 싣는다
+  }
+  if (epnum == (HID_EPIN_ADDR & 0x0F) || epnum == (HID_NKRO_EP_IN & 0x0F))
+  {
+    latencyMark(LATENCY_POINT_DONE);                                  // V261019R2: LL Transmit → IN 완료 구간
+  }
   if (epnum != (HID_EPIN_ADDR & 0x0F))
   {
     return (uint8_t)USBD_OK;
   }
+  if (usbHidTxOnKeyboardDataIn(&hid_tx, micros(), __HAL_TIM_GET_COUNTER(&htim2)) == true)   // V261018R4: IN 위상 샘플 + 변경→IN 지연
+  {
+    usbHidJitApplyCompare();
+  }
+  usbOnKeyboardReportSent();                                          // V261018R8: 부팅/재열거 후 첫 리포트 시각
   
 #if _DEF_ENABLE_USB_HID_TIMING_PROBE
   usbHidInstrumentationOnDataIn();                                    // V251009R7: HID 계측 활성 시에만 IN 완료 계수 갱신
@@ -1135,9 +1157,18 @@ static uint8_t USBD_HID_DataOut(USBD_HandleTypeDef *pdev, uint8_t epnum)
   uint32_t rx_size;
   rx_size = USBD_LL_GetRxDataSize(pdev, epnum);
 
+  bool queued = false;
+
   if (via_hid_receive_func != NULL)
   {
-    via_hid_receive_func(via_hid_usb_report, rx_size);
+    queued = via_hid_receive_func(via_hid_rx_report, rx_size);
+  }
+
+  // V261018R6: 응답 전 요청이 window 미만이면 다음 요청을 바로 받는다. 아니면 응답을 실을 때까지 NAK.
+  // V261020R4: 큐에 실리지 않은 요청(rx_size 0, 큐 가득)은 응답이 없으므로 pending 에 넣지 않는다.
+  if (usbHidViaOnReceive(&via_report, queued) == true)
+  {
+    (void)USBD_LL_PrepareReceive(pdev, HID_VIA_EP_OUT, via_hid_rx_report, sizeof(via_hid_rx_report));
   }
 
   return (uint8_t)USBD_OK;
@@ -1163,7 +1194,29 @@ uint8_t USBD_HID_SOF(USBD_HandleTypeDef *pdev)
 #if defined(USB_MONITOR_ENABLE)
     if (monitor_enabled)                                              // V251108R1: VIA 토글로 모니터 동작 제어
     {
-      usbHidMonitorSof(sof_now_us);                                   // V251009R7: 모니터 활성 시 타임스탬프 전달
+      // V261018R9: ISR 은 샘플만 적재하고 평가는 usbHidMonitorBackgroundTick() 에서 모아서 한다.
+      hid_sof_sample_t sample;
+
+#if _DEF_ENABLE_USB_HID_TIMING_PROBE
+      uint32_t cycle_begin = DWT->CYCCNT;
+#endif
+      sample.now_us    = sof_now_us;
+      sample.dev_state = pdev->dev_state;
+      sample.speed     = pdev->dev_speed;
+      sample.flags     = USBD_is_suspended() ? HID_SOF_FLAG_SUSPENDED : 0;
+      sample.reserved  = 0;
+      bool need_wake = usbHidSofMonOnSof(&sof_monitor, &sample);
+#if _DEF_ENABLE_USB_HID_TIMING_PROBE
+      usbHidSofMonAddIsrCycles(&sof_monitor, DWT->CYCCNT - cycle_begin);
+#endif
+#ifdef _USE_HW_IDLE
+      if (need_wake)                                                  // V261020R7: 매 SOF 가 아니라 링이 WAKE_DEPTH 에 닿을 때만 깨움
+      {
+        idleSetEvent(IDLE_EVENT_SOF);
+      }
+#else
+      (void)need_wake;
+#endif
     }
 #endif
 #if _DEF_ENABLE_USB_HID_TIMING_PROBE
@@ -1172,13 +1225,22 @@ uint8_t USBD_HID_SOF(USBD_HandleTypeDef *pdev)
   }
 #endif
 
-  if (qbufferAvailable(&via_report_q) && (millis()-via_report_pre_time) >= via_report_time)
+  usbHidTxOnSof(&hid_tx);                                             // V261021R5: 폴링되는 마이크로프레임 판정용 SOF 수
+  usbHidViaService(pdev);                                             // V261018R6: 유휴 후 첫 응답은 SOF 에서 싣는다
+  return (uint8_t)USBD_OK;
+}
+
+// V261018R6: OTG ISR(DataIn/SOF) 에서만 호출해 VIA 큐의 소비자를 하나로 유지한다.
+static void usbHidViaService(USBD_HandleTypeDef *pdev)
+{
+  if (usbHidTxEpIsIdle(&hid_tx, HID_VIA_EP_IN) && usbHidViaPop(&via_report, via_hid_tx_report, millis()) == true)
   {
-    qbufferRead(&via_report_q, (uint8_t *)via_hid_usb_report, 1);
-    USBD_LL_Transmit(pdev, HID_VIA_EP_OUT, via_hid_usb_report, sizeof(via_hid_usb_report));
-    USBD_LL_PrepareReceive(pdev, HID_VIA_EP_OUT, via_hid_usb_report, sizeof(via_hid_usb_report));
+    usbHidTxStart(&hid_tx, HID_VIA_EP_IN, via_hid_tx_report, sizeof(via_hid_tx_report));   // V261018R3: VIA IN EP 상태 추적
+  }
+  if (usbHidViaTakeRearm(&via_report) == true)
+  {
+    (void)USBD_LL_PrepareReceive(pdev, HID_VIA_EP_OUT, via_hid_rx_report, sizeof(via_hid_rx_report));
   }
-  return (uint8_t)USBD_OK;
 }
 
 #ifndef USE_USBD_COMPOSITE
@@ -1196,115 +1258,175 @@ static uint8_t *USBD_HID_GetDeviceQualifierDesc(uint16_t *length)
 }
 #endif /* USE_USBD_COMPOSITE  */
 
+// V261019R1: K 상태 시작만 한다. 종료(DeActivate)와 재개 후 재전송은 usbHidWakeUpProcess() 가 메인 루프에서 한다.
 bool usbHidUpdateWakeUp(USBD_HandleTypeDef *pdev)
 {
   PCD_HandleTypeDef *hpcd = (PCD_HandleTypeDef *)pdev->pData;
   bool ret = false;
   
-  if (pdev->dev_state == USBD_STATE_SUSPENDED)
+  if (pdev->dev_state == USBD_STATE_SUSPENDED && usbHidWakeUpRequest(&hid_wakeup, millis()) == true)
   {
     logPrintf("[  ] USB WakeUp\n");
 
     __HAL_PCD_UNGATE_PHYCLOCK((hpcd));
     HAL_PCD_ActivateRemoteWakeup(hpcd);
-    delay(10);
-    HAL_PCD_DeActivateRemoteWakeup(hpcd);
     ret = true;
   }
 
   return ret;
 }
 
-bool usbHidSetViaReceiveFunc(void (*func)(uint8_t *, uint8_t))
+// V261019R1: 서스펜드 중이거나 아직 재전송하지 않은 보관 리포트가 있으면 순서를 지키기 위해 보관한다.
+static bool usbHidWakeUpHold(uint8_t ep_addr, uint8_t *p_data, uint16_t length)
 {
-  via_hid_receive_func = func;
+  if (!USBD_is_suspended() && usbHidWakeUpAvailable(&hid_wakeup) == 0)
+  {
+    return false;
+  }
+
+  usbHidWakeUpPush(&hid_wakeup, ep_addr, p_data, length);
+  if (USBD_is_suspended())
+  {
+    usbHidUpdateWakeUp(&USBD_Device);
+  }
   return true;
 }
 
-bool usbHidEnqueueViaResponse(const uint8_t *p_data, uint8_t length)
+void usbHidWakeUpProcess(void)
 {
-  via_report_info_t info;
+  hid_wakeup_rec_t rec;
+  bool             ready;
 
-  if (p_data == NULL)
+  ready = !USBD_is_suspended() && USBD_Device.dev_state == USBD_STATE_CONFIGURED;
+
+  switch (usbHidWakeUpStep(&hid_wakeup, millis(), ready))
   {
-    return false;
+    case HID_WAKEUP_ACT_SIGNAL_END:
+      HAL_PCD_DeActivateRemoteWakeup((PCD_HandleTypeDef *)USBD_Device.pData);
+      break;
+
+    case HID_WAKEUP_ACT_REPLAY:
+      while (usbHidWakeUpPop(&hid_wakeup, &rec) == true)
+      {
+        if (rec.ep == HID_EPIN_ADDR)
+        {
+          usbHidSendReportNow(rec.buf, rec.len);
+        }
+        else if (rec.ep == HID_EXK_EP_IN)
+        {
+          usbHidSendReportEXKNow(rec.buf, rec.len);
+        }
+        else if (rec.ep == HID_NKRO_EP_IN)
+        {
+          usbHidSendReportNKRONow(rec.buf, rec.len);
+        }
+      }
+      break;
+
+    case HID_WAKEUP_ACT_TIMEOUT:
+      logPrintf("[!] USB WakeUp timeout\n");
+      break;
+
+    default:
+      break;
   }
+}
+
+bool usbHidSetViaReceiveFunc(bool (*func)(uint8_t *, uint8_t))
+{
+  via_hid_receive_func = func;
+  return true;
+}
 
-  if (length > sizeof(info.buf))
+bool usbHidEnqueueViaResponse(const uint8_t *p_data, uint8_t length)
+{
+  if (p_data == NULL)
   {
-    length = sizeof(info.buf);
+    return false;
   }
 
-  memset(info.buf, 0, sizeof(info.buf));
-  memcpy(info.buf, p_data, length);
-
-  if (qbufferWrite(&via_report_q, (uint8_t *)&info, 1) != true)
+  if (usbHidViaPush(&via_report, p_data, length, millis()) != true)   // V261018R6: 적재 시각은 게이트 모드에서만 사용
   {
     logPrintf("[!] VIA TX queue overflow\n");                         // V251108R8: 메인 루프 큐 적재 실패 감시
     return false;
   }
-
-  via_report_pre_time = millis();                                     // V251108R8: 전송 지연 타이머 갱신
   return true;
 }
 
-bool usbHidSendReport(uint8_t *p_data, uint16_t length)
+// V261018R1: Boot 프로토콜 호스트(BIOS 등)는 8바이트 부트 리포트만 받는다.
+static uint16_t usbHidKeyboardReportLength(void)
 {
-  report_info_t report_info;
+  if (p_hhid != NULL && p_hhid->Protocol == 0U)
+  {
+    return HID_KEYBOARD_BOOT_REPORT_SIZE;
+  }
+  return HID_KEYBOARD_REPORT_SIZE;
+}
 
+bool usbHidSendReport(uint8_t *p_data, uint16_t length)
+{
   if (length > HID_KEYBOARD_REPORT_SIZE)
     return false;
 
-  if (!USBD_is_suspended())
-  {
+  if (usbHidWakeUpHold(HID_EPIN_ADDR, p_data, length) == true)           // V261019R1
+    return true;
+
+  return usbHidSendReportNow(p_data, length);
+}
+
+static bool usbHidSendReportNow(uint8_t *p_data, uint16_t length)
+{
 #if _DEF_ENABLE_USB_HID_TIMING_PROBE
-    usbHidInstrumentationMarkReportStart();                            // V251009R7: 계측 시에만 리포트 시작 타임스탬프 기록
+  usbHidInstrumentationMarkReportStart();                            // V251009R7: 계측 시에만 리포트 시작 타임스탬프 기록
 #endif
 
-    memcpy(hid_buf, p_data, length);
-    if (USBD_HID_SendReport((uint8_t *)hid_buf, HID_KEYBOARD_REPORT_SIZE))
-    {
+  // V261021R4: 즉시 적재/병합 판단은 usbd_hid_tx.c (시뮬레이터도 같은 소스를 빌드)
+  if (usbHidTxKeyboard(&hid_tx, p_data, length, micros(), __HAL_TIM_GET_COUNTER(&htim2)) == true)
+  {
 #if _DEF_ENABLE_USB_HID_TIMING_PROBE
-      uint32_t queued_reports = qbufferAvailable(&report_q);           // V251009R7: 큐 깊이 스냅샷도 계측 활성 시에만 계산
-      usbHidInstrumentationOnImmediateSendSuccess(queued_reports);     // V251009R7: 즉시 전송 성공 계측 조건부 실행
+    usbHidInstrumentationOnImmediateSendSuccess(0);                  // V251009R7: 즉시 전송 성공 계측 조건부 실행
 #endif
-    }
-    else
-    {
-      memcpy(report_info.buf, p_data, length);
-      qbufferWrite(&report_q, (uint8_t *)&report_info, 1);
-    }    
-  }
-  else
-  {
-    usbHidUpdateWakeUp(&USBD_Device);
   }
-  
   return true;
 }
 
-bool usbHidSendReportEXK(uint8_t *p_data, uint16_t length)
+bool usbHidGetQueueInfo(usb_hid_queue_info_t *p_info)
 {
-  exk_report_info_t report_info;
+  usbHidCoalesceGetInfo(&hid_tx.kbd_q, p_info, micros());                  // V261018R2
+  return true;
+}
 
+bool usbHidSendReportEXK(uint8_t *p_data, uint16_t length)
+{
   if (length > HID_EXK_EP_SIZE)
     return false;
 
-  if (!USBD_is_suspended())
-  {
-    memcpy(hid_buf_exk, p_data, length);
-    if (!USBD_HID_SendReportEXK((uint8_t *)hid_buf_exk, length))
-    {
-      report_info.len = length;
-      memcpy(report_info.buf, p_data, length);
-      qbufferWrite(&report_exk_q, (uint8_t *)&report_info, 1);        
-    }    
-  }
-  else
-  {
-    usbHidUpdateWakeUp(&USBD_Device);
-  }
-  
+  if (usbHidWakeUpHold(HID_EXK_EP_IN, p_data, length) == true)           // V261019R1
+    return true;
+
+  return usbHidSendReportEXKNow(p_data, length);
+}
+
+static bool usbHidSendReportEXKNow(uint8_t *p_data, uint16_t length)
+{
+  usbHidTxExk(&hid_tx, p_data, length);                               // V261021R4
+  return true;
+}
+
+bool usbHidSendReportNKRO(uint8_t *p_data, uint16_t length)
+{
+  if (length > HID_NKRO_EP_SIZE)
+    return false;
+
+  if (usbHidWakeUpHold(HID_NKRO_EP_IN, p_data, length) == true)          // V261019R1
+    return true;
+
+  return usbHidSendReportNKRONow(p_data, length);
+}
+
+static bool usbHidSendReportNKRONow(uint8_t *p_data, uint16_t length)
+{
+  usbHidTxNkro(&hid_tx, p_data, length);                              // V261021R4
   return true;
 }
 
@@ -1327,346 +1449,29 @@ static UsbBootMode_t usbHidResolveDowngradeTarget(void)            // V250924R2
   }
 }
 
-static void usbHidMonitorPrimeTimeout(uint32_t now_us)             // V251108R9 SOF 누락 감시 타임아웃 초기화
+// V261018R9: 점수/창 정리는 usbd_hid_sof_mon.c 가 하고 여기서는 하위 모드 요청만 한다.
+static bool usbHidMonitorRequestDowngrade(uint32_t      now_us,
+                                          uint32_t      delta_us,
+                                          uint32_t      expected_us,
+                                          usb_monitor_event_t event)
 {
-  uint32_t guard_window = USB_SOF_MONITOR_WARMUP_TIMEOUT_US;
+  bool downgrade_requested = false;
+  UsbBootMode_t next_mode = usbHidResolveDowngradeTarget();
 
-  if (sof_monitor.expected_us > 0U)
+  (void)now_us;
+  if (next_mode < USB_BOOT_MODE_MAX)
   {
-    guard_window = sof_monitor.expected_us * USB_SOF_MONITOR_NO_SOF_TIMEOUT_FACTOR;
-    if (guard_window == 0U)
+    uint32_t now_ms = millis();
+    usb_boot_downgrade_result_t request_result = usbRequestBootModeDowngrade(next_mode,
+                                                                             delta_us,
+                                                                             expected_us,
+                                                                             now_ms);
+
+    if (request_result == USB_BOOT_DOWNGRADE_ARMED || request_result == USB_BOOT_DOWNGRADE_CONFIRMED)
     {
-      guard_window = sof_monitor.expected_us;
+      downgrade_requested = true;
     }
   }
-
-  sof_monitor.no_sof_deadline_us = now_us + guard_window;
-}
-
-static void usbHidMonitorSof(uint32_t now_us)
-{
-  USBD_HandleTypeDef *pdev = &USBD_Device;
-
-  if (pdev->dev_state != sof_prev_dev_state)
-  {
-    sof_monitor.prev_tick_us       = now_us;
-    sof_monitor.score              = 0U;
-    sof_monitor.slow_score         = 0U;
-    sof_monitor.last_decay_us      = now_us;
-    sof_monitor.slow_last_decay_us = now_us;
-    sof_monitor.holdoff_end_us =
-        (pdev->dev_state == USBD_STATE_CONFIGURED) ? (now_us + USB_SOF_MONITOR_CONFIG_HOLDOFF_US) : now_us;
-    sof_monitor.warmup_deadline_us =
-        (pdev->dev_state == USBD_STATE_CONFIGURED) ? (now_us + USB_SOF_MONITOR_WARMUP_TIMEOUT_US) : now_us;
-    sof_monitor.warmup_good_frames = 0U;
-    sof_monitor.warmup_complete    = false;
-    usbHidSofMonitorApplySpeedParams((pdev->dev_state == USBD_STATE_CONFIGURED) ? pdev->dev_speed : 0xFFU);
-    usbHidMonitorPrimeTimeout(now_us);
-    sof_monitor.speed_change_count     = 0U;
-    sof_monitor.suspend_count          = 0U;
-    sof_monitor.persistent_score       = 0U;
-    sof_monitor.speed_change_window_us = 0U;          // V251109R3: 이벤트 창을 첫 발생 기준으로 초기화
-    sof_monitor.suspend_window_us      = 0U;          // V251109R3: 서스펜드 창 초기화
-    sof_monitor.warmup_grace_active    = false;
-    sof_monitor.warmup_grace_deadline_us = 0U;
-    sof_prev_dev_state             = pdev->dev_state;
-  }
-
-  if (pdev->dev_state != USBD_STATE_CONFIGURED)
-  {
-    sof_monitor.prev_tick_us       = now_us;
-    sof_monitor.score              = 0U;
-    sof_monitor.slow_score         = 0U;
-    sof_monitor.last_decay_us      = now_us;
-    sof_monitor.slow_last_decay_us = now_us;
-    sof_monitor.holdoff_end_us     = now_us;
-    sof_monitor.warmup_deadline_us = now_us;
-    sof_monitor.warmup_good_frames = 0U;
-    sof_monitor.warmup_complete    = false;
-    usbHidSofMonitorApplySpeedParams(0xFFU);
-    usbHidMonitorPrimeTimeout(now_us);
-    sof_monitor.speed_change_count     = 0U;
-    sof_monitor.suspend_count          = 0U;
-    sof_monitor.persistent_score       = 0U;
-    sof_monitor.speed_change_window_us = 0U;          // V251109R3: 구성 전에는 창을 비활성화
-    sof_monitor.suspend_window_us      = 0U;          // V251109R3
-    sof_monitor.warmup_grace_active    = false;
-    sof_monitor.warmup_grace_deadline_us = 0U;
-    return;
-  }
-
-  bool is_suspended = USBD_is_suspended();
-
-  if (is_suspended)
-  {
-    if (sof_prev_suspended == false)
-    {
-      usbHidMonitorHandleSuspend(now_us);
-    }
-    sof_prev_suspended = true;
-    sof_monitor.prev_tick_us        = now_us;
-    sof_monitor.score               = 0U;
-    if (sof_monitor.slow_score > 0U)
-    {
-      sof_monitor.slow_score--;
-    }
-    sof_monitor.holdoff_end_us      = now_us + USB_SOF_MONITOR_RESUME_HOLDOFF_US;
-    sof_monitor.warmup_deadline_us  = now_us + USB_SOF_MONITOR_WARMUP_TIMEOUT_US;
-    sof_monitor.warmup_good_frames  = 0U;
-    sof_monitor.warmup_complete     = false;
-    sof_monitor.last_decay_us       = now_us;
-    sof_monitor.slow_last_decay_us  = now_us;
-    usbHidSofMonitorApplySpeedParams(pdev->dev_speed);
-    usbHidMonitorPrimeTimeout(now_us);
-    return;
-  }
-  else
-  {
-    sof_prev_suspended = false;
-  }
-
-  if (pdev->dev_speed != USBD_SPEED_HIGH && pdev->dev_speed != USBD_SPEED_FULL)
-  {
-    sof_monitor.prev_tick_us       = now_us;
-    sof_monitor.score              = 0U;
-    sof_monitor.slow_score         = 0U;
-    sof_monitor.last_decay_us      = now_us;
-    sof_monitor.slow_last_decay_us = now_us;
-    sof_monitor.warmup_deadline_us = now_us;
-    sof_monitor.warmup_good_frames = 0U;
-    sof_monitor.warmup_complete    = false;
-    usbHidSofMonitorApplySpeedParams(0xFFU);
-    usbHidMonitorPrimeTimeout(now_us);
-    return;
-  }
-
-  if (pdev->dev_speed != sof_monitor.active_speed)
-  {
-    usbHidMonitorHandleSpeedChange(now_us);
-    usbHidSofMonitorApplySpeedParams(pdev->dev_speed);
-    sof_monitor.score              = 0U;
-    if (sof_monitor.slow_score > 0U)
-    {
-      sof_monitor.slow_score--;
-    }
-    sof_monitor.last_decay_us      = now_us;
-    sof_monitor.slow_last_decay_us = now_us;
-    sof_monitor.holdoff_end_us     = now_us + USB_SOF_MONITOR_CONFIG_HOLDOFF_US;
-    sof_monitor.warmup_deadline_us = now_us + USB_SOF_MONITOR_WARMUP_TIMEOUT_US;
-    sof_monitor.warmup_good_frames = 0U;
-    sof_monitor.warmup_complete    = false;
-    usbHidMonitorPrimeTimeout(now_us);
-  }
-
-  if (sof_monitor.prev_tick_us == 0U)
-  {
-    sof_monitor.prev_tick_us = now_us;
-    sof_monitor.last_decay_us = now_us;
-    sof_monitor.slow_last_decay_us = now_us;
-    usbHidMonitorPrimeTimeout(now_us);
-    return;
-  }
-
-  uint32_t delta_us = now_us - sof_monitor.prev_tick_us;
-  sof_monitor.prev_tick_us = now_us;
-
-  usbHidMonitorProcessDelta(now_us, delta_us);
-}
-
-static void usbHidMonitorProcessDelta(uint32_t now_us, uint32_t delta_us)
-{
-  uint32_t expected_us            = sof_monitor.expected_us;
-  uint32_t stable_threshold       = sof_monitor.stable_threshold_us;
-  uint32_t decay_interval_us      = sof_monitor.decay_interval_us;
-  uint32_t slow_decay_interval_us = sof_monitor.slow_decay_interval_us;
-  uint8_t  degrade_threshold      = sof_monitor.degrade_threshold;
-  uint8_t  slow_degrade_threshold = sof_monitor.slow_degrade_threshold;
-  uint8_t  event_score_cap        = sof_monitor.event_score_cap;
-  uint16_t warmup_target_frames   = sof_monitor.warmup_target_frames;
-
-  if (expected_us == 0U)
-  {
-    return;
-  }
-
-  usbHidMonitorPrimeTimeout(now_us);                               // V251108R9 SOF 누락 감시 타임아웃 갱신
-
-  if (now_us < sof_monitor.holdoff_end_us)
-  {
-    sof_monitor.last_decay_us      = now_us;
-    sof_monitor.slow_last_decay_us = now_us;
-    return;
-  }
-
-  if (sof_monitor.warmup_complete == false)
-  {
-    if (sof_monitor.warmup_grace_active)
-    {
-      if (now_us <= sof_monitor.warmup_grace_deadline_us)
-      {
-        warmup_target_frames = (uint16_t)(warmup_target_frames / 2U);
-        if (warmup_target_frames == 0U)
-        {
-          warmup_target_frames = 1U;
-        }
-      }
-      else
-      {
-        sof_monitor.warmup_grace_active = false;
-      }
-    }
-
-    if (delta_us < stable_threshold)
-    {
-      if (sof_monitor.warmup_good_frames < warmup_target_frames)
-      {
-        sof_monitor.warmup_good_frames++;
-      }
-    }
-    else
-    {
-      sof_monitor.warmup_good_frames = 0U;
-    }
-
-    if (sof_monitor.warmup_good_frames >= warmup_target_frames || now_us >= sof_monitor.warmup_deadline_us)
-    {
-      sof_monitor.warmup_complete   = true;
-      sof_monitor.last_decay_us     = now_us;
-      sof_monitor.slow_last_decay_us = now_us;
-      sof_monitor.warmup_grace_active = false;
-    }
-    else
-    {
-      return;
-    }
-  }
-
-  if (delta_us < stable_threshold)
-  {
-    if (sof_monitor.score > 0U && decay_interval_us > 0U)
-    {
-      if ((now_us - sof_monitor.last_decay_us) >= decay_interval_us)
-      {
-        sof_monitor.score--;
-        sof_monitor.last_decay_us = now_us;
-      }
-    }
-
-    if (sof_monitor.slow_score > 0U && slow_decay_interval_us > 0U)
-    {
-      if ((now_us - sof_monitor.slow_last_decay_us) >= slow_decay_interval_us)
-      {
-        sof_monitor.slow_score--;
-        sof_monitor.slow_last_decay_us = now_us;
-      }
-    }
-    return;
-  }
-
-  uint32_t missed_frames = (delta_us + expected_us - 1U) / expected_us;
-  uint8_t  delta_score   = 1U;
-  uint32_t burst_points  = 0U;
-
-  if (missed_frames > 1U)
-  {
-    burst_points = missed_frames - 1U;
-  }
-
-  if (burst_points > event_score_cap)
-  {
-    burst_points = event_score_cap;
-  }
-
-  if (burst_points > 0U)
-  {
-    if (burst_points > 0xFFU)
-    {
-      burst_points = 0xFFU;
-    }
-    delta_score = (uint8_t)burst_points;
-  }
-
-  if (delta_score < 1U)
-  {
-    delta_score = 1U;
-  }
-
-  if (sof_monitor.score <= (uint8_t)(0xFFU - delta_score))
-  {
-    sof_monitor.score += delta_score;
-  }
-  else
-  {
-    sof_monitor.score = 0xFFU;
-  }
-
-  sof_monitor.last_decay_us = now_us;
-
-  if (sof_monitor.slow_score < 0xFFU)
-  {
-    sof_monitor.slow_score++;
-  }
-  sof_monitor.slow_last_decay_us = now_us;
-
-  bool need_degrade = false;
-
-  if (degrade_threshold > 0U && sof_monitor.score >= degrade_threshold)
-  {
-    need_degrade = true;
-  }
-
-  if (slow_degrade_threshold > 0U && sof_monitor.slow_score >= slow_degrade_threshold)
-  {
-    need_degrade = true;
-  }
-
-  if (need_degrade == false)
-  {
-    return;
-  }
-
-  (void)usbHidMonitorCommitDowngrade(now_us, delta_us, expected_us, USB_MONITOR_EVENT_SOF);
-}
-
-static bool usbHidMonitorCommitDowngrade(uint32_t      now_us,
-                                         uint32_t      delta_us,
-                                         uint32_t      expected_us,
-                                         usb_monitor_event_t event)
-{
-  bool downgrade_requested = false;
-  UsbBootMode_t next_mode = usbHidResolveDowngradeTarget();
-
-  if (next_mode < USB_BOOT_MODE_MAX)
-  {
-    uint32_t now_ms = millis();
-    usb_boot_downgrade_result_t request_result = usbRequestBootModeDowngrade(next_mode,
-                                                                             delta_us,
-                                                                             expected_us,
-                                                                             now_ms);
-
-    if (request_result == USB_BOOT_DOWNGRADE_ARMED || request_result == USB_BOOT_DOWNGRADE_CONFIRMED)
-    {
-      sof_monitor.holdoff_end_us = now_us + USB_BOOT_MONITOR_CONFIRM_DELAY_US;
-      downgrade_requested = true;
-    }
-    else
-    {
-      sof_monitor.holdoff_end_us = now_us + USB_SOF_MONITOR_RECOVERY_DELAY_US;
-    }
-  }
-  else
-  {
-    sof_monitor.holdoff_end_us = now_us + USB_SOF_MONITOR_RECOVERY_DELAY_US;
-  }
-
-  sof_monitor.score      = 0U;
-  sof_monitor.slow_score = 0U;
-  sof_monitor.persistent_score = 0U;
-  sof_monitor.speed_change_count = 0U;
-  sof_monitor.suspend_count = 0U;
-  sof_monitor.speed_change_window_us = 0U;            // V251109R3: 새 이벤트까지만 창 유지
-  sof_monitor.suspend_window_us = 0U;                 // V251109R3
-  sof_monitor.warmup_grace_active = false;
 #if HW_USB_LOG == 1
   if (downgrade_requested)
   {
@@ -1695,124 +1500,6 @@ static const char *usbHidMonitorEventLabel(usb_monitor_event_t event)
 }
 #endif
 
-static void usbHidMonitorBumpPersistent(uint32_t now_us, usb_monitor_event_t event)
-{
-  if (sof_monitor.persistent_score < 0xFFU)
-  {
-    sof_monitor.persistent_score++;
-  }
-
-  if (sof_monitor.persistent_threshold == 0U)
-  {
-    return;
-  }
-
-  if (sof_monitor.persistent_score >= sof_monitor.persistent_threshold)
-  {
-    uint32_t expected_us = (sof_monitor.expected_us > 0U) ? sof_monitor.expected_us : 125U;
-    uint32_t delta_us = USB_ENUM_MONITOR_ATTEMPT_TIMEOUT_US;
-
-    if (event == USB_MONITOR_EVENT_SPEED)
-    {
-      delta_us = USB_SOF_MONITOR_SPEED_WINDOW_US;
-    }
-    else if (event == USB_MONITOR_EVENT_SUSPEND)
-    {
-      delta_us = USB_SOF_MONITOR_SUSPEND_WINDOW_US;
-    }
-
-    (void)usbHidMonitorCommitDowngrade(now_us, delta_us, expected_us, event);
-  }
-}
-
-static void usbHidMonitorHandleSpeedChange(uint32_t now_us)
-{
-  if (sof_monitor.warmup_target_frames == 0U)
-  {
-    sof_monitor.speed_change_count = 0U;
-    sof_monitor.speed_change_window_us = 0U;          // V251109R3: 창 비활성화
-    return;
-  }
-
-  if (sof_monitor.speed_change_count == 0U || now_us >= sof_monitor.speed_change_window_us)
-  {
-    sof_monitor.speed_change_count = 0U;
-    sof_monitor.speed_change_window_us = now_us + USB_SOF_MONITOR_SPEED_WINDOW_US;  // V251109R3: 첫 이벤트 기준 고정 창
-  }
-
-  if (sof_monitor.warmup_complete)
-  {
-    sof_monitor.warmup_grace_active = true;
-    sof_monitor.warmup_grace_deadline_us = now_us + USB_SOF_MONITOR_WARMUP_GRACE_US;
-  }
-
-  if (sof_monitor.speed_change_count < 0xFFU)
-  {
-    sof_monitor.speed_change_count++;
-  }
-
-  if (sof_monitor.speed_change_count >= USB_SOF_MONITOR_SPEED_THRESHOLD)
-  {
-    sof_monitor.speed_change_count = 0U;
-    sof_monitor.speed_change_window_us = now_us + USB_SOF_MONITOR_SPEED_WINDOW_US;  // V251109R3: 새 창 시작
-    usbHidMonitorBumpPersistent(now_us, USB_MONITOR_EVENT_SPEED);
-  }
-}
-
-static void usbHidMonitorHandleSuspend(uint32_t now_us)
-{
-  if (sof_monitor.warmup_target_frames == 0U)
-  {
-    sof_monitor.suspend_count = 0U;
-    sof_monitor.suspend_window_us = 0U;               // V251109R3: 창 비활성화
-    return;
-  }
-
-  if (sof_monitor.suspend_count == 0U || now_us >= sof_monitor.suspend_window_us)
-  {
-    sof_monitor.suspend_count = 0U;
-    sof_monitor.suspend_window_us = now_us + USB_SOF_MONITOR_SUSPEND_WINDOW_US;  // V251109R3: 첫 이벤트 기준 창
-  }
-
-  if (sof_monitor.warmup_complete)
-  {
-    sof_monitor.warmup_grace_active = true;
-    sof_monitor.warmup_grace_deadline_us = now_us + USB_SOF_MONITOR_WARMUP_GRACE_US;
-  }
-
-  if (sof_monitor.suspend_count < 0xFFU)
-  {
-    sof_monitor.suspend_count++;
-  }
-
-  if (sof_monitor.suspend_count >= USB_SOF_MONITOR_SUSPEND_THRESHOLD)
-  {
-    sof_monitor.suspend_count = 0U;
-    sof_monitor.suspend_window_us = now_us + USB_SOF_MONITOR_SUSPEND_WINDOW_US;  // V251109R3: 새 창 시작
-    usbHidMonitorBumpPersistent(now_us, USB_MONITOR_EVENT_SUSPEND);
-  }
-}
-
-static void usbHidMonitorRefreshEventWindows(uint32_t now_us)
-{
-  if (sof_monitor.speed_change_count > 0U && now_us >= sof_monitor.speed_change_window_us)
-  {
-    sof_monitor.speed_change_count = 0U;
-    sof_monitor.speed_change_window_us = 0U;          // V251109R3: 만료 시 창 초기화
-  }
-
-  if (sof_monitor.suspend_count > 0U && now_us >= sof_monitor.suspend_window_us)
-  {
-    sof_monitor.suspend_count = 0U;
-    sof_monitor.suspend_window_us = 0U;               // V251109R3
-  }
-
-  if (sof_monitor.warmup_grace_active && now_us >= sof_monitor.warmup_grace_deadline_us)
-  {
-    sof_monitor.warmup_grace_active = false;
-  }
-}
-
 static void usbHidMonitorTrackEnumeration(uint32_t now_us,
                                           bool     monitor_enabled)
 {
@@ -1865,11 +1552,11 @@ static void usbHidMonitorTrackEnumeration(uint32_t now_us,
 
       if (monitor_enabled && enum_monitor.fail_score >= USB_ENUM_MONITOR_FAIL_THRESHOLD)
       {
-        uint32_t expected_us = (sof_monitor.expected_us > 0U) ? sof_monitor.expected_us : 125U;
-        (void)usbHidMonitorCommitDowngrade(now_us,
-                                           USB_ENUM_MONITOR_ATTEMPT_TIMEOUT_US,
-                                           expected_us,
-                                           USB_MONITOR_EVENT_ENUM);
+        (void)usbHidSofMonCommitDowngrade(&sof_monitor,
+                                          now_us,
+                                          USB_ENUM_MONITOR_ATTEMPT_TIMEOUT_US,
+                                          usbHidSofMonExpectedUs(&sof_monitor),
+                                          USB_MONITOR_EVENT_ENUM);
         enum_monitor.fail_score     = 0U;
         enum_monitor.waiting_config = false;
         enum_monitor.pending_state  = dev_state;
@@ -1900,58 +1587,58 @@ void usbHidMonitorBackgroundTick(uint32_t now_us)                    // V251108R
     return;
   }
 
-  usbHidMonitorRefreshEventWindows(now_us);
+  // V261018R9: ISR 이 쌓은 SOF 샘플을 먼저 평가해 아래 감시가 최신 기준 시각을 보게 한다.
+  usbHidSofMonDrain(&sof_monitor);
   usbHidMonitorTrackEnumeration(now_us, true);
 
   USBD_HandleTypeDef *pdev = &USBD_Device;
 
-  if (pdev->dev_state != USBD_STATE_CONFIGURED)
-  {
-    return;
-  }
+  usbHidSofMonTick(&sof_monitor,
+                   now_us,
+                   pdev->dev_state == USBD_STATE_CONFIGURED,
+                   USBD_is_suspended());
+}
 
-  if (USBD_is_suspended())
-  {
-    return;
-  }
+#endif  // USB_MONITOR_ENABLE  // V251010R5: 모니터 전용 함수 정의 범위 분리 완료
 
-  if (sof_monitor.prev_tick_us == 0U || sof_monitor.expected_us == 0U)
-  {
-    return;
-  }
 
-  if (sof_monitor.warmup_complete == false)
-  {
-    return;
-  }
+__weak void usbHidSetStatusLed(uint8_t led_bits)
+{
 
-  if (now_us < sof_monitor.no_sof_deadline_us)
-  {
-    return;
-  }
+}
 
-  uint32_t delta_us = now_us - sof_monitor.prev_tick_us;
-  sof_monitor.prev_tick_us = now_us;
+__weak void usbHidSetProtocol(uint8_t protocol)
+{
 
-  usbHidMonitorProcessDelta(now_us, delta_us);
 }
 
-#endif  // USB_MONITOR_ENABLE  // V251010R5: 모니터 전용 함수 정의 범위 분리 완료
+__weak void usbHidResendReports(void)                                 // V261018R8
+{
 
+}
 
-__weak void usbHidSetStatusLed(uint8_t led_bits)
+// ---------------------------------------------------------------------------
+// [SOF JIT] V261018R4
+//   - TIM2 는 SOF 마다 0 으로 리셋되므로 키보드 DataIn 시점의 카운터가 곧 IN 위상이다.
+//   - 잠금 후 CCR1 을 (위상 - guard) 로 옮기면 기존 백업 드레인이 그대로 JIT 적재 지점이 된다.
+//   - 변경→IN 지연은 레코드의 변경 수/시각 합으로 계산해 즉시 적재와 JIT 를 따로 집계한다.
+// ---------------------------------------------------------------------------
+static void usbHidJitApplyCompare(void)
 {
-
+  if (htim2.Instance != NULL)
+  {
+    __HAL_TIM_SET_COMPARE(&htim2, TIM_CHANNEL_1, hid_tx.jit.compare_us);
+  }
 }
 
 static uint32_t usbHidBackupTimerOffsetUs(void)
 {
   if (usbBootModeIsFullSpeed())
   {
-    return 975U;                                                   // V251012R1 FS 프레임 종료 직전 백업 전송 예약
+    return HID_TX_BACKUP_FS_US;                                    // V251012R1 FS 프레임 종료 직전 백업 전송 예약
   }
 
-  return 120U;                                                     // V251012R1 HS/uSOF 환경은 기존 120us 유지
+  return HID_TX_BACKUP_HS_US;                                      // V251012R1 HS/uSOF 환경은 기존 120us 유지
 }
 
 void usbHidInitTimer(void)
@@ -2041,41 +1728,235 @@ void HAL_TIM_PWM_PulseFinishedCallback(TIM_HandleTypeDef *htim)
 #if _DEF_ENABLE_USB_HID_TIMING_PROBE
   usbHidInstrumentationOnTimerPulse();                                 // V251009R7: 계측 타이머 후크를 조건부 실행
 #endif
-  if (qbufferAvailable(&report_q) > 0)
-  {
-    if (p_hhid->state == USBD_HID_IDLE)
-    {
+  // V261021R4: 드레인 정책은 usbd_hid_tx.c (시뮬레이터도 같은 소스를 비교 시점마다 호출)
 #if _DEF_ENABLE_USB_HID_TIMING_PROBE
-      uint32_t queued_reports = qbufferAvailable(&report_q);          // V250928R3 큐에 남은 리포트 수 기록 (계측 활성 시)
-#endif
+  uint32_t queued_reports = usbHidCoalesceAvailable(&hid_tx.kbd_q);   // V250928R3 큐에 남은 리포트 수 기록 (계측 활성 시)
 
-      qbufferRead(&report_q, (uint8_t *)hid_buf, 1);
-      USBD_HID_SendReport((uint8_t *)hid_buf, HID_KEYBOARD_REPORT_SIZE);
-#if _DEF_ENABLE_USB_HID_TIMING_PROBE
-      usbHidInstrumentationOnReportDequeued(queued_reports);           // V251009R7: 큐 처리 계측을 조건부 실행
+  if (usbHidTxDrain(&hid_tx, micros()) == true)
+  {
+    usbHidInstrumentationOnReportDequeued(queued_reports);           // V251009R7: 큐 처리 계측을 조건부 실행
+  }
+#else
+  usbHidTxDrain(&hid_tx, micros());
 #endif
+
+  return;
+}
+
+#ifdef _USE_HW_CLI
+void cliCmd(cli_args_t *args)
+{
+  // V261018R2: 병합 큐 상태는 계측 빌드 여부와 관계없이 조회한다.
+  if (args->argc >= 1 && args->isStr(0, "queue") == true)
+  {
+    usb_hid_queue_info_t info;
+
+    if (args->argc == 2 && args->isStr(1, "clear") == true)
+    {
+      usbHidCoalesceClearInfo(&hid_tx.kbd_q);
     }
+    usbHidGetQueueInfo(&info);
+    cliPrintf("hid queue %lu / %lu (최대 %lu)\n",
+              (unsigned long)info.depth,
+              (unsigned long)info.capacity,
+              (unsigned long)info.depth_max);
+    cliPrintf("  적재/병합     : %lu / %lu (강제 병합 %lu)\n",
+              (unsigned long)info.push_cnt,
+              (unsigned long)info.merge_cnt,
+              (unsigned long)info.forced_cnt);
+    cliPrintf("  대기 시간(us) : 현재 %lu / 평균 %lu / 최대 %lu (전송 %lu)\n",
+              (unsigned long)info.age_us,
+              (unsigned long)info.age_avg_us,
+              (unsigned long)info.age_max_us,
+              (unsigned long)info.pop_cnt);
+    return;
   }
 
-  if (qbufferAvailable(&report_exk_q) > 0)
+  // V261018R4: SOF 위상 고정 JIT 상태/토글
+  if (args->argc >= 1 && args->isStr(0, "jit") == true)
   {
-    if (p_hhid->state == USBD_HID_IDLE)
+    if (args->argc == 2 && args->isStr(1, "on") == true)
     {
-      exk_report_info_t report_info;
+      hid_jit_enable = true;
+      usbHidJitSetEnable(&hid_tx.jit, true);
+      usbHidJitApplyCompare();
+    }
+    else if (args->argc == 2 && args->isStr(1, "off") == true)
+    {
+      hid_jit_enable = false;
+      usbHidJitSetEnable(&hid_tx.jit, false);
+      usbHidJitApplyCompare();
+    }
+    else if (args->argc == 3 && args->isStr(1, "guard") == true)
+    {
+      usbHidJitSetGuard(&hid_tx.jit, (uint32_t)args->getData(2));
+      usbHidJitApplyCompare();
+    }
+    else if (args->argc == 2 && args->isStr(1, "clear") == true)
+    {
+      usbHidJitClearStat(&hid_tx.jit);
+    }
 
-      qbufferRead(&report_exk_q, (uint8_t *)&report_info, 1);
+    uint32_t avg_direct = usbHidJitGetAvgUs(&hid_tx.jit, HID_JIT_PATH_DIRECT);
+    uint32_t avg_jit    = usbHidJitGetAvgUs(&hid_tx.jit, HID_JIT_PATH_JIT);
+
+    cliPrintf("hid jit %s (%s), frame %lu us, poll %lu us, guard %lu us\n",
+              hid_tx.jit.enable ? "on" : "off",
+              hid_tx.jit.locked ? "locked" : "unlocked",
+              (unsigned long)hid_tx.jit.frame_us,
+              (unsigned long)usbHidTxGetPollUs(&hid_tx),                // V261021R5
+              (unsigned long)hid_tx.jit.guard_us);
+    cliPrintf("  IN 위상(us)   : %lu (폭 %lu, 창 %d 샘플)\n",
+              (unsigned long)hid_tx.jit.phase_us,
+              (unsigned long)hid_tx.jit.spread_us,
+              HID_JIT_WINDOW);
+    cliPrintf("  TIM2 비교(us) : %lu (백업 %lu)\n",
+              (unsigned long)hid_tx.jit.compare_us,
+              (unsigned long)hid_tx.jit.backup_us);
+    cliPrintf("  JIT 적재      : %lu (IN 놓침 %lu)\n",
+              (unsigned long)hid_tx.jit.load_cnt,
+              (unsigned long)hid_tx.jit.miss_cnt);
+    cliPrintf("  변경→IN(us)   : 즉시 평균 %lu / 최대 %lu (%lu), JIT 평균 %lu / 최대 %lu (%lu)\n",
+              (unsigned long)avg_direct,
+              (unsigned long)hid_tx.jit.stat[HID_JIT_PATH_DIRECT].max_us,
+              (unsigned long)hid_tx.jit.stat[HID_JIT_PATH_DIRECT].change_cnt,
+              (unsigned long)avg_jit,
+              (unsigned long)hid_tx.jit.stat[HID_JIT_PATH_JIT].max_us,
+              (unsigned long)hid_tx.jit.stat[HID_JIT_PATH_JIT].change_cnt);
+    if (hid_tx.jit.stat[HID_JIT_PATH_DIRECT].change_cnt > 0 && hid_tx.jit.stat[HID_JIT_PATH_JIT].change_cnt > 0)
+    {
+      cliPrintf("  지연 감소(us) : %ld\n", (long)avg_direct - (long)avg_jit);
+    }
+    return;
+  }
+#ifdef USB_MONITOR_ENABLE
+  // V261018R9: SOF 감시 평가 위치/일괄 평가 통계 (isr = V261018R8 까지의 ISR 평가)
+  if (args->argc >= 1 && args->isStr(0, "monitor") == true)
+  {
+    if (args->argc == 2 && args->isStr(1, "batch") == true)
+    {
+      usbHidSofMonSetBatch(&sof_monitor, true);
+    }
+    else if (args->argc == 2 && args->isStr(1, "isr") == true)
+    {
+      usbHidSofMonSetBatch(&sof_monitor, false);
+    }
+    else if (args->argc == 2 && args->isStr(1, "clear") == true)
+    {
+      usbHidSofMonClearStat(&sof_monitor);
+    }
 
-      memcpy(hid_buf_exk, report_info.buf, report_info.len);
-      USBD_HID_SendReportEXK((uint8_t *)hid_buf_exk, report_info.len);
+    cliPrintf("hid monitor %s (%s), expected %lu us\n",
+              sof_monitor.batch ? "batch" : "isr",
+              usbInstabilityIsEnabled() ? "on" : "off",
+              (unsigned long)sof_monitor.st.expected_us);
+    cliPrintf("  점수          : %u / %u (slow), 워밍업 %s\n",
+              sof_monitor.st.score,
+              sof_monitor.st.slow_score,
+              sof_monitor.st.warmup_complete ? "완료" : "진행 중");
+    cliPrintf("  적재/버림     : %lu / %lu (링 %d)\n",
+              (unsigned long)sof_monitor.push_cnt,
+              (unsigned long)sof_monitor.drop_cnt,
+              HID_SOF_MON_RING_DEPTH);
+    cliPrintf("  SOF 깨움      : %lu (%d 샘플 이상)\n",                      // V261020R7
+              (unsigned long)sof_monitor.wake_cnt,
+              HID_SOF_MON_WAKE_DEPTH);
+    cliPrintf("  평가/고속 통과: %lu / %lu, 일괄 %lu 회 (최대 %lu 샘플)\n",
+              (unsigned long)sof_monitor.eval_cnt,
+              (unsigned long)sof_monitor.fast_cnt,
+              (unsigned long)sof_monitor.batch_cnt,
+              (unsigned long)sof_monitor.batch_max);
+    cliPrintf("  최대 간격(us) : %lu, 다운그레이드 %lu\n",
+              (unsigned long)sof_monitor.gap_max_us,
+              (unsigned long)sof_monitor.downgrade_cnt);
+    if (sof_monitor.isr_cnt > 0)
+    {
+      cliPrintf("  ISR(cycle)    : 평균 %lu / 최대 %lu\n",
+                (unsigned long)(sof_monitor.isr_cycle_sum / sof_monitor.isr_cnt),
+                (unsigned long)sof_monitor.isr_cycle_max);
     }
+    return;
   }
+#endif
+  // V261018R6: VIA 파이프라인 상태/모드 (legacy = 20ms 게이트 + 요청 1개)
+  if (args->argc >= 1 && args->isStr(0, "via") == true)
+  {
+    if (args->argc == 2 && args->isStr(1, "legacy") == true)
+    {
+      usbHidViaSetMode(&via_report, HID_VIA_LEGACY_GATE_MS, HID_VIA_LEGACY_WINDOW);
+    }
+    else if (args->argc >= 2 && args->isStr(1, "pipe") == true)
+    {
+      uint32_t window = args->argc == 3 ? (uint32_t)args->getData(2) : HW_USB_VIA_WINDOW;
 
-  return;
-}
+      usbHidViaSetMode(&via_report, 0, window);
+    }
+    else if (args->argc == 2 && args->isStr(1, "clear") == true)
+    {
+      usbHidViaClearStat(&via_report);
+    }
 
-#ifdef _USE_HW_CLI
-void cliCmd(cli_args_t *args)
-{
+    cliPrintf("hid via %s, window %lu, gate %lu ms\n",
+              via_report.gate_ms > 0 ? "legacy" : "pipe",
+              (unsigned long)via_report.window,
+              (unsigned long)via_report.gate_ms);
+    cliPrintf("  요청/응답     : %lu / %lu (대기 응답 %lu)\n",
+              (unsigned long)via_report.rx_cnt,
+              (unsigned long)via_report.tx_cnt,
+              (unsigned long)usbHidViaAvailable(&via_report));
+    cliPrintf("  처리 중 요청  : %lu (최대 %lu), OUT NAK 유지 %lu\n",
+              (unsigned long)via_report.pending,
+              (unsigned long)via_report.pending_max,
+              (unsigned long)via_report.hold_cnt);
+    return;
+  }
+  // V261019R1: 원격 깨우기 단계/보관 리포트 통계
+  if (args->argc == 1 && args->isStr(0, "wakeup") == true)
+  {
+    static const char *stage_str[] = {"idle", "signal", "resume"};
+
+    cliPrintf("hid wakeup %s, signal %lu ms, timeout %lu ms\n",
+              stage_str[hid_wakeup.stage],
+              (unsigned long)hid_wakeup.signal_ms,
+              (unsigned long)hid_wakeup.timeout_ms);
+    cliPrintf("  깨우기/실패   : %lu / %lu, 마지막 재개 %lu ms\n",
+              (unsigned long)hid_wakeup.wake_cnt,
+              (unsigned long)hid_wakeup.timeout_cnt,
+              (unsigned long)hid_wakeup.resume_ms);
+    cliPrintf("  보관/재전송   : %lu / %lu (대기 %lu)\n",
+              (unsigned long)hid_wakeup.push_cnt,
+              (unsigned long)hid_wakeup.replay_cnt,
+              (unsigned long)usbHidWakeUpAvailable(&hid_wakeup));
+    cliPrintf("  덮어씀/버림   : %lu / %lu\n",
+              (unsigned long)hid_wakeup.merge_cnt,
+              (unsigned long)hid_wakeup.drop_cnt);
+    return;
+  }
+#ifdef _USE_HW_LATENCY
+  // V261019R2: 캡처 → IN 완료 구간별 지연 히스토그램
+  if (args->argc >= 1 && args->isStr(0, "latency") == true)
+  {
+    if (args->argc == 2 && args->isStr(1, "on") == true)
+    {
+      latencySetEnable(true);
+    }
+    else if (args->argc == 2 && args->isStr(1, "off") == true)
+    {
+      latencySetEnable(false);
+    }
+    else if (args->argc == 2 && args->isStr(1, "clear") == true)
+    {
+      latencyClear();
+    }
+    else if (args->argc == 3 && args->isStr(1, "his") == true)
+    {
+      latencyPrintHist((latency_stage_t)args->getData(2));
+      return;
+    }
+    latencyPrintInfo();
+    return;
+  }
+#endif
   usbHidInstrumentationHandleCli(args);
 }
 #endif
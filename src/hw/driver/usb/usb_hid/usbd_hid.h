@@ -52,14 +52,18 @@ extern "C" {
 #define HID_EXK_EP_IN                                   0x85U
 #define HID_EXK_EP_SIZE                                 8U
 
+#define HID_NKRO_EP_IN                                  0x86U   // V261018R1: NKRO 비트맵 리포트 전용 IN EP
+#define HID_NKRO_EP_SIZE                                32U
+
 #define HID_KEYBOARD
-#define USB_HID_CONFIG_DESC_SIZ                         91U  
+#define USB_HID_CONFIG_DESC_SIZ                         116U    // V261018R1: NKRO 인터페이스(25B) 추가
 #define USB_HID_DESC_SIZ                                9U
 
 #define HID_MOUSE_REPORT_DESC_SIZE                      74U
 #define HID_KEYBOARD_REPORT_DESC_SIZE                   64U
 #define HID_KEYBOARD_VIA_REPORT_DESC_SIZE               34U
 #define HID_EXK_REPORT_DESC_SIZE                        50U
+#define HID_NKRO_REPORT_DESC_SIZE                       35U     // V261018R1
 
 #define HID_DESCRIPTOR_TYPE                             0x21U
 #define HID_REPORT_DESC                                 0x22U
@@ -92,12 +96,13 @@ typedef enum
 } USBD_HID_StateTypeDef;
 
 
+#define HID_IN_EP_NUM_MAX                               8U      // V261018R3: IN EP 번호(0~7)별 전송 상태 슬롯
+
 typedef struct
 {
   uint32_t Protocol;
   uint32_t IdleState;
-  uint32_t AltSetting;
-  USBD_HID_StateTypeDef state;
+  uint32_t AltSetting;                                          // V261021R4: IN EP 전송 상태는 usbd_hid_tx.c 의 hid_tx_t 로 이동
 } USBD_HID_HandleTypeDef;
 
 /*
@@ -164,13 +169,32 @@ typedef struct
   uint32_t queue_depth_max;  // V250928R3 폴링 지연 당시 대기 중이던 큐 길이 최대값
 } usb_hid_rate_info_t;
 
-bool usbHidSetViaReceiveFunc(void (*func)(uint8_t *, uint8_t));
+typedef struct
+{
+  uint32_t depth;            // V261018R2 현재 대기 중인 전이 레코드 수
+  uint32_t depth_max;
+  uint32_t capacity;
+  uint32_t push_cnt;         // V261018R2 엔드포인트 busy 로 큐 경로를 탄 리포트 수
+  uint32_t merge_cnt;        // V261018R2 꼬리 레코드에 병합된 리포트 수
+  uint32_t forced_cnt;       // V261018R2 큐가 가득 차 강제 병합된 수 (중간 전이 손실)
+  uint32_t age_us;           // V261018R2 가장 오래된 대기 레코드의 현재 나이
+  uint32_t age_max_us;       // V261018R2 전송 시점 기준 최대 대기 시간
+  uint32_t pop_cnt;          // V261018R3 큐를 거쳐 전송된 레코드 수
+  uint32_t age_avg_us;       // V261018R3 큐를 거쳐 전송된 레코드의 평균 대기 시간
+} usb_hid_queue_info_t;
+
+bool usbHidSetViaReceiveFunc(bool (*func)(uint8_t *, uint8_t));     // V261020R4: func 는 요청을 큐에 실었으면 true
 bool usbHidEnqueueViaResponse(const uint8_t *p_data, uint8_t length);  // V251108R8: VIA 응답을 메인 루프에서 큐잉
 bool usbHidSendReport(uint8_t *p_data, uint16_t length);
 bool usbHidSendReportEXK(uint8_t *p_data, uint16_t length);
+bool usbHidSendReportNKRO(uint8_t *p_data, uint16_t length);    // V261018R1: NKRO 인터페이스 전송
 bool usbHidGetRateInfo(usb_hid_rate_info_t *p_info);
+bool usbHidGetQueueInfo(usb_hid_queue_info_t *p_info);           // V261018R2: 키보드 리포트 병합 큐 상태
 bool usbHidSetTimeLog(uint16_t index, uint32_t time_us);
 void usbHidSetStatusLed(uint8_t led_bits);
+void usbHidSetProtocol(uint8_t protocol);                       // V261018R1: 키보드 인터페이스 SET_PROTOCOL 통지 (0=Boot, 1=Report)
+void usbHidResendReports(void);                                 // V261018R8: 재열거 후 현재 키/확장 키 상태 재전송 (host.c)
+void usbHidWakeUpProcess(void);                                 // V261019R1: 원격 깨우기 단계 진행 + 재개 후 보관 리포트 재전송 (idle_task)
 #ifdef USB_MONITOR_ENABLE
 void usbHidMonitorBackgroundService(void);                      // V251124R1: 런타임 토글을 반영한 백그라운드 진입점
 void usbHidMonitorBackgroundTick(uint32_t now_us);              // V251108R9 SOF 중단 감시 진입점
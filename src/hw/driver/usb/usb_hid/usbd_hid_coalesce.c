@@ -0,0 +1,215 @@
+#include "usbd_hid_coalesce.h"
+
+#include <string.h>
+
+
+// ---------------------------------------------------------------------------
+// [Report Coalesce] V261018R2
+//   - 리포트 = mods(1) + reserved(1) + keys[HW_KEYS_PRESS_MAX]. mods 는 비트, keys 는 집합으로 본다.
+//   - base(꼬리 직전 상태) → tail → new 에서 어떤 키/모디파이어도 두 번 바뀌지 않으면
+//     tail 을 new 로 덮어써도 호스트가 보는 전이(눌림/뗌)는 하나도 사라지지 않는다.
+//   - 두 번 바뀌는 키(탭이 폴링 주기 안에 끝난 경우)가 있을 때만 새 레코드를 쌓는다.
+//   - 큐가 가득 차면 마지막 상태를 잃지 않도록 꼬리에 강제 병합하고 forced_cnt 로 집계한다.
+//   - 꼬리 수정은 TIM2 드레인과 겹치지 않도록 짧은 임계 구역에서 처리한다.
+// ---------------------------------------------------------------------------
+#define HID_COALESCE_KEY_OFFSET   2U
+
+
+
+
+static bool usbHidCoalesceHasKey(const uint8_t *p_report, uint8_t key)
+{
+  for (uint32_t i=HID_COALESCE_KEY_OFFSET; i<HID_KEYBOARD_REPORT_SIZE; i++)
+  {
+    if (p_report[i] == key)
+    {
+      return true;
+    }
+  }
+  return false;
+}
+
+static void usbHidCoalesceMergeTail(hid_coalesce_rec_t *p_tail, const uint8_t *p_new, bool changed, uint32_t now_us)
+{
+  memcpy(p_tail->buf, p_new, HID_KEYBOARD_REPORT_SIZE);
+  if (changed == true)
+  {
+    p_tail->change_cnt++;
+    p_tail->change_sum_us += now_us;
+  }
+}
+
+void usbHidCoalesceInit(hid_coalesce_t *p_q)
+{
+  qringCreate(&p_q->q, p_q->rec, sizeof(hid_coalesce_rec_t), HID_COALESCE_DEPTH);
+  memset(p_q->sent, 0, sizeof(p_q->sent));
+  memset(&p_q->last, 0, sizeof(p_q->last));
+  usbHidCoalesceClearInfo(p_q);
+}
+
+bool usbHidCoalesceCanMerge(const uint8_t *p_base, const uint8_t *p_tail, const uint8_t *p_new)
+{
+  // 모디파이어: base→tail 과 tail→new 에서 같은 비트가 모두 바뀌면 병합 불가
+  if (((p_base[0] ^ p_tail[0]) & (p_tail[0] ^ p_new[0])) != 0)
+  {
+    return false;
+  }
+
+  for (uint32_t i=HID_COALESCE_KEY_OFFSET; i<HID_KEYBOARD_REPORT_SIZE; i++)
+  {
+    uint8_t key;
+
+    // tail 에서 눌린 키가 new 에서 바로 떼어짐
+    key = p_tail[i];
+    if (key != 0 && usbHidCoalesceHasKey(p_base, key) != true && usbHidCoalesceHasKey(p_new, key) != true)
+    {
+      return false;
+    }
+
+    // tail 에서 떼어진 키가 new 에서 다시 눌림
+    key = p_base[i];
+    if (key != 0 && usbHidCoalesceHasKey(p_tail, key) != true && usbHidCoalesceHasKey(p_new, key) == true)
+    {
+      return false;
+    }
+  }
+  return true;
+}
+
+void usbHidCoalescePush(hid_coalesce_t *p_q, const uint8_t *p_data, uint16_t length, uint32_t now_us)
+{
+  uint8_t new_buf[HID_KEYBOARD_REPORT_SIZE] = {0, };
+
+  if (length > HID_KEYBOARD_REPORT_SIZE)
+  {
+    length = HID_KEYBOARD_REPORT_SIZE;
+  }
+  memcpy(new_buf, p_data, length);
+
+  __disable_irq();
+  uint32_t avail = qringAvailable(&p_q->q);
+
+  p_q->push_cnt++;
+  if (avail == 0)
+  {
+    if (memcmp(p_q->sent, new_buf, HID_KEYBOARD_REPORT_SIZE) == 0)
+    {
+      p_q->merge_cnt++;                                               // 전송 중인 상태와 같으면 쌓을 필요 없음
+    }
+    else
+    {
+      hid_coalesce_rec_t *p_rec = qringReserve(&p_q->q);
+
+      p_rec->time_us       = now_us;
+      p_rec->change_cnt    = 1;
+      p_rec->change_sum_us = now_us;
+      memcpy(p_rec->buf, new_buf, HID_KEYBOARD_REPORT_SIZE);
+      qringCommit(&p_q->q);
+      avail = 1;
+    }
+  }
+  else
+  {
+    hid_coalesce_rec_t *p_tail = qringPeekAt(&p_q->q, avail - 1);
+    const uint8_t      *p_base = avail >= 2 ? ((hid_coalesce_rec_t *)qringPeekAt(&p_q->q, avail - 2))->buf : p_q->sent;
+
+    bool changed = memcmp(p_tail->buf, new_buf, HID_KEYBOARD_REPORT_SIZE) != 0;
+
+    if (usbHidCoalesceCanMerge(p_base, p_tail->buf, new_buf) == true)
+    {
+      usbHidCoalesceMergeTail(p_tail, new_buf, changed, now_us);
+      p_q->merge_cnt++;
+    }
+    else if (avail >= HID_COALESCE_DEPTH)
+    {
+      usbHidCoalesceMergeTail(p_tail, new_buf, changed, now_us);     // 최종 상태 우선, 중간 전이 쌍은 손실
+      p_q->forced_cnt++;
+    }
+    else
+    {
+      hid_coalesce_rec_t *p_rec = qringReserve(&p_q->q);
+
+      p_rec->time_us       = now_us;
+      p_rec->change_cnt    = 1;
+      p_rec->change_sum_us = now_us;
+      memcpy(p_rec->buf, new_buf, HID_KEYBOARD_REPORT_SIZE);
+      qringCommit(&p_q->q);
+      avail++;
+    }
+  }
+
+  if (avail > p_q->depth_max)
+  {
+    p_q->depth_max = avail;
+  }
+  __enable_irq();
+}
+
+// 큐가 비어 있을 때 바로 전송한 리포트를 병합 기준 상태로 기록한다.
+void usbHidCoalesceMarkSent(hid_coalesce_t *p_q, const uint8_t *p_data, uint16_t length)
+{
+  if (length > HID_KEYBOARD_REPORT_SIZE)
+  {
+    length = HID_KEYBOARD_REPORT_SIZE;
+  }
+  memset(p_q->sent, 0, sizeof(p_q->sent));
+  memcpy(p_q->sent, p_data, length);
+}
+
+bool usbHidCoalescePop(hid_coalesce_t *p_q, uint8_t *p_data, uint32_t now_us)
+{
+  hid_coalesce_rec_t *p_rec = qringPeek(&p_q->q);
+
+  if (p_rec == NULL)
+  {
+    return false;
+  }
+
+  uint32_t age_us = now_us - p_rec->time_us;
+
+  if (age_us > p_q->age_max_us)
+  {
+    p_q->age_max_us = age_us;
+  }
+  p_q->age_sum_us += age_us;
+  p_q->pop_cnt++;
+  memcpy(p_data, p_rec->buf, HID_KEYBOARD_REPORT_SIZE);
+  memcpy(p_q->sent, p_rec->buf, HID_KEYBOARD_REPORT_SIZE);
+  p_q->last = *p_rec;
+  qringRelease(&p_q->q, 1);
+  return true;
+}
+
+uint32_t usbHidCoalesceAvailable(hid_coalesce_t *p_q)
+{
+  return qringAvailable(&p_q->q);
+}
+
+void usbHidCoalesceGetInfo(hid_coalesce_t *p_q, usb_hid_queue_info_t *p_info, uint32_t now_us)
+{
+  __disable_irq();
+  hid_coalesce_rec_t *p_rec = qringPeek(&p_q->q);
+
+  p_info->depth      = qringAvailable(&p_q->q);
+  p_info->depth_max  = p_q->depth_max;
+  p_info->capacity   = HID_COALESCE_DEPTH;
+  p_info->push_cnt   = p_q->push_cnt;
+  p_info->merge_cnt  = p_q->merge_cnt;
+  p_info->forced_cnt = p_q->forced_cnt;
+  p_info->age_us     = p_rec != NULL ? now_us - p_rec->time_us : 0;
+  p_info->age_max_us = p_q->age_max_us;
+  p_info->pop_cnt    = p_q->pop_cnt;
+  p_info->age_avg_us = p_q->pop_cnt > 0 ? (uint32_t)(p_q->age_sum_us / p_q->pop_cnt) : 0;
+  __enable_irq();
+}
+
+void usbHidCoalesceClearInfo(hid_coalesce_t *p_q)
+{
+  p_q->push_cnt   = 0;
+  p_q->merge_cnt  = 0;
+  p_q->forced_cnt = 0;
+  p_q->depth_max  = 0;
+  p_q->age_max_us = 0;
+  p_q->pop_cnt    = 0;
+  p_q->age_sum_us = 0;
+}
@@ -0,0 +1,55 @@
+#pragma once
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "qring.h"
+#include "usbd_hid.h"
+#include "usbd_hid_internal.h"
+
+
+// V261018R2: 키보드 리포트 상태 병합 큐
+//   - 엔드포인트가 바쁠 때 쌓이는 스냅샷 중 엣지를 잃지 않는 연속 상태는 꼬리 레코드에 병합한다.
+//   - 레코드 하나는 직전 레코드 대비 최소 1개의 되돌릴 수 없는 전이를 담으므로 깊이는 전이 수로 제한된다.
+//   - 레지스터 비의존 코드라 호스트 시뮬레이터도 같은 소스를 빌드한다.
+#define HID_COALESCE_DEPTH        32                  // 대기 가능한 전이 레코드 수 (2^n)
+
+
+typedef struct
+{
+  uint32_t time_us;                                   // 레코드 최초 적재 시각 (병합돼도 유지)
+  uint32_t change_cnt;                                // V261018R4: 병합된 상태 변경 수
+  uint32_t change_sum_us;                             // V261018R4: 변경 시각 합 (변경→IN 지연 계산용, wrap 허용)
+  uint8_t  buf[HID_KEYBOARD_REPORT_SIZE];
+} hid_coalesce_rec_t;
+
+typedef struct
+{
+  qring_t            q;
+  hid_coalesce_rec_t rec[HID_COALESCE_DEPTH];
+  uint8_t            sent[HID_KEYBOARD_REPORT_SIZE];  // 마지막으로 엔드포인트에 넘긴 상태
+
+  uint32_t           push_cnt;
+  uint32_t           merge_cnt;
+  uint32_t           forced_cnt;
+  uint32_t           depth_max;
+  uint32_t           age_max_us;
+  uint32_t           pop_cnt;                         // V261018R3: 큐를 거쳐 전송된 레코드 수
+  uint64_t           age_sum_us;                      // V261018R3: 평균 대기 시간 계산용
+  hid_coalesce_rec_t last;                            // V261018R4: 마지막으로 꺼낸 레코드 (buf 제외 통계용)
+} hid_coalesce_t;
+
+
+void     usbHidCoalesceInit(hid_coalesce_t *p_q);
+bool     usbHidCoalesceCanMerge(const uint8_t *p_base, const uint8_t *p_tail, const uint8_t *p_new);
+
+// 생산자 (메인 루프)
+void     usbHidCoalescePush(hid_coalesce_t *p_q, const uint8_t *p_data, uint16_t length, uint32_t now_us);
+void     usbHidCoalesceMarkSent(hid_coalesce_t *p_q, const uint8_t *p_data, uint16_t length);
+
+// 소비자 (TIM2 ISR)
+bool     usbHidCoalescePop(hid_coalesce_t *p_q, uint8_t *p_data, uint32_t now_us);
+uint32_t usbHidCoalesceAvailable(hid_coalesce_t *p_q);
+
+void     usbHidCoalesceGetInfo(hid_coalesce_t *p_q, usb_hid_queue_info_t *p_info, uint32_t now_us);
+void     usbHidCoalesceClearInfo(hid_coalesce_t *p_q);
@@ -48,6 +48,12 @@ static volatile uint32_t timer_pulse_total = 0;              // V251010R8: TIM2
 static volatile uint32_t timer_sof_offset_us = 0;            // V251010R8: TIM2 펄스 시점의 SOF 기준 지연(us)
 static volatile uint32_t sof_total = 0;                      // V251010R8: SOF 누적 카운트
 
+static volatile uint32_t otg_isr_cycle_uf = 0;               // V261018R5: 현재 (마이크로)프레임 OTG ISR 사이클 합
+static uint32_t otg_isr_cycle_sum = 0;                       // V261018R5: 윈도우 내 합
+static uint32_t otg_isr_cycle_max_check = 0;
+static uint32_t otg_isr_cycle_avg = 0;                       // V261018R5: 프레임당 평균 (윈도우 라치)
+static uint32_t otg_isr_cycle_max = 0;                       // V261018R5: 프레임당 최대 (윈도우 라치)
+
 static uint32_t usbHidExpectedPollIntervalUs(void);
 
 #endif
@@ -74,6 +80,16 @@ void usbHidInstrumentationOnSof(uint32_t now_us)
   }
   rate_time_sof_pre = now_us;
   sof_total++;                                                  // V251010R8: SOF 누적 카운트를 타이머와 분리 추적
+
+  // V261018R5: 직전 프레임의 OTG ISR 사이클을 닫는다. 이번 SOF ISR 자신은 다음 프레임으로 집계된다.
+  uint32_t isr_cycles = otg_isr_cycle_uf;
+
+  otg_isr_cycle_uf = 0;
+  otg_isr_cycle_sum += isr_cycles;
+  if (isr_cycles > otg_isr_cycle_max_check)
+  {
+    otg_isr_cycle_max_check = isr_cycles;
+  }
   if (sample_cnt >= sample_window)
   {
     sample_cnt = 0;
@@ -90,6 +106,10 @@ void usbHidInstrumentationOnSof(uint32_t now_us)
     }
     rate_time_excess_max = rate_time_excess_max_check;               // V251009R9: 폴링 초과 지연을 윈도우 경계에서 라치
     rate_queue_depth_max = rate_queue_depth_max_check;
+    otg_isr_cycle_avg = otg_isr_cycle_sum / sample_window;          // V261018R5
+    otg_isr_cycle_max = otg_isr_cycle_max_check;
+    otg_isr_cycle_sum = 0;
+    otg_isr_cycle_max_check = 0;
     data_in_cnt = 0;
 
     rate_time_min_check = 0xFFFF;
@@ -110,6 +130,11 @@ void usbHidInstrumentationOnTimerPulse(void)
   }
 }
 
+void usbHidInstrumentationOnOtgIsr(uint32_t cycles)
+{
+  otg_isr_cycle_uf += cycles;
+}
+
 void usbHidInstrumentationOnDataIn(void)
 {
   data_in_cnt++;
@@ -310,6 +335,12 @@ void usbHidInstrumentationHandleCli(cli_args_t *args)
                   (long)timer_diff,
                   (unsigned long)rate_time_sof,
                   (unsigned long)timer_sof_offset_us);
+        cliPrintf("  OTG ISR/프레임: 평균 %lu / 최대 %lu cycles (%lu / %lu ns, %s)\n",   // V261018R5: PIO/DMA 빌드 비교
+                  (unsigned long)otg_isr_cycle_avg,
+                  (unsigned long)otg_isr_cycle_max,
+                  (unsigned long)((uint64_t)otg_isr_cycle_avg * 1000U / (SystemCoreClock / 1000000U)),
+                  (unsigned long)((uint64_t)otg_isr_cycle_max * 1000U / (SystemCoreClock / 1000000U)),
+                  HW_USB_OTG_DMA == 1 ? "DMA" : "PIO");
 
         uint32_t recent_count = (key_time_cnt < 10U) ? key_time_cnt : 10U;
         if (recent_count > 0U)
@@ -407,10 +438,20 @@ void usbHidInstrumentationHandleCli(cli_args_t *args)
     cliPrintf("usbhid rate his\n");
     cliPrintf("usbhid log\n");
     cliPrintf("usbhid log clear\n");
+    cliPrintf("usbhid queue [clear]\n");                                  // V261018R2
+    cliPrintf("usbhid jit [on|off|guard us|clear]\n");                   // V261018R4
+    cliPrintf("usbhid via [legacy|pipe [window]|clear]\n");              // V261018R6
+    cliPrintf("usbhid wakeup\n");                                        // V261019R1
+#ifdef _USE_HW_LATENCY
+    cliPrintf("usbhid latency [on|off|clear|his 0~5]\n");               // V261019R2
+#endif
   }
 #else
   (void)args;
   cliPrintf("usbhid 계측이 비활성화되었습니다 (_DEF_ENABLE_USB_HID_TIMING_PROBE=0). USB 불안정성 감지는 계속 동작합니다.\n"); // V251009R5: 릴리스 빌드 안내 메시지
+#ifdef _USE_HW_LATENCY
+  cliPrintf("usbhid latency [on|off|clear|his 0~5]\n");                 // V261019R2: 구간 지연 계측은 릴리스 빌드에서도 동작
+#endif
 #endif
 #else
   (void)args;
@@ -18,6 +18,7 @@ void     usbHidInstrumentationOnReportDequeued(uint32_t queued_reports);
 void     usbHidInstrumentationOnImmediateSendSuccess(uint32_t queued_reports);
 void     usbHidInstrumentationMarkReportStart(void);
 void     usbHidMeasureRateTime(void);
+void     usbHidInstrumentationOnOtgIsr(uint32_t cycles);    // V261018R5: OTG_HS_IRQHandler 실행 사이클
 
 #else
 
@@ -67,6 +68,11 @@ static inline void usbHidMeasureRateTime(void)
   // V251010R1: 릴리스 빌드에서 폴링 간격 측정 비활성화
 }
 
+static inline void usbHidInstrumentationOnOtgIsr(uint32_t cycles)
+{
+  (void)cycles;  // V261018R5: 릴리스 빌드에서 ISR 사이클 집계 제거
+}
+
 #endif
 
 void     usbHidInstrumentationHandleCli(cli_args_t *args);
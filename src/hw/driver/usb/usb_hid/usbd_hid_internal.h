@@ -3,4 +3,5 @@
 #include "hw_def.h"
 
 #define HID_KEYBOARD_REPORT_SIZE (HW_KEYS_PRESS_MAX + 2U)
+#define HID_KEYBOARD_BOOT_REPORT_SIZE 8U  // V261018R1: Boot 프로토콜 리포트 (mods, reserved, keys[6])
 #define KEY_TIME_LOG_MAX         32  // V251009R9: 계측 모듈과 본체에서 공유
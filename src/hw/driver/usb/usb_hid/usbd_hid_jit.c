@@ -0,0 +1,140 @@
+#include "usbd_hid_jit.h"
+
+#include <string.h>
+
+
+// ---------------------------------------------------------------------------
+// [SOF JIT] V261018R4
+//   - 호스트는 마이크로프레임마다 거의 같은 위치에서 키보드 EP 에 IN 토큰을 보낸다.
+//     DataIn 완료 오프셋의 창 최소값을 IN 위상으로 잡으면 모든 샘플보다 앞선 적재 기준이 된다.
+//   - 변경 즉시 적재하면 SOF 직후 실린 리포트가 IN 까지 FIFO 에 머물고, 그 사이 생긴 변경은
+//     다음 프레임으로 밀린다. JIT 는 (위상 - guard) 까지 병합 큐에 모았다가 한 번에 적재한다.
+//   - 위상이 guard 보다 앞서거나(SOF 직후 IN) 창이 비정상이면 잠금을 풀고 기존 동작으로 돌아간다.
+// ---------------------------------------------------------------------------
+
+
+
+
+static void usbHidJitResetWindow(hid_jit_t *p_jit)
+{
+  p_jit->win_cnt = 0;
+  p_jit->win_min = UINT32_MAX;
+  p_jit->win_max = 0;
+}
+
+static void usbHidJitUpdateCompare(hid_jit_t *p_jit)
+{
+  if (p_jit->enable == true && p_jit->locked == true)
+  {
+    p_jit->compare_us = p_jit->phase_us - p_jit->guard_us;
+  }
+  else
+  {
+    p_jit->compare_us = p_jit->backup_us;
+  }
+}
+
+void usbHidJitInit(hid_jit_t *p_jit, bool enable, uint32_t frame_us, uint32_t guard_us, uint32_t backup_us)
+{
+  memset(p_jit, 0, sizeof(hid_jit_t));
+
+  p_jit->enable    = enable;
+  p_jit->frame_us  = frame_us;
+  p_jit->guard_us  = guard_us;
+  p_jit->backup_us = backup_us;
+  usbHidJitResetWindow(p_jit);
+  usbHidJitUpdateCompare(p_jit);
+}
+
+void usbHidJitSetEnable(hid_jit_t *p_jit, bool enable)
+{
+  p_jit->enable = enable;
+  usbHidJitUpdateCompare(p_jit);
+}
+
+// guard 가 바뀌면 다음 창에서 다시 잠근다.
+void usbHidJitSetGuard(hid_jit_t *p_jit, uint32_t guard_us)
+{
+  p_jit->guard_us = guard_us;
+  p_jit->locked   = false;
+  usbHidJitResetWindow(p_jit);
+  usbHidJitUpdateCompare(p_jit);
+}
+
+// 키보드 EP DataIn 마다 SOF 기준 오프셋을 넣는다. 비교 시점이 바뀌면 true.
+bool usbHidJitSample(hid_jit_t *p_jit, uint32_t offset_us)
+{
+  uint32_t compare_pre = p_jit->compare_us;
+
+  if (offset_us >= p_jit->frame_us)
+  {
+    return false;                                                     // SOF 누락 등으로 카운터가 프레임을 넘김
+  }
+
+  if (offset_us < p_jit->win_min)
+  {
+    p_jit->win_min = offset_us;
+  }
+  if (offset_us > p_jit->win_max)
+  {
+    p_jit->win_max = offset_us;
+  }
+  p_jit->win_cnt++;
+
+  if (p_jit->win_cnt >= HID_JIT_WINDOW)
+  {
+    p_jit->phase_us  = p_jit->win_min;
+    p_jit->spread_us = p_jit->win_max - p_jit->win_min;
+    p_jit->locked    = p_jit->phase_us >= p_jit->guard_us + HID_JIT_COMPARE_MIN_US;
+    usbHidJitResetWindow(p_jit);
+    usbHidJitUpdateCompare(p_jit);
+  }
+
+  return p_jit->compare_us != compare_pre;
+}
+
+bool usbHidJitIsActive(const hid_jit_t *p_jit)
+{
+  return p_jit->enable == true && p_jit->locked == true;
+}
+
+// JIT 중에는 비교 시점 ~ IN 위상 사이에만 바로 적재한다. 그 전 변경은 비교 시점까지 병합하고,
+// 위상 이후 변경은 이번 IN 에 실릴 수 없으므로 다음 프레임 비교 시점까지 모은다.
+bool usbHidJitCanLoadNow(const hid_jit_t *p_jit, uint32_t offset_us)
+{
+  if (usbHidJitIsActive(p_jit) != true)
+  {
+    return true;
+  }
+  return offset_us >= p_jit->compare_us && offset_us < p_jit->phase_us;
+}
+
+void usbHidJitAddLatency(hid_jit_t *p_jit, hid_jit_path_t path, uint32_t change_cnt, uint32_t sum_us, uint32_t max_us)
+{
+  hid_jit_stat_t *p_stat = &p_jit->stat[path];
+
+  p_stat->change_cnt += change_cnt;
+  p_stat->sum_us     += sum_us;
+  if (max_us > p_stat->max_us)
+  {
+    p_stat->max_us = max_us;
+  }
+}
+
+uint32_t usbHidJitGetAvgUs(const hid_jit_t *p_jit, hid_jit_path_t path)
+{
+  const hid_jit_stat_t *p_stat = &p_jit->stat[path];
+
+  if (p_stat->change_cnt == 0)
+  {
+    return 0;
+  }
+  return (uint32_t)(p_stat->sum_us / p_stat->change_cnt);
+}
+
+void usbHidJitClearStat(hid_jit_t *p_jit)
+{
+  p_jit->load_cnt = 0;
+  p_jit->miss_cnt = 0;
+  memset(p_jit->stat, 0, sizeof(p_jit->stat));
+}
@@ -0,0 +1,60 @@
+#pragma once
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "hw_def.h"
+
+
+// V261018R4: SOF 위상 고정 JIT(Just-In-Time) 키보드 리포트 적재
+//   - 키보드 EP DataIn 완료 시각(SOF 기준 오프셋)으로 호스트 IN 토큰 위상을 학습한다.
+//   - 학습이 끝나면 TIM2 비교 시점을 (위상 - guard) 로 옮겨 그 직전까지의 최신 상태를 적재한다.
+//   - 레지스터 비의존 코드라 호스트 시뮬레이터도 같은 소스를 빌드한다.
+#define HID_JIT_WINDOW            64                  // 위상 학습 창 (DataIn 샘플 수)
+#define HID_JIT_COMPARE_MIN_US    5                   // SOF 직후 TIM2 비교는 의미가 없어 JIT 를 쓰지 않음
+
+
+typedef enum
+{
+  HID_JIT_PATH_DIRECT = 0,                            // 변경 즉시 적재 (기존 동작)
+  HID_JIT_PATH_JIT,                                   // 위상 직전 적재
+  HID_JIT_PATH_MAX
+} hid_jit_path_t;
+
+typedef struct
+{
+  uint32_t change_cnt;                                // IN 으로 전달된 상태 변경 수
+  uint64_t sum_us;                                    // 변경 → IN 완료 지연 합
+  uint32_t max_us;
+} hid_jit_stat_t;
+
+typedef struct
+{
+  bool           enable;
+  bool           locked;                              // 위상 학습 완료 + JIT 적용 가능
+  uint32_t       frame_us;                            // SOF 주기 (HS 125, FS 1000)
+  uint32_t       guard_us;
+  uint32_t       backup_us;                           // 학습 전/비활성 시 TIM2 비교 시점
+  uint32_t       phase_us;                            // 학습된 IN 완료 위상 (창 최소값)
+  uint32_t       spread_us;                           // 창 내 최대 - 최소
+  uint32_t       compare_us;                          // 적용 중인 TIM2 비교 시점
+
+  uint32_t       win_cnt;
+  uint32_t       win_min;
+  uint32_t       win_max;
+
+  uint32_t       load_cnt;                            // JIT 경로 적재 수
+  uint32_t       miss_cnt;                            // JIT 적재 후 한 프레임 안에 IN 이 오지 않은 수
+  hid_jit_stat_t stat[HID_JIT_PATH_MAX];
+} hid_jit_t;
+
+
+void     usbHidJitInit(hid_jit_t *p_jit, bool enable, uint32_t frame_us, uint32_t guard_us, uint32_t backup_us);
+void     usbHidJitSetEnable(hid_jit_t *p_jit, bool enable);
+void     usbHidJitSetGuard(hid_jit_t *p_jit, uint32_t guard_us);
+bool     usbHidJitSample(hid_jit_t *p_jit, uint32_t offset_us);
+bool     usbHidJitIsActive(const hid_jit_t *p_jit);
+bool     usbHidJitCanLoadNow(const hid_jit_t *p_jit, uint32_t offset_us);
+void     usbHidJitAddLatency(hid_jit_t *p_jit, hid_jit_path_t path, uint32_t change_cnt, uint32_t sum_us, uint32_t max_us);
+uint32_t usbHidJitGetAvgUs(const hid_jit_t *p_jit, hid_jit_path_t path);
+void     usbHidJitClearStat(hid_jit_t *p_jit);
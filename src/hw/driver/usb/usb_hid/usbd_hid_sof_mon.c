@@ -0,0 +1,763 @@
+#include "usbd_hid_sof_mon.h"
+
+#include <string.h>
+
+#include "usb.h"
+
+
+// ---------------------------------------------------------------------------
+// [SOF Monitor] V261018R9
+//   - V261018R8 까지는 USBD_HID_SOF() 가 SOF(HS 8kHz) 마다 점수/워밍업/홀드오프/이벤트 창을 모두 평가했다.
+//     평가할 것이 없는 정상 구간에서도 분기와 sof_monitor 갱신이 OTG ISR 안에서 돌았다.
+//   - 지금은 ISR 이 샘플만 적재하고, 메인 루프가 모아서 평가한다. 평가 순서와 입력(샘플 시각/상태)이 같으므로
+//     판정은 ISR 평가와 같다. 다운그레이드 요청 시각만 메인 루프 지연만큼 늦어진다.
+//   - 백그라운드 SOF 누락 감시(Tick)와 SOF 평가가 같은 문맥에서 돌아 prev_tick_us 경합도 없어진다.
+// ---------------------------------------------------------------------------
+
+
+enum
+{
+  USB_SOF_MONITOR_CONFIG_HOLDOFF_MS   = 50U,                                               // V251108R9 재협상/재개 지연 최소화
+  USB_SOF_MONITOR_WARMUP_TIMEOUT_MS   = USB_SOF_MONITOR_CONFIG_HOLDOFF_MS + USB_BOOT_MONITOR_CONFIRM_DELAY_MS, // V250924R3 워밍업 최대 시간(ms)
+  USB_SOF_MONITOR_WARMUP_FRAMES_HS    = 2048U,                                             // V250924R3 HS 안정성 확인 프레임 수
+  USB_SOF_MONITOR_WARMUP_FRAMES_FS    = 128U,                                              // V250924R3 FS 안정성 확인 프레임 수
+  USB_SOF_MONITOR_CONFIG_HOLDOFF_US   = USB_SOF_MONITOR_CONFIG_HOLDOFF_MS * 1000UL,        // 구성 직후 워밍업 지연(us)
+  USB_SOF_MONITOR_WARMUP_TIMEOUT_US   = USB_SOF_MONITOR_WARMUP_TIMEOUT_MS * 1000UL,        // 워밍업 최대 시간(us)
+  USB_SOF_MONITOR_RESUME_HOLDOFF_US   = 50U * 1000UL,                                      // V251108R9 일시중지 해제 후 감시 재개 지연(us)
+  USB_SOF_MONITOR_RECOVERY_DELAY_US   = 50U * 1000UL,                                      // 다운그레이드 실패 후 지연(us)
+  USB_SOF_MONITOR_NO_SOF_TIMEOUT_FACTOR = 64U,                                            // V251108R9 SOF 누락 감시용 시간 배수
+  USB_SOF_MONITOR_EVENT_DELTA_US      = 250U * 1000UL,                                    // V251109R2 persistent 다운그레이드 기본 보고 간격 (열거 시도 타임아웃)
+  USB_SOF_MONITOR_SPEED_WINDOW_US     = 1000U * 1000UL,                                   // V251109R2 HS 재협상 평균 재시도(≤1s)에 맞춘 윈도우
+  USB_SOF_MONITOR_SPEED_THRESHOLD     = 3U,                                               // V251109R2 1초 내 3회 이상이면 비정상으로 간주
+  USB_SOF_MONITOR_SUSPEND_WINDOW_US   = 1500U * 1000UL,                                   // V251109R2 Selective Suspend 허용 간격(>1.5s)
+  USB_SOF_MONITOR_SUSPEND_THRESHOLD   = 3U,                                               // V251109R2 1.5s 내 3회 서스펜드는 비정상
+  USB_SOF_MONITOR_PERSISTENT_THRESHOLD = 3U,                                              // V251109R2 영구 점수 임계 (세 번째 이벤트에서 다운그레이드)
+  USB_SOF_MONITOR_WARMUP_GRACE_US     = 200U * 1000UL,                                    // V251109R2 워밍업 완화 기간(us)
+  USB_BOOT_MONITOR_CONFIRM_DELAY_US   = USB_BOOT_MONITOR_CONFIRM_DELAY_MS * 1000UL          // 다운그레이드 확인 대기(us)
+};
+
+
+static void usbHidSofMonProcessDelta(hid_sof_mon_t *p_mon, uint32_t now_us, uint32_t delta_us);
+static void usbHidSofMonHandleSpeedChange(hid_sof_mon_t *p_mon, uint32_t now_us);
+static void usbHidSofMonHandleSuspend(hid_sof_mon_t *p_mon, uint32_t now_us);
+
+
+
+
+void usbHidSofMonInit(hid_sof_mon_t *p_mon, bool batch, hid_sof_mon_downgrade_t downgrade_func)
+{
+  memset(p_mon, 0, sizeof(hid_sof_mon_t));
+
+  p_mon->prev_dev_state = USBD_STATE_DEFAULT;
+  p_mon->downgrade_func = downgrade_func;
+  p_mon->batch          = batch;
+  qringCreate(&p_mon->q, p_mon->q_buf, sizeof(hid_sof_sample_t), HID_SOF_MON_RING_DEPTH);
+}
+
+// 링에 남은 샘플은 모드와 관계없이 메인 루프가 먼저 비우므로 순서가 섞이지 않는다.
+void usbHidSofMonSetBatch(hid_sof_mon_t *p_mon, bool batch)
+{
+  p_mon->batch = batch;
+}
+
+void usbHidSofMonClearStat(hid_sof_mon_t *p_mon)
+{
+  p_mon->push_cnt      = 0;
+  p_mon->drop_cnt      = 0;
+  p_mon->wake_cnt      = 0;
+  p_mon->eval_cnt      = 0;
+  p_mon->fast_cnt      = 0;
+  p_mon->batch_cnt     = 0;
+  p_mon->batch_max     = 0;
+  p_mon->gap_max_us    = 0;
+  p_mon->downgrade_cnt = 0;
+  p_mon->isr_cnt       = 0;
+  p_mon->isr_cycle_sum = 0;
+  p_mon->isr_cycle_max = 0;
+}
+
+bool usbHidSofMonOnSof(hid_sof_mon_t *p_mon, const hid_sof_sample_t *p_sample)
+{
+  if (p_mon->batch == false && qringAvailable(&p_mon->q) == 0)
+  {
+    usbHidSofMonSample(p_mon, p_sample);
+    return false;
+  }
+
+  hid_sof_sample_t *p_slot = qringReserve(&p_mon->q);
+
+  if (p_slot == NULL)
+  {
+    p_mon->resync = true;
+    p_mon->drop_cnt++;
+    return false;
+  }
+
+  *p_slot = *p_sample;
+  if (p_mon->resync == true)
+  {
+    p_slot->flags |= HID_SOF_FLAG_RESYNC;
+    p_mon->resync  = false;
+  }
+  qringCommit(&p_mon->q);
+  p_mon->push_cnt++;
+
+  // V261020R7: 평소에는 1ms TIMER 틱의 백그라운드 서비스가 비운다. 메인 루프가 그보다 오래 잠들었을 때만 깨운다.
+  if (qringAvailable(&p_mon->q) == HID_SOF_MON_WAKE_DEPTH)
+  {
+    p_mon->wake_cnt++;
+    return true;
+  }
+  return false;
+}
+
+void usbHidSofMonAddIsrCycles(hid_sof_mon_t *p_mon, uint32_t cycles)
+{
+  p_mon->isr_cnt++;
+  p_mon->isr_cycle_sum += cycles;
+  if (cycles > p_mon->isr_cycle_max)
+  {
+    p_mon->isr_cycle_max = cycles;
+  }
+}
+
+uint32_t usbHidSofMonExpectedUs(const hid_sof_mon_t *p_mon)
+{
+  return (p_mon->st.expected_us > 0U) ? p_mon->st.expected_us : 125U;
+}
+
+static void usbHidSofMonApplySpeedParams(hid_sof_mon_t *p_mon, uint8_t speed_code)  // V250924R4 속도별 모니터링 파라미터 캐시
+{
+  usb_sof_monitor_t *p = &p_mon->st;
+
+  p->active_speed = speed_code;
+
+  switch (speed_code)
+  {
+    case USBD_SPEED_HIGH:
+      p->expected_us            = 125U;
+      p->stable_threshold_us    = 180U;                             // V251108R9 HS 환경 허용 오차 축소
+      p->decay_interval_us      = 4000U;
+      p->slow_decay_interval_us = 12000U;                           // V251108R9 느린 점수 감쇠 (약 12ms)
+      p->degrade_threshold      = 10U;
+      p->slow_degrade_threshold = 4U;
+      p->event_score_cap        = 6U;
+      p->persistent_threshold   = USB_SOF_MONITOR_PERSISTENT_THRESHOLD;
+      p->warmup_target_frames   = USB_SOF_MONITOR_WARMUP_FRAMES_HS;
+      break;
+    case USBD_SPEED_FULL:
+      p->expected_us            = 1000U;
+      p->stable_threshold_us    = 1500U;                            // V251108R9 FS 허용 오차 축소
+      p->decay_interval_us      = 20000U;
+      p->slow_decay_interval_us = 60000U;                           // V251108R9 느린 점수 감쇠 (약 60ms)
+      p->degrade_threshold      = 5U;
+      p->slow_degrade_threshold = 3U;
+      p->event_score_cap        = 4U;
+      p->persistent_threshold   = USB_SOF_MONITOR_PERSISTENT_THRESHOLD;
+      p->warmup_target_frames   = USB_SOF_MONITOR_WARMUP_FRAMES_FS;
+      break;
+    default:
+      p->expected_us            = 0U;
+      p->stable_threshold_us    = 0U;
+      p->decay_interval_us      = 0U;
+      p->degrade_threshold      = 0U;
+      p->slow_decay_interval_us = 0U;
+      p->slow_degrade_threshold = 0U;
+      p->event_score_cap        = 0U;
+      p->persistent_threshold   = 0U;
+      p->warmup_target_frames   = 0U;
+      break;
+  }
+}
+
+static void usbHidSofMonPrimeTimeout(hid_sof_mon_t *p_mon, uint32_t now_us)   // V251108R9 SOF 누락 감시 타임아웃 초기화
+{
+  uint32_t guard_window = USB_SOF_MONITOR_WARMUP_TIMEOUT_US;
+
+  if (p_mon->st.expected_us > 0U)
+  {
+    guard_window = p_mon->st.expected_us * USB_SOF_MONITOR_NO_SOF_TIMEOUT_FACTOR;
+    if (guard_window == 0U)
+    {
+      guard_window = p_mon->st.expected_us;
+    }
+  }
+
+  p_mon->st.no_sof_deadline_us = now_us + guard_window;
+}
+
+void usbHidSofMonSample(hid_sof_mon_t *p_mon, const hid_sof_sample_t *p_sample)
+{
+  usb_sof_monitor_t *p         = &p_mon->st;
+  uint32_t           now_us    = p_sample->now_us;
+  uint8_t            dev_state = p_sample->dev_state;
+  uint8_t            dev_speed = p_sample->speed;
+
+  p_mon->eval_cnt++;
+
+  if (dev_state != p_mon->prev_dev_state)
+  {
+    p->prev_tick_us       = now_us;
+    p->score              = 0U;
+    p->slow_score         = 0U;
+    p->last_decay_us      = now_us;
+    p->slow_last_decay_us = now_us;
+    p->holdoff_end_us =
+        (dev_state == USBD_STATE_CONFIGURED) ? (now_us + USB_SOF_MONITOR_CONFIG_HOLDOFF_US) : now_us;
+    p->warmup_deadline_us =
+        (dev_state == USBD_STATE_CONFIGURED) ? (now_us + USB_SOF_MONITOR_WARMUP_TIMEOUT_US) : now_us;
+    p->warmup_good_frames = 0U;
+    p->warmup_complete    = false;
+    usbHidSofMonApplySpeedParams(p_mon, (dev_state == USBD_STATE_CONFIGURED) ? dev_speed : 0xFFU);
+    usbHidSofMonPrimeTimeout(p_mon, now_us);
+    p->speed_change_count       = 0U;
+    p->suspend_count            = 0U;
+    p->persistent_score         = 0U;
+    p->speed_change_window_us   = 0U;                 // V251109R3: 이벤트 창을 첫 발생 기준으로 초기화
+    p->suspend_window_us        = 0U;                 // V251109R3: 서스펜드 창 초기화
+    p->warmup_grace_active      = false;
+    p->warmup_grace_deadline_us = 0U;
+    p_mon->prev_dev_state       = dev_state;
+  }
+
+  if (dev_state != USBD_STATE_CONFIGURED)
+  {
+    p->prev_tick_us       = now_us;
+    p->score              = 0U;
+    p->slow_score         = 0U;
+    p->last_decay_us      = now_us;
+    p->slow_last_decay_us = now_us;
+    p->holdoff_end_us     = now_us;
+    p->warmup_deadline_us = now_us;
+    p->warmup_good_frames = 0U;
+    p->warmup_complete    = false;
+    usbHidSofMonApplySpeedParams(p_mon, 0xFFU);
+    usbHidSofMonPrimeTimeout(p_mon, now_us);
+    p->speed_change_count       = 0U;
+    p->suspend_count            = 0U;
+    p->persistent_score         = 0U;
+    p->speed_change_window_us   = 0U;                 // V251109R3: 구성 전에는 창을 비활성화
+    p->suspend_window_us        = 0U;                 // V251109R3
+    p->warmup_grace_active      = false;
+    p->warmup_grace_deadline_us = 0U;
+    return;
+  }
+
+  if (p_sample->flags & HID_SOF_FLAG_SUSPENDED)
+  {
+    if (p_mon->prev_suspended == false)
+    {
+      usbHidSofMonHandleSuspend(p_mon, now_us);
+    }
+    p_mon->prev_suspended = true;
+    p->prev_tick_us       = now_us;
+    p->score              = 0U;
+    if (p->slow_score > 0U)
+    {
+      p->slow_score--;
+    }
+    p->holdoff_end_us     = now_us + USB_SOF_MONITOR_RESUME_HOLDOFF_US;
+    p->warmup_deadline_us = now_us + USB_SOF_MONITOR_WARMUP_TIMEOUT_US;
+    p->warmup_good_frames = 0U;
+    p->warmup_complete    = false;
+    p->last_decay_us      = now_us;
+    p->slow_last_decay_us = now_us;
+    usbHidSofMonApplySpeedParams(p_mon, dev_speed);
+    usbHidSofMonPrimeTimeout(p_mon, now_us);
+    return;
+  }
+  else
+  {
+    p_mon->prev_suspended = false;
+  }
+
+  if (dev_speed != USBD_SPEED_HIGH && dev_speed != USBD_SPEED_FULL)
+  {
+    p->prev_tick_us       = now_us;
+    p->score              = 0U;
+    p->slow_score         = 0U;
+    p->last_decay_us      = now_us;
+    p->slow_last_decay_us = now_us;
+    p->warmup_deadline_us = now_us;
+    p->warmup_good_frames = 0U;
+    p->warmup_complete    = false;
+    usbHidSofMonApplySpeedParams(p_mon, 0xFFU);
+    usbHidSofMonPrimeTimeout(p_mon, now_us);
+    return;
+  }
+
+  if (dev_speed != p->active_speed)
+  {
+    usbHidSofMonHandleSpeedChange(p_mon, now_us);
+    usbHidSofMonApplySpeedParams(p_mon, dev_speed);
+    p->score = 0U;
+    if (p->slow_score > 0U)
+    {
+      p->slow_score--;
+    }
+    p->last_decay_us      = now_us;
+    p->slow_last_decay_us = now_us;
+    p->holdoff_end_us     = now_us + USB_SOF_MONITOR_CONFIG_HOLDOFF_US;
+    p->warmup_deadline_us = now_us + USB_SOF_MONITOR_WARMUP_TIMEOUT_US;
+    p->warmup_good_frames = 0U;
+    p->warmup_complete    = false;
+    usbHidSofMonPrimeTimeout(p_mon, now_us);
+  }
+
+  // V261018R9: 링 넘침으로 빠진 구간은 간격으로 평가하지 않고 기준 시각만 다시 잡는다.
+  if (p->prev_tick_us == 0U || (p_sample->flags & HID_SOF_FLAG_RESYNC))
+  {
+    p->prev_tick_us       = now_us;
+    p->last_decay_us      = now_us;
+    p->slow_last_decay_us = now_us;
+    usbHidSofMonPrimeTimeout(p_mon, now_us);
+    return;
+  }
+
+  uint32_t delta_us = now_us - p->prev_tick_us;
+  p->prev_tick_us = now_us;
+
+  usbHidSofMonProcessDelta(p_mon, now_us, delta_us);
+}
+
+static void usbHidSofMonProcessDelta(hid_sof_mon_t *p_mon, uint32_t now_us, uint32_t delta_us)
+{
+  usb_sof_monitor_t *p = &p_mon->st;
+
+  uint32_t expected_us            = p->expected_us;
+  uint32_t stable_threshold       = p->stable_threshold_us;
+  uint32_t decay_interval_us      = p->decay_interval_us;
+  uint32_t slow_decay_interval_us = p->slow_decay_interval_us;
+  uint8_t  degrade_threshold      = p->degrade_threshold;
+  uint8_t  slow_degrade_threshold = p->slow_degrade_threshold;
+  uint8_t  event_score_cap        = p->event_score_cap;
+  uint16_t warmup_target_frames   = p->warmup_target_frames;
+
+  if (expected_us == 0U)
+  {
+    return;
+  }
+
+  usbHidSofMonPrimeTimeout(p_mon, now_us);                         // V251108R9 SOF 누락 감시 타임아웃 갱신
+
+  if (now_us < p->holdoff_end_us)
+  {
+    p->last_decay_us      = now_us;
+    p->slow_last_decay_us = now_us;
+    return;
+  }
+
+  if (p->warmup_complete == false)
+  {
+    if (p->warmup_grace_active)
+    {
+      if (now_us <= p->warmup_grace_deadline_us)
+      {
+        warmup_target_frames = (uint16_t)(warmup_target_frames / 2U);
+        if (warmup_target_frames == 0U)
+        {
+          warmup_target_frames = 1U;
+        }
+      }
+      else
+      {
+        p->warmup_grace_active = false;
+      }
+    }
+
+    if (delta_us < stable_threshold)
+    {
+      if (p->warmup_good_frames < warmup_target_frames)
+      {
+        p->warmup_good_frames++;
+      }
+    }
+    else
+    {
+      p->warmup_good_frames = 0U;
+    }
+
+    if (p->warmup_good_frames >= warmup_target_frames || now_us >= p->warmup_deadline_us)
+    {
+      p->warmup_complete     = true;
+      p->last_decay_us       = now_us;
+      p->slow_last_decay_us  = now_us;
+      p->warmup_grace_active = false;
+    }
+    else
+    {
+      return;
+    }
+  }
+
+  if (delta_us < stable_threshold)
+  {
+    if (p->score > 0U && decay_interval_us > 0U)
+    {
+      if ((now_us - p->last_decay_us) >= decay_interval_us)
+      {
+        p->score--;
+        p->last_decay_us = now_us;
+      }
+    }
+
+    if (p->slow_score > 0U && slow_decay_interval_us > 0U)
+    {
+      if ((now_us - p->slow_last_decay_us) >= slow_decay_interval_us)
+      {
+        p->slow_score--;
+        p->slow_last_decay_us = now_us;
+      }
+    }
+    return;
+  }
+
+  uint32_t missed_frames = (delta_us + expected_us - 1U) / expected_us;
+  uint8_t  delta_score   = 1U;
+  uint32_t burst_points  = 0U;
+
+  if (missed_frames > 1U)
+  {
+    burst_points = missed_frames - 1U;
+  }
+
+  if (burst_points > event_score_cap)
+  {
+    burst_points = event_score_cap;
+  }
+
+  if (burst_points > 0U)
+  {
+    if (burst_points > 0xFFU)
+    {
+      burst_points = 0xFFU;
+    }
+    delta_score = (uint8_t)burst_points;
+  }
+
+  if (delta_score < 1U)
+  {
+    delta_score = 1U;
+  }
+
+  if (p->score <= (uint8_t)(0xFFU - delta_score))
+  {
+    p->score += delta_score;
+  }
+  else
+  {
+    p->score = 0xFFU;
+  }
+
+  p->last_decay_us = now_us;
+
+  if (p->slow_score < 0xFFU)
+  {
+    p->slow_score++;
+  }
+  p->slow_last_decay_us = now_us;
+
+  bool need_degrade = false;
+
+  if (degrade_threshold > 0U && p->score >= degrade_threshold)
+  {
+    need_degrade = true;
+  }
+
+  if (slow_degrade_threshold > 0U && p->slow_score >= slow_degrade_threshold)
+  {
+    need_degrade = true;
+  }
+
+  if (need_degrade == false)
+  {
+    return;
+  }
+
+  (void)usbHidSofMonCommitDowngrade(p_mon, now_us, delta_us, expected_us, USB_MONITOR_EVENT_SOF);
+}
+
+bool usbHidSofMonCommitDowngrade(hid_sof_mon_t      *p_mon,
+                                 uint32_t            now_us,
+                                 uint32_t            delta_us,
+                                 uint32_t            expected_us,
+                                 usb_monitor_event_t event)
+{
+  usb_sof_monitor_t *p = &p_mon->st;
+  bool downgrade_requested = false;
+
+  if (p_mon->downgrade_func != NULL)
+  {
+    downgrade_requested = p_mon->downgrade_func(now_us, delta_us, expected_us, event);
+  }
+
+  if (downgrade_requested)
+  {
+    p->holdoff_end_us = now_us + USB_BOOT_MONITOR_CONFIRM_DELAY_US;
+    p_mon->downgrade_cnt++;
+  }
+  else
+  {
+    p->holdoff_end_us = now_us + USB_SOF_MONITOR_RECOVERY_DELAY_US;
+  }
+
+  p->score                  = 0U;
+  p->slow_score             = 0U;
+  p->persistent_score       = 0U;
+  p->speed_change_count     = 0U;
+  p->suspend_count          = 0U;
+  p->speed_change_window_us = 0U;                     // V251109R3: 새 이벤트까지만 창 유지
+  p->suspend_window_us      = 0U;                     // V251109R3
+  p->warmup_grace_active    = false;
+
+  return downgrade_requested;
+}
+
+static void usbHidSofMonBumpPersistent(hid_sof_mon_t *p_mon, uint32_t now_us, usb_monitor_event_t event)
+{
+  usb_sof_monitor_t *p = &p_mon->st;
+
+  if (p->persistent_score < 0xFFU)
+  {
+    p->persistent_score++;
+  }
+
+  if (p->persistent_threshold == 0U)
+  {
+    return;
+  }
+
+  if (p->persistent_score >= p->persistent_threshold)
+  {
+    uint32_t expected_us = usbHidSofMonExpectedUs(p_mon);
+    uint32_t delta_us    = USB_SOF_MONITOR_EVENT_DELTA_US;
+
+    if (event == USB_MONITOR_EVENT_SPEED)
+    {
+      delta_us = USB_SOF_MONITOR_SPEED_WINDOW_US;
+    }
+    else if (event == USB_MONITOR_EVENT_SUSPEND)
+    {
+      delta_us = USB_SOF_MONITOR_SUSPEND_WINDOW_US;
+    }
+
+    (void)usbHidSofMonCommitDowngrade(p_mon, now_us, delta_us, expected_us, event);
+  }
+}
+
+static void usbHidSofMonHandleSpeedChange(hid_sof_mon_t *p_mon, uint32_t now_us)
+{
+  usb_sof_monitor_t *p = &p_mon->st;
+
+  if (p->warmup_target_frames == 0U)
+  {
+    p->speed_change_count     = 0U;
+    p->speed_change_window_us = 0U;                   // V251109R3: 창 비활성화
+    return;
+  }
+
+  if (p->speed_change_count == 0U || now_us >= p->speed_change_window_us)
+  {
+    p->speed_change_count     = 0U;
+    p->speed_change_window_us = now_us + USB_SOF_MONITOR_SPEED_WINDOW_US;  // V251109R3: 첫 이벤트 기준 고정 창
+  }
+
+  if (p->warmup_complete)
+  {
+    p->warmup_grace_active      = true;
+    p->warmup_grace_deadline_us = now_us + USB_SOF_MONITOR_WARMUP_GRACE_US;
+  }
+
+  if (p->speed_change_count < 0xFFU)
+  {
+    p->speed_change_count++;
+  }
+
+  if (p->speed_change_count >= USB_SOF_MONITOR_SPEED_THRESHOLD)
+  {
+    p->speed_change_count     = 0U;
+    p->speed_change_window_us = now_us + USB_SOF_MONITOR_SPEED_WINDOW_US;  // V251109R3: 새 창 시작
+    usbHidSofMonBumpPersistent(p_mon, now_us, USB_MONITOR_EVENT_SPEED);
+  }
+}
+
+static void usbHidSofMonHandleSuspend(hid_sof_mon_t *p_mon, uint32_t now_us)
+{
+  usb_sof_monitor_t *p = &p_mon->st;
+
+  if (p->warmup_target_frames == 0U)
+  {
+    p->suspend_count     = 0U;
+    p->suspend_window_us = 0U;                        // V251109R3: 창 비활성화
+    return;
+  }
+
+  if (p->suspend_count == 0U || now_us >= p->suspend_window_us)
+  {
+    p->suspend_count     = 0U;
+    p->suspend_window_us = now_us + USB_SOF_MONITOR_SUSPEND_WINDOW_US;     // V251109R3: 첫 이벤트 기준 창
+  }
+
+  if (p->warmup_complete)
+  {
+    p->warmup_grace_active      = true;
+    p->warmup_grace_deadline_us = now_us + USB_SOF_MONITOR_WARMUP_GRACE_US;
+  }
+
+  if (p->suspend_count < 0xFFU)
+  {
+    p->suspend_count++;
+  }
+
+  if (p->suspend_count >= USB_SOF_MONITOR_SUSPEND_THRESHOLD)
+  {
+    p->suspend_count     = 0U;
+    p->suspend_window_us = now_us + USB_SOF_MONITOR_SUSPEND_WINDOW_US;     // V251109R3: 새 창 시작
+    usbHidSofMonBumpPersistent(p_mon, now_us, USB_MONITOR_EVENT_SUSPEND);
+  }
+}
+
+// 정상 구간 고속 경로: 구성/속도/서스펜드가 그대로이고 홀드오프 경과, 워밍업 완료, 두 점수가 0 이면
+// 간격이 임계 미만인 샘플은 기존 평가에서도 기준 시각과 누락 타임아웃만 바뀐다.
+static uint32_t usbHidSofMonScan(hid_sof_mon_t *p_mon, const hid_sof_sample_t *p_buf, uint32_t count)
+{
+  usb_sof_monitor_t *p = &p_mon->st;
+
+  if (p_mon->prev_dev_state != USBD_STATE_CONFIGURED || p_mon->prev_suspended == true ||
+      p->expected_us == 0U || p->warmup_complete == false ||
+      p->score > 0U || p->slow_score > 0U)
+  {
+    return 0;
+  }
+
+  uint32_t prev_us    = p->prev_tick_us;
+  uint32_t holdoff_us = p->holdoff_end_us;
+  uint32_t stable_us  = p->stable_threshold_us;
+  uint32_t gap_max_us = p_mon->gap_max_us;
+  uint8_t  speed      = p->active_speed;
+  uint32_t i;
+
+  for (i = 0; i < count; i++)
+  {
+    const hid_sof_sample_t *p_sample = &p_buf[i];
+    uint32_t                delta_us = p_sample->now_us - prev_us;
+
+    if (prev_us == 0U || p_sample->flags != 0 || p_sample->dev_state != USBD_STATE_CONFIGURED ||
+        p_sample->speed != speed || p_sample->now_us < holdoff_us || delta_us >= stable_us)
+    {
+      break;
+    }
+    if (delta_us > gap_max_us)
+    {
+      gap_max_us = delta_us;
+    }
+    prev_us = p_sample->now_us;
+  }
+
+  if (i > 0)
+  {
+    p->prev_tick_us   = prev_us;
+    p_mon->gap_max_us = gap_max_us;
+    p_mon->fast_cnt  += i;
+    usbHidSofMonPrimeTimeout(p_mon, prev_us);
+  }
+  return i;
+}
+
+// 호출 시점에 쌓인 샘플만 처리한다. 링 슬롯은 평가가 끝난 뒤 반납해 ISR 이 빈 링을 보고
+// 바로 평가로 넘어가는 순간(batch 해제 직후)에도 앞선 샘플이 모두 반영되어 있게 한다.
+uint32_t usbHidSofMonDrain(hid_sof_mon_t *p_mon)
+{
+  uint32_t total = qringAvailable(&p_mon->q);
+  uint32_t done  = 0;
+
+  while (done < total)
+  {
+    // 링 끝에서 끊기는 연속 구간 단위로 훑는다.
+    const hid_sof_sample_t *p_buf = qringPeek(&p_mon->q);
+    uint32_t                span  = p_mon->q.len - (p_mon->q.out & p_mon->q.mask);
+    uint32_t                i     = 0;
+
+    if (span > total - done)
+    {
+      span = total - done;
+    }
+
+    while (i < span)
+    {
+      i += usbHidSofMonScan(p_mon, &p_buf[i], span - i);
+      if (i < span)
+      {
+        usbHidSofMonSample(p_mon, &p_buf[i]);
+        i++;
+      }
+    }
+    qringRelease(&p_mon->q, span);
+    done += span;
+  }
+
+  if (total > 0)
+  {
+    p_mon->batch_cnt++;
+    if (total > p_mon->batch_max)
+    {
+      p_mon->batch_max = total;
+    }
+  }
+  return total;
+}
+
+void usbHidSofMonTick(hid_sof_mon_t *p_mon, uint32_t now_us, bool configured, bool suspended)
+{
+  usb_sof_monitor_t *p = &p_mon->st;
+
+  // V251109R2 이벤트 윈도우 만료 처리
+  if (p->speed_change_count > 0U && now_us >= p->speed_change_window_us)
+  {
+    p->speed_change_count     = 0U;
+    p->speed_change_window_us = 0U;                   // V251109R3: 만료 시 창 초기화
+  }
+
+  if (p->suspend_count > 0U && now_us >= p->suspend_window_us)
+  {
+    p->suspend_count     = 0U;
+    p->suspend_window_us = 0U;                        // V251109R3
+  }
+
+  if (p->warmup_grace_active && now_us >= p->warmup_grace_deadline_us)
+  {
+    p->warmup_grace_active = false;
+  }
+
+  // V251108R9 SOF 중단 감시
+  if (configured == false || suspended == true)
+  {
+    return;
+  }
+
+  if (p->prev_tick_us == 0U || p->expected_us == 0U)
+  {
+    return;
+  }
+
+  if (p->warmup_complete == false)
+  {
+    return;
+  }
+
+  // 링이 넘쳐 샘플이 빠진 뒤라 prev_tick_us 가 실제 마지막 SOF 가 아니다. 다음 샘플(RESYNC)이 기준을 다시 잡는다.
+  if (p_mon->resync == true)
+  {
+    return;
+  }
+
+  if (now_us < p->no_sof_deadline_us)
+  {
+    return;
+  }
+
+  uint32_t delta_us = now_us - p->prev_tick_us;
+  p->prev_tick_us = now_us;
+
+  usbHidSofMonProcessDelta(p_mon, now_us, delta_us);
+}
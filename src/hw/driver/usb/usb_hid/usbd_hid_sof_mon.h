@@ -0,0 +1,115 @@
+#pragma once
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "hw_def.h"
+#include "qring.h"
+
+
+// V261018R9: USB SOF 안정성 감시 (V250924R2 ~ V251109R3 usbd_hid.c 에서 분리)
+//   - ISR 은 SOF 마다 샘플(시각 + 장치 상태/속도/서스펜드) 1개를 링에 넣기만 한다.
+//   - 평가는 메인 루프 usbHidMonitorBackgroundTick() 이 모아서 한다. 정상 구간(워밍업 완료, 홀드오프 경과,
+//     점수 0, 상태 변화 없음)은 간격이 임계 미만인지만 훑어 넘기고, 나머지 샘플은 기존 평가를 그대로 탄다.
+//   - 링이 넘치면 다음 샘플에 RESYNC 를 달아 빠진 구간을 SOF 누락으로 세지 않고 기준 시각만 다시 잡는다.
+//   - 레지스터 비의존 코드라 호스트 시뮬레이터도 같은 소스를 빌드한다.
+#define HID_SOF_MON_RING_DEPTH    256                 // HS 8kHz 기준 32ms
+#define HID_SOF_MON_WAKE_DEPTH    64                  // V261020R7: 이만큼 쌓이면 메인 루프를 깨운다 (HS 8ms, 평소는 1ms TIMER 틱이 비움)
+
+#define HID_SOF_FLAG_SUSPENDED    0x01
+#define HID_SOF_FLAG_RESYNC       0x02                // 직전에 링 넘침으로 샘플이 빠짐
+
+
+typedef enum                                          // V251109R2 다운그레이드 이벤트 구분
+{
+  USB_MONITOR_EVENT_SOF = 0,
+  USB_MONITOR_EVENT_ENUM,
+  USB_MONITOR_EVENT_SPEED,
+  USB_MONITOR_EVENT_SUSPEND
+} usb_monitor_event_t;
+
+typedef struct
+{
+  uint32_t now_us;                                    // SOF 수신 시각
+  uint8_t  dev_state;                                 // USBD_STATE_*
+  uint8_t  speed;                                     // USBD_SPEED_*
+  uint8_t  flags;                                     // HID_SOF_FLAG_*
+  uint8_t  reserved;
+} hid_sof_sample_t;
+
+// 하위 폴링 모드 요청. ARMED/CONFIRMED 면 true (usbd_hid.c 가 usbRequestBootModeDowngrade 로 연결)
+typedef bool (*hid_sof_mon_downgrade_t)(uint32_t now_us, uint32_t delta_us, uint32_t expected_us, usb_monitor_event_t event);
+
+typedef struct
+{
+  uint32_t prev_tick_us;                                          // V250924R2 직전 SOF 타임스탬프(us)
+  uint32_t last_decay_us;                                         // 점수 감소 시각(us)
+  uint32_t slow_last_decay_us;                                    // V251108R9 느린 점수 감소/증가 기준 시각(us)
+  uint32_t holdoff_end_us;                                        // 다운그레이드 홀드오프 종료 시각(us)
+  uint32_t warmup_deadline_us;                                    // 워밍업 타임아웃 시각(us)
+  uint32_t no_sof_deadline_us;                                    // V251108R9 SOF 미수신 타임아웃 시각(us)
+  uint32_t expected_us;                                           // V250924R4 속도별 기대 SOF 주기(us)
+  uint32_t stable_threshold_us;                                   // V250924R4 정상 범위 상한(us)
+  uint32_t decay_interval_us;                                     // 점수 감쇠 주기(us)
+  uint32_t slow_decay_interval_us;                                // V251108R9 느린 점수 감쇠 주기(us)
+  uint32_t speed_change_window_us;                                // V251109R2 속도 변동 감시 윈도우(us)
+  uint32_t suspend_window_us;                                     // V251109R2 서스펜드 감시 윈도우(us)
+  uint32_t warmup_grace_deadline_us;                              // V251109R2 워밍업 완화 기한(us)
+  uint16_t warmup_good_frames;                                    // V250924R3 누적 정상 프레임 수
+  uint16_t warmup_target_frames;                                  // V250924R3 요구되는 정상 프레임 한계
+  uint8_t  degrade_threshold;                                     // V250924R4 다운그레이드 임계 점수
+  uint8_t  slow_degrade_threshold;                                // V251108R9 느린 점수 임계
+  uint8_t  event_score_cap;                                       // V251108R9 속도별 단일 이벤트 점수 상한
+  uint8_t  active_speed;                                          // V250924R4 캐시된 USB 속도 코드
+  uint8_t  score;                                                 // V250924R2 누적 불안정 점수
+  uint8_t  slow_score;                                            // V251108R9 느린 불안정 점수
+  uint8_t  speed_change_count;                                    // V251109R2 속도 변동 누적
+  uint8_t  suspend_count;                                         // V251109R2 서스펜드 누적
+  uint8_t  persistent_score;                                      // V251109R2 속도/서스펜드 전용 점수
+  uint8_t  persistent_threshold;                                  // V251109R2 persistent 다운그레이드 임계
+  bool     warmup_complete;                                       // V250924R3 워밍업 완료 여부
+  bool     warmup_grace_active;                                   // V251109R2 워밍업 완화 적용 여부
+} usb_sof_monitor_t;
+
+typedef struct
+{
+  usb_sof_monitor_t       st;
+  uint8_t                 prev_dev_state;             // V250924R2 마지막 USB 장치 상태
+  bool                    prev_suspended;             // V251109R2 직전 서스펜드 상태
+  hid_sof_mon_downgrade_t downgrade_func;
+
+  bool                    batch;                      // true = ISR 은 적재만, false = ISR 에서 바로 평가 (V261018R8 까지)
+  qring_t                 q;
+  hid_sof_sample_t        q_buf[HID_SOF_MON_RING_DEPTH];
+  volatile bool           resync;                     // ISR 전용: 넘침 후 다음 샘플에 RESYNC
+
+  volatile uint32_t       push_cnt;                   // 링에 넣은 샘플 수
+  volatile uint32_t       drop_cnt;                   // 링이 가득 차 버린 샘플 수
+  volatile uint32_t       wake_cnt;                   // V261020R7: WAKE_DEPTH 를 넘겨 메인 루프 깨움을 요청한 수
+  uint32_t                eval_cnt;                   // 기존 평가를 탄 샘플 수
+  uint32_t                fast_cnt;                   // 고속 경로로 넘긴 샘플 수
+  uint32_t                batch_cnt;                  // 샘플이 있었던 Drain 호출 수
+  uint32_t                batch_max;                  // 한 번에 처리한 최대 샘플 수
+  uint32_t                gap_max_us;                 // 고속 경로에서 본 최대 SOF 간격
+  uint32_t                downgrade_cnt;              // 다운그레이드 요청이 받아들여진 수
+  uint32_t                isr_cnt;                    // ISR 비용 집계 (계측 빌드)
+  uint32_t                isr_cycle_sum;
+  uint32_t                isr_cycle_max;
+} hid_sof_mon_t;
+
+
+void     usbHidSofMonInit(hid_sof_mon_t *p_mon, bool batch, hid_sof_mon_downgrade_t downgrade_func);
+void     usbHidSofMonSetBatch(hid_sof_mon_t *p_mon, bool batch);
+void     usbHidSofMonClearStat(hid_sof_mon_t *p_mon);
+
+// OTG ISR: batch 면 링 적재, 아니면 usbHidSofMonSample() 로 바로 평가
+//   링이 HID_SOF_MON_WAKE_DEPTH 에 닿은 SOF 에서만 true (V261020R7: 호출자가 메인 루프를 깨운다)
+bool     usbHidSofMonOnSof(hid_sof_mon_t *p_mon, const hid_sof_sample_t *p_sample);
+void     usbHidSofMonAddIsrCycles(hid_sof_mon_t *p_mon, uint32_t cycles);
+
+// 메인 루프
+void     usbHidSofMonSample(hid_sof_mon_t *p_mon, const hid_sof_sample_t *p_sample);   // 샘플 1개 평가 (기준 경로)
+uint32_t usbHidSofMonDrain(hid_sof_mon_t *p_mon);
+void     usbHidSofMonTick(hid_sof_mon_t *p_mon, uint32_t now_us, bool configured, bool suspended);
+bool     usbHidSofMonCommitDowngrade(hid_sof_mon_t *p_mon, uint32_t now_us, uint32_t delta_us, uint32_t expected_us, usb_monitor_event_t event);
+uint32_t usbHidSofMonExpectedUs(const hid_sof_mon_t *p_mon);   // 속도 미확정이면 125
@@ -0,0 +1,253 @@
+#include "usbd_hid_tx.h"
+
+#include <string.h>
+
+
+// ---------------------------------------------------------------------------
+// [HID Tx] V261021R4
+//   - 즉시 적재: 대기 레코드가 없고 EP 가 idle 일 때만 EP 버퍼에 복사해 보낸다 (순서 보장, 전송 중 버퍼 보호).
+//   - 드레인: TIM2 비교 시점마다 idle EP 의 대기열에서 하나씩 꺼낸다. JIT 잠금 후에는 비교 시점이 곧 적재 시점이다.
+//   - EP 상태는 슬롯마다 한 바이트 단위로 기록하므로 메인 루프/ISR 사이 RMW 경합이 없다.
+//   - V261021R5: HS 4K/2K 는 키보드 EP 를 2/4 마이크로프레임마다만 폴링하지만 TIM2 는 SOF 마다 리셋된다.
+//     JIT 적재는 마지막 IN 완료 이후 SOF 수가 poll_div 배수인(폴링되는) 마이크로프레임에서만 하고,
+//     놓침 판정도 SOF 주기가 아닌 폴링 주기로 한다.
+// ---------------------------------------------------------------------------
+
+
+
+
+static void usbHidTxBeginInflight(hid_tx_t *p_tx, const hid_coalesce_rec_t *p_rec, uint32_t now_us)
+{
+  p_tx->inflight         = *p_rec;
+  p_tx->inflight_path    = usbHidJitIsActive(&p_tx->jit) ? HID_JIT_PATH_JIT : HID_JIT_PATH_DIRECT;
+  p_tx->inflight_load_us = now_us;
+  if (p_tx->inflight_path == HID_JIT_PATH_JIT)
+  {
+    p_tx->jit.load_cnt++;
+  }
+}
+
+// IN 완료를 본 적이 없으면 어느 마이크로프레임이 폴링되는지 모르므로 막지 않는다.
+static bool usbHidTxIsPolledFrame(hid_tx_t *p_tx)
+{
+  if (p_tx->poll_div <= 1 || p_tx->in_sof_valid != true)
+  {
+    return true;
+  }
+  return ((p_tx->sof_cnt - p_tx->in_sof_cnt) % p_tx->poll_div) == 0;
+}
+
+// JIT 잠금 중에는 폴링되는 마이크로프레임의 (위상 - guard) 이후에만 키보드 리포트를 싣는다.
+static bool usbHidTxCanLoadKeyboard(hid_tx_t *p_tx, uint32_t sof_us)
+{
+  if (usbHidJitIsActive(&p_tx->jit) != true)
+  {
+    return true;
+  }
+  return usbHidJitCanLoadNow(&p_tx->jit, sof_us) == true && usbHidTxIsPolledFrame(p_tx) == true;
+}
+
+void usbHidTxInit(hid_tx_t *p_tx, hid_tx_func_t tx_func, uint8_t *p_kbd_buf, uint8_t *p_exk_buf, uint8_t *p_nkro_buf)
+{
+  p_tx->tx_func    = tx_func;
+  p_tx->p_kbd_buf  = p_kbd_buf;
+  p_tx->p_exk_buf  = p_exk_buf;
+  p_tx->p_nkro_buf = p_nkro_buf;
+  p_tx->kbd_len    = HID_KEYBOARD_REPORT_SIZE;
+  p_tx->poll_div   = 1;
+
+  usbHidCoalesceInit(&p_tx->kbd_q);
+  qringCreate(&p_tx->exk_q, p_tx->exk_buf, sizeof(exk_report_info_t), HID_TX_EXK_Q_MAX);     // V261017R9: 레코드 크기를 exk_report_info_t 로 수정
+  qringCreate(&p_tx->nkro_q, p_tx->nkro_buf, sizeof(nkro_report_info_t), HID_TX_NKRO_Q_MAX);
+  usbHidTxReset(p_tx, false);
+}
+
+// 구성(SET_CONFIGURATION) 전/해제 후에는 모든 EP 를 busy 로 두어 즉시 전송 없이 대기열에만 쌓는다.
+void usbHidTxReset(hid_tx_t *p_tx, bool configured)
+{
+  for (uint32_t i=0; i<HID_IN_EP_NUM_MAX; i++)
+  {
+    p_tx->ep_state[i] = configured ? USBD_HID_IDLE : USBD_HID_BUSY;
+  }
+  p_tx->inflight.change_cnt = 0;
+  p_tx->in_sof_valid        = false;
+}
+
+void usbHidTxSetKeyboardLength(hid_tx_t *p_tx, uint16_t length)
+{
+  p_tx->kbd_len = length;
+}
+
+void usbHidTxSetPollDiv(hid_tx_t *p_tx, uint32_t poll_div)
+{
+  p_tx->poll_div     = poll_div > 0 ? poll_div : 1;
+  p_tx->in_sof_valid = false;
+}
+
+uint32_t usbHidTxGetPollUs(hid_tx_t *p_tx)
+{
+  return p_tx->jit.frame_us * p_tx->poll_div;
+}
+
+bool usbHidTxEpIsIdle(hid_tx_t *p_tx, uint8_t ep_addr)
+{
+  if (p_tx->tx_func == NULL)
+  {
+    return false;
+  }
+  return p_tx->ep_state[ep_addr & 0x07U] == USBD_HID_IDLE;
+}
+
+bool usbHidTxStart(hid_tx_t *p_tx, uint8_t ep_addr, uint8_t *p_data, uint16_t length)
+{
+  if (usbHidTxEpIsIdle(p_tx, ep_addr) != true)
+  {
+    return false;
+  }
+
+  p_tx->ep_state[ep_addr & 0x07U] = USBD_HID_BUSY;
+  if (p_tx->tx_func(ep_addr, p_data, length) != true)
+  {
+    p_tx->ep_state[ep_addr & 0x07U] = USBD_HID_IDLE;
+    return false;
+  }
+  return true;
+}
+
+void usbHidTxOnDataIn(hid_tx_t *p_tx, uint8_t ep_addr)
+{
+  p_tx->ep_state[ep_addr & 0x07U] = USBD_HID_IDLE;                    // V261018R3: 완료된 EP 만 해제
+}
+
+bool usbHidTxKeyboard(hid_tx_t *p_tx, const uint8_t *p_data, uint16_t length, uint32_t now_us, uint32_t sof_us)
+{
+  bool sent = false;
+
+  // V261018R2: 대기 레코드가 있으면 순서를 지키기 위해 바로 보내지 않고 큐에 병합한다.
+  // V261018R4: JIT 잠금 중에는 IN 직전 구간에서만 바로 싣고, 나머지는 TIM2 비교 시점까지 병합한다.
+  if (usbHidCoalesceAvailable(&p_tx->kbd_q) == 0 && usbHidTxEpIsIdle(p_tx, HID_EPIN_ADDR) &&
+      usbHidTxCanLoadKeyboard(p_tx, sof_us) == true)
+  {
+    hid_coalesce_rec_t rec = {.time_us = now_us, .change_cnt = 1, .change_sum_us = now_us};
+
+    memcpy(p_tx->p_kbd_buf, p_data, length);
+    usbHidTxBeginInflight(p_tx, &rec, now_us);
+    sent = usbHidTxStart(p_tx, HID_EPIN_ADDR, p_tx->p_kbd_buf, p_tx->kbd_len);
+  }
+  if (sent == true)
+  {
+    usbHidCoalesceMarkSent(&p_tx->kbd_q, p_data, length);
+  }
+  else
+  {
+    usbHidCoalescePush(&p_tx->kbd_q, p_data, length, now_us);
+  }
+  return sent;
+}
+
+bool usbHidTxExk(hid_tx_t *p_tx, const uint8_t *p_data, uint16_t length)
+{
+  bool sent = false;
+
+  // V261018R3: 전송 중인 EP 버퍼는 건드리지 않고, 대기 중인 리포트가 있으면 순서를 지켜 큐에 넣는다.
+  if (qringAvailable(&p_tx->exk_q) == 0 && usbHidTxEpIsIdle(p_tx, HID_EXK_EP_IN))
+  {
+    memcpy(p_tx->p_exk_buf, p_data, length);
+    sent = usbHidTxStart(p_tx, HID_EXK_EP_IN, p_tx->p_exk_buf, length);
+  }
+  if (sent != true)
+  {
+    exk_report_info_t *p_info = qringReserve(&p_tx->exk_q);
+
+    if (p_info != NULL)
+    {
+      p_info->len = (uint8_t)length;
+      memcpy(p_info->buf, p_data, length);
+      qringCommit(&p_tx->exk_q);
+    }
+  }
+  return sent;
+}
+
+bool usbHidTxNkro(hid_tx_t *p_tx, const uint8_t *p_data, uint16_t length)
+{
+  bool sent = false;
+
+  if (qringAvailable(&p_tx->nkro_q) == 0 && usbHidTxEpIsIdle(p_tx, HID_NKRO_EP_IN))     // V261018R3
+  {
+    memcpy(p_tx->p_nkro_buf, p_data, length);
+    sent = usbHidTxStart(p_tx, HID_NKRO_EP_IN, p_tx->p_nkro_buf, HID_NKRO_EP_SIZE);
+  }
+  if (sent != true)
+  {
+    nkro_report_info_t *p_info = qringReserve(&p_tx->nkro_q);
+
+    if (p_info != NULL)
+    {
+      memcpy(p_info->buf, p_data, length);
+      qringCommit(&p_tx->nkro_q);
+    }
+  }
+  return sent;
+}
+
+void usbHidTxOnSof(hid_tx_t *p_tx)
+{
+  p_tx->sof_cnt++;
+}
+
+// TIM2 비교 ISR. 키보드 리포트를 실었으면 true
+bool usbHidTxDrain(hid_tx_t *p_tx, uint32_t now_us)
+{
+  bool kbd_loaded = false;
+
+  // V261018R3: EP 별 상태를 보므로 같은 펄스에서 세 큐를 모두 처리할 수 있다.
+  // V261021R5: JIT 잠금 중에는 폴링되지 않는 마이크로프레임의 비교 시점을 건너뛰고 계속 병합한다.
+  if (usbHidCoalesceAvailable(&p_tx->kbd_q) > 0 && usbHidTxEpIsIdle(p_tx, HID_EPIN_ADDR) &&
+      (usbHidJitIsActive(&p_tx->jit) != true || usbHidTxIsPolledFrame(p_tx) == true))
+  {
+    usbHidCoalescePop(&p_tx->kbd_q, p_tx->p_kbd_buf, now_us);         // V261018R2: 대기 시간(us) 집계
+    usbHidTxBeginInflight(p_tx, &p_tx->kbd_q.last, now_us);           // V261018R4
+    usbHidTxStart(p_tx, HID_EPIN_ADDR, p_tx->p_kbd_buf, p_tx->kbd_len);
+    kbd_loaded = true;
+  }
+
+  if (qringAvailable(&p_tx->exk_q) > 0 && usbHidTxEpIsIdle(p_tx, HID_EXK_EP_IN))
+  {
+    exk_report_info_t *p_info = qringPeek(&p_tx->exk_q);             // V261017R9: 슬롯에서 바로 복사
+
+    memcpy(p_tx->p_exk_buf, p_info->buf, p_info->len);
+    usbHidTxStart(p_tx, HID_EXK_EP_IN, p_tx->p_exk_buf, p_info->len);
+    qringRelease(&p_tx->exk_q, 1);
+  }
+
+  if (qringAvailable(&p_tx->nkro_q) > 0 && usbHidTxEpIsIdle(p_tx, HID_NKRO_EP_IN))
+  {
+    qringRead(&p_tx->nkro_q, p_tx->p_nkro_buf, 1);                    // V261018R1
+    usbHidTxStart(p_tx, HID_NKRO_EP_IN, p_tx->p_nkro_buf, HID_NKRO_EP_SIZE);
+  }
+
+  return kbd_loaded;
+}
+
+// 키보드 EP DataIn. IN 위상 샘플 + 변경→IN 지연 집계, TIM2 비교 시점이 바뀌었으면 true
+bool usbHidTxOnKeyboardDataIn(hid_tx_t *p_tx, uint32_t now_us, uint32_t sof_us)
+{
+  bool changed = usbHidJitSample(&p_tx->jit, sof_us);
+
+  p_tx->in_sof_cnt   = p_tx->sof_cnt;                                 // V261021R5: 폴링되는 마이크로프레임 기준
+  p_tx->in_sof_valid = true;
+
+  if (p_tx->inflight.change_cnt > 0)
+  {
+    uint32_t sum_us = p_tx->inflight.change_cnt * now_us - p_tx->inflight.change_sum_us;
+
+    usbHidJitAddLatency(&p_tx->jit, p_tx->inflight_path, p_tx->inflight.change_cnt, sum_us, now_us - p_tx->inflight.time_us);
+    if (p_tx->inflight_path == HID_JIT_PATH_JIT && now_us - p_tx->inflight_load_us > usbHidTxGetPollUs(p_tx))   // V261021R5
+    {
+      p_tx->jit.miss_cnt++;
+    }
+    p_tx->inflight.change_cnt = 0;
+  }
+  return changed;
+}
@@ -0,0 +1,82 @@
+#pragma once
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "qring.h"
+#include "usbd_hid.h"
+#include "usbd_hid_internal.h"
+#include "usbd_hid_coalesce.h"
+#include "usbd_hid_jit.h"
+
+
+// V261021R4: HID IN 전송 정책 (EP 별 상태 표 + 키보드/EXK/NKRO 대기열 + JIT 적재)
+//   - usbd_hid.c 의 usbHidSendReport*Now(), TIM2 드레인, ep_state 를 옮겨 왔다.
+//   - 실제 전송(USBD_LL_Transmit)과 TIM2 카운터/비교 레지스터는 호출자가 맡고, 시각은 인자로 받는다.
+//   - 레지스터 비의존 코드라 호스트 시뮬레이터도 같은 소스를 빌드한다.
+#define HID_TX_EXK_Q_MAX          128
+#define HID_TX_NKRO_Q_MAX         64
+#define HID_TX_BACKUP_HS_US       120                 // V251012R1 HS/uSOF 백업 비교 시점
+#define HID_TX_BACKUP_FS_US       975                 // V251012R1 FS 프레임 종료 직전 백업 비교 시점
+
+
+typedef bool (*hid_tx_func_t)(uint8_t ep_addr, uint8_t *p_data, uint16_t length);
+
+typedef struct
+{
+  uint8_t len;
+  uint8_t buf[HID_EXK_EP_SIZE];
+} exk_report_info_t;
+
+typedef struct
+{
+  uint8_t buf[HID_NKRO_EP_SIZE];
+} nkro_report_info_t;
+
+typedef struct
+{
+  volatile USBD_HID_StateTypeDef ep_state[HID_IN_EP_NUM_MAX];   // V261018R3: IN EP 마다 독립적인 전송 중 상태
+  hid_tx_func_t      tx_func;                                   // 실제 전송 (펌웨어: USBD_LL_Transmit)
+  uint8_t           *p_kbd_buf;                                 // EP 버퍼 (전송 중에는 건드리지 않음)
+  uint8_t           *p_exk_buf;
+  uint8_t           *p_nkro_buf;
+  uint16_t           kbd_len;                                   // V261018R1: Boot 프로토콜이면 8
+
+  hid_coalesce_t     kbd_q;                                     // V261018R2: 스냅샷 대신 전이 단위로 쌓는 병합 큐
+  qring_t            exk_q;
+  exk_report_info_t  exk_buf[HID_TX_EXK_Q_MAX];
+  qring_t            nkro_q;                                    // V261018R1: NKRO 리포트 대기열
+  nkro_report_info_t nkro_buf[HID_TX_NKRO_Q_MAX];
+
+  hid_jit_t          jit;                                       // V261018R4: IN 위상 학습 + 변경→IN 지연 통계
+  hid_coalesce_rec_t inflight;                                  // 전송 중 리포트에 실린 변경 (buf 미사용)
+  hid_jit_path_t     inflight_path;
+  uint32_t           inflight_load_us;
+
+  uint32_t           poll_div;                                  // V261021R5: 키보드 EP 폴링 주기 / SOF 주기 (HS bInterval 2 → 2, 3 → 4)
+  uint32_t           sof_cnt;                                   // V261021R5: SOF 수 (wrap 허용)
+  uint32_t           in_sof_cnt;                                // V261021R5: 마지막 키보드 IN 완료가 있었던 SOF 번호
+  bool               in_sof_valid;
+} hid_tx_t;
+
+
+void usbHidTxInit(hid_tx_t *p_tx, hid_tx_func_t tx_func, uint8_t *p_kbd_buf, uint8_t *p_exk_buf, uint8_t *p_nkro_buf);
+void usbHidTxReset(hid_tx_t *p_tx, bool configured);
+void usbHidTxSetKeyboardLength(hid_tx_t *p_tx, uint16_t length);
+void usbHidTxSetPollDiv(hid_tx_t *p_tx, uint32_t poll_div);
+uint32_t usbHidTxGetPollUs(hid_tx_t *p_tx);
+
+// EP 상태 (메인 루프 / USB ISR)
+bool usbHidTxEpIsIdle(hid_tx_t *p_tx, uint8_t ep_addr);
+bool usbHidTxStart(hid_tx_t *p_tx, uint8_t ep_addr, uint8_t *p_data, uint16_t length);
+void usbHidTxOnDataIn(hid_tx_t *p_tx, uint8_t ep_addr);
+
+// 생산자 (메인 루프). sof_us 는 SOF 기준 현재 오프셋 (TIM2 카운터)
+bool usbHidTxKeyboard(hid_tx_t *p_tx, const uint8_t *p_data, uint16_t length, uint32_t now_us, uint32_t sof_us);
+bool usbHidTxExk(hid_tx_t *p_tx, const uint8_t *p_data, uint16_t length);
+bool usbHidTxNkro(hid_tx_t *p_tx, const uint8_t *p_data, uint16_t length);
+
+// 소비자 (SOF ISR / TIM2 비교 ISR / 키보드 DataIn)
+void usbHidTxOnSof(hid_tx_t *p_tx);
+bool usbHidTxDrain(hid_tx_t *p_tx, uint32_t now_us);
+bool usbHidTxOnKeyboardDataIn(hid_tx_t *p_tx, uint32_t now_us, uint32_t sof_us);
@@ -0,0 +1,143 @@
+#include "usbd_hid_via.h"
+
+#include <string.h>
+
+
+// ---------------------------------------------------------------------------
+// [VIA Pipeline] V261018R6
+//   - V261018R5 까지는 응답 하나를 보낼 때만 OUT 을 재무장했고, 마지막 적재 후 20ms 가 지나야 보냈다.
+//     요청 하나가 최소 20ms 를 차지해 키맵 전체 읽기가 28B/20ms 로 묶였다.
+//   - 지금은 응답을 IN EP 가 비는 즉시 싣고, 응답 전 요청이 window 개 미만이면 OUT 을 바로 재무장한다.
+//   - pending/out_armed 는 OTG ISR(DataOut/DataIn/SOF) 에서만 바뀐다. 메인 루프는 큐에 적재만 한다.
+// ---------------------------------------------------------------------------
+
+
+
+
+static uint32_t usbHidViaClampWindow(uint32_t window)
+{
+  if (window == 0)
+  {
+    return 1;
+  }
+  if (window > HID_VIA_WINDOW_MAX)
+  {
+    return HID_VIA_WINDOW_MAX;
+  }
+  return window;
+}
+
+void usbHidViaInit(hid_via_t *p_via, uint32_t gate_ms, uint32_t window)
+{
+  memset(p_via, 0, sizeof(hid_via_t));
+
+  qringCreate(&p_via->q, p_via->buf, sizeof(hid_via_packet_t), HID_VIA_TX_DEPTH);
+  usbHidViaSetMode(p_via, gate_ms, window);
+  usbHidViaReset(p_via);
+}
+
+void usbHidViaSetMode(hid_via_t *p_via, uint32_t gate_ms, uint32_t window)
+{
+  p_via->gate_ms = gate_ms;
+  p_via->window  = usbHidViaClampWindow(window);
+}
+
+// USB 재구성 시 OUT 은 새로 무장되고 이전 요청은 호스트가 버린 것으로 본다.
+// V261020R4: 재구성 전에 쌓인 응답도 버린다. 남겨 두면 새 호스트의 첫 요청에 이전 응답이 나간다.
+//            OTG ISR(소비자) 문맥에서 호출되므로 소비자 쪽 인덱스만 옮기는 qringFlush() 로 비운다.
+void usbHidViaReset(hid_via_t *p_via)
+{
+  qringFlush(&p_via->q);
+  p_via->pending   = 0;
+  p_via->out_armed = true;
+}
+
+void usbHidViaClearStat(hid_via_t *p_via)
+{
+  p_via->rx_cnt      = 0;
+  p_via->tx_cnt      = 0;
+  p_via->hold_cnt    = 0;
+  p_via->pending_max = p_via->pending;
+}
+
+bool usbHidViaPush(hid_via_t *p_via, const uint8_t *p_data, uint8_t length, uint32_t now_ms)
+{
+  hid_via_packet_t *p_packet = qringReserve(&p_via->q);
+
+  if (p_packet == NULL)
+  {
+    return false;
+  }
+  if (length > sizeof(p_packet->buf))
+  {
+    length = sizeof(p_packet->buf);
+  }
+
+  memset(p_packet->buf, 0, sizeof(p_packet->buf));
+  memcpy(p_packet->buf, p_data, length);
+  p_via->push_ms = now_ms;
+  qringCommit(&p_via->q);
+  return true;
+}
+
+// DataOut 에서 요청을 넘긴 뒤 호출한다. true 면 OUT 을 바로 재무장한다.
+// V261020R4: queued 는 수신 함수가 요청을 RX 큐에 실었는지 여부. 빈 패킷처럼 싣지 않은 요청은
+//            응답이 나오지 않으므로 pending 에 넣지 않는다 (넣으면 window 개 뒤 OUT 이 영구히 잡힌다).
+bool usbHidViaOnReceive(hid_via_t *p_via, bool queued)
+{
+  p_via->rx_cnt++;
+  if (queued != true)
+  {
+    p_via->out_armed = p_via->pending < p_via->window;
+    return p_via->out_armed;
+  }
+  p_via->pending++;
+  if (p_via->pending > p_via->pending_max)
+  {
+    p_via->pending_max = p_via->pending;
+  }
+
+  p_via->out_armed = p_via->pending < p_via->window;
+  if (p_via->out_armed != true)
+  {
+    p_via->hold_cnt++;
+  }
+  return p_via->out_armed;
+}
+
+// VIA IN EP 가 idle 일 때 호출한다. true 면 p_data 를 IN 에 싣는다.
+bool usbHidViaPop(hid_via_t *p_via, uint8_t *p_data, uint32_t now_ms)
+{
+  if (qringAvailable(&p_via->q) == 0)
+  {
+    return false;
+  }
+  if (p_via->gate_ms > 0 && (now_ms - p_via->push_ms) < p_via->gate_ms)
+  {
+    return false;
+  }
+
+  qringRead(&p_via->q, p_data, 1);
+  p_via->tx_cnt++;
+  if (p_via->pending > 0)
+  {
+    p_via->pending--;
+  }
+  return true;
+}
+
+// 미뤄 둔 OUT 재무장이 가능해졌으면 true (한 번만).
+bool usbHidViaTakeRearm(hid_via_t *p_via)
+{
+  if (p_via->out_armed == true || p_via->pending >= p_via->window)
+  {
+    return false;
+  }
+  p_via->out_armed = true;
+  return true;
+}
+
+uint32_t usbHidViaAvailable(hid_via_t *p_via)
+{
+  return qringAvailable(&p_via->q);
+}
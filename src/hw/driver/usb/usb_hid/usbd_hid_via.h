@@ -0,0 +1,58 @@
+#pragma once
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "hw_def.h"
+#include "qring.h"
+
+
+// V261018R6: VIA RAW HID 파이프라인 전송
+//   - 응답은 VIA IN EP 가 비는 즉시(DataIn/SOF) 싣는다. 고정 지연 게이트는 gate_ms > 0 일 때만 쓴다.
+//   - 수신했지만 응답을 아직 싣지 않은 요청 수가 window 에 차면 OUT EP 를 재무장하지 않는다.
+//     호스트는 NAK 를 받고 재시도하므로 이것이 호스트 쪽 흐름 제어가 된다.
+//   - gate_ms 20, window 1 이면 V261018R5 까지의 동작(응답 전송 시 OUT 재무장 + 20ms 게이트)과 같다.
+//   - 레지스터 비의존 코드라 호스트 시뮬레이터도 같은 소스를 빌드한다.
+#define HID_VIA_PACKET_SIZE       32
+#define HID_VIA_TX_DEPTH          128                 // 응답 대기 큐 (2^n)
+#define HID_VIA_WINDOW_MAX        16                  // via_hid.c RX 큐 깊이를 넘지 않음
+#define HID_VIA_LEGACY_GATE_MS    20
+#define HID_VIA_LEGACY_WINDOW     1
+
+
+typedef struct
+{
+  uint8_t buf[HID_VIA_PACKET_SIZE];
+} hid_via_packet_t;
+
+typedef struct
+{
+  qring_t           q;
+  hid_via_packet_t  buf[HID_VIA_TX_DEPTH];
+
+  uint32_t          gate_ms;
+  uint32_t          window;
+  uint32_t          pending;                          // 수신 후 응답 전 요청 수 (OTG ISR 만 갱신)
+  bool              out_armed;
+  volatile uint32_t push_ms;                          // 마지막 응답 적재 시각 (게이트용)
+
+  uint32_t          rx_cnt;
+  uint32_t          tx_cnt;
+  uint32_t          hold_cnt;                         // window 가 차서 OUT 재무장을 미룬 횟수
+  uint32_t          pending_max;
+} hid_via_t;
+
+
+void     usbHidViaInit(hid_via_t *p_via, uint32_t gate_ms, uint32_t window);
+void     usbHidViaSetMode(hid_via_t *p_via, uint32_t gate_ms, uint32_t window);
+void     usbHidViaReset(hid_via_t *p_via);
+void     usbHidViaClearStat(hid_via_t *p_via);
+
+// 생산자 (메인 루프)
+bool     usbHidViaPush(hid_via_t *p_via, const uint8_t *p_data, uint8_t length, uint32_t now_ms);
+
+// 소비자 (OTG ISR)
+bool     usbHidViaOnReceive(hid_via_t *p_via, bool queued);   // V261020R4: 큐에 실린 요청만 pending 에 포함
+bool     usbHidViaPop(hid_via_t *p_via, uint8_t *p_data, uint32_t now_ms);
+bool     usbHidViaTakeRearm(hid_via_t *p_via);
+uint32_t usbHidViaAvailable(hid_via_t *p_via);
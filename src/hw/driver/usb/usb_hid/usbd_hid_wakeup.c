@@ -0,0 +1,144 @@
+#include "usbd_hid_wakeup.h"
+
+#include <string.h>
+
+
+// ---------------------------------------------------------------------------
+// [Remote WakeUp] V261019R1
+//   - V261018R9 까지 usbHidUpdateWakeUp() 은 리포트 경로에서 delay(10) 으로 K 상태를 유지해 그동안 스캔이 멈췄고,
+//     서스펜드 분기는 아무것도 큐에 넣지 않아 호스트를 깨운 키 입력이 사라졌다.
+//   - 지금은 K 상태 시작/종료를 단계로 나누고 리포트는 재개 후 순서대로 다시 보낸다.
+//   - 가득 차면 같은 EP 의 마지막 보관 리포트를 새 리포트로 덮어 최종 상태를 지킨다 (중간 전이만 잃음).
+// ---------------------------------------------------------------------------
+
+
+
+
+void usbHidWakeUpInit(hid_wakeup_t *p_wakeup, uint32_t signal_ms, uint32_t timeout_ms)
+{
+  memset(p_wakeup, 0, sizeof(hid_wakeup_t));
+
+  p_wakeup->stage      = HID_WAKEUP_IDLE;
+  p_wakeup->signal_ms  = signal_ms;
+  p_wakeup->timeout_ms = timeout_ms;
+  qringCreate(&p_wakeup->q, p_wakeup->q_buf, sizeof(hid_wakeup_rec_t), HID_WAKEUP_BUF_MAX);
+}
+
+bool usbHidWakeUpPush(hid_wakeup_t *p_wakeup, uint8_t ep, const uint8_t *p_data, uint16_t length)
+{
+  hid_wakeup_rec_t *p_rec;
+
+  if (length > HID_WAKEUP_REPORT_MAX)
+  {
+    p_wakeup->drop_cnt++;
+    return false;
+  }
+
+  p_rec = qringReserve(&p_wakeup->q);
+  if (p_rec == NULL)
+  {
+    uint32_t cnt = qringAvailable(&p_wakeup->q);
+
+    for (uint32_t i=cnt; i>0; i--)
+    {
+      hid_wakeup_rec_t *p_old = qringPeekAt(&p_wakeup->q, i - 1);
+
+      if (p_old->ep == ep)
+      {
+        p_rec = p_old;
+        break;
+      }
+    }
+    if (p_rec == NULL)
+    {
+      p_wakeup->drop_cnt++;
+      return false;
+    }
+    p_rec->len = (uint8_t)length;
+    memcpy(p_rec->buf, p_data, length);
+    p_wakeup->merge_cnt++;
+    return true;
+  }
+
+  p_rec->ep  = ep;
+  p_rec->len = (uint8_t)length;
+  memcpy(p_rec->buf, p_data, length);
+  qringCommit(&p_wakeup->q);
+  p_wakeup->push_cnt++;
+  return true;
+}
+
+bool usbHidWakeUpRequest(hid_wakeup_t *p_wakeup, uint32_t now_ms)
+{
+  if (p_wakeup->stage != HID_WAKEUP_IDLE)
+  {
+    return false;
+  }
+
+  p_wakeup->stage    = HID_WAKEUP_SIGNAL;
+  p_wakeup->req_ms   = now_ms;
+  p_wakeup->stage_ms = now_ms;
+  return true;
+}
+
+hid_wakeup_act_t usbHidWakeUpStep(hid_wakeup_t *p_wakeup, uint32_t now_ms, bool ready)
+{
+  switch (p_wakeup->stage)
+  {
+    case HID_WAKEUP_SIGNAL:
+      if (now_ms - p_wakeup->stage_ms < p_wakeup->signal_ms)
+      {
+        break;
+      }
+      p_wakeup->stage    = HID_WAKEUP_RESUME;
+      p_wakeup->stage_ms = now_ms;
+      return HID_WAKEUP_ACT_SIGNAL_END;
+
+    case HID_WAKEUP_RESUME:
+      if (ready == true)
+      {
+        p_wakeup->stage     = HID_WAKEUP_IDLE;
+        p_wakeup->resume_ms = now_ms - p_wakeup->req_ms;
+        p_wakeup->wake_cnt++;
+        return HID_WAKEUP_ACT_REPLAY;
+      }
+      if (now_ms - p_wakeup->stage_ms >= p_wakeup->timeout_ms)
+      {
+        p_wakeup->stage     = HID_WAKEUP_IDLE;
+        p_wakeup->drop_cnt += qringAvailable(&p_wakeup->q);
+        p_wakeup->timeout_cnt++;
+        qringFlush(&p_wakeup->q);
+        return HID_WAKEUP_ACT_TIMEOUT;
+      }
+      break;
+
+    default:
+      // 호스트가 먼저 재개한 경우 (깨우기 신호 없이 보관만 된 리포트)
+      if (ready == true && qringAvailable(&p_wakeup->q) > 0)
+      {
+        return HID_WAKEUP_ACT_REPLAY;
+      }
+      break;
+  }
+  return HID_WAKEUP_ACT_NONE;
+}
+
+bool usbHidWakeUpPop(hid_wakeup_t *p_wakeup, hid_wakeup_rec_t *p_rec)
+{
+  if (qringRead(&p_wakeup->q, p_rec, 1) != true)
+  {
+    return false;
+  }
+  p_wakeup->replay_cnt++;
+  return true;
+}
+
+uint32_t usbHidWakeUpAvailable(hid_wakeup_t *p_wakeup)
+{
+  return qringAvailable(&p_wakeup->q);
+}
+
+bool usbHidWakeUpIsBusy(const hid_wakeup_t *p_wakeup)
+{
+  return p_wakeup->stage != HID_WAKEUP_IDLE;
+}
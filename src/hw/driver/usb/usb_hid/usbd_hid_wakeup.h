@@ -0,0 +1,68 @@
+#pragma once
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "hw_def.h"
+#include "qring.h"
+
+
+// V261019R1: 비차단 원격 깨우기 + 재개 전 리포트 보관
+//   - 서스펜드 중 리포트가 생기면 원격 깨우기(K 상태)를 시작하고 리포트는 보관한다.
+//   - K 상태 유지 시간과 재개 대기는 메인 루프(idle_task)가 시각으로 판단한다. delay() 로 스캔을 멈추지 않는다.
+//   - 버스가 재개되어 CONFIGURED 로 돌아오면 보관한 리포트를 EP 구분 없이 넣은 순서대로 다시 보낸다.
+//   - 적재/재생은 모두 메인 루프에서 한다. 레지스터 비의존 코드라 호스트 시뮬레이터도 같은 소스를 빌드한다.
+#define HID_WAKEUP_BUF_MAX        32                  // 보관 리포트 수 (2^n)
+#define HID_WAKEUP_REPORT_MAX     32                  // 보관 리포트 최대 길이 (NKRO 32B)
+
+
+typedef enum
+{
+  HID_WAKEUP_IDLE = 0,
+  HID_WAKEUP_SIGNAL,                                  // 원격 깨우기 K 상태 구동 중
+  HID_WAKEUP_RESUME,                                  // 호스트 재개 + CONFIGURED 대기
+} hid_wakeup_stage_t;
+
+typedef enum
+{
+  HID_WAKEUP_ACT_NONE = 0,
+  HID_WAKEUP_ACT_SIGNAL_END,                          // HAL_PCD_DeActivateRemoteWakeup()
+  HID_WAKEUP_ACT_REPLAY,                              // 보관 리포트 재전송
+  HID_WAKEUP_ACT_TIMEOUT,                             // 호스트가 재개하지 않음, 보관 리포트 폐기
+} hid_wakeup_act_t;
+
+typedef struct
+{
+  uint8_t ep;                                         // IN EP 주소
+  uint8_t len;
+  uint8_t buf[HID_WAKEUP_REPORT_MAX];
+} hid_wakeup_rec_t;
+
+typedef struct
+{
+  hid_wakeup_stage_t stage;
+  uint32_t           signal_ms;                       // K 상태 유지 시간 (USB 2.0 7.1.7.7: 1~15ms)
+  uint32_t           timeout_ms;                      // K 상태 종료 후 재개 대기 한도
+  uint32_t           req_ms;                          // 마지막 깨우기 시작 시각
+  uint32_t           stage_ms;
+
+  qring_t            q;
+  hid_wakeup_rec_t   q_buf[HID_WAKEUP_BUF_MAX];
+
+  uint32_t           wake_cnt;                        // 재개까지 완료한 깨우기 수
+  uint32_t           timeout_cnt;
+  uint32_t           push_cnt;                        // 보관한 리포트 수
+  uint32_t           merge_cnt;                       // 가득 차 같은 EP 의 마지막 보관 리포트를 덮어쓴 수
+  uint32_t           drop_cnt;                        // 버린 리포트 수 (가득 참 + 재개 실패)
+  uint32_t           replay_cnt;                      // 재전송한 리포트 수
+  uint32_t           resume_ms;                       // 마지막 깨우기 시작 → 재개/CONFIGURED
+} hid_wakeup_t;
+
+
+void             usbHidWakeUpInit(hid_wakeup_t *p_wakeup, uint32_t signal_ms, uint32_t timeout_ms);
+bool             usbHidWakeUpPush(hid_wakeup_t *p_wakeup, uint8_t ep, const uint8_t *p_data, uint16_t length);
+bool             usbHidWakeUpRequest(hid_wakeup_t *p_wakeup, uint32_t now_ms);   // true = 지금 K 상태를 시작
+hid_wakeup_act_t usbHidWakeUpStep(hid_wakeup_t *p_wakeup, uint32_t now_ms, bool ready);   // ready = 재개 + CONFIGURED
+bool             usbHidWakeUpPop(hid_wakeup_t *p_wakeup, hid_wakeup_rec_t *p_rec);
+uint32_t         usbHidWakeUpAvailable(hid_wakeup_t *p_wakeup);
+bool             usbHidWakeUpIsBusy(const hid_wakeup_t *p_wakeup);
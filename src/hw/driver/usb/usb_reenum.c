@@ -0,0 +1,103 @@
+#include "usb_reenum.h"
+
+#include <string.h>
+
+
+// ---------------------------------------------------------------------------
+// [USB ReEnum] V261018R8
+//   - V261018R7 까지 폴링 모드 변경은 BootMode 저장 후 40ms 유예 → 분리 → 100ms → resetToReset() 이었다.
+//     키 상태, 탭 상태, RGB 상태가 모두 사라지고 부팅/EEPROM 로드/열거를 거쳐야 다시 입력이 들어갔다.
+//   - 지금은 같은 유예/분리 시간을 메인 루프에서 비차단으로 기다린 뒤 usbBegin() 으로 다시 붙는다.
+//     디스크립터 bInterval 과 PCD 속도는 BootMode 값을 읽어 만들므로 저장된 모드가 그대로 반영된다.
+// ---------------------------------------------------------------------------
+
+
+
+
+void usbReEnumInit(usb_reenum_t *p_reenum, uint32_t detach_ms, uint32_t timeout_ms)
+{
+  memset(p_reenum, 0, sizeof(usb_reenum_t));
+
+  p_reenum->stage      = USB_REENUM_IDLE;
+  p_reenum->detach_ms  = detach_ms;
+  p_reenum->timeout_ms = timeout_ms;
+}
+
+// 진행 중인 재열거가 있으면 모드만 바꿔 이어서 쓴다 (분리 전이면 새 모드로 붙는다).
+bool usbReEnumRequest(usb_reenum_t *p_reenum, uint8_t usb_mode, uint32_t now_ms, uint32_t grace_ms)
+{
+  p_reenum->usb_mode = usb_mode;
+  if (p_reenum->stage != USB_REENUM_IDLE)
+  {
+    return true;
+  }
+
+  p_reenum->stage       = USB_REENUM_GRACE;
+  p_reenum->req_ms      = now_ms;
+  p_reenum->stage_ms    = now_ms + grace_ms;
+  p_reenum->wait_report = false;
+  return true;
+}
+
+bool usbReEnumIsBusy(const usb_reenum_t *p_reenum)
+{
+  return p_reenum->stage != USB_REENUM_IDLE;
+}
+
+usb_reenum_act_t usbReEnumStep(usb_reenum_t *p_reenum, uint32_t now_ms, bool configured)
+{
+  switch (p_reenum->stage)
+  {
+    case USB_REENUM_GRACE:
+      if ((int32_t)(now_ms - p_reenum->stage_ms) < 0)
+      {
+        break;
+      }
+      p_reenum->stage    = USB_REENUM_DETACHED;
+      p_reenum->stage_ms = now_ms + p_reenum->detach_ms;
+      return USB_REENUM_ACT_DETACH;
+
+    case USB_REENUM_DETACHED:
+      if ((int32_t)(now_ms - p_reenum->stage_ms) < 0)
+      {
+        break;
+      }
+      p_reenum->stage     = USB_REENUM_ENUM;
+      p_reenum->attach_ms = now_ms;
+      return USB_REENUM_ACT_ATTACH;
+
+    case USB_REENUM_ENUM:
+      if (configured == true)
+      {
+        p_reenum->stage       = USB_REENUM_IDLE;
+        p_reenum->enum_ms     = now_ms - p_reenum->attach_ms;
+        p_reenum->wait_report = true;
+        p_reenum->count++;
+        return USB_REENUM_ACT_RESEND;
+      }
+      if (now_ms - p_reenum->attach_ms >= p_reenum->timeout_ms)
+      {
+        p_reenum->stage = USB_REENUM_IDLE;
+        p_reenum->timeout_cnt++;
+        return USB_REENUM_ACT_TIMEOUT;
+      }
+      break;
+
+    default:
+      break;
+  }
+  return USB_REENUM_ACT_NONE;
+}
+
+void usbReEnumOnReport(usb_reenum_t *p_reenum, uint32_t now_ms)
+{
+  if (p_reenum->boot_report_ms == 0)
+  {
+    p_reenum->boot_report_ms = now_ms > 0 ? now_ms : 1;
+  }
+  if (p_reenum->wait_report == true)
+  {
+    p_reenum->wait_report     = false;
+    p_reenum->first_report_ms = now_ms - p_reenum->req_ms;
+  }
+}
@@ -0,0 +1,59 @@
+#pragma once
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "hw_def.h"
+
+
+// V261018R8: MCU 리셋 없는 USB 재열거 (폴링 모드 변경)
+//   - 응답 유예 → USBD 분리 → 호스트가 디태치를 감지할 시간 → usbBegin() 재접속 → CONFIGURED 후 눌린 키 재전송.
+//   - QMK 코어(키맵/레이어/탭 상태/RGB)는 계속 동작하며, 분리 구간의 리포트는 재전송으로 덮어쓴다.
+//   - CONFIGURED 가 timeout_ms 안에 오지 않으면 TIMEOUT 을 돌려 기존 리셋 경로로 넘긴다.
+//   - 단계 판단만 하고 USBD 호출은 usb.c 가 한다. 레지스터 비의존 코드라 호스트 시뮬레이터도 같은 소스를 빌드한다.
+
+
+typedef enum
+{
+  USB_REENUM_IDLE = 0,
+  USB_REENUM_GRACE,                                   // VIA 응답 송신 유예
+  USB_REENUM_DETACHED,                                // 분리 후 호스트 감지 대기
+  USB_REENUM_ENUM,                                    // 재접속 후 CONFIGURED 대기
+  USB_REENUM_STAGE_MAX
+} usb_reenum_stage_t;
+
+typedef enum
+{
+  USB_REENUM_ACT_NONE = 0,
+  USB_REENUM_ACT_DETACH,                              // USBD_Stop/DeInit
+  USB_REENUM_ACT_ATTACH,                              // usbBegin(usb_mode)
+  USB_REENUM_ACT_RESEND,                              // 눌린 키/확장 키 재전송
+  USB_REENUM_ACT_TIMEOUT,                             // 재열거 실패 → 리셋 경로
+} usb_reenum_act_t;
+
+typedef struct
+{
+  usb_reenum_stage_t stage;
+  uint8_t            usb_mode;                        // 재접속할 UsbMode_t
+  uint32_t           detach_ms;
+  uint32_t           timeout_ms;
+  uint32_t           req_ms;                          // 요청 시각
+  uint32_t           stage_ms;                        // 현재 단계 만료/시작 시각
+  uint32_t           attach_ms;
+  volatile bool      wait_report;                     // 재전송 리포트의 IN 완료 대기
+
+  uint32_t           count;                           // 완료한 재열거 수
+  uint32_t           timeout_cnt;
+  uint32_t           enum_ms;                         // 마지막 재접속 → CONFIGURED
+  volatile uint32_t  first_report_ms;                 // 마지막 요청 → 첫 리포트 IN 완료
+  volatile uint32_t  boot_report_ms;                  // 부팅 → 첫 리포트 IN 완료 (리셋 경로 비교용)
+} usb_reenum_t;
+
+
+void     usbReEnumInit(usb_reenum_t *p_reenum, uint32_t detach_ms, uint32_t timeout_ms);
+bool     usbReEnumRequest(usb_reenum_t *p_reenum, uint8_t usb_mode, uint32_t now_ms, uint32_t grace_ms);
+bool     usbReEnumIsBusy(const usb_reenum_t *p_reenum);
+usb_reenum_act_t usbReEnumStep(usb_reenum_t *p_reenum, uint32_t now_ms, bool configured);
+
+// 키보드 EP IN 완료 (OTG ISR)
+void     usbReEnumOnReport(usb_reenum_t *p_reenum, uint32_t now_ms);
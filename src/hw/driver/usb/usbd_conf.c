@@ -50,11 +50,131 @@
 #include "usbd_cdc.h"
 
 
-PCD_HandleTypeDef hpcd_USB_OTG_HS;
+// V261018R5: DMA 빌드에서는 SETUP 패킷(hpcd->Setup)도 DMA 가 쓰므로 PCD 핸들을 비캐시 영역에 둔다.
+USBD_DMA_BUF PCD_HandleTypeDef hpcd_USB_OTG_HS;
 void Error_Handler(void);
 static bool is_connected = false;
 static bool is_suspended = false;
 
+
+// ---------------------------------------------------------------------------
+// [OTG DMA] V261018R5
+//   - PIO 는 OTG_HS_IRQHandler 안에서 CPU 가 패킷마다 FIFO 를 채우고 비운다 (8kHz x EP 수).
+//   - DMA 는 OTG 내부 AHB 마스터가 버퍼를 직접 읽고 써서 ISR 은 완료 처리만 한다.
+//   - OTG DMA 는 DTCM 에 접근할 수 없고 D-Cache 와 일관성이 없으므로 버퍼를 세 갈래로 처리한다.
+//       1) .non_cache(BUF) 버퍼 : 그대로 전달 (HID/VIA/CDC 데이터 버퍼, USBD_DMA_BUF)
+//       2) 슬롯 이하 크기       : EP 별 32B 정렬 바운스 슬롯으로 복사 (EP0 디스크립터/요청, 스택 버퍼)
+//       3) 캐시 영역 큰 송신    : D-Cache 클린 후 전달, 수신/DTCM 은 거부하고 reject 로 집계
+// ---------------------------------------------------------------------------
+#if HW_USB_OTG_DMA == 1
+#define USBD_DMA_EP_MAX           9                   // dev_endpoints
+#define USBD_DMA_SLOT_SIZE        64                  // HID/VIA/EXK/NKRO 최대 패킷
+#define USBD_DMA_EP0_SLOT_SIZE    USBD_MAX_STR_DESC_SIZ  // EP0 IN 은 디스크립터 전체를 한 번에 넘김
+
+#define USBD_DMA_NON_CACHE_BEGIN  0x24000000U         // bsp.c MPU_REGION_NUMBER2 (BUF 16KB, 비캐시)
+#define USBD_DMA_NON_CACHE_END    0x24004000U
+#define USBD_DMA_AXI_BEGIN        0x24000000U         // bsp.c MPU_REGION_NUMBER1 (AXI SRAM, write-back)
+#define USBD_DMA_AXI_END          0x24080000U
+
+static USBD_DMA_BUF uint8_t usbd_dma_ep0_in_slot[USBD_DMA_EP0_SLOT_SIZE];
+static USBD_DMA_BUF uint8_t usbd_dma_in_slot[USBD_DMA_EP_MAX][USBD_DMA_SLOT_SIZE];
+static USBD_DMA_BUF uint8_t usbd_dma_out_slot[USBD_DMA_EP_MAX][USBD_DMA_SLOT_SIZE];
+static uint8_t             *usbd_dma_out_user[USBD_DMA_EP_MAX];   // 바운스 수신 시 복사할 원래 버퍼
+static usbd_dma_info_t      usbd_dma_info = {.enable = true};
+
+static bool usbdDmaIsNonCache(const uint8_t *pbuf, uint32_t size)
+{
+  uint32_t addr = (uint32_t)pbuf;
+
+  return addr >= USBD_DMA_NON_CACHE_BEGIN && addr + size <= USBD_DMA_NON_CACHE_END;
+}
+
+static uint8_t *usbdDmaPrepareTx(uint8_t ep_addr, uint8_t *pbuf, uint32_t size)
+{
+  uint8_t  ep_num    = ep_addr & 0x0FU;
+  uint32_t addr      = (uint32_t)pbuf;
+  uint32_t slot_size = ep_num == 0 ? USBD_DMA_EP0_SLOT_SIZE : USBD_DMA_SLOT_SIZE;
+  uint8_t *p_slot    = ep_num == 0 ? usbd_dma_ep0_in_slot : usbd_dma_in_slot[ep_num];
+
+  if (pbuf == NULL || usbdDmaIsNonCache(pbuf, size) == true)
+  {
+    usbd_dma_info.tx_direct++;
+    return pbuf;
+  }
+  if (ep_num < USBD_DMA_EP_MAX && size <= slot_size)
+  {
+    memcpy(p_slot, pbuf, size);
+    usbd_dma_info.tx_bounce++;
+    return p_slot;
+  }
+  if (addr >= USBD_DMA_AXI_BEGIN && addr + size <= USBD_DMA_AXI_END && (addr & 0x03U) == 0)
+  {
+    uint32_t line_addr = addr & ~0x1FU;
+
+    SCB_CleanDCache_by_Addr((uint32_t *)line_addr, (int32_t)(addr + size - line_addr));
+    usbd_dma_info.tx_clean++;
+    return pbuf;
+  }
+  usbd_dma_info.reject++;
+  return NULL;
+}
+
+static uint8_t *usbdDmaPrepareRx(uint8_t ep_addr, uint8_t *pbuf, uint32_t size)
+{
+  uint8_t ep_num = ep_addr & 0x0FU;
+
+  if (ep_num >= USBD_DMA_EP_MAX)
+  {
+    usbd_dma_info.reject++;
+    return NULL;
+  }
+  usbd_dma_out_user[ep_num] = NULL;
+  if (usbdDmaIsNonCache(pbuf, size) == true)
+  {
+    usbd_dma_info.rx_direct++;
+    return pbuf;
+  }
+  if (size <= USBD_DMA_SLOT_SIZE)
+  {
+    usbd_dma_out_user[ep_num] = pbuf;
+    usbd_dma_info.rx_bounce++;
+    return usbd_dma_out_slot[ep_num];
+  }
+  usbd_dma_info.reject++;
+  return NULL;
+}
+
+// 바운스 수신이면 받은 만큼 원래 버퍼로 옮기고 그 버퍼를 돌려준다.
+static uint8_t *usbdDmaCompleteRx(PCD_HandleTypeDef *hpcd, uint8_t epnum)
+{
+  uint8_t *p_user = epnum < USBD_DMA_EP_MAX ? usbd_dma_out_user[epnum] : NULL;
+
+  if (p_user == NULL)
+  {
+    return hpcd->OUT_ep[epnum].xfer_buff;
+  }
+
+  uint32_t rx_len = HAL_PCD_EP_GetRxCount(hpcd, epnum);
+
+  if (rx_len > USBD_DMA_SLOT_SIZE)
+  {
+    rx_len = USBD_DMA_SLOT_SIZE;
+  }
+  memcpy(p_user, usbd_dma_out_slot[epnum], rx_len);
+  usbd_dma_out_user[epnum] = NULL;
+  return p_user;
+}
+#endif
+
+void USBD_DMA_GetInfo(usbd_dma_info_t *p_info)
+{
+#if HW_USB_OTG_DMA == 1
+  *p_info = usbd_dma_info;
+#else
+  memset(p_info, 0, sizeof(usbd_dma_info_t));
+#endif
+}
+
 /* External functions --------------------------------------------------------*/
 
 /* USER CODE BEGIN 0 */
@@ -154,7 +274,11 @@ static void PCD_DataOutStageCallback(PCD_HandleTypeDef *hpcd, uint8_t epnum)
 void HAL_PCD_DataOutStageCallback(PCD_HandleTypeDef *hpcd, uint8_t epnum)
 #endif /* USE_HAL_PCD_REGISTER_CALLBACKS */
 {
+#if HW_USB_OTG_DMA == 1
+  USBD_LL_DataOutStage((USBD_HandleTypeDef*)hpcd->pData, epnum, usbdDmaCompleteRx(hpcd, epnum));  // V261018R5
+#else
   USBD_LL_DataOutStage((USBD_HandleTypeDef*)hpcd->pData, epnum, hpcd->OUT_ep[epnum].xfer_buff);
+#endif
 }
 
 /**
@@ -342,6 +466,10 @@ USBD_StatusTypeDef USBD_LL_Init(USBD_HandleTypeDef *pdev)
 {
   /* Init USB Ip. */
   if (pdev->id == DEVICE_HS) {
+  // V261021R6: DMA 빌드에서는 핸들이 .non_cache(NOLOAD, startup 이 0 으로 채우지 않음)에 있다.
+  //            HAL_PCD_Init() 이 State == HAL_PCD_STATE_RESET 으로 MspInit 여부를 가르므로 먼저 비운다.
+  memset(&hpcd_USB_OTG_HS, 0, sizeof(hpcd_USB_OTG_HS));
+
   /* Link the driver to the stack. */
   hpcd_USB_OTG_HS.pData = pdev;
   pdev->pData = &hpcd_USB_OTG_HS;
@@ -356,7 +484,11 @@ USBD_StatusTypeDef USBD_LL_Init(USBD_HandleTypeDef *pdev)
   {
     hpcd_USB_OTG_HS.Init.speed = PCD_SPEED_HIGH;
   }
+#if HW_USB_OTG_DMA == 1
+  hpcd_USB_OTG_HS.Init.dma_enable = ENABLE;                         // V261018R5: 패킷 복사를 OTG 내부 DMA 로 이관
+#else
   hpcd_USB_OTG_HS.Init.dma_enable = DISABLE;
+#endif
   hpcd_USB_OTG_HS.Init.phy_itface = USB_OTG_HS_EMBEDDED_PHY;
   hpcd_USB_OTG_HS.Init.Sof_enable = ENABLE;
   hpcd_USB_OTG_HS.Init.low_power_enable = DISABLE;
@@ -393,7 +525,8 @@ USBD_StatusTypeDef USBD_LL_Init(USBD_HandleTypeDef *pdev)
   HAL_PCDEx_SetTxFiFo(&hpcd_USB_OTG_HS, 2, 128);
   HAL_PCDEx_SetTxFiFo(&hpcd_USB_OTG_HS, 3, 128);  
   HAL_PCDEx_SetTxFiFo(&hpcd_USB_OTG_HS, 4, 128);  
-  HAL_PCDEx_SetTxFiFo(&hpcd_USB_OTG_HS, 5, 128);  
+  HAL_PCDEx_SetTxFiFo(&hpcd_USB_OTG_HS, 5, 64);                     // V261018R1: EXK(8B) 는 64 word 로 충분, 남는 공간을 NKRO 에 할당
+  HAL_PCDEx_SetTxFiFo(&hpcd_USB_OTG_HS, 6, 64);                     // V261018R1: NKRO(32B), 전체 FIFO 합계는 유지
   }
   return USBD_OK;
 }
@@ -594,6 +727,15 @@ USBD_StatusTypeDef USBD_LL_Transmit(USBD_HandleTypeDef *pdev, uint8_t ep_addr, u
   HAL_StatusTypeDef hal_status = HAL_OK;
   USBD_StatusTypeDef usb_status = USBD_OK;
 
+#if HW_USB_OTG_DMA == 1
+  uint8_t *p_src = pbuf;
+
+  pbuf = usbdDmaPrepareTx(ep_addr, pbuf, size);                     // V261018R5
+  if (pbuf == NULL && p_src != NULL)
+  {
+    return USBD_FAIL;
+  }
+#endif
   hal_status = HAL_PCD_EP_Transmit(pdev->pData, ep_addr, pbuf, size);
 
   usb_status =  USBD_Get_USB_Status(hal_status);
@@ -614,6 +756,13 @@ USBD_StatusTypeDef USBD_LL_PrepareReceive(USBD_HandleTypeDef *pdev, uint8_t ep_a
   HAL_StatusTypeDef hal_status = HAL_OK;
   USBD_StatusTypeDef usb_status = USBD_OK;
 
+#if HW_USB_OTG_DMA == 1
+  pbuf = usbdDmaPrepareRx(ep_addr, pbuf, size);                     // V261018R5
+  if (pbuf == NULL)
+  {
+    return USBD_FAIL;
+  }
+#endif
   hal_status = HAL_PCD_EP_Receive(pdev->pData, ep_addr, pbuf, size);
 
   usb_status =  USBD_Get_USB_Status(hal_status);
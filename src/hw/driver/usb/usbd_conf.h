@@ -73,6 +73,14 @@
 #define DEVICE_FS 		0
 #define DEVICE_HS 		1
 
+// V261018R5: OTG HS 내부 DMA 가 직접 접근하는 버퍼 배치.
+//   DMA 빌드에서는 MPU 비캐시 영역(.non_cache, BUF 16KB)에 32B 정렬로 둔다. PIO 빌드는 기존 배치 유지.
+#if HW_USB_OTG_DMA == 1
+#define USBD_DMA_BUF              __attribute__((section(".non_cache"), aligned(32)))
+#else
+#define USBD_DMA_BUF
+#endif
+
 /* Exported macro ------------------------------------------------------------*/
 /* Memory management macros */   
 #define USBD_malloc               (void *)USBD_static_malloc
@@ -113,6 +121,19 @@ void USBD_static_free(void *p);
 bool USBD_is_connected(void);
 bool USBD_is_suspended(void);
 
+typedef struct
+{
+  bool     enable;                                    // HW_USB_OTG_DMA
+  uint32_t tx_direct;                                 // 비캐시 버퍼를 그대로 DMA 전송
+  uint32_t tx_bounce;                                 // 바운스 슬롯으로 복사 후 전송
+  uint32_t tx_clean;                                  // 캐시 클린 후 전송 (슬롯보다 큰 캐시 영역 버퍼)
+  uint32_t rx_direct;
+  uint32_t rx_bounce;
+  uint32_t reject;                                    // DMA 접근 불가(DTCM 등) + 슬롯 초과
+} usbd_dma_info_t;
+
+void USBD_DMA_GetInfo(usbd_dma_info_t *p_info);       // V261018R5
+
 #endif /* __USBD_CONF_H */
 
 /************************ (C) COPYRIGHT STMicroelectronics *****END OF FILE****/
@@ -54,6 +54,13 @@ static bool hwRunFactoryResetWithRetry(void)
   return false;
 }
 
+#ifdef _USE_HW_LATENCY
+// V261019R2: 지연 계측 틱 (코어 클럭 사이클)
+static uint32_t hwGetCycle(void)
+{
+  return DWT->CYCCNT;
+}
+#endif
 
 
 bool hwInit(void)
@@ -68,6 +75,13 @@ bool hwInit(void)
   logInit();  
   ledInit();
   microsInit();
+  idleInit();                                                 // V261017R5: 메인 루프 이벤트/WFI 대기
+#ifdef _USE_HW_LATENCY
+  CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;             // V261019R2: 릴리스 빌드에서도 DWT 사이클 카운터 사용
+  DWT->LAR          = 0xC5ACCE55;
+  DWT->CTRL        |= DWT_CTRL_CYCCNTENA_Msk;
+  latencyInit(hwGetCycle, SystemCoreClock / 1000000U);
+#endif
 
   uartInit();
   for (int i=0; i<HW_UART_MAX_CH; i++)
@@ -100,6 +114,9 @@ bool hwInit(void)
   resetInit();    
   i2cInit();
   eepromInit();
+  #ifdef _USE_HW_QSPI
+  qspiInit();                                                 // V261019R6: eeprom_init() 의 웨어 레벨링 적재보다 먼저
+  #endif
   eeprom_init();                                              // V250923R1 Sync QMK EEPROM image before USB init
 #ifdef BOOTMODE_ENABLE
   bootmode_init();                                            // V251112R6: BootMode 기본값 초기화
@@ -124,9 +141,6 @@ bool hwInit(void)
   {
     hw_ok = false;                                             // V251124R6: 팩토리 리셋 실패 시 치명적 상태 표시
   }
-  #ifdef _USE_HW_QSPI
-  qspiInit();
-  #endif
   flashInit();
   if (keysInit() != true)
   {
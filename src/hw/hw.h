@@ -15,6 +15,8 @@ extern "C" {
 #include "usb.h"
 #include "cdc.h"
 #include "micros.h"
+#include "idle.h"                                             // V261017R5: WFI 대기 메인 루프
+#include "latency.h"                                          // V261019R2: 키 입력 → USB 전달 구간별 지연
 #include "button.h"
 #include "keys.h"
 #include "spi.h"
@@ -27,6 +29,7 @@ extern "C" {
 #include "qspi.h"
 #include "ws2812.h"
 #include "qbuffer.h"
+#include "qring.h"                                            // V261017R9: SPSC 링
 
 
 bool hwInit(void);
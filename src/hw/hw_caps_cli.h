@@ -71,5 +71,9 @@
 #define _USE_CLI_HW_WS2812          1
 #endif
 
+#ifndef _USE_CLI_HW_IDLE
+#define _USE_CLI_HW_IDLE            1                 // V261017R5: idle info/on/off
+#endif
+
 
 #endif
@@ -4,7 +4,7 @@
 
 // ---------------------------------------------------------------------------
 // [Caps Dependencies] V251114R3
-//   - 사용처: src/hw/hw.c 초기화, src/hw/driver/flash.c, src/hw/driver/micros.c
+//   - 사용처: src/hw/hw.c 초기화, src/hw/driver/flash.c, src/hw/driver/micros.c, src/hw/driver/idle.c
 //   - 비고  : _USE_HW_VCOM 토글 시 USB 로그 경로(hcaps_usb.h)와 연동
 // ---------------------------------------------------------------------------
 #ifndef _USE_HW_CACHE
@@ -19,6 +19,26 @@
 #define _USE_HW_MICROS
 #endif
 
+#ifndef _USE_HW_IDLE
+#define _USE_HW_IDLE                                  // V261017R5: 이벤트 구동 메인 루프 + WFI 대기
+#endif
+
+#ifndef HW_IDLE_WFI_DEFAULT
+#define HW_IDLE_WFI_DEFAULT         1                 // V261017R5: 부팅 시 WFI 대기 활성 (CLI idle on/off)
+#endif
+
+#ifndef _USE_HW_LATENCY
+#define _USE_HW_LATENCY                               // V261019R2: 키 입력 → USB 전달 구간별 지연 히스토그램 (DWT CYCCNT)
+#endif
+
+#ifndef HW_LATENCY_ENABLE_DEFAULT
+#define HW_LATENCY_ENABLE_DEFAULT   1                 // V261019R2: 부팅 시 계측 활성 (CLI usbhid latency on/off, VIA)
+#endif
+
+#ifndef HW_LATENCY_TIMEOUT_MS
+#define HW_LATENCY_TIMEOUT_MS       100               // V261019R2: 디바운스 확정 후 이 시간 안에 IN 완료가 없으면 샘플 폐기
+#endif
+
 // #define _USE_HW_QSPI
 // #define _USE_HW_VCOM
 
@@ -15,5 +15,17 @@
 #define EEPROM_CHIP_ZD24C128
 #endif
 
+// V261019R6: 고빈도 설정(RGB/BootMode/토글)을 QSPI 플래시 웨어 레벨링 로그로 기록
+//   - cmake -DEEPROM_WL_ENABLE=ON 이 _USE_HW_QSPI, _USE_HW_EEPROM_WL 과 논리/백킹 크기를 함께 정의한다 (시뮬레이터는 기본 ON)
+// #define _USE_HW_EEPROM_WL
+#ifdef _USE_HW_EEPROM_WL
+#ifndef HW_EEPROM_WL_QSPI_ADDR
+#define HW_EEPROM_WL_QSPI_ADDR      0x1FE000          // V261019R6: W25Q16 (2MB) 마지막 8KB, 4KB 서브섹터 2개
+#endif
+#ifndef HW_EEPROM_WL_ENABLE_DEFAULT
+#define HW_EEPROM_WL_ENABLE_DEFAULT 1                 // V261019R6: 부팅 시 라우팅 활성 (CLI qmk wl on/off)
+#endif
+#endif
+
 
 #endif
@@ -4,7 +4,7 @@
 
 // ---------------------------------------------------------------------------
 // [Caps Dependencies] V251114R3
-//   - 사용처: src/hw/driver/keys.c, src/ap/modules/qmk/port/protocol/report.h
+//   - 사용처: src/hw/driver/keys.c, src/hw/driver/keys_reduce.c, src/ap/modules/qmk/port/protocol/report.h, port/scan_profile.c
 //   - 비고  : USB HID 리포트 크기(usbd_hid.c)와 직결되므로 값 변경 시 USB 디스크립터 검토 필요
 // ---------------------------------------------------------------------------
 #ifndef _USE_HW_KEYS
@@ -15,5 +15,44 @@
 #define HW_KEYS_PRESS_MAX           20
 #endif
 
+// V261017R7: 매트릭스 디스크립터 기본값 (행 GPIOA 0~MATRIX_ROWS-1, 열 GPIOB 0~MATRIX_COLS-1)
+//   보드 config.h 에서 재정의한다. 열 포트가 둘 이상이면 주소 오름차순·같은 간격이어야 한다.
+//   HW_KEYS_COL_SEGS 항목 = {col_port 인덱스, 시작 핀, 핀 수, 시작 열}
+#ifndef HW_KEYS_ROW_PORT
+#define HW_KEYS_ROW_PORT            GPIOA
+#endif
+
+#ifndef HW_KEYS_ROW_PINS
+#define HW_KEYS_ROW_PINS            {0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15}
+#endif
+
+#ifndef HW_KEYS_COL_PORT_CNT
+#define HW_KEYS_COL_PORT_CNT        1
+#endif
+
+#ifndef HW_KEYS_COL_PORTS
+#define HW_KEYS_COL_PORTS           {GPIOB}
+#endif
+
+#ifndef HW_KEYS_COL_SEGS
+#define HW_KEYS_COL_SEGS            {{0, 0, MATRIX_COLS, 0}}
+#endif
+
+#ifndef HW_KEYS_COL_PULL
+#define HW_KEYS_COL_PULL            GPIO_PULLDOWN
+#endif
+
+#ifndef HW_KEYS_OVERSAMPLE_DEFAULT
+#define HW_KEYS_OVERSAMPLE_DEFAULT  1                 // V261017R6: 프레임당 축약 스윕 수 (1 = 기존 동작)
+#endif
+
+#ifndef HW_KEYS_REDUCE_DEFAULT
+#define HW_KEYS_REDUCE_DEFAULT      0                 // V261017R6: KEYS_REDUCE_MAJORITY
+#endif
+
+#ifndef HW_KEYS_SCAN_RATE_DEFAULT
+#define HW_KEYS_SCAN_RATE_DEFAULT   0                 // V261017R6: KEYS_SCAN_RATE_1US
+#endif
+
 
 #endif
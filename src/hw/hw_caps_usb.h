@@ -50,4 +50,52 @@
 #endif
 
 
+// V261018R4: SOF 위상 고정 JIT 키보드 리포트 적재 (usbd_hid_jit.c)
+#ifndef HW_USB_HID_JIT_DEFAULT
+#define HW_USB_HID_JIT_DEFAULT      1                 // 1 = 위상 학습 후 IN 토큰 직전에 적재
+#endif
+#ifndef HW_USB_HID_JIT_GUARD_HS_US
+#define HW_USB_HID_JIT_GUARD_HS_US  15                // TIM2 ISR 진입 + FIFO 적재 여유
+#endif
+#ifndef HW_USB_HID_JIT_GUARD_FS_US
+#define HW_USB_HID_JIT_GUARD_FS_US  50
+#endif
+
+// V261018R5: OTG HS 내부 DMA (usbd_conf.c). 0 = CPU 가 ISR 에서 FIFO 복사(PIO), 1 = DMA
+//   엔드포인트 버퍼와 PCD 핸들은 .non_cache(BUF) 로 옮기고, 그 외 버퍼는 EP 별 바운스 슬롯을 거친다.
+#ifndef HW_USB_OTG_DMA
+#define HW_USB_OTG_DMA              0
+#endif
+
+// V261018R6: VIA RAW HID 파이프라인 전송 (usbd_hid_via.c)
+//   응답은 VIA IN EP 가 비는 즉시 싣고, 응답 전 요청 수가 WINDOW 에 차면 OUT 을 재무장하지 않아 호스트를 NAK 로 막는다.
+#ifndef HW_USB_VIA_WINDOW
+#define HW_USB_VIA_WINDOW           4                 // 동시에 처리 중일 수 있는 요청 수 (VIA RX 큐 16 이하)
+#endif
+#ifndef HW_USB_VIA_GATE_MS
+#define HW_USB_VIA_GATE_MS          0                 // 0 = 게이트 없음, >0 = 마지막 적재 후 대기(V261018R5 까지 20ms)
+#endif
+
+// V261018R8: 폴링 모드 변경을 MCU 리셋 없이 USB 재열거로 적용 (usb_reenum.c)
+#ifndef HW_USB_SOFT_REENUM
+#define HW_USB_SOFT_REENUM          1                 // 0 = 저장 후 resetToReset() (V261018R7 까지 동작)
+#endif
+#ifndef HW_USB_REENUM_TIMEOUT_MS
+#define HW_USB_REENUM_TIMEOUT_MS    3000              // 재접속 후 CONFIGURED 가 없으면 리셋 경로로 넘김
+#endif
+
+// V261018R9: SOF 안정성 감시 평가 위치 (usbd_hid_sof_mon.c)
+#ifndef HW_USB_MONITOR_BATCH
+#define HW_USB_MONITOR_BATCH        1                 // 1 = ISR 은 샘플 적재만, 메인 루프에서 일괄 평가. 0 = ISR 에서 평가 (V261018R8 까지)
+#endif
+
+// V261019R1: 비차단 원격 깨우기 (usbd_hid_wakeup.c)
+#ifndef HW_USB_WAKEUP_SIGNAL_MS
+#define HW_USB_WAKEUP_SIGNAL_MS     10                // 원격 깨우기 K 상태 유지 (USB 2.0: 1~15ms)
+#endif
+#ifndef HW_USB_WAKEUP_TIMEOUT_MS
+#define HW_USB_WAKEUP_TIMEOUT_MS    1000              // K 상태 종료 후 재개가 없으면 보관 리포트를 버리고 다음 입력에서 다시 깨움
+#endif
+
+
 #endif
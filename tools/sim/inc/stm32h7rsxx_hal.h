@@ -0,0 +1,67 @@
+#ifndef STM32H7RSXX_HAL_H_
+#define STM32H7RSXX_HAL_H_
+
+
+// ---------------------------------------------------------------------------
+// [Host Sim] V261017R1
+//   - 용도  : x86 호스트 시뮬레이터 빌드에서 bsp.h 가 요구하는 HAL 헤더를 대체
+//   - 범위  : 포팅 계층/ST USB 헤더가 참조하는 CMSIS 컴파일러 매크로와 상태 코드만 제공
+//   - 비고  : 레지스터/주변장치 정의는 제공하지 않으므로 src/hw/driver/*.c 는 빌드 대상이 아님 (레지스터 비의존 idle.c/keys_reduce.c 제외)
+// ---------------------------------------------------------------------------
+#include <stdint.h>
+
+
+typedef enum
+{
+  HAL_OK      = 0x00U,
+  HAL_ERROR   = 0x01U,
+  HAL_BUSY    = 0x02U,
+  HAL_TIMEOUT = 0x03U
+} HAL_StatusTypeDef;
+
+
+typedef struct sim_gpio_s GPIO_TypeDef;                 // V261017R7: keys_matrix_desc_t 포인터 필드용 불완전 타입
+
+
+#ifndef __IO
+#define __IO                volatile
+#endif
+#ifndef __PACKED
+#define __PACKED            __attribute__((packed))
+#endif
+#ifndef __STATIC_INLINE
+#define __STATIC_INLINE     static inline
+#endif
+#ifndef __WEAK
+#define __WEAK              __attribute__((weak))
+#endif
+#ifndef __ALIGNED
+#define __ALIGNED(x)        __attribute__((aligned(x)))
+#endif
+#ifndef __NOP
+#define __NOP()             do { } while (0)
+#endif
+#ifndef __DSB
+#define __DSB()             __atomic_thread_fence(__ATOMIC_SEQ_CST)
+#endif
+#ifndef __DMB
+#define __DMB()             __atomic_thread_fence(__ATOMIC_SEQ_CST)
+#endif
+#ifndef __ISB
+#define __ISB()             __atomic_thread_fence(__ATOMIC_SEQ_CST)
+#endif
+#ifndef __disable_irq
+#define __disable_irq()     do { } while (0)
+#endif
+#ifndef __enable_irq
+#define __enable_irq()      do { } while (0)
+#endif
+#ifndef __WFI
+#define __WFI()             simWaitForInterrupt()      // V261017R5: 다음 인터럽트 시점까지 가상 시계 전진
+#endif
+
+
+void simWaitForInterrupt(void);
+
+
+#endif
@@ -0,0 +1,471 @@
+#include "def.h"
+#include "qbuffer.h"
+#include "qring.h"
+
+#include <pthread.h>
+#include <sched.h>
+#include <time.h>
+
+
+// ---------------------------------------------------------------------------
+// [SPSC Ring Test] V261017R9
+//   - check  : 단일 스레드 경계 조건 (2의 거듭제곱, 용량 전체 사용, 전부/전무 기록, 랩어라운드)
+//   - stress : 생산자/소비자 스레드가 API 를 섞어 호출하며 순서/내용이 보존되는지 검증
+//              진행이 없으면 sched_yield() 로 양보해 단일 코어 호스트에서도 시간 안에 끝난다.
+//   - bench  : qbuffer 대비 레코드/바이트 스트림 enqueue+dequeue 호스트 실행 시간 비교
+// ---------------------------------------------------------------------------
+#define QRING_TEST_REC_LEN        64                  // 작은 용량으로 가득 참/랩어라운드를 자주 만든다
+#define QRING_TEST_REC_CNT        4000000
+#define QRING_TEST_BYTE_LEN       2048
+#define QRING_TEST_BYTE_CNT       64000000
+#define QRING_TEST_BULK_MAX       7
+#define QRING_BENCH_LOOP          4000000
+#define QRING_BENCH_CHUNK         64                  // CDC 패킷 크기
+
+
+typedef struct
+{
+  uint32_t seq;
+  uint32_t inv;
+  uint32_t sum;                                       // 12 byte: 2의 거듭제곱이 아닌 레코드 크기
+} qring_test_rec_t;
+
+typedef struct
+{
+  const char *name;
+  bool      (*func)(void);
+  const char *desc;
+} qring_test_t;
+
+
+static bool qring_test_check(void);
+static bool qring_test_stress(void);
+static bool qring_test_bench(void);
+
+static const qring_test_t test_tbl[] =
+{
+  {"check",  qring_test_check,  "단일 스레드 경계 조건"},
+  {"stress", qring_test_stress, "생산자/소비자 스레드 동시 실행"},
+  {"bench",  qring_test_bench,  "qbuffer 대비 실행 시간 측정"},
+};
+
+static qring_test_rec_t rec_buf[QRING_TEST_REC_LEN];
+static uint8_t          byte_buf[QRING_TEST_BYTE_LEN];
+static qring_t          rec_q;
+static qring_t          byte_q;
+
+
+
+
+static uint64_t qring_test_ns(void)
+{
+  struct timespec ts;
+
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return (uint64_t)ts.tv_sec * 1000000000ULL + (uint64_t)ts.tv_nsec;
+}
+
+// 스레드별 xorshift 난수 (호출 패턴만 섞으면 되므로 품질은 중요하지 않다)
+static uint32_t qring_test_rand(uint32_t *p_state)
+{
+  uint32_t x = *p_state;
+
+  x ^= x << 13;
+  x ^= x >> 17;
+  x ^= x << 5;
+  *p_state = x;
+  return x;
+}
+
+static void qring_test_rec_fill(qring_test_rec_t *p_rec, uint32_t seq)
+{
+  p_rec->seq = seq;
+  p_rec->inv = ~seq;
+  p_rec->sum = seq * 2654435761U;
+}
+
+static bool qring_test_rec_ok(const qring_test_rec_t *p_rec, uint32_t seq)
+{
+  return p_rec->seq == seq && p_rec->inv == ~seq && p_rec->sum == seq * 2654435761U;
+}
+
+int main(int argc, char *argv[])
+{
+  uint32_t pass = 0;
+  uint32_t fail = 0;
+
+  for (uint32_t i=0; i<sizeof(test_tbl)/sizeof(test_tbl[0]); i++)
+  {
+    if (argc > 1 && strcmp(argv[1], test_tbl[i].name) != 0)
+    {
+      continue;
+    }
+
+    printf("[%s] %s\n", test_tbl[i].name, test_tbl[i].desc);
+    if (test_tbl[i].func())
+    {
+      printf("[%s] PASS\n", test_tbl[i].name);
+      pass++;
+    }
+    else
+    {
+      printf("[%s] FAIL\n", test_tbl[i].name);
+      fail++;
+    }
+  }
+
+  if (pass + fail == 0)
+  {
+    printf("unknown test : %s\n", argv[1]);
+    return 1;
+  }
+  return fail == 0 ? 0 : 1;
+}
+
+bool qring_test_check(void)
+{
+  qring_test_rec_t rec[QRING_TEST_REC_LEN];
+  bool             ret = true;
+
+#define QRING_EXPECT(cond)  do { if (!(cond)) { printf("  line %d : %s\n", __LINE__, #cond); ret = false; } } while (0)
+
+  QRING_EXPECT(qringCreate(&rec_q, rec_buf, sizeof(qring_test_rec_t), 48) == false);
+  QRING_EXPECT(qringCreate(&rec_q, rec_buf, sizeof(qring_test_rec_t), 0) == false);
+  QRING_EXPECT(qringCreate(&rec_q, rec_buf, sizeof(qring_test_rec_t), QRING_TEST_REC_LEN) == true);
+
+  // 용량 전체를 사용할 수 있고 초과 기록은 전부 거부된다
+  for (uint32_t i=0; i<QRING_TEST_REC_LEN; i++)
+  {
+    qring_test_rec_fill(&rec[i], i);
+  }
+  QRING_EXPECT(qringWrite(&rec_q, rec, QRING_TEST_REC_LEN - 1) == true);
+  QRING_EXPECT(qringWrite(&rec_q, rec, 2) == false);
+  QRING_EXPECT(qringAvailable(&rec_q) == QRING_TEST_REC_LEN - 1);
+  QRING_EXPECT(qringWrite(&rec_q, &rec[QRING_TEST_REC_LEN - 1], 1) == true);
+  QRING_EXPECT(qringFree(&rec_q) == 0);
+  QRING_EXPECT(qringReserve(&rec_q) == NULL);
+
+  // 부족한 개수 읽기는 거부되고 위치는 그대로
+  QRING_EXPECT(qringPeekAt(&rec_q, QRING_TEST_REC_LEN) == NULL);
+  QRING_EXPECT(qring_test_rec_ok(qringPeekAt(&rec_q, QRING_TEST_REC_LEN - 1), QRING_TEST_REC_LEN - 1));
+  QRING_EXPECT(qringRead(&rec_q, NULL, 10) == true);
+  QRING_EXPECT(qringRead(&rec_q, rec, QRING_TEST_REC_LEN) == false);
+  QRING_EXPECT(qring_test_rec_ok(qringPeek(&rec_q), 10));
+
+  // 끝 경계를 넘는 대량 기록/읽기 (두 번의 memcpy)
+  for (uint32_t i=0; i<10; i++)
+  {
+    qring_test_rec_fill(&rec[i], QRING_TEST_REC_LEN + i);
+  }
+  QRING_EXPECT(qringWrite(&rec_q, rec, 10) == true);
+  QRING_EXPECT(qringRead(&rec_q, rec, QRING_TEST_REC_LEN) == true);
+  for (uint32_t i=0; i<QRING_TEST_REC_LEN; i++)
+  {
+    QRING_EXPECT(qring_test_rec_ok(&rec[i], 10 + i));
+  }
+  QRING_EXPECT(qringAvailable(&rec_q) == 0);
+  QRING_EXPECT(qringPeek(&rec_q) == NULL);
+
+  // reserve/commit 은 commit 전까지 소비자에게 보이지 않는다
+  qring_test_rec_t *p_slot = qringReserve(&rec_q);
+
+  QRING_EXPECT(p_slot != NULL);
+  if (p_slot != NULL)
+  {
+    qring_test_rec_fill(p_slot, 1234);
+    QRING_EXPECT(qringAvailable(&rec_q) == 0);
+    qringCommit(&rec_q);
+    QRING_EXPECT(qring_test_rec_ok(qringPeek(&rec_q), 1234));
+  }
+  qringRelease(&rec_q, 5);
+  QRING_EXPECT(qringAvailable(&rec_q) == 0);
+
+  // flush 는 소비자 위치를 생산자 위치로 옮긴다
+  QRING_EXPECT(qringWrite(&rec_q, rec, 3) == true);
+  qringFlush(&rec_q);
+  QRING_EXPECT(qringAvailable(&rec_q) == 0);
+  QRING_EXPECT(qringFree(&rec_q) == QRING_TEST_REC_LEN);
+
+#undef QRING_EXPECT
+  return ret;
+}
+
+
+// 생산자: 단건/대량 기록과 reserve/commit 을 무작위로 섞는다.
+static void *qring_test_rec_producer(void *arg)
+{
+  uint32_t         rnd = 0x12345678;
+  uint32_t         seq = 0;
+  qring_test_rec_t rec[QRING_TEST_BULK_MAX];
+
+  (void)arg;
+  while (seq < QRING_TEST_REC_CNT)
+  {
+    uint32_t op = qring_test_rand(&rnd) % 3;
+
+    if (op == 0)
+    {
+      qring_test_rec_t *p_slot = qringReserve(&rec_q);
+
+      if (p_slot == NULL)
+      {
+        sched_yield();
+        continue;
+      }
+      qring_test_rec_fill(p_slot, seq++);
+      qringCommit(&rec_q);
+    }
+    else
+    {
+      uint32_t cnt = op == 1 ? 1 : 1 + qring_test_rand(&rnd) % QRING_TEST_BULK_MAX;
+
+      if (cnt > QRING_TEST_REC_CNT - seq)
+      {
+        cnt = QRING_TEST_REC_CNT - seq;
+      }
+      for (uint32_t i=0; i<cnt; i++)
+      {
+        qring_test_rec_fill(&rec[i], seq + i);
+      }
+      if (qringWrite(&rec_q, rec, cnt) != true)
+      {
+        sched_yield();
+        continue;
+      }
+      seq += cnt;
+    }
+  }
+  return NULL;
+}
+
+static void *qring_test_byte_producer(void *arg)
+{
+  uint32_t rnd = 0x9E3779B9;
+  uint32_t pos = 0;
+  uint8_t  buf[QRING_BENCH_CHUNK * 2];
+
+  (void)arg;
+  while (pos < QRING_TEST_BYTE_CNT)
+  {
+    uint32_t len = 1 + qring_test_rand(&rnd) % sizeof(buf);
+
+    if (len > QRING_TEST_BYTE_CNT - pos)
+    {
+      len = QRING_TEST_BYTE_CNT - pos;
+    }
+    if (len > qringFree(&byte_q))
+    {
+      len = qringFree(&byte_q);
+    }
+    for (uint32_t i=0; i<len; i++)
+    {
+      buf[i] = (uint8_t)((pos + i) * 7);
+    }
+    if (len == 0 || qringWrite(&byte_q, buf, len) != true)
+    {
+      sched_yield();
+      continue;
+    }
+    pos += len;
+  }
+  return NULL;
+}
+
+bool qring_test_stress(void)
+{
+  pthread_t        thread;
+  uint32_t         rnd     = 0xCAFEBABE;
+  uint32_t         seq     = 0;
+  uint32_t         err_cnt = 0;
+  uint64_t         ns;
+  qring_test_rec_t rec[QRING_TEST_BULK_MAX];
+
+  // 12 byte 레코드 링
+  qringCreate(&rec_q, rec_buf, sizeof(qring_test_rec_t), QRING_TEST_REC_LEN);
+  ns = qring_test_ns();
+  pthread_create(&thread, NULL, qring_test_rec_producer, NULL);
+
+  while (seq < QRING_TEST_REC_CNT && err_cnt == 0)
+  {
+    uint32_t op = qring_test_rand(&rnd) % 3;
+
+    if (op == 0)
+    {
+      uint32_t avail = qringAvailable(&rec_q);
+
+      if (avail == 0)
+      {
+        sched_yield();
+        continue;
+      }
+      // 제로 카피 참조: 쌓인 범위 안을 임의 offset 으로 확인한 뒤 한꺼번에 해제
+      for (uint32_t i=0; i<avail; i++)
+      {
+        if (qring_test_rec_ok(qringPeekAt(&rec_q, i), seq + i) != true)
+        {
+          err_cnt++;
+          break;
+        }
+      }
+      qringRelease(&rec_q, avail);
+      seq += avail;
+    }
+    else
+    {
+      uint32_t cnt = op == 1 ? 1 : 1 + qring_test_rand(&rnd) % QRING_TEST_BULK_MAX;
+
+      if (cnt > QRING_TEST_REC_CNT - seq)
+      {
+        cnt = QRING_TEST_REC_CNT - seq;
+      }
+      if (qringRead(&rec_q, rec, cnt) != true)
+      {
+        sched_yield();
+        continue;
+      }
+      for (uint32_t i=0; i<cnt; i++)
+      {
+        if (qring_test_rec_ok(&rec[i], seq + i) != true)
+        {
+          err_cnt++;
+          break;
+        }
+      }
+      seq += cnt;
+    }
+  }
+  pthread_join(thread, NULL);
+  ns = qring_test_ns() - ns;
+
+  printf("  record : %u recs, %llu ns/rec, err %u\n",
+         seq,
+         (unsigned long long)(seq ? ns / seq : 0),
+         err_cnt);
+  if (err_cnt > 0 || seq != QRING_TEST_REC_CNT || qringAvailable(&rec_q) != 0)
+  {
+    printf("  record order/content mismatch at seq %u\n", seq);
+    return false;
+  }
+
+  // 1 byte 스트림 링 (CDC 와 동일한 구성)
+  uint32_t pos = 0;
+  uint8_t  buf[QRING_BENCH_CHUNK * 2];
+
+  qringCreate(&byte_q, byte_buf, 1, QRING_TEST_BYTE_LEN);
+  ns = qring_test_ns();
+  pthread_create(&thread, NULL, qring_test_byte_producer, NULL);
+
+  while (pos < QRING_TEST_BYTE_CNT && err_cnt == 0)
+  {
+    uint32_t len = qringAvailable(&byte_q);
+
+    if (len > sizeof(buf))
+    {
+      len = 1 + qring_test_rand(&rnd) % sizeof(buf);
+    }
+    if (len == 0 || qringRead(&byte_q, buf, len) != true)
+    {
+      sched_yield();
+      continue;
+    }
+    for (uint32_t i=0; i<len; i++)
+    {
+      if (buf[i] != (uint8_t)((pos + i) * 7))
+      {
+        err_cnt++;
+        break;
+      }
+    }
+    pos += len;
+  }
+  pthread_join(thread, NULL);
+  ns = qring_test_ns() - ns;
+
+  printf("  byte   : %u bytes, %llu ns/KB, err %u\n",
+         pos,
+         (unsigned long long)(pos ? ns * 1024 / pos : 0),
+         err_cnt);
+  if (err_cnt > 0 || pos != QRING_TEST_BYTE_CNT)
+  {
+    printf("  byte stream mismatch at %u\n", pos);
+    return false;
+  }
+  return true;
+}
+
+
+bool qring_test_bench(void)
+{
+  static uint8_t   q_buf[QRING_TEST_BYTE_LEN + 1];
+  qbuffer_t        qbuf;
+  uint8_t          report[8]  = {0, };
+  uint8_t          chunk[QRING_BENCH_CHUNK];
+  uint64_t         ns[5];
+  volatile uint8_t sink       = 0;
+
+  // HID 리포트 큐 (8 byte x 128): 단건 enqueue + dequeue
+  qbufferCreateBySize(&qbuf, q_buf, sizeof(report), 128);
+  ns[0] = qring_test_ns();
+  for (uint32_t i=0; i<QRING_BENCH_LOOP; i++)
+  {
+    report[2] = (uint8_t)i;
+    qbufferWrite(&qbuf, report, 1);
+    qbufferRead(&qbuf, report, 1);
+    sink += report[2];
+  }
+  ns[0] = qring_test_ns() - ns[0];
+
+  qringCreate(&rec_q, q_buf, sizeof(report), 128);
+  ns[1] = qring_test_ns();
+  for (uint32_t i=0; i<QRING_BENCH_LOOP; i++)
+  {
+    report[2] = (uint8_t)i;
+    qringWrite(&rec_q, report, 1);
+    qringRead(&rec_q, report, 1);
+    sink += report[2];
+  }
+  ns[1] = qring_test_ns() - ns[1];
+
+  ns[2] = qring_test_ns();
+  for (uint32_t i=0; i<QRING_BENCH_LOOP; i++)
+  {
+    uint8_t *p_slot = qringReserve(&rec_q);
+
+    memcpy(p_slot, report, sizeof(report));
+    p_slot[2] = (uint8_t)i;
+    qringCommit(&rec_q);
+    sink += ((uint8_t *)qringPeek(&rec_q))[2];
+    qringRelease(&rec_q, 1);
+  }
+  ns[2] = qring_test_ns() - ns[2];
+
+  // CDC 바이트 스트림 (2048 byte): 64 byte 단위 enqueue + dequeue
+  memset(chunk, 0x5A, sizeof(chunk));
+  qbufferCreate(&qbuf, q_buf, sizeof(q_buf));
+  ns[3] = qring_test_ns();
+  for (uint32_t i=0; i<QRING_BENCH_LOOP / 8; i++)
+  {
+    qbufferWrite(&qbuf, chunk, sizeof(chunk));
+    qbufferRead(&qbuf, chunk, sizeof(chunk));
+    sink += chunk[i % sizeof(chunk)];
+  }
+  ns[3] = qring_test_ns() - ns[3];
+
+  qringCreate(&byte_q, q_buf, 1, QRING_TEST_BYTE_LEN);
+  ns[4] = qring_test_ns();
+  for (uint32_t i=0; i<QRING_BENCH_LOOP / 8; i++)
+  {
+    qringWrite(&byte_q, chunk, sizeof(chunk));
+    qringRead(&byte_q, chunk, sizeof(chunk));
+    sink += chunk[i % sizeof(chunk)];
+  }
+  ns[4] = qring_test_ns() - ns[4];
+
+  printf("  report 8B  qbuffer        : %6.1f ns/op\n", (double)ns[0] / QRING_BENCH_LOOP);
+  printf("  report 8B  qring          : %6.1f ns/op\n", (double)ns[1] / QRING_BENCH_LOOP);
+  printf("  report 8B  reserve/peek   : %6.1f ns/op\n", (double)ns[2] / QRING_BENCH_LOOP);
+  printf("  stream 64B qbuffer        : %6.1f ns/op\n", (double)ns[3] / (QRING_BENCH_LOOP / 8));
+  printf("  stream 64B qring          : %6.1f ns/op\n", (double)ns[4] / (QRING_BENCH_LOOP / 8));
+  (void)sink;
+  return true;
+}
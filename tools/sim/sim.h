@@ -0,0 +1,108 @@
+#ifndef SIM_H_
+#define SIM_H_
+
+
+#include "hw_def.h"
+#include "usbd_hid_jit.h"                             // V261018R4
+#include "usbd_hid_via.h"                             // V261018R6
+#include "usb_reenum.h"                               // V261018R8
+#include "usbd_hid_wakeup.h"                          // V261019R1
+#include "usbd_hid_sof_mon.h"                         // V261020R7
+
+
+// ---------------------------------------------------------------------------
+// [Host Sim] V261017R1
+//   - 목적  : 보드 없이 scan → debounce → action → HID 경로를 가상 시계로 구동
+//   - 구성  : sim_hw.c(하드웨어 대체 구현) + sim_main.c(시나리오/벤치마크)
+//   - 시간  : micros()/millis()/delay()는 모두 가상 시계를 사용하며 delay()는 시계를 전진시킴
+// ---------------------------------------------------------------------------
+#define SIM_REPORT_LOG_MAX        4096
+#define SIM_REPORT_DATA_MAX       64
+
+#define SIM_KEYS_FRAME_US         100                 // V261017R4: DMA HT/TC 프레임 게시 주기 (행 1us x 16 스윕 근사)
+
+#define SIM_EP_KEYBOARD           0x81U
+#define SIM_EP_VIA                0x84U
+#define SIM_EP_EXK                0x85U
+#define SIM_EP_NKRO               0x86U               // V261018R1
+
+
+typedef struct
+{
+  uint32_t program_cnt;                               // 프로그램 명령 수
+  uint32_t program_bytes;
+  uint32_t erase_cnt;                                 // 4KB 서브섹터 지우기 수
+  uint32_t erase_max;                                 // 가장 많이 지운 서브섹터의 지우기 수
+  uint32_t violate_cnt;                               // 지우지 않은 0 비트를 1 로 쓰려 한 바이트 수
+  uint64_t busy_us;                                   // 프로그램/지우기/읽기로 호출자가 멈춘 시간
+} sim_qspi_stat_t;                                    // V261019R6: W25Q16 NOR 모델 계측
+
+typedef struct
+{
+  uint32_t time_us;                                   // 가상 시계 기준 전송 시각
+  uint8_t  ep;                                        // IN 엔드포인트 주소
+  uint8_t  length;
+  uint8_t  data[SIM_REPORT_DATA_MAX];
+} sim_report_t;
+
+
+void                simInit(void);
+void                simSetLogEnable(bool enable);
+
+uint32_t            simGetTimeUs(void);
+void                simAdvanceUs(uint32_t us);
+void                simRunUs(uint32_t duration_us, uint32_t step_us);
+void                simRunIdleUs(uint32_t duration_us, uint32_t step_us); // V261017R5: idleWait() 구동 메인 루프
+uint64_t            simGetUpdateCount(void);
+uint32_t            simGetUpdateMaxUs(void);                      // V261019R1: qmkUpdate() 1회가 delay() 로 소모한 최대 가상 시간
+void                simClearUpdateMaxUs(void);
+uint64_t            simGetUpdateHostNs(void);
+uint64_t            simGetHostNs(void);                // V261017R3: 커널 단위 벤치마크용 호스트 시각
+
+void                simSetKey(uint8_t row, uint8_t col, bool pressed);
+bool                simGetKey(uint8_t row, uint8_t col);
+void                simInjectSpike(uint8_t row, uint8_t col);      // V261017R6: 다음 프레임 스윕 1개만 반전
+
+uint32_t            simGetReportCount(void);
+uint32_t            simGetReportDropped(void);
+const sim_report_t *simGetReport(uint32_t index);
+void                simClearReports(void);
+
+bool                simCliRun(const char *line);
+void                simViaSend(const uint8_t *p_data, uint8_t length);
+void                simSetSuspended(bool suspended);
+uint32_t            simGetEepromWriteBytes(void);
+uint32_t            simGetEepromWriteCount(void);                  // V261019R3: eepromWriteByte/Page 호출 수
+void                simSetEepromBlocking(bool blocking);           // V261019R4: 페이지 쓰기가 호출자를 막는 (개선 전) 모델
+void                simSetEepromLegacyRead(bool legacy);           // V261019R5: 바이트마다 1바이트 전송으로 읽는 (개선 전) 모델
+uint32_t            simGetEepromReadCount(void);                   // V261019R5: eepromRead/ReadAsync 호출 수
+const uint8_t      *simGetEepromData(void);                        // V261019R5: 칩 이미지 (미러 비교용)
+uint32_t            simGetEepromPageWriteCount(uint32_t page);     // V261019R6: 32B 페이지별 쓰기 주기 수
+void                simGetQspiStat(sim_qspi_stat_t *p_stat);       // V261019R6: QSPI NOR 프로그램/지우기 계측
+void                simSetHidPollUs(uint32_t poll_us);             // V261018R2: 키보드 EP 폴링 모델 (0 = 즉시 기록)
+void                simStallHidUs(uint32_t us);                    // V261018R2: 호스트 NAK 구간
+void                simSetHidSharedBusy(bool shared);              // V261018R3: IN EP busy 공유(개선 전) 모델
+void                simSetHidPhaseUs(uint32_t phase_us, uint32_t jitter_us);  // V261018R4: IN 토큰 위상 모델
+void                simSetHidJit(bool enable);                     // V261018R4: SOF 위상 고정 JIT 적재
+hid_jit_t          *simGetHidJit(void);                           // V261018R4: 학습 위상/변경→IN 지연 통계
+void                simSetViaTransport(uint32_t poll_us, uint32_t gate_ms, uint32_t window, uint32_t host_window);  // V261018R6: VIA EP 모델 (poll 0 = 즉시 기록)
+bool                simViaHostQueue(const uint8_t *p_data, uint8_t length);   // V261018R6: RAW HID 호스트 대역 요청 적재
+uint32_t            simViaHostPending(void);                      // V261018R6: 응답을 받지 못한 요청 수
+hid_via_t          *simGetVia(void);                              // V261018R6
+bool                simUsbReEnum(uint32_t grace_ms, uint32_t enum_us);  // V261018R8: 리셋 없는 재열거 (enum_us = 호스트 열거 시간)
+usb_reenum_t       *simGetUsbReEnum(void);                        // V261018R8
+uint32_t            simGetUsbConfDescSize(void);                  // V261020R6: Composite 구성 디스크립터 크기 모델
+uint32_t            simGetUsbConfDescMax(void);                   // V261020R6: 부팅 후 최대 크기
+uint32_t            simGetUsbLostReports(void);                   // V261018R8: 링크가 끊긴 동안 버린 리포트 수
+void                simSetWakeUpResumeUs(uint32_t resume_us);     // V261019R1: 깨우기 시작 → 호스트 재개 (0 = 재개 안 함)
+void                simSetWakeUpBlocking(bool blocking);          // V261019R1: delay(10) + 리포트 버림 (개선 전) 모델
+hid_wakeup_t       *simGetHidWakeUp(void);                        // V261019R1
+
+// V261020R7: SOF 감시 기준 구현 (sim_sof_ref.c, V261018R8 ISR 평가 동결 사본)
+void                     simSofRefInit(hid_sof_mon_downgrade_t downgrade_func);
+void                     simSofRefOnSof(const hid_sof_sample_t *p_sample);
+void                     simSofRefTick(uint32_t now_us, bool configured, bool suspended);
+const usb_sof_monitor_t *simSofRefState(void);
+
+
+#endif
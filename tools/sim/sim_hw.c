@@ -0,0 +1,1678 @@
+#include "sim.h"
+
+
+#include <time.h>
+#include "hw.h"
+#include "qmk/qmk.h"
+#include "usbd_hid_coalesce.h"
+#include "usbd_hid_jit.h"
+#include "usbd_hid_tx.h"
+#include "usbd_hid_via.h"
+#include "usb_reenum.h"
+#include "usbd_hid_wakeup.h"
+
+
+// ---------------------------------------------------------------------------
+// [Host Sim] V261017R1
+//   - keys/micros/eeprom/usb/reset/log/cli 드라이버를 호스트용 가짜 구현으로 대체
+//   - 포팅 계층과 퀀텀 코어는 펌웨어와 동일한 소스를 그대로 링크함
+// ---------------------------------------------------------------------------
+#define SIM_CLI_CMD_MAX           HW_CLI_CMD_LIST_MAX
+#define SIM_CLI_ARGV_MAX          8
+#define SIM_CLI_LINE_MAX          HW_CLI_LINE_BUF_MAX
+#define SIM_EEPROM_SIZE           TOTAL_EEPROM_BYTE_COUNT
+
+
+typedef struct
+{
+  char   name[HW_CLI_CMD_NAME_MAX];
+  void (*func)(cli_args_t *);
+} sim_cli_cmd_t;
+
+
+static uint64_t      sim_time_us        = 0;
+static uint64_t      sim_update_cnt     = 0;
+static uint64_t      sim_update_host_ns = 0;
+static bool          sim_log_enable     = false;
+static bool          sim_suspended      = false;
+
+// V261017R7: 열은 16핀 가상 포트 SIM_COL_PORTS 개에 순서대로 배치한다 (keys.c 의 [스윕][행][포트] 캡처와 동일 배치)
+#define SIM_COL_PORTS        ((MATRIX_COLS + 15) / 16)
+
+static keys_col_t    sim_cols_buf[MATRIX_ROWS];
+static keys_col_t    sim_frame_buf[MATRIX_ROWS];
+static uint32_t      sim_frame_seq      = 0;
+static uint16_t      sim_sweep_buf[KEYS_OVERSAMPLE_MAX][MATRIX_ROWS * SIM_COL_PORTS];  // V261017R6: 프레임 1개 분량의 DMA 스윕
+static keys_col_t    sim_spike_buf[MATRIX_ROWS];                        // V261017R6: 다음 프레임 마지막 스윕에 주입할 잡음
+static uint8_t       sim_oversample     = HW_KEYS_OVERSAMPLE_DEFAULT;
+static keys_reduce_t sim_reduce         = (keys_reduce_t)HW_KEYS_REDUCE_DEFAULT;
+static keys_scan_rate_t sim_scan_rate   = (keys_scan_rate_t)HW_KEYS_SCAN_RATE_DEFAULT;
+
+static sim_report_t  sim_report_log[SIM_REPORT_LOG_MAX];
+static uint32_t      sim_report_cnt     = 0;
+static uint32_t      sim_report_dropped = 0;
+
+// V261018R2: 키보드 EP 모델. poll 0 이면 항상 idle(즉시 기록), 아니면 poll 주기마다 IN 토큰이 온다.
+// V261021R4: 전송 정책(EP 상태 표, 대기열, 드레인, JIT 적재)은 펌웨어와 같은 usbd_hid_tx.c 를 링크한다.
+//   시뮬레이터는 LL 전송(리포트 기록 + IN 완료 예약)과 두 ISR 의 시점만 만든다.
+//   - SOF ISR       : SOF 주기(HS 125us, FS 1000us)마다 usbHidTxOnSof()             (V261021R5)
+//   - TIM2 비교 ISR : SOF + jit.compare_us 마다 usbHidTxDrain()
+//   - DataIn ISR    : 실린 리포트를 가져가는 IN 토큰(NAK 구간 이후 첫 토큰)에서 usbHidTxOnDataIn()
+#define SIM_HID_HS_SOF_US    125
+#define SIM_HID_FS_SOF_US    1000
+
+static hid_tx_t      sim_hid_tx;
+static uint8_t       sim_hid_kbd_buf[HID_KEYBOARD_REPORT_SIZE];
+static uint8_t       sim_hid_exk_buf[HID_EXK_EP_SIZE];
+static uint8_t       sim_hid_nkro_buf[HID_NKRO_EP_SIZE];
+static uint32_t      sim_hid_poll_us    = 0;
+static uint32_t      sim_hid_sof_us     = SIM_HID_FS_SOF_US;       // V261021R5: HS 는 폴링 주기와 무관하게 125us
+static uint64_t      sim_hid_sof_at_us  = 0;                       // 마지막으로 실행한 SOF 시각
+static bool          sim_hid_busy[HID_IN_EP_NUM_MAX];              // LL 전송 후 IN 완료를 기다리는 EP
+static uint64_t      sim_hid_done_us[HID_IN_EP_NUM_MAX];           // 그 리포트를 가져갈 IN 토큰 시각
+static uint64_t      sim_hid_drain_us   = 0;                       // 마지막으로 실행한 TIM2 비교 시각
+static uint64_t      sim_hid_stall_us   = 0;                       // 호스트 NAK 구간 끝
+static bool          sim_hid_shared     = false;                   // V261018R3: V261018R2 까지의 단일 busy 플래그 모델
+
+// V261018R4: 호스트 IN 토큰 위상 모델. 폴링되는 SOF 는 poll 배수 시각, IN 은 SOF + phase + jitter.
+//   phase 0 이면 폴링 경계에서 IN 이 완료된다.
+//   기존 시나리오 기준선이 바뀌지 않도록 시뮬레이터는 JIT 를 끈 채로 시작한다.
+static uint32_t      sim_hid_phase_us   = 0;
+static uint32_t      sim_hid_jitter_us  = 0;
+
+static uint8_t       sim_eeprom[SIM_EEPROM_SIZE];
+static uint32_t      sim_eeprom_write_bytes = 0;
+static uint32_t      sim_eeprom_write_cnt   = 0;                    // V261019R3: 칩 쓰기 호출 수 (쓰기 주기 tWR 횟수)
+static uint32_t      sim_eeprom_page_write[SIM_EEPROM_SIZE / 32];    // V261019R6: 32B 페이지별 쓰기 주기 수 (셀 수명)
+
+// V261019R4: 비차단 페이지 쓰기 모델. 시작 시각 + (주소 3B + 데이터) x 9비트 @1MHz + tWR 에 칩에 반영된다.
+//   blocking 은 V261019R3 까지의 eepromWritePage() 처럼 호출자 안에서 같은 시간을 소모한다.
+#define SIM_EEPROM_BYTE_US        9
+#define SIM_EEPROM_CYCLE_US       5000                              // ZD24C128 tWR (최대)
+#define SIM_EEPROM_PAGE_MAX       32
+
+static bool          sim_eeprom_blocking    = false;
+static bool          sim_eeprom_busy        = false;
+static uint64_t      sim_eeprom_done_us     = 0;
+static uint32_t      sim_eeprom_async_addr  = 0;
+static uint32_t      sim_eeprom_async_len   = 0;
+static uint8_t       sim_eeprom_async_buf[SIM_EEPROM_PAGE_MAX];
+static eeprom_async_state_t sim_eeprom_result = EEPROM_ASYNC_IDLE;
+// V261019R5: 읽기 비용. 순차 읽기는 주소 4B + 데이터, 1바이트 전송(V261019R4 까지)은 바이트마다 5B
+#define SIM_EEPROM_READ_HDR       4
+static bool          sim_eeprom_legacy_read = false;
+static uint8_t      *sim_eeprom_async_dst   = NULL;                 // NULL 이 아니면 진행 중 요청은 읽기
+static uint32_t      sim_eeprom_read_cnt    = 0;
+
+// V261019R6: W25Q16JV NOR 모델. 프로그램은 1 → 0 만 바뀌고 4KB 서브섹터 지우기로만 0xFF 가 된다.
+//   시간은 데이터시트 대표값 (tBP1 30us + 바이트당 2.5us, tSE 45ms), 읽기는 명령 + 쿼드 전송으로 둔다.
+#define SIM_QSPI_SIZE             0x200000
+#define SIM_QSPI_SECTOR           0x1000
+#define SIM_QSPI_PROG_US          30
+#define SIM_QSPI_PROG_BYTE_NS     2500
+#define SIM_QSPI_ERASE_US         45000
+#define SIM_QSPI_READ_US          2
+static uint8_t       sim_qspi[SIM_QSPI_SIZE];
+static uint32_t      sim_qspi_erase[SIM_QSPI_SIZE / SIM_QSPI_SECTOR];
+static sim_qspi_stat_t sim_qspi_stat;
+
+static bool        (*sim_via_receive_func)(uint8_t *, uint8_t) = NULL;   // V261020R4: 큐 적재 여부 반환
+
+// V261018R6: VIA RAW HID 호스트 대역. poll 0 이면 응답을 바로 기록한다 (simViaSend 시나리오용).
+//   poll 경계마다 IN(응답 수거 → DataIn) → OUT(요청 전달 → DataOut) → SOF 순서로 펌웨어와 같은 hid_via_t 를 구동한다.
+#define SIM_VIA_HOST_Q_MAX   1024
+
+static hid_via_t     sim_via;
+static uint32_t      sim_via_poll_us      = 0;
+static uint64_t      sim_via_next_us      = 0;
+static uint32_t      sim_via_host_window  = 1;                    // 응답 없이 보낼 수 있는 요청 수 (호스트 쪽)
+static uint8_t       sim_via_host_q[SIM_VIA_HOST_Q_MAX][HID_VIA_PACKET_SIZE];
+static uint32_t      sim_via_host_queued  = 0;
+static uint32_t      sim_via_host_sent    = 0;
+static uint32_t      sim_via_host_done    = 0;
+static bool          sim_via_in_loaded    = false;
+static uint8_t       sim_via_in_buf[HID_VIA_PACKET_SIZE];
+
+// V261018R8: USB 링크 모델. 재열거 중 분리 구간과 호스트 열거 시간 동안 보낸 리포트는 호스트에 닿지 않는다.
+#define SIM_USB_DETACH_MS    100                                  // usb.c USB_RESET_DETACH_DELAY_MS
+
+static usb_reenum_t  sim_reenum;
+static bool          sim_usb_attached     = true;
+static uint64_t      sim_usb_config_us    = 0;                    // 이 시각부터 CONFIGURED
+static uint32_t      sim_usb_enum_us      = 0;                    // 재접속 → CONFIGURED (호스트 열거 시간)
+static uint32_t      sim_usb_lost         = 0;
+
+// V261020R6: usbd_cmp.c 구성 디스크립터 빌더 모델. USBD_Init() 후 첫 클래스 등록 때 헤더를, 클래스마다 현재 크기 뒤에 이어 붙인다.
+#define SIM_CMP_CONF_HDR_SZ  9                                    // USB_CONF_DESC_SIZE
+#define SIM_CMP_HID_SZ       25                                   // 인터페이스 + HID + IN EP
+#define SIM_CMP_CDC_SZ       66                                   // IAD + 통지/데이터 인터페이스 + EP 3개
+
+static uint32_t      sim_cmp_conf_sz      = 0;                    // CurrFSConfDescSz
+static uint32_t      sim_cmp_conf_max     = 0;
+
+// V261019R1: 원격 깨우기 모델. 호스트는 깨우기 시작 후 resume_us 뒤에 버스를 재개한다 (0 = 재개하지 않음).
+#define SIM_WAKEUP_RESUME_US 21000                                // K 1ms 안에 호스트 재개 구동 20ms (USB 2.0 7.1.7.7)
+
+static hid_wakeup_t  sim_wakeup;
+static uint32_t      sim_wakeup_resume_us = SIM_WAKEUP_RESUME_US;
+static uint64_t      sim_wakeup_resume_at = 0;                    // 0 = 예정 없음
+static bool          sim_wakeup_blocking  = false;                // V261018R9 까지의 delay(10) + 리포트 버림 모델
+
+// V261019R2: 지연 계측 틱은 600MHz 코어 클럭(DWT CYCCNT)과 같은 분해능으로 가상 시계에서 만든다.
+#define SIM_LATENCY_TICK_PER_US   600
+static uint32_t      sim_update_max_us    = 0;                    // qmkUpdate() 1회가 소모한 최대 가상 시간
+
+static sim_cli_cmd_t sim_cli_cmd[SIM_CLI_CMD_MAX];
+static uint32_t      sim_cli_cmd_cnt = 0;
+static char         *sim_cli_argv[SIM_CLI_ARGV_MAX];
+static uint16_t      sim_cli_argc    = 0;
+
+
+static void     sim_report_push(uint8_t ep, const uint8_t *p_data, uint16_t length);
+static void     sim_keys_update_frame(void);
+static void     sim_hid_service(void);
+static void     sim_hid_run_isr(void);
+static bool     sim_hid_tx_func(uint8_t ep_addr, uint8_t *p_data, uint16_t length);
+static void     sim_via_service(void);
+static void     sim_usb_service(void);
+static bool     sim_usb_drop_report(void);
+static void     sim_usb_begin(void);
+static bool     sim_wakeup_hold(uint8_t ep, uint8_t *p_data, uint16_t length);
+static bool     sim_hid_send_kbd(uint8_t *p_data, uint16_t length);
+static bool     sim_hid_send_exk(uint8_t *p_data, uint16_t length);
+static bool     sim_hid_send_nkro(uint8_t *p_data, uint16_t length);
+static uint64_t sim_host_ns(void);
+static uint32_t sim_latency_tick(void);
+static int32_t  sim_cli_get_data(uint8_t index);
+static float    sim_cli_get_float(uint8_t index);
+static char    *sim_cli_get_str(uint8_t index);
+static bool     sim_cli_is_str(uint8_t index, const char *p_str);
+
+
+
+
+void simInit(void)
+{
+  memset(sim_cols_buf, 0, sizeof(sim_cols_buf));
+  memset(sim_frame_buf, 0, sizeof(sim_frame_buf));
+  memset(sim_spike_buf, 0, sizeof(sim_spike_buf));
+  sim_frame_seq = 0;
+  memset(sim_eeprom, 0xFF, sizeof(sim_eeprom));                     // 공장 출하 EEPROM 상태로 시작
+  sim_eeprom_busy   = false;
+  sim_eeprom_result = EEPROM_ASYNC_IDLE;
+  sim_eeprom_async_dst = NULL;
+  memset(sim_qspi, 0xFF, sizeof(sim_qspi));                         // V261019R6: 지운 NOR 로 시작
+  memset(sim_qspi_erase, 0, sizeof(sim_qspi_erase));
+  memset(&sim_qspi_stat, 0, sizeof(sim_qspi_stat));
+  sim_time_us    = 0;
+  sim_update_cnt = 0;
+  simClearReports();
+  usbHidTxInit(&sim_hid_tx, sim_hid_tx_func, sim_hid_kbd_buf, sim_hid_exk_buf, sim_hid_nkro_buf);   // V261021R4
+  usbHidTxReset(&sim_hid_tx, true);
+  usbHidJitInit(&sim_hid_tx.jit, false, 1000, HW_USB_HID_JIT_GUARD_FS_US, HID_TX_BACKUP_FS_US);
+  memset(sim_hid_busy, 0, sizeof(sim_hid_busy));
+  sim_hid_drain_us = 0;
+  simSetViaTransport(0, HW_USB_VIA_GATE_MS, HW_USB_VIA_WINDOW, 1);
+  usbReEnumInit(&sim_reenum, SIM_USB_DETACH_MS, HW_USB_REENUM_TIMEOUT_MS);
+  sim_usb_attached  = true;
+  sim_usb_config_us = 0;
+  sim_cmp_conf_sz   = 0;
+  sim_cmp_conf_max  = 0;
+  sim_usb_begin();
+  usbHidWakeUpInit(&sim_wakeup, HW_USB_WAKEUP_SIGNAL_MS, HW_USB_WAKEUP_TIMEOUT_MS);
+  sim_suspended        = false;
+  sim_wakeup_resume_at = 0;
+
+  idleInit();                                                       // V261017R5: hwInit() 과 동일하게 qmkInit() 전에 초기화
+  latencyInit(sim_latency_tick, SIM_LATENCY_TICK_PER_US);           // V261019R2
+  eeprom_set_wl_enable(false);                                      // V261019R6: 기존 시나리오는 I2C 경로 기준, eeprom_wl 이 켠다
+  eeprom_init();                                                    // V261019R5: hwInit() 과 같이 qmkInit() 전에 한 번만
+  qmkInit();
+  sim_time_us = (sim_time_us + 999U) / 1000U * 1000U;              // V261019R5: 적재 시간을 ms 경계로 올려 시나리오 위상 유지
+}
+
+void simSetLogEnable(bool enable)
+{
+  sim_log_enable = enable;
+}
+
+uint32_t simGetTimeUs(void)
+{
+  return (uint32_t)sim_time_us;
+}
+
+uint64_t simGetHostNs(void)
+{
+  return sim_host_ns();
+}
+
+void simAdvanceUs(uint32_t us)
+{
+  sim_time_us += us;
+}
+
+void simRunUs(uint32_t duration_us, uint32_t step_us)
+{
+  uint64_t end_us = sim_time_us + duration_us;
+
+  if (step_us == 0)
+  {
+    step_us = 1;
+  }
+
+  while (sim_time_us < end_us)
+  {
+    uint64_t begin_ns = sim_host_ns();
+    uint64_t begin_us = sim_time_us;
+
+    qmkUpdate();
+
+    sim_update_host_ns += sim_host_ns() - begin_ns;
+    sim_update_cnt++;
+    if (sim_time_us - begin_us > sim_update_max_us)               // V261019R1: delay() 가 루프를 막은 시간
+    {
+      sim_update_max_us = (uint32_t)(sim_time_us - begin_us);
+    }
+    sim_time_us += step_us;
+    sim_hid_service();                                              // V261018R2: TIM2 드레인
+    sim_usb_service();                                              // V261018R8: usbProcess() 재열거 단계
+  }
+}
+
+// V261017R5: 펌웨어 apMain() 과 같이 idleWait() → qmkUpdate() → idleMarkDone() 순서로 구동한다.
+//   idleWait() 의 __WFI 는 simWaitForInterrupt() 로 치환되어 다음 프레임 게시 시점까지 시계를 전진시킨다.
+void simRunIdleUs(uint32_t duration_us, uint32_t step_us)
+{
+  uint64_t end_us = sim_time_us + duration_us;
+
+  if (step_us == 0)
+  {
+    step_us = 1;
+  }
+
+  while (sim_time_us < end_us)
+  {
+    idleWait();
+
+    uint64_t begin_ns = sim_host_ns();
+    uint64_t begin_us = sim_time_us;
+
+    qmkUpdate();
+
+    sim_update_host_ns += sim_host_ns() - begin_ns;
+    sim_update_cnt++;
+    if (sim_time_us - begin_us > sim_update_max_us)               // V261019R1: delay() 가 루프를 막은 시간
+    {
+      sim_update_max_us = (uint32_t)(sim_time_us - begin_us);
+    }
+    sim_time_us += step_us;
+    sim_keys_update_frame();                                        // 루프 처리 중 지난 DMA 프레임 ISR
+    sim_hid_service();                                              // V261018R2: TIM2 드레인
+    sim_usb_service();                                              // V261018R8
+    idleMarkDone();
+  }
+}
+
+// __WFI 대체: 다음 인터럽트(프레임 게시 = SIM_KEYS_FRAME_US 경계, 1ms tick 포함)까지 시계를 전진시키고 ISR 을 실행한다.
+void simWaitForInterrupt(void)
+{
+  sim_time_us = (sim_time_us / SIM_KEYS_FRAME_US + 1U) * SIM_KEYS_FRAME_US;
+  sim_keys_update_frame();
+  sim_hid_service();
+}
+
+uint32_t simGetUpdateMaxUs(void)
+{
+  return sim_update_max_us;
+}
+
+void simClearUpdateMaxUs(void)
+{
+  sim_update_max_us = 0;
+}
+
+uint64_t simGetUpdateCount(void)
+{
+  return sim_update_cnt;
+}
+
+uint64_t simGetUpdateHostNs(void)
+{
+  return sim_update_host_ns;
+}
+
+void simSetKey(uint8_t row, uint8_t col, bool pressed)
+{
+  if (row >= MATRIX_ROWS || col >= MATRIX_COLS)
+  {
+    return;
+  }
+
+  if (pressed)
+  {
+    sim_cols_buf[row] |= (keys_col_t)1 << col;
+  }
+  else
+  {
+    sim_cols_buf[row] &= (keys_col_t)~((keys_col_t)1 << col);
+  }
+}
+
+// V261017R6: 다음 게시 프레임의 마지막 스윕 1개에서만 해당 스위치 값을 뒤집는다 (EMI 스파이크 모델).
+void simInjectSpike(uint8_t row, uint8_t col)
+{
+  if (row >= MATRIX_ROWS || col >= MATRIX_COLS)
+  {
+    return;
+  }
+  sim_spike_buf[row] ^= (keys_col_t)1 << col;
+}
+
+bool simGetKey(uint8_t row, uint8_t col)
+{
+  if (row >= MATRIX_ROWS || col >= MATRIX_COLS)
+  {
+    return false;
+  }
+  return (sim_cols_buf[row] & ((keys_col_t)1 << col)) != 0;
+}
+
+uint32_t simGetReportCount(void)
+{
+  return sim_report_cnt;
+}
+
+uint32_t simGetReportDropped(void)
+{
+  return sim_report_dropped;
+}
+
+const sim_report_t *simGetReport(uint32_t index)
+{
+  if (index >= sim_report_cnt)
+  {
+    return NULL;
+  }
+  return &sim_report_log[index];
+}
+
+void simClearReports(void)
+{
+  sim_report_cnt     = 0;
+  sim_report_dropped = 0;
+}
+
+bool simCliRun(const char *line)
+{
+  static char buf[SIM_CLI_LINE_MAX];
+  char       *save = NULL;
+
+  strncpy(buf, line, sizeof(buf) - 1);
+  buf[sizeof(buf) - 1] = 0;
+
+  char *cmd = strtok_r(buf, " ", &save);
+  if (cmd == NULL)
+  {
+    return false;
+  }
+
+  sim_cli_argc = 0;
+  for (char *tok = strtok_r(NULL, " ", &save); tok != NULL && sim_cli_argc < SIM_CLI_ARGV_MAX; tok = strtok_r(NULL, " ", &save))
+  {
+    sim_cli_argv[sim_cli_argc++] = tok;
+  }
+
+  for (uint32_t i=0; i<sim_cli_cmd_cnt; i++)
+  {
+    if (strcmp(cmd, sim_cli_cmd[i].name) == 0)
+    {
+      cli_args_t args;
+
+      args.argc     = sim_cli_argc;
+      args.argv     = sim_cli_argv;
+      args.getData  = sim_cli_get_data;
+      args.getFloat = sim_cli_get_float;
+      args.getStr   = sim_cli_get_str;
+      args.isStr    = sim_cli_is_str;
+
+      bool log_enable = sim_log_enable;
+
+      sim_log_enable = true;                                        // CLI 응답은 logPrintf 경로로도 출력되므로 일시 활성화
+      sim_cli_cmd[i].func(&args);
+      sim_log_enable = log_enable;
+      return true;
+    }
+  }
+  return false;
+}
+
+int32_t sim_cli_get_data(uint8_t index)
+{
+  if (index >= sim_cli_argc)
+  {
+    return 0;
+  }
+  return (int32_t)strtol(sim_cli_argv[index], NULL, 0);
+}
+
+float sim_cli_get_float(uint8_t index)
+{
+  if (index >= sim_cli_argc)
+  {
+    return 0.0f;
+  }
+  return strtof(sim_cli_argv[index], NULL);
+}
+
+char *sim_cli_get_str(uint8_t index)
+{
+  if (index >= sim_cli_argc)
+  {
+    return NULL;
+  }
+  return sim_cli_argv[index];
+}
+
+bool sim_cli_is_str(uint8_t index, const char *p_str)
+{
+  if (index >= sim_cli_argc)
+  {
+    return false;
+  }
+  return strcmp(sim_cli_argv[index], p_str) == 0;
+}
+
+void simViaSend(const uint8_t *p_data, uint8_t length)
+{
+  uint8_t buf[SIM_REPORT_DATA_MAX];
+
+  if (sim_via_receive_func == NULL || length > sizeof(buf))
+  {
+    return;
+  }
+
+  memcpy(buf, p_data, length);
+  sim_via_receive_func(buf, length);                                // 펌웨어에서는 OTG ISR 문맥에서 호출됨
+}
+
+// poll_us 0 이면 전송 모델을 끄고 응답을 바로 기록한다. 호스트 큐와 통계는 초기화된다.
+void simSetViaTransport(uint32_t poll_us, uint32_t gate_ms, uint32_t window, uint32_t host_window)
+{
+  usbHidViaInit(&sim_via, gate_ms, window);
+  sim_via_poll_us     = poll_us;
+  sim_via_next_us     = poll_us > 0 ? (sim_time_us / poll_us + 1U) * poll_us : 0;
+  sim_via_host_window = host_window > 0 ? host_window : 1;
+  sim_via_host_queued = 0;
+  sim_via_host_sent   = 0;
+  sim_via_host_done   = 0;
+  sim_via_in_loaded   = false;
+}
+
+bool simViaHostQueue(const uint8_t *p_data, uint8_t length)
+{
+  if (sim_via_host_queued >= SIM_VIA_HOST_Q_MAX || length > HID_VIA_PACKET_SIZE)
+  {
+    return false;
+  }
+
+  memset(sim_via_host_q[sim_via_host_queued], 0, HID_VIA_PACKET_SIZE);
+  memcpy(sim_via_host_q[sim_via_host_queued], p_data, length);
+  sim_via_host_queued++;
+  return true;
+}
+
+// 응답을 아직 받지 못한 요청 수 (보내지 않은 것 포함)
+uint32_t simViaHostPending(void)
+{
+  return sim_via_host_queued - sim_via_host_done;
+}
+
+hid_via_t *simGetVia(void)
+{
+  return &sim_via;
+}
+
+// 펌웨어 usbHidViaService() 대응
+static void sim_via_load(void)
+{
+  if (sim_via_in_loaded != true && usbHidViaPop(&sim_via, sim_via_in_buf, millis()) == true)
+  {
+    sim_via_in_loaded = true;
+  }
+  usbHidViaTakeRearm(&sim_via);                                     // 펌웨어에서는 여기서 OUT 을 재무장
+}
+
+void sim_via_service(void)
+{
+  if (sim_via_poll_us == 0)
+  {
+    return;
+  }
+
+  while (sim_time_us >= sim_via_next_us)
+  {
+    sim_via_next_us += sim_via_poll_us;
+
+    if (sim_via_in_loaded == true)                                  // IN: 실린 응답 수거 → DataIn
+    {
+      sim_report_push(SIM_EP_VIA, sim_via_in_buf, HID_VIA_PACKET_SIZE);
+      sim_via_in_loaded = false;
+      sim_via_host_done++;
+      sim_via_load();
+    }
+
+    if (sim_via.out_armed == true && sim_via_host_sent < sim_via_host_queued &&
+        sim_via_host_sent - sim_via_host_done < sim_via_host_window)   // OUT: NAK 가 아니면 요청 전달 → DataOut
+    {
+      uint8_t buf[HID_VIA_PACKET_SIZE];
+
+      bool queued = false;
+
+      memcpy(buf, sim_via_host_q[sim_via_host_sent++], sizeof(buf));
+      if (sim_via_receive_func != NULL)
+      {
+        queued = sim_via_receive_func(buf, sizeof(buf));
+      }
+      usbHidViaOnReceive(&sim_via, queued);
+    }
+
+    sim_via_load();                                                 // SOF
+  }
+}
+
+void simSetSuspended(bool suspended)
+{
+  sim_suspended = suspended;
+  if (suspended == true)
+  {
+    sim_wakeup_resume_at = 0;
+  }
+}
+
+void simSetWakeUpResumeUs(uint32_t resume_us)
+{
+  sim_wakeup_resume_us = resume_us;
+}
+
+void simSetWakeUpBlocking(bool blocking)
+{
+  sim_wakeup_blocking = blocking;
+}
+
+hid_wakeup_t *simGetHidWakeUp(void)
+{
+  return &sim_wakeup;
+}
+
+// V261018R2: 키보드 EP 폴링 주기를 바꾸고 병합 큐 통계를 초기화한다.
+void simSetHidPollUs(uint32_t poll_us)
+{
+  sim_hid_poll_us   = poll_us;
+  sim_hid_sof_us    = poll_us < 1000U ? SIM_HID_HS_SOF_US : SIM_HID_FS_SOF_US;
+  sim_hid_sof_at_us = sim_time_us / sim_hid_sof_us * sim_hid_sof_us;
+  sim_hid_drain_us  = sim_time_us;
+  memset(sim_hid_busy, 0, sizeof(sim_hid_busy));
+  usbHidTxReset(&sim_hid_tx, true);
+  usbHidCoalesceClearInfo(&sim_hid_tx.kbd_q);
+
+  // V261018R4: 펌웨어 USBD_HID_Init() 과 같이 폴링이 바뀌면 위상을 다시 학습한다.
+  // V261021R4: 백업 비교 시점도 펌웨어 usbHidBackupTimerOffsetUs() 와 같다 (드레인이 그 시점에만 돈다).
+  // V261021R5: JIT 프레임은 SOF 주기, 폴링 주기는 SOF 배수(HS bInterval 2/3 → 2/4 마이크로프레임)로 나눠 넘긴다.
+  if (poll_us > 0)
+  {
+    usbHidJitInit(&sim_hid_tx.jit, sim_hid_tx.jit.enable, sim_hid_sof_us,
+                  poll_us < 1000U ? HW_USB_HID_JIT_GUARD_HS_US : HW_USB_HID_JIT_GUARD_FS_US,
+                  poll_us < 1000U ? HID_TX_BACKUP_HS_US : HID_TX_BACKUP_FS_US);
+    usbHidTxSetPollDiv(&sim_hid_tx, poll_us / sim_hid_sof_us);
+  }
+}
+
+// V261018R4: 키보드 EP IN 토큰 위상(SOF 기준)과 프레임별 흔들림 폭 (phase + jitter < poll)
+void simSetHidPhaseUs(uint32_t phase_us, uint32_t jitter_us)
+{
+  sim_hid_phase_us  = phase_us;
+  sim_hid_jitter_us = jitter_us;
+}
+
+void simSetHidJit(bool enable)
+{
+  usbHidJitSetEnable(&sim_hid_tx.jit, enable);
+}
+
+hid_jit_t *simGetHidJit(void)
+{
+  return &sim_hid_tx.jit;
+}
+
+// V261018R3: true 면 모든 IN EP 가 busy 상태 하나를 공유한다 (어느 EP 의 완료든 해제, 개선 전 비교용).
+void simSetHidSharedBusy(bool shared)
+{
+  sim_hid_shared = shared;
+}
+
+// 지금부터 us 동안 호스트가 키보드 EP IN 토큰에 NAK 한다 (버스 점유/호스트 지연 모델).
+void simStallHidUs(uint32_t us)
+{
+  sim_hid_run_isr();                                                // 이미 지난 IN 토큰은 NAK 대상이 아니다
+  sim_hid_stall_us = sim_time_us + us;
+}
+
+bool simUsbReEnum(uint32_t grace_ms, uint32_t enum_us)
+{
+  sim_usb_enum_us = enum_us;
+  return usbReEnumRequest(&sim_reenum, USB_HID_MODE, millis(), grace_ms);
+}
+
+usb_reenum_t *simGetUsbReEnum(void)
+{
+  return &sim_reenum;
+}
+
+uint32_t simGetUsbLostReports(void)
+{
+  return sim_usb_lost;
+}
+
+uint32_t simGetUsbConfDescSize(void)
+{
+  return sim_cmp_conf_sz;
+}
+
+uint32_t simGetUsbConfDescMax(void)
+{
+  return sim_cmp_conf_max;
+}
+
+static void sim_cmp_add(uint8_t class_id, uint32_t class_sz)
+{
+  if (class_id == 0)                                                // USBD_CMPSIT_AddToConfDesc() 첫 클래스
+  {
+    sim_cmp_conf_sz += SIM_CMP_CONF_HDR_SZ;
+  }
+  sim_cmp_conf_sz += class_sz;
+  if (sim_cmp_conf_sz > sim_cmp_conf_max)
+  {
+    sim_cmp_conf_max = sim_cmp_conf_sz;
+  }
+}
+
+// usb.c usbBegin() USB_CMP_MODE 대응 (디스크립터 크기만 모델링)
+static void sim_usb_begin(void)
+{
+  sim_cmp_conf_sz = 0;                                              // USBD_CMPST_ClearConfDesc()
+  sim_cmp_add(0, SIM_CMP_HID_SZ);                                   // USBD_RegisterClassComposite(HID)
+  sim_cmp_add(1, SIM_CMP_CDC_SZ);                                   // USBD_RegisterClassComposite(CDC)
+}
+
+static bool sim_usb_is_configured(void)
+{
+  return sim_usb_attached == true && sim_time_us >= sim_usb_config_us;
+}
+
+// usb.c usbProcessReEnum() 대응 (USBD 호출 대신 링크 모델을 바꾼다)
+void sim_usb_service(void)
+{
+  if (sim_wakeup_resume_at != 0 && sim_time_us >= sim_wakeup_resume_at)   // V261019R1: 호스트 재개 → PCD_ResumeCallback
+  {
+    sim_wakeup_resume_at = 0;
+    sim_suspended        = false;
+  }
+
+  if (usbReEnumIsBusy(&sim_reenum) != true)
+  {
+    return;
+  }
+
+  switch (usbReEnumStep(&sim_reenum, millis(), sim_usb_is_configured()))
+  {
+    case USB_REENUM_ACT_DETACH:
+      sim_usb_attached = false;
+      break;
+
+    case USB_REENUM_ACT_ATTACH:
+      sim_usb_begin();
+      sim_usb_attached  = true;
+      sim_usb_config_us = sim_time_us + sim_usb_enum_us;
+      break;
+
+    case USB_REENUM_ACT_RESEND:
+      usbHidResendReports();
+      break;
+
+    default:
+      break;
+  }
+}
+
+// V261019R1: usbd_hid.c usbHidWakeUpHold()/usbHidUpdateWakeUp() 대응
+static bool sim_wakeup_hold(uint8_t ep, uint8_t *p_data, uint16_t length)
+{
+  if (sim_wakeup_blocking == true)
+  {
+    if (sim_suspended != true)
+    {
+      return false;
+    }
+    delay(HW_USB_WAKEUP_SIGNAL_MS);                                 // K 상태 동안 메인 루프 정지, 리포트는 버림
+    if (sim_wakeup_resume_at == 0 && sim_wakeup_resume_us > 0)
+    {
+      sim_wakeup_resume_at = sim_time_us - HW_USB_WAKEUP_SIGNAL_MS * 1000U + sim_wakeup_resume_us;
+    }
+    return true;
+  }
+
+  if (sim_suspended != true && usbHidWakeUpAvailable(&sim_wakeup) == 0)
+  {
+    return false;
+  }
+
+  usbHidWakeUpPush(&sim_wakeup, ep, p_data, length);
+  if (sim_suspended == true && usbHidWakeUpRequest(&sim_wakeup, millis()) == true && sim_wakeup_resume_us > 0)
+  {
+    sim_wakeup_resume_at = sim_time_us + sim_wakeup_resume_us;
+  }
+  return true;
+}
+
+// usbd_hid.c usbHidWakeUpProcess() 대응 (qmk.c idle_task() 에서 호출)
+void usbHidWakeUpProcess(void)
+{
+  hid_wakeup_rec_t rec;
+
+  switch (usbHidWakeUpStep(&sim_wakeup, millis(), sim_suspended != true && sim_usb_is_configured() == true))
+  {
+    case HID_WAKEUP_ACT_REPLAY:
+      while (usbHidWakeUpPop(&sim_wakeup, &rec) == true)
+      {
+        if (rec.ep == SIM_EP_KEYBOARD)
+        {
+          sim_hid_send_kbd(rec.buf, rec.len);
+        }
+        else if (rec.ep == SIM_EP_EXK)
+        {
+          sim_hid_send_exk(rec.buf, rec.len);
+        }
+        else if (rec.ep == SIM_EP_NKRO)
+        {
+          sim_hid_send_nkro(rec.buf, rec.len);
+        }
+      }
+      break;
+
+    default:
+      break;
+  }
+}
+
+// 펌웨어는 CONFIGURED 가 아니면 IN 을 싣지 못하고, 재구성 후 호스트는 이전 리포트를 모른다.
+static bool sim_usb_drop_report(void)
+{
+  if (sim_usb_is_configured() == true)
+  {
+    return false;
+  }
+  sim_usb_lost++;
+  return true;
+}
+
+uint32_t simGetEepromWriteBytes(void)
+{
+  return sim_eeprom_write_bytes;
+}
+
+uint32_t simGetEepromWriteCount(void)
+{
+  return sim_eeprom_write_cnt;
+}
+
+void simSetEepromBlocking(bool blocking)
+{
+  sim_eeprom_blocking = blocking;
+}
+
+void simSetEepromLegacyRead(bool legacy)
+{
+  sim_eeprom_legacy_read = legacy;
+}
+
+uint32_t simGetEepromReadCount(void)
+{
+  return sim_eeprom_read_cnt;
+}
+
+const uint8_t *simGetEepromData(void)
+{
+  return sim_eeprom;
+}
+
+uint32_t simGetEepromPageWriteCount(uint32_t page)
+{
+  return page < sizeof(sim_eeprom_page_write) / sizeof(sim_eeprom_page_write[0]) ? sim_eeprom_page_write[page] : 0;
+}
+
+void simGetQspiStat(sim_qspi_stat_t *p_stat)
+{
+  *p_stat = sim_qspi_stat;
+}
+
+void sim_report_push(uint8_t ep, const uint8_t *p_data, uint16_t length)
+{
+  if (sim_report_cnt >= SIM_REPORT_LOG_MAX)
+  {
+    sim_report_dropped++;
+    return;
+  }
+
+  sim_report_t *p_report = &sim_report_log[sim_report_cnt++];
+
+  if (length > SIM_REPORT_DATA_MAX)
+  {
+    length = SIM_REPORT_DATA_MAX;
+  }
+  if (ep == SIM_EP_KEYBOARD || ep == SIM_EP_NKRO)
+  {
+    usbReEnumOnReport(&sim_reenum, millis());                      // V261018R8: usbd_hid.c DataIn 대응
+    latencyMark(LATENCY_POINT_TX);                                 // V261019R2: usbHidEpTransmit() 대응
+    if (sim_hid_poll_us == 0)
+    {
+      latencyMark(LATENCY_POINT_DONE);                             // 폴링 모델이 없으면 즉시 IN 완료
+    }
+  }
+  p_report->time_us = (uint32_t)sim_time_us;
+  p_report->ep      = ep;
+  p_report->length  = (uint8_t)length;
+  memset(p_report->data, 0, sizeof(p_report->data));            // V261018R1: 짧은 리포트(부트 8B) 뒤에 이전 기록이 남지 않도록
+  memcpy(p_report->data, p_data, length);
+}
+
+// 프레임마다 달라지지만 재현 가능한 IN 위상 흔들림
+static uint32_t sim_hid_token_jitter(uint64_t frame)
+{
+  if (sim_hid_jitter_us == 0)
+  {
+    return 0;
+  }
+  return (uint32_t)(((frame * 2654435761ULL) >> 7) % (sim_hid_jitter_us + 1U));
+}
+
+// after_us 이후 첫 IN 토큰 시각
+static uint64_t sim_hid_next_token_us(uint64_t after_us)
+{
+  uint64_t frame = after_us / sim_hid_poll_us;
+
+  while (true)
+  {
+    uint64_t token_us = frame * sim_hid_poll_us + sim_hid_phase_us + sim_hid_token_jitter(frame);
+
+    if (token_us > after_us)
+    {
+      return token_us;
+    }
+    frame++;
+  }
+}
+
+// TIM2 는 SOF 마다 리셋되므로 비교 ISR 은 매 (마이크로)프레임 compare_us 에서 한 번 돈다.
+static uint64_t sim_hid_next_drain_us(void)
+{
+  uint64_t drain_us = sim_hid_drain_us / sim_hid_sof_us * sim_hid_sof_us + sim_hid_tx.jit.compare_us;
+
+  if (drain_us <= sim_hid_drain_us)
+  {
+    drain_us += sim_hid_sof_us;
+  }
+  return drain_us;
+}
+
+// 펌웨어 usbHidEpTransmit() 대응 (usbHidTxStart() 가 호출). 리포트를 기록하고 다음 IN 토큰에 완료를 예약한다.
+bool sim_hid_tx_func(uint8_t ep_addr, uint8_t *p_data, uint16_t length)
+{
+  uint32_t slot = ep_addr & 0x07U;
+
+  sim_report_push(ep_addr, p_data, length);
+  sim_hid_busy[slot]    = true;
+  sim_hid_done_us[slot] = sim_hid_next_token_us(sim_time_us);
+  if (sim_hid_shared == true)
+  {
+    for (uint32_t i=0; i<HID_IN_EP_NUM_MAX; i++)
+    {
+      sim_hid_tx.ep_state[i] = USBD_HID_BUSY;                      // V261018R3 이전: 모든 EP 가 상태 하나를 공유
+    }
+  }
+  return true;
+}
+
+// 펌웨어 USBD_HID_DataIn() 대응. 폴링 루프라 IN 완료 시각으로 소급해 실행한다.
+static void sim_hid_data_in(uint32_t slot)
+{
+  uint8_t  ep_addr = (uint8_t)(0x80U | slot);
+  uint64_t in_us   = sim_hid_done_us[slot];
+  uint64_t now_us  = sim_time_us;
+
+  sim_time_us        = in_us;
+  sim_hid_busy[slot] = false;
+  for (uint32_t i=0; i<HID_IN_EP_NUM_MAX; i++)
+  {
+    if (i == slot || sim_hid_shared == true)                        // 공유 모델은 어느 EP 의 완료든 모두 해제
+    {
+      usbHidTxOnDataIn(&sim_hid_tx, (uint8_t)(0x80U | i));
+    }
+  }
+  if (ep_addr == SIM_EP_KEYBOARD || ep_addr == SIM_EP_NKRO)
+  {
+    latencyMark(LATENCY_POINT_DONE);                               // V261019R2
+  }
+  if (ep_addr == SIM_EP_KEYBOARD)
+  {
+    usbHidTxOnKeyboardDataIn(&sim_hid_tx, (uint32_t)in_us, (uint32_t)(in_us % sim_hid_sof_us));
+  }
+  sim_time_us = now_us;
+}
+
+// 펌웨어 HAL_TIM_PWM_PulseFinishedCallback() 대응
+static void sim_hid_drain(uint64_t drain_us)
+{
+  uint64_t now_us = sim_time_us;
+
+  sim_time_us      = drain_us;
+  sim_hid_drain_us = drain_us;
+  usbHidTxDrain(&sim_hid_tx, (uint32_t)drain_us);
+  sim_time_us = now_us;
+}
+
+// V261021R4: 지금까지 지난 ISR(SOF, IN 완료, TIM2 비교)을 시각 순서대로 실행한다. 같은 시각이면 이 순서대로다.
+void sim_hid_run_isr(void)
+{
+  if (sim_hid_poll_us == 0)
+  {
+    return;
+  }
+
+  while (true)
+  {
+    uint64_t sof_us   = sim_hid_sof_at_us + sim_hid_sof_us;
+    uint64_t drain_us = sim_hid_next_drain_us();
+    int32_t  slot     = -1;
+
+    for (uint32_t i=0; i<HID_IN_EP_NUM_MAX; i++)
+    {
+      if (sim_hid_busy[i] != true)
+      {
+        continue;
+      }
+      if (sim_hid_done_us[i] < sim_hid_stall_us)
+      {
+        sim_hid_done_us[i] = sim_hid_next_token_us(sim_hid_stall_us - 1U);   // NAK 구간의 IN 토큰은 건너뛴다
+      }
+      if (slot < 0 || sim_hid_done_us[i] < sim_hid_done_us[slot])
+      {
+        slot = (int32_t)i;
+      }
+    }
+
+    if (sof_us <= sim_time_us && sof_us <= drain_us && (slot < 0 || sof_us <= sim_hid_done_us[slot]))
+    {
+      sim_hid_sof_at_us = sof_us;
+      usbHidTxOnSof(&sim_hid_tx);                                  // V261021R5: 펌웨어 USBD_HID_SOF() 대응
+    }
+    else if (slot >= 0 && sim_hid_done_us[slot] <= sim_time_us && sim_hid_done_us[slot] <= drain_us)
+    {
+      sim_hid_data_in((uint32_t)slot);
+    }
+    else if (drain_us <= sim_time_us)
+    {
+      sim_hid_drain(drain_us);
+    }
+    else
+    {
+      break;
+    }
+  }
+}
+
+void sim_hid_service(void)
+{
+  sim_via_service();                                                // V261018R6: VIA EP 는 키보드 폴링 모델과 독립
+  sim_hid_run_isr();
+}
+
+uint32_t sim_latency_tick(void)
+{
+  return (uint32_t)(sim_time_us * SIM_LATENCY_TICK_PER_US);
+}
+
+uint64_t sim_host_ns(void)
+{
+  struct timespec ts;
+
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return (uint64_t)ts.tv_sec * 1000000000ULL + (uint64_t)ts.tv_nsec;
+}
+
+
+// ---------------------------------------------------------------------------
+// bsp / micros
+// ---------------------------------------------------------------------------
+void delay(uint32_t time_ms)
+{
+  sim_time_us += (uint64_t)time_ms * 1000U;                          // 블로킹 지연은 가상 시계를 그대로 소모
+}
+
+uint32_t millis(void)
+{
+  return (uint32_t)(sim_time_us / 1000U);
+}
+
+uint32_t micros(void)
+{
+  return (uint32_t)sim_time_us;
+}
+
+
+// ---------------------------------------------------------------------------
+// log / cli
+// ---------------------------------------------------------------------------
+void logPrintf(const char *fmt, ...)
+{
+  if (sim_log_enable != true)
+  {
+    return;
+  }
+
+  va_list args;
+
+  va_start(args, fmt);
+  vprintf(fmt, args);
+  va_end(args);
+}
+
+void cliPrintf(const char *fmt, ...)
+{
+  va_list args;
+
+  va_start(args, fmt);
+  vprintf(fmt, args);
+  va_end(args);
+}
+
+bool cliAdd(const char *cmd_str, void (*p_func)(cli_args_t *))
+{
+  if (sim_cli_cmd_cnt >= SIM_CLI_CMD_MAX)
+  {
+    return false;
+  }
+
+  strncpy(sim_cli_cmd[sim_cli_cmd_cnt].name, cmd_str, HW_CLI_CMD_NAME_MAX - 1);
+  sim_cli_cmd[sim_cli_cmd_cnt].func = p_func;
+  sim_cli_cmd_cnt++;
+  return true;
+}
+
+
+// ---------------------------------------------------------------------------
+// keys
+// ---------------------------------------------------------------------------
+// V261017R4: 가상 시계가 SIM_KEYS_FRAME_US 경계를 넘을 때마다 현재 키 상태를 한 프레임으로 게시한다.
+static void sim_keys_update_frame(void)
+{
+  uint32_t seq = (uint32_t)(sim_time_us / SIM_KEYS_FRAME_US) + 1U;
+
+  if (seq != sim_frame_seq)
+  {
+    keys_col_t frame[MATRIX_ROWS];
+    uint32_t   first = KEYS_OVERSAMPLE_MAX - sim_oversample;
+
+    // V261017R6: keysPublishFrame() 과 같이 최근 sim_oversample 스윕을 keysReduceSamples() 로 축약한다.
+    for (uint32_t i=0; i<KEYS_OVERSAMPLE_MAX; i++)
+    {
+      for (uint32_t r=0; r<MATRIX_ROWS; r++)
+      {
+        keys_col_t cols = sim_cols_buf[r];
+
+        if (i == KEYS_OVERSAMPLE_MAX - 1)
+        {
+          cols ^= sim_spike_buf[r];
+        }
+        for (uint32_t k=0; k<SIM_COL_PORTS; k++)
+        {
+          sim_sweep_buf[i][r * SIM_COL_PORTS + k] = (uint16_t)(cols >> (16 * k));
+        }
+      }
+    }
+    for (uint32_t r=0; r<MATRIX_ROWS; r++)
+    {
+      frame[r] = 0;
+      for (uint32_t k=0; k<SIM_COL_PORTS; k++)
+      {
+        uint16_t port_val = keysReduceSamples(&sim_sweep_buf[first][r * SIM_COL_PORTS + k],
+                                              MATRIX_ROWS * SIM_COL_PORTS,
+                                              sim_oversample,
+                                              sim_reduce);
+
+        frame[r] |= (keys_col_t)port_val << (16 * k);
+      }
+    }
+    memset(sim_spike_buf, 0, sizeof(sim_spike_buf));
+
+    bool changed = memcmp(sim_frame_buf, frame, sizeof(sim_frame_buf)) != 0;
+
+    memcpy(sim_frame_buf, frame, sizeof(sim_frame_buf));
+    sim_frame_seq = seq;
+    if (changed)
+    {
+      idleSetEvent(IDLE_EVENT_KEYS);                                // V261017R5: keysPublishFrame() 의 XOR 변화 검출과 동일
+    }
+  }
+}
+
+const volatile keys_col_t *keysPeekColsBuf(void)
+{
+  sim_keys_update_frame();
+  return sim_frame_buf;
+}
+
+bool keysReadColsBuf(keys_col_t *p_data, uint32_t rows_cnt)
+{
+  return keysReadFrame(p_data, rows_cnt, NULL, NULL);
+}
+
+uint32_t keysGetFrameSeq(void)
+{
+  sim_keys_update_frame();
+  return sim_frame_seq;
+}
+
+bool keysReadFrame(keys_col_t *p_data, uint32_t rows_cnt, uint32_t *p_seq, uint32_t *p_us)
+{
+  sim_keys_update_frame();
+  memcpy(p_data, sim_frame_buf, rows_cnt * sizeof(keys_col_t));
+  if (p_seq != NULL)
+  {
+    *p_seq = sim_frame_seq;
+  }
+  if (p_us != NULL)
+  {
+    *p_us = (sim_frame_seq - 1U) * SIM_KEYS_FRAME_US;              // V261017R8: 프레임 경계(스윕 완료) 시각
+  }
+  return true;
+}
+
+bool keysGetPressed(uint16_t row, uint16_t col)
+{
+  return simGetKey((uint8_t)row, (uint8_t)col);
+}
+
+bool keysSetOversample(uint8_t samples, keys_reduce_t reduce)
+{
+  if (samples == 0 || samples > KEYS_OVERSAMPLE_MAX || reduce >= KEYS_REDUCE_COUNT)
+  {
+    return false;
+  }
+  sim_oversample = samples;
+  sim_reduce     = reduce;
+  return true;
+}
+
+uint8_t keysGetOversample(void)
+{
+  return sim_oversample;
+}
+
+keys_reduce_t keysGetReduce(void)
+{
+  return sim_reduce;
+}
+
+// 가상 시계의 프레임 주기(SIM_KEYS_FRAME_US)는 고정이며 설정값만 보관한다.
+bool keysSetScanRate(keys_scan_rate_t rate)
+{
+  if (rate >= KEYS_SCAN_RATE_COUNT)
+  {
+    return false;
+  }
+  sim_scan_rate = rate;
+  return true;
+}
+
+keys_scan_rate_t keysGetScanRate(void)
+{
+  return sim_scan_rate;
+}
+
+// V261021R1: 가상 시계는 SIM_KEYS_FRAME_US 마다 게시하므로 스캔(게시) 주파수도 그 주기로 보고한다.
+uint32_t keysGetScanFreqHz(void)
+{
+  return 1000000U / keysGetFramePeriodUs();
+}
+
+uint32_t keysGetSweepFreqHz(void)
+{
+  return 1000000U / ((1U << sim_scan_rate) * MATRIX_ROWS);
+}
+
+uint32_t keysGetFramePeriodUs(void)
+{
+  return SIM_KEYS_FRAME_US;
+}
+
+
+// ---------------------------------------------------------------------------
+// eeprom
+// ---------------------------------------------------------------------------
+static void sim_eeprom_commit(void)
+{
+  if (sim_eeprom_async_dst != NULL)
+  {
+    memcpy(sim_eeprom_async_dst, &sim_eeprom[sim_eeprom_async_addr], sim_eeprom_async_len);   // V261019R5: 비동기 읽기 완료
+    sim_eeprom_async_dst = NULL;
+    sim_eeprom_busy      = false;
+    sim_eeprom_result    = EEPROM_ASYNC_DONE;
+    return;
+  }
+  memcpy(&sim_eeprom[sim_eeprom_async_addr], sim_eeprom_async_buf, sim_eeprom_async_len);
+  sim_eeprom_write_bytes += sim_eeprom_async_len;
+  sim_eeprom_write_cnt++;
+  sim_eeprom_page_write[sim_eeprom_async_addr / 32U]++;
+  sim_eeprom_busy   = false;
+  sim_eeprom_result = EEPROM_ASYNC_DONE;
+}
+
+bool eepromWritePageAsync(uint32_t addr, uint8_t const *p_data, uint32_t length)
+{
+  if (sim_eeprom_busy == true || length == 0 || length > SIM_EEPROM_PAGE_MAX || addr + length > SIM_EEPROM_SIZE)
+  {
+    return false;
+  }
+  memcpy(sim_eeprom_async_buf, p_data, length);
+  sim_eeprom_async_addr = addr;
+  sim_eeprom_async_len  = length;
+  sim_eeprom_busy       = true;
+  sim_eeprom_result     = EEPROM_ASYNC_IDLE;
+  sim_eeprom_done_us    = sim_time_us + (3U + length) * SIM_EEPROM_BYTE_US + SIM_EEPROM_CYCLE_US;
+  if (sim_eeprom_blocking == true)
+  {
+    sim_time_us = sim_eeprom_done_us;                               // 전송 + ACK 폴링 동안 호출자가 멈춤
+    sim_eeprom_commit();
+  }
+  return true;
+}
+
+bool eepromReadAsync(uint32_t addr, uint8_t *p_data, uint32_t length)
+{
+  if (sim_eeprom_busy == true || length == 0 || addr + length > SIM_EEPROM_SIZE)
+  {
+    return false;
+  }
+  sim_eeprom_async_dst  = p_data;
+  sim_eeprom_async_addr = addr;
+  sim_eeprom_async_len  = length;
+  sim_eeprom_busy       = true;
+  sim_eeprom_result     = EEPROM_ASYNC_IDLE;
+  sim_eeprom_done_us    = sim_time_us + (SIM_EEPROM_READ_HDR + length) * SIM_EEPROM_BYTE_US;
+  sim_eeprom_read_cnt++;
+  return true;
+}
+
+eeprom_async_state_t eepromAsyncUpdate(void)
+{
+  eeprom_async_state_t ret;
+
+  if (sim_eeprom_busy == true)
+  {
+    if (sim_time_us < sim_eeprom_done_us)
+    {
+      return EEPROM_ASYNC_BUSY;
+    }
+    sim_eeprom_commit();
+  }
+  ret = sim_eeprom_result;
+  sim_eeprom_result = EEPROM_ASYNC_IDLE;
+  return ret;
+}
+
+bool eepromAsyncWait(uint32_t timeout_ms)
+{
+  (void)timeout_ms;
+  if (sim_eeprom_busy == true)
+  {
+    if (sim_time_us < sim_eeprom_done_us)
+    {
+      sim_time_us = sim_eeprom_done_us;                             // 블로킹 대기는 가상 시계를 소모
+    }
+    sim_eeprom_commit();
+  }
+  return true;
+}
+
+bool eepromRead(uint32_t addr, uint8_t *p_data, uint32_t length)
+{
+  if (addr + length > SIM_EEPROM_SIZE)
+  {
+    return false;
+  }
+  eepromAsyncWait(0);
+  memcpy(p_data, &sim_eeprom[addr], length);
+  if (sim_eeprom_legacy_read == true)
+  {
+    sim_time_us += (uint64_t)length * (SIM_EEPROM_READ_HDR + 1U) * SIM_EEPROM_BYTE_US;
+  }
+  else
+  {
+    sim_time_us += (uint64_t)(SIM_EEPROM_READ_HDR + length) * SIM_EEPROM_BYTE_US;
+  }
+  sim_eeprom_read_cnt++;
+  return true;
+}
+
+bool eepromWriteByte(uint32_t addr, uint8_t data_in)
+{
+  if (addr >= SIM_EEPROM_SIZE)
+  {
+    return false;
+  }
+  eepromAsyncWait(0);
+  sim_eeprom[addr] = data_in;
+  sim_eeprom_write_bytes++;
+  sim_eeprom_write_cnt++;
+  sim_eeprom_page_write[addr / 32U]++;
+  return true;
+}
+
+bool eepromWritePage(uint32_t addr, uint8_t const *p_data, uint32_t length)
+{
+  if (addr + length > SIM_EEPROM_SIZE)
+  {
+    return false;
+  }
+  eepromAsyncWait(0);
+  memcpy(&sim_eeprom[addr], p_data, length);
+  sim_eeprom_write_bytes += length;
+  sim_eeprom_write_cnt++;
+  sim_eeprom_page_write[addr / 32U]++;
+  return true;
+}
+
+bool eepromIsErasing(void)
+{
+  return false;
+}
+
+bool eepromScheduleDeferredFactoryReset(void)
+{
+  return true;
+}
+
+
+// ---------------------------------------------------------------------------
+// qspi
+// ---------------------------------------------------------------------------
+bool qspiInit(void)
+{
+  return true;
+}
+
+bool qspiIsInit(void)
+{
+  return true;
+}
+
+bool qspiRead(uint32_t addr, uint8_t *p_data, uint32_t length)
+{
+  if (addr + length > SIM_QSPI_SIZE)
+  {
+    return false;
+  }
+  memcpy(p_data, &sim_qspi[addr], length);
+  sim_time_us           += SIM_QSPI_READ_US;
+  sim_qspi_stat.busy_us += SIM_QSPI_READ_US;
+  return true;
+}
+
+bool qspiWrite(uint32_t addr, uint8_t *p_data, uint32_t length)
+{
+  uint32_t us;
+
+  if (addr + length > SIM_QSPI_SIZE || length == 0)
+  {
+    return false;
+  }
+  for (uint32_t i=0; i<length; i++)
+  {
+    if ((p_data[i] & ~sim_qspi[addr + i]) != 0)
+    {
+      sim_qspi_stat.violate_cnt++;                                  // 지우지 않은 자리에 1 비트를 쓰려 함
+    }
+    sim_qspi[addr + i] &= p_data[i];
+  }
+  us = SIM_QSPI_PROG_US + (length - 1U) * SIM_QSPI_PROG_BYTE_NS / 1000U;
+  sim_time_us                 += us;
+  sim_qspi_stat.busy_us       += us;
+  sim_qspi_stat.program_cnt++;
+  sim_qspi_stat.program_bytes += length;
+  return true;
+}
+
+bool qspiEraseBlock(uint32_t block_addr)
+{
+  uint32_t sector = block_addr / SIM_QSPI_SECTOR;
+
+  if (block_addr >= SIM_QSPI_SIZE)
+  {
+    return false;
+  }
+  memset(&sim_qspi[sector * SIM_QSPI_SECTOR], 0xFF, SIM_QSPI_SECTOR);
+  sim_qspi_erase[sector]++;
+  if (sim_qspi_erase[sector] > sim_qspi_stat.erase_max)
+  {
+    sim_qspi_stat.erase_max = sim_qspi_erase[sector];
+  }
+  sim_time_us           += SIM_QSPI_ERASE_US;
+  sim_qspi_stat.busy_us += SIM_QSPI_ERASE_US;
+  sim_qspi_stat.erase_cnt++;
+  return true;
+}
+
+uint32_t qspiGetLength(void)
+{
+  return SIM_QSPI_SIZE;
+}
+
+
+// ---------------------------------------------------------------------------
+// reset
+// ---------------------------------------------------------------------------
+void resetToBoot(void)
+{
+  logPrintf("[sim] resetToBoot()\n");
+}
+
+void resetToReset(void)
+{
+  logPrintf("[sim] resetToReset()\n");
+}
+
+void resetSetBootMode(uint32_t data)
+{
+  (void)data;
+}
+
+
+// ---------------------------------------------------------------------------
+// ws2812
+// ---------------------------------------------------------------------------
+void ws2812SetColor(uint32_t ch, uint32_t color)
+{
+  (void)ch;
+  (void)color;
+}
+
+bool ws2812Refresh(void)
+{
+  return true;
+}
+
+
+// ---------------------------------------------------------------------------
+// usb / usb_hid
+// ---------------------------------------------------------------------------
+bool usbIsSuspended(void)
+{
+  return sim_suspended;
+}
+
+uint32_t usbGetBootReportMs(void)
+{
+  for (uint32_t i=0; i<sim_report_cnt; i++)
+  {
+    if (sim_report_log[i].ep == SIM_EP_KEYBOARD)
+    {
+      uint32_t ms = sim_report_log[i].time_us / 1000U;
+
+      return ms > 0 ? ms : 1;                                      // V261019R5: 리포트 로그 기준 첫 키보드 리포트
+    }
+  }
+  return 0;
+}
+
+bool usbHidSetViaReceiveFunc(bool (*func)(uint8_t *, uint8_t))
+{
+  sim_via_receive_func = func;
+  return true;
+}
+
+bool usbHidEnqueueViaResponse(const uint8_t *p_data, uint8_t length)
+{
+  if (sim_via_poll_us > 0)
+  {
+    return usbHidViaPush(&sim_via, p_data, length, millis());       // V261018R6: 펌웨어와 같은 큐/게이트
+  }
+  sim_report_push(SIM_EP_VIA, p_data, length);
+  return true;
+}
+
+bool usbHidSendReport(uint8_t *p_data, uint16_t length)
+{
+  if (sim_wakeup_hold(SIM_EP_KEYBOARD, p_data, length) == true)     // V261019R1
+  {
+    return true;
+  }
+  return sim_hid_send_kbd(p_data, length);
+}
+
+static bool sim_hid_send_kbd(uint8_t *p_data, uint16_t length)
+{
+  if (sim_usb_drop_report() == true)                                // V261018R8
+  {
+    return false;
+  }
+  if (sim_hid_poll_us == 0)
+  {
+    sim_report_push(SIM_EP_KEYBOARD, p_data, length);
+    return true;
+  }
+
+  // V261021R4: 펌웨어 usbHidSendReportNow() 와 같은 usbHidTxKeyboard(). TIM2 카운터 = SOF 기준 오프셋
+  sim_hid_run_isr();
+  usbHidTxKeyboard(&sim_hid_tx, p_data, length, (uint32_t)sim_time_us, (uint32_t)(sim_time_us % sim_hid_sof_us));
+  return true;
+}
+
+bool usbHidSendReportEXK(uint8_t *p_data, uint16_t length)
+{
+  if (sim_wakeup_hold(SIM_EP_EXK, p_data, length) == true)          // V261019R1
+  {
+    return true;
+  }
+  return sim_hid_send_exk(p_data, length);
+}
+
+static bool sim_hid_send_exk(uint8_t *p_data, uint16_t length)
+{
+  if (sim_usb_drop_report() == true)                                // V261018R8
+  {
+    return false;
+  }
+  if (sim_hid_poll_us == 0)
+  {
+    sim_report_push(SIM_EP_EXK, p_data, length);
+    return true;
+  }
+
+  sim_hid_run_isr();
+  usbHidTxExk(&sim_hid_tx, p_data, length);                        // V261021R4
+  return true;
+}
+
+bool usbHidSendReportNKRO(uint8_t *p_data, uint16_t length)
+{
+  if (sim_wakeup_hold(SIM_EP_NKRO, p_data, length) == true)         // V261019R1
+  {
+    return true;
+  }
+  return sim_hid_send_nkro(p_data, length);
+}
+
+static bool sim_hid_send_nkro(uint8_t *p_data, uint16_t length)
+{
+  if (sim_usb_drop_report() == true)                                // V261018R8
+  {
+    return false;
+  }
+  if (sim_hid_poll_us == 0)
+  {
+    sim_report_push(SIM_EP_NKRO, p_data, length);
+    return true;
+  }
+
+  sim_hid_run_isr();
+  usbHidTxNkro(&sim_hid_tx, p_data, length);                       // V261021R4: 폴링 모델에서는 NKRO EP 도 대기열을 거친다
+  return true;
+}
+
+bool usbHidGetRateInfo(usb_hid_rate_info_t *p_info)
+{
+  memset(p_info, 0, sizeof(usb_hid_rate_info_t));
+  return true;
+}
+
+bool usbHidGetQueueInfo(usb_hid_queue_info_t *p_info)
+{
+  usbHidCoalesceGetInfo(&sim_hid_tx.kbd_q, p_info, (uint32_t)sim_time_us);
+  return true;
+}
+
+#ifdef BOOTMODE_ENABLE
+UsbBootMode_t usbBootModeGet(void)
+{
+  return USB_BOOT_MODE_HS_8K;
+}
+
+void usbBootModeApplyDefaults(void)
+{
+}
+
+bool usbBootModeScheduleApply(UsbBootMode_t mode)
+{
+  (void)mode;
+  return true;
+}
+
+bool usbScheduleGraceReset(uint32_t delay_ms)
+{
+  (void)delay_ms;
+  return true;
+}
+#endif
+
+#ifdef USB_MONITOR_ENABLE
+bool usbInstabilityIsEnabled(void)
+{
+  return false;
+}
+
+bool usbInstabilityStore(bool enable)
+{
+  (void)enable;
+  return true;
+}
+#endif
@@ -0,0 +1,3886 @@
+#include "sim.h"
+
+
+#include "quantum.h"
+#include "debounce_profile.h"
+#include "via.h"
+#include "idle.h"
+#include "usbd_hid_coalesce.h"
+#include "dynamic_keymap.h"
+#include "bulk_sync.h"
+#include "util_core.h"
+#include "usbd_def.h"
+#include "usbd_hid_sof_mon.h"
+#include "nkro.h"
+
+
+// ---------------------------------------------------------------------------
+// [Host Sim] V261017R1
+//   - 시나리오: 가상 시계로 키 입력을 주입하고 HID 리포트 타임스탬프로 지연을 검증
+//   - 벤치마크: qmkUpdate() 1회당 호스트 실행 시간을 측정해 커밋 간 파이프라인 비용을 비교
+// ---------------------------------------------------------------------------
+#define SIM_LOOP_STEP_US          10                  // qmkUpdate() 1회가 소모하는 가상 시간
+#define SIM_BOOT_SETTLE_US        100000              // 부팅 직후 EEPROM 초기화/지연 처리 안정화 구간
+#define SIM_LATENCY_SLACK_US      2000                // 디바운스 이후 허용되는 추가 지연
+#define SIM_IDLE_EDGE_MAX         400                 // V261017R5: idle 시나리오 무작위 엣지 수
+#define SIM_IDLE_KEY_MAX          4
+#define SIM_IDLE_DB_TRIALS        16                  // V261019R9: idle_debounce 시나리오 탭 횟수 (1ms tick 대비 위상을 바꿔 가며)
+#define SIM_IDLE_DB_TICKS         4                   // V261019R9: 125us 단위 defer 지연 (500us)
+#define SIM_EDGE_KEY_MAX          4                   // V261017R8: edge 시나리오 키 수
+#define SIM_EDGE_GAP_US           130                 // V261017R8: 키 사이 간격 (프레임 주기보다 길고 1ms 보다 짧게)
+#define SIM_EDGE_LOG_MAX          64
+#define SIM_NKRO_KEY_MAX          12                  // V261018R1: 6KRO 한도(HW_KEYS_PRESS_MAX)를 넘는 동시 입력 수
+#define SIM_COALESCE_KEY_MAX      8                   // V261018R2: 롤 키 수
+#define SIM_COALESCE_POLL_US      1000                // V261018R2: FS 1ms 폴링
+#define SIM_EP_STATE_POLL_US      125                 // V261018R3: HS 8kHz 폴링
+#define SIM_JIT_POLL_US           1000                // V261018R4: FS 1ms 프레임 (프레임 안 변경이 많아 차이가 크게 보임)
+#define SIM_JIT_PHASE_US          600                 // V261018R4: 호스트 IN 토큰 위상
+#define SIM_JIT_JITTER_US         20
+#define SIM_JIT_HS4K_POLL_US      250                 // V261021R5: HS 4K 부트 모드 (bInterval 2, 마이크로프레임 2개마다 폴링)
+#define SIM_JIT_HS4K_PHASE_US     205                 // 홀수 마이크로프레임 + 80us (SOF 기준 위상 80us)
+#define SIM_JIT_HS4K_JITTER_US    5
+#define SIM_VIA_POLL_US           125                 // V261018R6: VIA EP HS 폴링
+#define SIM_VIA_CHUNK             28                  // V261018R6: id_dynamic_keymap_get_buffer 1회 최대 크기
+#define SIM_VIA_HOST_WINDOW       8                   // V261018R6: 응답을 기다리지 않고 보내는 호스트 요청 수
+#define SIM_BULK_REQ_MAX          512                 // V261018R7: 한 번에 주고받는 VIA 요청 수
+#define SIM_REENUM_GRACE_MS       40                  // V261018R8: usb.c USB_BOOTMODE_APPLY_GRACE_MS
+#define SIM_REENUM_DETACH_MS      100                 // V261018R8: usb.c USB_RESET_DETACH_DELAY_MS
+#define SIM_REENUM_ENUM_US        50000               // V261018R8: 호스트 열거 시간 모델 (재접속 → CONFIGURED)
+#define SIM_SOF_TRACE_MAX         300000              // V261018R9: 기록 SOF 트레이스 최대 샘플 수 (HS 30s 약 24만)
+#define SIM_SOF_LOG_MAX           64                  // V261018R9: 다운그레이드 판정 기록 수
+#define SIM_SOF_BENCH_BLOCK       32                  // V261018R9: ISR 비용 측정 시 한 번에 재는 SOF 수
+#define SIM_SOF_MODE_REF          0                   // V261020R7: V261018R8 ISR 평가 동결 사본 (sim_sof_ref.c)
+#define SIM_SOF_MODE_ISR          1                   // usbd_hid_sof_mon.c ISR 평가
+#define SIM_SOF_MODE_BATCH        2                   // usbd_hid_sof_mon.c 일괄 평가
+#define SIM_SOF_MODE_MAX          3
+#define SIM_WAKEUP_RESUME_US      21000               // V261019R1: 깨우기 시작 → 호스트 재개 (K 1ms 안 + 재개 구동 20ms)
+#define SIM_WAKEUP_TAP_US         8000                // V261019R1: 깨우는 키 탭 길이 (K 상태 10ms 보다 짧게)
+#define SIM_LATENCY_KEY_MAX       4                   // V261019R2: latency 시나리오 키 수
+#define SIM_LATENCY_TAPS          16                  // V261019R2: 탭 수 (press/release 각각 샘플 1개)
+#define SIM_LATENCY_POLL_US       1000                // V261019R2: FS 1ms 폴링
+#define SIM_EEPROM_PAGE           32                  // V261019R3: platforms/eeprom.c 캐시 페이지
+#define SIM_EEPROM_TWR_US         5000                // V261019R3: ZD24C128 쓰기 주기 tWR (최대)
+#define SIM_EEPROM_VIA_CHUNK      28                  // V261019R3: id_dynamic_keymap_set_buffer 1회 최대 크기
+#define SIM_EEPROM_TAP_DELAY_US   3000                // V261019R4: 키맵 기록 시작 → 탭 누름
+#define SIM_EEPROM_TAP_US         20000               // V261019R4: 기록 중 탭 길이
+#define SIM_EEPROM_LOAD_US        100000              // V261019R5: 백그라운드 적재 완료 대기 상한
+#define SIM_WL_I2C_CHANGES        200                 // V261019R6: I2C 경로 변경 횟수 (페이지 쓰기 비율 측정)
+#define SIM_WL_CHANGES            3000                // V261019R6: 플래시 경로 변경 횟수 (정리 여러 번)
+#define SIM_WL_I2C_GAP_US         6000                // V261019R6: 변경 간격 (tWR 5ms 가 끝나도록)
+#define SIM_WL_GAP_US             200                 // V261019R6: 변경 간격 (구간 기록은 루프 한 번)
+#define SIM_KEYCACHE_ROUNDS       256                 // V261019R7: 무작위 레이어 상태/키맵 쓰기 비교 횟수
+#define SIM_KEYCACHE_BENCH_PASS   2000                // V261019R7: 전체 위치 조회 반복 수 (실행 시간 측정)
+#define SIM_WL_EEPROM_CYCLES      1000000UL           // V261019R6: I2C EEPROM 페이지 쓰기 수명
+#define SIM_WL_FLASH_CYCLES       100000UL            // V261019R6: W25Q16 서브섹터 지우기 수명
+
+
+typedef struct
+{
+  const char *name;
+  bool      (*func)(void);
+  const char *desc;
+} sim_scenario_t;
+
+// 런타임 엔진을 거치지 않고 커널을 직접 구동하기 위한 선언 (quantum/debounce/*.c)
+typedef struct
+{
+  const char             *name;
+  debounce_runtime_type_t type;
+  bool                  (*pk_init)(uint8_t num_rows);
+  bool                  (*pk_run)(matrix_row_t raw[], matrix_row_t cooked[], uint8_t num_rows, bool changed);
+  void                  (*pk_free)(void);
+  bool                  (*bs_init)(uint8_t num_rows);
+  bool                  (*bs_run)(matrix_row_t raw[], matrix_row_t cooked[], uint8_t num_rows, bool changed);
+  void                  (*bs_free)(void);
+} sim_debounce_pair_t;
+
+// V261017R8: pre_process_record_user() 에서 기록한 키 이벤트
+typedef struct
+{
+  keypos_t key;
+  bool     pressed;
+  uint16_t time;
+  bool     has_time_us;                               // V261020R2
+  uint32_t time_us;
+} sim_edge_log_t;
+
+bool debounce_sym_defer_pk_init(uint8_t num_rows);
+bool debounce_sym_defer_pk_run(matrix_row_t raw[], matrix_row_t cooked[], uint8_t num_rows, bool changed);
+void debounce_sym_defer_pk_free(void);
+bool debounce_sym_eager_pk_init(uint8_t num_rows);
+bool debounce_sym_eager_pk_run(matrix_row_t raw[], matrix_row_t cooked[], uint8_t num_rows, bool changed);
+void debounce_sym_eager_pk_free(void);
+bool debounce_asym_eager_defer_pk_init(uint8_t num_rows);
+bool debounce_asym_eager_defer_pk_run(matrix_row_t raw[], matrix_row_t cooked[], uint8_t num_rows, bool changed);
+void debounce_asym_eager_defer_pk_free(void);
+bool debounce_sym_defer_bs_init(uint8_t num_rows);
+bool debounce_sym_defer_bs_run(matrix_row_t raw[], matrix_row_t cooked[], uint8_t num_rows, bool changed);
+void debounce_sym_defer_bs_free(void);
+bool debounce_sym_eager_bs_init(uint8_t num_rows);
+bool debounce_sym_eager_bs_run(matrix_row_t raw[], matrix_row_t cooked[], uint8_t num_rows, bool changed);
+void debounce_sym_eager_bs_free(void);
+bool debounce_asym_eager_defer_bs_init(uint8_t num_rows);
+bool debounce_asym_eager_defer_bs_run(matrix_row_t raw[], matrix_row_t cooked[], uint8_t num_rows, bool changed);
+void debounce_asym_eager_defer_bs_free(void);
+
+
+static bool sim_scenario_tap(void);
+static bool sim_scenario_roll(void);
+static bool sim_scenario_bench(void);
+static bool sim_scenario_debounce_us(void);
+static bool sim_scenario_debounce_bs(void);
+static bool sim_scenario_idle(void);
+static bool sim_scenario_idle_debounce(void);
+static bool sim_scenario_oversample(void);
+static bool sim_scenario_edge(void);
+static bool sim_scenario_nkro(void);
+static bool sim_scenario_coalesce(void);
+static bool sim_scenario_ep_state(void);
+static bool sim_scenario_jit(void);
+static bool sim_scenario_via_pipe(void);
+static bool sim_scenario_via_bulk(void);
+static bool sim_scenario_reenum(void);
+static bool sim_scenario_sof_batch(void);
+static bool sim_scenario_wakeup(void);
+static bool sim_scenario_latency(void);
+static bool sim_scenario_eeprom_cache(void);
+static bool sim_scenario_eeprom_async(void);
+static bool sim_scenario_eeprom_boot(void);
+static bool sim_scenario_eeprom_wl(void);
+static bool sim_scenario_keycache(void);
+
+
+static const sim_scenario_t sim_scenarios[] =
+{
+  {"tap",         sim_scenario_tap,         "단일 키 탭 press/release 지연 검증"},
+  {"roll",        sim_scenario_roll,        "5키 롤 입력 순서/누락 검증"},
+  {"bench",       sim_scenario_bench,       "qmkUpdate() 호스트 실행 시간 측정"},
+  {"debounce_us", sim_scenario_debounce_us, "125us 단위 eager 디바운스 지연/채터 억제 검증"},
+  {"debounce_bs", sim_scenario_debounce_bs, "비트 평면 디바운스 커널의 pk 동등성/실행 시간 비교"},
+  {"idle",        sim_scenario_idle,        "이벤트 구동 WFI 루프의 엣지 누락/깨움 지연 검증"},
+  {"idle_debounce", sim_scenario_idle_debounce, "WFI 활성 상태에서 125us defer 디바운스 만료가 1ms tick 에 묶이지 않는지 검증"},
+  {"oversample",  sim_scenario_oversample,  "오버샘플 축약 커널 검증 및 단일 스윕 잡음 제거 확인"},
+  {"edge",        sim_scenario_edge,        "키별 엣지 시각(us)의 keyevent_t 전달과 sub-ms 순서 보존 검증"},
+  {"nkro",        sim_scenario_nkro,        "VIA NKRO 토글, 6KRO 초과 동시 입력, Boot 프로토콜 폴백 검증"},
+  {"coalesce",    sim_scenario_coalesce,    "EP busy 중 리포트 병합 큐의 엣지 보존/대기 시간 상한 검증"},
+  {"ep_state",    sim_scenario_ep_state,    "미디어 키 연속 입력 중 키보드 리포트 대기 시간 (EP 별 busy vs 공유)"},
+  {"jit",         sim_scenario_jit,         "SOF 위상 학습/폴백과 JIT 적재의 변경→IN 지연 감소 검증"},
+  {"via_pipe",    sim_scenario_via_pipe,    "VIA 키맵 전체 읽기 처리량 (20ms 게이트 vs 파이프라인)"},
+  {"via_bulk",    sim_scenario_via_bulk,    "압축 일괄 전송 전체 프로필 동기화 시간/내용과 차분 적용 EEPROM 기록량 검증"},
+  {"reenum",      sim_scenario_reenum,      "리셋 없는 USB 재열거 후 눌린 키 재전송과 첫 리포트까지 시간 검증"},
+  {"sof_batch",   sim_scenario_sof_batch,   "SOF 감시 일괄 평가의 판정 동등성(기록 트레이스)과 ISR 비용 비교"},
+  {"wakeup",      sim_scenario_wakeup,      "서스펜드 중 탭의 비차단 원격 깨우기와 재개 후 press/release 재전송 검증"},
+  {"latency",     sim_scenario_latency,     "캡처 → IN 완료 구간별 지연 히스토그램의 샘플 수/구간 합/VIA 조회 검증"},
+  {"eeprom_cache", sim_scenario_eeprom_cache, "EEPROM 더티 페이지 캐시의 전체 키맵 기록 페이지 수/병합/미러 일치 검증"},
+  {"eeprom_async", sim_scenario_eeprom_async, "전체 키맵 기록 중 비차단 페이지 쓰기의 루프 정지/탭 지연 비교"},
+  {"eeprom_boot",  sim_scenario_eeprom_boot,  "EEPROM 우선/지연 적재의 첫 리포트까지 시간, 백그라운드 적재 미러 일치, 미적재 접근 비교"},
+  {"eeprom_wl",    sim_scenario_eeprom_wl,    "고빈도 설정 플래시 로그의 I2C 쓰기 제거/정리/수명과 재적재 후 값 유지 검증"},
+  {"keycache",     sim_scenario_keycache,     "레이어 상태 기준 해석 키맵 캐시의 결과 동등성/부분 무효화/조회 비용과 레이어 키 입력 검증"},
+};
+
+
+
+
+static bool sim_report_has_usage(const sim_report_t *p_report, uint8_t usage)
+{
+  const report_keyboard_t *p_kbd = (const report_keyboard_t *)p_report->data;
+
+  if (IS_MODIFIER_KEYCODE(usage))
+  {
+    return (p_kbd->mods & MOD_BIT(usage)) != 0;
+  }
+
+  for (uint32_t i=0; i<KEYBOARD_REPORT_KEYS; i++)
+  {
+    if (p_kbd->keys[i] == usage)
+    {
+      return true;
+    }
+  }
+  return false;
+}
+
+static bool sim_report_is_empty(const sim_report_t *p_report)
+{
+  const report_keyboard_t *p_kbd = (const report_keyboard_t *)p_report->data;
+
+  if (p_kbd->mods != 0)
+  {
+    return false;
+  }
+  for (uint32_t i=0; i<KEYBOARD_REPORT_KEYS; i++)
+  {
+    if (p_kbd->keys[i] != 0)
+    {
+      return false;
+    }
+  }
+  return true;
+}
+
+// from 이후 첫 키보드 리포트 중 usage 상태가 pressed 와 일치하는 항목을 찾는다.
+static int32_t sim_find_report(uint32_t from, uint8_t usage, bool pressed)
+{
+  for (uint32_t i=from; i<simGetReportCount(); i++)
+  {
+    const sim_report_t *p_report = simGetReport(i);
+
+    if (p_report->ep != SIM_EP_KEYBOARD)
+    {
+      continue;
+    }
+    if (sim_report_has_usage(p_report, usage) == pressed)
+    {
+      return (int32_t)i;
+    }
+  }
+  return -1;
+}
+
+// 보드별 키맵이 다르므로 레이어 0에서 알파벳 키 위치를 행 우선으로 골라 사용한다.
+static uint32_t sim_pick_alpha_keys(keypos_t *p_pos, uint8_t *p_usage, uint32_t count)
+{
+  uint32_t found = 0;
+
+  for (uint8_t row=0; row<MATRIX_ROWS && found<count; row++)
+  {
+    for (uint8_t col=0; col<MATRIX_COLS && found<count; col++)
+    {
+      keypos_t key     = {.row = row, .col = col};
+      uint16_t keycode = keymap_key_to_keycode(0, key);
+
+      if (keycode >= KC_A && keycode <= KC_Z)
+      {
+        p_pos[found]   = key;
+        p_usage[found] = (uint8_t)keycode;
+        found++;
+      }
+    }
+  }
+  return found;
+}
+
+static uint32_t sim_latency_limit_us(void)
+{
+  const debounce_profile_values_t *profile = debounce_profile_current();
+  uint32_t delay   = profile->pre_ms > profile->post_ms ? profile->pre_ms : profile->post_ms;
+  uint32_t unit_us = profile->unit == DEBOUNCE_RUNTIME_UNIT_125US ? DEBOUNCE_RUNTIME_TICK_US : 1000U;
+
+  return delay * unit_us + SIM_LATENCY_SLACK_US;
+}
+
+// VIA KEY RESPONSE 채널(14)로 디바운스 값을 설정하고 메인 루프가 처리할 시간을 준다.
+static void sim_via_set_debounce(uint8_t value_id, uint8_t value)
+{
+  uint8_t packet[32] = {id_custom_set_value, id_qmk_key_response, value_id, value};
+
+  simViaSend(packet, sizeof(packet));
+  simRunUs(1000, SIM_LOOP_STEP_US);
+}
+
+static uint32_t sim_count_reports(uint32_t from, uint8_t usage, bool pressed)
+{
+  uint32_t cnt  = 0;
+  bool     prev = !pressed;
+
+  for (uint32_t i=from; i<simGetReportCount(); i++)
+  {
+    const sim_report_t *p_report = simGetReport(i);
+
+    if (p_report->ep != SIM_EP_KEYBOARD)
+    {
+      continue;
+    }
+
+    bool cur = sim_report_has_usage(p_report, usage);
+    if (cur == pressed && prev != pressed)
+    {
+      cnt++;
+    }
+    prev = cur;
+  }
+  return cnt;
+}
+
+bool sim_scenario_tap(void)
+{
+  keypos_t key;
+  uint8_t  usage;
+  bool     ret = true;
+
+  if (sim_pick_alpha_keys(&key, &usage, 1) != 1)
+  {
+    printf("  no alpha key in layer 0\n");
+    return false;
+  }
+
+  simRunUs(SIM_BOOT_SETTLE_US, SIM_LOOP_STEP_US);
+  simClearReports();
+
+  uint32_t press_us = simGetTimeUs();
+  simSetKey(key.row, key.col, true);
+  simRunUs(30000, SIM_LOOP_STEP_US);
+
+  uint32_t release_us = simGetTimeUs();
+  simSetKey(key.row, key.col, false);
+  simRunUs(30000, SIM_LOOP_STEP_US);
+
+  int32_t press_idx   = sim_find_report(0, usage, true);
+  int32_t release_idx = press_idx < 0 ? -1 : sim_find_report((uint32_t)press_idx + 1, usage, false);
+
+  if (press_idx < 0 || release_idx < 0)
+  {
+    printf("  press/release report missing (press %d, release %d)\n", press_idx, release_idx);
+    return false;
+  }
+
+  uint32_t press_lat   = simGetReport((uint32_t)press_idx)->time_us - press_us;
+  uint32_t release_lat = simGetReport((uint32_t)release_idx)->time_us - release_us;
+  uint32_t limit       = sim_latency_limit_us();
+
+  printf("  press   latency : %lu us\n", (unsigned long)press_lat);
+  printf("  release latency : %lu us\n", (unsigned long)release_lat);
+  printf("  reports         : %lu\n", (unsigned long)simGetReportCount());
+
+  if (press_lat > limit || release_lat > limit)
+  {
+    printf("  latency exceeds %lu us\n", (unsigned long)limit);
+    ret = false;
+  }
+  if (sim_report_is_empty(simGetReport(simGetReportCount() - 1)) != true)
+  {
+    printf("  last report is not empty\n");
+    ret = false;
+  }
+  return ret;
+}
+
+bool sim_scenario_roll(void)
+{
+  const uint32_t gap_us      = 3000;
+  const uint32_t hold_us     = 20000;
+  const uint32_t key_cnt     = 5;
+  keypos_t       keys[5];
+  uint8_t        usages[5];
+  uint32_t       press_us[5];
+  uint32_t       latency_max = 0;
+  uint32_t       latency_sum = 0;
+  bool           ret         = true;
+
+  if (sim_pick_alpha_keys(keys, usages, key_cnt) != key_cnt)
+  {
+    printf("  not enough alpha keys in layer 0\n");
+    return false;
+  }
+
+  simRunUs(SIM_BOOT_SETTLE_US, SIM_LOOP_STEP_US);
+  simClearReports();
+
+  uint32_t start_us = simGetTimeUs();
+
+  // 각 키를 gap_us 간격으로 누르고 hold_us 뒤에 뗀다.
+  while (simGetTimeUs() - start_us < gap_us * key_cnt + hold_us + 30000U)
+  {
+    uint32_t elapsed = simGetTimeUs() - start_us;
+
+    for (uint32_t i=0; i<key_cnt; i++)
+    {
+      uint32_t down_at = gap_us * i;
+
+      if (elapsed == down_at)
+      {
+        press_us[i] = simGetTimeUs();
+        simSetKey(keys[i].row, keys[i].col, true);
+      }
+      if (elapsed == down_at + hold_us)
+      {
+        simSetKey(keys[i].row, keys[i].col, false);
+      }
+    }
+    simRunUs(SIM_LOOP_STEP_US, SIM_LOOP_STEP_US);
+  }
+
+  int32_t prev_idx = -1;
+
+  for (uint32_t i=0; i<key_cnt; i++)
+  {
+    int32_t press_idx = sim_find_report(0, usages[i], true);
+
+    if (press_idx < 0)
+    {
+      printf("  key %lu press report missing\n", (unsigned long)i);
+      ret = false;
+      continue;
+    }
+    if (press_idx < prev_idx)
+    {
+      printf("  key %lu reported out of order\n", (unsigned long)i);
+      ret = false;
+    }
+    if (sim_find_report((uint32_t)press_idx + 1, usages[i], false) < 0)
+    {
+      printf("  key %lu release report missing\n", (unsigned long)i);
+      ret = false;
+    }
+
+    uint32_t latency = simGetReport((uint32_t)press_idx)->time_us - press_us[i];
+
+    latency_sum += latency;
+    if (latency > latency_max)
+    {
+      latency_max = latency;
+    }
+    prev_idx = press_idx;
+  }
+
+  printf("  press latency   : avg %lu us, max %lu us\n",
+         (unsigned long)(latency_sum / key_cnt),
+         (unsigned long)latency_max);
+  printf("  reports         : %lu\n", (unsigned long)simGetReportCount());
+
+  if (latency_max > sim_latency_limit_us())
+  {
+    printf("  latency exceeds %lu us\n", (unsigned long)sim_latency_limit_us());
+    ret = false;
+  }
+  if (simGetReportCount() == 0 || sim_report_is_empty(simGetReport(simGetReportCount() - 1)) != true)
+  {
+    printf("  last report is not empty\n");
+    ret = false;
+  }
+  return ret;
+}
+
+bool sim_scenario_bench(void)
+{
+  const uint32_t idle_us   = 1000000;
+  const uint32_t typing_us = 1000000;
+  keypos_t       keys[10];
+  uint8_t        usages[10];
+  uint32_t       key_cnt   = sim_pick_alpha_keys(keys, usages, 10);
+
+  if (key_cnt == 0)
+  {
+    printf("  no alpha key in layer 0\n");
+    return false;
+  }
+
+  simRunUs(SIM_BOOT_SETTLE_US, SIM_LOOP_STEP_US);
+
+  uint64_t cnt_begin = simGetUpdateCount();
+  uint64_t ns_begin  = simGetUpdateHostNs();
+
+  simRunUs(idle_us, SIM_LOOP_STEP_US);
+
+  uint64_t idle_cnt = simGetUpdateCount() - cnt_begin;
+  uint64_t idle_ns  = simGetUpdateHostNs() - ns_begin;
+
+  cnt_begin = simGetUpdateCount();
+  ns_begin  = simGetUpdateHostNs();
+
+  simClearReports();
+
+  // 20ms 마다 한 키씩 10ms 눌렀다 떼는 연속 타이핑 부하 (디바운스 구간보다 길게 유지)
+  for (uint32_t t=0; t<typing_us; t+=20000)
+  {
+    keypos_t key = keys[(t / 20000) % key_cnt];
+
+    simSetKey(key.row, key.col, true);
+    simRunUs(10000, SIM_LOOP_STEP_US);
+    simSetKey(key.row, key.col, false);
+    simRunUs(10000, SIM_LOOP_STEP_US);
+  }
+
+  uint64_t typing_cnt = simGetUpdateCount() - cnt_begin;
+  uint64_t typing_ns  = simGetUpdateHostNs() - ns_begin;
+
+  printf("  idle   : %llu updates, %llu ns/update\n",
+         (unsigned long long)idle_cnt,
+         (unsigned long long)(idle_cnt ? idle_ns / idle_cnt : 0));
+  printf("  typing : %llu updates, %llu ns/update, %lu reports\n",
+         (unsigned long long)typing_cnt,
+         (unsigned long long)(typing_cnt ? typing_ns / typing_cnt : 0),
+         (unsigned long)simGetReportCount());
+  return true;
+}
+
+bool sim_scenario_debounce_us(void)
+{
+  const uint32_t bounce_us = 250;                     // 접점 채터 간격 (2틱)
+  keypos_t       key;
+  uint8_t        usage;
+  bool           ret = true;
+
+  if (sim_pick_alpha_keys(&key, &usage, 1) != 1)
+  {
+    printf("  no alpha key in layer 0\n");
+    return false;
+  }
+
+  simRunUs(SIM_BOOT_SETTLE_US, SIM_LOOP_STEP_US);
+
+  // Fast(eager) + 125us 단위, 변화 후 잠금 구간 2ms(16틱)
+  sim_via_set_debounce(id_qmk_debounce_mode, DEBOUNCE_RUNTIME_TYPE_SYM_EAGER_PK);
+  sim_via_set_debounce(id_qmk_debounce_unit, DEBOUNCE_RUNTIME_UNIT_125US);
+  sim_via_set_debounce(id_qmk_debounce_time_post, 16);
+
+  const debounce_profile_values_t *profile = debounce_profile_current();
+  if (profile->unit != DEBOUNCE_RUNTIME_UNIT_125US || profile->post_ms != 16)
+  {
+    printf("  VIA debounce unit/post not applied (unit %d, post %d)\n", profile->unit, profile->post_ms);
+    debounce_profile_restore_defaults();
+    return false;
+  }
+  simClearReports();
+
+  // press 직후 1ms 동안 채터를 주고 눌린 상태로 유지한다.
+  uint32_t press_us = simGetTimeUs();
+  for (uint32_t i=0; i<4; i++)
+  {
+    simSetKey(key.row, key.col, (i % 2) == 0);
+    simRunUs(bounce_us, SIM_LOOP_STEP_US);
+  }
+  simSetKey(key.row, key.col, true);
+  simRunUs(20000, SIM_LOOP_STEP_US);
+
+  // release 직후에도 동일하게 채터를 준다.
+  uint32_t release_us = simGetTimeUs();
+  for (uint32_t i=0; i<4; i++)
+  {
+    simSetKey(key.row, key.col, (i % 2) != 0);
+    simRunUs(bounce_us, SIM_LOOP_STEP_US);
+  }
+  simSetKey(key.row, key.col, false);
+  simRunUs(20000, SIM_LOOP_STEP_US);
+
+  int32_t  press_idx   = sim_find_report(0, usage, true);
+  int32_t  release_idx = press_idx < 0 ? -1 : sim_find_report((uint32_t)press_idx + 1, usage, false);
+  uint32_t press_cnt   = sim_count_reports(0, usage, true);
+
+  debounce_profile_restore_defaults();                // 이후 시나리오에 영향이 없도록 보드 기본값 복구
+
+  if (press_idx < 0 || release_idx < 0)
+  {
+    printf("  press/release report missing (press %d, release %d)\n", press_idx, release_idx);
+    return false;
+  }
+
+  uint32_t press_lat   = simGetReport((uint32_t)press_idx)->time_us - press_us;
+  uint32_t release_lat = simGetReport((uint32_t)release_idx)->time_us - release_us;
+
+  printf("  press   latency : %lu us\n", (unsigned long)press_lat);
+  printf("  release latency : %lu us\n", (unsigned long)release_lat);
+  printf("  press reports   : %lu\n", (unsigned long)press_cnt);
+
+  if (press_lat >= 1000U)
+  {
+    printf("  eager press latency is not below 1 ms\n");
+    ret = false;
+  }
+  if (press_cnt != 1)
+  {
+    printf("  chatter produced extra press reports\n");
+    ret = false;
+  }
+  if (sim_report_is_empty(simGetReport(simGetReportCount() - 1)) != true)
+  {
+    printf("  last report is not empty\n");
+    ret = false;
+  }
+
+  // V261019R8: 30ms → 240틱 환산 값과 asym pk 7비트 카운터 한도(127틱)가 VIA 응답에 그대로 보여야 한다
+  sim_via_set_debounce(id_qmk_debounce_unit, DEBOUNCE_RUNTIME_UNIT_MS);
+  sim_via_set_debounce(id_qmk_debounce_mode, DEBOUNCE_RUNTIME_TYPE_SYM_DEFER_PK);
+  sim_via_set_debounce(id_qmk_debounce_time_single, 30);
+  sim_via_set_debounce(id_qmk_debounce_unit, DEBOUNCE_RUNTIME_UNIT_125US);
+  uint8_t sym_max = debounce_profile_current()->post_ms;
+  sim_via_set_debounce(id_qmk_debounce_mode, DEBOUNCE_RUNTIME_TYPE_ASYM_EAGER_DEFER_PK);
+  sim_via_set_debounce(id_qmk_debounce_time_post, 240);
+  uint8_t asym_max = debounce_profile_current()->post_ms;
+
+  printf("  125us range     : sym 30 ms -> %u, asym pk 240 -> %u (runtime %u)\n", sym_max, asym_max, debounce_runtime_release_delay());
+  if (sym_max != 240 || asym_max != 127 || debounce_runtime_release_delay() != asym_max)
+  {
+    printf("  debounce range clamp mismatch\n");
+    ret = false;
+  }
+
+  debounce_profile_restore_defaults();
+  return ret;
+}
+
+static uint32_t sim_rand(uint32_t *p_seed)
+{
+  uint32_t x = *p_seed;
+
+  x ^= x << 13;
+  x ^= x >> 17;
+  x ^= x << 5;
+  *p_seed = x;
+  return x;
+}
+
+// 동일한 채터 입력을 pk/bs 커널에 넣어 매 스캔 cooked 결과가 같은지 비교한다.
+static bool sim_debounce_pair_check(const sim_debounce_pair_t *p_pair, debounce_runtime_unit_t unit)
+{
+  const uint32_t            step_us  = 50;
+  const uint32_t            steps    = 40000;           // 2초
+  debounce_runtime_config_t config   = {.type = p_pair->type, .pre_ms = 3, .post_ms = 5, .unit = unit};
+  matrix_row_t              raw[MATRIX_ROWS]       = {0};
+  matrix_row_t              cooked_pk[MATRIX_ROWS] = {0};
+  matrix_row_t              cooked_bs[MATRIX_ROWS] = {0};
+  matrix_row_t              raw_prev[MATRIX_ROWS]  = {0};
+  uint32_t                  seed     = 0x12345678U;
+  uint64_t                  pk_ns    = 0;
+  uint64_t                  bs_ns    = 0;
+  uint32_t                  changes  = 0;
+  bool                      ret      = true;
+
+  if (unit == DEBOUNCE_RUNTIME_UNIT_125US)
+  {
+    config.pre_ms  = 12;
+    config.post_ms = 20;
+  }
+  debounce_runtime_apply_config(&config);              // 커널이 읽는 지연/단위만 설정
+
+  if (p_pair->pk_init(MATRIX_ROWS) != true || p_pair->bs_init(MATRIX_ROWS) != true)
+  {
+    printf("  %s init failed\n", p_pair->name);
+    return false;
+  }
+
+  for (uint32_t i=0; i<steps && ret; i++)
+  {
+    bool changed = false;
+
+    // 스텝마다 임의 키 하나를 뒤집고, 가끔 같은 행에 짧은 채터를 추가한다.
+    if ((sim_rand(&seed) % 8U) == 0U)
+    {
+      uint32_t r   = sim_rand(&seed);
+      uint8_t  row = (uint8_t)(r % MATRIX_ROWS);
+      uint8_t  col = (uint8_t)((r >> 8) % MATRIX_COLS);
+
+      raw[row] ^= ((matrix_row_t)1 << col);
+    }
+    for (uint8_t row=0; row<MATRIX_ROWS; row++)
+    {
+      changed |= (raw[row] != raw_prev[row]);
+      raw_prev[row] = raw[row];
+    }
+    changes += changed ? 1 : 0;
+
+    uint64_t t0 = simGetHostNs();
+    p_pair->pk_run(raw, cooked_pk, MATRIX_ROWS, changed);
+    uint64_t t1 = simGetHostNs();
+    p_pair->bs_run(raw, cooked_bs, MATRIX_ROWS, changed);
+    uint64_t t2 = simGetHostNs();
+
+    pk_ns += t1 - t0;
+    bs_ns += t2 - t1;
+
+    if (memcmp(cooked_pk, cooked_bs, sizeof(cooked_pk)) != 0)
+    {
+      printf("  %s mismatch at step %lu\n", p_pair->name, (unsigned long)i);
+      ret = false;
+    }
+    simAdvanceUs(step_us);
+  }
+
+  p_pair->pk_free();
+  p_pair->bs_free();
+
+  printf("  %-16s %-5s : pk %4llu ns/scan, bs %4llu ns/scan, %lu input changes\n",
+         p_pair->name,
+         unit == DEBOUNCE_RUNTIME_UNIT_125US ? "125us" : "1ms",
+         (unsigned long long)(pk_ns / steps),
+         (unsigned long long)(bs_ns / steps),
+         (unsigned long)changes);
+  return ret;
+}
+
+bool sim_scenario_debounce_bs(void)
+{
+  static const sim_debounce_pair_t pairs[] =
+  {
+    {"sym_defer",        DEBOUNCE_RUNTIME_TYPE_SYM_DEFER_PK,
+     debounce_sym_defer_pk_init, debounce_sym_defer_pk_run, debounce_sym_defer_pk_free,
+     debounce_sym_defer_bs_init, debounce_sym_defer_bs_run, debounce_sym_defer_bs_free},
+    {"sym_eager",        DEBOUNCE_RUNTIME_TYPE_SYM_EAGER_PK,
+     debounce_sym_eager_pk_init, debounce_sym_eager_pk_run, debounce_sym_eager_pk_free,
+     debounce_sym_eager_bs_init, debounce_sym_eager_bs_run, debounce_sym_eager_bs_free},
+    {"asym_eager_defer", DEBOUNCE_RUNTIME_TYPE_ASYM_EAGER_DEFER_PK,
+     debounce_asym_eager_defer_pk_init, debounce_asym_eager_defer_pk_run, debounce_asym_eager_defer_pk_free,
+     debounce_asym_eager_defer_bs_init, debounce_asym_eager_defer_bs_run, debounce_asym_eager_defer_bs_free},
+  };
+  bool ret = true;
+
+  simRunUs(SIM_BOOT_SETTLE_US, SIM_LOOP_STEP_US);
+
+  for (uint32_t i=0; i<sizeof(pairs)/sizeof(pairs[0]); i++)
+  {
+    ret &= sim_debounce_pair_check(&pairs[i], DEBOUNCE_RUNTIME_UNIT_MS);
+    ret &= sim_debounce_pair_check(&pairs[i], DEBOUNCE_RUNTIME_UNIT_125US);
+  }
+
+  debounce_profile_apply_current();                   // 키보드 경로의 런타임 설정 복구
+  return ret;
+}
+
+// 키 하나의 리포트 상태 전이 시각을 순서대로 모은다. (초기 상태 = 떼어짐)
+static uint32_t sim_collect_transitions(uint8_t usage, uint32_t *p_time, uint32_t max)
+{
+  uint32_t cnt  = 0;
+  bool     prev = false;
+
+  for (uint32_t i=0; i<simGetReportCount(); i++)
+  {
+    const sim_report_t *p_report = simGetReport(i);
+
+    if (p_report->ep != SIM_EP_KEYBOARD)
+    {
+      continue;
+    }
+
+    bool cur = sim_report_has_usage(p_report, usage);
+    if (cur != prev)
+    {
+      if (cnt < max)
+      {
+        p_time[cnt] = p_report->time_us;
+      }
+      cnt++;
+      prev = cur;
+    }
+  }
+  return cnt;
+}
+
+// V261017R5: 펌웨어와 같은 idleWait() 루프로 구동하며
+//   1) 입력이 없을 때 1ms tick 외에는 잠들어 있는지,
+//   2) 무작위 간격(프레임 미만 ~ 수 ms)의 엣지를 하나도 놓치지 않고 제한 지연 안에 리포트하는지 확인한다.
+bool sim_scenario_idle(void)
+{
+  static uint32_t edge_us[SIM_IDLE_KEY_MAX][SIM_IDLE_EDGE_MAX];
+  static uint32_t report_us[SIM_IDLE_EDGE_MAX];
+  const uint32_t  quiet_us    = 200000;
+  const bool      enable_prev = idleIsEnabled();
+  keypos_t        keys[SIM_IDLE_KEY_MAX];
+  uint8_t         usages[SIM_IDLE_KEY_MAX];
+  bool            state[SIM_IDLE_KEY_MAX]   = {false,};
+  uint32_t        edge_cnt[SIM_IDLE_KEY_MAX] = {0,};
+  uint32_t        edge_total  = 0;
+  uint32_t        seed        = 0x1D1E5EEDU;
+  uint32_t        latency_max = 0;
+  idle_info_t     info;
+  bool            ret = true;
+
+  if (sim_pick_alpha_keys(keys, usages, SIM_IDLE_KEY_MAX) != SIM_IDLE_KEY_MAX)
+  {
+    printf("  not enough alpha keys in layer 0\n");
+    return false;
+  }
+
+  simRunUs(SIM_BOOT_SETTLE_US, SIM_LOOP_STEP_US);
+  idleSetEnable(true);
+  idleClearInfo();
+
+  // 1) 입력 없음
+  uint64_t loops = simGetUpdateCount();
+
+  simRunIdleUs(quiet_us, SIM_LOOP_STEP_US);
+  loops = simGetUpdateCount() - loops;
+  idleGetInfo(&info);
+
+  printf("  quiet loops     : %lu in %lu ms (busy loop %lu)\n",
+         (unsigned long)loops,
+         (unsigned long)(quiet_us / 1000),
+         (unsigned long)(quiet_us / SIM_LOOP_STEP_US));
+  printf("  quiet sleep     : %lu %%\n", (unsigned long)(info.sleep_us / (quiet_us / 100)));
+
+  if (loops > quiet_us / 1000 + 2 || info.sleep_us < quiet_us * 9 / 10)
+  {
+    printf("  main loop did not stay asleep without events\n");
+    ret = false;
+  }
+
+  // 2) 무작위 엣지: 같은 키의 엣지 간격은 디바운스 지연 + 여유 이상으로 둔다.
+  const uint32_t hold_us = sim_latency_limit_us();
+  uint32_t       last_us[SIM_IDLE_KEY_MAX];
+
+  simClearReports();
+  idleClearInfo();
+  loops = simGetUpdateCount();
+
+  uint32_t start_us = simGetTimeUs();
+  for (uint32_t i=0; i<SIM_IDLE_KEY_MAX; i++)
+  {
+    last_us[i] = start_us - hold_us;
+  }
+
+  while (edge_total < SIM_IDLE_EDGE_MAX)
+  {
+    uint32_t k   = sim_rand(&seed) % SIM_IDLE_KEY_MAX;
+    uint32_t now = simGetTimeUs();
+
+    if (now - last_us[k] >= hold_us)
+    {
+      state[k] = !state[k];
+      simSetKey(keys[k].row, keys[k].col, state[k]);
+      edge_us[k][edge_cnt[k]++] = now;
+      last_us[k]                = now;
+      edge_total++;
+    }
+    simRunIdleUs(50 + sim_rand(&seed) % 3000, SIM_LOOP_STEP_US);
+  }
+
+  simRunIdleUs(hold_us, SIM_LOOP_STEP_US);
+  for (uint32_t k=0; k<SIM_IDLE_KEY_MAX; k++)
+  {
+    if (state[k])
+    {
+      simSetKey(keys[k].row, keys[k].col, false);
+      edge_us[k][edge_cnt[k]++] = simGetTimeUs();
+    }
+  }
+  simRunIdleUs(hold_us + 10000, SIM_LOOP_STEP_US);
+
+  uint32_t run_ms = (simGetTimeUs() - start_us) / 1000;
+
+  loops = simGetUpdateCount() - loops;
+  idleGetInfo(&info);
+
+  for (uint32_t k=0; k<SIM_IDLE_KEY_MAX; k++)
+  {
+    uint32_t cnt = sim_collect_transitions(usages[k], report_us, SIM_IDLE_EDGE_MAX);
+
+    if (cnt != edge_cnt[k])
+    {
+      printf("  key %lu : %lu edges injected, %lu reported\n",
+             (unsigned long)k,
+             (unsigned long)edge_cnt[k],
+             (unsigned long)cnt);
+      ret = false;
+      continue;
+    }
+    for (uint32_t i=0; i<cnt; i++)
+    {
+      uint32_t latency = report_us[i] - edge_us[k][i];
+
+      if (latency > latency_max)
+      {
+        latency_max = latency;
+      }
+    }
+  }
+
+  printf("  edges           : %lu in %lu ms\n", (unsigned long)edge_total, (unsigned long)run_ms);
+  printf("  loops           : %lu (%lu per ms)\n", (unsigned long)loops, (unsigned long)(loops / (run_ms ? run_ms : 1)));
+  printf("  key events      : %lu\n", (unsigned long)info.event_cnt[0]);
+  printf("  key wake        : max %lu us\n", (unsigned long)info.key_wake_us_max);
+  printf("  key done        : max %lu us, avg %lu us\n",
+         (unsigned long)info.key_done_us_max,
+         (unsigned long)(info.key_done_cnt ? info.key_done_us_sum / info.key_done_cnt : 0));
+  printf("  report latency  : max %lu us (limit %lu us)\n", (unsigned long)latency_max, (unsigned long)hold_us);
+
+  if (simGetReportDropped() != 0)
+  {
+    printf("  report log overflow\n");
+    ret = false;
+  }
+  if (latency_max > hold_us)
+  {
+    printf("  report latency exceeds limit\n");
+    ret = false;
+  }
+  if (info.event_cnt[0] < edge_total * 3 / 4)           // 같은 프레임에 겹친 엣지만 하나로 합쳐질 수 있다
+  {
+    printf("  matrix changes did not wake the main loop\n");
+    ret = false;
+  }
+  if (info.key_wake_us_max > SIM_LOOP_STEP_US || info.key_done_us_max > 2 * SIM_LOOP_STEP_US)
+  {
+    printf("  wake latency exceeds one loop iteration\n");
+    ret = false;
+  }
+
+  idleSetEnable(enable_prev);
+  return ret;
+}
+
+// V261019R9: WFI 활성 상태에서 125us 단위 defer 디바운스로 탭을 반복하며
+//   press/release 리포트가 지연(500us) + 프레임 1개 안에 나가는지 확인한다.
+//   확정 대기 중 깨움원이 없으면 만료가 다음 1ms tick 까지 밀려 일부 탭이 1ms 를 넘는다.
+bool sim_scenario_idle_debounce(void)
+{
+  const uint32_t delay_us    = SIM_IDLE_DB_TICKS * 125U;
+  const uint32_t limit_us    = delay_us + SIM_KEYS_FRAME_US + 2 * SIM_LOOP_STEP_US;
+  const bool     enable_prev = idleIsEnabled();
+  keypos_t       key;
+  uint8_t        usage;
+  uint32_t       press_max   = 0;
+  uint32_t       release_max = 0;
+  idle_info_t    info;
+  bool           ret = true;
+
+  if (sim_pick_alpha_keys(&key, &usage, 1) != 1)
+  {
+    printf("  no alpha key in layer 0\n");
+    return false;
+  }
+
+  simRunUs(SIM_BOOT_SETTLE_US, SIM_LOOP_STEP_US);
+  sim_via_set_debounce(id_qmk_debounce_mode, DEBOUNCE_RUNTIME_TYPE_SYM_DEFER_PK);
+  sim_via_set_debounce(id_qmk_debounce_unit, DEBOUNCE_RUNTIME_UNIT_125US);
+  sim_via_set_debounce(id_qmk_debounce_time_single, SIM_IDLE_DB_TICKS);
+
+  const debounce_profile_values_t *profile = debounce_profile_current();
+  if (profile->unit != DEBOUNCE_RUNTIME_UNIT_125US || debounce_runtime_release_delay() != SIM_IDLE_DB_TICKS)
+  {
+    printf("  VIA debounce unit/delay not applied (unit %d, delay %u)\n", profile->unit, debounce_runtime_release_delay());
+    debounce_profile_restore_defaults();
+    return false;
+  }
+
+  idleSetEnable(true);
+  idleClearInfo();
+
+  for (uint32_t i=0; i<SIM_IDLE_DB_TRIALS; i++)
+  {
+    // 1ms tick 에 대한 엣지 위상을 매번 다르게 둔다
+    simRunIdleUs(5000 + i * 137U, SIM_LOOP_STEP_US);
+    simClearReports();
+
+    uint32_t press_us = simGetTimeUs();
+    simSetKey(key.row, key.col, true);
+    simRunIdleUs(5000 + i * 61U, SIM_LOOP_STEP_US);
+
+    uint32_t release_us = simGetTimeUs();
+    simSetKey(key.row, key.col, false);
+    simRunIdleUs(5000, SIM_LOOP_STEP_US);
+
+    int32_t press_idx   = sim_find_report(0, usage, true);
+    int32_t release_idx = press_idx < 0 ? -1 : sim_find_report((uint32_t)press_idx + 1, usage, false);
+
+    if (press_idx < 0 || release_idx < 0)
+    {
+      printf("  trial %lu : press/release report missing (press %d, release %d)\n", (unsigned long)i, press_idx, release_idx);
+      ret = false;
+      break;
+    }
+
+    uint32_t press_lat   = simGetReport((uint32_t)press_idx)->time_us - press_us;
+    uint32_t release_lat = simGetReport((uint32_t)release_idx)->time_us - release_us;
+
+    if (press_lat > press_max)
+    {
+      press_max = press_lat;
+    }
+    if (release_lat > release_max)
+    {
+      release_max = release_lat;
+    }
+  }
+
+  // 확정 대기가 끝난 뒤에는 다시 tick 사이에 잠들어야 한다
+  idleClearInfo();
+  simRunIdleUs(50000, SIM_LOOP_STEP_US);
+  idleGetInfo(&info);
+
+  debounce_profile_restore_defaults();
+  idleSetEnable(enable_prev);
+
+  printf("  defer delay     : %lu us (limit %lu us)\n", (unsigned long)delay_us, (unsigned long)limit_us);
+  printf("  press   latency : max %lu us\n", (unsigned long)press_max);
+  printf("  release latency : max %lu us\n", (unsigned long)release_max);
+  printf("  quiet sleep     : %lu %%\n", (unsigned long)(info.sleep_us / 500));
+
+  if (ret && (press_max > limit_us || release_max > limit_us || release_max >= 1000U))
+  {
+    printf("  debounce expiry waited for the 1 ms tick\n");
+    ret = false;
+  }
+  if (info.sleep_us < 50000U * 9 / 10)
+  {
+    printf("  main loop did not go back to sleep after debounce settled\n");
+    ret = false;
+  }
+  return ret;
+}
+
+// 다수결 축약 결과를 열별 단순 카운트와 비교한다.
+static bool sim_reduce_kernel_check(void)
+{
+  uint16_t samples[KEYS_OVERSAMPLE_MAX];
+  uint32_t seed = 0x5CA17E57U;
+
+  for (uint32_t iter=0; iter<20000; iter++)
+  {
+    uint32_t count = 1 + sim_rand(&seed) % KEYS_OVERSAMPLE_MAX;
+    uint16_t and_v = 0xFFFF;
+    uint16_t or_v  = 0;
+    uint16_t maj_v = 0;
+
+    for (uint32_t i=0; i<count; i++)
+    {
+      samples[i] = (uint16_t)sim_rand(&seed);
+      and_v     &= samples[i];
+      or_v      |= samples[i];
+    }
+    for (uint32_t col=0; col<16; col++)
+    {
+      uint32_t ones = 0;
+
+      for (uint32_t i=0; i<count; i++)
+      {
+        ones += (samples[i] >> col) & 1U;
+      }
+      if (ones > count / 2)
+      {
+        maj_v |= (uint16_t)(1U << col);
+      }
+    }
+
+    if (keysReduceSamples(samples, 1, count, KEYS_REDUCE_MAJORITY) != maj_v ||
+        keysReduceSamples(samples, 1, count, KEYS_REDUCE_AND) != and_v ||
+        keysReduceSamples(samples, 1, count, KEYS_REDUCE_OR) != or_v)
+    {
+      printf("  reduce kernel mismatch (count %lu)\n", (unsigned long)count);
+      return false;
+    }
+  }
+  return true;
+}
+
+// V261021R2: DMA 절반 스윕 수 계산이 오버샘플 수를 담고, N=1 에서 8kHz(125us) 게시를 지키는지 모든 행 수/주기로 확인한다.
+static bool sim_frame_sizing_check(void)
+{
+  for (uint32_t rows=1; rows<=KEYS_ROWS_MAX; rows++)
+  {
+    for (uint32_t rate=0; rate<KEYS_SCAN_RATE_COUNT; rate++)
+    {
+      uint32_t sweep_us = rows << rate;
+
+      for (uint32_t samples=1; samples<=KEYS_OVERSAMPLE_MAX; samples++)
+      {
+        uint32_t sweeps   = keysCalcSweepsPerHalf(samples, sweep_us);
+        uint32_t frame_us = sweeps * sweep_us;
+
+        if (sweeps < samples || sweeps > KEYS_OVERSAMPLE_MAX)
+        {
+          printf("  sweeps %lu out of range (rows %lu, rate %lu, samples %lu)\n",
+                 (unsigned long)sweeps, (unsigned long)rows, (unsigned long)rate, (unsigned long)samples);
+          return false;
+        }
+        if (frame_us < KEYS_FRAME_MIN_US && sweeps < KEYS_OVERSAMPLE_MAX)
+        {
+          printf("  frame %lu us below ISR floor (rows %lu, rate %lu)\n",
+                 (unsigned long)frame_us, (unsigned long)rows, (unsigned long)rate);
+          return false;
+        }
+        if (samples == 1 && sweep_us <= KEYS_FRAME_MAX_US && frame_us > KEYS_FRAME_MAX_US)
+        {
+          printf("  frame %lu us exceeds %d us (rows %lu, rate %lu)\n",
+                 (unsigned long)frame_us, KEYS_FRAME_MAX_US, (unsigned long)rows, (unsigned long)rate);
+          return false;
+        }
+      }
+    }
+  }
+
+  printf("  frame period    : %d rows 1us %lu us, 8us %lu us / 16 rows 1us %lu us (fixed 16 sweeps: %d / %d / %d us)\n",
+         MATRIX_ROWS,
+         (unsigned long)(keysCalcSweepsPerHalf(1, MATRIX_ROWS) * MATRIX_ROWS),
+         (unsigned long)(keysCalcSweepsPerHalf(1, MATRIX_ROWS * 8) * MATRIX_ROWS * 8),
+         (unsigned long)(keysCalcSweepsPerHalf(1, KEYS_ROWS_MAX) * KEYS_ROWS_MAX),
+         MATRIX_ROWS * KEYS_OVERSAMPLE_MAX,
+         MATRIX_ROWS * 8 * KEYS_OVERSAMPLE_MAX,
+         KEYS_ROWS_MAX * KEYS_OVERSAMPLE_MAX);
+  return true;
+}
+
+// 키 A 를 누른 상태에서 A(떨어짐)/B(눌림) 방향 단일 스윕 스파이크를 주기적으로 주입하고 리포트 전이를 센다.
+static void sim_oversample_run(const keypos_t *p_key)
+{
+  simClearReports();
+  simSetKey(p_key[0].row, p_key[0].col, true);
+  simRunUs(2000, SIM_LOOP_STEP_US);
+
+  for (uint32_t i=0; i<100; i++)
+  {
+    simInjectSpike(p_key[(i & 1) ? 1 : 0].row, p_key[(i & 1) ? 1 : 0].col);
+    simRunUs(500, SIM_LOOP_STEP_US);
+  }
+
+  simSetKey(p_key[0].row, p_key[0].col, false);
+  simRunUs(20000, SIM_LOOP_STEP_US);
+}
+
+// V261017R6: 짧은 eager 디바운스(0.25ms)에서 오버샘플링 유무에 따른 잡음 리포트 차이를 확인한다.
+bool sim_scenario_oversample(void)
+{
+  keypos_t keys[2];
+  uint8_t  usages[2];
+  bool     ret = true;
+
+  if (sim_pick_alpha_keys(keys, usages, 2) != 2)
+  {
+    printf("  not enough alpha keys in layer 0\n");
+    return false;
+  }
+
+  if (sim_reduce_kernel_check() != true)
+  {
+    return false;
+  }
+  printf("  reduce kernel   : majority/and/or match reference\n");
+
+  if (sim_frame_sizing_check() != true)
+  {
+    return false;
+  }
+
+  simRunUs(SIM_BOOT_SETTLE_US, SIM_LOOP_STEP_US);
+  sim_via_set_debounce(id_qmk_debounce_mode, DEBOUNCE_RUNTIME_TYPE_SYM_EAGER_PK);
+  sim_via_set_debounce(id_qmk_debounce_unit, DEBOUNCE_RUNTIME_UNIT_125US);
+  sim_via_set_debounce(id_qmk_debounce_time_post, 2);
+
+  const uint8_t sample_cnt[2] = {1, 3};
+
+  for (uint32_t i=0; i<2; i++)
+  {
+    sim_via_set_debounce(id_qmk_scan_samples, sample_cnt[i]);
+    sim_via_set_debounce(id_qmk_scan_reduce, KEYS_REDUCE_MAJORITY);
+
+    if (keysGetOversample() != sample_cnt[i])
+    {
+      printf("  VIA oversample not applied (%d)\n", keysGetOversample());
+      ret = false;
+      break;
+    }
+
+    sim_oversample_run(keys);
+
+    uint32_t hold_press  = sim_count_reports(0, usages[0], true);
+    uint32_t hold_rel    = sim_count_reports(0, usages[0], false);
+    uint32_t noise_press = sim_count_reports(0, usages[1], true);
+
+    printf("  samples %d       : key A press %lu / release %lu, key B false press %lu\n",
+           sample_cnt[i],
+           (unsigned long)hold_press,
+           (unsigned long)hold_rel,
+           (unsigned long)noise_press);
+
+    if (sample_cnt[i] == 1 && noise_press == 0)
+    {
+      printf("  spikes did not reach the report without oversampling\n");
+      ret = false;
+    }
+    if (sample_cnt[i] > 1 && (noise_press != 0 || hold_press != 1 || hold_rel != 1))
+    {
+      printf("  spikes leaked through majority oversampling\n");
+      ret = false;
+    }
+  }
+
+  sim_via_set_debounce(id_qmk_scan_samples, HW_KEYS_OVERSAMPLE_DEFAULT);
+  debounce_profile_restore_defaults();
+  return ret;
+}
+
+static sim_edge_log_t sim_edge_log[SIM_EDGE_LOG_MAX];
+static uint32_t       sim_edge_log_cnt = 0;
+
+// 액션 계층으로 들어가는 키 이벤트를 기록한다 (quantum.c 의 weak 구현 대체).
+bool pre_process_record_user(uint16_t keycode, keyrecord_t *record)
+{
+  if (IS_KEYEVENT(record->event) && sim_edge_log_cnt < SIM_EDGE_LOG_MAX)
+  {
+    sim_edge_log_t *p_log = &sim_edge_log[sim_edge_log_cnt++];
+
+    p_log->key     = record->event.key;
+    p_log->pressed = record->event.pressed;
+    p_log->time    = record->event.time;
+    p_log->time_us = record->event.time_us;
+    p_log->has_time_us = record->event.has_time_us;
+  }
+  return true;
+}
+
+static const sim_edge_log_t *sim_find_edge_log(keypos_t key, bool pressed)
+{
+  for (uint32_t i=0; i<sim_edge_log_cnt; i++)
+  {
+    if (KEYEQ(sim_edge_log[i].key, key) && sim_edge_log[i].pressed == pressed)
+    {
+      return &sim_edge_log[i];
+    }
+  }
+  return NULL;
+}
+
+// V261017R8: 1ms 안에 연달아 누른 키들이 스위치 엣지 시각(프레임 해상도)과 순서를 유지한 채 keyevent_t 로 전달되는지 확인한다.
+bool sim_scenario_edge(void)
+{
+  keypos_t keys[SIM_EDGE_KEY_MAX];
+  uint8_t  usages[SIM_EDGE_KEY_MAX];
+  uint32_t edge_us[2][SIM_EDGE_KEY_MAX];
+  uint32_t same_ms = 0;
+  bool     ret     = true;
+
+  if (sim_pick_alpha_keys(keys, usages, SIM_EDGE_KEY_MAX) != SIM_EDGE_KEY_MAX)
+  {
+    printf("  not enough alpha keys in layer 0\n");
+    return false;
+  }
+
+  simRunUs(SIM_BOOT_SETTLE_US, SIM_LOOP_STEP_US);
+  simRunUs(1000 - simGetTimeUs() % 1000 + 17, SIM_LOOP_STEP_US);    // ms 경계 직후에서 시작
+  sim_edge_log_cnt = 0;
+
+  for (uint32_t phase=0; phase<2; phase++)
+  {
+    bool pressed = (phase == 0);
+
+    for (uint32_t i=0; i<SIM_EDGE_KEY_MAX; i++)
+    {
+      edge_us[phase][i] = simGetTimeUs();
+      simSetKey(keys[i].row, keys[i].col, pressed);
+      simRunUs(SIM_EDGE_GAP_US, SIM_LOOP_STEP_US);
+    }
+    simRunUs(30000, SIM_LOOP_STEP_US);
+  }
+
+  for (uint32_t phase=0; phase<2; phase++)
+  {
+    bool                  pressed = (phase == 0);
+    const sim_edge_log_t *p_prev  = NULL;
+
+    for (uint32_t i=0; i<SIM_EDGE_KEY_MAX; i++)
+    {
+      const sim_edge_log_t *p_log = sim_find_edge_log(keys[i], pressed);
+
+      if (p_log == NULL)
+      {
+        printf("  %s event missing : key %lu\n", pressed ? "press" : "release", (unsigned long)i);
+        ret = false;
+        continue;
+      }
+
+      if (p_log->has_time_us != true)                 // V261020R2: 매트릭스 키 이벤트는 항상 엣지 시각을 가져야 한다
+      {
+        printf("  %s key %lu event has no edge time\n", pressed ? "press" : "release", (unsigned long)i);
+        ret = false;
+        continue;
+      }
+
+      uint32_t lag = p_log->time_us - edge_us[phase][i];
+
+      printf("  %s key %lu     : switch %7lu us, edge %7lu us (+%3lu), event time %5u ms\n",
+             pressed ? "press  " : "release",
+             (unsigned long)i,
+             (unsigned long)edge_us[phase][i],
+             (unsigned long)p_log->time_us,
+             (unsigned long)lag,
+             p_log->time);
+
+      if (lag > SIM_KEYS_FRAME_US)
+      {
+        printf("  edge time not within one frame of the switch edge\n");
+        ret = false;
+      }
+      if (p_prev != NULL)
+      {
+        if ((int32_t)(p_log->time_us - p_prev->time_us) <= 0)
+        {
+          printf("  edge order lost between key %lu and %lu\n", (unsigned long)(i - 1), (unsigned long)i);
+          ret = false;
+        }
+        if (p_log->time == p_prev->time)
+        {
+          same_ms++;
+        }
+      }
+      p_prev = p_log;
+    }
+  }
+
+  printf("  same-ms pairs   : %lu (ordered by edge us)\n", (unsigned long)same_ms);
+  if (same_ms == 0)
+  {
+    printf("  no same-ms event pair, scenario did not exercise sub-ms ordering\n");
+    ret = false;
+  }
+  return ret;
+}
+
+static void sim_via_set_nkro(bool enable)
+{
+  uint8_t packet[32] = {id_custom_set_value, id_qmk_usb_polling, id_qmk_usb_nkro_toggle, enable};
+
+  simViaSend(packet, sizeof(packet));
+  simRunUs(1000, SIM_LOOP_STEP_US);
+}
+
+static const sim_report_t *sim_last_report(uint8_t ep)
+{
+  for (uint32_t i=simGetReportCount(); i>0; i--)
+  {
+    const sim_report_t *p_report = simGetReport(i - 1);
+
+    if (p_report->ep == ep)
+    {
+      return p_report;
+    }
+  }
+  return NULL;
+}
+
+static uint32_t sim_nkro_key_count(const sim_report_t *p_report, const uint8_t *p_usage, uint32_t count)
+{
+  const report_nkro_t *p_nkro = (const report_nkro_t *)p_report->data;
+  uint32_t             found  = 0;
+
+  for (uint32_t i=0; i<count; i++)
+  {
+    if (p_nkro->bits[p_usage[i] >> 3] & (1U << (p_usage[i] & 7)))
+    {
+      found++;
+    }
+  }
+  return found;
+}
+
+static void sim_nkro_press_all(const keypos_t *p_pos, uint32_t count, bool pressed)
+{
+  for (uint32_t i=0; i<count; i++)
+  {
+    simSetKey(p_pos[i].row, p_pos[i].col, pressed);
+    simRunUs(500, SIM_LOOP_STEP_US);
+  }
+  simRunUs(30000, SIM_LOOP_STEP_US);
+}
+
+// V261018R1: NKRO 를 켜면 6KRO 한도를 넘는 동시 입력이 NKRO EP 로 모두 전달되고,
+//            Boot 프로토콜(SET_PROTOCOL 0)에서는 키보드 EP 6KRO 리포트로 폴백하는지 확인한다.
+bool sim_scenario_nkro(void)
+{
+  keypos_t keys[SIM_NKRO_KEY_MAX];
+  uint8_t  usages[SIM_NKRO_KEY_MAX];
+  bool     ret = true;
+
+  if (sim_pick_alpha_keys(keys, usages, SIM_NKRO_KEY_MAX) != SIM_NKRO_KEY_MAX)
+  {
+    printf("  not enough alpha keys in layer 0\n");
+    return false;
+  }
+
+  simRunUs(SIM_BOOT_SETTLE_US, SIM_LOOP_STEP_US);
+  sim_via_set_nkro(true);
+  simClearReports();
+
+  // Report 프로토콜 + NKRO
+  sim_nkro_press_all(keys, SIM_NKRO_KEY_MAX, true);
+
+  const sim_report_t *p_nkro = sim_last_report(SIM_EP_NKRO);
+  uint32_t            held   = p_nkro != NULL ? sim_nkro_key_count(p_nkro, usages, SIM_NKRO_KEY_MAX) : 0;
+
+  printf("  nkro held keys  : %lu / %d\n", (unsigned long)held, SIM_NKRO_KEY_MAX);
+  if (p_nkro == NULL || p_nkro->length != sizeof(report_nkro_t) || held != SIM_NKRO_KEY_MAX)
+  {
+    printf("  NKRO report does not carry every held key\n");
+    ret = false;
+  }
+  if (sim_last_report(SIM_EP_KEYBOARD) != NULL)
+  {
+    printf("  6KRO report sent while NKRO is active\n");
+    ret = false;
+  }
+
+  sim_nkro_press_all(keys, SIM_NKRO_KEY_MAX, false);
+  p_nkro = sim_last_report(SIM_EP_NKRO);
+  if (p_nkro == NULL || sim_nkro_key_count(p_nkro, usages, SIM_NKRO_KEY_MAX) != 0)
+  {
+    printf("  NKRO release report missing\n");
+    ret = false;
+  }
+  printf("  nkro reports    : %lu\n", (unsigned long)simGetReportCount());
+
+  // Boot 프로토콜 폴백
+  usbHidSetProtocol(0);
+  simClearReports();
+  sim_nkro_press_all(keys, SIM_NKRO_KEY_MAX, true);
+
+  // 6키를 넘으면 부트 리포트 키 슬롯이 모두 ErrorRollOver(0x01)여야 한다.
+  const sim_report_t *p_kbd    = sim_last_report(SIM_EP_KEYBOARD);
+  uint32_t            rollover = 0;
+
+  for (uint32_t i=0; p_kbd != NULL && i<6; i++)
+  {
+    rollover += p_kbd->data[2 + i] == 0x01 ? 1 : 0;
+  }
+  printf("  boot report     : %u bytes, rollover slots %lu / 6\n", p_kbd != NULL ? p_kbd->length : 0, (unsigned long)rollover);
+  if (p_kbd == NULL || p_kbd->length != 8 || rollover != 6 || sim_last_report(SIM_EP_NKRO) != NULL)
+  {
+    printf("  boot protocol did not fall back to 8-byte boot report\n");
+    ret = false;
+  }
+
+  sim_nkro_press_all(keys, SIM_NKRO_KEY_MAX, false);
+  p_kbd = sim_last_report(SIM_EP_KEYBOARD);
+  if (p_kbd == NULL || p_kbd->length != 8 || sim_report_is_empty(p_kbd) != true)
+  {
+    printf("  boot release report missing\n");
+    ret = false;
+  }
+
+  usbHidSetProtocol(1);
+  sim_via_set_nkro(false);
+
+  // V261021R3: 채널 처리기 규약 - 저장 명령은 짧아도 처리, 짧은 패킷/알 수 없는 명령은 id_unhandled
+  uint8_t save_pkt[2]  = {id_custom_save, id_qmk_usb_polling};
+  uint8_t short_pkt[3] = {id_custom_get_value, id_qmk_usb_polling, id_qmk_usb_nkro_toggle};
+  uint8_t bad_pkt[4]   = {id_get_protocol_version, id_qmk_usb_polling, id_qmk_usb_nkro_toggle, 0};
+
+  via_qmk_usb_nkro_command(save_pkt, sizeof(save_pkt));
+  via_qmk_usb_nkro_command(short_pkt, sizeof(short_pkt));
+  via_qmk_usb_nkro_command(bad_pkt, sizeof(bad_pkt));
+  printf("  via save/short/unknown : 0x%02X / 0x%02X / 0x%02X\n", save_pkt[0], short_pkt[0], bad_pkt[0]);
+  if (save_pkt[0] != id_custom_save || short_pkt[0] != id_unhandled || bad_pkt[0] != id_unhandled)
+  {
+    printf("  nkro VIA handler does not follow id_custom_save/id_unhandled convention\n");
+    ret = false;
+  }
+  return ret;
+}
+
+// V261018R2: 병합 판정 커널 단위 검증. 키 집합은 슬롯 순서와 무관해야 한다.
+static bool sim_coalesce_kernel_check(void)
+{
+  typedef struct
+  {
+    uint8_t base[4];                                  // mods, k0, k1, k2
+    uint8_t tail[4];
+    uint8_t next[4];
+    bool    merge;
+  } sim_merge_case_t;
+
+  static const sim_merge_case_t cases[] =
+  {
+    {{0, 0,    0,    0}, {0, KC_A, 0,    0}, {0, KC_A, KC_B, 0}, true },  // 연속 눌림
+    {{0, 0,    0,    0}, {0, KC_A, 0,    0}, {0, 0,    0,    0}, false},  // 눌림 후 바로 뗌
+    {{0, KC_A, 0,    0}, {0, 0,    0,    0}, {0, KC_A, 0,    0}, false},  // 뗌 후 다시 눌림
+    {{0, KC_A, KC_B, 0}, {0, KC_B, 0,    0}, {0, KC_C, KC_B, 0}, true },  // 슬롯 이동
+    {{0, KC_A, KC_B, 0}, {0, KC_B, KC_C, 0}, {0, KC_C, 0,    0}, true },  // 서로 다른 키의 뗌/눌림
+    {{0, 0,    0,    0}, {0x02, 0, 0,    0}, {0x03, 0, 0,    0}, true },  // 모디파이어 추가
+    {{0, 0,    0,    0}, {0x02, 0, 0,    0}, {0x01, 0, 0,    0}, false},  // 같은 모디파이어 두 번 전이
+  };
+  bool ret = true;
+
+  for (uint32_t i=0; i<sizeof(cases)/sizeof(cases[0]); i++)
+  {
+    uint8_t base[HID_KEYBOARD_REPORT_SIZE] = {0, };
+    uint8_t tail[HID_KEYBOARD_REPORT_SIZE] = {0, };
+    uint8_t next[HID_KEYBOARD_REPORT_SIZE] = {0, };
+
+    base[0] = cases[i].base[0];
+    tail[0] = cases[i].tail[0];
+    next[0] = cases[i].next[0];
+    memcpy(&base[2], &cases[i].base[1], 3);
+    memcpy(&tail[2], &cases[i].tail[1], 3);
+    memcpy(&next[2], &cases[i].next[1], 3);
+
+    if (usbHidCoalesceCanMerge(base, tail, next) != cases[i].merge)
+    {
+      printf("  merge case %lu mismatch (expect %d)\n", (unsigned long)i, cases[i].merge);
+      ret = false;
+    }
+  }
+  return ret;
+}
+
+// 키마다 리포트 전이가 눌림/뗌 taps 쌍으로 정확히 나타나는지 확인한다.
+static bool sim_coalesce_check_edges(const uint8_t *p_usage, uint32_t count, uint32_t taps)
+{
+  uint32_t times[16];
+  bool     ret = true;
+
+  for (uint32_t i=0; i<count; i++)
+  {
+    uint32_t edges = sim_collect_transitions(p_usage[i], times, 16);
+
+    if (edges != taps * 2)
+    {
+      printf("  key %lu edges %lu / %lu\n", (unsigned long)i, (unsigned long)edges, (unsigned long)(taps * 2));
+      ret = false;
+    }
+  }
+  return ret;
+}
+
+// V261018R2: 호스트가 키보드 EP 를 잠시 NAK 하는 동안(1ms 폴링) 빠른 롤과 연타를 넣고
+//   1) 모든 눌림/뗌 전이가 순서대로 전달되는지,
+//   2) 큐 깊이가 스냅샷 수가 아니라 되돌림 전이 수로 제한되는지,
+//   3) 최대 대기 시간이 NAK 구간 + 깊이 x 폴링 주기 안인지 확인한다.
+bool sim_scenario_coalesce(void)
+{
+  const uint32_t       gap_us   = 400;
+  const uint32_t       hold_us  = 8000;
+  const uint32_t       stall_us = 30000;
+  const uint32_t       taps     = 4;
+  keypos_t             keys[SIM_COALESCE_KEY_MAX];
+  uint8_t              usages[SIM_COALESCE_KEY_MAX];
+  usb_hid_queue_info_t info;
+  uint32_t             limit;
+  bool                 ret = true;
+
+  if (sim_coalesce_kernel_check() != true)
+  {
+    return false;
+  }
+  if (sim_pick_alpha_keys(keys, usages, SIM_COALESCE_KEY_MAX) != SIM_COALESCE_KEY_MAX)
+  {
+    printf("  not enough alpha keys in layer 0\n");
+    return false;
+  }
+
+  simRunUs(SIM_BOOT_SETTLE_US, SIM_LOOP_STEP_US);
+  simSetHidPollUs(SIM_COALESCE_POLL_US);
+
+  // 1) 롤: 모든 키가 NAK 구간 안에서 눌렸다 떼어진다.
+  simClearReports();
+  simStallHidUs(stall_us);
+
+  uint32_t start_us = simGetTimeUs();
+
+  while (simGetTimeUs() - start_us < stall_us + 20000U)
+  {
+    uint32_t elapsed = simGetTimeUs() - start_us;
+
+    for (uint32_t i=0; i<SIM_COALESCE_KEY_MAX; i++)
+    {
+      if (elapsed == gap_us * i)
+      {
+        simSetKey(keys[i].row, keys[i].col, true);
+      }
+      if (elapsed == gap_us * i + hold_us)
+      {
+        simSetKey(keys[i].row, keys[i].col, false);
+      }
+    }
+    simRunUs(SIM_LOOP_STEP_US, SIM_LOOP_STEP_US);
+  }
+
+  usbHidGetQueueInfo(&info);
+  limit = stall_us + (info.depth_max + 1) * SIM_COALESCE_POLL_US;
+  printf("  roll  : push %lu, merge %lu, depth max %lu, age max %lu us (limit %lu), reports %lu\n",
+         (unsigned long)info.push_cnt, (unsigned long)info.merge_cnt, (unsigned long)info.depth_max,
+         (unsigned long)info.age_max_us, (unsigned long)limit, (unsigned long)simGetReportCount());
+
+  ret &= sim_coalesce_check_edges(usages, SIM_COALESCE_KEY_MAX, 1);
+  if (info.depth_max > 2 || info.forced_cnt != 0 || info.age_max_us > limit)
+  {
+    printf("  roll queue not bounded by transitions\n");
+    ret = false;
+  }
+
+  // 2) 연타: 같은 키를 NAK 구간 안에서 taps 번 눌렀다 뗀다. 되돌림 전이마다 레코드가 하나씩 필요하다.
+  simSetHidPollUs(SIM_COALESCE_POLL_US);
+  simClearReports();
+  simStallHidUs(taps * hold_us * 2 + 10000U);
+
+  for (uint32_t t=0; t<taps; t++)
+  {
+    simSetKey(keys[0].row, keys[0].col, true);
+    simSetKey(keys[1].row, keys[1].col, true);
+    simRunUs(hold_us, SIM_LOOP_STEP_US);
+    simSetKey(keys[0].row, keys[0].col, false);
+    simSetKey(keys[1].row, keys[1].col, false);
+    simRunUs(hold_us, SIM_LOOP_STEP_US);
+  }
+  simRunUs(30000, SIM_LOOP_STEP_US);
+
+  usbHidGetQueueInfo(&info);
+  limit = taps * hold_us * 2 + 10000U + (info.depth_max + 1) * SIM_COALESCE_POLL_US;
+  printf("  taps  : push %lu, merge %lu, depth max %lu, age max %lu us (limit %lu), reports %lu\n",
+         (unsigned long)info.push_cnt, (unsigned long)info.merge_cnt, (unsigned long)info.depth_max,
+         (unsigned long)info.age_max_us, (unsigned long)limit, (unsigned long)simGetReportCount());
+
+  ret &= sim_coalesce_check_edges(usages, 2, taps);
+  if (info.depth_max > taps * 2 || info.depth_max >= info.push_cnt || info.forced_cnt != 0 || info.age_max_us > limit)
+  {
+    printf("  tap queue not bounded by transitions\n");
+    ret = false;
+  }
+  if (simGetReportCount() == 0 || sim_report_is_empty(simGetReport(simGetReportCount() - 1)) != true)
+  {
+    printf("  last report is not empty\n");
+    ret = false;
+  }
+
+  simSetHidPollUs(0);
+  return ret;
+}
+
+// V261018R3: 롤을 치는 동안 미디어 키(EXK EP)를 media_us 마다 눌렀다 떼고 키보드 큐 통계를 돌려준다.
+static uint32_t sim_ep_state_run(const keypos_t *p_key, uint32_t count, usb_hid_queue_info_t *p_info)
+{
+  const uint32_t gap_us   = 400;
+  const uint32_t hold_us  = 8000;
+  const uint32_t media_us = 250;
+  uint32_t       kbd_cnt  = 0;
+
+  simSetHidPollUs(SIM_EP_STATE_POLL_US);
+  simClearReports();
+
+  uint32_t start_us = simGetTimeUs();
+
+  while (simGetTimeUs() - start_us < gap_us * count + hold_us + 10000U)
+  {
+    uint32_t elapsed = simGetTimeUs() - start_us;
+
+    for (uint32_t i=0; i<count; i++)
+    {
+      if (elapsed == gap_us * i)
+      {
+        simSetKey(p_key[i].row, p_key[i].col, true);
+      }
+      if (elapsed == gap_us * i + hold_us)
+      {
+        simSetKey(p_key[i].row, p_key[i].col, false);
+      }
+    }
+    if (elapsed % media_us == 0)
+    {
+      host_consumer_send(((elapsed / media_us) & 1U) == 0 ? AUDIO_VOL_UP : 0);
+    }
+    simRunUs(SIM_LOOP_STEP_US, SIM_LOOP_STEP_US);
+  }
+  host_consumer_send(0);
+  simRunUs(5000, SIM_LOOP_STEP_US);
+
+  usbHidGetQueueInfo(p_info);
+  for (uint32_t i=0; i<simGetReportCount(); i++)
+  {
+    kbd_cnt += simGetReport(i)->ep == SIM_EP_KEYBOARD ? 1 : 0;
+  }
+  return kbd_cnt;
+}
+
+// V261018R3: 키보드/EXK EP 가 busy 상태 하나를 공유하던 모델과 EP 별 상태 모델에서
+//   미디어 키 연속 입력 중 키보드 리포트의 EP 대기 시간을 비교한다.
+bool sim_scenario_ep_state(void)
+{
+  keypos_t             keys[SIM_COALESCE_KEY_MAX];
+  uint8_t              usages[SIM_COALESCE_KEY_MAX];
+  usb_hid_queue_info_t info[2];
+  uint32_t             kbd_cnt[2];
+  uint32_t             wait_avg[2];
+  bool                 ret = true;
+
+  if (sim_pick_alpha_keys(keys, usages, SIM_COALESCE_KEY_MAX) != SIM_COALESCE_KEY_MAX)
+  {
+    printf("  not enough alpha keys in layer 0\n");
+    return false;
+  }
+
+  simRunUs(SIM_BOOT_SETTLE_US, SIM_LOOP_STEP_US);
+
+  for (uint32_t m=0; m<2; m++)
+  {
+    simSetHidSharedBusy(m == 0);
+    kbd_cnt[m]  = sim_ep_state_run(keys, SIM_COALESCE_KEY_MAX, &info[m]);
+    wait_avg[m] = kbd_cnt[m] > 0 ? info[m].age_avg_us * info[m].pop_cnt / kbd_cnt[m] : 0;
+
+    printf("  %-7s : kbd reports %lu, queued %lu, wait avg %lu us (queued avg %lu us), max %lu us\n",
+           m == 0 ? "shared" : "per-ep",
+           (unsigned long)kbd_cnt[m], (unsigned long)info[m].pop_cnt,
+           (unsigned long)wait_avg[m], (unsigned long)info[m].age_avg_us, (unsigned long)info[m].age_max_us);
+
+    ret &= sim_coalesce_check_edges(usages, SIM_COALESCE_KEY_MAX, 1);
+  }
+  simSetHidSharedBusy(false);
+  simSetHidPollUs(0);
+
+  // V261021R4: 드레인은 TIM2 백업 비교 시점(SOF + 120us)에만 돈다. IN 완료(다음 SOF) 전에 쌓인 리포트는
+  //   다음 프레임 비교 시점에 실리므로 EP 별 상태에서도 최대 대기는 2 폴링 주기 안이다.
+  if (info[1].age_max_us > 2U * SIM_EP_STATE_POLL_US || wait_avg[1] >= wait_avg[0])
+  {
+    printf("  per-endpoint busy tracking did not reduce keyboard wait\n");
+    ret = false;
+  }
+  return ret;
+}
+
+// V261018R4: 위상 학습기 단위 검증. 흔들림이 있어도 창 최소값으로 잠그고,
+//   SOF 직후 IN(위상 < guard) 이면 잠금을 풀어 백업 비교 시점으로 돌아가야 한다.
+static bool sim_jit_learner_check(void)
+{
+  hid_jit_t jit;
+  bool      ret = true;
+
+  usbHidJitInit(&jit, true, 125, 15, 120);
+  for (uint32_t i=0; i<HID_JIT_WINDOW - 1; i++)
+  {
+    usbHidJitSample(&jit, 60 + i % 5);
+  }
+  usbHidJitSample(&jit, 500);                                       // 프레임을 넘긴 샘플은 무시
+  if (usbHidJitIsActive(&jit) == true || jit.compare_us != 120)
+  {
+    printf("  learner locked before window end\n");
+    ret = false;
+  }
+  if (usbHidJitSample(&jit, 63) != true || usbHidJitIsActive(&jit) != true ||
+      jit.phase_us != 60 || jit.spread_us != 4 || jit.compare_us != 45)
+  {
+    printf("  learner lock mismatch (phase %lu, spread %lu, compare %lu)\n",
+           (unsigned long)jit.phase_us, (unsigned long)jit.spread_us, (unsigned long)jit.compare_us);
+    ret = false;
+  }
+  if (usbHidJitCanLoadNow(&jit, 40) == true || usbHidJitCanLoadNow(&jit, 50) != true || usbHidJitCanLoadNow(&jit, 70) == true)
+  {
+    printf("  load window mismatch\n");
+    ret = false;
+  }
+
+  for (uint32_t i=0; i<HID_JIT_WINDOW; i++)
+  {
+    usbHidJitSample(&jit, 10);
+  }
+  if (usbHidJitIsActive(&jit) == true || jit.compare_us != 120 || usbHidJitCanLoadNow(&jit, 40) != true)
+  {
+    printf("  learner did not fall back on early IN phase\n");
+    ret = false;
+  }
+  return ret;
+}
+
+// 롤을 rounds 번 치고 JIT 통계를 돌려준다. 키 간격이 프레임보다 짧아 한 프레임에 변경이 여러 번 생긴다.
+static void sim_jit_run(const keypos_t *p_key, uint32_t count, uint32_t rounds)
+{
+  const uint32_t gap_us  = 170;
+  const uint32_t hold_us = 8000;
+
+  for (uint32_t r=0; r<rounds; r++)
+  {
+    uint32_t start_us = simGetTimeUs();
+
+    while (simGetTimeUs() - start_us < gap_us * count + hold_us + 10000U)
+    {
+      uint32_t elapsed = simGetTimeUs() - start_us;
+
+      for (uint32_t i=0; i<count; i++)
+      {
+        if (elapsed == gap_us * i)
+        {
+          simSetKey(p_key[i].row, p_key[i].col, true);
+        }
+        if (elapsed == gap_us * i + hold_us)
+        {
+          simSetKey(p_key[i].row, p_key[i].col, false);
+        }
+      }
+      simRunUs(SIM_LOOP_STEP_US, SIM_LOOP_STEP_US);
+    }
+  }
+}
+
+// V261018R4: FS 폴링에서 IN 토큰이 SOF + 600us 에 오는 호스트를 두고
+//   1) 즉시 적재와 JIT 적재의 변경→IN 평균 지연을 비교하고,
+//   2) JIT 에서도 모든 눌림/뗌 전이가 전달되며 IN 을 놓치지 않는지,
+//   3) IN 이 SOF 직후인 호스트에서는 잠그지 않고 즉시 적재로 남는지 확인한다.
+//   4) V261021R5: HS 4K(폴링 250us, SOF 125us)에서 폴링되지 않는 마이크로프레임 적재/대기를 놓침으로 세지 않는지 확인한다.
+bool sim_scenario_jit(void)
+{
+  const uint32_t rounds = 4;
+  keypos_t       keys[SIM_COALESCE_KEY_MAX];
+  uint8_t        usages[SIM_COALESCE_KEY_MAX];
+  hid_jit_t     *p_jit = simGetHidJit();
+  uint32_t       avg_us[HID_JIT_PATH_MAX];
+  bool           ret = true;
+
+  if (sim_jit_learner_check() != true)
+  {
+    return false;
+  }
+  if (sim_pick_alpha_keys(keys, usages, SIM_COALESCE_KEY_MAX) != SIM_COALESCE_KEY_MAX)
+  {
+    printf("  not enough alpha keys in layer 0\n");
+    return false;
+  }
+
+  simRunUs(SIM_BOOT_SETTLE_US, SIM_LOOP_STEP_US);
+  simSetHidPhaseUs(SIM_JIT_PHASE_US, SIM_JIT_JITTER_US);
+
+  for (uint32_t m=0; m<HID_JIT_PATH_MAX; m++)
+  {
+    simSetHidJit(m == HID_JIT_PATH_JIT);
+    simSetHidPollUs(SIM_JIT_POLL_US);
+
+    // 위상 학습: 잠글 때까지 같은 롤을 반복한다 (즉시 적재 경로에서 샘플 수집).
+    for (uint32_t i=0; i<20 && m == HID_JIT_PATH_JIT && usbHidJitIsActive(p_jit) != true; i++)
+    {
+      sim_jit_run(keys, SIM_COALESCE_KEY_MAX, 1);
+    }
+    usbHidJitClearStat(p_jit);
+    simClearReports();
+
+    sim_jit_run(keys, SIM_COALESCE_KEY_MAX, rounds);
+    avg_us[m] = usbHidJitGetAvgUs(p_jit, (hid_jit_path_t)m);
+
+    printf("  %-6s : %s phase %lu us (spread %lu), compare %lu us, changes %lu, avg %lu us, max %lu us, load %lu, miss %lu\n",
+           m == HID_JIT_PATH_JIT ? "jit" : "direct",
+           usbHidJitIsActive(p_jit) ? "locked" : "unlocked",
+           (unsigned long)p_jit->phase_us, (unsigned long)p_jit->spread_us, (unsigned long)p_jit->compare_us,
+           (unsigned long)p_jit->stat[m].change_cnt, (unsigned long)avg_us[m],
+           (unsigned long)p_jit->stat[m].max_us,
+           (unsigned long)p_jit->load_cnt, (unsigned long)p_jit->miss_cnt);
+
+    ret &= sim_coalesce_check_edges(usages, SIM_COALESCE_KEY_MAX, rounds);
+    if (p_jit->stat[m].change_cnt == 0)
+    {
+      printf("  no latency samples\n");
+      ret = false;
+    }
+  }
+
+  if (usbHidJitIsActive(p_jit) != true ||
+      p_jit->phase_us < SIM_JIT_PHASE_US || p_jit->phase_us > SIM_JIT_PHASE_US + SIM_JIT_JITTER_US)
+  {
+    printf("  IN phase not learned\n");
+    ret = false;
+  }
+  if (p_jit->miss_cnt != 0 || avg_us[HID_JIT_PATH_JIT] >= avg_us[HID_JIT_PATH_DIRECT])
+  {
+    printf("  JIT did not reduce change-to-IN latency\n");
+    ret = false;
+  }
+  printf("  reduce : %ld us\n", (long)avg_us[HID_JIT_PATH_DIRECT] - (long)avg_us[HID_JIT_PATH_JIT]);
+
+  // 3) IN 이 SOF 직후인 호스트: guard 를 확보할 수 없어 잠그지 않아야 한다.
+  simSetHidPhaseUs(10, 0);
+  simSetHidPollUs(SIM_JIT_POLL_US);
+  simClearReports();
+
+  uint32_t early_rounds = 0;
+
+  while (early_rounds < 20 && p_jit->phase_us == 0)                 // 학습 창 하나가 끝날 때까지
+  {
+    sim_jit_run(keys, SIM_COALESCE_KEY_MAX, 1);
+    early_rounds++;
+  }
+  printf("  early  : %s phase %lu us, compare %lu us\n",
+         usbHidJitIsActive(p_jit) ? "locked" : "unlocked",
+         (unsigned long)p_jit->phase_us, (unsigned long)p_jit->compare_us);
+  if (p_jit->phase_us == 0 || usbHidJitIsActive(p_jit) == true || p_jit->compare_us != p_jit->backup_us)
+  {
+    printf("  JIT locked on early IN phase\n");
+    ret = false;
+  }
+  ret &= sim_coalesce_check_edges(usages, SIM_COALESCE_KEY_MAX, early_rounds);
+
+  // 4) HS 4K: TIM2 는 매 마이크로프레임 리셋되지만 호스트는 두 번째 마이크로프레임마다 IN 을 보낸다.
+  simSetHidPhaseUs(SIM_JIT_HS4K_PHASE_US, SIM_JIT_HS4K_JITTER_US);
+  simSetHidJit(true);
+  simSetHidPollUs(SIM_JIT_HS4K_POLL_US);
+
+  for (uint32_t i=0; i<20 && usbHidJitIsActive(p_jit) != true; i++)
+  {
+    sim_jit_run(keys, SIM_COALESCE_KEY_MAX, 1);
+  }
+  usbHidJitClearStat(p_jit);
+  simClearReports();
+
+  sim_jit_run(keys, SIM_COALESCE_KEY_MAX, rounds);
+  printf("  hs 4k  : %s phase %lu us, compare %lu us, poll %lu us, avg %lu us, max %lu us, load %lu, miss %lu\n",
+         usbHidJitIsActive(p_jit) ? "locked" : "unlocked",
+         (unsigned long)p_jit->phase_us, (unsigned long)p_jit->compare_us,
+         (unsigned long)SIM_JIT_HS4K_POLL_US,
+         (unsigned long)usbHidJitGetAvgUs(p_jit, HID_JIT_PATH_JIT),
+         (unsigned long)p_jit->stat[HID_JIT_PATH_JIT].max_us,
+         (unsigned long)p_jit->load_cnt, (unsigned long)p_jit->miss_cnt);
+  if (usbHidJitIsActive(p_jit) != true || p_jit->load_cnt == 0 || p_jit->miss_cnt != 0)
+  {
+    printf("  JIT counted unpolled microframes as missed IN\n");
+    ret = false;
+  }
+  ret &= sim_coalesce_check_edges(usages, SIM_COALESCE_KEY_MAX, rounds);
+
+  simSetHidJit(false);
+  simSetHidPhaseUs(0, 0);
+  simSetHidPollUs(0);
+  return ret;
+}
+
+// V261018R6: 흐름 제어 단위 검증. window 가 차면 OUT 을 잡아 두고 응답을 실을 때 한 번만 재무장,
+//   게이트 모드에서는 마지막 적재 후 gate_ms 전까지 응답을 싣지 않아야 한다.
+static bool sim_via_flow_check(void)
+{
+  static hid_via_t via;
+  uint8_t          packet[HID_VIA_PACKET_SIZE] = {id_get_protocol_version};
+  bool             ret = true;
+
+  usbHidViaInit(&via, 0, 2);
+  if (usbHidViaOnReceive(&via, true) != true || usbHidViaOnReceive(&via, true) == true || via.hold_cnt != 1)
+  {
+    printf("  OUT not held at window\n");
+    ret = false;
+  }
+  if (usbHidViaTakeRearm(&via) == true || usbHidViaPop(&via, packet, 0) == true)
+  {
+    printf("  OUT re-armed without a response\n");
+    ret = false;
+  }
+  usbHidViaPush(&via, packet, sizeof(packet), 0);
+  if (usbHidViaPop(&via, packet, 0) != true || usbHidViaTakeRearm(&via) != true || usbHidViaTakeRearm(&via) == true)
+  {
+    printf("  OUT not re-armed once after response\n");
+    ret = false;
+  }
+
+  // V261020R4: 큐에 싣지 않은 요청(빈 패킷)은 pending 을 늘리지 않고, 리셋은 남은 응답을 버린다
+  usbHidViaReset(&via);
+  for (uint32_t i=0; i<4; i++)
+  {
+    if (usbHidViaOnReceive(&via, false) != true)
+    {
+      printf("  unqueued request held the OUT endpoint\n");
+      ret = false;
+      break;
+    }
+  }
+  if (via.pending != 0)
+  {
+    printf("  unqueued request leaked pending (%lu)\n", (unsigned long)via.pending);
+    ret = false;
+  }
+  usbHidViaPush(&via, packet, sizeof(packet), 0);
+  usbHidViaReset(&via);
+  if (usbHidViaAvailable(&via) != 0)
+  {
+    printf("  reset kept %lu stale responses\n", (unsigned long)usbHidViaAvailable(&via));
+    ret = false;
+  }
+
+  usbHidViaSetMode(&via, HID_VIA_LEGACY_GATE_MS, HID_VIA_LEGACY_WINDOW);
+  usbHidViaReset(&via);
+  usbHidViaOnReceive(&via, true);
+  usbHidViaPush(&via, packet, sizeof(packet), 100);
+  if (usbHidViaPop(&via, packet, 100 + HID_VIA_LEGACY_GATE_MS - 1) == true ||
+      usbHidViaPop(&via, packet, 100 + HID_VIA_LEGACY_GATE_MS) != true || usbHidViaTakeRearm(&via) != true)
+  {
+    printf("  legacy gate mismatch\n");
+    ret = false;
+  }
+  return ret;
+}
+
+// V261018R6: RAW HID 호스트 대역으로 동적 키맵 전체를 28B 씩 읽어 처리량(B/s)과 내용을 확인한다.
+static bool sim_via_read_keymap(const char *p_name, uint32_t gate_ms, uint32_t window, uint32_t host_window,
+                                const uint8_t *p_ref, uint16_t size, uint32_t *p_rate)
+{
+  hid_via_t *p_via   = simGetVia();
+  uint32_t   req_cnt = 0;
+  bool       ret     = true;
+
+  simSetViaTransport(SIM_VIA_POLL_US, gate_ms, window, host_window);
+  simClearReports();
+
+  for (uint16_t offset=0; offset<size; offset+=SIM_VIA_CHUNK)
+  {
+    uint8_t  packet[HID_VIA_PACKET_SIZE] = {0};
+    uint16_t chunk = size - offset < SIM_VIA_CHUNK ? size - offset : SIM_VIA_CHUNK;
+
+    packet[0] = id_dynamic_keymap_get_buffer;
+    packet[1] = offset >> 8;
+    packet[2] = offset & 0xFF;
+    packet[3] = chunk;
+    if (simViaHostQueue(packet, sizeof(packet)) != true)
+    {
+      printf("  host queue full\n");
+      return false;
+    }
+    req_cnt++;
+  }
+
+  uint32_t start_us = simGetTimeUs();
+  uint32_t limit_us = req_cnt * (gate_ms * 1000U + 4U * SIM_VIA_POLL_US) + 100000U;
+
+  while (simViaHostPending() > 0 && simGetTimeUs() - start_us < limit_us)
+  {
+    simRunUs(SIM_LOOP_STEP_US, SIM_LOOP_STEP_US);
+  }
+
+  uint32_t elapsed_us = simGetTimeUs() - start_us;
+  uint32_t resp_cnt   = 0;
+
+  for (uint32_t i=0; i<simGetReportCount(); i++)
+  {
+    const sim_report_t *p_report = simGetReport(i);
+
+    if (p_report->ep != SIM_EP_VIA)
+    {
+      continue;
+    }
+
+    uint16_t offset = resp_cnt * SIM_VIA_CHUNK;
+    uint16_t chunk  = size - offset < SIM_VIA_CHUNK ? size - offset : SIM_VIA_CHUNK;
+
+    if (resp_cnt >= req_cnt || p_report->data[0] != id_dynamic_keymap_get_buffer ||
+        ((p_report->data[1] << 8) | p_report->data[2]) != offset || memcmp(&p_report->data[4], &p_ref[offset], chunk) != 0)
+    {
+      printf("  response %lu mismatch\n", (unsigned long)resp_cnt);
+      ret = false;
+      break;
+    }
+    resp_cnt++;
+  }
+
+  *p_rate = elapsed_us > 0 ? (uint32_t)((uint64_t)size * 1000000ULL / elapsed_us) : 0;
+  printf("  %-8s : %u B in %lu us, %lu B/s (requests %lu, window %lu, pending max %lu, OUT NAK %lu)\n",
+         p_name, size, (unsigned long)elapsed_us, (unsigned long)*p_rate,
+         (unsigned long)req_cnt, (unsigned long)p_via->window,
+         (unsigned long)p_via->pending_max, (unsigned long)p_via->hold_cnt);
+
+  if (resp_cnt != req_cnt)
+  {
+    printf("  %lu / %lu responses\n", (unsigned long)resp_cnt, (unsigned long)req_cnt);
+    ret = false;
+  }
+  if (p_via->pending_max > p_via->window)
+  {
+    printf("  device accepted more requests than window\n");
+    ret = false;
+  }
+  return ret;
+}
+
+// V261018R6: 개선 전(20ms 게이트 + 요청 1개), 파이프라인 + 요청 1개 호스트(VIA 앱), 파이프라인 + 다중 요청 호스트 비교
+bool sim_scenario_via_pipe(void)
+{
+  static uint8_t ref[4096];
+  uint32_t       rate[3];
+  bool           ret = true;
+
+  if (sim_via_flow_check() != true)
+  {
+    return false;
+  }
+  simRunUs(SIM_BOOT_SETTLE_US, SIM_LOOP_STEP_US);
+
+  uint32_t size = (uint32_t)dynamic_keymap_get_layer_count() * MATRIX_ROWS * MATRIX_COLS * 2U;
+
+  if (size == 0 || size > sizeof(ref))
+  {
+    printf("  unexpected keymap size %lu\n", (unsigned long)size);
+    return false;
+  }
+  dynamic_keymap_get_buffer(0, size, ref);
+
+  ret &= sim_via_read_keymap("legacy", HID_VIA_LEGACY_GATE_MS, HID_VIA_LEGACY_WINDOW, 1, ref, size, &rate[0]);
+  ret &= sim_via_read_keymap("pipe x1", 0, HW_USB_VIA_WINDOW, 1, ref, size, &rate[1]);
+  ret &= sim_via_read_keymap("pipe x8", 0, HW_USB_VIA_WINDOW, SIM_VIA_HOST_WINDOW, ref, size, &rate[2]);
+
+  if (rate[1] < rate[0] * 10U || rate[2] <= rate[1])
+  {
+    printf("  pipeline did not raise throughput\n");
+    ret = false;
+  }
+  printf("  speedup  : x%lu (x1 host), x%lu (x8 host)\n",
+         (unsigned long)(rate[1] / (rate[0] > 0 ? rate[0] : 1)),
+         (unsigned long)(rate[2] / (rate[0] > 0 ? rate[0] : 1)));
+
+  simSetViaTransport(0, HW_USB_VIA_GATE_MS, HW_USB_VIA_WINDOW, 1);
+  return ret;
+}
+
+// V261018R7: 요청을 호스트 대역으로 보내고 응답을 순서대로 sim_bulk_resp 에 모은다. 걸린 시간(us), 실패 시 0.
+static uint8_t sim_bulk_req[SIM_BULK_REQ_MAX][HID_VIA_PACKET_SIZE];
+static uint8_t sim_bulk_resp[SIM_BULK_REQ_MAX][HID_VIA_PACKET_SIZE];
+
+static uint32_t sim_via_exchange(uint32_t count, uint32_t gate_ms, uint32_t window)
+{
+  simSetViaTransport(SIM_VIA_POLL_US, gate_ms, window, 1);         // VIA 앱처럼 응답을 받고 다음 요청
+  simClearReports();
+  for (uint32_t i=0; i<count; i++)
+  {
+    simViaHostQueue(sim_bulk_req[i], HID_VIA_PACKET_SIZE);
+  }
+
+  uint32_t start_us = simGetTimeUs();
+  uint32_t limit_us = count * (gate_ms * 1000U + 4U * SIM_VIA_POLL_US) + 100000U;
+
+  while (simViaHostPending() > 0 && simGetTimeUs() - start_us < limit_us)
+  {
+    simRunUs(SIM_LOOP_STEP_US, SIM_LOOP_STEP_US);
+  }
+
+  uint32_t elapsed_us = simGetTimeUs() - start_us;
+  uint32_t resp_cnt   = 0;
+
+  for (uint32_t i=0; i<simGetReportCount() && resp_cnt < count; i++)
+  {
+    const sim_report_t *p_report = simGetReport(i);
+
+    if (p_report->ep == SIM_EP_VIA)
+    {
+      memcpy(sim_bulk_resp[resp_cnt++], p_report->data, HID_VIA_PACKET_SIZE);
+    }
+  }
+  simSetViaTransport(0, HW_USB_VIA_GATE_MS, HW_USB_VIA_WINDOW, 1);
+  return resp_cnt == count && elapsed_us > 0 ? elapsed_us : 0;
+}
+
+static void sim_bulk_set_req(uint32_t index, uint8_t command_id, uint8_t value_id, uint8_t region)
+{
+  memset(sim_bulk_req[index], 0, HID_VIA_PACKET_SIZE);
+  sim_bulk_req[index][0] = command_id;
+  sim_bulk_req[index][1] = id_qmk_bulk;
+  sim_bulk_req[index][2] = value_id;
+  sim_bulk_req[index][3] = region;
+}
+
+// 개선 전 경로: 키맵/매크로를 28B 씩 읽는다 (탭댄스/USER 는 값 단위 명령뿐이라 제외).
+static uint32_t sim_bulk_legacy_sync(uint32_t gate_ms, uint32_t window, uint32_t *p_req_cnt)
+{
+  uint32_t count = 0;
+  uint16_t size[2] = {bulk_region_size(BULK_REGION_KEYMAP), bulk_region_size(BULK_REGION_MACRO)};
+  uint8_t  cmd[2]  = {id_dynamic_keymap_get_buffer, id_dynamic_keymap_macro_get_buffer};
+
+  for (uint32_t r=0; r<2; r++)
+  {
+    for (uint16_t offset=0; offset<size[r] && count < SIM_BULK_REQ_MAX; offset+=SIM_VIA_CHUNK)
+    {
+      memset(sim_bulk_req[count], 0, HID_VIA_PACKET_SIZE);
+      sim_bulk_req[count][0] = cmd[r];
+      sim_bulk_req[count][1] = offset >> 8;
+      sim_bulk_req[count][2] = offset & 0xFF;
+      sim_bulk_req[count][3] = size[r] - offset < SIM_VIA_CHUNK ? size[r] - offset : SIM_VIA_CHUNK;
+      count++;
+    }
+  }
+  *p_req_cnt = count;
+  return sim_via_exchange(count, gate_ms, window);
+}
+
+// 새 경로: 영역별 info(스냅샷) 후 압축 스트림을 25B 씩 읽어 복원/CRC/원본 비교까지 확인한다.
+static uint32_t sim_bulk_sync(uint32_t *p_req_cnt, bool *p_ok)
+{
+  static uint8_t stream[BULK_STREAM_MAX];
+  static uint8_t raw[BULK_RAW_MAX];
+  static uint8_t ref[BULK_RAW_MAX];
+  uint16_t       raw_len[BULK_REGION_MAX];
+  uint16_t       crc[BULK_REGION_MAX];
+  uint16_t       stream_len[BULK_REGION_MAX];
+  uint32_t       count = 0;
+  uint32_t       total_us;
+
+  for (uint8_t r=0; r<BULK_REGION_MAX; r++)
+  {
+    sim_bulk_set_req(count++, id_custom_get_value, id_qmk_bulk_info, r);
+  }
+  total_us = sim_via_exchange(count, 0, HW_USB_VIA_WINDOW);
+  *p_req_cnt = count;
+  *p_ok      = total_us > 0;
+
+  for (uint8_t r=0; r<BULK_REGION_MAX && *p_ok; r++)
+  {
+    const uint8_t *p_resp = sim_bulk_resp[r];
+
+    raw_len[r]    = bulk_region_size(r) > 0 && p_resp[0] == id_custom_get_value ? (p_resp[4] << 8) | p_resp[5] : 0;
+    crc[r]        = (p_resp[6] << 8) | p_resp[7];
+    stream_len[r] = (p_resp[8] << 8) | p_resp[9];
+    if (raw_len[r] != bulk_region_size(r))
+    {
+      printf("  region %u info mismatch\n", r);
+      *p_ok = false;
+    }
+  }
+
+  // info 가 스냅샷을 한 영역만 잡으므로 영역마다 info → read 를 다시 주고받는다.
+  for (uint8_t r=0; r<BULK_REGION_MAX && *p_ok; r++)
+  {
+    if (raw_len[r] == 0)
+    {
+      continue;
+    }
+
+    uint32_t n = 0;
+
+    sim_bulk_set_req(n++, id_custom_get_value, id_qmk_bulk_info, r);
+    for (uint16_t offset=0; offset<stream_len[r] && n < SIM_BULK_REQ_MAX; offset+=BULK_CHUNK_MAX)
+    {
+      sim_bulk_set_req(n, id_custom_get_value, id_qmk_bulk_read, r);
+      sim_bulk_req[n][4] = offset >> 8;
+      sim_bulk_req[n][5] = offset & 0xFF;
+      n++;
+    }
+
+    uint32_t elapsed_us = sim_via_exchange(n, 0, HW_USB_VIA_WINDOW);
+    uint32_t pos        = 0;
+
+    total_us   += elapsed_us;
+    *p_req_cnt += n - 1;                                             // 영역별 info 는 앞에서 이미 셌다
+    for (uint32_t i=1; i<n && elapsed_us > 0; i++)
+    {
+      uint8_t len = sim_bulk_resp[i][6];
+
+      memcpy(&stream[pos], &sim_bulk_resp[i][7], len);
+      pos += len;
+    }
+
+    memset(ref, 0, sizeof(ref));
+    if (r == BULK_REGION_KEYMAP)
+    {
+      dynamic_keymap_get_buffer(0, raw_len[r], ref);
+    }
+    else if (r == BULK_REGION_MACRO)
+    {
+      dynamic_keymap_macro_get_buffer(0, raw_len[r], ref);
+    }
+    else
+    {
+      eeprom_read_block(ref, r == BULK_REGION_USER ? (void *)EECONFIG_USER_DATABLOCK : EECONFIG_USER_TAPDANCE, raw_len[r]);
+    }
+
+    bool ok = elapsed_us > 0 && pos == stream_len[r] &&
+              bulk_rle_decode(stream, pos, raw, raw_len[r]) == true &&
+              utilCalcCRC(0, raw, raw_len[r]) == crc[r] && memcmp(raw, ref, raw_len[r]) == 0;
+
+    printf("    region %u : %4u B -> %4u B (%lu requests)%s\n",
+           r, raw_len[r], stream_len[r], (unsigned long)(n - 1), ok ? "" : " MISMATCH");
+    *p_ok &= ok;
+  }
+  return total_us;
+}
+
+// 키맵 영역을 host_raw 로 적용한다. 돌려준 changed 는 commit 응답값.
+static bool sim_bulk_apply_keymap(const uint8_t *p_raw, uint16_t raw_len, bool corrupt_crc, uint16_t *p_changed)
+{
+  static uint8_t stream[BULK_STREAM_MAX];
+  uint32_t       stream_len = bulk_rle_encode(p_raw, raw_len, stream, sizeof(stream));
+  uint16_t       crc        = utilCalcCRC(0, (uint8_t *)p_raw, raw_len) ^ (corrupt_crc ? 0x5A5A : 0);
+  uint32_t       n          = 0;
+
+  sim_bulk_set_req(n, id_custom_set_value, id_qmk_bulk_write_begin, BULK_REGION_KEYMAP);
+  sim_bulk_req[n][4] = raw_len >> 8;
+  sim_bulk_req[n][5] = raw_len & 0xFF;
+  sim_bulk_req[n][6] = crc >> 8;
+  sim_bulk_req[n][7] = crc & 0xFF;
+  sim_bulk_req[n][8] = stream_len >> 8;
+  sim_bulk_req[n][9] = stream_len & 0xFF;
+  n++;
+  for (uint32_t offset=0; offset<stream_len && n < SIM_BULK_REQ_MAX - 1; offset+=BULK_CHUNK_MAX)
+  {
+    uint8_t len = stream_len - offset < BULK_CHUNK_MAX ? stream_len - offset : BULK_CHUNK_MAX;
+
+    sim_bulk_set_req(n, id_custom_set_value, id_qmk_bulk_write_data, BULK_REGION_KEYMAP);
+    sim_bulk_req[n][4] = offset >> 8;
+    sim_bulk_req[n][5] = offset & 0xFF;
+    sim_bulk_req[n][6] = len;
+    memcpy(&sim_bulk_req[n][7], &stream[offset], len);
+    n++;
+  }
+  sim_bulk_set_req(n++, id_custom_set_value, id_qmk_bulk_write_commit, BULK_REGION_KEYMAP);
+
+  uint32_t elapsed_us = sim_via_exchange(n, 0, HW_USB_VIA_WINDOW);
+  uint8_t *p_commit   = sim_bulk_resp[n - 1];
+
+  if (elapsed_us == 0 || p_commit[0] != id_custom_set_value)
+  {
+    return false;
+  }
+  *p_changed = (p_commit[4] << 8) | p_commit[5];
+  printf("    apply : %lu requests, %lu us, changed %u B\n", (unsigned long)n, (unsigned long)elapsed_us, *p_changed);
+  return true;
+}
+
+// EEPROM 쓰기 큐가 빌 때까지 돌리고 begin 이후 실제로 기록된 바이트 수를 돌려준다.
+static uint32_t sim_bulk_flush_eeprom(uint32_t begin)
+{
+  for (uint32_t i=0; i<1000 && eeprom_is_pending() == true; i++)
+  {
+    simRunUs(1000, SIM_LOOP_STEP_US);
+  }
+  return simGetEepromWriteBytes() - begin;
+}
+
+// V261018R7: 전체 프로필 동기화(개선 전 28B 왕복 + 20ms 게이트 vs 압축 일괄 전송)와 차분 적용을 확인한다.
+bool sim_scenario_via_bulk(void)
+{
+  static uint8_t keymap[BULK_RAW_MAX];
+  uint32_t       legacy_req, pipe_req, bulk_req;
+  bool           ok  = true;
+  bool           ret = true;
+
+  simRunUs(SIM_BOOT_SETTLE_US, SIM_LOOP_STEP_US);
+  sim_bulk_flush_eeprom(simGetEepromWriteBytes());
+
+  // RLE 커널 단위 검증: 홀수 길이, 128 워드 넘는 반복, 리터럴/반복 경계
+  {
+    static uint8_t in[301];
+    static uint8_t out[sizeof(in)];
+    uint8_t        z[BULK_STREAM_MAX];
+
+    for (uint32_t i=0; i<sizeof(in); i++)
+    {
+      in[i] = i < 280 ? 0x00 : (uint8_t)(i * 7);
+    }
+    in[11] = 0x01;
+    uint32_t z_len = bulk_rle_encode(in, sizeof(in), z, sizeof(z));
+
+    if (z_len == 0 || bulk_rle_decode(z, z_len, out, sizeof(out)) != true || memcmp(in, out, sizeof(in)) != 0 ||
+        bulk_rle_decode(z, z_len - 1, out, sizeof(out)) == true)
+    {
+      printf("  RLE round trip failed\n");
+      return false;
+    }
+  }
+
+  uint32_t legacy_us = sim_bulk_legacy_sync(HID_VIA_LEGACY_GATE_MS, HID_VIA_LEGACY_WINDOW, &legacy_req);
+  uint32_t pipe_us   = sim_bulk_legacy_sync(0, HW_USB_VIA_WINDOW, &pipe_req);
+
+  printf("  legacy  : keymap+macro %lu requests, %lu us (20ms gate)\n", (unsigned long)legacy_req, (unsigned long)legacy_us);
+  printf("  pipe    : keymap+macro %lu requests, %lu us\n", (unsigned long)pipe_req, (unsigned long)pipe_us);
+
+  uint32_t bulk_us = sim_bulk_sync(&bulk_req, &ok);
+
+  printf("  bulk    : full profile %lu requests, %lu us\n", (unsigned long)bulk_req, (unsigned long)bulk_us);
+  if (legacy_us == 0 || pipe_us == 0 || ok != true)
+  {
+    printf("  sync failed\n");
+    return false;
+  }
+  if (bulk_req >= pipe_req || bulk_us >= pipe_us || bulk_us > 50000U)
+  {
+    printf("  bulk sync did not cut round trips / time\n");
+    ret = false;
+  }
+
+  // 차분 적용: 키 3개만 바꾼 프로필은 바뀐 바이트만 EEPROM 에 기록되어야 한다.
+  uint16_t size    = bulk_region_size(BULK_REGION_KEYMAP);
+  uint16_t changed = 0;
+  uint16_t expect  = 0;
+
+  dynamic_keymap_get_buffer(0, size, keymap);
+  for (uint32_t i=0; i<3; i++)
+  {
+    uint32_t offset = (MATRIX_ROWS * MATRIX_COLS * 2) * (i + 1) + 2 * i;   // 레이어 1~3 의 키 하나씩
+
+    expect += keymap[offset] != 0x00 ? 1 : 0;
+    expect += keymap[offset + 1] != 0x04 ? 1 : 0;
+    keymap[offset]     = 0x00;
+    keymap[offset + 1] = 0x04;                                      // KC_A
+  }
+
+  uint32_t write_bytes;
+  uint32_t begin = simGetEepromWriteBytes();
+
+  if (sim_bulk_apply_keymap(keymap, size, true, &changed) == true || sim_bulk_flush_eeprom(begin) != 0)
+  {
+    printf("  corrupted CRC was applied\n");
+    ret = false;
+  }
+  begin = simGetEepromWriteBytes();
+  if (sim_bulk_apply_keymap(keymap, size, false, &changed) != true)
+  {
+    printf("  apply failed\n");
+    return false;
+  }
+  write_bytes = sim_bulk_flush_eeprom(begin);
+  printf("  diff    : expected %u B, changed %u B, EEPROM written %lu B of %u B\n",
+         expect, changed, (unsigned long)write_bytes, size);
+  if (changed != expect || write_bytes != expect || dynamic_keymap_get_keycode(1, 0, 0) != KC_A)
+  {
+    printf("  diff apply mismatch\n");
+    ret = false;
+  }
+
+  begin = simGetEepromWriteBytes();
+  if (sim_bulk_apply_keymap(keymap, size, false, &changed) != true || changed != 0 || sim_bulk_flush_eeprom(begin) != 0)
+  {
+    printf("  re-applying the same profile wrote EEPROM\n");
+    ret = false;
+  }
+  return ret;
+}
+
+// V261018R8: 폴링 모드 변경을 MCU 리셋 없이 재열거로 적용한다.
+//   재열거 전부터 누른 키는 놓지 않은 채 다시 보내고, 분리 중에 누른 키도 재전송 리포트에 포함되어야 한다.
+bool sim_scenario_reenum(void)
+{
+  keypos_t keys[2];
+  uint8_t  usages[2];
+  bool     ret = true;
+
+  if (sim_pick_alpha_keys(keys, usages, 2) != 2)
+  {
+    printf("  no alpha key in layer 0\n");
+    return false;
+  }
+
+  simRunUs(SIM_BOOT_SETTLE_US, SIM_LOOP_STEP_US);
+  simSetKey(keys[0].row, keys[0].col, true);
+  simRunUs(30000, SIM_LOOP_STEP_US);
+  simClearReports();
+
+  usb_reenum_t *p_reenum = simGetUsbReEnum();
+  uint32_t      req_us   = simGetTimeUs();
+  uint32_t      lost     = simGetUsbLostReports();
+  uint32_t      conf_sz  = simGetUsbConfDescSize();
+
+  simUsbReEnum(SIM_REENUM_GRACE_MS, SIM_REENUM_ENUM_US);
+  simRunUs((SIM_REENUM_GRACE_MS + SIM_REENUM_DETACH_MS / 2) * 1000U, SIM_LOOP_STEP_US);
+  simSetKey(keys[1].row, keys[1].col, true);                       // 분리 중 입력
+
+  for (uint32_t i=0; i<2000 && (usbReEnumIsBusy(p_reenum) == true || p_reenum->wait_report == true); i++)
+  {
+    simRunUs(1000, SIM_LOOP_STEP_US);
+  }
+  lost = simGetUsbLostReports() - lost;
+
+  int32_t  first_idx = sim_find_report(0, usages[0], true);
+  uint32_t min_us    = (SIM_REENUM_GRACE_MS + SIM_REENUM_DETACH_MS) * 1000U + SIM_REENUM_ENUM_US;
+
+  printf("  reenum  : count %lu, enum %lu ms, lost reports %lu\n",
+         (unsigned long)p_reenum->count, (unsigned long)p_reenum->enum_ms, (unsigned long)lost);
+  printf("  soft    : request -> first report %lu ms\n", (unsigned long)p_reenum->first_report_ms);
+  printf("  reset   : grace %d + detach %d ms + MCU boot/EEPROM load/enum (hardware: usb reenum)\n",
+         SIM_REENUM_GRACE_MS, SIM_REENUM_DETACH_MS);
+
+  if (p_reenum->count != 1 || first_idx != 0 || lost == 0)
+  {
+    printf("  reenum did not complete (idx %d)\n", first_idx);
+    return false;
+  }
+
+  const sim_report_t *p_first = simGetReport(0);
+
+  if (p_first->time_us - req_us < min_us || sim_report_has_usage(p_first, usages[1]) != true)
+  {
+    printf("  re-sent report is early or misses the key pressed while detached\n");
+    ret = false;
+  }
+  if (p_reenum->first_report_ms > min_us / 1000U + 2U)
+  {
+    printf("  first report later than grace + detach + enum\n");
+    ret = false;
+  }
+
+  simSetKey(keys[0].row, keys[0].col, false);
+  simSetKey(keys[1].row, keys[1].col, false);
+  simRunUs(30000, SIM_LOOP_STEP_US);
+  if (sim_count_reports(0, usages[0], false) != 1 || sim_report_is_empty(simGetReport(simGetReportCount() - 1)) != true)
+  {
+    printf("  held key was released to host before the user released it\n");
+    ret = false;
+  }
+
+  // V261020R6: 두 번째 재열거 후에도 Composite 구성 디스크립터가 부팅 때 크기 그대로여야 한다.
+  simUsbReEnum(SIM_REENUM_GRACE_MS, SIM_REENUM_ENUM_US);
+  for (uint32_t i=0; i<2000 && (usbReEnumIsBusy(p_reenum) == true || p_reenum->wait_report == true); i++)
+  {
+    simRunUs(1000, SIM_LOOP_STEP_US);
+  }
+  printf("  confdesc: boot %lu B, after %lu re-enum %lu B (max %lu B)\n",
+         (unsigned long)conf_sz, (unsigned long)p_reenum->count,
+         (unsigned long)simGetUsbConfDescSize(), (unsigned long)simGetUsbConfDescMax());
+  if (p_reenum->count != 2 || simGetUsbConfDescSize() != conf_sz || simGetUsbConfDescMax() != conf_sz)
+  {
+    printf("  config descriptor changed across re-enumeration\n");
+    ret = false;
+  }
+  return ret;
+}
+
+// V261018R9: SOF 감시 다운그레이드 판정 기록 (SIM_SOF_MODE_*)
+typedef struct
+{
+  uint32_t now_us;
+  uint32_t delta_us;
+  uint8_t  event;
+} sim_sof_decision_t;
+
+static hid_sof_sample_t   sim_sof_trace[SIM_SOF_TRACE_MAX];
+static sim_sof_decision_t sim_sof_log[SIM_SOF_MODE_MAX][SIM_SOF_LOG_MAX];
+static uint32_t           sim_sof_log_cnt[SIM_SOF_MODE_MAX];
+static uint32_t           sim_sof_log_sel;
+
+static bool sim_sof_downgrade(uint32_t now_us, uint32_t delta_us, uint32_t expected_us, usb_monitor_event_t event)
+{
+  uint32_t cnt = sim_sof_log_cnt[sim_sof_log_sel]++;
+
+  (void)expected_us;
+  if (cnt < SIM_SOF_LOG_MAX)
+  {
+    sim_sof_log[sim_sof_log_sel][cnt].now_us   = now_us;
+    sim_sof_log[sim_sof_log_sel][cnt].delta_us = delta_us;
+    sim_sof_log[sim_sof_log_sel][cnt].event    = (uint8_t)event;
+  }
+  return true;                                        // usbRequestBootModeDowngrade() ARMED
+}
+
+// 호스트/허브 이상을 흉내 낸 SOF 트레이스. faults 가 false 면 지터만 있는 정상 HS 8kHz 이다.
+//   0.3s 까지 DEFAULT/ADDRESSED, 5~10s 드문 누락, 10~12s 잦은 누락, 13s 30ms SOF 중단,
+//   14~15.2s 서스펜드 3회, 16~16.9s HS/FS 전환 6회, 20s 100ms ADDRESSED, 22s~ 드문 누락
+static uint32_t sim_sof_make_trace(uint32_t duration_us, bool faults)
+{
+  uint32_t seed  = 0x50F7ACE5U;
+  uint32_t t     = 1000;
+  uint32_t cnt   = 0;
+  bool     stall = false;
+
+  while (t < duration_us && cnt < SIM_SOF_TRACE_MAX)
+  {
+    hid_sof_sample_t *p_sample = &sim_sof_trace[cnt++];
+    uint32_t          period   = 125;
+    uint32_t          glitch   = 0;
+
+    p_sample->now_us    = t;
+    p_sample->dev_state = USBD_STATE_CONFIGURED;
+    p_sample->speed     = USBD_SPEED_HIGH;
+    p_sample->flags     = 0;
+    p_sample->reserved  = 0;
+
+    if (faults == true)
+    {
+      if (t < 300000)
+      {
+        p_sample->dev_state = (t < 150000) ? USBD_STATE_DEFAULT : USBD_STATE_ADDRESSED;
+      }
+      else if (t >= 20000000 && t < 20100000)
+      {
+        p_sample->dev_state = USBD_STATE_ADDRESSED;
+      }
+      if (t >= 14000000 && t < 15200000 && (t - 14000000) % 400000 < 3000)
+      {
+        p_sample->flags = HID_SOF_FLAG_SUSPENDED;
+      }
+      if (t >= 16000000 && t < 16900000 && ((t - 16000000) / 150000) % 2 == 1)
+      {
+        p_sample->speed = USBD_SPEED_FULL;
+        period          = 1000;
+      }
+
+      if (t >= 5000000 && t < 10000000)
+      {
+        glitch = 2;                                   // 천분율
+      }
+      else if (t >= 10000000 && t < 12000000)
+      {
+        glitch = 30;
+      }
+      else if (t >= 22000000)
+      {
+        glitch = 1;
+      }
+    }
+
+    uint32_t gap = period;
+
+    if (period == 125)
+    {
+      gap = 125 + sim_rand(&seed) % 17 - 8;           // ±8us 지터
+    }
+    if (sim_rand(&seed) % 1000 < glitch)
+    {
+      gap = period * (2 + sim_rand(&seed) % 6);       // 1~6 프레임 누락
+    }
+    if (faults == true && stall == false && t >= 13000000)
+    {
+      gap   = 30000;                                  // 백그라운드 SOF 중단 감시 경로
+      stall = true;
+    }
+    t += gap;
+  }
+  return cnt;
+}
+
+static void sim_sof_tick(hid_sof_mon_t *p_mon, uint32_t now_us, const hid_sof_sample_t *p_last)
+{
+  if (sim_sof_log_sel == SIM_SOF_MODE_REF)            // V261020R7: 동결 사본은 Drain 없이 누락 감시만
+  {
+    simSofRefTick(now_us,
+                  p_last->dev_state == USBD_STATE_CONFIGURED,
+                  (p_last->flags & HID_SOF_FLAG_SUSPENDED) != 0);
+    return;
+  }
+  usbHidSofMonDrain(p_mon);                           // ISR 평가 모드에서는 링이 비어 있어 아무것도 하지 않는다
+  usbHidSofMonTick(p_mon,
+                   now_us,
+                   p_last->dev_state == USBD_STATE_CONFIGURED,
+                   (p_last->flags & HID_SOF_FLAG_SUSPENDED) != 0);
+}
+
+// 트레이스를 시간 순서로 재생한다. 메인 루프 틱은 50~2050us 무작위 간격이고 stall_at_us 부터 stall_us 동안 멈춘다.
+static void sim_sof_replay(hid_sof_mon_t *p_mon, uint32_t mode, uint32_t cnt, uint32_t stall_at_us, uint32_t stall_us)
+{
+  uint32_t seed      = 0x71C4ED01U;
+  uint32_t next_tick = sim_sof_trace[0].now_us + 100;
+
+  sim_sof_log_sel = mode;
+  sim_sof_log_cnt[sim_sof_log_sel] = 0;
+  usbHidSofMonInit(p_mon, mode == SIM_SOF_MODE_BATCH, sim_sof_downgrade);
+  if (mode == SIM_SOF_MODE_REF)
+  {
+    simSofRefInit(sim_sof_downgrade);
+  }
+
+  for (uint32_t i=0; i<cnt; i++)
+  {
+    const hid_sof_sample_t *p_sample = &sim_sof_trace[i];
+
+    while (i > 0 && (int32_t)(p_sample->now_us - next_tick) >= 0)
+    {
+      sim_sof_tick(p_mon, next_tick, &sim_sof_trace[i - 1]);
+      next_tick += 50 + sim_rand(&seed) % 2000;
+      if (stall_us > 0 && next_tick >= stall_at_us)
+      {
+        next_tick  += stall_us;
+        stall_us    = 0;
+      }
+    }
+    if (mode == SIM_SOF_MODE_REF)
+    {
+      simSofRefOnSof(p_sample);
+    }
+    else
+    {
+      usbHidSofMonOnSof(p_mon, p_sample);
+    }
+  }
+  sim_sof_tick(p_mon, next_tick, &sim_sof_trace[cnt - 1]);
+}
+
+// SOF 1개당 ISR 쪽 호스트 실행 시간(ps). 측정 밖에서 SIM_SOF_BENCH_BLOCK 개마다 메인 루프 평가를 돌린다.
+static uint64_t sim_sof_isr_ps(bool batch, uint32_t cnt, uint64_t *p_drain_ps)
+{
+  static hid_sof_mon_t mon;
+  uint64_t isr_ns   = 0;
+  uint64_t drain_ns = 0;
+
+  usbHidSofMonInit(&mon, batch, sim_sof_downgrade);
+  for (uint32_t i=0; i + SIM_SOF_BENCH_BLOCK <= cnt; i += SIM_SOF_BENCH_BLOCK)
+  {
+    uint64_t t0 = simGetHostNs();
+    for (uint32_t j=0; j<SIM_SOF_BENCH_BLOCK; j++)
+    {
+      usbHidSofMonOnSof(&mon, &sim_sof_trace[i + j]);
+    }
+    uint64_t t1 = simGetHostNs();
+    usbHidSofMonDrain(&mon);
+    usbHidSofMonTick(&mon, sim_sof_trace[i + SIM_SOF_BENCH_BLOCK - 1].now_us, true, false);
+    uint64_t t2 = simGetHostNs();
+
+    isr_ns   += t1 - t0;
+    drain_ns += t2 - t1;
+  }
+  if (p_drain_ps != NULL)
+  {
+    *p_drain_ps = drain_ns * 1000U / cnt;
+  }
+  return isr_ns * 1000U / cnt;
+}
+
+// V261018R9: 같은 기록 트레이스를 ISR 평가(V261018R8 까지)와 일괄 평가로 재생해
+//   1) 다운그레이드 판정(시각/간격/이벤트)과 최종 감시 상태가 같은지,
+//   2) 메인 루프가 32ms 넘게 멈춰 링이 넘쳐도 빠진 구간을 누락으로 세지 않는지,
+//   3) SOF 1개당 ISR 비용이 얼마나 줄었는지 확인한다.
+// V261020R7: 기준은 리팩터링 전 usbd_hid.c 평가 코드의 동결 사본(sim_sof_ref.c)이다. 새 모듈의 ISR/일괄 평가를 모두 여기에 맞춘다.
+bool sim_scenario_sof_batch(void)
+{
+  static const char   *mode_label[SIM_SOF_MODE_MAX] = {"ref", "isr", "batch"};
+  static hid_sof_mon_t mon[SIM_SOF_MODE_MAX];
+  bool     ret = true;
+  uint32_t cnt = sim_sof_make_trace(30000000, true);
+
+  for (uint32_t m=0; m<SIM_SOF_MODE_MAX; m++)
+  {
+    sim_sof_replay(&mon[m], m, cnt, 0, 0);
+  }
+
+  printf("  trace   : %lu SOF, %lu / %lu / %lu downgrade (ref / isr / batch)\n",
+         (unsigned long)cnt, (unsigned long)sim_sof_log_cnt[SIM_SOF_MODE_REF],
+         (unsigned long)sim_sof_log_cnt[SIM_SOF_MODE_ISR], (unsigned long)sim_sof_log_cnt[SIM_SOF_MODE_BATCH]);
+  for (uint32_t i=0; i<sim_sof_log_cnt[SIM_SOF_MODE_REF] && i<SIM_SOF_LOG_MAX; i++)
+  {
+    static const char *label[] = {"sof", "enum", "speed", "suspend"};
+    printf("    %8lu us  delta %7lu us  %s\n",
+           (unsigned long)sim_sof_log[SIM_SOF_MODE_REF][i].now_us,
+           (unsigned long)sim_sof_log[SIM_SOF_MODE_REF][i].delta_us,
+           label[sim_sof_log[SIM_SOF_MODE_REF][i].event]);
+  }
+  printf("  batch   : eval %lu, fast %lu, batches %lu (max %lu), max gap %lu us, SOF wake %lu\n",
+         (unsigned long)mon[SIM_SOF_MODE_BATCH].eval_cnt, (unsigned long)mon[SIM_SOF_MODE_BATCH].fast_cnt,
+         (unsigned long)mon[SIM_SOF_MODE_BATCH].batch_cnt, (unsigned long)mon[SIM_SOF_MODE_BATCH].batch_max,
+         (unsigned long)mon[SIM_SOF_MODE_BATCH].gap_max_us, (unsigned long)mon[SIM_SOF_MODE_BATCH].wake_cnt);
+
+  for (uint32_t m=SIM_SOF_MODE_ISR; m<SIM_SOF_MODE_MAX; m++)
+  {
+    bool same = sim_sof_log_cnt[m] == sim_sof_log_cnt[SIM_SOF_MODE_REF] &&
+                memcmp(sim_sof_log[m], sim_sof_log[SIM_SOF_MODE_REF], sizeof(sim_sof_log[0])) == 0 &&
+                memcmp(&mon[m].st, simSofRefState(), sizeof(usb_sof_monitor_t)) == 0;
+    if (same == false)
+    {
+      printf("  %s decisions differ from the pre-refactor evaluator\n", mode_label[m]);
+      ret = false;
+    }
+  }
+  if (sim_sof_log_cnt[SIM_SOF_MODE_REF] < 3)
+  {
+    printf("  trace did not exercise downgrade paths\n");
+    ret = false;
+  }
+  if (mon[SIM_SOF_MODE_BATCH].fast_cnt < cnt / 2)     // 워밍업/홀드오프/점수 감쇠 구간은 기존 평가를 탄다
+  {
+    printf("  fast path covered less than half of SOF\n");
+    ret = false;
+  }
+  if (mon[SIM_SOF_MODE_BATCH].wake_cnt * 16 > cnt)    // V261020R7: 메인 루프가 틱마다 비우면 SOF 로 깨울 일이 거의 없다
+  {
+    printf("  SOF woke the main loop %lu times (threshold %d)\n",
+           (unsigned long)mon[SIM_SOF_MODE_BATCH].wake_cnt, HID_SOF_MON_WAKE_DEPTH);
+    ret = false;
+  }
+
+  // 링(256 = HS 32ms) 보다 긴 메인 루프 정지
+  cnt = sim_sof_make_trace(3000000, false);
+  for (uint32_t m=0; m<SIM_SOF_MODE_MAX; m++)
+  {
+    sim_sof_replay(&mon[m], m, cnt, 2500000, 60000);
+  }
+  printf("  stall   : 60 ms main loop stall, dropped %lu, SOF wake %lu, downgrade %lu / %lu / %lu (ref / isr / batch)\n",
+         (unsigned long)mon[SIM_SOF_MODE_BATCH].drop_cnt, (unsigned long)mon[SIM_SOF_MODE_BATCH].wake_cnt,
+         (unsigned long)sim_sof_log_cnt[SIM_SOF_MODE_REF], (unsigned long)sim_sof_log_cnt[SIM_SOF_MODE_ISR],
+         (unsigned long)sim_sof_log_cnt[SIM_SOF_MODE_BATCH]);
+  if (mon[SIM_SOF_MODE_BATCH].drop_cnt == 0 || sim_sof_log_cnt[SIM_SOF_MODE_ISR] != 0 || sim_sof_log_cnt[SIM_SOF_MODE_BATCH] != 0)
+  {
+    printf("  ring overflow counted as missed SOF\n");
+    ret = false;
+  }
+  if (mon[SIM_SOF_MODE_BATCH].wake_cnt == 0)
+  {
+    printf("  ring fill past threshold did not request a main loop wake\n");
+    ret = false;
+  }
+
+  // ISR 비용 (정상 구간: 모든 SOF 가 평가할 것 없이 지나가는 경우)
+  uint64_t drain_ps;
+  uint64_t isr_ps   = sim_sof_isr_ps(false, cnt, NULL);
+  uint64_t batch_ps = sim_sof_isr_ps(true, cnt, &drain_ps);
+
+  printf("  isr cost: in-ISR eval %lu.%03lu ns/SOF, push %lu.%03lu ns/SOF (main loop drain %lu.%03lu ns/SOF)\n",
+         (unsigned long)(isr_ps / 1000), (unsigned long)(isr_ps % 1000),
+         (unsigned long)(batch_ps / 1000), (unsigned long)(batch_ps % 1000),
+         (unsigned long)(drain_ps / 1000), (unsigned long)(drain_ps % 1000));
+  return ret;
+}
+
+// V261019R1: 서스펜드 중 탭 1회 (0 = delay(10) + 버림, 1 = 단계 진행 + 보관/재전송)
+static bool sim_wakeup_tap(keypos_t key, uint8_t usage, bool blocking, uint32_t resume_us, uint32_t run_us)
+{
+  simSetWakeUpBlocking(blocking);
+  simSetWakeUpResumeUs(resume_us);
+  simSetSuspended(true);
+  simRunUs(5000, SIM_LOOP_STEP_US);                   // idle_task() suspend_power_down()
+  simClearReports();
+  simClearUpdateMaxUs();
+
+  uint32_t req_us = simGetTimeUs();
+
+  simSetKey(key.row, key.col, true);
+  simRunUs(SIM_WAKEUP_TAP_US, SIM_LOOP_STEP_US);
+  simSetKey(key.row, key.col, false);
+  simRunUs(run_us, SIM_LOOP_STEP_US);
+
+  int32_t press_idx   = sim_find_report(0, usage, true);
+  int32_t release_idx = press_idx >= 0 ? sim_find_report((uint32_t)press_idx + 1U, usage, false) : -1;
+
+  printf("  %-8s: reports %lu, press %ld ms, release %ld ms, max loop block %lu us\n",
+         blocking ? "blocking" : "async",
+         (unsigned long)simGetReportCount(),
+         press_idx   >= 0 ? (long)((simGetReport((uint32_t)press_idx)->time_us - req_us) / 1000U) : -1L,
+         release_idx >= 0 ? (long)((simGetReport((uint32_t)release_idx)->time_us - req_us) / 1000U) : -1L,
+         (unsigned long)simGetUpdateMaxUs());
+
+  if (blocking == true)
+  {
+    return true;
+  }
+  if (resume_us == 0)
+  {
+    return simGetReportCount() == 0;
+  }
+  if (press_idx < 0 || release_idx < 0)
+  {
+    printf("  tap that woke the host was lost\n");
+    return false;
+  }
+  uint32_t wake_us = simGetHidWakeUp()->req_ms * 1000U;           // 디바운스 후 첫 리포트가 깨우기를 시작한 시각
+
+  if (simGetReport((uint32_t)press_idx)->time_us - wake_us < resume_us ||
+      simGetReport((uint32_t)press_idx)->time_us - wake_us > resume_us + 2000U)
+  {
+    printf("  press not replayed right after resume\n");
+    return false;
+  }
+  if (simGetUpdateMaxUs() >= 1000U)
+  {
+    printf("  main loop blocked during remote wakeup\n");
+    return false;
+  }
+  return true;
+}
+
+bool sim_scenario_wakeup(void)
+{
+  keypos_t      key;
+  uint8_t       usage;
+  bool          ret      = true;
+  hid_wakeup_t *p_wakeup = simGetHidWakeUp();
+
+  if (sim_pick_alpha_keys(&key, &usage, 1) != 1)
+  {
+    printf("  no alpha key in layer 0\n");
+    return false;
+  }
+  simRunUs(SIM_BOOT_SETTLE_US, SIM_LOOP_STEP_US);
+
+  sim_wakeup_tap(key, usage, true, SIM_WAKEUP_RESUME_US, 60000);
+
+  uint32_t wake_cnt = p_wakeup->wake_cnt;
+
+  if (sim_wakeup_tap(key, usage, false, SIM_WAKEUP_RESUME_US, 60000) != true)
+  {
+    ret = false;
+  }
+  printf("  wakeup  : resume %lu ms, buffered %lu, replayed %lu\n",
+         (unsigned long)p_wakeup->resume_ms, (unsigned long)p_wakeup->push_cnt, (unsigned long)p_wakeup->replay_cnt);
+  if (p_wakeup->wake_cnt != wake_cnt + 1U)
+  {
+    printf("  wakeup did not complete once\n");
+    ret = false;
+  }
+
+  // 호스트가 재개하지 않으면 시간 제한 후 보관 리포트를 버리고, 이후 재개해도 묵은 입력을 보내지 않는다.
+  uint32_t timeout_cnt = p_wakeup->timeout_cnt;
+
+  if (sim_wakeup_tap(key, usage, false, 0, (HW_USB_WAKEUP_SIGNAL_MS + HW_USB_WAKEUP_TIMEOUT_MS) * 1000U + 50000U) != true ||
+      p_wakeup->timeout_cnt != timeout_cnt + 1U || usbHidWakeUpAvailable(p_wakeup) != 0)
+  {
+    printf("  wakeup without resume did not time out cleanly\n");
+    ret = false;
+  }
+  simSetSuspended(false);
+  simRunUs(10000, SIM_LOOP_STEP_US);
+  printf("  timeout : %lu, stale reports after late resume %lu\n",
+         (unsigned long)p_wakeup->timeout_cnt, (unsigned long)simGetReportCount());
+  if (simGetReportCount() != 0)
+  {
+    printf("  stale report sent after timeout\n");
+    ret = false;
+  }
+
+  simSetWakeUpBlocking(false);
+  simSetWakeUpResumeUs(SIM_WAKEUP_RESUME_US);
+  return ret;
+}
+
+// V261019R2: VIA 지연 계측 채널(18) 요청 후 응답(value_data = data[3..])을 돌려준다.
+static const uint8_t *sim_via_latency(uint8_t command_id, uint8_t value_id, uint8_t arg0, uint8_t arg1)
+{
+  uint8_t             packet[32] = {command_id, id_qmk_latency, value_id, arg0, arg1};
+  const sim_report_t *p_report;
+
+  simViaSend(packet, sizeof(packet));
+  simRunUs(1000, SIM_LOOP_STEP_US);
+
+  p_report = sim_last_report(SIM_EP_VIA);
+  if (p_report == NULL || p_report->data[0] != command_id || p_report->data[1] != id_qmk_latency)
+  {
+    return NULL;
+  }
+  return &p_report->data[3];
+}
+
+static uint32_t sim_get_be32(const uint8_t *p_buf)
+{
+  return ((uint32_t)p_buf[0] << 24) | ((uint32_t)p_buf[1] << 16) | ((uint32_t)p_buf[2] << 8) | p_buf[3];
+}
+
+static void sim_latency_taps(const keypos_t *p_keys, uint32_t taps)
+{
+  for (uint32_t i=0; i<taps; i++)
+  {
+    const keypos_t *p_key = &p_keys[i % SIM_LATENCY_KEY_MAX];
+
+    simRunUs((i * 337U) % SIM_LATENCY_POLL_US, SIM_LOOP_STEP_US);   // 폴링 위상을 탭마다 바꾼다
+    simSetKey(p_key->row, p_key->col, true);
+    simRunUs(20000, SIM_LOOP_STEP_US);
+    simSetKey(p_key->row, p_key->col, false);
+    simRunUs(20000, SIM_LOOP_STEP_US);
+  }
+}
+
+// V261019R2: 탭마다 press/release 샘플이 하나씩 쌓이고, 구간 합이 total 과 정확히 같으며,
+//   tx>done 은 폴링 주기, capture>debounce 는 디바운스 지연 안에 들어와야 한다.
+bool sim_scenario_latency(void)
+{
+  keypos_t              keys[SIM_LATENCY_KEY_MAX];
+  uint8_t               usages[SIM_LATENCY_KEY_MAX];
+  const latency_hist_t *p_total = latencyGetHist(LATENCY_STAGE_TOTAL);
+  const uint8_t        *p_resp;
+  uint64_t              stage_sum = 0;
+  uint32_t              tick_per_us;
+  bool                  ret = true;
+
+  if (sim_pick_alpha_keys(keys, usages, SIM_LATENCY_KEY_MAX) != SIM_LATENCY_KEY_MAX)
+  {
+    printf("  not enough alpha keys in layer 0\n");
+    return false;
+  }
+
+  simRunUs(SIM_BOOT_SETTLE_US, SIM_LOOP_STEP_US);
+  simSetHidPollUs(SIM_LATENCY_POLL_US);
+  simClearReports();
+  latencyClear();
+
+  sim_latency_taps(keys, SIM_LATENCY_TAPS);
+  latencyPrintInfo();
+
+  tick_per_us = latencyGetTickPerUs();
+  if (latencyGetSampleCount() != SIM_LATENCY_TAPS * 2U || latencyGetAbandonCount() != 0)
+  {
+    printf("  samples %lu (expected %lu), abandoned %lu\n",
+           (unsigned long)latencyGetSampleCount(), (unsigned long)(SIM_LATENCY_TAPS * 2U),
+           (unsigned long)latencyGetAbandonCount());
+    ret = false;
+  }
+  for (uint32_t i=0; i<LATENCY_STAGE_TOTAL; i++)
+  {
+    const latency_hist_t *p_hist = latencyGetHist((latency_stage_t)i);
+
+    stage_sum += p_hist->sum_tick;
+    if (p_hist->cnt != p_total->cnt)
+    {
+      printf("  %s count %lu != total %lu\n", latencyStageName((latency_stage_t)i),
+             (unsigned long)p_hist->cnt, (unsigned long)p_total->cnt);
+      ret = false;
+    }
+  }
+  if (stage_sum != p_total->sum_tick)
+  {
+    printf("  stage sum %llu != total %llu ticks\n",
+           (unsigned long long)stage_sum, (unsigned long long)p_total->sum_tick);
+    ret = false;
+  }
+  if (latencyGetHist(LATENCY_STAGE_DONE)->max_tick > SIM_LATENCY_POLL_US * tick_per_us)
+  {
+    printf("  tx>done exceeds poll interval\n");
+    ret = false;
+  }
+  if (latencyGetHist(LATENCY_STAGE_DEBOUNCE)->max_tick > (sim_latency_limit_us() - SIM_LATENCY_SLACK_US + SIM_KEYS_FRAME_US) * tick_per_us)
+  {
+    printf("  capture>debounce exceeds debounce delay\n");
+    ret = false;
+  }
+
+  // VIA: 샘플 수, total 구간 통계, 히스토그램 조각 합
+  p_resp = sim_via_latency(id_custom_get_value, id_qmk_latency_info, 0, 0);
+  if (p_resp == NULL || sim_get_be32(&p_resp[0]) != latencyGetSampleCount() || p_resp[10] != LATENCY_HIST_BINS)
+  {
+    printf("  VIA info mismatch\n");
+    ret = false;
+  }
+  p_resp = sim_via_latency(id_custom_get_value, id_qmk_latency_stage, LATENCY_STAGE_TOTAL, 0);
+  if (p_resp == NULL || sim_get_be32(&p_resp[1]) != p_total->cnt ||
+      sim_get_be32(&p_resp[17]) != latencyTickToNs(p_total->max_tick))
+  {
+    printf("  VIA stage mismatch\n");
+    ret = false;
+  }
+
+  uint32_t bin_sum = 0;
+
+  for (uint32_t first=0; first<LATENCY_HIST_BINS && ret; )
+  {
+    p_resp = sim_via_latency(id_custom_get_value, id_qmk_latency_hist, LATENCY_STAGE_TOTAL, (uint8_t)first);
+    if (p_resp == NULL || p_resp[1] != first || p_resp[2] == 0)
+    {
+      printf("  VIA hist mismatch at bin %lu\n", (unsigned long)first);
+      ret = false;
+      break;
+    }
+    for (uint32_t i=0; i<p_resp[2]; i++)
+    {
+      bin_sum += ((uint32_t)p_resp[3 + i * 2] << 8) | p_resp[4 + i * 2];
+    }
+    first += p_resp[2];
+  }
+  if (ret == true && bin_sum != p_total->cnt)
+  {
+    printf("  VIA hist sum %lu != %lu\n", (unsigned long)bin_sum, (unsigned long)p_total->cnt);
+    ret = false;
+  }
+
+  // VIA 로 끄면 샘플이 늘지 않아야 한다.
+  uint32_t samples = latencyGetSampleCount();
+
+  sim_via_latency(id_custom_set_value, id_qmk_latency_enable, 0, 0);
+  sim_latency_taps(keys, 2);
+  if (latencyGetSampleCount() != samples || latencyIsEnabled() == true)
+  {
+    printf("  samples added while disabled\n");
+    ret = false;
+  }
+  sim_via_latency(id_custom_set_value, id_qmk_latency_enable, 1, 0);
+  printf("  samples : %lu, total p50 %lu ns, p99 %lu ns\n", (unsigned long)samples,
+         (unsigned long)latencyGetPercentileNs(LATENCY_STAGE_TOTAL, 500),
+         (unsigned long)latencyGetPercentileNs(LATENCY_STAGE_TOTAL, 990));
+
+  simSetHidPollUs(0);
+  return ret;
+}
+
+// V261019R3: 미러와 칩이 다른 바이트로 더티 페이지 수와 페이지별 구간 합을 구한다.
+static void sim_eeprom_diff(uint32_t *p_pages, uint32_t *p_bytes)
+{
+  static uint8_t chip[TOTAL_EEPROM_BYTE_COUNT];
+
+  eepromRead(0, chip, sizeof(chip));
+  *p_pages = 0;
+  *p_bytes = 0;
+  for (uint32_t page=0; page<TOTAL_EEPROM_BYTE_COUNT / SIM_EEPROM_PAGE; page++)
+  {
+    int32_t lo = -1;
+    int32_t hi = -1;
+
+    for (uint32_t i=0; i<SIM_EEPROM_PAGE; i++)
+    {
+      uint32_t addr = page * SIM_EEPROM_PAGE + i;
+
+      if (eeprom_read_byte((const uint8_t *)(uintptr_t)addr) != chip[addr])
+      {
+        lo = lo < 0 ? (int32_t)i : lo;
+        hi = (int32_t)i;
+      }
+    }
+    if (lo >= 0)
+    {
+      (*p_pages)++;
+      *p_bytes += (uint32_t)(hi - lo + 1);
+    }
+  }
+}
+
+static uint32_t sim_eeprom_flush(void)
+{
+  uint32_t loops = 0;
+
+  while (eeprom_is_pending() == true && loops < 1000)
+  {
+    simRunUs(1000, SIM_LOOP_STEP_US);
+    loops++;
+  }
+  return loops;
+}
+
+// V261019R3: VIA 28B 조각으로 전체 키맵을 바꾼 뒤 더티 페이지 캐시가 바뀐 페이지를 한 번씩만,
+//   구간만큼만 기록하는지와 같은 바이트 반복 쓰기 병합, 같은 값 쓰기 무시를 확인한다.
+bool sim_scenario_eeprom_cache(void)
+{
+  static uint8_t keymap[BULK_RAW_MAX];
+  static uint8_t chip[TOTAL_EEPROM_BYTE_COUNT];
+  uint16_t       size = bulk_region_size(BULK_REGION_KEYMAP);
+  uint32_t       pages, bytes;
+  uint32_t       write_cnt, write_bytes;
+  uint64_t       host_ns;
+  bool           ret = true;
+
+  simRunUs(SIM_BOOT_SETTLE_US, SIM_LOOP_STEP_US);
+  sim_eeprom_flush();
+
+  // 1) 전체 키맵 갱신 (모든 워드를 바꿈)
+  dynamic_keymap_get_buffer(0, size, keymap);
+  for (uint16_t i=0; i<size; i++)
+  {
+    keymap[i] ^= 0x5A;
+  }
+  host_ns = simGetHostNs();
+  for (uint16_t offset=0; offset<size; offset+=SIM_EEPROM_VIA_CHUNK)
+  {
+    uint16_t len = size - offset < SIM_EEPROM_VIA_CHUNK ? size - offset : SIM_EEPROM_VIA_CHUNK;
+
+    dynamic_keymap_set_buffer(offset, len, &keymap[offset]);
+  }
+  host_ns = simGetHostNs() - host_ns;
+
+  sim_eeprom_diff(&pages, &bytes);
+  write_cnt   = simGetEepromWriteCount();
+  write_bytes = simGetEepromWriteBytes();
+
+  uint32_t pending = eeprom_get_write_pending_count();
+  uint32_t loops   = sim_eeprom_flush();
+
+  write_cnt   = simGetEepromWriteCount() - write_cnt;
+  write_bytes = simGetEepromWriteBytes() - write_bytes;
+  printf("  keymap  : %u B, host %lu ns to mark, %lu dirty pages\n",
+         size, (unsigned long)host_ns, (unsigned long)pending);
+  printf("  flush   : %lu page writes, %lu B, %lu loops, tWR model %lu ms\n",
+         (unsigned long)write_cnt, (unsigned long)write_bytes, (unsigned long)loops,
+         (unsigned long)(write_cnt * SIM_EEPROM_TWR_US / 1000U));
+  if (pending != pages || write_cnt != pages || write_bytes != bytes || eeprom_is_pending() == true)
+  {
+    printf("  expected %lu pages / %lu B\n", (unsigned long)pages, (unsigned long)bytes);
+    ret = false;
+  }
+
+  eepromRead(0, chip, sizeof(chip));
+  for (uint32_t i=0; i<TOTAL_EEPROM_BYTE_COUNT; i++)
+  {
+    if (chip[i] != eeprom_read_byte((const uint8_t *)(uintptr_t)i))
+    {
+      printf("  mirror/chip mismatch at %lu\n", (unsigned long)i);
+      ret = false;
+      break;
+    }
+  }
+
+  // 2) 같은 바이트 반복 쓰기는 마지막 값 하나로 병합
+  uint8_t *p_addr = (uint8_t *)(uintptr_t)EECONFIG_USER_DATABLOCK;
+  uint8_t  orig   = eeprom_read_byte(p_addr);
+
+  write_cnt   = simGetEepromWriteCount();
+  write_bytes = simGetEepromWriteBytes();
+  for (uint32_t i=0; i<100; i++)
+  {
+    eeprom_write_byte(p_addr, (uint8_t)(orig + 1U + i));
+  }
+  sim_eeprom_flush();
+  eepromRead((uint32_t)(uintptr_t)p_addr, chip, 1);
+  printf("  repeat  : 100 writes -> %lu page write, %lu B\n",
+         (unsigned long)(simGetEepromWriteCount() - write_cnt), (unsigned long)(simGetEepromWriteBytes() - write_bytes));
+  if (simGetEepromWriteCount() - write_cnt != 1 || simGetEepromWriteBytes() - write_bytes != 1 || chip[0] != (uint8_t)(orig + 100U))
+  {
+    printf("  repeated writes not coalesced\n");
+    ret = false;
+  }
+
+  // 3) 미러와 같은 값 쓰기는 표시하지 않는다
+  eeprom_write_byte(p_addr, (uint8_t)(orig + 100U));
+  if (eeprom_is_pending() == true)
+  {
+    printf("  same-value write marked dirty\n");
+    ret = false;
+  }
+
+  eeprom_write_byte(p_addr, orig);
+  for (uint16_t i=0; i<size; i++)
+  {
+    keymap[i] ^= 0x5A;
+  }
+  dynamic_keymap_set_buffer(0, size, keymap);
+  sim_eeprom_flush();
+  return ret;
+}
+
+// V261019R4: 전체 키맵(탭할 키 제외)을 바꾼 직후 탭 1회. pending 이 아니면 기록 없는 기준 탭.
+//   press 리포트 지연(누름 → 리포트)과 qmkUpdate() 1회 최대 정지 시간을 돌려준다.
+static bool sim_eeprom_tap(keypos_t key, uint8_t usage, bool pending, uint32_t *p_press_us, uint32_t *p_flush_ms, uint32_t *p_write_cnt)
+{
+  static uint8_t keymap[BULK_RAW_MAX];
+  uint16_t       size = bulk_region_size(BULK_REGION_KEYMAP);
+  uint16_t       skip = key.row * MATRIX_COLS + key.col;          // 탭할 키(레이어 0)의 키코드는 그대로 둔다
+  uint32_t       begin_us;
+
+  sim_eeprom_flush();
+  if (pending == true)
+  {
+    dynamic_keymap_get_buffer(0, size, keymap);
+    for (uint16_t i=0; i<size; i++)
+    {
+      keymap[i] ^= i / 2U == skip ? 0x00 : 0x5A;
+    }
+    dynamic_keymap_set_buffer(0, size, keymap);
+  }
+  simClearReports();
+  simClearUpdateMaxUs();
+  begin_us     = simGetTimeUs();
+  *p_write_cnt = simGetEepromWriteCount();
+
+  simRunUs(SIM_EEPROM_TAP_DELAY_US, SIM_LOOP_STEP_US);
+
+  uint32_t press_us = simGetTimeUs();
+
+  simSetKey(key.row, key.col, true);
+  simRunUs(SIM_EEPROM_TAP_US, SIM_LOOP_STEP_US);
+  simSetKey(key.row, key.col, false);
+  simRunUs(SIM_EEPROM_TAP_US, SIM_LOOP_STEP_US);
+  sim_eeprom_flush();
+  *p_flush_ms  = (simGetTimeUs() - begin_us) / 1000U;
+  *p_write_cnt = simGetEepromWriteCount() - *p_write_cnt;
+
+  int32_t press_idx = sim_find_report(0, usage, true);
+
+  if (press_idx < 0 || sim_find_report((uint32_t)press_idx + 1U, usage, false) < 0)
+  {
+    printf("  tap lost while writing EEPROM\n");
+    return false;
+  }
+  *p_press_us = simGetReport((uint32_t)press_idx)->time_us - press_us;
+
+  if (pending == true)
+  {
+    for (uint16_t i=0; i<size; i++)
+    {
+      keymap[i] ^= i / 2U == skip ? 0x00 : 0x5A;
+    }
+    dynamic_keymap_set_buffer(0, size, keymap);
+    sim_eeprom_flush();
+  }
+  return true;
+}
+
+// V261019R4: 키맵 전체(약 38페이지) 기록 중 탭이 기준 탭과 같은 지연으로 나가는지, 루프가 멈추지 않는지 확인한다.
+//   blocking 은 V261019R3 까지처럼 페이지 쓰기가 전송 + tWR 동안 호출자를 막는 모델이다.
+bool sim_scenario_eeprom_async(void)
+{
+  keypos_t key;
+  uint8_t  usage;
+  uint32_t base_us, press_us, flush_ms, write_cnt;
+  uint32_t block_us;
+  bool     ret = true;
+
+  if (sim_pick_alpha_keys(&key, &usage, 1) != 1)
+  {
+    printf("  no alpha key in layer 0\n");
+    return false;
+  }
+  simRunUs(SIM_BOOT_SETTLE_US, SIM_LOOP_STEP_US);
+
+  if (sim_eeprom_tap(key, usage, false, &base_us, &flush_ms, &write_cnt) != true)
+  {
+    return false;
+  }
+  printf("  idle    : press %lu us\n", (unsigned long)base_us);
+
+  for (int32_t blocking=1; blocking>=0; blocking--)
+  {
+    simSetEepromBlocking(blocking == 1);
+    if (sim_eeprom_tap(key, usage, true, &press_us, &flush_ms, &write_cnt) != true)
+    {
+      ret = false;
+      break;
+    }
+    block_us = simGetUpdateMaxUs();
+    printf("  %-8s: press %lu us, max loop block %lu us, %lu page writes in %lu ms\n",
+           blocking ? "blocking" : "async",
+           (unsigned long)press_us, (unsigned long)block_us,
+           (unsigned long)write_cnt, (unsigned long)flush_ms);
+
+    if (blocking == 0 && (block_us > 0 || press_us > base_us + SIM_LOOP_STEP_US))
+    {
+      printf("  EEPROM write delayed the key path\n");
+      ret = false;
+    }
+  }
+
+  simSetEepromBlocking(false);
+  return ret;
+}
+
+// V261019R5: 전원 인가 때부터 눌린 키로 eeprom_init() 을 다시 돌려 부팅 → 첫 리포트 시간을 잰다.
+//   legacy 는 V261019R4 까지처럼 바이트마다 1바이트 전송으로 4KB 전체를 두 번(hwInit, qmkInit) 읽은 뒤 스캔한다.
+static bool sim_eeprom_boot(keypos_t key, uint8_t usage, bool legacy, uint32_t *p_init_us, uint32_t *p_first_us)
+{
+  uint32_t begin_us;
+  int32_t  press_idx;
+
+  sim_eeprom_flush();
+  simClearReports();
+  simSetEepromLegacyRead(legacy);
+  begin_us = simGetTimeUs();
+  simSetKey(key.row, key.col, true);
+  if (legacy == true)
+  {
+    for (uint32_t i=0; i<2; i++)
+    {
+      eeprom_init();
+      eeprom_load_all();
+    }
+  }
+  else
+  {
+    eeprom_init();
+  }
+  *p_init_us = simGetTimeUs() - begin_us;
+  simSetEepromLegacyRead(false);
+
+  simRunUs(SIM_EEPROM_TAP_US, SIM_LOOP_STEP_US);
+  simSetKey(key.row, key.col, false);
+  simRunUs(SIM_EEPROM_TAP_US, SIM_LOOP_STEP_US);
+
+  press_idx = sim_find_report(0, usage, true);
+  if (press_idx < 0)
+  {
+    printf("  first report missing (%s)\n", legacy ? "legacy" : "priority");
+    return false;
+  }
+  *p_first_us = simGetReport((uint32_t)press_idx)->time_us - begin_us;
+  return true;
+}
+
+// V261019R5: 우선 구간만 읽고 스캔을 시작해 첫 리포트가 앞당겨지는지, 나머지가 루프를 막지 않고 채워져
+//   미러 == 칩인지, 적재 전 접근이 그 페이지 하나만 읽는지 확인한다.
+bool sim_scenario_eeprom_boot(void)
+{
+  static uint8_t     mirror[TOTAL_EEPROM_BYTE_COUNT];
+  keypos_t           key;
+  uint8_t            usage;
+  uint32_t           init_us[2], first_us[2];
+  eeprom_load_info_t info;
+  bool               ret = true;
+
+  if (sim_pick_alpha_keys(&key, &usage, 1) != 1)
+  {
+    printf("  no alpha key in layer 0\n");
+    return false;
+  }
+  simRunUs(SIM_BOOT_SETTLE_US, SIM_LOOP_STEP_US);
+
+  for (uint32_t legacy=0; legacy<2; legacy++)
+  {
+    if (sim_eeprom_boot(key, usage, legacy == 0, &init_us[legacy], &first_us[legacy]) != true)
+    {
+      return false;
+    }
+    eeprom_get_load_info(&info);
+    printf("  %-8s: eeprom init %6lu us, first report %6lu us\n",
+           legacy == 0 ? "legacy" : "priority",
+           (unsigned long)init_us[legacy], (unsigned long)first_us[legacy]);
+  }
+  printf("  priority span : %lu B\n", (unsigned long)info.prio_bytes);
+  if (first_us[1] >= first_us[0])
+  {
+    printf("  priority load did not shorten time to first report\n");
+    ret = false;
+  }
+
+  // 백그라운드 적재: 루프 정지 없이 끝나고 미러가 칩과 같아야 한다
+  sim_eeprom_flush();
+  eeprom_init();
+  simClearUpdateMaxUs();
+  uint32_t begin_us = simGetTimeUs();
+
+  while (eeprom_is_loaded() != true && simGetTimeUs() - begin_us < SIM_EEPROM_LOAD_US)
+  {
+    simRunUs(1000, SIM_LOOP_STEP_US);
+  }
+  eeprom_get_load_info(&info);
+  printf("  background    : %lu B loaded in %lu us, max loop block %lu us, on-demand %lu pages\n",
+         (unsigned long)info.loaded, (unsigned long)(simGetTimeUs() - begin_us),
+         (unsigned long)simGetUpdateMaxUs(), (unsigned long)info.lazy_cnt);
+  if (eeprom_is_loaded() != true || simGetUpdateMaxUs() > 0)
+  {
+    printf("  background load incomplete or blocked the loop\n");
+    ret = false;
+  }
+  eeprom_read_block(mirror, (const void *)0, TOTAL_EEPROM_BYTE_COUNT);
+  if (memcmp(mirror, simGetEepromData(), TOTAL_EEPROM_BYTE_COUNT) != 0)
+  {
+    printf("  mirror differs from chip after background load\n");
+    ret = false;
+  }
+
+  // 적재 전 접근: 마지막 페이지 하나만 블로킹으로 읽는다
+  eeprom_init();
+  begin_us = simGetTimeUs();
+
+  uint8_t  value   = eeprom_read_byte((const uint8_t *)(TOTAL_EEPROM_BYTE_COUNT - 1));
+  uint32_t lazy_us = simGetTimeUs() - begin_us;
+
+  eeprom_get_load_info(&info);
+  printf("  on-demand     : last page in %lu us (%lu pages)\n", (unsigned long)lazy_us, (unsigned long)info.lazy_cnt);
+  if (value != simGetEepromData()[TOTAL_EEPROM_BYTE_COUNT - 1] || info.lazy_cnt != 1 ||
+      info.loaded != info.prio_bytes + SIM_EEPROM_PAGE)
+  {
+    printf("  on-demand access did not load exactly its page\n");
+    ret = false;
+  }
+  simRunUs(SIM_EEPROM_LOAD_US, SIM_LOOP_STEP_US);
+
+  // V261020R8: 적재 전 공장 초기화는 남은 구간을 한 번에 읽고 시작해 페이지 단위 블로킹 읽기가 없어야 한다.
+  eeprom_init();
+  begin_us = simGetTimeUs();
+
+  bool     reset_ok = eeprom_apply_factory_defaults(false);
+  uint32_t reset_us = simGetTimeUs() - begin_us;
+
+  eeprom_get_load_info(&info);
+  eeprom_read_block(mirror, (const void *)0, TOTAL_EEPROM_BYTE_COUNT);
+  printf("  factory reset : %lu us, loaded %lu B, on-demand %lu pages\n",
+         (unsigned long)reset_us, (unsigned long)info.loaded, (unsigned long)info.lazy_cnt);
+  if (reset_ok != true || eeprom_is_loaded() != true || info.lazy_cnt != 0 ||
+      memcmp(mirror, simGetEepromData(), TOTAL_EEPROM_BYTE_COUNT) != 0)
+  {
+    printf("  factory reset ran against a partially loaded mirror\n");
+    ret = false;
+  }
+  return ret;
+}
+
+// V261019R6: RGB 모드 단계 + NKRO 토글 한 번 = 변경 1회 (둘 다 고빈도 구간)
+static void sim_wl_change(uint32_t i)
+{
+  if (i % 2U == 0)
+  {
+    rgblight_step();
+  }
+  else
+  {
+    eeconfig_update_keymap(eeconfig_read_keymap() ^ EECONFIG_KEYMAP_NKRO);
+  }
+}
+
+static uint32_t sim_wl_page_write_max(const uint32_t *p_base)
+{
+  uint32_t max = 0;
+
+  for (uint32_t page=0; page<TOTAL_EEPROM_BYTE_COUNT / SIM_EEPROM_PAGE; page++)
+  {
+    uint32_t cnt = simGetEepromPageWriteCount(page) - p_base[page];
+
+    max = cnt > max ? cnt : max;
+  }
+  return max;
+}
+
+// V261019R6: 같은 변경 순서를 I2C 더티 페이지 경로와 QSPI 웨어 레벨링 경로로 돌려 I2C 쓰기 주기,
+//   가장 많이 쓴 EEPROM 페이지/플래시 서브섹터로 본 수명, 정리 횟수와 정지 시간을 비교하고,
+//   eeprom_init() 재적재 뒤 플래시 값이 미러에 돌아오는지, 끌 때 I2C 로 되돌려 쓰는지 확인한다.
+bool sim_scenario_eeprom_wl(void)
+{
+  static uint32_t  page_base[TOTAL_EEPROM_BYTE_COUNT / SIM_EEPROM_PAGE];
+  uint8_t          hot[WEAR_LEVELING_LOGICAL_SIZE];
+  uint32_t         addr, len, hot_len;
+  uint32_t         i2c_cnt, i2c_page_max, wl_i2c_cnt;
+  eeprom_wl_info_t wl_begin, info;
+  sim_qspi_stat_t  q_begin, q;
+  uint32_t         boot_cnt;
+  bool             ret = true;
+
+  simRunUs(SIM_BOOT_SETTLE_US, SIM_LOOP_STEP_US);
+  sim_eeprom_flush();
+
+  // 1) 개선 전: 고빈도 구간도 I2C 더티 페이지로
+  for (uint32_t page=0; page<TOTAL_EEPROM_BYTE_COUNT / SIM_EEPROM_PAGE; page++)
+  {
+    page_base[page] = simGetEepromPageWriteCount(page);
+  }
+  i2c_cnt = simGetEepromWriteCount();
+  for (uint32_t i=0; i<SIM_WL_I2C_CHANGES; i++)
+  {
+    sim_wl_change(i);
+    simRunUs(SIM_WL_I2C_GAP_US, SIM_LOOP_STEP_US);
+  }
+  sim_eeprom_flush();
+  i2c_cnt      = simGetEepromWriteCount() - i2c_cnt;
+  i2c_page_max = sim_wl_page_write_max(page_base);
+  printf("  i2c     : %u changes -> %lu page writes (tWR %lu ms), hottest page %lu cycles, life %lu changes\n",
+         SIM_WL_I2C_CHANGES, (unsigned long)i2c_cnt,
+         (unsigned long)(i2c_cnt * SIM_EEPROM_TWR_US / 1000U),
+         (unsigned long)i2c_page_max,
+         (unsigned long)(i2c_page_max > 0 ? SIM_WL_EEPROM_CYCLES * SIM_WL_I2C_CHANGES / i2c_page_max : 0));
+
+  // 2) 웨어 레벨링: 같은 변경이 I2C 를 쓰지 않고 플래시 로그에 쌓인다
+  if (eeprom_set_wl_enable(true) != true)
+  {
+    printf("  wear-leveling enable failed\n");
+    return false;
+  }
+  eeprom_wl_get_info(&wl_begin);
+  simGetQspiStat(&q_begin);
+  simClearUpdateMaxUs();
+  wl_i2c_cnt = simGetEepromWriteCount();
+  for (uint32_t i=0; i<SIM_WL_CHANGES; i++)
+  {
+    sim_wl_change(i);
+    simRunUs(SIM_WL_GAP_US, SIM_LOOP_STEP_US);
+  }
+  sim_eeprom_flush();
+  wl_i2c_cnt = simGetEepromWriteCount() - wl_i2c_cnt;
+  eeprom_wl_get_info(&info);
+  simGetQspiStat(&q);
+  printf("  flash   : %u changes -> %lu entries, %lu B programmed, %lu consolidations, %lu erases, i2c %lu page writes\n",
+         SIM_WL_CHANGES,
+         (unsigned long)(info.entry_cnt - wl_begin.entry_cnt),
+         (unsigned long)(q.program_bytes - q_begin.program_bytes),
+         (unsigned long)(info.consolidate_cnt - wl_begin.consolidate_cnt),
+         (unsigned long)(q.erase_cnt - q_begin.erase_cnt),
+         (unsigned long)wl_i2c_cnt);
+  printf("  flash   : busy %lu us (%lu us/change), commit max %lu us, loop block max %lu us, life %lu changes\n",
+         (unsigned long)(q.busy_us - q_begin.busy_us),
+         (unsigned long)((q.busy_us - q_begin.busy_us) / SIM_WL_CHANGES),
+         (unsigned long)info.commit_max_us,
+         (unsigned long)simGetUpdateMaxUs(),
+         (unsigned long)(q.erase_max > 0 ? SIM_WL_FLASH_CYCLES * SIM_WL_CHANGES / q.erase_max : 0));
+  if (wl_i2c_cnt != 0 || info.consolidate_cnt == wl_begin.consolidate_cnt || q.violate_cnt != 0 ||
+      info.fail_cnt != 0 || info.log_used > info.log_size)
+  {
+    printf("  expected no i2c writes, at least one consolidation, no program-over-0 (%lu) and no failures\n",
+           (unsigned long)q.violate_cnt);
+    ret = false;
+  }
+
+  // 3) 재적재: I2C 는 변경 전 값이지만 플래시 값이 미러에 돌아와야 한다
+  hot_len = 0;
+  for (uint32_t i=0; eeprom_wl_get_span(i, &addr, &len) == true; i++)
+  {
+    eeprom_read_block(&hot[hot_len], (const void *)(uintptr_t)addr, len);
+    hot_len += len;
+  }
+  boot_cnt = info.boot_cnt;
+  eeprom_init();
+  eeprom_wl_get_info(&info);
+  hot_len = 0;
+  for (uint32_t i=0; eeprom_wl_get_span(i, &addr, &len) == true; i++)
+  {
+    for (uint32_t j=0; j<len; j++)
+    {
+      if (eeprom_read_byte((const uint8_t *)(uintptr_t)(addr + j)) != hot[hot_len + j])
+      {
+        printf("  reload lost flash value at %lu\n", (unsigned long)(addr + j));
+        ret = false;
+        break;
+      }
+    }
+    hot_len += len;
+  }
+  printf("  reload  : %lu B from flash, boot count %lu -> %lu, log %lu/%lu B\n",
+         (unsigned long)hot_len, (unsigned long)boot_cnt, (unsigned long)info.boot_cnt,
+         (unsigned long)info.log_used, (unsigned long)info.log_size);
+  if (info.boot_cnt != boot_cnt + 1U)
+  {
+    printf("  boot counter not advanced\n");
+    ret = false;
+  }
+
+  // 4) 끄기: 플래시에만 있던 값이 I2C 로 내려가고 다음 부팅은 I2C 값으로 다시 채운다
+  eeprom_set_wl_enable(false);
+  sim_eeprom_flush();
+  for (uint32_t i=0; eeprom_wl_get_span(i, &addr, &len) == true; i++)
+  {
+    for (uint32_t j=0; j<len; j++)
+    {
+      if (simGetEepromData()[addr + j] != eeprom_read_byte((const uint8_t *)(uintptr_t)(addr + j)))
+      {
+        printf("  disable did not write back %lu\n", (unsigned long)(addr + j));
+        ret = false;
+        break;
+      }
+    }
+  }
+  return ret;
+}
+
+// V261019R7: 캐시 없이 위에서부터 레이어를 훑는 기준 해석 (probe 는 읽은 레이어 수)
+static uint8_t sim_keycache_ref(layer_state_t layers, keypos_t key, uint16_t *p_keycode, uint32_t *p_probe)
+{
+  for (int8_t i=MAX_LAYER - 1; i>=0; i--)
+  {
+    if (layers & ((layer_state_t)1 << i))
+    {
+      uint16_t keycode = keymap_key_to_keycode(i, key);
+
+      (*p_probe)++;
+      if (action_for_keycode(keycode).code != ACTION_TRANSPARENT)
+      {
+        *p_keycode = keycode;
+        return i;
+      }
+    }
+  }
+  *p_keycode = keymap_key_to_keycode(0, key);
+  return 0;
+}
+
+static uint32_t sim_keycache_compare(void)
+{
+  uint32_t      mismatch = 0;
+  uint32_t      probe    = 0;
+  layer_state_t layers   = layer_state | default_layer_state;
+
+  for (uint8_t row=0; row<MATRIX_ROWS; row++)
+  {
+    for (uint8_t col=0; col<MATRIX_COLS; col++)
+    {
+      keypos_t key = {.row = row, .col = col};
+      uint16_t ref_keycode;
+      uint8_t  ref_layer = sim_keycache_ref(layers, key, &ref_keycode, &probe);
+      uint8_t  layer     = layer_switch_get_layer(key);
+
+      if (layer != ref_layer || layer_switch_get_keycode(layer, key) != ref_keycode)
+      {
+        if (mismatch == 0)
+        {
+          printf("  mismatch r%u c%u : layer %u/%u keycode 0x%04X/0x%04X\n",
+                 row, col, layer, ref_layer, layer_switch_get_keycode(layer, key), ref_keycode);
+        }
+        mismatch++;
+      }
+    }
+  }
+  return mismatch;
+}
+
+// 레이어 1 이상은 대부분 투명, 일부만 알파벳 키로 채운 깊은 레이어 스택
+static void sim_keycache_fill_layers(uint32_t *p_seed)
+{
+  for (uint8_t layer=1; layer<MAX_LAYER; layer++)
+  {
+    for (uint8_t row=0; row<MATRIX_ROWS; row++)
+    {
+      for (uint8_t col=0; col<MATRIX_COLS; col++)
+      {
+        uint32_t r       = sim_rand(p_seed);
+        uint16_t keycode = (r % 8) == 0 ? (uint16_t)(KC_A + (r >> 8) % 26) : KC_TRNS;
+
+        dynamic_keymap_set_keycode(layer, row, col, keycode);
+      }
+    }
+  }
+}
+
+static uint64_t sim_keycache_bench(void)
+{
+  uint64_t begin = simGetHostNs();
+  uint32_t sum   = 0;
+
+  for (uint32_t pass=0; pass<SIM_KEYCACHE_BENCH_PASS; pass++)
+  {
+    for (uint8_t row=0; row<MATRIX_ROWS; row++)
+    {
+      for (uint8_t col=0; col<MATRIX_COLS; col++)
+      {
+        keypos_t key = {.row = row, .col = col};
+
+        sum += layer_switch_get_keycode(layer_switch_get_layer(key), key);
+      }
+    }
+  }
+  if (sum == 0xFFFFFFFF)
+  {
+    printf("  bench sum %lu\n", (unsigned long)sum);              // 최적화로 루프가 사라지지 않도록 결과를 사용
+  }
+  return (simGetHostNs() - begin) / ((uint64_t)SIM_KEYCACHE_BENCH_PASS * MATRIX_ROWS * MATRIX_COLS);
+}
+
+// V261019R7: 무작위 레이어 상태/키맵 쓰기에서 해석 캐시가 기준 해석과 같은지, 아래 레이어 변경 시
+//   위에서 해석된 위치를 남기는지, 깊은 스택 조회 비용, MO 레이어 키 입력의 press/release 키코드를 확인한다.
+bool sim_scenario_keycache(void)
+{
+  const layer_state_t all_layers = (layer_state_t)(((uint32_t)1 << MAX_LAYER) - 1);
+  keymap_cache_info_t info_begin, info;
+  uint32_t            seed     = 0x4B43u;
+  uint32_t            mismatch = 0;
+  uint32_t            probe    = 0;
+  keypos_t            keys[2];
+  uint8_t             usages[2];
+  bool                ret = true;
+
+  if (sim_pick_alpha_keys(keys, usages, 2) != 2)
+  {
+    printf("  no alpha key in layer 0\n");
+    return false;
+  }
+
+  simRunUs(SIM_BOOT_SETTLE_US, SIM_LOOP_STEP_US);
+  sim_keycache_fill_layers(&seed);
+
+  // 1) 무작위 레이어 상태, 키맵 단일/버퍼 쓰기, 백그라운드 채우기를 섞어도 기준 해석과 같아야 한다
+  for (uint32_t round=0; round<SIM_KEYCACHE_ROUNDS; round++)
+  {
+    uint32_t r = sim_rand(&seed);
+
+    if ((round % 16) == 0)
+    {
+      default_layer_set((layer_state_t)1 << (r % 2));
+    }
+    layer_state_set((layer_state_t)(sim_rand(&seed) & all_layers));
+    if ((round % 4) == 0)
+    {
+      uint8_t  layer   = (uint8_t)(r % MAX_LAYER);
+      uint8_t  row     = (uint8_t)((r >> 8) % MATRIX_ROWS);
+      uint8_t  col     = (uint8_t)((r >> 16) % MATRIX_COLS);
+      uint16_t keycode = (r & 0x01000000) ? KC_TRNS : (uint16_t)(KC_A + (r >> 25) % 26);
+
+      dynamic_keymap_set_keycode(layer, row, col, keycode);
+    }
+    if ((round % 32) == 0)
+    {
+      uint8_t  buf[SIM_EEPROM_VIA_CHUNK];
+      uint16_t offset = (uint16_t)((sim_rand(&seed) % (MAX_LAYER * MATRIX_ROWS * MATRIX_COLS)) * 2);
+
+      for (uint32_t i=0; i<sizeof(buf); i+=2)
+      {
+        buf[i]     = 0;
+        buf[i + 1] = (sim_rand(&seed) % 2) ? KC_TRNS : (uint8_t)(KC_A + i / 2);
+      }
+      dynamic_keymap_set_buffer(offset, sizeof(buf), buf);
+    }
+    for (uint32_t i=0; i<(r >> 28); i++)
+    {
+      keymap_cache_task();
+    }
+    mismatch += sim_keycache_compare();
+  }
+  printf("  compare : %u rounds x %u positions, %lu mismatch\n",
+         SIM_KEYCACHE_ROUNDS, MATRIX_ROWS * MATRIX_COLS, (unsigned long)mismatch);
+  if (mismatch != 0)
+  {
+    ret = false;
+  }
+
+  // 2) 위쪽 레이어가 켜진 채 아래 레이어만 바뀌면 그 위에서 해석된 위치는 남는다
+  default_layer_set((layer_state_t)1 << 0);
+  layer_state_set(all_layers);
+  for (uint32_t i=0; i<MATRIX_ROWS; i++)
+  {
+    keymap_cache_task();
+  }
+  keymap_cache_get_info(&info_begin);
+  layer_state_set(all_layers & ~((layer_state_t)1 << 1));
+  mismatch = sim_keycache_compare();
+  keymap_cache_get_info(&info);
+  printf("  layer 1 off under %u layers : %lu / %u positions re-resolved, %lu mismatch\n",
+         MAX_LAYER, (unsigned long)(info.drop_cnt - info_begin.drop_cnt), MATRIX_ROWS * MATRIX_COLS, (unsigned long)mismatch);
+  if (mismatch != 0 || info.drop_cnt - info_begin.drop_cnt >= (uint32_t)(MATRIX_ROWS * MATRIX_COLS))
+  {
+    printf("  partial re-resolve failed\n");
+    ret = false;
+  }
+
+  // 3) 모든 레이어가 켜진 깊은 스택에서 조회 비용
+  layer_state_set(all_layers);
+  for (uint8_t row=0; row<MATRIX_ROWS; row++)
+  {
+    for (uint8_t col=0; col<MATRIX_COLS; col++)
+    {
+      keypos_t key = {.row = row, .col = col};
+      uint16_t keycode;
+
+      sim_keycache_ref(all_layers, key, &keycode, &probe);
+    }
+  }
+  keymap_cache_set_enable(false);
+  uint64_t off_ns = sim_keycache_bench();
+  keymap_cache_set_enable(true);
+  uint64_t on_ns  = sim_keycache_bench();
+
+  printf("  lookup  : %u layers on, %lu.%lu layers probed (%lu.%lu B EEPROM) per uncached lookup\n",
+         MAX_LAYER,
+         (unsigned long)(probe / (MATRIX_ROWS * MATRIX_COLS)), (unsigned long)(probe * 10 / (MATRIX_ROWS * MATRIX_COLS) % 10),
+         (unsigned long)(probe * 2 / (MATRIX_ROWS * MATRIX_COLS)), (unsigned long)(probe * 20 / (MATRIX_ROWS * MATRIX_COLS) % 10));
+  printf("  host    : cache off %llu ns, cache on %llu ns per lookup\n",
+         (unsigned long long)off_ns, (unsigned long long)on_ns);
+
+  // 4) 실제 이벤트: MO(1) 를 누른 채 누른 키는 레이어 1 키코드로, MO 를 먼저 떼도 같은 키코드로 떼어진다
+  dynamic_keymap_reset();
+  layer_clear();
+  uint8_t alt = usages[1] == KC_Q ? KC_W : KC_Q;
+
+  dynamic_keymap_set_keycode(0, keys[0].row, keys[0].col, MO(1));
+  dynamic_keymap_set_keycode(1, keys[1].row, keys[1].col, alt);
+  simRunUs(20000, SIM_LOOP_STEP_US);
+  simClearReports();
+  keymap_cache_get_info(&info_begin);
+
+  simSetKey(keys[0].row, keys[0].col, true);
+  simRunUs(20000, SIM_LOOP_STEP_US);
+  simSetKey(keys[1].row, keys[1].col, true);
+  simRunUs(20000, SIM_LOOP_STEP_US);
+  simSetKey(keys[0].row, keys[0].col, false);
+  simRunUs(20000, SIM_LOOP_STEP_US);
+  simSetKey(keys[1].row, keys[1].col, false);
+  simRunUs(20000, SIM_LOOP_STEP_US);
+  simSetKey(keys[1].row, keys[1].col, true);
+  simRunUs(20000, SIM_LOOP_STEP_US);
+  simSetKey(keys[1].row, keys[1].col, false);
+  simRunUs(20000, SIM_LOOP_STEP_US);
+
+  int32_t alt_press   = sim_find_report(0, alt, true);
+  int32_t alt_release = alt_press < 0 ? -1 : sim_find_report((uint32_t)alt_press + 1, alt, false);
+  int32_t base_press  = alt_release < 0 ? -1 : sim_find_report((uint32_t)alt_release, usages[1], true);
+
+  keymap_cache_get_info(&info);
+  printf("  events  : MO(1) alt %d/%d, base %d, %lu hit %lu miss\n",
+         alt_press, alt_release, base_press,
+         (unsigned long)(info.hit_cnt - info_begin.hit_cnt), (unsigned long)(info.miss_cnt - info_begin.miss_cnt));
+  if (alt_press < 0 || alt_release < 0 || base_press < 0 || sim_count_reports(0, usages[1], true) != 1)
+  {
+    printf("  layer key events resolved wrong keycode\n");
+    ret = false;
+  }
+  if (sim_report_is_empty(simGetReport(simGetReportCount() - 1)) != true)
+  {
+    printf("  last report is not empty\n");
+    ret = false;
+  }
+
+  dynamic_keymap_reset();
+  sim_eeprom_flush();
+  return ret;
+}
+
+int main(int argc, char **argv)
+{
+  const char *name = "all";
+  uint32_t    fail = 0;
+  uint32_t    run  = 0;
+
+  for (int i=1; i<argc; i++)
+  {
+    if (strcmp(argv[i], "-v") == 0)
+    {
+      simSetLogEnable(true);
+    }
+    else
+    {
+      name = argv[i];
+    }
+  }
+
+  simInit();
+
+  for (uint32_t i=0; i<sizeof(sim_scenarios)/sizeof(sim_scenarios[0]); i++)
+  {
+    const sim_scenario_t *p_scenario = &sim_scenarios[i];
+
+    if (strcmp(name, "all") != 0 && strcmp(name, p_scenario->name) != 0)
+    {
+      continue;
+    }
+
+    printf("[%s] %s\n", p_scenario->name, p_scenario->desc);
+    bool ret = p_scenario->func();
+    printf("[%s] %s\n", p_scenario->name, ret ? "PASS" : "FAIL");
+
+    run++;
+    if (ret != true)
+    {
+      fail++;
+    }
+  }
+
+  if (run == 0)
+  {
+    printf("usage : qmk-sim [-v] [all");
+    for (uint32_t i=0; i<sizeof(sim_scenarios)/sizeof(sim_scenarios[0]); i++)
+    {
+      printf("|%s", sim_scenarios[i].name);
+    }
+    printf("]\n");
+    return 2;
+  }
+
+  return fail == 0 ? 0 : 1;
+}
@@ -0,0 +1,637 @@
+#include "sim.h"
+
+
+#include <string.h>
+#include "usb.h"
+#include "usbd_def.h"
+#include "usbd_hid_sof_mon.h"
+
+
+// ---------------------------------------------------------------------------
+// [Host Sim] V261020R7: SOF 감시 기준 구현 (V261018R8 usbd_hid.c 동결 사본)
+//   - usbd_hid_sof_mon.c 로 옮기기 전 ISR 평가 코드를 그대로 두고 sof_batch 가 판정을 맞춰 본다.
+//   - 바꾼 곳: pdev 는 샘플의 장치 상태/속도/서스펜드, 다운그레이드 요청은 콜백, 로그와 열거 감시 제외,
+//     usbHidMonitorBackgroundTick() 은 공개 선언과 겹치지 않게 sim_ref_background_tick() 으로 이름만 바꿈
+//     (열거 감시는 usbd_hid.c 에 그대로 남아 있어 비교 대상이 아니다).
+//   - 이 파일은 고치지 않는다. 감시 동작을 바꾸면 sof_batch 가 차이를 보고한다.
+// ---------------------------------------------------------------------------
+
+
+enum
+{
+  USB_SOF_MONITOR_CONFIG_HOLDOFF_MS   = 50U,                                               // V251108R9 재협상/재개 지연 최소화
+  USB_SOF_MONITOR_WARMUP_TIMEOUT_MS   = USB_SOF_MONITOR_CONFIG_HOLDOFF_MS + USB_BOOT_MONITOR_CONFIRM_DELAY_MS, // V250924R3 워밍업 최대 시간(ms)
+  USB_SOF_MONITOR_WARMUP_FRAMES_HS    = 2048U,                                             // V250924R3 HS 안정성 확인 프레임 수
+  USB_SOF_MONITOR_WARMUP_FRAMES_FS    = 128U,                                              // V250924R3 FS 안정성 확인 프레임 수
+  USB_SOF_MONITOR_CONFIG_HOLDOFF_US   = USB_SOF_MONITOR_CONFIG_HOLDOFF_MS * 1000UL,        // 구성 직후 워밍업 지연(us)
+  USB_SOF_MONITOR_WARMUP_TIMEOUT_US   = USB_SOF_MONITOR_WARMUP_TIMEOUT_MS * 1000UL,        // 워밍업 최대 시간(us)
+  USB_SOF_MONITOR_RESUME_HOLDOFF_US   = 50U * 1000UL,                                      // V251108R9 일시중지 해제 후 감시 재개 지연(us)
+  USB_SOF_MONITOR_RECOVERY_DELAY_US   = 50U * 1000UL,                                      // 다운그레이드 실패 후 지연(us)
+  USB_SOF_MONITOR_NO_SOF_TIMEOUT_FACTOR = 64U,                                            // V251108R9 SOF 누락 감시용 시간 배수
+  USB_ENUM_MONITOR_ATTEMPT_TIMEOUT_MS = 250U,                                             // V251109R1 열거 시도 타임아웃(ms)
+  USB_ENUM_MONITOR_FAIL_THRESHOLD     = 3U,                                               // V251109R1 열거 실패 다운그레이드 임계
+  USB_ENUM_MONITOR_SCORE_CAP          = 5U,                                               // V251109R1 열거 실패 점수 상한
+  USB_ENUM_MONITOR_RECOVERY_MS        = 1000U,                                            // V251109R1 열거 안정 여부 감쇠(ms)
+  USB_SOF_MONITOR_SPEED_WINDOW_US     = 1000U * 1000UL,                                   // V251109R2 HS 재협상 평균 재시도(≤1s)에 맞춘 윈도우
+  USB_SOF_MONITOR_SPEED_THRESHOLD     = 3U,                                               // V251109R2 1초 내 3회 이상이면 비정상으로 간주
+  USB_SOF_MONITOR_SUSPEND_WINDOW_US   = 1500U * 1000UL,                                   // V251109R2 Selective Suspend 허용 간격(>1.5s)
+  USB_SOF_MONITOR_SUSPEND_THRESHOLD   = 3U,                                               // V251109R2 1.5s 내 3회 서스펜드는 비정상
+  USB_SOF_MONITOR_PERSISTENT_THRESHOLD = 3U,                                              // V251109R2 영구 점수 임계 (세 번째 이벤트에서 다운그레이드)
+  USB_SOF_MONITOR_WARMUP_GRACE_US     = 200U * 1000UL,                                    // V251109R2 워밍업 완화 기간(us)
+  USB_BOOT_MONITOR_CONFIRM_DELAY_US   = USB_BOOT_MONITOR_CONFIRM_DELAY_MS * 1000UL          // 다운그레이드 확인 대기(us)
+};
+
+#define USB_ENUM_MONITOR_ATTEMPT_TIMEOUT_US (USB_ENUM_MONITOR_ATTEMPT_TIMEOUT_MS * 1000UL)
+
+typedef struct
+{
+  uint8_t dev_state;
+  uint8_t dev_speed;
+  bool    suspended;
+} sim_ref_dev_t;
+
+static usb_sof_monitor_t       sof_monitor = {0};                       // V250924R2 SOF 안정성 상태
+static uint8_t                 sof_prev_dev_state = USBD_STATE_DEFAULT; // V250924R2 마지막 USB 장치 상태
+static bool                    sof_prev_suspended = false;              // V251109R2 직전 서스펜드 상태
+static sim_ref_dev_t           sim_ref_dev;
+static hid_sof_mon_downgrade_t sim_ref_downgrade_func = NULL;
+
+static void usbHidMonitorSof(uint32_t now_us);
+static void usbHidMonitorProcessDelta(uint32_t now_us, uint32_t delta_us);
+static void usbHidMonitorPrimeTimeout(uint32_t now_us);
+static bool usbHidMonitorCommitDowngrade(uint32_t      now_us,
+                                         uint32_t      delta_us,
+                                         uint32_t      expected_us,
+                                         usb_monitor_event_t event);
+static void usbHidMonitorHandleSpeedChange(uint32_t now_us);
+static void usbHidMonitorHandleSuspend(uint32_t now_us);
+static void usbHidMonitorBumpPersistent(uint32_t now_us, usb_monitor_event_t event);
+static void usbHidMonitorRefreshEventWindows(uint32_t now_us);
+static void sim_ref_background_tick(uint32_t now_us);
+
+
+
+
+void simSofRefInit(hid_sof_mon_downgrade_t downgrade_func)
+{
+  memset(&sof_monitor, 0, sizeof(sof_monitor));
+  memset(&sim_ref_dev, 0, sizeof(sim_ref_dev));
+  sof_prev_dev_state     = USBD_STATE_DEFAULT;
+  sof_prev_suspended     = false;
+  sim_ref_downgrade_func = downgrade_func;
+}
+
+// USBD_HID_SOF() 대응
+void simSofRefOnSof(const hid_sof_sample_t *p_sample)
+{
+  sim_ref_dev.dev_state = p_sample->dev_state;
+  sim_ref_dev.dev_speed = p_sample->speed;
+  sim_ref_dev.suspended = (p_sample->flags & HID_SOF_FLAG_SUSPENDED) != 0;
+  usbHidMonitorSof(p_sample->now_us);
+}
+
+// usbHidMonitorBackgroundService() 대응
+void simSofRefTick(uint32_t now_us, bool configured, bool suspended)
+{
+  sim_ref_dev.dev_state = configured ? USBD_STATE_CONFIGURED : USBD_STATE_DEFAULT;
+  sim_ref_dev.suspended = suspended;
+  sim_ref_background_tick(now_us);
+}
+
+const usb_sof_monitor_t *simSofRefState(void)
+{
+  return &sof_monitor;
+}
+
+
+static void usbHidSofMonitorApplySpeedParams(uint8_t speed_code)  // V250924R4 속도별 모니터링 파라미터 캐시
+{
+  sof_monitor.active_speed = speed_code;
+
+  switch (speed_code)
+  {
+    case USBD_SPEED_HIGH:
+      sof_monitor.expected_us        = 125U;
+      sof_monitor.stable_threshold_us = 180U;                       // V251108R9 HS 환경 허용 오차 축소
+      sof_monitor.decay_interval_us  = 4000U;
+      sof_monitor.slow_decay_interval_us = 12000U;                  // V251108R9 느린 점수 감쇠 (약 12ms)
+      sof_monitor.degrade_threshold  = 10U;
+      sof_monitor.slow_degrade_threshold = 4U;
+      sof_monitor.event_score_cap    = 6U;
+      sof_monitor.persistent_threshold = USB_SOF_MONITOR_PERSISTENT_THRESHOLD;
+      sof_monitor.warmup_target_frames = USB_SOF_MONITOR_WARMUP_FRAMES_HS;
+      break;
+    case USBD_SPEED_FULL:
+      sof_monitor.expected_us        = 1000U;
+      sof_monitor.stable_threshold_us = 1500U;                      // V251108R9 FS 허용 오차 축소
+      sof_monitor.decay_interval_us  = 20000U;
+      sof_monitor.slow_decay_interval_us = 60000U;                  // V251108R9 느린 점수 감쇠 (약 60ms)
+      sof_monitor.degrade_threshold  = 5U;
+      sof_monitor.slow_degrade_threshold = 3U;
+      sof_monitor.event_score_cap    = 4U;
+      sof_monitor.persistent_threshold = USB_SOF_MONITOR_PERSISTENT_THRESHOLD;
+      sof_monitor.warmup_target_frames = USB_SOF_MONITOR_WARMUP_FRAMES_FS;
+      break;
+    default:
+      sof_monitor.expected_us        = 0U;
+      sof_monitor.stable_threshold_us = 0U;
+      sof_monitor.decay_interval_us  = 0U;
+      sof_monitor.degrade_threshold  = 0U;
+      sof_monitor.slow_decay_interval_us = 0U;
+      sof_monitor.slow_degrade_threshold = 0U;
+      sof_monitor.event_score_cap    = 0U;
+      sof_monitor.persistent_threshold = 0U;
+      sof_monitor.warmup_target_frames = 0U;
+      break;
+  }
+}
+
+static void usbHidMonitorPrimeTimeout(uint32_t now_us)             // V251108R9 SOF 누락 감시 타임아웃 초기화
+{
+  uint32_t guard_window = USB_SOF_MONITOR_WARMUP_TIMEOUT_US;
+
+  if (sof_monitor.expected_us > 0U)
+  {
+    guard_window = sof_monitor.expected_us * USB_SOF_MONITOR_NO_SOF_TIMEOUT_FACTOR;
+    if (guard_window == 0U)
+    {
+      guard_window = sof_monitor.expected_us;
+    }
+  }
+
+  sof_monitor.no_sof_deadline_us = now_us + guard_window;
+}
+
+static void usbHidMonitorSof(uint32_t now_us)
+{
+  sim_ref_dev_t *pdev = &sim_ref_dev;
+
+  if (pdev->dev_state != sof_prev_dev_state)
+  {
+    sof_monitor.prev_tick_us       = now_us;
+    sof_monitor.score              = 0U;
+    sof_monitor.slow_score         = 0U;
+    sof_monitor.last_decay_us      = now_us;
+    sof_monitor.slow_last_decay_us = now_us;
+    sof_monitor.holdoff_end_us =
+        (pdev->dev_state == USBD_STATE_CONFIGURED) ? (now_us + USB_SOF_MONITOR_CONFIG_HOLDOFF_US) : now_us;
+    sof_monitor.warmup_deadline_us =
+        (pdev->dev_state == USBD_STATE_CONFIGURED) ? (now_us + USB_SOF_MONITOR_WARMUP_TIMEOUT_US) : now_us;
+    sof_monitor.warmup_good_frames = 0U;
+    sof_monitor.warmup_complete    = false;
+    usbHidSofMonitorApplySpeedParams((pdev->dev_state == USBD_STATE_CONFIGURED) ? pdev->dev_speed : 0xFFU);
+    usbHidMonitorPrimeTimeout(now_us);
+    sof_monitor.speed_change_count     = 0U;
+    sof_monitor.suspend_count          = 0U;
+    sof_monitor.persistent_score       = 0U;
+    sof_monitor.speed_change_window_us = 0U;          // V251109R3: 이벤트 창을 첫 발생 기준으로 초기화
+    sof_monitor.suspend_window_us      = 0U;          // V251109R3: 서스펜드 창 초기화
+    sof_monitor.warmup_grace_active    = false;
+    sof_monitor.warmup_grace_deadline_us = 0U;
+    sof_prev_dev_state             = pdev->dev_state;
+  }
+
+  if (pdev->dev_state != USBD_STATE_CONFIGURED)
+  {
+    sof_monitor.prev_tick_us       = now_us;
+    sof_monitor.score              = 0U;
+    sof_monitor.slow_score         = 0U;
+    sof_monitor.last_decay_us      = now_us;
+    sof_monitor.slow_last_decay_us = now_us;
+    sof_monitor.holdoff_end_us     = now_us;
+    sof_monitor.warmup_deadline_us = now_us;
+    sof_monitor.warmup_good_frames = 0U;
+    sof_monitor.warmup_complete    = false;
+    usbHidSofMonitorApplySpeedParams(0xFFU);
+    usbHidMonitorPrimeTimeout(now_us);
+    sof_monitor.speed_change_count     = 0U;
+    sof_monitor.suspend_count          = 0U;
+    sof_monitor.persistent_score       = 0U;
+    sof_monitor.speed_change_window_us = 0U;          // V251109R3: 구성 전에는 창을 비활성화
+    sof_monitor.suspend_window_us      = 0U;          // V251109R3
+    sof_monitor.warmup_grace_active    = false;
+    sof_monitor.warmup_grace_deadline_us = 0U;
+    return;
+  }
+
+  bool is_suspended = sim_ref_dev.suspended;
+
+  if (is_suspended)
+  {
+    if (sof_prev_suspended == false)
+    {
+      usbHidMonitorHandleSuspend(now_us);
+    }
+    sof_prev_suspended = true;
+    sof_monitor.prev_tick_us        = now_us;
+    sof_monitor.score               = 0U;
+    if (sof_monitor.slow_score > 0U)
+    {
+      sof_monitor.slow_score--;
+    }
+    sof_monitor.holdoff_end_us      = now_us + USB_SOF_MONITOR_RESUME_HOLDOFF_US;
+    sof_monitor.warmup_deadline_us  = now_us + USB_SOF_MONITOR_WARMUP_TIMEOUT_US;
+    sof_monitor.warmup_good_frames  = 0U;
+    sof_monitor.warmup_complete     = false;
+    sof_monitor.last_decay_us       = now_us;
+    sof_monitor.slow_last_decay_us  = now_us;
+    usbHidSofMonitorApplySpeedParams(pdev->dev_speed);
+    usbHidMonitorPrimeTimeout(now_us);
+    return;
+  }
+  else
+  {
+    sof_prev_suspended = false;
+  }
+
+  if (pdev->dev_speed != USBD_SPEED_HIGH && pdev->dev_speed != USBD_SPEED_FULL)
+  {
+    sof_monitor.prev_tick_us       = now_us;
+    sof_monitor.score              = 0U;
+    sof_monitor.slow_score         = 0U;
+    sof_monitor.last_decay_us      = now_us;
+    sof_monitor.slow_last_decay_us = now_us;
+    sof_monitor.warmup_deadline_us = now_us;
+    sof_monitor.warmup_good_frames = 0U;
+    sof_monitor.warmup_complete    = false;
+    usbHidSofMonitorApplySpeedParams(0xFFU);
+    usbHidMonitorPrimeTimeout(now_us);
+    return;
+  }
+
+  if (pdev->dev_speed != sof_monitor.active_speed)
+  {
+    usbHidMonitorHandleSpeedChange(now_us);
+    usbHidSofMonitorApplySpeedParams(pdev->dev_speed);
+    sof_monitor.score              = 0U;
+    if (sof_monitor.slow_score > 0U)
+    {
+      sof_monitor.slow_score--;
+    }
+    sof_monitor.last_decay_us      = now_us;
+    sof_monitor.slow_last_decay_us = now_us;
+    sof_monitor.holdoff_end_us     = now_us + USB_SOF_MONITOR_CONFIG_HOLDOFF_US;
+    sof_monitor.warmup_deadline_us = now_us + USB_SOF_MONITOR_WARMUP_TIMEOUT_US;
+    sof_monitor.warmup_good_frames = 0U;
+    sof_monitor.warmup_complete    = false;
+    usbHidMonitorPrimeTimeout(now_us);
+  }
+
+  if (sof_monitor.prev_tick_us == 0U)
+  {
+    sof_monitor.prev_tick_us = now_us;
+    sof_monitor.last_decay_us = now_us;
+    sof_monitor.slow_last_decay_us = now_us;
+    usbHidMonitorPrimeTimeout(now_us);
+    return;
+  }
+
+  uint32_t delta_us = now_us - sof_monitor.prev_tick_us;
+  sof_monitor.prev_tick_us = now_us;
+
+  usbHidMonitorProcessDelta(now_us, delta_us);
+}
+
+static void usbHidMonitorProcessDelta(uint32_t now_us, uint32_t delta_us)
+{
+  uint32_t expected_us            = sof_monitor.expected_us;
+  uint32_t stable_threshold       = sof_monitor.stable_threshold_us;
+  uint32_t decay_interval_us      = sof_monitor.decay_interval_us;
+  uint32_t slow_decay_interval_us = sof_monitor.slow_decay_interval_us;
+  uint8_t  degrade_threshold      = sof_monitor.degrade_threshold;
+  uint8_t  slow_degrade_threshold = sof_monitor.slow_degrade_threshold;
+  uint8_t  event_score_cap        = sof_monitor.event_score_cap;
+  uint16_t warmup_target_frames   = sof_monitor.warmup_target_frames;
+
+  if (expected_us == 0U)
+  {
+    return;
+  }
+
+  usbHidMonitorPrimeTimeout(now_us);                               // V251108R9 SOF 누락 감시 타임아웃 갱신
+
+  if (now_us < sof_monitor.holdoff_end_us)
+  {
+    sof_monitor.last_decay_us      = now_us;
+    sof_monitor.slow_last_decay_us = now_us;
+    return;
+  }
+
+  if (sof_monitor.warmup_complete == false)
+  {
+    if (sof_monitor.warmup_grace_active)
+    {
+      if (now_us <= sof_monitor.warmup_grace_deadline_us)
+      {
+        warmup_target_frames = (uint16_t)(warmup_target_frames / 2U);
+        if (warmup_target_frames == 0U)
+        {
+          warmup_target_frames = 1U;
+        }
+      }
+      else
+      {
+        sof_monitor.warmup_grace_active = false;
+      }
+    }
+
+    if (delta_us < stable_threshold)
+    {
+      if (sof_monitor.warmup_good_frames < warmup_target_frames)
+      {
+        sof_monitor.warmup_good_frames++;
+      }
+    }
+    else
+    {
+      sof_monitor.warmup_good_frames = 0U;
+    }
+
+    if (sof_monitor.warmup_good_frames >= warmup_target_frames || now_us >= sof_monitor.warmup_deadline_us)
+    {
+      sof_monitor.warmup_complete   = true;
+      sof_monitor.last_decay_us     = now_us;
+      sof_monitor.slow_last_decay_us = now_us;
+      sof_monitor.warmup_grace_active = false;
+    }
+    else
+    {
+      return;
+    }
+  }
+
+  if (delta_us < stable_threshold)
+  {
+    if (sof_monitor.score > 0U && decay_interval_us > 0U)
+    {
+      if ((now_us - sof_monitor.last_decay_us) >= decay_interval_us)
+      {
+        sof_monitor.score--;
+        sof_monitor.last_decay_us = now_us;
+      }
+    }
+
+    if (sof_monitor.slow_score > 0U && slow_decay_interval_us > 0U)
+    {
+      if ((now_us - sof_monitor.slow_last_decay_us) >= slow_decay_interval_us)
+      {
+        sof_monitor.slow_score--;
+        sof_monitor.slow_last_decay_us = now_us;
+      }
+    }
+    return;
+  }
+
+  uint32_t missed_frames = (delta_us + expected_us - 1U) / expected_us;
+  uint8_t  delta_score   = 1U;
+  uint32_t burst_points  = 0U;
+
+  if (missed_frames > 1U)
+  {
+    burst_points = missed_frames - 1U;
+  }
+
+  if (burst_points > event_score_cap)
+  {
+    burst_points = event_score_cap;
+  }
+
+  if (burst_points > 0U)
+  {
+    if (burst_points > 0xFFU)
+    {
+      burst_points = 0xFFU;
+    }
+    delta_score = (uint8_t)burst_points;
+  }
+
+  if (delta_score < 1U)
+  {
+    delta_score = 1U;
+  }
+
+  if (sof_monitor.score <= (uint8_t)(0xFFU - delta_score))
+  {
+    sof_monitor.score += delta_score;
+  }
+  else
+  {
+    sof_monitor.score = 0xFFU;
+  }
+
+  sof_monitor.last_decay_us = now_us;
+
+  if (sof_monitor.slow_score < 0xFFU)
+  {
+    sof_monitor.slow_score++;
+  }
+  sof_monitor.slow_last_decay_us = now_us;
+
+  bool need_degrade = false;
+
+  if (degrade_threshold > 0U && sof_monitor.score >= degrade_threshold)
+  {
+    need_degrade = true;
+  }
+
+  if (slow_degrade_threshold > 0U && sof_monitor.slow_score >= slow_degrade_threshold)
+  {
+    need_degrade = true;
+  }
+
+  if (need_degrade == false)
+  {
+    return;
+  }
+
+  (void)usbHidMonitorCommitDowngrade(now_us, delta_us, expected_us, USB_MONITOR_EVENT_SOF);
+}
+
+static bool usbHidMonitorCommitDowngrade(uint32_t      now_us,
+                                         uint32_t      delta_us,
+                                         uint32_t      expected_us,
+                                         usb_monitor_event_t event)
+{
+  bool downgrade_requested = false;
+
+  // 원본: usbHidResolveDowngradeTarget() + usbRequestBootModeDowngrade() 가 ARMED/CONFIRMED 인지
+  if (sim_ref_downgrade_func != NULL)
+  {
+    downgrade_requested = sim_ref_downgrade_func(now_us, delta_us, expected_us, event);
+  }
+
+  if (downgrade_requested)
+  {
+    sof_monitor.holdoff_end_us = now_us + USB_BOOT_MONITOR_CONFIRM_DELAY_US;
+  }
+  else
+  {
+    sof_monitor.holdoff_end_us = now_us + USB_SOF_MONITOR_RECOVERY_DELAY_US;
+  }
+
+  sof_monitor.score      = 0U;
+  sof_monitor.slow_score = 0U;
+  sof_monitor.persistent_score = 0U;
+  sof_monitor.speed_change_count = 0U;
+  sof_monitor.suspend_count = 0U;
+  sof_monitor.speed_change_window_us = 0U;            // V251109R3: 새 이벤트까지만 창 유지
+  sof_monitor.suspend_window_us = 0U;                 // V251109R3
+  sof_monitor.warmup_grace_active = false;
+
+  return downgrade_requested;
+}
+
+static void usbHidMonitorBumpPersistent(uint32_t now_us, usb_monitor_event_t event)
+{
+  if (sof_monitor.persistent_score < 0xFFU)
+  {
+    sof_monitor.persistent_score++;
+  }
+
+  if (sof_monitor.persistent_threshold == 0U)
+  {
+    return;
+  }
+
+  if (sof_monitor.persistent_score >= sof_monitor.persistent_threshold)
+  {
+    uint32_t expected_us = (sof_monitor.expected_us > 0U) ? sof_monitor.expected_us : 125U;
+    uint32_t delta_us = USB_ENUM_MONITOR_ATTEMPT_TIMEOUT_US;
+
+    if (event == USB_MONITOR_EVENT_SPEED)
+    {
+      delta_us = USB_SOF_MONITOR_SPEED_WINDOW_US;
+    }
+    else if (event == USB_MONITOR_EVENT_SUSPEND)
+    {
+      delta_us = USB_SOF_MONITOR_SUSPEND_WINDOW_US;
+    }
+
+    (void)usbHidMonitorCommitDowngrade(now_us, delta_us, expected_us, event);
+  }
+}
+
+static void usbHidMonitorHandleSpeedChange(uint32_t now_us)
+{
+  if (sof_monitor.warmup_target_frames == 0U)
+  {
+    sof_monitor.speed_change_count = 0U;
+    sof_monitor.speed_change_window_us = 0U;          // V251109R3: 창 비활성화
+    return;
+  }
+
+  if (sof_monitor.speed_change_count == 0U || now_us >= sof_monitor.speed_change_window_us)
+  {
+    sof_monitor.speed_change_count = 0U;
+    sof_monitor.speed_change_window_us = now_us + USB_SOF_MONITOR_SPEED_WINDOW_US;  // V251109R3: 첫 이벤트 기준 고정 창
+  }
+
+  if (sof_monitor.warmup_complete)
+  {
+    sof_monitor.warmup_grace_active = true;
+    sof_monitor.warmup_grace_deadline_us = now_us + USB_SOF_MONITOR_WARMUP_GRACE_US;
+  }
+
+  if (sof_monitor.speed_change_count < 0xFFU)
+  {
+    sof_monitor.speed_change_count++;
+  }
+
+  if (sof_monitor.speed_change_count >= USB_SOF_MONITOR_SPEED_THRESHOLD)
+  {
+    sof_monitor.speed_change_count = 0U;
+    sof_monitor.speed_change_window_us = now_us + USB_SOF_MONITOR_SPEED_WINDOW_US;  // V251109R3: 새 창 시작
+    usbHidMonitorBumpPersistent(now_us, USB_MONITOR_EVENT_SPEED);
+  }
+}
+
+static void usbHidMonitorHandleSuspend(uint32_t now_us)
+{
+  if (sof_monitor.warmup_target_frames == 0U)
+  {
+    sof_monitor.suspend_count = 0U;
+    sof_monitor.suspend_window_us = 0U;               // V251109R3: 창 비활성화
+    return;
+  }
+
+  if (sof_monitor.suspend_count == 0U || now_us >= sof_monitor.suspend_window_us)
+  {
+    sof_monitor.suspend_count = 0U;
+    sof_monitor.suspend_window_us = now_us + USB_SOF_MONITOR_SUSPEND_WINDOW_US;  // V251109R3: 첫 이벤트 기준 창
+  }
+
+  if (sof_monitor.warmup_complete)
+  {
+    sof_monitor.warmup_grace_active = true;
+    sof_monitor.warmup_grace_deadline_us = now_us + USB_SOF_MONITOR_WARMUP_GRACE_US;
+  }
+
+  if (sof_monitor.suspend_count < 0xFFU)
+  {
+    sof_monitor.suspend_count++;
+  }
+
+  if (sof_monitor.suspend_count >= USB_SOF_MONITOR_SUSPEND_THRESHOLD)
+  {
+    sof_monitor.suspend_count = 0U;
+    sof_monitor.suspend_window_us = now_us + USB_SOF_MONITOR_SUSPEND_WINDOW_US;  // V251109R3: 새 창 시작
+    usbHidMonitorBumpPersistent(now_us, USB_MONITOR_EVENT_SUSPEND);
+  }
+}
+
+static void usbHidMonitorRefreshEventWindows(uint32_t now_us)
+{
+  if (sof_monitor.speed_change_count > 0U && now_us >= sof_monitor.speed_change_window_us)
+  {
+    sof_monitor.speed_change_count = 0U;
+    sof_monitor.speed_change_window_us = 0U;          // V251109R3: 만료 시 창 초기화
+  }
+
+  if (sof_monitor.suspend_count > 0U && now_us >= sof_monitor.suspend_window_us)
+  {
+    sof_monitor.suspend_count = 0U;
+    sof_monitor.suspend_window_us = 0U;               // V251109R3
+  }
+
+  if (sof_monitor.warmup_grace_active && now_us >= sof_monitor.warmup_grace_deadline_us)
+  {
+    sof_monitor.warmup_grace_active = false;
+  }
+}
+
+static void sim_ref_background_tick(uint32_t now_us)             // V251108R9 SOF 중단 감시
+{
+  usbHidMonitorRefreshEventWindows(now_us);
+
+  sim_ref_dev_t *pdev = &sim_ref_dev;
+
+  if (pdev->dev_state != USBD_STATE_CONFIGURED)
+  {
+    return;
+  }
+
+  if (sim_ref_dev.suspended)
+  {
+    return;
+  }
+
+  if (sof_monitor.prev_tick_us == 0U || sof_monitor.expected_us == 0U)
+  {
+    return;
+  }
+
+  if (sof_monitor.warmup_complete == false)
+  {
+    return;
+  }
+
+  if (now_us < sof_monitor.no_sof_deadline_us)
+  {
+    return;
+  }
+
+  uint32_t delta_us = now_us - sof_monitor.prev_tick_us;
+  sof_monitor.prev_tick_us = now_us;
+
+  usbHidMonitorProcessDelta(now_us, delta_us);
+}